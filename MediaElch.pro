@@ -107,16 +107,21 @@ QMAKE_INFO_PLIST = MediaElch.plist
 SOURCES += src/main.cpp \
     src/concerts/ConcertController.cpp \
     src/data/MediaInfoFile.cpp \
+    src/data/MediaInfoProbe.cpp \
+    src/data/MediaInfoProbeQueue.cpp \
     src/export/CsvExport.cpp \
     src/globals/Containers.cpp \
     src/globals/Random.cpp \
     src/music/AllMusicId.cpp \
     src/music/MusicBrainzId.cpp \
     src/music/TheAudioDbId.cpp \
+    src/network/HttpDiskCache.cpp \
     src/network/HttpStatusCodes.cpp \
     src/network/NetworkRequest.cpp \
     src/network/NetworkManager.cpp \
     src/scrapers/ScraperError.cpp \
+    src/scrapers/ScraperRateLimiter.cpp \
+    src/scrapers/ScrapePipeline.cpp \
     src/scrapers/music/AllMusic.cpp \
     src/scrapers/music/Discogs.cpp \
     src/scrapers/music/MusicBrainz.cpp \
@@ -132,14 +137,18 @@ SOURCES += src/main.cpp \
     src/concerts/ConcertModel.cpp \
     src/concerts/ConcertProxyModel.cpp \
     src/data/Database.cpp \
+    src/data/DatabaseWorker.cpp \
     src/data/ImageCache.cpp \
     src/data/ResumeTime.cpp \
     src/movies/Movie.cpp \
+    src/movies/MovieDuplicateIndex.cpp \
     src/movies/file_searcher/MovieFileSearcher.cpp \
     src/movies/MovieFilesOrganizer.cpp \
     src/movies/MovieImages.cpp \
+    src/movies/MovieKeyTable.cpp \
     src/movies/MovieModel.cpp \
     src/movies/MovieProxyModel.cpp \
+    src/movies/MovieScrapeItem.cpp \
     src/data/Locale.cpp \
     src/data/Rating.cpp \
     src/data/Storage.cpp \
@@ -148,6 +157,7 @@ SOURCES += src/main.cpp \
     src/tv_shows/TvShow.cpp \
     src/tv_shows/TvShowEpisode.cpp \
     src/tv_shows/TvShowFileSearcher.cpp \
+    src/tv_shows/TvShowScrapeItem.cpp \
     src/ui/export/CsvExportDialog.cpp \
     src/ui/imports/ImportActions.cpp \
     src/ui/imports/ImportDialog.cpp \
@@ -156,19 +166,24 @@ SOURCES += src/main.cpp \
     src/ui/export/ExportDialog.cpp \
     src/ui/imports/UnpackButtons.cpp \
     src/imports/MakeMkvCon.cpp \
-    src/imports/MyFile.cpp \
     src/imports/Extractor.cpp \
-    src/imports/FileWorker.cpp \
+    src/imports/FileImporter.cpp \
     src/imports/DownloadFileSearcher.cpp \
     src/log/Log.cpp \
+    src/export/CompiledTemplate.cpp \
     src/export/ExportTemplate.cpp \
     src/export/ExportTemplateLoader.cpp \
     src/export/MediaExport.cpp \
     src/export/SimpleEngine.cpp \
     src/file/FileFilter.cpp \
+    src/file/FileNameMatcher.cpp \
+    src/file/DirectoryJournal.cpp \
+    src/file/DirectorySnapshot.cpp \
+    src/file/DirectoryWalker.cpp \
     src/file/FilenameUtils.cpp \
     src/file/Path.cpp \
     src/globals/Actor.cpp \
+    src/globals/CollationKeys.cpp \
     src/globals/ComboDelegate.cpp \
     src/globals/DownloadManager.cpp \
     src/globals/DownloadManagerElement.cpp \
@@ -176,11 +191,13 @@ SOURCES += src/main.cpp \
     src/globals/Globals.cpp \
     src/globals/Helper.cpp \
     src/globals/ImageDialog.cpp \
+    src/globals/ImagePreviewLoader.cpp \
     src/globals/ImagePreviewDialog.cpp \
     src/globals/JsonRequest.cpp \
     src/globals/Manager.cpp \
     src/globals/MessageIds.cpp \
     src/globals/Math.cpp \
+    src/globals/MediaSearchIndex.cpp \
     src/globals/Meta.cpp \
     src/file/NameFormatter.cpp \
     src/network/NetworkReplyWatcher.cpp \
@@ -206,6 +223,7 @@ SOURCES += src/main.cpp \
     src/ui/main/Navbar.cpp \
     src/ui/main/QuickOpen.cpp \
     src/ui/main/Update.cpp \
+    src/media_centers/kodi/KodiXmlReader.cpp \
     src/media_centers/kodi/KodiXmlWriter.cpp \
     src/media_centers/kodi/AlbumXmlReader.cpp \
     src/media_centers/kodi/AlbumXmlWriter.cpp \
@@ -412,6 +430,7 @@ SOURCES += src/main.cpp \
     src/tv_shows/TvDbId.cpp \
     src/tv_shows/TvMazeId.cpp \
     src/tv_shows/EpisodeNumber.cpp \
+    src/tv_shows/EpisodeNumberMatcher.cpp \
     src/tv_shows/SeasonNumber.cpp \
     src/tv_shows/SeasonOrder.cpp \
     src/data/Certification.cpp \
@@ -426,16 +445,21 @@ macx {
 HEADERS  += Version.h \
     src/concerts/ConcertController.h \
     src/data/MediaInfoFile.h \
+    src/data/MediaInfoProbe.h \
+    src/data/MediaInfoProbeQueue.h \
     src/export/CsvExport.h \
     src/globals/Containers.h \
     src/globals/Random.h \
     src/music/AllMusicId.h \
     src/music/MusicBrainzId.h \
     src/music/TheAudioDbId.h \
+    src/network/HttpDiskCache.h \
     src/network/HttpStatusCodes.h \
     src/network/NetworkRequest.h \
     src/network/NetworkManager.h \
     src/scrapers/ScraperError.h \
+    src/scrapers/ScraperRateLimiter.h \
+    src/scrapers/ScrapePipeline.h \
     src/scrapers/music/AllMusic.h \
     src/scrapers/music/Discogs.h \
     src/scrapers/music/MusicBrainz.h \
@@ -451,15 +475,19 @@ HEADERS  += Version.h \
     src/concerts/ConcertProxyModel.h \
     src/ui/concerts/ConcertStreamDetailsWidget.h \
     src/data/Database.h \
+    src/data/DatabaseWorker.h \
     src/data/ImageCache.h \
     src/data/ResumeTime.h \
     src/media_centers/MediaCenterInterface.h \
     src/movies/Movie.h \
+    src/movies/MovieDuplicateIndex.h \
     src/movies/file_searcher/MovieFileSearcher.h \
     src/movies/MovieFilesOrganizer.h \
     src/movies/MovieImages.h \
+    src/movies/MovieKeyTable.h \
     src/movies/MovieModel.h \
     src/movies/MovieProxyModel.h \
+    src/movies/MovieScrapeItem.h \
     src/scrapers/image/ImageProvider.h \
     src/scrapers/concert/ConcertIdentifier.h \
     src/scrapers/concert/ConcertScraper.h \
@@ -475,11 +503,11 @@ HEADERS  += Version.h \
     src/tv_shows/TvShow.h \
     src/tv_shows/TvShowEpisode.h \
     src/tv_shows/TvShowFileSearcher.h \
+    src/tv_shows/TvShowScrapeItem.h \
     src/imports/DownloadFileSearcher.h \
     src/imports/Extractor.h \
-    src/imports/FileWorker.h \
+    src/imports/FileImporter.h \
     src/imports/MakeMkvCon.h \
-    src/imports/MyFile.h \
     src/log/Log.h \
     src/ui/export/CsvExportDialog.h \
     src/ui/export/ExportDialog.h \
@@ -488,14 +516,20 @@ HEADERS  += Version.h \
     src/ui/imports/ImportDialog.h \
     src/ui/imports/MakeMkvDialog.h \
     src/ui/imports/UnpackButtons.h \
+    src/export/CompiledTemplate.h \
     src/export/ExportTemplate.h \
     src/export/ExportTemplateLoader.h \
     src/export/MediaExport.h \
     src/export/SimpleEngine.h \
     src/file/FileFilter.h \
+    src/file/FileNameMatcher.h \
+    src/file/DirectoryJournal.h \
+    src/file/DirectorySnapshot.h \
+    src/file/DirectoryWalker.h \
     src/file/FilenameUtils.h \
     src/file/Path.h \
     src/globals/Actor.h \
+    src/globals/CollationKeys.h \
     src/globals/ComboDelegate.h \
     src/globals/DownloadManager.h \
     src/globals/DownloadManagerElement.h \
@@ -503,12 +537,14 @@ HEADERS  += Version.h \
     src/globals/Globals.h \
     src/globals/Helper.h \
     src/globals/ImageDialog.h \
+    src/globals/ImagePreviewLoader.h \
     src/globals/ImagePreviewDialog.h \
     src/globals/JsonRequest.h \
     src/globals/LocaleStringCompare.h \
     src/globals/Manager.h \
     src/globals/MessageIds.h \
     src/globals/Math.h \
+    src/globals/MediaSearchIndex.h \
     src/globals/Meta.h \
     src/file/NameFormatter.h \
     src/network/NetworkReplyWatcher.h \
@@ -539,6 +575,7 @@ HEADERS  += Version.h \
     src/ui/main/Navbar.h \
     src/ui/main/QuickOpen.h \
     src/ui/main/Update.h \
+    src/media_centers/kodi/KodiXmlReader.h \
     src/media_centers/kodi/KodiXmlWriter.h \
     src/media_centers/kodi/AlbumXmlReader.h \
     src/media_centers/kodi/AlbumXmlWriter.h \
@@ -737,6 +774,7 @@ HEADERS  += Version.h \
     src/tv_shows/TvDbId.h \
     src/tv_shows/TvMazeId.h \
     src/tv_shows/EpisodeNumber.h \
+    src/tv_shows/EpisodeNumberMatcher.h \
     src/tv_shows/SeasonNumber.h \
     src/tv_shows/SeasonOrder.h \
     src/data/Certification.h \
@@ -33,6 +33,17 @@ MediaType mediaTypeFromString(QString str)
     return MediaType::Unknown;
 }
 
+OutputFormat outputFormatFromString(QString str)
+{
+    if ("table" == str) {
+        return OutputFormat::Table;
+    }
+    if ("json" == str) {
+        return OutputFormat::Json;
+    }
+    return OutputFormat::Unknown;
+}
+
 void setVerbosity(int level)
 {
     if (level <= 0) {
@@ -18,6 +18,17 @@ enum class MediaType
 
 MediaType mediaTypeFromString(QString str);
 
+enum class OutputFormat
+{
+    Unknown,
+    /// Human readable tables
+    Table,
+    /// Newline-delimited JSON, see JsonLinesWriter
+    Json
+};
+
+OutputFormat outputFormatFromString(QString str);
+
 void setVerbosity(int level);
 void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg);
 
@@ -0,0 +1,66 @@
+#include "cli/duplicates.h"
+
+#include "export/TableWriter.h"
+#include "globals/Manager.h"
+#include "movies/Movie.h"
+#include "movies/MovieDuplicateIndex.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "settings/Settings.h"
+
+#include <QSet>
+#include <iostream>
+
+namespace mediaelch {
+namespace cli {
+
+int duplicates(QApplication& app, QCommandLineParser& parser)
+{
+    parser.clearPositionalArguments();
+    // re-add this command so that it appears when help is printed
+    parser.addPositionalArgument("duplicates", "List duplicate movies", "duplicates");
+    parser.process(app);
+
+    Manager::instance()->movieFileSearcher()->setMovieDirectories(
+        Settings::instance()->directorySettings().movieDirectories());
+    Manager::instance()->movieFileSearcher()->reload(false);
+
+    MovieDuplicateIndex index;
+    index.setMovies(Manager::instance()->movieModel()->moviesWithDetails());
+
+    TableLayout layout;
+    layout.addColumn(TableColumn("Group", 5, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("ImDb Id", 9));
+    layout.addColumn(TableColumn("Title", 30));
+    layout.addColumn(TableColumn("Year", 4));
+    layout.addColumn(TableColumn("File", 50));
+
+    std::cout << "List of duplicate movies: \n\n";
+
+    TableWriter table(std::cout, layout);
+    table.writeHeading();
+
+    int group = 0;
+    QSet<Movie*> printed;
+    for (Movie* movie : index.moviesWithDuplicates()) {
+        if (printed.contains(movie)) {
+            continue;
+        }
+        ++group;
+        const QVector<Movie*> movies = QVector<Movie*>{movie} + index.duplicatesOf(movie);
+        for (Movie* duplicate : movies) {
+            printed.insert(duplicate);
+            table.writeCell(QString::number(group));
+            table.writeCell(duplicate->imdbId().isValid() ? duplicate->imdbId().toString() : "");
+            table.writeCell(duplicate->name());
+            table.writeCell(duplicate->released().isValid() ? QString::number(duplicate->released().year()) : "");
+            table.writeCell(duplicate->files().isEmpty() ? "" : duplicate->files().first().toNativePathString());
+        }
+    }
+
+    std::cout << std::endl << group << " groups of duplicates in " << index.movieCount() << " movies" << std::endl;
+
+    return 0;
+}
+
+} // namespace cli
+} // namespace mediaelch
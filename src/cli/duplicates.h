@@ -0,0 +1,15 @@
+#pragma once
+
+#include "cli/common.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Lists duplicate movies, see MovieDuplicateIndex.
+int duplicates(QApplication& app, QCommandLineParser& parser);
+
+} // namespace cli
+} // namespace mediaelch
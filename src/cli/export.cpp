@@ -0,0 +1,250 @@
+#include "cli/export.h"
+
+#include "export/CsvExport.h"
+#include "globals/Globals.h"
+#include "globals/Manager.h"
+#include "movies/Movie.h"
+#include "movies/MovieController.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "settings/Settings.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+struct ExportConfig
+{
+    QString type;
+    QStringList fields;
+    QString separator;
+    QString replacement;
+};
+
+/// \brief Selected fields of the exporter or all fields if none were given.
+/// Returns false if a field name is unknown.
+template<class Export>
+bool parseFields(const QStringList& names, QVector<typename Export::Field>& fields)
+{
+    using Field = typename Export::Field;
+    // Fields are numbered from 1 without gaps; fieldToString() returns "unknown" for the first invalid one.
+    QVector<Field> allFields;
+    for (int i = 1; Export::fieldToString(static_cast<Field>(i)) != "unknown"; ++i) {
+        allFields << static_cast<Field>(i);
+    }
+    if (names.isEmpty()) {
+        fields = allFields;
+        return true;
+    }
+
+    for (const QString& name : names) {
+        auto field = std::find_if(allFields.cbegin(), allFields.cend(), [&name](Field f) {
+            return Export::fieldToString(f) == name.trimmed();
+        });
+        if (field == allFields.cend()) {
+            std::cerr << "Unknown field: " << name.toStdString() << std::endl;
+            std::cerr << "Available fields:" << std::endl;
+            for (Field f : allFields) {
+                std::cerr << "  " << Export::fieldToString(f).toStdString() << std::endl;
+            }
+            return false;
+        }
+        fields << *field;
+    }
+    return true;
+}
+
+template<class Export>
+bool createExporter(const ExportConfig& config, QTextStream& stream, std::unique_ptr<Export>& exporter)
+{
+    QVector<typename Export::Field> fields;
+    if (!parseFields<Export>(config.fields, fields)) {
+        return false;
+    }
+    exporter = std::make_unique<Export>(stream, fields);
+    exporter->setSeparator(config.separator);
+    exporter->setReplacement(config.replacement);
+    return true;
+}
+
+/// \brief Writes the movies in batches.  Only the details of one batch are kept in memory.
+void exportMovies(const mediaelch::CsvMovieExport& exporter, const QVector<Movie*>& movies)
+{
+    constexpr int batchSize = 100;
+    mediaelch::CsvWriter csv = exporter.csvWriter();
+    exporter.writeHeader(csv);
+    for (int i = 0; i < movies.size(); i += batchSize) {
+        const QVector<Movie*> batch = movies.mid(i, batchSize);
+        MovieController::loadDetails(batch);
+        for (Movie* movie : batch) {
+            exporter.writeMovie(csv, *movie);
+            movie->controller()->releaseDetails();
+        }
+    }
+}
+
+void loadTvShows()
+{
+    Manager::instance()->tvShowFileSearcher()->setTvShowDirectories(
+        Settings::instance()->directorySettings().tvShowDirectories());
+    Manager::instance()->tvShowFileSearcher()->reload(false);
+}
+
+void loadMusic()
+{
+    Manager::instance()->musicFileSearcher()->setMusicDirectories(
+        Settings::instance()->directorySettings().musicDirectories());
+    Manager::instance()->musicFileSearcher()->reload(false);
+}
+
+} // namespace
+
+namespace mediaelch {
+namespace cli {
+
+static bool exportCsv(const ExportConfig& config, QTextStream& stream)
+{
+    // Exporters call this after each item (or after each TV show / artist for episodes / albums).
+    const auto progress = []() {};
+
+    if (config.type == "movie") {
+        std::unique_ptr<CsvMovieExport> exporter;
+        if (!createExporter(config, stream, exporter)) {
+            return false;
+        }
+        Manager::instance()->movieFileSearcher()->setProcessEvents(false);
+        Manager::instance()->movieFileSearcher()->setMovieDirectories(
+            Settings::instance()->directorySettings().movieDirectories());
+        Manager::instance()->movieFileSearcher()->reload(false);
+        exportMovies(*exporter, Manager::instance()->movieModel()->movies());
+
+    } else if (config.type == "tvshow" || config.type == "episode") {
+        // The global TvShowFilesWidget instance is set in its constructor...
+        // TODO: Don't implicitly expect that it is instantiated somewhere.
+        TvShowFilesWidget filesWidget;
+        if (config.type == "tvshow") {
+            std::unique_ptr<CsvTvShowExport> exporter;
+            if (!createExporter(config, stream, exporter)) {
+                return false;
+            }
+            loadTvShows();
+            exporter->exportTvShows(Manager::instance()->tvShowModel()->tvShows(), progress);
+        } else {
+            std::unique_ptr<CsvTvEpisodeExport> exporter;
+            if (!createExporter(config, stream, exporter)) {
+                return false;
+            }
+            loadTvShows();
+            exporter->exportEpisodes(Manager::instance()->tvShowModel()->tvShowsWithEpisodeDetails(), progress);
+        }
+
+    } else if (config.type == "concert") {
+        std::unique_ptr<CsvConcertExport> exporter;
+        if (!createExporter(config, stream, exporter)) {
+            return false;
+        }
+        Manager::instance()->concertFileSearcher()->setConcertDirectories(
+            Settings::instance()->directorySettings().concertDirectories());
+        Manager::instance()->concertFileSearcher()->reload(false);
+        exporter->exportConcerts(Manager::instance()->concertModel()->concerts(), progress);
+
+    } else if (config.type == "artist") {
+        std::unique_ptr<CsvArtistExport> exporter;
+        if (!createExporter(config, stream, exporter)) {
+            return false;
+        }
+        loadMusic();
+        exporter->exportArtists(Manager::instance()->musicModel()->artists(), progress);
+
+    } else if (config.type == "album") {
+        std::unique_ptr<CsvAlbumExport> exporter;
+        if (!createExporter(config, stream, exporter)) {
+            return false;
+        }
+        loadMusic();
+        exporter->exportAlbumsOfArtists(Manager::instance()->musicModel()->artists(), progress);
+
+    } else {
+        std::cerr << "Unknown media type: " << config.type.toStdString() << std::endl;
+        return false;
+    }
+
+    stream.flush();
+    return stream.status() == QTextStream::Ok;
+}
+
+int exportMedia(QApplication& app, QCommandLineParser& parser)
+{
+    parser.clearPositionalArguments();
+    // re-add this command so that it appears when help is printed
+    parser.addPositionalArgument("export", "Export media entries", "export --csv [export_options]");
+
+    QCommandLineOption csvOption("csv", "Export as CSV. Currently the only export format.");
+    QCommandLineOption typeOption("type",
+        R"(Media type. Either "movie", "tvshow", "episode", "concert", "artist" or "album")",
+        "mediatype",
+        "movie");
+    QCommandLineOption outputOption("output", "Output file. Default: standard output", "file");
+    QCommandLineOption fieldsOption(
+        "fields", R"(Comma separated list of fields, e.g. "movie_title,movie_imdb_id". Default: all)", "fields");
+    QCommandLineOption separatorOption("separator", "Column separator. Default: tab", "separator", "\t");
+    QCommandLineOption replacementOption(
+        "replacement", "Replacement for separators in values. Default: space", "replacement", " ");
+
+    parser.addOption(csvOption);
+    parser.addOption(typeOption);
+    parser.addOption(outputOption);
+    parser.addOption(fieldsOption);
+    parser.addOption(separatorOption);
+    parser.addOption(replacementOption);
+    parser.process(app);
+
+    if (!parser.isSet(csvOption)) {
+        std::cerr << "Missing export format, use --csv" << std::endl;
+        return 1;
+    }
+
+    ExportConfig config;
+    config.type = parser.value(typeOption);
+    config.fields = parser.value(fieldsOption).split(',', ElchSplitBehavior::SkipEmptyParts);
+    config.separator = parser.value(separatorOption);
+    config.replacement = parser.value(replacementOption);
+
+    if (config.separator.isEmpty()) {
+        std::cerr << "The separator must not be empty" << std::endl;
+        return 1;
+    }
+
+    // The file is written while media is exported. Only QTextStream's buffer is kept in memory.
+    QFile file;
+    bool isOpen = false;
+    if (parser.isSet(outputOption)) {
+        file.setFileName(parser.value(outputOption));
+        isOpen = file.open(QFile::WriteOnly | QFile::Text);
+    } else {
+        isOpen = file.open(stdout, QFile::WriteOnly | QFile::Text);
+    }
+    if (!isOpen) {
+        std::cerr << "Could not open output file: " << file.errorString().toStdString() << std::endl;
+        return 1;
+    }
+
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+
+    QElapsedTimer timer;
+    timer.start();
+    if (!exportCsv(config, stream)) {
+        return 1;
+    }
+    qInfo() << "[CsvExport] Finished in" << timer.elapsed() << "ms";
+    return 0;
+}
+
+} // namespace cli
+} // namespace mediaelch
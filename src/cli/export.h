@@ -0,0 +1,15 @@
+#pragma once
+
+#include "cli/common.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Exports media as CSV. The `export` keyword is reserved, hence the name.
+int exportMedia(QApplication& app, QCommandLineParser& parser);
+
+} // namespace cli
+} // namespace mediaelch
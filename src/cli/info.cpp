@@ -2,6 +2,7 @@
 
 #include "Version.h"
 #include "cli/common.h"
+#include "cli/info/CacheStatistics.h"
 #include "cli/info/ScraperFeatureTable.h"
 #include "export/TableWriter.h"
 #include "globals/Manager.h"
@@ -15,6 +16,7 @@ namespace cli {
 enum class InfoObjectType
 {
     MovieScrapers,
+    Cache,
     Unknown
 };
 
@@ -23,6 +25,9 @@ static InfoObjectType infoTypeFromString(QString str)
     if ("movie_scrapers" == str) {
         return InfoObjectType::MovieScrapers;
     }
+    if ("cache" == str) {
+        return InfoObjectType::Cache;
+    }
     return InfoObjectType::Unknown;
 }
 
@@ -31,7 +36,7 @@ int info(QApplication& app, QCommandLineParser& parser)
     parser.clearPositionalArguments();
     // re-add this command so that it appears when help is printed
     parser.addPositionalArgument("info", "Query information about MediaElch.", "info [list_options]");
-    parser.addPositionalArgument("details", "What details to show. Can be:\n - movie_scrapers", "<details>");
+    parser.addPositionalArgument("details", "What details to show. Can be:\n - movie_scrapers\n - cache", "<details>");
 
     parser.process(app);
 
@@ -44,6 +49,10 @@ int info(QApplication& app, QCommandLineParser& parser)
         printer.print();
         return 0;
     }
+    case InfoObjectType::Cache: {
+        printCacheStatistics(std::cout);
+        return 0;
+    }
     case InfoObjectType::Unknown:
         if (command.isEmpty()) {
             std::cout << "Missing info <details>" << std::endl;
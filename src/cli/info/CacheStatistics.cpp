@@ -0,0 +1,43 @@
+#include "cli/info/CacheStatistics.h"
+
+#include "export/TableWriter.h"
+#include "network/HttpDiskCache.h"
+#include "network/WebsiteCache.h"
+
+namespace mediaelch {
+namespace cli {
+
+void printCacheStatistics(std::ostream& out)
+{
+    // This is a new process: Its own counters are all zero.  Use the counters of all
+    // processes that are stored in the disk cache.
+    network::HttpDiskCache* diskCache = network::HttpDiskCache::instance();
+    const scraper::WebsiteCache::Statistics stats = scraper::WebsiteCache::persistentStatistics(diskCache);
+    const quint64 lookups = stats.memoryHits + stats.diskHits + stats.misses;
+    const double hitRate =
+        lookups == 0 ? 0.0 : 100.0 * static_cast<double>(stats.memoryHits + stats.diskHits) / lookups;
+
+    out << "Website cache statistics:" << std::endl;
+
+    TableLayout layout;
+    layout.addColumn(TableColumn("Counter", 20));
+    layout.addColumn(TableColumn("Value", 16, ColumnAlignment::Right));
+    TableWriter table(out, layout);
+    table.writeHeading();
+
+    auto writeRow = [&table](const char* name, const QString& value) {
+        table.writeCell(QString(name));
+        table.writeCell(value);
+    };
+    writeRow("Memory hits", QString::number(stats.memoryHits));
+    writeRow("Disk hits", QString::number(stats.diskHits));
+    writeRow("Misses", QString::number(stats.misses));
+    writeRow("Hit rate", QStringLiteral("%1 %").arg(hitRate, 0, 'f', 1));
+    writeRow("Revalidations (304)", QString::number(stats.revalidations));
+    writeRow("Evictions", QString::number(stats.evictions));
+    writeRow("Disk bytes", QString::number(diskCache->size()));
+    writeRow("Disk budget", QString::number(diskCache->maxSize()));
+}
+
+} // namespace cli
+} // namespace mediaelch
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <ostream>
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Prints hit/miss/eviction counters of the website caches and the size of the disk cache.
+/// Counters are accumulated over all MediaElch processes that used the disk cache.
+void printCacheStatistics(std::ostream& out);
+
+} // namespace cli
+} // namespace mediaelch
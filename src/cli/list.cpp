@@ -4,6 +4,7 @@
 #include "cli/common.h"
 #include "cli/reload.h"
 #include "concerts/Concert.h"
+#include "export/JsonLinesWriter.h"
 #include "export/TableWriter.h"
 #include "globals/Manager.h"
 #include "movies/Movie.h"
@@ -11,12 +12,80 @@
 #include "music/Album.h"
 #include "settings/Settings.h"
 
+#include <QJsonArray>
 #include <iomanip>
 #include <iostream>
 
+namespace {
+
+QJsonArray filesToJson(const mediaelch::FileList& files)
+{
+    QJsonArray array;
+    for (const mediaelch::FilePath& file : files) {
+        array.append(file.toNativePathString());
+    }
+    return array;
+}
+
+} // namespace
+
 namespace mediaelch {
 namespace cli {
 
+QJsonObject movieToJson(const Movie& movie)
+{
+    QJsonObject object;
+    object.insert("type", "movie");
+    object.insert("id", movie.databaseId());
+    object.insert("imdbId", movie.imdbId().isValid() ? movie.imdbId().toString() : "");
+    object.insert("tmdbId", movie.tmdbId().isValid() ? movie.tmdbId().toString() : "");
+    object.insert("title", movie.name());
+    object.insert("year", movie.released().isValid() ? movie.released().year() : 0);
+    object.insert("genres", QJsonArray::fromStringList(movie.genres()));
+    object.insert("files", filesToJson(movie.files()));
+    return object;
+}
+
+QJsonObject concertToJson(const Concert& concert)
+{
+    QJsonObject object;
+    object.insert("type", "concert");
+    object.insert("id", concert.databaseId());
+    object.insert("imdbId", concert.imdbId().isValid() ? concert.imdbId().toString() : "");
+    object.insert("title", concert.name());
+    object.insert("artist", concert.artist());
+    object.insert("genres", QJsonArray::fromStringList(concert.genres()));
+    object.insert("files", filesToJson(concert.files()));
+    return object;
+}
+
+QJsonObject tvShowToJson(const TvShow& show)
+{
+    QJsonObject object;
+    object.insert("type", "tvshow");
+    object.insert("id", show.databaseId());
+    object.insert("imdbId", show.imdbId().isValid() ? show.imdbId().toString() : "");
+    object.insert("tvdbId", show.tvdbId().isValid() ? show.tvdbId().toString() : "");
+    object.insert("title", show.title());
+    object.insert("network", show.network());
+    object.insert("episodes", show.episodes().size());
+    object.insert("dir", show.dir().toNativePathString());
+    return object;
+}
+
+QJsonObject albumToJson(const Album& album)
+{
+    QJsonObject object;
+    object.insert("type", "album");
+    object.insert("id", album.databaseId());
+    object.insert("title", album.title());
+    object.insert("artist", album.artist());
+    object.insert("year", album.year());
+    object.insert("genres", QJsonArray::fromStringList(album.genres()));
+    object.insert("dir", album.path().toNativePathString());
+    return object;
+}
+
 void printMovie(TableWriter& table, Movie& movie)
 {
     table.writeCell(movie.imdbId().isValid() ? movie.imdbId().toString() : "");
@@ -24,13 +93,22 @@ void printMovie(TableWriter& table, Movie& movie)
     table.writeCell(movie.genres().join(", "));
 }
 
-void listMovies()
+void listMovies(OutputFormat format)
 {
+    Manager::instance()->movieFileSearcher()->setProcessEvents(false);
     Manager::instance()->movieFileSearcher()->setMovieDirectories(
         Settings::instance()->directorySettings().movieDirectories());
     Manager::instance()->movieFileSearcher()->reload(false);
     MovieModel* movieModel = Manager::instance()->movieModel();
 
+    if (format == OutputFormat::Json) {
+        JsonLinesWriter writer(std::cout);
+        for (const Movie* movie : movieModel->moviesWithDetails()) {
+            writer.write(movieToJson(*movie));
+        }
+        return;
+    }
+
     TableLayout layout;
     layout.addColumn(TableColumn("ImDb Id", 9));
     layout.addColumn(TableColumn("Title", 30));
@@ -56,13 +134,21 @@ void printConcert(TableWriter& table, Concert& concert)
     table.writeCell(concert.genres().join(", "));
 }
 
-void listConcerts()
+void listConcerts(OutputFormat format)
 {
     Manager::instance()->concertFileSearcher()->setConcertDirectories(
         Settings::instance()->directorySettings().concertDirectories());
     Manager::instance()->concertFileSearcher()->reload(false);
     ConcertModel* concertModel = Manager::instance()->concertModel();
 
+    if (format == OutputFormat::Json) {
+        JsonLinesWriter writer(std::cout);
+        for (const Concert* concert : concertModel->concerts()) {
+            writer.write(concertToJson(*concert));
+        }
+        return;
+    }
+
     TableLayout layout;
     layout.addColumn(TableColumn("ImDb Id", 9));
     layout.addColumn(TableColumn("Title", 30));
@@ -96,13 +182,25 @@ void printArtist(TableWriter& table, Artist& artist)
     }
 }
 
-void listMusic()
+void listMusic(OutputFormat format)
 {
     Manager::instance()->musicFileSearcher()->setMusicDirectories(
         Settings::instance()->directorySettings().musicDirectories());
     Manager::instance()->musicFileSearcher()->reload(false);
     MusicModel* musicModel = Manager::instance()->musicModel();
 
+    if (format == OutputFormat::Json) {
+        JsonLinesWriter writer(std::cout);
+        for (const Artist* artist : musicModel->artists()) {
+            for (const Album* album : artist->albums()) {
+                if (album != nullptr) {
+                    writer.write(albumToJson(*album));
+                }
+            }
+        }
+        return;
+    }
+
     TableLayout layout;
     layout.addColumn(TableColumn("Title", 30));
     layout.addColumn(TableColumn("Genres", 30));
@@ -119,7 +217,7 @@ void listMusic()
     }
 }
 
-void listTvShows()
+void listTvShows(OutputFormat format)
 {
     Manager::instance()->tvShowFileSearcher()->setTvShowDirectories(
         Settings::instance()->directorySettings().tvShowDirectories());
@@ -129,6 +227,16 @@ void listTvShows()
     Manager::instance()->tvShowFileSearcher()->reload(false);
     TvShowModel* tvShowModel = Manager::instance()->tvShowModel();
 
+    if (format == OutputFormat::Json) {
+        JsonLinesWriter writer(std::cout);
+        for (const TvShow* show : tvShowModel->tvShows()) {
+            if (show != nullptr) {
+                writer.write(tvShowToJson(*show));
+            }
+        }
+        return;
+    }
+
     TableLayout layout;
     layout.addColumn(TableColumn("ImDb id", 8));
     layout.addColumn(TableColumn("TvDB id", 8));
@@ -152,24 +260,27 @@ void listTvShows()
 
 void listEntries(ListConfig config)
 {
+    // JSON lines must not be separated by empty lines.
+    const char* separator = config.format == OutputFormat::Json ? "" : "\n";
+
     switch (config.mediaType) {
-    case MediaType::Movie: listMovies(); break;
-    case MediaType::TvShow: listTvShows(); break;
-    case MediaType::Concert: listConcerts(); break;
-    case MediaType::Music: listMusic(); break;
+    case MediaType::Movie: listMovies(config.format); break;
+    case MediaType::TvShow: listTvShows(config.format); break;
+    case MediaType::Concert: listConcerts(config.format); break;
+    case MediaType::Music: listMusic(config.format); break;
     case MediaType::All:
-        listMovies();
-        std::cout << std::endl;
-        listTvShows();
-        std::cout << std::endl;
-        listConcerts();
-        std::cout << std::endl;
-        listMusic();
+        listMovies(config.format);
+        std::cout << separator;
+        listTvShows(config.format);
+        std::cout << separator;
+        listConcerts(config.format);
+        std::cout << separator;
+        listMusic(config.format);
         break;
     case MediaType::Unknown: break;
     }
 
-    std::cout << std::endl;
+    std::cout << separator << std::flush;
 }
 
 int list(QApplication& app, QCommandLineParser& parser)
@@ -181,20 +292,31 @@ int list(QApplication& app, QCommandLineParser& parser)
     QCommandLineOption typeOption(
         "type", R"(Media type. Either "all", "movie", "concert", "music" or "tvshow")", "mediatype", "all");
 
+    QCommandLineOption formatOption("format",
+        R"(Output format. Either "table" or "json" (one JSON object per line))",
+        "format",
+        "table");
+
     parser.addOption(typeOption);
+    parser.addOption(formatOption);
     parser.process(app);
 
     ListConfig config;
     config.mediaType = mediaTypeFromString(parser.value(typeOption));
+    config.format = outputFormatFromString(parser.value(formatOption));
 
     if (config.mediaType == MediaType::Unknown) {
         std::cerr << "Unknown media type: " << parser.value(typeOption).toStdString() << std::endl;
         return 1;
     }
+    if (config.format == OutputFormat::Unknown) {
+        std::cerr << "Unknown output format: " << parser.value(formatOption).toStdString() << std::endl;
+        return 1;
+    }
 
     listEntries(config);
 
-    return 1;
+    return 0;
 }
 
 } // namespace cli
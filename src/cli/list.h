@@ -4,6 +4,7 @@
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QJsonObject>
 
 class Album;
 class Artist;
@@ -18,6 +19,7 @@ namespace cli {
 struct ListConfig
 {
     MediaType mediaType = MediaType::All;
+    OutputFormat format = OutputFormat::Table;
     bool reload = false;
 };
 
@@ -26,10 +28,16 @@ void printConcert(TableWriter& table, Concert& concert);
 void printArtist(TableWriter& table, Artist& album);
 void printAlbum(TableWriter& table, Album& album);
 
-void listMovies();
-void listConcerts();
-void listMusic();
-void listTvShows();
+/// \brief Objects of the JSON output format. Each has a "type" key with the media type.
+QJsonObject movieToJson(const Movie& movie);
+QJsonObject concertToJson(const Concert& concert);
+QJsonObject tvShowToJson(const TvShow& show);
+QJsonObject albumToJson(const Album& album);
+
+void listMovies(OutputFormat format);
+void listConcerts(OutputFormat format);
+void listMusic(OutputFormat format);
+void listTvShows(OutputFormat format);
 
 void listEntries(ListConfig config);
 
@@ -1,8 +1,11 @@
 #include "Version.h"
 #include "cli/common.h"
+#include "cli/duplicates.h"
+#include "cli/export.h"
 #include "cli/info.h"
 #include "cli/list.h"
 #include "cli/reload.h"
+#include "cli/scrape.h"
 #include "cli/show.h"
 #include "globals/Meta.h"
 #include "settings/Settings.h"
@@ -26,6 +29,9 @@ enum class Command
     Reload,
     Add,
     Show,
+    Duplicates,
+    Scrape,
+    Export,
     Sync,
     Settings,
     Info,
@@ -47,6 +53,15 @@ static Command commandFromString(const QString& command)
     if ("show" == command) {
         return Command::Show;
     }
+    if ("duplicates" == command) {
+        return Command::Duplicates;
+    }
+    if ("scrape" == command) {
+        return Command::Scrape;
+    }
+    if ("export" == command) {
+        return Command::Export;
+    }
     if ("sync" == command) {
         return Command::Sync;
     }
@@ -75,10 +90,17 @@ Options:
 
 commands:
    list        List all media entries.
-   reload      Reload all media files.
+   reload      Reload all media files and print the duration of each stage.
+               `list`, `reload` and `show` accept `--format=json` to print
+               one JSON object per line.
    add <path>  Add given path to MediaElch's directory settings.
    show <id>   Show an entry with the identifier <id>. <id> can be either
                MediaElch's media id, IMDb id or TheTvDb id for TV shows.
+   duplicates  List movies that have the same IMDb id, TMDb id or title and year.
+   scrape      Scrape all movies or TV shows without NFO file using the given
+               scraper, save them and print request and cache statistics.
+   export      Export movies, TV shows, episodes, concerts or music as CSV
+               using `export --csv`.
    sync        Sync MediaElch with Kodi. Uses parameters set in settings.
    settings    Get or set MediaElch's settings.
    info        Get various details about MediaElch.
@@ -127,6 +149,9 @@ static int parseArguments(QApplication& app)
     case Command::Sync:
     case Command::Add: printUnsupported(command); return 1;
     case Command::Show: return mediaelch::cli::show(app, parser);
+    case Command::Duplicates: return mediaelch::cli::duplicates(app, parser);
+    case Command::Scrape: return mediaelch::cli::scrape(app, parser);
+    case Command::Export: return mediaelch::cli::exportMedia(app, parser);
     case Command::Info: return mediaelch::cli::info(app, parser);
     case Command::Unknown:
         // do not process arguments so that we can show our custom help command
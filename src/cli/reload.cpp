@@ -1,63 +1,144 @@
 #include "cli/reload.h"
 
+#include "export/JsonLinesWriter.h"
+#include "export/TableWriter.h"
 #include "globals/Manager.h"
 #include "movies/file_searcher/MovieFileSearcher.h"
 
+#include <QElapsedTimer>
 #include <iostream>
 
+namespace {
+
+double itemsPerSecond(const mediaelch::cli::ReloadStage& stage)
+{
+    if (stage.duration.count() <= 0) {
+        return 0.;
+    }
+    return stage.items * 1000. / static_cast<double>(stage.duration.count());
+}
+
+} // namespace
+
 namespace mediaelch {
 namespace cli {
 
-void reloadMovies()
+QVector<ReloadStage> reloadMovies()
 {
-    Manager::instance()->movieFileSearcher()->setMovieDirectories(
-        Settings::instance()->directorySettings().movieDirectories());
-    Manager::instance()->movieFileSearcher()->reload(true);
-    std::cout << "Movies reloaded." << std::endl;
+    using namespace std::chrono;
+    MovieFileSearcher* searcher = Manager::instance()->movieFileSearcher();
+    searcher->setProcessEvents(false);
+    searcher->setMovieDirectories(Settings::instance()->directorySettings().movieDirectories());
+    searcher->reload(true);
+
+    // Movies are written in the database thread while their NFO files are
+    // parsed.  This is the time that is left after parsing is done.
+    QElapsedTimer timer;
+    timer.start();
+    Manager::instance()->database()->waitForPendingWrites();
+    const milliseconds storeDuration(timer.elapsed());
+
+    const MovieFileSearcher::ReloadStatistics& stats = searcher->lastReloadStatistics();
+    return {{"movie", "scan", stats.scan, stats.directories},
+        {"movie", "parse", stats.parse, stats.moviesFromDisk + stats.moviesFromCache},
+        {"movie", "store", storeDuration, stats.moviesFromDisk}};
 }
 
-void reloadTvShows()
+QVector<ReloadStage> reloadTvShows()
 {
     Manager::instance()->tvShowFileSearcher()->setTvShowDirectories(
         Settings::instance()->directorySettings().tvShowDirectories());
     // The global TvShowFilesWidget instance is set in its constructor...
     // TODO: Don't implicitly expect that it is instantiated somewhere.
     TvShowFilesWidget filesWidget;
+    QElapsedTimer timer;
+    timer.start();
     Manager::instance()->tvShowFileSearcher()->reload(true);
-    std::cout << "Concerts reloaded." << std::endl;
+    return {{"tvshow",
+        "total",
+        std::chrono::milliseconds(timer.elapsed()),
+        Manager::instance()->tvShowModel()->tvShows().size()}};
 }
 
-void reloadConcerts()
+QVector<ReloadStage> reloadConcerts()
 {
     Manager::instance()->concertFileSearcher()->setConcertDirectories(
         Settings::instance()->directorySettings().concertDirectories());
+    QElapsedTimer timer;
+    timer.start();
     Manager::instance()->concertFileSearcher()->reload(true);
-    std::cout << "Concerts reloaded." << std::endl;
+    return {{"concert",
+        "total",
+        std::chrono::milliseconds(timer.elapsed()),
+        Manager::instance()->concertModel()->concerts().size()}};
 }
 
-void reloadMusic()
+QVector<ReloadStage> reloadMusic()
 {
     Manager::instance()->musicFileSearcher()->setMusicDirectories(
         Settings::instance()->directorySettings().musicDirectories());
+    QElapsedTimer timer;
+    timer.start();
     Manager::instance()->musicFileSearcher()->reload(true);
-    std::cout << "Music reloaded." << std::endl;
+    return {{"music",
+        "total",
+        std::chrono::milliseconds(timer.elapsed()),
+        Manager::instance()->musicModel()->artists().size()}};
+}
+
+void printReloadStages(const QVector<ReloadStage>& stages, OutputFormat format)
+{
+    if (format == OutputFormat::Json) {
+        JsonLinesWriter writer(std::cout);
+        for (const ReloadStage& stage : stages) {
+            QJsonObject object;
+            object.insert("type", "reload");
+            object.insert("media", stage.media);
+            object.insert("stage", stage.stage);
+            object.insert("ms", static_cast<qint64>(stage.duration.count()));
+            object.insert("items", stage.items);
+            object.insert("itemsPerSecond", itemsPerSecond(stage));
+            writer.write(object);
+        }
+        return;
+    }
+
+    TableLayout layout;
+    layout.addColumn(TableColumn("Media", 8));
+    layout.addColumn(TableColumn("Stage", 8));
+    layout.addColumn(TableColumn("Time (ms)", 10, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Items", 8, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Items/s", 10, ColumnAlignment::Right));
+
+    TableWriter table(std::cout, layout);
+    table.writeHeading();
+    for (const ReloadStage& stage : stages) {
+        table.writeCell(stage.media);
+        table.writeCell(stage.stage);
+        table.writeCell(QString::number(stage.duration.count()));
+        table.writeCell(QString::number(stage.items));
+        table.writeCell(QString::number(itemsPerSecond(stage), 'f', 1));
+    }
+    std::cout << std::endl;
 }
 
 void reloadEntries(ReloadConfig config)
 {
+    QVector<ReloadStage> stages;
     switch (config.mediaType) {
-    case MediaType::Movie: reloadMovies(); break;
-    case MediaType::TvShow: reloadTvShows(); break;
-    case MediaType::Concert: reloadConcerts(); break;
-    case MediaType::Music: reloadMusic(); break;
+    case MediaType::Movie: stages << reloadMovies(); break;
+    case MediaType::TvShow: stages << reloadTvShows(); break;
+    case MediaType::Concert: stages << reloadConcerts(); break;
+    case MediaType::Music: stages << reloadMusic(); break;
     case MediaType::All:
-        reloadMovies();
-        reloadTvShows();
-        reloadConcerts();
-        reloadMusic();
+        stages << reloadMovies();
+        stages << reloadTvShows();
+        stages << reloadConcerts();
+        stages << reloadMusic();
         break;
     case MediaType::Unknown: break;
     }
+    printReloadStages(stages, config.format);
 }
 
 int reload(QApplication& app, QCommandLineParser& parser)
@@ -68,21 +149,31 @@ int reload(QApplication& app, QCommandLineParser& parser)
 
     QCommandLineOption typeOption(
         "type", R"(Media type. Either "all", "movie", "concert", "music" or "tvshow")", "mediatype", "all");
+    QCommandLineOption formatOption("format",
+        R"(Output format of the timings. Either "table" or "json" (one JSON object per line))",
+        "format",
+        "table");
 
     parser.addOption(typeOption);
+    parser.addOption(formatOption);
     parser.process(app);
 
     ReloadConfig config;
     config.mediaType = mediaTypeFromString(parser.value(typeOption));
+    config.format = outputFormatFromString(parser.value(formatOption));
 
     if (config.mediaType == MediaType::Unknown) {
         std::cerr << "Unknown media type: " << parser.value(typeOption).toStdString() << std::endl;
         return 1;
     }
+    if (config.format == OutputFormat::Unknown) {
+        std::cerr << "Unknown output format: " << parser.value(formatOption).toStdString() << std::endl;
+        return 1;
+    }
 
     reloadEntries(config);
 
-    return 1;
+    return 0;
 }
 
 
@@ -4,6 +4,9 @@
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QString>
+#include <QVector>
+#include <chrono>
 
 namespace mediaelch {
 namespace cli {
@@ -11,13 +14,24 @@ namespace cli {
 struct ReloadConfig
 {
     MediaType mediaType = MediaType::All;
+    OutputFormat format = OutputFormat::Table;
 };
 
-void reloadMovies();
-void reloadTvShows();
-void reloadConcerts();
-void reloadMusic();
+/// \brief Duration of a single stage of a reload, e.g. scanning movie directories.
+struct ReloadStage
+{
+    QString media;
+    QString stage;
+    std::chrono::milliseconds duration{0};
+    int items = 0;
+};
+
+QVector<ReloadStage> reloadMovies();
+QVector<ReloadStage> reloadTvShows();
+QVector<ReloadStage> reloadConcerts();
+QVector<ReloadStage> reloadMusic();
 
+void printReloadStages(const QVector<ReloadStage>& stages, OutputFormat format);
 void reloadEntries(ReloadConfig config);
 
 int reload(QApplication& app, QCommandLineParser& parser);
@@ -0,0 +1,453 @@
+#include "cli/scrape.h"
+
+#include "export/JsonLinesWriter.h"
+#include "globals/Globals.h"
+#include "globals/Manager.h"
+#include "movies/Movie.h"
+#include "movies/MovieScrapeItem.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "network/NetworkManager.h"
+#include "network/WebsiteCache.h"
+#include "scrapers/ScrapePipeline.h"
+#include "scrapers/movie/MovieScraper.h"
+#include "scrapers/tv_show/TvScraper.h"
+#include "settings/Settings.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+#include "tv_shows/TvShowScrapeItem.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonObject>
+#include <QMap>
+#include <QSet>
+#include <QTimer>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using mediaelch::scraper::ScrapePipelineItem;
+
+const QMap<QString, MovieScraperInfo> movieDetailNames = {{"title", MovieScraperInfo::Title},
+    {"tagline", MovieScraperInfo::Tagline},
+    {"rating", MovieScraperInfo::Rating},
+    {"released", MovieScraperInfo::Released},
+    {"runtime", MovieScraperInfo::Runtime},
+    {"certification", MovieScraperInfo::Certification},
+    {"trailer", MovieScraperInfo::Trailer},
+    {"overview", MovieScraperInfo::Overview},
+    {"poster", MovieScraperInfo::Poster},
+    {"backdrop", MovieScraperInfo::Backdrop},
+    {"actors", MovieScraperInfo::Actors},
+    {"genres", MovieScraperInfo::Genres},
+    {"studios", MovieScraperInfo::Studios},
+    {"countries", MovieScraperInfo::Countries},
+    {"writer", MovieScraperInfo::Writer},
+    {"director", MovieScraperInfo::Director},
+    {"tags", MovieScraperInfo::Tags},
+    {"extrafanarts", MovieScraperInfo::ExtraFanarts},
+    {"set", MovieScraperInfo::Set},
+    {"logo", MovieScraperInfo::Logo},
+    {"cdart", MovieScraperInfo::CdArt},
+    {"clearart", MovieScraperInfo::ClearArt},
+    {"banner", MovieScraperInfo::Banner},
+    {"thumb", MovieScraperInfo::Thumb}};
+
+const QMap<QString, ShowScraperInfo> showDetailNames = {{"actors", ShowScraperInfo::Actors},
+    {"banner", ShowScraperInfo::Banner},
+    {"certification", ShowScraperInfo::Certification},
+    {"fanart", ShowScraperInfo::Fanart},
+    {"firstaired", ShowScraperInfo::FirstAired},
+    {"genres", ShowScraperInfo::Genres},
+    {"network", ShowScraperInfo::Network},
+    {"overview", ShowScraperInfo::Overview},
+    {"poster", ShowScraperInfo::Poster},
+    {"rating", ShowScraperInfo::Rating},
+    {"seasonposter", ShowScraperInfo::SeasonPoster},
+    {"title", ShowScraperInfo::Title},
+    {"tags", ShowScraperInfo::Tags},
+    {"extraarts", ShowScraperInfo::ExtraArts},
+    {"seasonbackdrop", ShowScraperInfo::SeasonBackdrop},
+    {"seasonbanner", ShowScraperInfo::SeasonBanner},
+    {"extrafanarts", ShowScraperInfo::ExtraFanarts},
+    {"thumb", ShowScraperInfo::Thumb},
+    {"seasonthumb", ShowScraperInfo::SeasonThumb},
+    {"runtime", ShowScraperInfo::Runtime},
+    {"status", ShowScraperInfo::Status}};
+
+const QMap<QString, EpisodeScraperInfo> episodeDetailNames = {{"actors", EpisodeScraperInfo::Actors},
+    {"certification", EpisodeScraperInfo::Certification},
+    {"director", EpisodeScraperInfo::Director},
+    {"firstaired", EpisodeScraperInfo::FirstAired},
+    {"network", EpisodeScraperInfo::Network},
+    {"overview", EpisodeScraperInfo::Overview},
+    {"rating", EpisodeScraperInfo::Rating},
+    {"thumbnail", EpisodeScraperInfo::Thumbnail},
+    {"title", EpisodeScraperInfo::Title},
+    {"writer", EpisodeScraperInfo::Writer},
+    {"tags", EpisodeScraperInfo::Tags}};
+
+/// \brief Parses a comma separated list of detail names. "all" selects all supported details.
+/// Details that the scraper does not support are dropped with a warning.
+template<class Info>
+bool parseDetails(const QString& value,
+    const QMap<QString, Info>& names,
+    const QSet<Info>& supported,
+    QSet<Info>& details)
+{
+    if (value == "all") {
+        details = supported;
+        return true;
+    }
+    const QStringList entries = value.split(',', ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& entry : entries) {
+        const QString name = entry.trimmed().toLower();
+        if (!names.contains(name)) {
+            std::cerr << "Unknown detail: " << name.toStdString() << std::endl;
+            std::cerr << "Available details: " << names.keys().join(", ").toStdString() << std::endl;
+            return false;
+        }
+        if (!supported.contains(names.value(name))) {
+            std::cerr << "Detail is not supported by the scraper and is skipped: " << name.toStdString()
+                      << std::endl;
+            continue;
+        }
+        details.insert(names.value(name));
+    }
+    return !details.isEmpty();
+}
+
+QString stageToString(ScrapePipelineItem::Stage stage)
+{
+    switch (stage) {
+    case ScrapePipelineItem::Stage::Queued: return "queued";
+    case ScrapePipelineItem::Stage::Search: return "search";
+    case ScrapePipelineItem::Stage::Load: return "load";
+    case ScrapePipelineItem::Stage::Images: return "images";
+    case ScrapePipelineItem::Stage::Save: return "save";
+    case ScrapePipelineItem::Stage::Done: return "done";
+    case ScrapePipelineItem::Stage::Skipped: return "skipped";
+    case ScrapePipelineItem::Stage::Failed: return "failed";
+    }
+    return "unknown";
+}
+
+/// \brief Value at the given percentile of the sorted list.
+qint64 percentile(const QVector<qint64>& sorted, int percent)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    const int index = qBound(0, (sorted.size() * percent + 99) / 100 - 1, sorted.size() - 1);
+    return sorted.at(index);
+}
+
+} // namespace
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Prints progress and statistics of a ScrapePipeline.
+class ScrapeReporter
+{
+public:
+    ScrapeReporter(scraper::ScrapePipeline& pipeline, OutputFormat format) :
+        m_pipeline{pipeline}, m_format{format}, m_json{std::cout}
+    {
+        m_networkStart = network::NetworkManager::statistics();
+        m_cacheStart = scraper::WebsiteCache::statistics();
+        m_timer.start();
+    }
+
+    void onStageChanged(ScrapePipelineItem* item, ScrapePipelineItem::Stage stage)
+    {
+        if (m_format != OutputFormat::Json) {
+            return;
+        }
+        QJsonObject object;
+        object.insert("type", "stage");
+        object.insert("item", m_pipeline.items().indexOf(item));
+        object.insert("title", item->title());
+        object.insert("stage", stageToString(stage));
+        m_json.write(object);
+    }
+
+    void onItemFinished(ScrapePipelineItem* item)
+    {
+        ++m_finished;
+        if (item->stage() == ScrapePipelineItem::Stage::Done) {
+            m_latencies << item->elapsedMs();
+        }
+
+        if (m_format == OutputFormat::Json) {
+            QJsonObject object;
+            object.insert("type", "item");
+            object.insert("item", m_pipeline.items().indexOf(item));
+            object.insert("title", item->title());
+            object.insert("stage", stageToString(item->stage()));
+            object.insert("ms", item->elapsedMs());
+            object.insert("message", item->message());
+            m_json.write(object);
+            return;
+        }
+
+        std::cout << "[" << m_finished << "/" << m_pipeline.items().size() << "] " << std::left << std::setw(8)
+                  << stageToString(item->stage()).toStdString() << std::right << std::setw(8) << item->elapsedMs()
+                  << " ms  " << item->title().toStdString();
+        if (!item->message().isEmpty()) {
+            std::cout << " (" << item->message().toStdString() << ")";
+        }
+        std::cout << std::endl;
+    }
+
+    void printSummary()
+    {
+        const network::NetworkManager::Statistics network = network::NetworkManager::statistics();
+        const scraper::WebsiteCache::Statistics cache = scraper::WebsiteCache::statistics();
+
+        QMap<QString, int> stages;
+        for (const ScrapePipelineItem* item : m_pipeline.items()) {
+            ++stages[stageToString(item->stage())];
+        }
+        std::sort(m_latencies.begin(), m_latencies.end());
+        qint64 latencySum = 0;
+        for (qint64 latency : m_latencies) {
+            latencySum += latency;
+        }
+
+        QJsonObject summary;
+        summary.insert("type", "summary");
+        summary.insert("items", m_pipeline.items().size());
+        summary.insert("done", stages.value("done"));
+        summary.insert("skipped", stages.value("skipped"));
+        summary.insert("failed", stages.value("failed"));
+        summary.insert("ms", m_timer.elapsed());
+        summary.insert("requests", static_cast<qint64>(network.requests - m_networkStart.requests));
+        summary.insert("failedRequests", static_cast<qint64>(network.failedRequests - m_networkStart.failedRequests));
+        summary.insert("bytesReceived", network.bytesReceived - m_networkStart.bytesReceived);
+        summary.insert("cacheHits",
+            static_cast<qint64>(cache.memoryHits + cache.diskHits - m_cacheStart.memoryHits - m_cacheStart.diskHits));
+        summary.insert("cacheRevalidations", static_cast<qint64>(cache.revalidations - m_cacheStart.revalidations));
+        summary.insert("latencyAvgMs", m_latencies.isEmpty() ? 0 : latencySum / m_latencies.size());
+        summary.insert("latencyP50Ms", percentile(m_latencies, 50));
+        summary.insert("latencyP95Ms", percentile(m_latencies, 95));
+        summary.insert("latencyMaxMs", m_latencies.isEmpty() ? 0 : m_latencies.last());
+
+        if (m_format == OutputFormat::Json) {
+            m_json.write(summary);
+            return;
+        }
+        std::cout << std::endl << "Scrape statistics:" << std::endl;
+        for (auto it = summary.constBegin(); it != summary.constEnd(); ++it) {
+            if (it.key() != "type") {
+                std::cout << "  " << std::left << std::setw(20) << it.key().toStdString()
+                          << it.value().toVariant().toString().toStdString() << std::endl;
+            }
+        }
+    }
+
+private:
+    scraper::ScrapePipeline& m_pipeline;
+    OutputFormat m_format;
+    JsonLinesWriter m_json;
+    QElapsedTimer m_timer;
+    network::NetworkManager::Statistics m_networkStart;
+    scraper::WebsiteCache::Statistics m_cacheStart;
+    QVector<qint64> m_latencies;
+    int m_finished = 0;
+};
+
+static bool addMovieItems(const ScrapeConfig& config, scraper::ScrapePipeline& pipeline)
+{
+    scraper::MovieScraper* movieScraper = Manager::instance()->scrapers().movieScraper(config.scraperId);
+    if (movieScraper == nullptr) {
+        std::cerr << "Unknown movie scraper: " << config.scraperId.toStdString() << std::endl;
+        return false;
+    }
+
+    MovieScrapeItem::Config itemConfig;
+    itemConfig.scraper = movieScraper;
+    itemConfig.onlyWithId = config.onlyWithId;
+    itemConfig.saveToDisk = true;
+    if (!parseDetails(config.details, movieDetailNames, movieScraper->meta().supportedDetails, itemConfig.details)) {
+        std::cerr << "No details to scrape." << std::endl;
+        return false;
+    }
+
+    MovieFileSearcher* searcher = Manager::instance()->movieFileSearcher();
+    searcher->setProcessEvents(false);
+    searcher->setMovieDirectories(Settings::instance()->directorySettings().movieDirectories());
+    searcher->reload(false);
+
+    // infoLoaded() is known without reading the NFO.  MovieScrapeItem loads
+    // the details of the selected movies when they are scraped.
+    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+        if (config.includeScraped || !movie->controller()->infoLoaded()) {
+            pipeline.addItem(new MovieScrapeItem(movie, itemConfig));
+        }
+    }
+    return true;
+}
+
+static bool addTvShowItems(const ScrapeConfig& config, scraper::ScrapePipeline& pipeline)
+{
+    scraper::TvScraper* tvScraper = Manager::instance()->scrapers().tvScraper(config.scraperId);
+    if (tvScraper == nullptr) {
+        std::cerr << "Unknown TV scraper: " << config.scraperId.toStdString() << std::endl;
+        return false;
+    }
+
+    if (!tvScraper->isInitialized()) {
+        // TV scrapers are initialized asynchronously by the ScraperManager.
+        QEventLoop loop;
+        QObject::connect(tvScraper, &scraper::TvScraper::initialized, &loop, &QEventLoop::quit);
+        QTimer::singleShot(30 * 1000, &loop, &QEventLoop::quit);
+        if (!tvScraper->isInitialized()) {
+            loop.exec();
+        }
+        if (!tvScraper->isInitialized()) {
+            std::cerr << "Could not initialize TV scraper: " << config.scraperId.toStdString() << std::endl;
+            return false;
+        }
+    }
+
+    const auto& meta = tvScraper->meta();
+    TvScrapeConfig itemConfig;
+    itemConfig.scraper = tvScraper;
+    itemConfig.locale = Settings::instance()->scraperSettings(meta.identifier)->language(meta.defaultLocale);
+    itemConfig.onlyWithId = config.onlyWithId;
+    itemConfig.saveToDisk = true;
+    if (!parseDetails(config.details, showDetailNames, meta.supportedShowDetails, itemConfig.showDetails)
+        || !parseDetails(
+            config.episodeDetails, episodeDetailNames, meta.supportedEpisodeDetails, itemConfig.episodeDetails)) {
+        std::cerr << "No details to scrape." << std::endl;
+        return false;
+    }
+
+    Manager::instance()->tvShowFileSearcher()->setTvShowDirectories(
+        Settings::instance()->directorySettings().tvShowDirectories());
+    Manager::instance()->tvShowFileSearcher()->reload(false);
+
+    // Shows are queued first so that episodes can reuse their search results.
+    QVector<TvShowEpisode*> episodes;
+    for (TvShow* show : Manager::instance()->tvShowModel()->tvShows()) {
+        if (config.includeScraped || !show->infoLoaded()) {
+            pipeline.addItem(new TvShowScrapeItem(show, itemConfig));
+        }
+        for (TvShowEpisode* episode : show->episodes()) {
+            if (config.includeScraped || !episode->infoLoaded()) {
+                episodes << episode;
+            }
+        }
+    }
+    for (TvShowEpisode* episode : asConst(episodes)) {
+        pipeline.addItem(new TvShowEpisodeScrapeItem(episode, itemConfig));
+    }
+    return true;
+}
+
+static int scrapeEntries(const ScrapeConfig& config)
+{
+    scraper::ScrapePipeline pipeline;
+    pipeline.setConcurrency(
+        config.concurrency > 0 ? config.concurrency : Settings::instance()->advanced()->multiScrapeConcurrency());
+
+    // The global TvShowFilesWidget instance is set in its constructor...
+    // TODO: Don't implicitly expect that it is instantiated somewhere.
+    TvShowFilesWidget filesWidget;
+
+    const bool ok = config.mediaType == MediaType::Movie ? addMovieItems(config, pipeline)
+                                                         : addTvShowItems(config, pipeline);
+    if (!ok) {
+        return 1;
+    }
+
+    ScrapeReporter reporter(pipeline, config.format);
+    QObject::connect(&pipeline,
+        &scraper::ScrapePipeline::sigItemStageChanged,
+        &pipeline,
+        [&reporter](ScrapePipelineItem* item, ScrapePipelineItem::Stage stage) {
+            reporter.onStageChanged(item, stage);
+        });
+    QObject::connect(&pipeline,
+        &scraper::ScrapePipeline::sigItemFinished,
+        &pipeline,
+        [&reporter](ScrapePipelineItem* item) { reporter.onItemFinished(item); });
+
+    QEventLoop loop;
+    QObject::connect(&pipeline, &scraper::ScrapePipeline::sigFinished, &loop, &QEventLoop::quit);
+    pipeline.start();
+    loop.exec();
+
+    // NFO files are written by the items; the cache is updated in the database thread.
+    Manager::instance()->database()->waitForPendingWrites();
+    reporter.printSummary();
+    return 0;
+}
+
+int scrape(QApplication& app, QCommandLineParser& parser)
+{
+    parser.clearPositionalArguments();
+    // re-add this command so that it appears when help is printed
+    parser.addPositionalArgument("scrape", "Scrape all media items that have no NFO file.", "scrape [scrape_options]");
+
+    QCommandLineOption typeOption("type", R"(Media type. Either "movie" or "tvshow")", "mediatype", "movie");
+    QCommandLineOption scraperOption(
+        "scraper", R"(Scraper identifier, see "mediaelch-cli info movie_scrapers", e.g. "TMDb")", "id");
+    QCommandLineOption detailsOption("details",
+        R"(Comma separated list of movie or TV show details, e.g. "title,rating,poster". Default: "all")",
+        "details",
+        "all");
+    QCommandLineOption episodeDetailsOption("episode-details",
+        R"(Comma separated list of episode details, e.g. "title,thumbnail". Default: "all")",
+        "details",
+        "all");
+    QCommandLineOption concurrencyOption(
+        "concurrency", "Number of items that are scraped at the same time. Default: <multiScrapeConcurrency>", "n");
+    QCommandLineOption allOption("all", "Scrape items that already have an NFO file as well.");
+    QCommandLineOption onlyWithIdOption("only-with-id", "Skip items without an ID for the scraper.");
+    QCommandLineOption formatOption("format",
+        R"(Output format. Either "table" or "json" (one JSON object per line))",
+        "format",
+        "table");
+
+    parser.addOption(typeOption);
+    parser.addOption(scraperOption);
+    parser.addOption(detailsOption);
+    parser.addOption(episodeDetailsOption);
+    parser.addOption(concurrencyOption);
+    parser.addOption(allOption);
+    parser.addOption(onlyWithIdOption);
+    parser.addOption(formatOption);
+    parser.process(app);
+
+    ScrapeConfig config;
+    config.mediaType = mediaTypeFromString(parser.value(typeOption));
+    config.format = outputFormatFromString(parser.value(formatOption));
+    config.scraperId = parser.value(scraperOption);
+    config.details = parser.value(detailsOption);
+    config.episodeDetails = parser.value(episodeDetailsOption);
+    config.concurrency = parser.value(concurrencyOption).toInt();
+    config.includeScraped = parser.isSet(allOption);
+    config.onlyWithId = parser.isSet(onlyWithIdOption);
+
+    if (config.mediaType != MediaType::Movie && config.mediaType != MediaType::TvShow) {
+        std::cerr << "Unsupported media type: " << parser.value(typeOption).toStdString() << std::endl;
+        return 1;
+    }
+    if (config.format == OutputFormat::Unknown) {
+        std::cerr << "Unknown output format: " << parser.value(formatOption).toStdString() << std::endl;
+        return 1;
+    }
+    if (config.scraperId.isEmpty()) {
+        std::cerr << "Missing scraper identifier, use --scraper <id>" << std::endl;
+        return 1;
+    }
+
+    return scrapeEntries(config);
+}
+
+} // namespace cli
+} // namespace mediaelch
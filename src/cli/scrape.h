@@ -0,0 +1,30 @@
+#pragma once
+
+#include "cli/common.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QString>
+
+namespace mediaelch {
+namespace cli {
+
+struct ScrapeConfig
+{
+    MediaType mediaType = MediaType::Movie;
+    OutputFormat format = OutputFormat::Table;
+    QString scraperId;
+    /// \brief Comma separated detail names or "all", see scrape --help.
+    QString details = "all";
+    QString episodeDetails = "all";
+    int concurrency = 0;
+    /// \brief Scrape items that already have an NFO file as well.
+    bool includeScraped = false;
+    bool onlyWithId = false;
+};
+
+/// \brief Scrapes all unscraped movies or TV shows using a ScrapePipeline and saves them.
+int scrape(QApplication& app, QCommandLineParser& parser);
+
+} // namespace cli
+} // namespace mediaelch
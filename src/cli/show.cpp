@@ -2,20 +2,150 @@
 
 #include "Version.h"
 #include "cli/common.h"
+#include "cli/list.h"
+#include "concerts/Concert.h"
+#include "export/JsonLinesWriter.h"
 #include "globals/Manager.h"
+#include "movies/Movie.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "settings/Settings.h"
 
+#include <QJsonArray>
 #include <iomanip>
 #include <iostream>
 
+namespace {
+
+QJsonArray ratingsToJson(const QVector<Rating>& ratings)
+{
+    QJsonArray array;
+    for (const Rating& rating : ratings) {
+        QJsonObject object;
+        object.insert("source", rating.source);
+        object.insert("rating", rating.rating);
+        object.insert("votes", rating.voteCount);
+        array.append(object);
+    }
+    return array;
+}
+
+QJsonObject movieDetailsToJson(const Movie& movie)
+{
+    QJsonObject object = mediaelch::cli::movieToJson(movie);
+    object.insert("originalTitle", movie.originalName());
+    object.insert("tagline", movie.tagline());
+    object.insert("overview", movie.overview());
+    object.insert("released", movie.released().isValid() ? movie.released().toString("yyyy-MM-dd") : "");
+    object.insert("runtime", static_cast<int>(movie.runtime().count()));
+    object.insert("certification", movie.certification().toString());
+    object.insert("director", movie.director());
+    object.insert("writer", movie.writer());
+    object.insert("studios", QJsonArray::fromStringList(movie.studios()));
+    object.insert("countries", QJsonArray::fromStringList(movie.countries()));
+    object.insert("set", movie.set().name);
+    object.insert("ratings", ratingsToJson(movie.ratings()));
+    object.insert("watched", movie.watched());
+    return object;
+}
+
+bool matchesId(const QString& id, int databaseId, const QStringList& otherIds)
+{
+    bool isNumber = false;
+    const int number = id.toInt(&isNumber);
+    return (isNumber && number == databaseId) || otherIds.contains(id);
+}
+
+} // namespace
+
 namespace mediaelch {
 namespace cli {
 
+/// \brief Human readable value for the table output format.
+static QString jsonValueToText(const QJsonValue& value)
+{
+    if (value.isArray()) {
+        QStringList values;
+        for (const QJsonValue& entry : value.toArray()) {
+            values << jsonValueToText(entry);
+        }
+        return values.join(", ");
+    }
+    if (value.isObject()) {
+        // ratings
+        const QJsonObject object = value.toObject();
+        return object.value("source").toString() + ": " + QString::number(object.value("rating").toDouble());
+    }
+    return value.toVariant().toString();
+}
+
+static void printObject(const QJsonObject& object, OutputFormat format)
+{
+    if (format == OutputFormat::Json) {
+        JsonLinesWriter writer(std::cout);
+        writer.write(object);
+        return;
+    }
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        std::cout << std::left << std::setw(15) << (it.key() + ":").toStdString()
+                  << jsonValueToText(it.value()).toStdString() << "\n";
+    }
+    std::cout << std::endl;
+}
+
+static int showEntries(const ShowConfig& config)
+{
+    int found = 0;
+
+    Manager::instance()->movieFileSearcher()->setProcessEvents(false);
+    Manager::instance()->movieFileSearcher()->setMovieDirectories(
+        Settings::instance()->directorySettings().movieDirectories());
+    Manager::instance()->movieFileSearcher()->reload(false);
+    for (const Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
+        if (matchesId(config.id, movie->databaseId(), {movie->imdbId().toString(), movie->tmdbId().toString()})) {
+            printObject(movieDetailsToJson(*movie), config.format);
+            ++found;
+        }
+    }
+
+    Manager::instance()->concertFileSearcher()->setConcertDirectories(
+        Settings::instance()->directorySettings().concertDirectories());
+    Manager::instance()->concertFileSearcher()->reload(false);
+    for (const Concert* concert : Manager::instance()->concertModel()->concerts()) {
+        if (matchesId(config.id, concert->databaseId(), {concert->imdbId().toString()})) {
+            printObject(concertToJson(*concert), config.format);
+            ++found;
+        }
+    }
+
+    Manager::instance()->tvShowFileSearcher()->setTvShowDirectories(
+        Settings::instance()->directorySettings().tvShowDirectories());
+    // The global TvShowFilesWidget instance is set in its constructor...
+    // TODO: Don't implicitly expect that it is instantiated somewhere.
+    TvShowFilesWidget filesWidget;
+    Manager::instance()->tvShowFileSearcher()->reload(false);
+    for (const TvShow* show : Manager::instance()->tvShowModel()->tvShows()) {
+        if (show != nullptr
+            && matchesId(config.id, show->databaseId(), {show->imdbId().toString(), show->tvdbId().toString()})) {
+            printObject(tvShowToJson(*show), config.format);
+            ++found;
+        }
+    }
+
+    return found;
+}
+
 int show(QApplication& app, QCommandLineParser& parser)
 {
     parser.clearPositionalArguments();
     // re-add this command so that it appears when help is printed
     parser.addPositionalArgument("show", "Show a given media item", "show <id>");
     parser.addPositionalArgument("id", "media item id");
+
+    QCommandLineOption formatOption("format",
+        R"(Output format. Either "table" or "json" (one JSON object per line))",
+        "format",
+        "table");
+    parser.addOption(formatOption);
     parser.process(app);
 
     const QStringList args = parser.positionalArguments();
@@ -28,21 +158,18 @@ int show(QApplication& app, QCommandLineParser& parser)
 
     ShowConfig config;
     config.id = command;
+    config.format = outputFormatFromString(parser.value(formatOption));
 
-    std::cerr << "We don't support this command, yet!" << std::endl;
-
-    //    Manager::instance()->movieFileSearcher()->setMovieDirectories(
-    //        Settings::instance()->directorySettings().movieDirectories());
-    //    Manager::instance()->movieFileSearcher()->reload(false);
-    //    MovieModel* movieModel = Manager::instance()->movieModel();
-
-    //    for (Movie* movie : movieModel->movies()) {
-    //        if (movie->imdbId() == ImdbId(config.id)) {
-    //            std::cerr << movie->name().toStdString() << std::endl;
-    //        }
-    //    }
+    if (config.format == OutputFormat::Unknown) {
+        std::cerr << "Unknown output format: " << parser.value(formatOption).toStdString() << std::endl;
+        return 1;
+    }
 
-    return 1;
+    if (showEntries(config) == 0) {
+        std::cerr << "No media item with identifier: " << config.id.toStdString() << std::endl;
+        return 1;
+    }
+    return 0;
 }
 
 } // namespace cli
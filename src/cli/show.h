@@ -11,6 +11,7 @@ namespace cli {
 struct ShowConfig
 {
     QString id;
+    OutputFormat format = OutputFormat::Table;
 };
 
 int show(QApplication& app, QCommandLineParser& parser);
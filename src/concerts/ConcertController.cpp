@@ -29,6 +29,11 @@ ConcertController::ConcertController(Concert* parent) :
         static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection));
 }
 
+void ConcertController::setDownloadPriority(DownloadPriority priority)
+{
+    m_downloadManager->setPriority(priority);
+}
+
 Concert* ConcertController::concert()
 {
     return m_concert;
@@ -127,7 +132,7 @@ void ConcertController::loadData(TmdbId id,
 void ConcertController::loadStreamDetailsFromFile()
 {
     using namespace std::chrono;
-    m_concert->streamDetails()->loadStreamDetails();
+    Manager::instance()->mediaInfoProbeQueue()->loadStreamDetails(*m_concert->streamDetails());
     seconds runtime(
         m_concert->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     m_concert->setRuntime(duration_cast<minutes>(runtime));
@@ -34,6 +34,9 @@ public:
     QSet<ConcertScraperInfo> infosToLoad();
     bool infoLoaded() const;
     bool downloadsInProgress() const;
+    /// \brief Priority of this concert's image downloads compared to other items' downloads.
+    void setDownloadPriority(DownloadPriority priority);
+
     void loadImage(ImageType type, QUrl url);
     void loadImages(ImageType type, QVector<QUrl> urls);
     void abortDownloads();
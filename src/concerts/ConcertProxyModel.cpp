@@ -20,13 +20,18 @@ ConcertProxyModel::ConcertProxyModel(QObject* parent) : QSortFilterProxyModel(pa
 bool ConcertProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
 {
     Q_UNUSED(sourceParent);
-    QVector<Concert*> concerts = Manager::instance()->concertModel()->concerts();
-    if (sourceRow < 0 || sourceRow >= concerts.count()) {
+    ConcertModel* model = Manager::instance()->concertModel();
+    if (sourceRow < 0 || sourceRow >= model->rowCount()) {
         return true;
     }
 
-    Concert* concert = concerts.at(sourceRow);
-    for (Filter* filter : m_filters) {
+    Concert* concert = model->concert(sourceRow);
+    for (const QSet<const QObject*>& hits : m_searchHits) {
+        if (!hits.contains(concert)) {
+            return false;
+        }
+    }
+    for (Filter* filter : m_otherFilters) {
         if (!filter->accepts(concert)) {
             return false;
         }
@@ -48,7 +53,7 @@ bool ConcertProxyModel::lessThan(const QModelIndex& left, const QModelIndex& rig
         && sourceModel()->data(right, Qt::UserRole + 1).toBool()) {
         return false;
     }
-    int cmp = QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString());
+    int cmp = m_collationKeys.compare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString());
     return !(cmp < 0);
 }
 
@@ -59,4 +64,16 @@ void ConcertProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = filters;
     m_filterText = text;
+    m_searchHits.clear();
+    m_otherFilters.clear();
+
+    mediaelch::MediaSearchIndex* index = Manager::instance()->searchIndex();
+    index->addConcerts(Manager::instance()->concertModel()->concerts());
+    for (Filter* filter : m_filters) {
+        if (filter->isInfo(ConcertFilters::Title)) {
+            m_searchHits << index->search(filter->shortText(), mediaelch::MediaSearchIndex::Field::Title);
+        } else {
+            m_otherFilters << filter;
+        }
+    }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "globals/CollationKeys.h"
+
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 class Filter;
@@ -17,5 +20,9 @@ protected:
 
 private:
     QVector<Filter*> m_filters;
+    /// Hits of title filters in MediaSearchIndex.  A concert has to be part of each set.
+    QVector<QSet<const QObject*>> m_searchHits;
+    QVector<Filter*> m_otherFilters;
     QString m_filterText;
+    mutable mediaelch::CollationKeyCache m_collationKeys;
 };
@@ -1,6 +1,7 @@
 #include "Database.h"
 
 #include "concerts/Concert.h"
+#include "data/DatabaseWorker.h"
 #include "data/Subtitle.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
@@ -16,21 +17,467 @@
 #include <QDebug>
 #include <QDesktopServices>
 #include <QDir>
+#include <QPair>
+#include <QPointer>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
 
 using namespace mediaelch;
 
-Database::Database(QObject* parent) : QObject(parent)
+namespace {
+
+/// \brief Copy of a movie's cache entry. Unlike the movie, it can be written in any thread.
+struct MovieRow
+{
+    /// Values of the "movies" table without the path, see insertMovies().
+    QVariantList values;
+    /// Summary columns, see movieSummary().
+    QVariantList summary;
+    QVector<QByteArray> files;
+    /// Values of the "movieSubtitles" table without the movie ID.
+    QVector<QVariantList> subtitles;
+    int label = 0;
+};
+
+/// \brief Values of the summary columns (title, sortTitle, released, playcount, infoLoaded,
+///        hasActors, hasTrailer, hasStreamDetails, hasImdbId).
+/// \details The summary is enough to show the movie in the movie list, including its
+///          status columns.  It lets moviesInDirectory() skip the NFO contents, see
+///          lazyMovieLoading.
+QVariantList movieSummary(const Movie& movie)
+{
+    const MovieController::DetailsSummary details = movie.controller()->detailsSummary();
+    return QVariantList{movie.name(),
+        movie.sortTitle(),
+        movie.released().isValid() ? movie.released().toString("yyyy-MM-dd") : QString(""),
+        movie.playcount(),
+        movie.controller()->infoLoaded() ? 1 : 0,
+        details.hasActors ? 1 : 0,
+        details.hasTrailer ? 1 : 0,
+        details.streamDetailsLoaded ? 1 : 0,
+        details.hasImdbId ? 1 : 0};
+}
+
+/// \brief Values of the episode summary columns (title, firstAired, playcount, infoLoaded).
+/// \details Like movieSummary() but for episodes, see lazyEpisodeLoading.
+QVariantList episodeSummary(const TvShowEpisode& episode)
+{
+    return QVariantList{episode.title(),
+        episode.firstAired().isValid() ? episode.firstAired().toString("yyyy-MM-dd") : QString(""),
+        episode.playCount(),
+        episode.infoLoaded() ? 1 : 0};
+}
+
+MovieRow movieRow(const Movie& movie)
+{
+    MovieRow row;
+    row.values = QVariantList{movie.nfoContent().isEmpty() ? QByteArray("") : movie.nfoContent().toUtf8(),
+        movie.fileLastModified().isNull() ? QDateTime::currentDateTime() : movie.fileLastModified(),
+        movie.inSeparateFolder() ? 1 : 0,
+        movie.hasImage(ImageType::MoviePoster) ? 1 : 0,
+        movie.hasImage(ImageType::MovieBackdrop) ? 1 : 0,
+        movie.hasImage(ImageType::MovieLogo) ? 1 : 0,
+        movie.hasImage(ImageType::MovieClearArt) ? 1 : 0,
+        movie.hasImage(ImageType::MovieCdArt) ? 1 : 0,
+        movie.hasImage(ImageType::MovieBanner) ? 1 : 0,
+        movie.hasImage(ImageType::MovieThumb) ? 1 : 0,
+        movie.constImages().hasExtraFanarts() ? 1 : 0,
+        static_cast<int>(movie.discType())};
+    for (const mediaelch::FilePath& file : movie.files()) {
+        row.files << file.toString().toUtf8();
+    }
+    for (const Subtitle* subtitle : movie.subtitles()) {
+        row.subtitles << QVariantList{subtitle->files().join("%§%"),
+            subtitle->language().isEmpty() ? "" : subtitle->language(),
+            subtitle->forced() ? 1 : 0};
+    }
+    row.label = static_cast<int>(movie.label());
+    row.summary = movieSummary(movie);
+    return row;
+}
+
+/// \brief Sets the color label of the given files. Labels that don't exist yet are batch-inserted.
+void writeLabels(PreparedStatements& statements, const QVector<QPair<QByteArray, int>>& labels)
+{
+    QVector<QVariantList> newLabels;
+    QSqlQuery& update = statements.query("UPDATE labels SET color=:color WHERE fileName=:fileName");
+    for (const auto& label : labels) {
+        update.bindValue(":color", label.second);
+        update.bindValue(":fileName", label.first);
+        update.exec();
+        if (update.numRowsAffected() < 1) {
+            newLabels << QVariantList{label.second, label.first};
+        }
+    }
+    statements.insertRows("labels", {"color", "fileName"}, newLabels);
+}
+
+/// \brief Inserts the movies and returns their new IDs in the same order.
+/// \details Files, subtitles and labels of all movies are written with multi-row inserts.
+QVector<int> insertMovies(PreparedStatements& statements, const QVector<MovieRow>& rows, const QByteArray& path)
+{
+    QVector<int> ids;
+    ids.reserve(rows.size());
+    QVector<QVariantList> files;
+    QVector<QVariantList> subtitles;
+    QVector<QPair<QByteArray, int>> labels;
+
+    QSqlQuery& query = statements.query(
+        "INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
+        "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, "
+        "title, sortTitle, released, playcount, infoLoaded, hasActors, hasTrailer, hasStreamDetails, hasImdbId, path) "
+        "VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    for (const MovieRow& row : rows) {
+        int parameter = 0;
+        for (const QVariant& value : row.values) {
+            query.bindValue(parameter++, value);
+        }
+        for (const QVariant& value : row.summary) {
+            query.bindValue(parameter++, value);
+        }
+        query.bindValue(parameter, path);
+        if (!query.exec()) {
+            qWarning() << "[Database] Could not insert movie:" << query.lastError().text();
+        }
+        const int insertId = query.lastInsertId().toInt();
+        ids << insertId;
+
+        for (const QByteArray& file : row.files) {
+            files << QVariantList{insertId, file};
+            labels << qMakePair(file, row.label);
+        }
+        for (const QVariantList& subtitle : row.subtitles) {
+            subtitles << (QVariantList{insertId} + subtitle);
+        }
+    }
+
+    statements.insertRows("movieFiles", {"idMovie", "file"}, files);
+    statements.insertRows("movieSubtitles", {"idMovie", "files", "language", "forced"}, subtitles);
+    writeLabels(statements, labels);
+    return ids;
+}
+
+/// \brief Resolves the index of a column in a query's result.
+int columnIndex(const QSqlRecord& record, const char* name)
+{
+    const int index = record.indexOf(name);
+    if (index < 0) {
+        qCritical() << "[Database] Query result has no column" << name;
+    }
+    return index;
+}
+
+/// \brief Typed access to the current row of a query.
+/// \details Columns are accessed by index.  Indexes are resolved once per query
+///          by the *Columns structs below instead of calling QSqlRecord::indexOf()
+///          for every field of every row.
+class Row
+{
+public:
+    explicit Row(const QSqlQuery& query) : m_query{query} {}
+
+    int toInt(int column) const { return m_query.value(column).toInt(); }
+    bool toBool(int column) const { return toInt(column) == 1; }
+    QString toString(int column) const { return m_query.value(column).toString(); }
+    /// Paths and NFO contents are stored as UTF-8 encoded blobs.
+    QString fromUtf8(int column) const { return QString::fromUtf8(m_query.value(column).toByteArray()); }
+    QDateTime toDateTime(int column) const { return m_query.value(column).toDateTime(); }
+
+private:
+    const QSqlQuery& m_query;
+};
+
+struct MovieColumns
+{
+    explicit MovieColumns(const QSqlRecord& record) :
+        idMovie{columnIndex(record, "idMovie")},
+        content{columnIndex(record, "content")},
+        lastModified{columnIndex(record, "lastModified")},
+        inSeparateFolder{columnIndex(record, "inSeparateFolder")},
+        hasPoster{columnIndex(record, "hasPoster")},
+        hasBackdrop{columnIndex(record, "hasBackdrop")},
+        hasLogo{columnIndex(record, "hasLogo")},
+        hasClearArt{columnIndex(record, "hasClearArt")},
+        hasCdArt{columnIndex(record, "hasCdArt")},
+        hasBanner{columnIndex(record, "hasBanner")},
+        hasThumb{columnIndex(record, "hasThumb")},
+        hasExtraFanarts{columnIndex(record, "hasExtraFanarts")},
+        discType{columnIndex(record, "discType")},
+        file{columnIndex(record, "file")},
+        color{columnIndex(record, "color")},
+        title{columnIndex(record, "title")},
+        sortTitle{columnIndex(record, "sortTitle")},
+        released{columnIndex(record, "released")},
+        playcount{columnIndex(record, "playcount")},
+        infoLoaded{columnIndex(record, "infoLoaded")},
+        hasActors{columnIndex(record, "hasActors")},
+        hasTrailer{columnIndex(record, "hasTrailer")},
+        hasStreamDetails{columnIndex(record, "hasStreamDetails")},
+        hasImdbId{columnIndex(record, "hasImdbId")}
+    {
+    }
+
+    int idMovie;
+    int content;
+    int lastModified;
+    int inSeparateFolder;
+    int hasPoster;
+    int hasBackdrop;
+    int hasLogo;
+    int hasClearArt;
+    int hasCdArt;
+    int hasBanner;
+    int hasThumb;
+    int hasExtraFanarts;
+    int discType;
+    int file;
+    int color;
+    int title;
+    int sortTitle;
+    int released;
+    int playcount;
+    int infoLoaded;
+    int hasActors;
+    int hasTrailer;
+    int hasStreamDetails;
+    int hasImdbId;
+};
+
+Movie* decodeMovie(const Row& row, const MovieColumns& columns, QObject* parent)
+{
+    auto* movie = new Movie(QStringList(), parent);
+    movie->setDatabaseId(row.toInt(columns.idMovie));
+    movie->setFileLastModified(row.toDateTime(columns.lastModified));
+    movie->setInSeparateFolder(row.toBool(columns.inSeparateFolder));
+    movie->setNfoContent(row.fromUtf8(columns.content));
+    movie->images().setHasImage(ImageType::MoviePoster, row.toBool(columns.hasPoster));
+    movie->images().setHasImage(ImageType::MovieBackdrop, row.toBool(columns.hasBackdrop));
+    movie->images().setHasImage(ImageType::MovieLogo, row.toBool(columns.hasLogo));
+    movie->images().setHasImage(ImageType::MovieClearArt, row.toBool(columns.hasClearArt));
+    movie->images().setHasImage(ImageType::MovieCdArt, row.toBool(columns.hasCdArt));
+    movie->images().setHasImage(ImageType::MovieBanner, row.toBool(columns.hasBanner));
+    movie->images().setHasImage(ImageType::MovieThumb, row.toBool(columns.hasThumb));
+    movie->images().setHasExtraFanarts(row.toBool(columns.hasExtraFanarts));
+    movie->setDiscType(static_cast<DiscType>(row.toInt(columns.discType)));
+    movie->setLabel(static_cast<ColorLabel>(row.toInt(columns.color)));
+    movie->setChanged(false);
+    return movie;
+}
+
+/// \brief Fills the movie from the summary columns instead of its NFO contents.
+/// \details Only used if the row has a summary, i.e. infoLoaded is not negative.
+///          The NFO contents are loaded by MovieController::loadDetails().
+void decodeMovieSummary(const Row& row, const MovieColumns& columns, Movie* movie)
+{
+    movie->blockSignals(true);
+    movie->setName(row.toString(columns.title));
+    movie->setSortTitle(row.toString(columns.sortTitle));
+    movie->setReleased(QDate::fromString(row.toString(columns.released), "yyyy-MM-dd"));
+    movie->setPlayCount(row.toInt(columns.playcount));
+    movie->setChanged(false);
+    movie->blockSignals(false);
+
+    MovieController::DetailsSummary details;
+    details.hasActors = row.toBool(columns.hasActors);
+    details.hasTrailer = row.toBool(columns.hasTrailer);
+    details.streamDetailsLoaded = row.toBool(columns.hasStreamDetails);
+    details.hasImdbId = row.toBool(columns.hasImdbId);
+    movie->controller()->setDetailsPending(row.toBool(columns.infoLoaded), details);
+}
+
+struct SubtitleColumns
+{
+    explicit SubtitleColumns(const QSqlRecord& record) :
+        idMovie{columnIndex(record, "idMovie")},
+        files{columnIndex(record, "files")},
+        language{columnIndex(record, "language")},
+        forced{columnIndex(record, "forced")}
+    {
+    }
+
+    int idMovie;
+    int files;
+    int language;
+    int forced;
+};
+
+Subtitle* decodeSubtitle(const Row& row, const SubtitleColumns& columns, Movie* movie)
+{
+    auto* subtitle = new Subtitle(movie);
+    subtitle->setForced(row.toBool(columns.forced));
+    subtitle->setLanguage(row.toString(columns.language));
+    subtitle->setFiles(row.toString(columns.files).split("%§%"));
+    subtitle->setChanged(false);
+    return subtitle;
+}
+
+/// \brief Columns of the *Files tables: the ID of the media item and the file.
+struct FileColumns
+{
+    FileColumns(const QSqlRecord& record, const char* idColumn) :
+        id{columnIndex(record, idColumn)}, file{columnIndex(record, "file")}
+    {
+    }
+
+    int id;
+    int file;
+};
+
+/// \brief Reads all files of an executed query, grouped by the media item's ID.
+QHash<int, QStringList> decodeFiles(QSqlQuery& query, const char* idColumn)
+{
+    QHash<int, QStringList> files;
+    const FileColumns columns(query.record(), idColumn);
+    const Row row(query);
+    while (query.next()) {
+        files[row.toInt(columns.id)] << row.fromUtf8(columns.file);
+    }
+    return files;
+}
+
+struct ConcertColumns
+{
+    explicit ConcertColumns(const QSqlRecord& record) :
+        idConcert{columnIndex(record, "idConcert")},
+        content{columnIndex(record, "content")},
+        inSeparateFolder{columnIndex(record, "inSeparateFolder")}
+    {
+    }
+
+    int idConcert;
+    int content;
+    int inSeparateFolder;
+};
+
+Concert* decodeConcert(const Row& row, const ConcertColumns& columns, const QStringList& files, QObject* parent)
+{
+    auto* concert = new Concert(files, parent);
+    concert->setDatabaseId(row.toInt(columns.idConcert));
+    concert->setInSeparateFolder(row.toBool(columns.inSeparateFolder));
+    concert->setNfoContent(row.fromUtf8(columns.content));
+    return concert;
+}
+
+struct ShowColumns
+{
+    explicit ShowColumns(const QSqlRecord& record) :
+        idShow{columnIndex(record, "idShow")}, dir{columnIndex(record, "dir")}, content{columnIndex(record, "content")}
+    {
+    }
+
+    int idShow;
+    int dir;
+    int content;
+};
+
+TvShow* decodeShow(const Row& row, const ShowColumns& columns, TvShowFileSearcher* parent)
+{
+    auto* show = new TvShow(row.fromUtf8(columns.dir), parent);
+    show->setDatabaseId(row.toInt(columns.idShow));
+    show->setNfoContent(row.fromUtf8(columns.content));
+    return show;
+}
+
+struct EpisodeColumns
+{
+    explicit EpisodeColumns(const QSqlRecord& record) :
+        idEpisode{columnIndex(record, "idEpisode")},
+        content{columnIndex(record, "content")},
+        seasonNumber{columnIndex(record, "seasonNumber")},
+        episodeNumber{columnIndex(record, "episodeNumber")}
+    {
+    }
+
+    int idEpisode;
+    int content;
+    int seasonNumber;
+    int episodeNumber;
+};
+
+TvShowEpisode* decodeEpisode(const Row& row, const EpisodeColumns& columns, const QStringList& files, TvShow* show)
+{
+    auto* episode = new TvShowEpisode(files, show);
+    episode->setSeason(SeasonNumber(row.toInt(columns.seasonNumber)));
+    episode->setEpisode(EpisodeNumber(row.toInt(columns.episodeNumber)));
+    episode->setNfoContent(row.fromUtf8(columns.content));
+    return episode;
+}
+
+/// \brief Summary columns of the "episodes" table, see episodeSummary().
+struct EpisodeSummaryColumns
+{
+    explicit EpisodeSummaryColumns(const QSqlRecord& record) :
+        title{columnIndex(record, "title")},
+        firstAired{columnIndex(record, "firstAired")},
+        playcount{columnIndex(record, "playcount")},
+        infoLoaded{columnIndex(record, "infoLoaded")}
+    {
+    }
+
+    int title;
+    int firstAired;
+    int playcount;
+    int infoLoaded;
+};
+
+/// \brief Fills the episode from the summary columns instead of its NFO contents.
+/// \details Only used if the row has a summary, i.e. infoLoaded is not negative.
+///          The NFO contents are loaded by TvShowEpisode::loadDetails().
+void decodeEpisodeSummary(const Row& row, const EpisodeSummaryColumns& columns, TvShowEpisode* episode)
+{
+    episode->blockSignals(true);
+    episode->setTitle(row.toString(columns.title));
+    episode->setFirstAired(QDate::fromString(row.toString(columns.firstAired), "yyyy-MM-dd"));
+    episode->setPlayCount(row.toInt(columns.playcount));
+    episode->setChanged(false);
+    episode->blockSignals(false);
+    episode->setDetailsPending(row.toBool(columns.infoLoaded));
+}
+
+/// \brief Columns of the "artists" and "albums" tables.
+struct MusicColumns
+{
+    MusicColumns(const QSqlRecord& record, const char* idColumn) :
+        id{columnIndex(record, idColumn)}, content{columnIndex(record, "content")}, dir{columnIndex(record, "dir")}
+    {
+    }
+
+    int id;
+    int content;
+    int dir;
+};
+
+template<class T>
+T* decodeMusicItem(const Row& row, const MusicColumns& columns, MusicFileSearcher* parent)
+{
+    auto* item = new T(row.fromUtf8(columns.dir), parent);
+    item->setDatabaseId(row.toInt(columns.id));
+    item->setNfoContent(row.fromUtf8(columns.content));
+    return item;
+}
+
+QString defaultDatabaseFile()
 {
     mediaelch::DirectoryPath dataLocation = Settings::instance()->databaseDir();
     QDir dir(dataLocation.dir());
     if (!dir.exists()) {
         dir.mkpath(dataLocation.toString());
     }
-    m_db = new QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", "mediaDb"));
-    m_db->setDatabaseName(dataLocation.filePath("MediaElch.sqlite"));
+    return dataLocation.filePath("MediaElch.sqlite");
+}
+
+} // namespace
+
+Database::Database(QObject* parent) : Database(defaultDatabaseFile(), "mediaDb", parent)
+{
+}
+
+Database::Database(const QString& databaseFile, const QString& connectionName, QObject* parent) : QObject(parent)
+{
+    m_db = new QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", connectionName));
+    m_db->setDatabaseName(databaseFile);
+    m_statements = std::make_unique<PreparedStatements>(*m_db);
     if (!m_db->open()) {
         qWarning() << "Could not open cache database";
     } else {
@@ -218,15 +665,106 @@ Database::Database(QObject* parent) : QObject(parent)
             query.exec();
 
             myDbVersion = 16;
-            Q_UNUSED(myDbVersion);
             updateDbVersion(16);
         }
 
-        query.prepare("PRAGMA synchronous=0;");
-        query.exec();
+        if (myDbVersion < 17) {
+            query.prepare("DROP TABLE IF EXISTS movieDirectorySnapshots;");
+            query.exec();
 
-        query.prepare("PRAGMA cache_size=20000;");
-        query.exec();
+            query.prepare("CREATE TABLE IF NOT EXISTS movieDirectorySnapshots( "
+                          "\"idSnapshot\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
+                          "\"path\" text NOT NULL, "
+                          "\"dir\" text NOT NULL, "
+                          "\"lastModified\" integer NOT NULL, "
+                          "\"inode\" integer NOT NULL "
+                          ");");
+            query.exec();
+            query.prepare("CREATE INDEX id_snapshot_path_idx ON movieDirectorySnapshots(path);");
+            query.exec();
+
+            myDbVersion = 17;
+            updateDbVersion(17);
+        }
+
+        if (myDbVersion < 18) {
+            // The index of version 14 was created on the wrong table.  Labels are
+            // looked up by file name for every movie that is written to the cache.
+            query.prepare("CREATE INDEX IF NOT EXISTS id_label_file_name_idx ON labels(fileName);");
+            query.exec();
+
+            myDbVersion = 18;
+            updateDbVersion(18);
+        }
+
+        if (myDbVersion < 19) {
+            // Summary of each movie for lazyMovieLoading.  Existing rows have no
+            // summary (infoLoaded=-1) and are loaded from their NFO contents.
+            query.prepare("ALTER TABLE movies ADD COLUMN \"title\" text NOT NULL DEFAULT '';");
+            query.exec();
+            query.prepare("ALTER TABLE movies ADD COLUMN \"sortTitle\" text NOT NULL DEFAULT '';");
+            query.exec();
+            query.prepare("ALTER TABLE movies ADD COLUMN \"released\" text NOT NULL DEFAULT '';");
+            query.exec();
+            query.prepare("ALTER TABLE movies ADD COLUMN \"playcount\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            query.prepare("ALTER TABLE movies ADD COLUMN \"infoLoaded\" integer NOT NULL DEFAULT -1;");
+            query.exec();
+
+            myDbVersion = 19;
+            updateDbVersion(19);
+        }
+
+        if (myDbVersion < 20) {
+            // Stream details of media files keyed by their identity, see MediaInfoProbeQueue.
+            query.prepare("CREATE TABLE IF NOT EXISTS mediaInfoProbes ( "
+                          "\"path\" text PRIMARY KEY, "
+                          "\"size\" integer NOT NULL, "
+                          "\"lastModified\" integer NOT NULL, "
+                          "\"details\" text NOT NULL);");
+            query.exec();
+
+            myDbVersion = 20;
+            updateDbVersion(20);
+        }
+
+        if (myDbVersion < 21) {
+            // Summary of each episode for lazyEpisodeLoading, see version 19 for movies.
+            query.prepare("ALTER TABLE episodes ADD COLUMN \"title\" text NOT NULL DEFAULT '';");
+            query.exec();
+            query.prepare("ALTER TABLE episodes ADD COLUMN \"firstAired\" text NOT NULL DEFAULT '';");
+            query.exec();
+            query.prepare("ALTER TABLE episodes ADD COLUMN \"playcount\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            query.prepare("ALTER TABLE episodes ADD COLUMN \"infoLoaded\" integer NOT NULL DEFAULT -1;");
+            query.exec();
+
+            myDbVersion = 21;
+            updateDbVersion(21);
+        }
+
+        if (myDbVersion < 22) {
+            // Media status columns of the movie list are part of the summary, see version 19.
+            // Existing summaries don't have them; such movies are loaded from their NFO
+            // contents once and get a new summary.
+            query.prepare("ALTER TABLE movies ADD COLUMN \"hasActors\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            query.prepare("ALTER TABLE movies ADD COLUMN \"hasTrailer\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            query.prepare("ALTER TABLE movies ADD COLUMN \"hasStreamDetails\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            query.prepare("ALTER TABLE movies ADD COLUMN \"hasImdbId\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            query.prepare("UPDATE movies SET infoLoaded=-1;");
+            query.exec();
+
+            myDbVersion = 22;
+            Q_UNUSED(myDbVersion);
+            updateDbVersion(22);
+        }
+
+        DatabaseWorker::configureConnection(*m_db);
+        m_worker = new DatabaseWorker(m_db->databaseName(), this);
     }
 }
 
@@ -235,10 +773,16 @@ Database::Database(QObject* parent) : QObject(parent)
  */
 Database::~Database()
 {
+    // The worker has its own connection but must finish writing before we're gone.
+    delete m_worker;
+    m_worker = nullptr;
+    m_statements.reset();
     if ((m_db != nullptr) && m_db->isOpen()) {
+        const QString connectionName = m_db->connectionName();
         m_db->close();
         delete m_db;
         m_db = nullptr;
+        QSqlDatabase::removeDatabase(connectionName);
     }
 }
 
@@ -289,6 +833,7 @@ void Database::commit()
 
 void Database::clearAllMovies()
 {
+    waitForPendingWrites();
     QSqlQuery query(db());
     query.prepare("DELETE FROM movies");
     query.exec();
@@ -302,10 +847,13 @@ void Database::clearAllMovies()
     query.exec();
     query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
     query.exec();
+    query.prepare("DELETE FROM movieDirectorySnapshots");
+    query.exec();
 }
 
 void Database::clearMoviesInDirectory(DirectoryPath path)
 {
+    waitForPendingWrites();
     QSqlQuery query(db());
     query.prepare("DELETE FROM movieFiles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
     query.bindValue(":path", path.toString().toUtf8());
@@ -316,61 +864,85 @@ void Database::clearMoviesInDirectory(DirectoryPath path)
     query.prepare("DELETE FROM movies WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    // Snapshots are only valid as long as the cached movies are.
+    query.prepare("DELETE FROM movieDirectorySnapshots WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
 }
 
 void Database::add(Movie* movie, DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
-                  "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
-                  "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
-                  ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
-    query.bindValue(
-        ":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
-    query.bindValue(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
-    query.bindValue(":hasPoster", movie->hasImage(ImageType::MoviePoster) ? 1 : 0);
-    query.bindValue(":hasBackdrop", movie->hasImage(ImageType::MovieBackdrop) ? 1 : 0);
-    query.bindValue(":hasLogo", movie->hasImage(ImageType::MovieLogo) ? 1 : 0);
-    query.bindValue(":hasClearArt", movie->hasImage(ImageType::MovieClearArt) ? 1 : 0);
-    query.bindValue(":hasCdArt", movie->hasImage(ImageType::MovieCdArt) ? 1 : 0);
-    query.bindValue(":hasBanner", movie->hasImage(ImageType::MovieBanner) ? 1 : 0);
-    query.bindValue(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
-    query.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
-    query.bindValue(":discType", static_cast<int>(movie->discType()));
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    int insertId = query.lastInsertId().toInt();
+    waitForPendingWrites();
+    const QVector<int> ids = insertMovies(*m_statements, {movieRow(*movie)}, path.toString().toUtf8());
+    movie->setDatabaseId(ids.first());
+}
 
-    for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+void Database::addAsync(const QVector<Movie*>& movies, DirectoryPath path)
+{
+    if (movies.isEmpty()) {
+        return;
+    }
+    if (m_worker == nullptr) {
+        transaction();
+        for (Movie* movie : movies) {
+            add(movie, path);
+        }
+        commit();
+        return;
     }
 
-    for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
+    QVector<MovieRow> rows;
+    QVector<QPointer<Movie>> guards;
+    rows.reserve(movies.size());
+    guards.reserve(movies.size());
+    for (Movie* movie : movies) {
+        rows << movieRow(*movie);
+        guards << movie;
     }
 
-    setLabel(movie->files(), movie->label());
+    auto ids = std::make_shared<QVector<int>>();
+    const QByteArray pathData = path.toString().toUtf8();
+    m_worker->enqueue(
+        [rows, pathData, ids](PreparedStatements& statements) { *ids = insertMovies(statements, rows, pathData); },
+        [guards, ids]() {
+            for (int i = 0; i < guards.size() && i < ids->size(); ++i) {
+                if (!guards[i].isNull()) {
+                    guards[i]->setDatabaseId(ids->at(i));
+                }
+            }
+        });
+}
 
-    movie->setDatabaseId(insertId);
+void Database::waitForPendingWrites()
+{
+    if (m_worker != nullptr) {
+        m_worker->waitForDone();
+    }
 }
 
 void Database::update(Movie* movie)
 {
+    waitForPendingWrites();
     QSqlQuery query(db());
-    query.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
+    // Movies whose details were not loaded yet don't have their NFO contents.
+    if (!movie->controller()->detailsPending()) {
+        const QVariantList summary = movieSummary(*movie);
+        query.prepare("UPDATE movies SET content=:content, title=:title, sortTitle=:sortTitle, released=:released, "
+                      "playcount=:playcount, infoLoaded=:infoLoaded, hasActors=:hasActors, hasTrailer=:hasTrailer, "
+                      "hasStreamDetails=:hasStreamDetails, hasImdbId=:hasImdbId WHERE idMovie=:idMovie");
+        query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
+        query.bindValue(":title", summary.at(0));
+        query.bindValue(":sortTitle", summary.at(1));
+        query.bindValue(":released", summary.at(2));
+        query.bindValue(":playcount", summary.at(3));
+        query.bindValue(":infoLoaded", summary.at(4));
+        query.bindValue(":hasActors", summary.at(5));
+        query.bindValue(":hasTrailer", summary.at(6));
+        query.bindValue(":hasStreamDetails", summary.at(7));
+        query.bindValue(":hasImdbId", summary.at(8));
+        query.bindValue(":idMovie", movie->databaseId());
+        query.exec();
+    }
 
     query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
     query.bindValue(":idMovie", movie->databaseId());
@@ -396,14 +968,22 @@ void Database::update(Movie* movie)
     }
 }
 
-QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
+QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, bool summaryOnly)
 {
+    waitForPendingWrites();
     transaction();
     QSqlQuery query(db());
-    query.prepare("SELECT M.idMovie, M.content, M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, "
-                  "M.hasLogo, M.hasClearArt, "
-                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, MF.file, L.color "
-                  "FROM movies M "
+    // Rows without a summary always need their NFO contents.
+    const QString content =
+        summaryOnly ? QStringLiteral("CASE WHEN M.infoLoaded < 0 THEN M.content ELSE '' END AS content")
+                    : QStringLiteral("M.content");
+    query.prepare("SELECT M.idMovie, " + content
+                  + ", M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, "
+                    "M.hasLogo, M.hasClearArt, "
+                    "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, "
+                    "M.title, M.sortTitle, M.released, M.playcount, M.infoLoaded, "
+                    "M.hasActors, M.hasTrailer, M.hasStreamDetails, M.hasImdbId, MF.file, L.color "
+                    "FROM movies M "
                   "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
                   "LEFT JOIN labels L ON MF.file=L.fileName "
                   "WHERE path=:path "
@@ -412,68 +992,200 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
     query.exec();
 
     QMap<int, Movie*> movies;
-    while (query.next()) {
-        Movie* movie = nullptr;
-        if (movies.contains(query.value(query.record().indexOf("idMovie")).toInt())) {
-            movie = movies.value(query.value(query.record().indexOf("idMovie")).toInt());
+    QHash<int, QStringList> files;
+    {
+        const MovieColumns columns(query.record());
+        const Row row(query);
+        MovieFileSearcher* movieFileSearcher = Manager::instance()->movieFileSearcher();
+        while (query.next()) {
+            const int idMovie = row.toInt(columns.idMovie);
+            if (!movies.contains(idMovie)) {
+                Movie* movie = decodeMovie(row, columns, movieFileSearcher);
+                if (summaryOnly && row.toInt(columns.infoLoaded) >= 0) {
+                    decodeMovieSummary(row, columns, movie);
+                }
+                movies.insert(idMovie, movie);
+            }
+            files[idMovie] << row.fromUtf8(columns.file);
+        }
+    }
+    for (auto it = movies.constBegin(); it != movies.constEnd(); ++it) {
+        it.value()->setFiles(files.value(it.key()));
+    }
+
+    query.prepare("SELECT idMovie, files, language, forced FROM movieSubtitles "
+                  "WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
+    {
+        const SubtitleColumns columns(query.record());
+        const Row row(query);
+        while (query.next()) {
+            Movie* movie = movies.value(row.toInt(columns.idMovie), nullptr);
             if (movie == nullptr) {
-                // This *must* not happen because we just inserted it.
-                qCritical() << "[Database] Movie is undefined but should exist!";
                 continue;
             }
+            movie->addSubtitle(decodeSubtitle(row, columns, movie), true);
+        }
+    }
+
+    commit();
 
-        } else {
-            ColorLabel label = static_cast<ColorLabel>(query.value(query.record().indexOf("color")).toInt());
-            movie = new Movie(QStringList(), Manager::instance()->movieFileSearcher());
-            movie->setDatabaseId(query.value(query.record().indexOf("idMovie")).toInt());
-            movie->setFileLastModified(query.value(query.record().indexOf("lastModified")).toDateTime());
-            movie->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-            movie->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-            movie->images().setHasImage(
-                ImageType::MoviePoster, query.value(query.record().indexOf("hasPoster")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieBackdrop, query.value(query.record().indexOf("hasBackdrop")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieLogo, query.value(query.record().indexOf("hasLogo")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieClearArt, query.value(query.record().indexOf("hasClearArt")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieCdArt, query.value(query.record().indexOf("hasCdArt")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieBanner, query.value(query.record().indexOf("hasBanner")).toInt() == 1);
-            movie->images().setHasImage(
-                ImageType::MovieThumb, query.value(query.record().indexOf("hasThumb")).toInt() == 1);
-            movie->images().setHasExtraFanarts(query.value(query.record().indexOf("hasExtraFanarts")).toInt() == 1);
-            movie->setDiscType(static_cast<DiscType>(query.value(query.record().indexOf("discType")).toInt()));
-            movie->setLabel(label);
-            movie->setChanged(false);
-            movies.insert(query.value(query.record().indexOf("idMovie")).toInt(), movie);
+    return movies.values().toVector();
+}
+
+QString Database::movieNfoContent(int idMovie)
+{
+    return movieNfoContents({idMovie}).value(idMovie);
+}
+
+QHash<int, QString> Database::movieNfoContents(const QVector<int>& idMovies)
+{
+    waitForPendingWrites();
+    QHash<int, QString> contents;
+    QSqlQuery query(db());
+    query.prepare("SELECT idMovie, content FROM movies WHERE idMovie=:idMovie");
+    for (int idMovie : idMovies) {
+        query.bindValue(":idMovie", idMovie);
+        query.exec();
+        if (query.next()) {
+            contents.insert(idMovie, QString::fromUtf8(query.value(1).toByteArray()));
         }
+    }
+    return contents;
+}
 
-        mediaelch::FileList files = movie->files();
-        files << mediaelch::FilePath(query.value(query.record().indexOf("file")).toByteArray());
-        movie->setFiles(files);
+void Database::updateMovieSummaries(const QVector<Movie*>& movies)
+{
+    if (movies.isEmpty()) {
+        return;
+    }
+    QVector<QVariantList> rows;
+    rows.reserve(movies.size());
+    for (const Movie* movie : movies) {
+        if (movie->databaseId() >= 0 && !movie->controller()->detailsPending()) {
+            QVariantList row = movieSummary(*movie);
+            row << movie->databaseId();
+            rows << row;
+        }
+    }
+    const auto write = [rows](PreparedStatements& statements) {
+        QSqlQuery& query = statements.query("UPDATE movies SET title=?, sortTitle=?, released=?, playcount=?, "
+                                            "infoLoaded=?, hasActors=?, hasTrailer=?, hasStreamDetails=?, "
+                                            "hasImdbId=? WHERE idMovie=?");
+        for (const QVariantList& row : rows) {
+            for (int i = 0; i < row.size(); ++i) {
+                query.bindValue(i, row.at(i));
+            }
+            query.exec();
+        }
+    };
+    if (m_worker == nullptr) {
+        transaction();
+        write(*m_statements);
+        commit();
+    } else {
+        m_worker->enqueue(write);
     }
+}
 
-    query.prepare("SELECT idMovie, files, language, forced FROM movieSubtitles");
+void Database::remove(Movie* movie)
+{
+    waitForPendingWrites();
+    if (movie->databaseId() < 0) {
+        return;
+    }
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+    query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+    query.prepare("DELETE FROM movies WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+    movie->setDatabaseId(-1);
+}
+
+QHash<QString, DirectorySnapshot> Database::movieDirectorySnapshots(DirectoryPath path)
+{
+    QHash<QString, DirectorySnapshot> snapshots;
+    QSqlQuery query(db());
+    query.prepare("SELECT dir, lastModified, inode FROM movieDirectorySnapshots WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
     query.exec();
     while (query.next()) {
-        int movieId = query.value(query.record().indexOf("idMovie")).toInt();
-        Movie* movie = movies.value(movieId, nullptr);
-        if (movie == nullptr) {
-            continue;
-        }
-        auto* subtitle = new Subtitle(movie);
-        subtitle->setForced(query.value(query.record().indexOf("forced")).toInt() == 1);
-        subtitle->setLanguage(query.value(query.record().indexOf("language")).toString());
-        subtitle->setFiles(query.value(query.record().indexOf("files")).toString().split("%§%"));
-        subtitle->setChanged(false);
-        movie->addSubtitle(subtitle, true);
+        DirectorySnapshot snapshot;
+        snapshot.lastModified = query.value(1).toLongLong();
+        snapshot.inode = query.value(2).toULongLong();
+        snapshots.insert(QString::fromUtf8(query.value(0).toByteArray()), snapshot);
     }
+    return snapshots;
+}
+
+void Database::setMovieDirectorySnapshots(DirectoryPath path, const QHash<QString, DirectorySnapshot>& snapshots)
+{
+    transaction();
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM movieDirectorySnapshots WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
 
+    query.prepare("INSERT INTO movieDirectorySnapshots(path, dir, lastModified, inode) "
+                  "VALUES(:path, :dir, :lastModified, :inode)");
+    for (auto it = snapshots.constBegin(); it != snapshots.constEnd(); ++it) {
+        query.bindValue(":path", path.toString().toUtf8());
+        query.bindValue(":dir", it.key().toUtf8());
+        query.bindValue(":lastModified", it.value().lastModified);
+        query.bindValue(":inode", it.value().inode);
+        query.exec();
+    }
     commit();
+}
 
-    return movies.values().toVector();
+QHash<QString, MediaInfoProbe> Database::mediaInfoProbes(const QStringList& paths)
+{
+    QHash<QString, MediaInfoProbe> probes;
+    QSqlQuery& query =
+        m_statements->query("SELECT size, lastModified, details FROM mediaInfoProbes WHERE path=:path");
+    for (const QString& path : paths) {
+        query.bindValue(":path", path.toUtf8());
+        query.exec();
+        if (query.next()) {
+            MediaInfoProbe probe;
+            probe.identity.path = path;
+            probe.identity.size = query.value(0).toLongLong();
+            probe.identity.lastModified = query.value(1).toLongLong();
+            probe.details = streamDetailsFromJson(query.value(2).toByteArray());
+            probes.insert(path, probe);
+        }
+    }
+    return probes;
+}
+
+void Database::setMediaInfoProbeAsync(const MediaInfoProbe& probe)
+{
+    if (!probe.identity.isValid()) {
+        return;
+    }
+    const QVariantList row{probe.identity.path.toUtf8(),
+        probe.identity.size,
+        probe.identity.lastModified,
+        streamDetailsToJson(probe.details)};
+    const auto write = [row](PreparedStatements& statements) {
+        QSqlQuery& query = statements.query("INSERT OR REPLACE INTO mediaInfoProbes(path, size, lastModified, details) "
+                                            "VALUES(?, ?, ?, ?)");
+        for (int i = 0; i < row.size(); ++i) {
+            query.bindValue(i, row.at(i));
+        }
+        query.exec();
+    };
+    if (m_worker == nullptr) {
+        write(*m_statements);
+    } else {
+        m_worker->enqueue(write);
+    }
 }
 
 void Database::clearAllConcerts()
@@ -541,26 +1253,23 @@ void Database::update(Concert* concert)
 
 QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
 {
-    QVector<Concert*> concerts;
     QSqlQuery query(db());
-    QSqlQuery queryFiles(db());
+    query.prepare("SELECT idConcert, file FROM concertFiles "
+                  "WHERE idConcert IN (SELECT idConcert FROM concerts WHERE path=:path) ORDER BY idFile");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
+    const QHash<int, QStringList> files = decodeFiles(query, "idConcert");
+
+    QVector<Concert*> concerts;
     query.prepare("SELECT idConcert, content, inSeparateFolder FROM concerts WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    const ConcertColumns columns(query.record());
+    const Row row(query);
+    ConcertFileSearcher* concertFileSearcher = Manager::instance()->concertFileSearcher();
     while (query.next()) {
-        QStringList files;
-        queryFiles.prepare("SELECT file FROM concertFiles WHERE idConcert=:idConcert");
-        queryFiles.bindValue(":idConcert", query.value(query.record().indexOf("idConcert")).toInt());
-        queryFiles.exec();
-        while (queryFiles.next()) {
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
-        }
-
-        auto* concert = new Concert(files, Manager::instance()->concertFileSearcher());
-        concert->setDatabaseId(query.value(query.record().indexOf("idConcert")).toInt());
-        concert->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-        concert->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        concerts.append(concert);
+        const QStringList& concertFiles = files.value(row.toInt(columns.idConcert));
+        concerts.append(decodeConcert(row, columns, concertFiles, concertFileSearcher));
     }
     return concerts;
 }
@@ -648,14 +1357,22 @@ void Database::setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials)
 
 void Database::add(TvShowEpisode* episode, DirectoryPath path, int idShow)
 {
+    waitForPendingWrites();
+    const QVariantList summary = episodeSummary(*episode);
     QSqlQuery query(db());
-    query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
-                  "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
+    query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber, "
+                  "title, firstAired, playcount, infoLoaded) "
+                  "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber, "
+                  ":title, :firstAired, :playcount, :infoLoaded)");
     query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
     query.bindValue(":idShow", idShow);
     query.bindValue(":path", path.toString().toUtf8());
     query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
     query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
+    query.bindValue(":title", summary.at(0));
+    query.bindValue(":firstAired", summary.at(1));
+    query.bindValue(":playcount", summary.at(2));
+    query.bindValue(":infoLoaded", summary.at(3));
     query.exec();
     int insertId = query.lastInsertId().toInt();
     for (const FilePath& file : episode->files()) {
@@ -689,11 +1406,21 @@ void Database::update(TvShow* show)
 
 void Database::update(TvShowEpisode* episode)
 {
+    waitForPendingWrites();
     QSqlQuery query(db());
-    query.prepare("UPDATE episodes SET content=:content WHERE idEpisode=:id");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent());
-    query.bindValue(":id", episode->databaseId());
-    query.exec();
+    // Episodes whose details were not loaded yet don't have their NFO contents.
+    if (!episode->detailsPending()) {
+        const QVariantList summary = episodeSummary(*episode);
+        query.prepare("UPDATE episodes SET content=:content, title=:title, firstAired=:firstAired, "
+                      "playcount=:playcount, infoLoaded=:infoLoaded WHERE idEpisode=:id");
+        query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent());
+        query.bindValue(":title", summary.at(0));
+        query.bindValue(":firstAired", summary.at(1));
+        query.bindValue(":playcount", summary.at(2));
+        query.bindValue(":infoLoaded", summary.at(3));
+        query.bindValue(":id", episode->databaseId());
+        query.exec();
+    }
 
     query.prepare("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
     query.bindValue(":idEpisode", episode->databaseId());
@@ -728,56 +1455,119 @@ QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
     query.prepare("SELECT idShow, dir, content, path FROM shows WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
-    while (query.next()) {
-        auto* show = new TvShow(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()),
-            Manager::instance()->tvShowFileSearcher());
-        show->setDatabaseId(query.value(query.record().indexOf("idShow")).toInt());
-        show->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        shows.append(show);
+    {
+        const ShowColumns columns(query.record());
+        const Row row(query);
+        TvShowFileSearcher* tvShowFileSearcher = Manager::instance()->tvShowFileSearcher();
+        while (query.next()) {
+            shows.append(decodeShow(row, columns, tvShowFileSearcher));
+        }
     }
 
+    QSqlQuery& settingsQuery = m_statements->query(
+        "SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
     for (TvShow* show : shows) {
-        query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.exec();
-        if (query.next()) {
-            show->setShowMissingEpisodes(
-                query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1, false);
-            show->setHideSpecialsInMissingEpisodes(
-                query.value(query.record().indexOf("hideSpecialsInMissingEpisodes")).toInt() == 1, false);
+        settingsQuery.bindValue(":dir", show->dir().toString().toUtf8());
+        settingsQuery.exec();
+        if (settingsQuery.next()) {
+            show->setShowMissingEpisodes(settingsQuery.value(0).toInt() == 1, false);
+            show->setHideSpecialsInMissingEpisodes(settingsQuery.value(1).toInt() == 1, false);
         }
     }
+    settingsQuery.finish();
 
     return shows;
 }
 
-QVector<TvShowEpisode*> Database::episodes(int idShow)
+QVector<TvShowEpisode*> Database::episodes(int idShow, bool summaryOnly)
 {
-    QVector<TvShowEpisode*> episodes;
+    waitForPendingWrites();
     QSqlQuery query(db());
-    QSqlQuery queryFiles(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow");
+    query.prepare("SELECT idEpisode, file FROM episodeFiles "
+                  "WHERE idEpisode IN (SELECT idEpisode FROM episodes WHERE idShow=:idShow) ORDER BY idFile");
     query.bindValue(":idShow", idShow);
     query.exec();
+    const QHash<int, QStringList> files = decodeFiles(query, "idEpisode");
+
+    QVector<TvShowEpisode*> episodes;
+    // Rows without a summary always need their NFO contents.
+    const QString content = summaryOnly
+                                ? QStringLiteral("CASE WHEN infoLoaded < 0 THEN content ELSE '' END AS content")
+                                : QStringLiteral("content");
+    query.prepare("SELECT idEpisode, " + content
+                  + ", seasonNumber, episodeNumber, title, firstAired, playcount, infoLoaded "
+                    "FROM episodes WHERE idShow=:idShow");
+    query.bindValue(":idShow", idShow);
+    query.exec();
+    const EpisodeColumns columns(query.record());
+    const EpisodeSummaryColumns summaryColumns(query.record());
+    const Row row(query);
     while (query.next()) {
-        QStringList files;
-        queryFiles.prepare("SELECT file FROM episodeFiles WHERE idEpisode=:idEpisode");
-        queryFiles.bindValue(":idEpisode", query.value(query.record().indexOf("idEpisode")).toInt());
-        queryFiles.exec();
-        while (queryFiles.next()) {
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
+        const int idEpisode = row.toInt(columns.idEpisode);
+        TvShowEpisode* episode = decodeEpisode(row, columns, files.value(idEpisode), nullptr);
+        episode->setDatabaseId(idEpisode);
+        if (summaryOnly && row.toInt(summaryColumns.infoLoaded) >= 0) {
+            decodeEpisodeSummary(row, summaryColumns, episode);
         }
-
-        auto* episode = new TvShowEpisode(files);
-        episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
-        episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
-        episode->setDatabaseId(query.value(query.record().indexOf("idEpisode")).toInt());
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
         episodes.append(episode);
     }
     return episodes;
 }
 
+QString Database::episodeNfoContent(int idEpisode)
+{
+    return episodeNfoContents({idEpisode}).value(idEpisode);
+}
+
+QHash<int, QString> Database::episodeNfoContents(const QVector<int>& idEpisodes)
+{
+    waitForPendingWrites();
+    QHash<int, QString> contents;
+    QSqlQuery query(db());
+    query.prepare("SELECT idEpisode, content FROM episodes WHERE idEpisode=:idEpisode");
+    for (int idEpisode : idEpisodes) {
+        query.bindValue(":idEpisode", idEpisode);
+        query.exec();
+        if (query.next()) {
+            contents.insert(idEpisode, QString::fromUtf8(query.value(1).toByteArray()));
+        }
+    }
+    return contents;
+}
+
+void Database::updateEpisodeSummaries(const QVector<TvShowEpisode*>& episodes)
+{
+    if (episodes.isEmpty()) {
+        return;
+    }
+    QVector<QVariantList> rows;
+    rows.reserve(episodes.size());
+    for (const TvShowEpisode* episode : episodes) {
+        if (episode->databaseId() >= 0 && !episode->detailsPending()) {
+            QVariantList row = episodeSummary(*episode);
+            row << episode->databaseId();
+            rows << row;
+        }
+    }
+    const auto write = [rows](PreparedStatements& statements) {
+        QSqlQuery& query =
+            statements.query("UPDATE episodes SET title=?, firstAired=?, playcount=?, infoLoaded=? WHERE idEpisode=?");
+        for (const QVariantList& row : rows) {
+            for (int i = 0; i < row.size(); ++i) {
+                query.bindValue(i, row.at(i));
+            }
+            query.exec();
+        }
+    };
+    if (m_worker == nullptr) {
+        transaction();
+        write(*m_statements);
+        commit();
+    } else {
+        m_worker->enqueue(write);
+    }
+}
+
 void Database::clearAllTvShows()
 {
     QSqlQuery query(db());
@@ -915,12 +1705,10 @@ QVector<TvShowEpisode*> Database::showsEpisodes(TvShow* show)
     query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM showsEpisodes WHERE idShow=:idShow");
     query.bindValue(":idShow", id);
     query.exec();
+    const EpisodeColumns columns(query.record());
+    const Row row(query);
     while (query.next()) {
-        auto* episode = new TvShowEpisode(QStringList(), show);
-        episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
-        episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        episodes.append(episode);
+        episodes.append(decodeEpisode(row, columns, QStringList(), show));
     }
     return episodes;
 }
@@ -950,12 +1738,17 @@ bool Database::guessImport(QString fileName, QString& type, QString& path)
     QSqlQuery query(db());
     query.prepare("SELECT filename, type, path FROM importCache");
     query.exec();
+    const QSqlRecord record = query.record();
+    const int fileNameColumn = columnIndex(record, "filename");
+    const int typeColumn = columnIndex(record, "type");
+    const int pathColumn = columnIndex(record, "path");
+    const Row row(query);
     while (query.next()) {
-        qreal p = helper::similarity(fileName, query.value(query.record().indexOf("filename")).toString());
+        qreal p = helper::similarity(fileName, row.toString(fileNameColumn));
         if (p > 0.7 && p > bestMatch) {
             bestMatch = p;
-            type = query.value(query.record().indexOf("type")).toString();
-            path = query.value(query.record().indexOf("path")).toString();
+            type = row.toString(typeColumn);
+            path = row.toString(pathColumn);
         }
     }
 
@@ -964,33 +1757,12 @@ bool Database::guessImport(QString fileName, QString& type, QString& path)
 
 void Database::setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLabel)
 {
-    int color = static_cast<int>(colorLabel);
-    QSqlQuery query(db());
-    int id = 1;
-    query.prepare("SELECT MAX(idLabel) FROM labels");
-    query.exec();
-    if (query.next()) {
-        id = query.value(0).toInt() + 1;
-    }
-
+    waitForPendingWrites();
+    QVector<QPair<QByteArray, int>> labels;
     for (const mediaelch::FilePath& fileName : fileNames) {
-        query.prepare("SELECT idLabel FROM labels WHERE fileName=:fileName");
-        query.bindValue(":fileName", fileName.toString().toUtf8());
-        query.exec();
-        if (query.next()) {
-            int idLabel = query.value(query.record().indexOf("idLabel")).toInt();
-            query.prepare("UPDATE labels SET color=:color WHERE idLabel=:idLabel");
-            query.bindValue(":idLabel", idLabel);
-            query.bindValue(":color", color);
-            query.exec();
-        } else {
-            query.prepare("INSERT INTO labels(idLabel, color, fileName) VALUES(:idLabel, :color, :fileName)");
-            query.bindValue(":idLabel", id);
-            query.bindValue(":color", color);
-            query.bindValue(":fileName", fileName.toString().toUtf8());
-            query.exec();
-        }
+        labels << qMakePair(fileName.toString().toUtf8(), static_cast<int>(colorLabel));
     }
+    writeLabels(*m_statements, labels);
 }
 
 ColorLabel Database::getLabel(const mediaelch::FileList& fileNames)
@@ -1057,12 +1829,11 @@ QVector<Artist*> Database::artistsInDirectory(DirectoryPath path)
     query.prepare("SELECT idArtist, content, dir FROM artists WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    const MusicColumns columns(query.record(), "idArtist");
+    const Row row(query);
+    MusicFileSearcher* musicFileSearcher = Manager::instance()->musicFileSearcher();
     while (query.next()) {
-        auto* artist = new Artist(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()),
-            Manager::instance()->musicFileSearcher());
-        artist->setDatabaseId(query.value(query.record().indexOf("idArtist")).toInt());
-        artist->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        artists.append(artist);
+        artists.append(decodeMusicItem<Artist>(row, columns, musicFileSearcher));
     }
     return artists;
 }
@@ -1113,11 +1884,11 @@ QVector<Album*> Database::albums(Artist* artist)
     query.prepare("SELECT idAlbum, content, dir FROM albums WHERE idArtist=:idArtist");
     query.bindValue(":idArtist", artist->databaseId());
     query.exec();
+    const MusicColumns columns(query.record(), "idAlbum");
+    const Row row(query);
+    MusicFileSearcher* musicFileSearcher = Manager::instance()->musicFileSearcher();
     while (query.next()) {
-        auto* album = new Album(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()),
-            Manager::instance()->musicFileSearcher());
-        album->setDatabaseId(query.value(query.record().indexOf("idAlbum")).toInt());
-        album->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        auto* album = decodeMusicItem<Album>(row, columns, musicFileSearcher);
         album->setArtistObj(artist);
         artist->addAlbum(album);
         albums.append(album);
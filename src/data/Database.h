@@ -1,15 +1,20 @@
 #pragma once
 
+#include "data/MediaInfoProbe.h"
+#include "file/DirectorySnapshot.h"
 #include "file/Path.h"
 #include "globals/Globals.h"
 #include "tv_shows/TvDbId.h"
 
 #include <QDateTime>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
+#include <memory>
+
 class Album;
 class Artist;
 class Concert;
@@ -17,11 +22,19 @@ class Movie;
 class TvShow;
 class TvShowEpisode;
 
+namespace mediaelch {
+class DatabaseWorker;
+class PreparedStatements;
+} // namespace mediaelch
+
 class Database : public QObject
 {
     Q_OBJECT
 public:
+    /// \brief Opens the cache database in MediaElch's data directory.
     explicit Database(QObject* parent = nullptr);
+    /// \brief Opens (and if necessary creates) the given cache database file.
+    Database(const QString& databaseFile, const QString& connectionName, QObject* parent = nullptr);
     ~Database() override;
     QSqlDatabase db();
     void transaction();
@@ -29,8 +42,34 @@ public:
     void clearAllMovies();
     void clearMoviesInDirectory(mediaelch::DirectoryPath path);
     void add(Movie* movie, mediaelch::DirectoryPath path);
+    /// \brief Writes the movies in the database thread, see DatabaseWorker.
+    /// \details The movies' database IDs are set once they were written.  All
+    ///          other movie and episode related functions wait for pending writes first.
+    void addAsync(const QVector<Movie*>& movies, mediaelch::DirectoryPath path);
+    /// \brief Blocks until all writes of addAsync() are done and the IDs are set.
+    void waitForPendingWrites();
     void update(Movie* movie);
-    QVector<Movie*> moviesInDirectory(mediaelch::DirectoryPath path);
+    /// \brief Loads all cached movies of the given directory.
+    /// \param summaryOnly If true, movies that have a summary are not loaded from their
+    ///        NFO contents. Their details are loaded on demand, see MovieController::loadDetails().
+    QVector<Movie*> moviesInDirectory(mediaelch::DirectoryPath path, bool summaryOnly = false);
+    QString movieNfoContent(int idMovie);
+    QHash<int, QString> movieNfoContents(const QVector<int>& idMovies);
+    /// \brief Writes the summary of movies that were loaded from their NFO contents.
+    void updateMovieSummaries(const QVector<Movie*>& movies);
+    void remove(Movie* movie);
+
+    /// \brief Snapshots of all directories inside the given movie directory, keyed by directory path.
+    /// Used for incremental rescans, see MovieFileSearcher::reloadIncremental()
+    QHash<QString, mediaelch::DirectorySnapshot> movieDirectorySnapshots(mediaelch::DirectoryPath path);
+    void setMovieDirectorySnapshots(mediaelch::DirectoryPath path,
+        const QHash<QString, mediaelch::DirectorySnapshot>& snapshots);
+
+    /// \brief Cached MediaInfo probes of the given paths, see MediaFileIdentity::pathOf().
+    /// Paths without a cached probe are not part of the result.
+    QHash<QString, mediaelch::MediaInfoProbe> mediaInfoProbes(const QStringList& paths);
+    /// \brief Stores the probe in the database thread, replacing an older probe of the same path.
+    void setMediaInfoProbeAsync(const mediaelch::MediaInfoProbe& probe);
 
     void clearAllConcerts();
     void clearConcertsInDirectory(mediaelch::DirectoryPath path);
@@ -47,7 +86,14 @@ public:
     void clearTvShowInDirectory(mediaelch::DirectoryPath path);
     int showCount(mediaelch::DirectoryPath path);
     QVector<TvShow*> showsInDirectory(mediaelch::DirectoryPath path);
-    QVector<TvShowEpisode*> episodes(int idShow);
+    /// \brief Loads all cached episodes of the given show.
+    /// \param summaryOnly If true, episodes that have a summary are not loaded from their
+    ///        NFO contents. Their details are loaded on demand, see TvShowEpisode::loadDetails().
+    QVector<TvShowEpisode*> episodes(int idShow, bool summaryOnly = false);
+    QString episodeNfoContent(int idEpisode);
+    QHash<int, QString> episodeNfoContents(const QVector<int>& idEpisodes);
+    /// \brief Writes the summary of episodes that were loaded from their NFO contents.
+    void updateEpisodeSummaries(const QVector<TvShowEpisode*>& episodes);
     int episodeCount();
 
     void setShowMissingEpisodes(TvShow* show, bool showMissing);
@@ -78,5 +124,7 @@ public:
 
 private:
     QSqlDatabase* m_db;
+    std::unique_ptr<mediaelch::PreparedStatements> m_statements;
+    mediaelch::DatabaseWorker* m_worker = nullptr;
     void updateDbVersion(int version);
 };
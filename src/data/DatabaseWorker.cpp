@@ -0,0 +1,246 @@
+#include "data/DatabaseWorker.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QThread>
+
+namespace {
+
+// SQLite's default limit of bound parameters per statement (SQLITE_MAX_VARIABLE_NUMBER)
+// is 999 for versions older than 3.32.
+constexpr int maxBoundParameters = 999;
+constexpr int maxRowsPerInsert = 100;
+
+} // namespace
+
+namespace mediaelch {
+
+PreparedStatements::PreparedStatements(QSqlDatabase db) : m_db{std::move(db)}
+{
+}
+
+QSqlQuery& PreparedStatements::query(const QString& sql)
+{
+    auto it = m_queries.find(sql);
+    if (it == m_queries.end()) {
+        QSqlQuery query(m_db);
+        if (!query.prepare(sql)) {
+            qWarning() << "[Database] Could not prepare statement:" << sql << query.lastError().text();
+        }
+        it = m_queries.insert(sql, query);
+    }
+    // Results of the last execution must not keep the database locked.
+    it->finish();
+    return it.value();
+}
+
+void PreparedStatements::insertRows(const QString& table,
+    const QStringList& columns,
+    const QVector<QVariantList>& rows)
+{
+    if (rows.isEmpty() || columns.isEmpty()) {
+        return;
+    }
+
+    const int rowsPerStatement = qBound(1, maxBoundParameters / columns.size(), maxRowsPerInsert);
+    const int fullChunks = rows.size() / rowsPerStatement;
+
+    // Full chunks share one statement. The remaining rows are inserted one by one
+    // so that we don't prepare a statement for each possible remainder.
+    int row = 0;
+    if (fullChunks > 0) {
+        QSqlQuery& chunkQuery = query(insertSql(table, columns, rowsPerStatement));
+        for (int chunk = 0; chunk < fullChunks; ++chunk) {
+            int parameter = 0;
+            for (int i = 0; i < rowsPerStatement; ++i, ++row) {
+                for (const QVariant& value : rows[row]) {
+                    chunkQuery.bindValue(parameter++, value);
+                }
+            }
+            if (!chunkQuery.exec()) {
+                qWarning() << "[Database] Could not insert into" << table << chunkQuery.lastError().text();
+            }
+        }
+    }
+
+    if (row < rows.size()) {
+        QSqlQuery& rowQuery = query(insertSql(table, columns, 1));
+        for (; row < rows.size(); ++row) {
+            int parameter = 0;
+            for (const QVariant& value : rows[row]) {
+                rowQuery.bindValue(parameter++, value);
+            }
+            if (!rowQuery.exec()) {
+                qWarning() << "[Database] Could not insert into" << table << rowQuery.lastError().text();
+            }
+        }
+    }
+}
+
+int PreparedStatements::count() const
+{
+    return m_queries.size();
+}
+
+void PreparedStatements::clear()
+{
+    m_queries.clear();
+}
+
+QString PreparedStatements::insertSql(const QString& table, const QStringList& columns, int rowCount) const
+{
+    QStringList placeholders;
+    for (int i = 0; i < columns.size(); ++i) {
+        placeholders << "?";
+    }
+    const QString rowValues = "(" + placeholders.join(", ") + ")";
+
+    QStringList values;
+    for (int i = 0; i < rowCount; ++i) {
+        values << rowValues;
+    }
+    return QStringLiteral("INSERT INTO %1(%2) VALUES %3").arg(table, columns.join(", "), values.join(", "));
+}
+
+class DatabaseWorker::Thread : public QThread
+{
+public:
+    explicit Thread(DatabaseWorker& worker) : m_worker{worker} {}
+
+protected:
+    void run() override { m_worker.runThread(); }
+
+private:
+    DatabaseWorker& m_worker;
+};
+
+DatabaseWorker::DatabaseWorker(QString databaseFile, QObject* parent) :
+    QObject(parent),
+    m_databaseFile{std::move(databaseFile)},
+    m_connectionName{QStringLiteral("mediaDbWorker-%1").arg(reinterpret_cast<quintptr>(this))},
+    m_thread{std::make_unique<Thread>(*this)}
+{
+    connect(this,
+        &DatabaseWorker::sigRequestsExecuted,
+        this,
+        &DatabaseWorker::runDoneCallbacks,
+        Qt::QueuedConnection);
+    m_thread->start();
+}
+
+DatabaseWorker::~DatabaseWorker()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wakeUp.wakeAll();
+    }
+    m_thread->wait();
+    runDoneCallbacks();
+}
+
+void DatabaseWorker::configureConnection(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    // Readers don't block the writer and vice versa. With WAL, "NORMAL" can't
+    // corrupt the database; at most the last transactions are lost on power loss.
+    query.exec("PRAGMA journal_mode=WAL;");
+    query.exec("PRAGMA synchronous=NORMAL;");
+    query.exec("PRAGMA cache_size=20000;");
+}
+
+void DatabaseWorker::enqueue(Request request, std::function<void()> done)
+{
+    QMutexLocker locker(&m_mutex);
+    m_jobs.enqueue({std::move(request), std::move(done)});
+    m_wakeUp.wakeAll();
+}
+
+void DatabaseWorker::waitForDone()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        while (!m_jobs.isEmpty() || m_executing > 0) {
+            m_idle.wait(&m_mutex);
+        }
+    }
+    runDoneCallbacks();
+}
+
+int DatabaseWorker::pendingRequests() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_jobs.size() + m_executing;
+}
+
+void DatabaseWorker::runThread()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+        db.setDatabaseName(m_databaseFile);
+        if (db.open()) {
+            configureConnection(db);
+        } else {
+            qWarning() << "[DatabaseWorker] Could not open cache database:" << db.lastError().text();
+        }
+        PreparedStatements statements(db);
+
+        QMutexLocker locker(&m_mutex);
+        while (true) {
+            while (m_jobs.isEmpty() && !m_stopping) {
+                m_wakeUp.wait(&m_mutex);
+            }
+            if (m_jobs.isEmpty()) {
+                break;
+            }
+
+            QVector<Job> jobs;
+            jobs.reserve(m_jobs.size());
+            while (!m_jobs.isEmpty()) {
+                jobs.append(m_jobs.dequeue());
+            }
+            m_executing = jobs.size();
+            locker.unlock();
+
+            db.transaction();
+            for (Job& job : jobs) {
+                job.request(statements);
+            }
+            if (!db.commit()) {
+                qWarning() << "[DatabaseWorker] Could not commit transaction:" << db.lastError().text();
+                db.rollback();
+            }
+
+            locker.relock();
+            for (Job& job : jobs) {
+                if (job.done) {
+                    m_doneCallbacks.append(std::move(job.done));
+                }
+            }
+            m_executing = 0;
+            m_idle.wakeAll();
+            locker.unlock();
+            emit sigRequestsExecuted();
+            locker.relock();
+        }
+
+        statements.clear();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+void DatabaseWorker::runDoneCallbacks()
+{
+    QVector<std::function<void()>> callbacks;
+    {
+        QMutexLocker locker(&m_mutex);
+        callbacks.swap(m_doneCallbacks);
+    }
+    for (const auto& callback : callbacks) {
+        callback();
+    }
+}
+
+} // namespace mediaelch
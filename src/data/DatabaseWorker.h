@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QQueue>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVector>
+#include <QWaitCondition>
+#include <functional>
+#include <memory>
+
+class QThread;
+
+namespace mediaelch {
+
+/// \brief Prepared statements of a single database connection.
+/// \details Statements are prepared on first use and reused by later calls
+///          with the same SQL.  Must only be used in the connection's thread.
+class PreparedStatements
+{
+public:
+    explicit PreparedStatements(QSqlDatabase db);
+
+    /// \brief Returns the prepared statement for the given SQL. Bound values
+    ///        of earlier calls must be overwritten by the caller.
+    QSqlQuery& query(const QString& sql);
+
+    /// \brief Inserts all rows using multi-row INSERT statements.
+    /// \details Each row must have one value per column.  Rows are written in
+    ///          chunks that stay below SQLite's limit of bound parameters.
+    void insertRows(const QString& table, const QStringList& columns, const QVector<QVariantList>& rows);
+
+    int count() const;
+    void clear();
+
+private:
+    QString insertSql(const QString& table, const QStringList& columns, int rowCount) const;
+
+private:
+    QSqlDatabase m_db;
+    QHash<QString, QSqlQuery> m_queries;
+};
+
+/// \brief Executes requests against the cache database in a dedicated thread.
+/// \details QSqlDatabase connections must only be used in the thread that
+///          created them, so the worker opens its own connection to the cache
+///          file.  The database is in WAL mode, i.e. the GUI thread can still
+///          read while the worker writes.  All requests that are queued when
+///          the worker becomes idle are executed inside a single transaction.
+class DatabaseWorker : public QObject
+{
+    Q_OBJECT
+public:
+    using Request = std::function<void(PreparedStatements& statements)>;
+
+    explicit DatabaseWorker(QString databaseFile, QObject* parent = nullptr);
+    /// \brief Executes all pending requests before the thread is stopped.
+    ~DatabaseWorker() override;
+
+    /// \brief Applies the settings shared by all connections to the cache database.
+    static void configureConnection(QSqlDatabase& db);
+
+    /// \brief Queues the request. It is executed in the database thread.
+    /// \param done Called in this object's thread once the request was executed.
+    void enqueue(Request request, std::function<void()> done = {});
+
+    /// \brief Blocks until all queued requests were executed and calls their done callbacks.
+    void waitForDone();
+
+    /// \brief Number of requests that were queued but not yet executed.
+    int pendingRequests() const;
+
+signals:
+    /// \brief Internal signal that is emitted in the database thread.
+    void sigRequestsExecuted();
+
+private:
+    struct Job
+    {
+        Request request;
+        std::function<void()> done;
+    };
+    class Thread;
+
+    void runThread();
+    void runDoneCallbacks();
+
+private:
+    QString m_databaseFile;
+    QString m_connectionName;
+    std::unique_ptr<QThread> m_thread;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_wakeUp;
+    QWaitCondition m_idle;
+    QQueue<Job> m_jobs;
+    QVector<std::function<void()>> m_doneCallbacks;
+    int m_executing = 0;
+    bool m_stopping = false;
+};
+
+} // namespace mediaelch
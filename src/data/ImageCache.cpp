@@ -1,30 +1,39 @@
 #include "ImageCache.h"
 
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <algorithm>
 
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Meta.h"
 #include "settings/Settings.h"
 
-ImageCache::ImageCache(QObject* parent) : QObject(parent)
+namespace {
+
+const char* const INDEX_FILE_NAME = "thumbnails.index";
+constexpr quint32 INDEX_MAGIC = 0x4d45494d; // "MEIM"
+constexpr quint8 INDEX_RECORD_THUMBNAIL = 1;
+constexpr quint8 INDEX_RECORD_REMOVE = 2;
+
+} // namespace
+
+ImageCache::ImageCache(QObject* parent) :
+    ImageCache(Settings::instance()->imageCacheDir().subDir("images"), parent)
 {
-    mediaelch::DirectoryPath location = Settings::instance()->imageCacheDir();
-    QDir dir(location.dir());
-    if (!dir.exists()) {
-        dir.mkdir(location.toString());
-    }
-    location = location.subDir("images");
-    dir.setPath(location.toString());
-    bool exists = dir.exists();
-    if (!exists) {
-        exists = dir.mkdir(location.toString());
-    }
-    if (exists) {
-        m_cacheDir = location;
+}
+
+ImageCache::ImageCache(mediaelch::DirectoryPath cacheDir, QObject* parent) : QObject(parent)
+{
+    if (QDir().mkpath(cacheDir.toString())) {
+        m_cacheDir = cacheDir;
     }
     qDebug() << "[ImageCache] Using cache dir:" << m_cacheDir;
 
@@ -44,40 +53,52 @@ QImage ImageCache::image(mediaelch::FilePath path, int width, int height, int& o
     }
 
     QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_%2_%3_").arg(md5).arg(width).arg(height);
-
-    bool update = true;
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (!files.isEmpty()) {
-        QString fileName = files.first();
-        QStringList parts = fileName.split("_");
-        if (parts.count() > 6) {
-            origWidth = parts.at(3).toInt();
-            origHeight = parts.at(4).toInt();
-            if (m_forceCache || (parts.at(5).toInt() > 0 && parts.at(5).toUInt() == getLastModified(path))) {
-                update = false;
+    const QString fileName = thumbnailFileName(md5, width, height);
+
+    {
+        QMutexLocker locker(&m_mutex);
+        ensureIndexIsLoaded();
+        for (const Thumbnail& thumbnail : m_index.value(md5)) {
+            if (thumbnail.width == width && thumbnail.height == height && isUpToDate(thumbnail, path)) {
+                origWidth = thumbnail.origWidth;
+                origHeight = thumbnail.origHeight;
+                locker.unlock();
+                QImage img = helper::getImage(mediaelch::FilePath(m_cacheDir.filePath(fileName)));
+                if (!img.isNull()) {
+                    return img;
+                }
+                // The thumbnail was removed from disk; recreate it.
+                break;
             }
         }
     }
 
-    if (update) {
-        QImage origImg = helper::getImage(path);
-        origWidth = origImg.width();
-        origHeight = origImg.height();
-        QImage img = scaledImage(origImg, width, height);
-        QString fileName = QString("%1_%2_%3_%4_%5_%6_.png")
-                               .arg(md5)
-                               .arg(width)
-                               .arg(height)
-                               .arg(origWidth)
-                               .arg(origHeight)
-                               .arg(getLastModified(path));
-        img.save(m_cacheDir.filePath(fileName), "png", -1);
-        return img;
+    QImage origImg = helper::getImage(path);
+    origWidth = origImg.width();
+    origHeight = origImg.height();
+    QImage img = scaledImage(origImg, width, height);
+    img.save(m_cacheDir.filePath(fileName), "png", -1);
+
+    QMutexLocker locker(&m_mutex);
+    Thumbnail thumbnail;
+    thumbnail.width = width;
+    thumbnail.height = height;
+    thumbnail.origWidth = origWidth;
+    thumbnail.origHeight = origHeight;
+    thumbnail.lastModified = getLastModified(path);
+
+    QVector<Thumbnail>& thumbnails = m_index[md5];
+    auto existing = std::find_if(thumbnails.begin(), thumbnails.end(), [&](const Thumbnail& t) { //
+        return t.width == width && t.height == height;
+    });
+    if (existing != thumbnails.end()) {
+        *existing = thumbnail;
+    } else {
+        thumbnails.append(thumbnail);
     }
+    appendThumbnailToIndex(md5, thumbnail);
 
-    return helper::getImage(mediaelch::FilePath(m_cacheDir.filePath(files.first())));
+    return img;
 }
 
 QImage ImageCache::scaledImage(QImage img, int width, int height)
@@ -101,12 +122,16 @@ void ImageCache::invalidateImages(mediaelch::FilePath path)
     }
 
     QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QDir dir = m_cacheDir.dir();
-    const QStringList entries = dir.entryList(QStringList() << md5 + "*");
-    for (const QString& file : entries) {
-        QFile f(dir.absolutePath() + "/" + file);
-        f.remove();
+    QMutexLocker locker(&m_mutex);
+    ensureIndexIsLoaded();
+    const QVector<Thumbnail> thumbnails = m_index.take(md5);
+    if (thumbnails.isEmpty()) {
+        return;
     }
+    for (const Thumbnail& thumbnail : thumbnails) {
+        QFile::remove(m_cacheDir.filePath(thumbnailFileName(md5, thumbnail.width, thumbnail.height)));
+    }
+    appendRemovalToIndex(md5);
 }
 
 QSize ImageCache::imageSize(mediaelch::FilePath path)
@@ -116,19 +141,25 @@ QSize ImageCache::imageSize(mediaelch::FilePath path)
     }
 
     QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_").arg(md5);
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (files.isEmpty() || files.first().split("_").count() < 7) {
+    QMutexLocker locker(&m_mutex);
+    ensureIndexIsLoaded();
+    const QVector<Thumbnail> thumbnails = m_index.value(md5);
+    if (thumbnails.isEmpty() || !isUpToDate(thumbnails.first(), path)) {
+        locker.unlock();
         return helper::getImage(path).size();
     }
 
-    QStringList parts = files.first().split("_");
-    if (!m_forceCache && parts.at(5).toInt() > 0 && getLastModified(path) != parts.at(5).toUInt()) {
-        return helper::getImage(path).size();
-    }
+    return {thumbnails.first().origWidth, thumbnails.first().origHeight};
+}
+
+bool ImageCache::isUpToDate(const Thumbnail& thumbnail, const mediaelch::FilePath& path)
+{
+    return m_forceCache || (thumbnail.lastModified > 0 && thumbnail.lastModified == getLastModified(path));
+}
 
-    return {parts.at(3).toInt(), parts.at(4).toInt()};
+QString ImageCache::thumbnailFileName(const QString& md5, int width, int height) const
+{
+    return QStringLiteral("%1_%2_%3.png").arg(md5).arg(width).arg(height);
 }
 
 unsigned ImageCache::getLastModified(const mediaelch::FilePath& fileName)
@@ -146,8 +177,142 @@ void ImageCache::clearCache()
     if (!m_cacheDir.isValid() || !Settings::instance()->advanced()->forceCache()) {
         return;
     }
+    QMutexLocker locker(&m_mutex);
+    m_indexFile.close();
     const auto entries = m_cacheDir.dir().entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
     for (const QFileInfo& file : entries) {
         QFile(file.absoluteFilePath()).remove();
     }
+    m_index.clear();
+    // The index file was removed as well and is recreated on the next lookup.
+    m_indexLoaded = false;
+}
+
+void ImageCache::ensureIndexIsLoaded()
+{
+    if (m_indexLoaded) {
+        return;
+    }
+    m_indexLoaded = true;
+    m_index.clear();
+
+    m_indexFile.setFileName(m_cacheDir.filePath(INDEX_FILE_NAME));
+    const bool indexExists = m_indexFile.exists();
+    bool isValidIndex = false;
+    bool isComplete = true;
+    int recordCount = 0;
+
+    if (indexExists && m_indexFile.open(QIODevice::ReadOnly)) {
+        QDataStream in(&m_indexFile);
+        quint32 magic = 0;
+        in >> magic;
+        isValidIndex = (magic == INDEX_MAGIC);
+        while (isValidIndex && !in.atEnd()) {
+            quint8 type = 0;
+            QString md5;
+            in >> type >> md5;
+            Thumbnail thumbnail;
+            if (type == INDEX_RECORD_THUMBNAIL) {
+                qint32 width = 0;
+                qint32 height = 0;
+                qint32 origWidth = 0;
+                qint32 origHeight = 0;
+                quint32 lastModified = 0;
+                in >> width >> height >> origWidth >> origHeight >> lastModified;
+                thumbnail.width = width;
+                thumbnail.height = height;
+                thumbnail.origWidth = origWidth;
+                thumbnail.origHeight = origHeight;
+                thumbnail.lastModified = lastModified;
+            }
+            if (in.status() != QDataStream::Ok
+                || (type != INDEX_RECORD_THUMBNAIL && type != INDEX_RECORD_REMOVE)) {
+                // Incomplete or corrupt record, e.g. if MediaElch crashed while writing.
+                // Everything after it is ignored.
+                qWarning() << "[ImageCache] Ignoring corrupt index record after" << recordCount << "records";
+                isComplete = false;
+                break;
+            }
+
+            if (type == INDEX_RECORD_REMOVE) {
+                m_index.remove(md5);
+
+            } else {
+                QVector<Thumbnail>& thumbnails = m_index[md5];
+                auto existing = std::find_if(thumbnails.begin(), thumbnails.end(), [&](const Thumbnail& t) {
+                    return t.width == thumbnail.width && t.height == thumbnail.height;
+                });
+                if (existing != thumbnails.end()) {
+                    *existing = thumbnail;
+                } else {
+                    thumbnails.append(thumbnail);
+                }
+            }
+            ++recordCount;
+        }
+        m_indexFile.close();
+    }
+
+    if (!indexExists) {
+        // Thumbnails of older MediaElch versions are encoded in their file names
+        // and are not part of the index.
+        const QStringList legacyFiles = m_cacheDir.dir().entryList({"*_.png"}, QDir::Files);
+        for (const QString& file : legacyFiles) {
+            QFile::remove(m_cacheDir.filePath(file));
+        }
+    }
+
+    int thumbnailCount = 0;
+    for (const QVector<Thumbnail>& thumbnails : asConst(m_index)) {
+        thumbnailCount += thumbnails.size();
+    }
+    qDebug() << "[ImageCache] Loaded index with" << thumbnailCount << "thumbnails";
+
+    // Superseded and removed records are dropped if they make up most of the journal.
+    // A corrupt journal is rewritten as well, because records appended to it couldn't be read.
+    if (!isValidIndex || !isComplete || recordCount > 2 * thumbnailCount + 1000) {
+        compactIndex();
+    }
+    if (!m_indexFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "[ImageCache] Could not open index file:" << m_indexFile.fileName();
+    }
+}
+
+void ImageCache::compactIndex()
+{
+    QSaveFile file(m_indexFile.fileName());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[ImageCache] Could not write index file:" << file.fileName();
+        return;
+    }
+    QDataStream out(&file);
+    out << INDEX_MAGIC;
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        for (const Thumbnail& thumbnail : it.value()) {
+            out << INDEX_RECORD_THUMBNAIL << it.key() << qint32(thumbnail.width) << qint32(thumbnail.height)
+                << qint32(thumbnail.origWidth) << qint32(thumbnail.origHeight) << quint32(thumbnail.lastModified);
+        }
+    }
+    file.commit();
+}
+
+void ImageCache::appendThumbnailToIndex(const QString& md5, const Thumbnail& thumbnail)
+{
+    if (!m_indexFile.isOpen()) {
+        return;
+    }
+    QDataStream out(&m_indexFile);
+    out << INDEX_RECORD_THUMBNAIL << md5 << qint32(thumbnail.width) << qint32(thumbnail.height)
+        << qint32(thumbnail.origWidth) << qint32(thumbnail.origHeight) << quint32(thumbnail.lastModified);
+    m_indexFile.flush();
+}
+
+void ImageCache::appendRemovalToIndex(const QString& md5)
+{
+    if (!m_indexFile.isOpen()) {
+        return;
+    }
+    QDataStream out(&m_indexFile);
+    out << INDEX_RECORD_REMOVE << md5;
+    m_indexFile.flush();
 }
@@ -2,17 +2,30 @@
 
 #include "file/Path.h"
 
+#include <QFile>
 #include <QHash>
 #include <QImage>
+#include <QMutex>
 #include <QSize>
 #include <QString>
 #include <QVector>
 
+/// \brief Cache for scaled images (thumbnails).
+///
+/// Thumbnails are stored as PNG files in the cache directory.  An index maps
+/// the image's path hash to all of its thumbnails, their original image size
+/// and the image's modification time.  The index is held in memory and
+/// persisted as an append-only journal, so that lookups don't need to list
+/// the cache directory.
+///
+/// The cache is thread safe.
 class ImageCache : public QObject
 {
     Q_OBJECT
 public:
     explicit ImageCache(QObject* parent = nullptr);
+    /// \brief Cache that stores its thumbnails and index in the given directory.
+    explicit ImageCache(mediaelch::DirectoryPath cacheDir, QObject* parent = nullptr);
     static ImageCache* instance(QObject* parent = nullptr);
     QImage image(mediaelch::FilePath path, int width, int height, int& origWidth, int& origHeight);
     QSize imageSize(mediaelch::FilePath path);
@@ -20,9 +33,33 @@ public:
     void clearCache();
 
 private:
+    struct Thumbnail
+    {
+        int width = 0;
+        int height = 0;
+        int origWidth = 0;
+        int origHeight = 0;
+        unsigned lastModified = 0;
+    };
+
+    /// \brief Loads the index journal if that hasn't happened, yet.
+    void ensureIndexIsLoaded();
+    /// \brief Rewrites the index journal with only the current thumbnails.
+    void compactIndex();
+    void appendThumbnailToIndex(const QString& md5, const Thumbnail& thumbnail);
+    void appendRemovalToIndex(const QString& md5);
+    bool isUpToDate(const Thumbnail& thumbnail, const mediaelch::FilePath& path);
+    QString thumbnailFileName(const QString& md5, int width, int height) const;
+
     mediaelch::DirectoryPath m_cacheDir;
     QHash<mediaelch::FilePath, QVector<unsigned>> m_lastModifiedTimes;
     QImage scaledImage(QImage img, int width, int height);
     unsigned getLastModified(const mediaelch::FilePath& fileName);
     bool m_forceCache;
+
+    QMutex m_mutex;
+    bool m_indexLoaded = false;
+    /// Thumbnails of an image keyed by the MD5 hash of the image's path.
+    QHash<QString, QVector<Thumbnail>> m_index;
+    QFile m_indexFile;
 };
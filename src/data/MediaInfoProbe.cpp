@@ -0,0 +1,118 @@
+#include "data/MediaInfoProbe.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <initializer_list>
+
+namespace {
+
+template<class Key>
+QJsonObject detailsToJson(const QMap<Key, QString>& details)
+{
+    QJsonObject object;
+    for (auto it = details.constBegin(); it != details.constEnd(); ++it) {
+        object.insert(StreamDetails::detailToString(it.key()), it.value());
+    }
+    return object;
+}
+
+template<class Key>
+QMap<Key, QString> detailsFromJson(const QJsonObject& object, std::initializer_list<Key> keys)
+{
+    QMap<Key, QString> details;
+    for (Key key : keys) {
+        const QJsonValue value = object.value(StreamDetails::detailToString(key));
+        if (value.isString()) {
+            details.insert(key, value.toString());
+        }
+    }
+    return details;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+MediaFileIdentity MediaFileIdentity::of(const FileList& files)
+{
+    MediaFileIdentity identity;
+    for (const FilePath& file : files) {
+        QFileInfo fi(file.toString());
+        if (!fi.exists()) {
+            return {};
+        }
+        identity.size += fi.size();
+        identity.lastModified = qMax(identity.lastModified, fi.lastModified().toMSecsSinceEpoch());
+    }
+    identity.path = pathOf(files);
+    return identity;
+}
+
+QString MediaFileIdentity::pathOf(const FileList& files)
+{
+    QStringList paths;
+    paths.reserve(files.size());
+    for (const FilePath& file : files) {
+        paths << file.toString();
+    }
+    return paths.join('\n');
+}
+
+bool operator==(const MediaFileIdentity& lhs, const MediaFileIdentity& rhs)
+{
+    return lhs.path == rhs.path && lhs.size == rhs.size && lhs.lastModified == rhs.lastModified;
+}
+
+bool operator!=(const MediaFileIdentity& lhs, const MediaFileIdentity& rhs)
+{
+    return !(lhs == rhs);
+}
+
+QByteArray streamDetailsToJson(const StreamDetails::Details& details)
+{
+    QJsonArray audio;
+    for (const auto& stream : details.audio) {
+        audio.append(detailsToJson(stream));
+    }
+    QJsonArray subtitles;
+    for (const auto& stream : details.subtitles) {
+        subtitles.append(detailsToJson(stream));
+    }
+    QJsonObject object;
+    object.insert("video", detailsToJson(details.video));
+    object.insert("audio", audio);
+    object.insert("subtitles", subtitles);
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+StreamDetails::Details streamDetailsFromJson(const QByteArray& json)
+{
+    using VideoDetails = StreamDetails::VideoDetails;
+    using AudioDetails = StreamDetails::AudioDetails;
+    using SubtitleDetails = StreamDetails::SubtitleDetails;
+
+    const QJsonObject object = QJsonDocument::fromJson(json).object();
+
+    StreamDetails::Details details;
+    details.video = detailsFromJson(object.value("video").toObject(),
+        {VideoDetails::DurationInSeconds,
+            VideoDetails::Codec,
+            VideoDetails::Aspect,
+            VideoDetails::Width,
+            VideoDetails::Height,
+            VideoDetails::ScanType,
+            VideoDetails::StereoMode});
+    for (const QJsonValue& stream : object.value("audio").toArray()) {
+        details.audio.append(
+            detailsFromJson(stream.toObject(), {AudioDetails::Language, AudioDetails::Codec, AudioDetails::Channels}));
+    }
+    for (const QJsonValue& stream : object.value("subtitles").toArray()) {
+        details.subtitles.append(detailsFromJson(stream.toObject(), {SubtitleDetails::Language}));
+    }
+    return details;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+namespace mediaelch {
+
+/// \brief Identity of the files a MediaInfo probe was run on.
+///
+/// Stream details only change if a file is replaced, which changes its size
+/// or modification time.  A probe whose identity equals the files' current
+/// identity can be reused without opening the files with libmediainfo.
+struct MediaFileIdentity
+{
+    /// \brief Reads the identity of the given files.
+    /// Returns an invalid identity if one of the files can't be read.
+    static MediaFileIdentity of(const FileList& files);
+    /// \brief Key of the files in the probe cache.
+    static QString pathOf(const FileList& files);
+
+    bool isValid() const { return !path.isEmpty() && lastModified != 0; }
+
+    /// All file paths joined by a newline (for stacked files)
+    QString path;
+    /// Sum of all file sizes
+    qint64 size = 0;
+    /// Latest modification time of all files in milliseconds since epoch
+    qint64 lastModified = 0;
+};
+
+bool operator==(const MediaFileIdentity& lhs, const MediaFileIdentity& rhs);
+bool operator!=(const MediaFileIdentity& lhs, const MediaFileIdentity& rhs);
+
+/// \brief Cached result of StreamDetails::probe().
+struct MediaInfoProbe
+{
+    MediaFileIdentity identity;
+    StreamDetails::Details details;
+};
+
+/// \brief Serializes stream details for the probe cache.
+QByteArray streamDetailsToJson(const StreamDetails::Details& details);
+/// \brief Inverse of streamDetailsToJson(). Unknown keys are ignored.
+StreamDetails::Details streamDetailsFromJson(const QByteArray& json);
+
+} // namespace mediaelch
@@ -0,0 +1,109 @@
+#include "data/MediaInfoProbeQueue.h"
+
+#include "data/Database.h"
+#include "data/StreamDetails.h"
+#include "movies/Movie.h"
+#include "movies/MovieController.h"
+
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace mediaelch {
+
+MediaInfoProbeQueue::MediaInfoProbeQueue(Database& database, QObject* parent) : QObject(parent), m_database{database}
+{
+    // libmediainfo is mostly waiting for I/O.  More threads only lead to
+    // more seeking on hard disks and network shares.
+    m_pool.setMaxThreadCount(2);
+}
+
+MediaInfoProbeQueue::~MediaInfoProbeQueue()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void MediaInfoProbeQueue::loadStreamDetails(StreamDetails& streamDetails)
+{
+    const MediaFileIdentity identity = MediaFileIdentity::of(streamDetails.files());
+    if (identity.isValid()) {
+        const MediaInfoProbe cached = m_database.mediaInfoProbes({identity.path}).value(identity.path);
+        if (cached.identity == identity) {
+            streamDetails.setDetails(cached.details);
+            return;
+        }
+    }
+
+    MediaInfoProbe probe;
+    probe.identity = identity;
+    probe.details = StreamDetails::probe(streamDetails.files());
+    streamDetails.setDetails(probe.details);
+    m_database.setMediaInfoProbeAsync(probe);
+}
+
+void MediaInfoProbeQueue::enqueueMovies(const QVector<Movie*>& movies)
+{
+    QVector<Movie*> queued;
+    QStringList paths;
+    for (Movie* movie : movies) {
+        if (movie->streamDetailsLoaded() || m_pending.contains(movie) || movie->streamDetails()->files().isEmpty()) {
+            continue;
+        }
+        queued << movie;
+        paths << MediaFileIdentity::pathOf(movie->streamDetails()->files());
+    }
+    if (queued.isEmpty()) {
+        return;
+    }
+
+    // Read all cached rows at once in this thread.  The pool only has to
+    // compare them against the files' current identity.
+    const QHash<QString, MediaInfoProbe> cachedProbes = m_database.mediaInfoProbes(paths);
+
+    for (int i = 0; i < queued.size(); ++i) {
+        Movie* movie = queued.at(i);
+        QPointer<Movie> target(movie);
+        const FileList files = movie->streamDetails()->files();
+        const MediaInfoProbe cached = cachedProbes.value(paths.at(i));
+        m_pending.insert(
+            movie, connect(movie, &QObject::destroyed, this, [this, movie]() { m_pending.remove(movie); }));
+
+        auto* watcher = new QFutureWatcher<Result>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, target]() {
+            const Result result = watcher->result();
+            watcher->deleteLater();
+
+            if (!result.fromCache) {
+                m_database.setMediaInfoProbeAsync(result.probe);
+            }
+            if (!target.isNull()) {
+                disconnect(m_pending.take(target.data()));
+                if (!target->streamDetailsLoaded()) {
+                    target->streamDetails()->setDetails(result.probe.details);
+                    target->controller()->applyProbedStreamDetails();
+                    emit sigMovieStreamDetailsLoaded(target.data());
+                }
+            }
+            if (m_pending.isEmpty()) {
+                emit sigFinished();
+            }
+        });
+        watcher->setFuture(QtConcurrent::run(&m_pool, [files, cached]() { return probeFiles(files, cached); }));
+    }
+}
+
+MediaInfoProbeQueue::Result MediaInfoProbeQueue::probeFiles(const FileList& files, const MediaInfoProbe& cached)
+{
+    Result result;
+    result.probe.identity = MediaFileIdentity::of(files);
+    if (result.probe.identity.isValid() && result.probe.identity == cached.identity) {
+        result.probe.details = cached.details;
+        result.fromCache = true;
+        return result;
+    }
+    result.probe.details = StreamDetails::probe(files);
+    return result;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "data/MediaInfoProbe.h"
+
+#include <QHash>
+#include <QObject>
+#include <QThreadPool>
+#include <QVector>
+
+class Database;
+class Movie;
+class StreamDetails;
+
+namespace mediaelch {
+
+/// \brief Loads stream details through the MediaInfo probe cache.
+///
+/// Probing a file with libmediainfo has to read parts of it, which is slow
+/// for network shares.  Probes are therefore cached by file identity (path,
+/// size and modification time) in the database and only repeated for new or
+/// changed files.  enqueueMovies() probes in a small thread pool so that the
+/// stream details are usually available once a movie is opened.
+class MediaInfoProbeQueue : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MediaInfoProbeQueue(Database& database, QObject* parent = nullptr);
+    /// \brief Waits for running probes. Their results are discarded.
+    ~MediaInfoProbeQueue() override;
+
+    /// \brief Loads the stream details in the calling thread, using the cache if possible.
+    void loadStreamDetails(StreamDetails& streamDetails);
+
+    /// \brief Probes all movies without stream details in the background.
+    /// \details Movies that are already queued are skipped.  Stream details and
+    ///          the runtime of a movie are only set if its stream details were not
+    ///          loaded in the meantime, see MovieController::applyProbedStreamDetails().
+    ///          The movie is not marked as changed.
+    void enqueueMovies(const QVector<Movie*>& movies);
+
+    int pendingCount() const { return m_pending.size(); }
+
+signals:
+    void sigMovieStreamDetailsLoaded(Movie* movie);
+    /// \brief Emitted once all queued probes are done.
+    void sigFinished();
+
+private:
+    struct Result
+    {
+        MediaInfoProbe probe;
+        bool fromCache = false;
+    };
+
+    /// \brief Runs in the thread pool.
+    static Result probeFiles(const FileList& files, const MediaInfoProbe& cached);
+
+private:
+    Database& m_database;
+    QThreadPool m_pool;
+    /// Queued movies.  Movies are removed once they are destroyed, so that a new
+    /// movie at the same address is not mistaken for a queued one.
+    QHash<Movie*, QMetaObject::Connection> m_pending;
+};
+
+} // namespace mediaelch
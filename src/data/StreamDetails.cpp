@@ -69,14 +69,43 @@ void StreamDetails::clear()
  * \brief Loads stream details from the file
  */
 void StreamDetails::loadStreamDetails()
+{
+    setDetails(probe(m_files));
+}
+
+StreamDetails::Details StreamDetails::details() const
+{
+    return Details{m_videoDetails, m_audioDetails, m_subtitles};
+}
+
+void StreamDetails::setDetails(const Details& streamDetails)
 {
     clear();
-    if (m_files.isEmpty()) {
-        return;
+    for (auto it = streamDetails.video.constBegin(); it != streamDetails.video.constEnd(); ++it) {
+        setVideoDetail(it.key(), it.value());
+    }
+    for (int i = 0; i < streamDetails.audio.size(); ++i) {
+        const QMap<AudioDetails, QString>& stream = streamDetails.audio.at(i);
+        for (auto it = stream.constBegin(); it != stream.constEnd(); ++it) {
+            setAudioDetail(i, it.key(), it.value());
+        }
+    }
+    for (int i = 0; i < streamDetails.subtitles.size(); ++i) {
+        const QMap<SubtitleDetails, QString>& stream = streamDetails.subtitles.at(i);
+        for (auto it = stream.constBegin(); it != stream.constEnd(); ++it) {
+            setSubtitleDetail(i, it.key(), it.value());
+        }
+    }
+}
+
+StreamDetails::Details StreamDetails::probe(const mediaelch::FileList& files)
+{
+    if (files.isEmpty()) {
+        return {};
     }
-    const QString firstFile = m_files.first().toString();
+    const QString firstFile = files.first().toString();
     if (firstFile.endsWith(".iso", Qt::CaseInsensitive) || firstFile.endsWith(".img", Qt::CaseInsensitive)) {
-        return;
+        return {};
     }
 
     // If it's a DVD structure, compute the biggest part (main movie) and use this IFO file
@@ -104,33 +133,33 @@ void StreamDetails::loadStreamDetails()
         if (!biggest.isEmpty()) {
             QFileInfo fiNew(fi.absolutePath() + "/VTS_" + biggest + "_0.IFO");
             if (fiNew.isFile() && fiNew.exists()) {
-                m_files = mediaelch::FileList({mediaelch::FilePath(fiNew.absoluteFilePath())});
+                return loadWithLibrary(mediaelch::FileList({mediaelch::FilePath(fiNew.absoluteFilePath())}));
             }
         }
     }
 
-    loadWithLibrary();
+    return loadWithLibrary(files);
 }
 
-void StreamDetails::loadWithLibrary()
+StreamDetails::Details StreamDetails::loadWithLibrary(const mediaelch::FileList& files)
 {
-    mediaelch::FilePath filePath = m_files.first();
-    if (m_files.size() == 1 && filePath.toString().endsWith("index.bdmv")) {
+    mediaelch::FilePath filePath = files.first();
+    if (files.size() == 1 && filePath.toString().endsWith("index.bdmv")) {
         QFileInfo fi(filePath.toString());
         QDir dir(fi.absolutePath() + "/STREAM");
-        QStringList files = dir.entryList(QStringList() << "*.m2ts", QDir::NoDotAndDotDot | QDir::Files, QDir::Name);
-        if (!files.isEmpty()) {
-            filePath = mediaelch::FilePath(dir.absolutePath() + "/" + files.first());
+        QStringList streamFiles =
+            dir.entryList(QStringList() << "*.m2ts", QDir::NoDotAndDotDot | QDir::Files, QDir::Name);
+        if (!streamFiles.isEmpty()) {
+            filePath = mediaelch::FilePath(dir.absolutePath() + "/" + streamFiles.first());
         }
     }
 
     MediaInfoFile mi(filePath.toString());
 
     std::chrono::seconds duration{0};
-    QString scanType;
 
-    if (m_files.size() > 1) {
-        for (const mediaelch::FilePath& file : m_files) {
+    if (files.size() > 1) {
+        for (const mediaelch::FilePath& file : files) {
             const MediaInfoFile mediaFile(file.toString());
             duration += std::chrono::seconds(qRound(mediaFile.duration(0).count() / 1000.));
         }
@@ -138,28 +167,30 @@ void StreamDetails::loadWithLibrary()
         duration += std::chrono::seconds(qRound(mi.duration(0).count() / 1000.));
     }
 
-    setVideoDetail(StreamDetails::VideoDetails::DurationInSeconds, QString::number(duration.count()));
+    Details result;
+    result.video.insert(VideoDetails::DurationInSeconds, QString::number(duration.count()));
 
     if (mi.videoStreamCount() > 0) {
-        setVideoDetail(VideoDetails::Codec, mi.format(0));
-        setVideoDetail(VideoDetails::Aspect, QString::number(mi.aspectRatio(0)));
-        setVideoDetail(VideoDetails::Width, QString::number(mi.videoWidth(0)));
-        setVideoDetail(VideoDetails::Height, QString::number(mi.videoHeight(0)));
-        setVideoDetail(VideoDetails::ScanType, mi.scanType(0));
-        setVideoDetail(VideoDetails::StereoMode, mi.stereoFormat(0));
+        result.video.insert(VideoDetails::Codec, mi.format(0));
+        result.video.insert(VideoDetails::Aspect, QString::number(mi.aspectRatio(0)));
+        result.video.insert(VideoDetails::Width, QString::number(mi.videoWidth(0)));
+        result.video.insert(VideoDetails::Height, QString::number(mi.videoHeight(0)));
+        result.video.insert(VideoDetails::ScanType, mi.scanType(0));
+        result.video.insert(VideoDetails::StereoMode, mi.stereoFormat(0));
     }
 
     const int audioCount = mi.audioStreamCount();
     for (int i = 0; i < audioCount; ++i) {
-        setAudioDetail(i, AudioDetails::Language, mi.audioLanguage(i));
-        setAudioDetail(i, AudioDetails::Codec, mi.audioCodec(i));
-        setAudioDetail(i, AudioDetails::Channels, mi.audioChannels(i));
+        result.audio.append(QMap<AudioDetails, QString>{{AudioDetails::Language, mi.audioLanguage(i)},
+            {AudioDetails::Codec, mi.audioCodec(i)},
+            {AudioDetails::Channels, mi.audioChannels(i)}});
     }
 
     int textCount = mi.subtitleCount();
     for (int i = 0; i < textCount; ++i) {
-        setSubtitleDetail(i, StreamDetails::SubtitleDetails::Language, mi.subtitleLang(i));
+        result.subtitles.append(QMap<SubtitleDetails, QString>{{SubtitleDetails::Language, mi.subtitleLang(i)}});
     }
+    return result;
 }
 
 
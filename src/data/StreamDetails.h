@@ -39,7 +39,24 @@ public:
     static QString detailToString(AudioDetails details);
     static QString detailToString(SubtitleDetails details);
 
+    /// \brief Plain copy of all stream details that can be passed between threads.
+    struct Details
+    {
+        QMap<VideoDetails, QString> video;
+        QVector<QMap<AudioDetails, QString>> audio;
+        QVector<QMap<SubtitleDetails, QString>> subtitles;
+    };
+
+    /// \brief Reads the stream details of the given files using libmediainfo.
+    /// \details Does not touch any StreamDetails object and can be called from any thread.
+    ///          Slow for network shares, see mediaelch::MediaInfoProbeQueue.
+    static Details probe(const mediaelch::FileList& files);
+
     void loadStreamDetails();
+    Details details() const;
+    /// \brief Replaces all stream details with the given ones.
+    void setDetails(const Details& streamDetails);
+    const mediaelch::FileList& files() const { return m_files; }
     void setVideoDetail(VideoDetails key, QString value);
     void setAudioDetail(int streamNumber, AudioDetails key, QString value);
     void setSubtitleDetail(int streamNumber, SubtitleDetails key, QString value);
@@ -55,7 +72,7 @@ public:
     virtual QVector<QMap<SubtitleDetails, QString>> subtitleDetails() const;
 
 private:
-    void loadWithLibrary();
+    static Details loadWithLibrary(const mediaelch::FileList& files);
 
     mediaelch::FileList m_files;
     QMap<VideoDetails, QString> m_videoDetails;
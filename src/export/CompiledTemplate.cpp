@@ -0,0 +1,184 @@
+#include "export/CompiledTemplate.h"
+
+#include <QRegularExpression>
+
+namespace mediaelch {
+
+bool TemplateContext::appendVariable(const QString& /*name*/, QString& /*out*/) const
+{
+    return false;
+}
+
+bool TemplateContext::appendBlock(const QString& /*name*/, const CompiledTemplate& /*item*/, QString& /*out*/) const
+{
+    return false;
+}
+
+bool TemplateContext::appendImage(const QString& /*type*/, QSize /*size*/, QString& /*out*/) const
+{
+    return false;
+}
+
+bool ValueTemplateContext::appendVariable(const QString& name, QString& out) const
+{
+    auto value = m_values.constFind(name);
+    if (value == m_values.constEnd()) {
+        return false;
+    }
+    out += value.value();
+    return true;
+}
+
+CompiledTemplate::CompiledTemplate(const QString& text)
+{
+    parse(text);
+}
+
+void CompiledTemplate::parse(const QString& text)
+{
+    const QString open = QStringLiteral("{{ ");
+    const QString close = QStringLiteral(" }}");
+    const QString beginBlock = QStringLiteral("BEGIN_BLOCK_");
+    static const QRegularExpression imageRx(R"(^IMAGE.(.*)\[(\d*), ?(\d*)\]$)",
+        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
+
+    int pos = 0;
+    while (pos < text.size()) {
+        const int start = text.indexOf(open, pos);
+        if (start < 0) {
+            break;
+        }
+        const int end = text.indexOf(close, start + open.size());
+        if (end < 0) {
+            break;
+        }
+        // Placeholders can't be nested: "{{ a {{ B }}" is the text "{{ a " followed by "{{ B }}".
+        const int next = text.indexOf(open, start + open.size());
+        if (next >= 0 && next < end) {
+            appendLiteral(text.mid(pos, next - pos));
+            pos = next;
+            continue;
+        }
+
+        appendLiteral(text.mid(pos, start - pos));
+        pos = end + close.size();
+
+        Token token;
+        token.text = text.mid(start, pos - start);
+        token.name = text.mid(start + open.size(), end - start - open.size());
+
+        if (token.name.startsWith(beginBlock)) {
+            // Blocks end at the first matching END_BLOCK, i.e. blocks of the same name can't be nested.
+            token.name = token.name.mid(beginBlock.size());
+            const QString endTag = open + "END_BLOCK_" + token.name + close;
+            const int blockEnd = text.indexOf(endTag, pos);
+            if (blockEnd < 0) {
+                appendLiteral(token.text);
+                continue;
+            }
+            token.type = Token::Type::Block;
+            token.block = std::make_shared<const CompiledTemplate>(text.mid(pos, blockEnd - pos).trimmed());
+            pos = blockEnd + endTag.size();
+            m_tokens.append(token);
+            continue;
+        }
+
+        QRegularExpressionMatch match = imageRx.match(token.name);
+        if (match.hasMatch()) {
+            token.size = QSize(match.captured(2).toInt(), match.captured(3).toInt());
+            if (token.size.isEmpty()) {
+                appendLiteral(token.text);
+                continue;
+            }
+            token.type = Token::Type::Image;
+            token.name = match.captured(1).toLower();
+            m_tokens.append(token);
+            continue;
+        }
+
+        token.type = Token::Type::Variable;
+        m_tokens.append(token);
+    }
+    appendLiteral(text.mid(pos));
+}
+
+void CompiledTemplate::appendLiteral(const QString& text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    if (!m_tokens.isEmpty() && m_tokens.last().type == Token::Type::Literal) {
+        m_tokens.last().text += text;
+        return;
+    }
+    Token token;
+    token.type = Token::Type::Literal;
+    token.text = text;
+    m_tokens.append(token);
+}
+
+const CompiledTemplate* CompiledTemplate::block(const QString& name) const
+{
+    for (const Token& token : m_tokens) {
+        if (token.type != Token::Type::Block) {
+            continue;
+        }
+        if (token.name == name) {
+            return token.block.get();
+        }
+        const CompiledTemplate* nested = token.block->block(name);
+        if (nested != nullptr) {
+            return nested;
+        }
+    }
+    return nullptr;
+}
+
+QSet<QString> CompiledTemplate::imageTypes() const
+{
+    QSet<QString> types;
+    for (const Token& token : m_tokens) {
+        if (token.type == Token::Type::Image) {
+            types.insert(token.name);
+        } else if (token.type == Token::Type::Block) {
+            types.unite(token.block->imageTypes());
+        }
+    }
+    return types;
+}
+
+QString CompiledTemplate::render(const TemplateContext& context) const
+{
+    QString out;
+    render(context, out);
+    return out;
+}
+
+void CompiledTemplate::render(const TemplateContext& context, QString& out) const
+{
+    for (const Token& token : m_tokens) {
+        bool replaced = false;
+        for (const TemplateContext* c = &context; c != nullptr && !replaced; c = c->parent()) {
+            switch (token.type) {
+            case Token::Type::Literal:
+                out += token.text;
+                replaced = true;
+                break;
+            case Token::Type::Variable: replaced = c->appendVariable(token.name, out); break;
+            case Token::Type::Image: replaced = c->appendImage(token.name, token.size, out); break;
+            case Token::Type::Block: replaced = c->appendBlock(token.name, *token.block, out); break;
+            }
+        }
+        if (replaced) {
+            continue;
+        }
+        out += token.text;
+        if (token.type == Token::Type::Block) {
+            // Unknown blocks are kept but placeholders inside them are still replaced.
+            token.block->render(context, out);
+            out += QStringLiteral("{{ END_BLOCK_") + token.name + QStringLiteral(" }}");
+        }
+    }
+}
+
+} // namespace mediaelch
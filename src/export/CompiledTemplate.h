@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+namespace mediaelch {
+
+class CompiledTemplate;
+
+/// \brief Provides the values of an export template's placeholders, e.g. of a single movie.
+/// \details Contexts are chained: placeholders that a context does not know are looked up
+///          in its parent.  Placeholders that no context knows are written as they are.
+class TemplateContext
+{
+public:
+    explicit TemplateContext(const TemplateContext* parent = nullptr) : m_parent{parent} {}
+    virtual ~TemplateContext() = default;
+
+    const TemplateContext* parent() const { return m_parent; }
+
+    /// \brief Appends the value of the variable, e.g. "MOVIE.TITLE". Returns false if unknown.
+    virtual bool appendVariable(const QString& name, QString& out) const;
+    /// \brief Appends the block "BEGIN_BLOCK_<name>" by rendering the block's item for each
+    /// of the block's entries. Returns false if unknown.
+    virtual bool appendBlock(const QString& name, const CompiledTemplate& item, QString& out) const;
+    /// \brief Appends the path of the image placeholder "IMAGE.<type>[<width>,<height>]".
+    /// Returns false if the image type is unknown.
+    virtual bool appendImage(const QString& type, QSize size, QString& out) const;
+
+private:
+    const TemplateContext* m_parent = nullptr;
+};
+
+/// \brief Context with a fixed set of values, e.g. a single entry of a TAGS block.
+class ValueTemplateContext : public TemplateContext
+{
+public:
+    explicit ValueTemplateContext(const TemplateContext* parent = nullptr) : TemplateContext(parent) {}
+
+    void insert(const QString& name, const QString& value) { m_values.insert(name, value); }
+    bool appendVariable(const QString& name, QString& out) const override;
+
+private:
+    QHash<QString, QString> m_values;
+};
+
+/// \brief An export template that is parsed once into literals and placeholders.
+/// \details The template syntax is the one of the simple engine:
+///           - {{ NAME }} for variables
+///           - {{ BEGIN_BLOCK_NAME }} ... {{ END_BLOCK_NAME }} for repeated blocks
+///           - {{ IMAGE.type[width,height] }} for images
+///          Rendering only walks the token list instead of searching the whole
+///          template for each placeholder.  A compiled template is immutable and
+///          can be rendered from multiple threads at the same time.
+class CompiledTemplate
+{
+public:
+    CompiledTemplate() = default;
+    explicit CompiledTemplate(const QString& text);
+
+    bool isEmpty() const { return m_tokens.isEmpty(); }
+
+    /// \brief Item template of the first block with the given name or nullptr.
+    /// Nested blocks are searched as well.
+    const CompiledTemplate* block(const QString& name) const;
+    /// \brief Types of all image placeholders, e.g. "poster". Nested blocks are searched as well.
+    QSet<QString> imageTypes() const;
+
+    QString render(const TemplateContext& context) const;
+    void render(const TemplateContext& context, QString& out) const;
+
+private:
+    struct Token
+    {
+        enum class Type
+        {
+            Literal,
+            Variable,
+            Image,
+            Block
+        };
+        Type type = Type::Literal;
+        /// \brief Literal text or, for placeholders, the placeholder as written in the template.
+        QString text;
+        /// \brief Variable name, image type or block name.
+        QString name;
+        QSize size;
+        std::shared_ptr<const CompiledTemplate> block;
+    };
+
+    void parse(const QString& text);
+    void appendLiteral(const QString& text);
+
+    QVector<Token> m_tokens;
+};
+
+} // namespace mediaelch
@@ -95,70 +95,101 @@ static QString getStreamDetails(const StreamDetails* streamDetails, StreamDetail
     return values.join(", ");
 }
 
+/// \brief Resolves the accessor of each field once so that rows don't need to look up fields.
+template<class Column, class Field>
+static QVector<Column> resolveColumns(const QVector<Field>& fields, Column (*column)(Field))
+{
+    QVector<Column> columns;
+    columns.reserve(fields.size());
+    for (const Field field : fields) {
+        columns << column(field);
+    }
+    return columns;
+}
+
 namespace mediaelch {
 
+CsvWriter CsvMediaExport::csvWriter() const
+{
+    CsvWriter csv(m_out);
+    csv.setSeparator(m_separator);
+    csv.setReplacement(m_replacement);
+    return csv;
+}
+
 CsvMovieExport::CsvMovieExport(QTextStream& outStream, QVector<CsvMovieExport::Field> fields, QObject* parent) :
-    CsvMediaExport(outStream, parent), m_fields{fields}
+    CsvMediaExport(outStream, parent), m_fields{fields}, m_columns{resolveColumns(m_fields, &CsvMovieExport::column)}
 {
 }
 
 void CsvMovieExport::exportMovies(const QVector<Movie*>& movies, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Movie* movie : asConst(movies)) {
-        const auto* st = movie->streamDetails();
-        csv.addRow({
-            {s(Field::Imdbid), movie->imdbId().toString()},
-            {s(Field::Tmdbid), movie->tmdbId().toString()},
-            {s(Field::Title), movie->name()},
-            {s(Field::OriginalTitle), movie->originalName()},
-            {s(Field::SortTitle), movie->sortTitle()},
-            {s(Field::Overview), movie->overview()},
-            {s(Field::Outline), movie->outline()},
-            {s(Field::Ratings), ratingsToString(movie->ratings())},
-            {s(Field::UserRating), QString::number(movie->userRating())},
-            {s(Field::IsImdbTop250), QString::number(movie->top250())},
-            {s(Field::ReleaseDate), movie->released().isValid() ? movie->released().toString(Qt::ISODate) : ""},
-            {s(Field::Tagline), movie->tagline()},
-            {s(Field::Runtime), QString::number(movie->runtime().count())},
-            {s(Field::Certification), movie->certification().toString()},
-            {s(Field::Writers), movie->writer()},
-            {s(Field::Directors), movie->director()},
-            {s(Field::Genres), movie->genres().join(", ")},
-            {s(Field::Countries), movie->countries().join(", ")},
-            {s(Field::Studios), movie->studios().join(", ")},
-            {s(Field::Tags), movie->tags().join(", ")},
-            {s(Field::Trailer), movie->trailer().toString()},
-            {s(Field::Actors), actorsToString(movie->actors())},
-            {s(Field::PlayCount), QString::number(movie->playcount())},
-            {s(Field::LastPlayed), movie->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::MovieSet), movie->set().name},
-            {s(Field::Directory), dirFromFileList(movie->files())},
-            {s(Field::Filenames), filesToString(movie->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-        });
+    CsvWriter csv = csvWriter();
+    writeHeader(csv);
+    for (Movie* movie : movies) {
+        writeMovie(csv, *movie);
         callback();
     }
 }
 
+void CsvMovieExport::writeHeader(CsvWriter& csv) const
+{
+    csv.writeHeader(fieldsToStrings());
+}
+
+void CsvMovieExport::writeMovie(CsvWriter& csv, Movie& movie) const
+{
+    for (const Column accessor : m_columns) {
+        csv.addCell(accessor(movie));
+    }
+    csv.endRow();
+}
+
+CsvMovieExport::Column CsvMovieExport::column(Field field)
+{
+    // clang-format off
+    switch (field) {
+    case Field::Imdbid: return [](Movie& movie) { return movie.imdbId().toString(); };
+    case Field::Tmdbid: return [](Movie& movie) { return movie.tmdbId().toString(); };
+    case Field::Title: return [](Movie& movie) { return movie.name(); };
+    case Field::OriginalTitle: return [](Movie& movie) { return movie.originalName(); };
+    case Field::SortTitle: return [](Movie& movie) { return movie.sortTitle(); };
+    case Field::Overview: return [](Movie& movie) { return movie.overview(); };
+    case Field::Outline: return [](Movie& movie) { return movie.outline(); };
+    case Field::Ratings: return [](Movie& movie) { return ratingsToString(movie.ratings()); };
+    case Field::UserRating: return [](Movie& movie) { return QString::number(movie.userRating()); };
+    case Field::IsImdbTop250: return [](Movie& movie) { return QString::number(movie.top250()); };
+    case Field::ReleaseDate: return [](Movie& movie) { return movie.released().isValid() ? movie.released().toString(Qt::ISODate) : ""; };
+    case Field::Tagline: return [](Movie& movie) { return movie.tagline(); };
+    case Field::Runtime: return [](Movie& movie) { return QString::number(movie.runtime().count()); };
+    case Field::Certification: return [](Movie& movie) { return movie.certification().toString(); };
+    case Field::Writers: return [](Movie& movie) { return movie.writer(); };
+    case Field::Directors: return [](Movie& movie) { return movie.director(); };
+    case Field::Genres: return [](Movie& movie) { return movie.genres().join(", "); };
+    case Field::Countries: return [](Movie& movie) { return movie.countries().join(", "); };
+    case Field::Studios: return [](Movie& movie) { return movie.studios().join(", "); };
+    case Field::Tags: return [](Movie& movie) { return movie.tags().join(", "); };
+    case Field::Trailer: return [](Movie& movie) { return movie.trailer().toString(); };
+    case Field::Actors: return [](Movie& movie) { return actorsToString(movie.actors()); };
+    case Field::PlayCount: return [](Movie& movie) { return QString::number(movie.playcount()); };
+    case Field::LastPlayed: return [](Movie& movie) { return movie.lastPlayed().toString(Qt::ISODate); };
+    case Field::MovieSet: return [](Movie& movie) { return movie.set().name; };
+    case Field::Directory: return [](Movie& movie) { return dirFromFileList(movie.files()); };
+    case Field::Filenames: return [](Movie& movie) { return filesToString(movie.files()); };
+    case Field::StreamDetails_Video_DurationInSeconds: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::VideoDetails::DurationInSeconds); };
+    case Field::StreamDetails_Video_Aspect: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::VideoDetails::Aspect); };
+    case Field::StreamDetails_Video_Width: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::VideoDetails::Width); };
+    case Field::StreamDetails_Video_Height: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::VideoDetails::Height); };
+    case Field::StreamDetails_Video_Codec: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::VideoDetails::Codec); };
+    case Field::StreamDetails_Audio_Language: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::AudioDetails::Language); };
+    case Field::StreamDetails_Audio_Codec: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::AudioDetails::Codec); };
+    case Field::StreamDetails_Audio_Channels: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::AudioDetails::Channels); };
+    case Field::StreamDetails_Subtitle_Language: return [](Movie& movie) { return getStreamDetails(movie.streamDetails(), StreamDetails::SubtitleDetails::Language); };
+    }
+    // clang-format on
+    return [](Movie& /*movie*/) { return QString(); };
+}
+
 QVector<QString> CsvMovieExport::fieldsToStrings() const
 {
     QVector<QString> out;
@@ -218,42 +249,49 @@ CsvTvShowExport::CsvTvShowExport(QTextStream& outStream, QVector<CsvTvShowExport
 
 void CsvTvShowExport::exportTvShows(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
+    CsvWriter csv(m_out);
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
+    const QVector<Column> columns = resolveColumns(m_fields, &CsvTvShowExport::column);
     for (TvShow* show : shows) {
-        csv.addRow({
-            {s(Field::ShowTmdbId), show->tmdbId().toString()},
-            {s(Field::ShowImdbId), show->imdbId().toString()},
-            {s(Field::ShowTvDbId), show->tvdbId().toString()},
-            {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-            {s(Field::ShowTitle), show->title()},
-            {s(Field::ShowSortTitle), show->sortTitle()},
-            {s(Field::ShowOriginalTitle), show->originalTitle()},
-            {s(Field::ShowFirstAired), show->firstAired().toString(Qt::ISODate)},
-            {s(Field::ShowNetwork), show->network()},
-            {s(Field::ShowCertification), show->certification().toString()},
-            {s(Field::ShowGenres), show->genres().join(", ")},
-            {s(Field::ShowTags), show->tags().join(", ")},
-            {s(Field::ShowRuntime), QString::number(show->runtime().count())},
-            {s(Field::ShowRatings), ratingsToString(show->ratings())},
-            {s(Field::ShowUserRating), QString::number(show->userRating())},
-            {s(Field::ShowActors), actorsToString(show->actors())},
-            {s(Field::ShowOverview), show->overview()},
-            {s(Field::ShowIsImdbTop250), QString::number(show->top250())},
-            {s(Field::ShowDirectory), show->dir().toNativePathString()} //
-        });
-
+        for (const Column accessor : columns) {
+            csv.addCell(accessor(*show));
+        }
+        csv.endRow();
         callback();
     }
 }
 
+CsvTvShowExport::Column CsvTvShowExport::column(Field field)
+{
+    // clang-format off
+    switch (field) {
+    case Field::ShowTmdbId: return [](TvShow& show) { return show.tmdbId().toString(); };
+    case Field::ShowImdbId: return [](TvShow& show) { return show.imdbId().toString(); };
+    case Field::ShowTvDbId: return [](TvShow& show) { return show.tvdbId().toString(); };
+    case Field::ShowTvMazeId: return [](TvShow& show) { return show.tvmazeId().toString(); };
+    case Field::ShowTitle: return [](TvShow& show) { return show.title(); };
+    case Field::ShowSortTitle: return [](TvShow& show) { return show.sortTitle(); };
+    case Field::ShowOriginalTitle: return [](TvShow& show) { return show.originalTitle(); };
+    case Field::ShowFirstAired: return [](TvShow& show) { return show.firstAired().toString(Qt::ISODate); };
+    case Field::ShowNetwork: return [](TvShow& show) { return show.network(); };
+    case Field::ShowCertification: return [](TvShow& show) { return show.certification().toString(); };
+    case Field::ShowGenres: return [](TvShow& show) { return show.genres().join(", "); };
+    case Field::ShowTags: return [](TvShow& show) { return show.tags().join(", "); };
+    case Field::ShowRuntime: return [](TvShow& show) { return QString::number(show.runtime().count()); };
+    case Field::ShowRatings: return [](TvShow& show) { return ratingsToString(show.ratings()); };
+    case Field::ShowUserRating: return [](TvShow& show) { return QString::number(show.userRating()); };
+    case Field::ShowActors: return [](TvShow& show) { return actorsToString(show.actors()); };
+    case Field::ShowOverview: return [](TvShow& show) { return show.overview(); };
+    case Field::ShowIsImdbTop250: return [](TvShow& show) { return QString::number(show.top250()); };
+    case Field::ShowDirectory: return [](TvShow& show) { return show.dir().toNativePathString(); };
+    }
+    // clang-format on
+    return [](TvShow& /*show*/) { return QString(); };
+}
+
 QVector<QString> CsvTvShowExport::fieldsToStrings() const
 {
     QVector<QString> out;
@@ -299,59 +337,61 @@ CsvTvEpisodeExport::CsvTvEpisodeExport(QTextStream& outStream,
 
 void CsvTvEpisodeExport::exportEpisodes(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
+    CsvWriter csv(m_out);
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
+    const QVector<Column> columns = resolveColumns(m_fields, &CsvTvEpisodeExport::column);
     for (TvShow* show : shows) {
-        for (TvShowEpisode* episode : asConst(show->episodes())) {
-            const auto* st = episode->streamDetails();
-            csv.addRow({
-                {s(Field::ShowTmdbId), show->tmdbId().toString()},
-                {s(Field::ShowImdbId), show->imdbId().toString()},
-                {s(Field::ShowTvDbId), show->tvdbId().toString()},
-                {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-                {s(Field::ShowTitle), show->title()},
-                {s(Field::EpisodeSeason), episode->seasonNumber().toString()},
-                {s(Field::EpisodeNumber), episode->episodeNumber().toString()},
-                {s(Field::EpisodeTmdbId), episode->tmdbId().toString()},
-                {s(Field::EpisodeImdbId), episode->imdbId().toString()},
-                {s(Field::EpisodeTvDbId), episode->tvdbId().toString()},
-                {s(Field::EpisodeTvMazeId), episode->tvmazeId().toString()},
-                {s(Field::EpisodeFirstAired), episode->firstAired().toString(Qt::ISODate)},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeOverview), episode->overview()},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeUserRating), QString::number(episode->userRating())},
-                {s(Field::EpisodeActors), actorsToString(episode->actors())},
-                {s(Field::EpisodeDirectory), dirFromFileList(episode->files())},
-                {s(Field::EpisodeFilenames), filesToString(episode->files())},
-                {s(Field::EpisodeStreamDetails_Video_DurationInSeconds),
-                    getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-                {s(Field::EpisodeStreamDetails_Video_Aspect),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-                {s(Field::EpisodeStreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-                {s(Field::EpisodeStreamDetails_Video_Height),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-                {s(Field::EpisodeStreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Language),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-                {s(Field::EpisodeStreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Channels),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-                {s(Field::EpisodeStreamDetails_Subtitle_Language),
-                    getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-            });
+        for (TvShowEpisode* episode : show->episodes()) {
+            for (const Column accessor : columns) {
+                csv.addCell(accessor(*show, *episode));
+            }
+            csv.endRow();
         }
         callback();
     }
 }
 
+CsvTvEpisodeExport::Column CsvTvEpisodeExport::column(Field field)
+{
+    // clang-format off
+    switch (field) {
+    case Field::ShowTmdbId: return [](TvShow& show, TvShowEpisode& /*episode*/) { return show.tmdbId().toString(); };
+    case Field::ShowImdbId: return [](TvShow& show, TvShowEpisode& /*episode*/) { return show.imdbId().toString(); };
+    case Field::ShowTvDbId: return [](TvShow& show, TvShowEpisode& /*episode*/) { return show.tvdbId().toString(); };
+    case Field::ShowTvMazeId: return [](TvShow& show, TvShowEpisode& /*episode*/) { return show.tvmazeId().toString(); };
+    case Field::ShowTitle: return [](TvShow& show, TvShowEpisode& /*episode*/) { return show.title(); };
+    case Field::EpisodeSeason: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.seasonNumber().toString(); };
+    case Field::EpisodeNumber: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.episodeNumber().toString(); };
+    case Field::EpisodeTmdbId: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.tmdbId().toString(); };
+    case Field::EpisodeImdbId: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.imdbId().toString(); };
+    case Field::EpisodeTvDbId: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.tvdbId().toString(); };
+    case Field::EpisodeTvMazeId: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.tvmazeId().toString(); };
+    case Field::EpisodeFirstAired: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.firstAired().toString(Qt::ISODate); };
+    case Field::EpisodeTitle: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.title(); };
+    case Field::EpisodeOverview: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.overview(); };
+    case Field::EpisodeUserRating: return [](TvShow& /*show*/, TvShowEpisode& episode) { return QString::number(episode.userRating()); };
+    case Field::EpisodeWriters: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.writers().join(", "); };
+    case Field::EpisodeDirectors: return [](TvShow& /*show*/, TvShowEpisode& episode) { return episode.directors().join(", "); };
+    case Field::EpisodeActors: return [](TvShow& /*show*/, TvShowEpisode& episode) { return actorsToString(episode.actors()); };
+    case Field::EpisodeDirectory: return [](TvShow& /*show*/, TvShowEpisode& episode) { return dirFromFileList(episode.files()); };
+    case Field::EpisodeFilenames: return [](TvShow& /*show*/, TvShowEpisode& episode) { return filesToString(episode.files()); };
+    case Field::EpisodeStreamDetails_Video_DurationInSeconds: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::VideoDetails::DurationInSeconds); };
+    case Field::EpisodeStreamDetails_Video_Aspect: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::VideoDetails::Aspect); };
+    case Field::EpisodeStreamDetails_Video_Width: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::VideoDetails::Width); };
+    case Field::EpisodeStreamDetails_Video_Height: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::VideoDetails::Height); };
+    case Field::EpisodeStreamDetails_Video_Codec: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::VideoDetails::Codec); };
+    case Field::EpisodeStreamDetails_Audio_Language: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::AudioDetails::Language); };
+    case Field::EpisodeStreamDetails_Audio_Codec: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::AudioDetails::Codec); };
+    case Field::EpisodeStreamDetails_Audio_Channels: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::AudioDetails::Channels); };
+    case Field::EpisodeStreamDetails_Subtitle_Language: return [](TvShow& /*show*/, TvShowEpisode& episode) { return getStreamDetails(episode.streamDetails(), StreamDetails::SubtitleDetails::Language); };
+    }
+    // clang-format on
+    return [](TvShow& /*show*/, TvShowEpisode& /*episode*/) { return QString(); };
+}
+
 QVector<QString> CsvTvEpisodeExport::fieldsToStrings() const
 {
     QVector<QString> out;
@@ -404,54 +444,58 @@ CsvConcertExport::CsvConcertExport(QTextStream& outStream, QVector<CsvConcertExp
 
 void CsvConcertExport::exportConcerts(const QVector<Concert*>& concerts, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
+    CsvWriter csv(m_out);
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Concert* concert : asConst(concerts)) {
-        const auto* st = concert->streamDetails();
-        csv.addRow({
-            {s(Field::TmdbId), concert->tmdbId().toString()},
-            {s(Field::ImdbId), concert->imdbId().toString()},
-            {s(Field::Title), concert->name()},
-            {s(Field::Artist), concert->artist()},
-            {s(Field::Album), concert->album()},
-            {s(Field::Overview), concert->overview()},
-            {s(Field::Ratings), ratingsToString(concert->ratings())},
-            {s(Field::UserRating), QString::number(concert->userRating())},
-            {s(Field::ReleaseDate), concert->released().toString(Qt::ISODate)},
-            {s(Field::Tagline), concert->tagline()},
-            {s(Field::Runtime), QString::number(concert->runtime().count())},
-            {s(Field::Certification), concert->certification().toString()},
-            {s(Field::Genres), concert->genres().join(", ")},
-            {s(Field::Tags), concert->tags().join(", ")},
-            {s(Field::TrailerUrl), concert->trailer().toString()},
-            {s(Field::Playcount), QString::number(concert->playcount())},
-            {s(Field::LastPlayed), concert->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::Directory), dirFromFileList(concert->files())},
-            {s(Field::Filenames), filesToString(concert->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-
-        });
+    const QVector<Column> columns = resolveColumns(m_fields, &CsvConcertExport::column);
+    for (Concert* concert : concerts) {
+        for (const Column accessor : columns) {
+            csv.addCell(accessor(*concert));
+        }
+        csv.endRow();
         callback();
     }
 }
 
+CsvConcertExport::Column CsvConcertExport::column(Field field)
+{
+    // clang-format off
+    switch (field) {
+    case Field::TmdbId: return [](Concert& concert) { return concert.tmdbId().toString(); };
+    case Field::ImdbId: return [](Concert& concert) { return concert.imdbId().toString(); };
+    case Field::Title: return [](Concert& concert) { return concert.name(); };
+    case Field::Artist: return [](Concert& concert) { return concert.artist(); };
+    case Field::Album: return [](Concert& concert) { return concert.album(); };
+    case Field::Overview: return [](Concert& concert) { return concert.overview(); };
+    case Field::Ratings: return [](Concert& concert) { return ratingsToString(concert.ratings()); };
+    case Field::UserRating: return [](Concert& concert) { return QString::number(concert.userRating()); };
+    case Field::ReleaseDate: return [](Concert& concert) { return concert.released().toString(Qt::ISODate); };
+    case Field::Tagline: return [](Concert& concert) { return concert.tagline(); };
+    case Field::Runtime: return [](Concert& concert) { return QString::number(concert.runtime().count()); };
+    case Field::Certification: return [](Concert& concert) { return concert.certification().toString(); };
+    case Field::Genres: return [](Concert& concert) { return concert.genres().join(", "); };
+    case Field::Tags: return [](Concert& concert) { return concert.tags().join(", "); };
+    case Field::TrailerUrl: return [](Concert& concert) { return concert.trailer().toString(); };
+    case Field::Playcount: return [](Concert& concert) { return QString::number(concert.playcount()); };
+    case Field::LastPlayed: return [](Concert& concert) { return concert.lastPlayed().toString(Qt::ISODate); };
+    case Field::Directory: return [](Concert& concert) { return dirFromFileList(concert.files()); };
+    case Field::Filenames: return [](Concert& concert) { return filesToString(concert.files()); };
+    case Field::StreamDetails_Video_DurationInSeconds: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::VideoDetails::DurationInSeconds); };
+    case Field::StreamDetails_Video_Aspect: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::VideoDetails::Aspect); };
+    case Field::StreamDetails_Video_Width: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::VideoDetails::Width); };
+    case Field::StreamDetails_Video_Height: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::VideoDetails::Height); };
+    case Field::StreamDetails_Video_Codec: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::VideoDetails::Codec); };
+    case Field::StreamDetails_Audio_Language: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::AudioDetails::Language); };
+    case Field::StreamDetails_Audio_Codec: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::AudioDetails::Codec); };
+    case Field::StreamDetails_Audio_Channels: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::AudioDetails::Channels); };
+    case Field::StreamDetails_Subtitle_Language: return [](Concert& concert) { return getStreamDetails(concert.streamDetails(), StreamDetails::SubtitleDetails::Language); };
+    }
+    // clang-format on
+    return [](Concert& /*concert*/) { return QString(); };
+}
+
 QVector<QString> CsvConcertExport::fieldsToStrings() const
 {
     QVector<QString> out;
@@ -503,35 +547,43 @@ CsvArtistExport::CsvArtistExport(QTextStream& outStream, QVector<CsvArtistExport
 
 void CsvArtistExport::exportArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
+    CsvWriter csv(m_out);
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Artist* artist : asConst(artists)) {
-        csv.addRow({
-            {s(Field::ArtistName), artist->name()},
-            {s(Field::ArtistGenres), artist->genres().join(", ")},
-            {s(Field::ArtistStyles), artist->styles().join(", ")},
-            {s(Field::ArtistMoods), artist->moods().join(", ")},
-            {s(Field::ArtistYearsActive), artist->yearsActive()},
-            {s(Field::ArtistFormed), artist->formed()},
-            {s(Field::ArtistBiography), artist->biography()},
-            {s(Field::ArtistBorn), artist->born()},
-            {s(Field::ArtistDied), artist->died()},
-            {s(Field::ArtistDisbanded), artist->disbanded()},
-            {s(Field::ArtistMusicBrainzId), artist->mbId().toString()},
-            {s(Field::ArtistAllMusicId), artist->allMusicId().toString()},
-            {s(Field::ArtistDirectory), artist->path().toNativePathString()} //
-        });
+    const QVector<Column> columns = resolveColumns(m_fields, &CsvArtistExport::column);
+    for (Artist* artist : artists) {
+        for (const Column accessor : columns) {
+            csv.addCell(accessor(*artist));
+        }
+        csv.endRow();
         callback();
     }
 }
 
+CsvArtistExport::Column CsvArtistExport::column(Field field)
+{
+    // clang-format off
+    switch (field) {
+    case Field::ArtistName: return [](Artist& artist) { return artist.name(); };
+    case Field::ArtistGenres: return [](Artist& artist) { return artist.genres().join(", "); };
+    case Field::ArtistStyles: return [](Artist& artist) { return artist.styles().join(", "); };
+    case Field::ArtistMoods: return [](Artist& artist) { return artist.moods().join(", "); };
+    case Field::ArtistYearsActive: return [](Artist& artist) { return artist.yearsActive(); };
+    case Field::ArtistFormed: return [](Artist& artist) { return artist.formed(); };
+    case Field::ArtistBiography: return [](Artist& artist) { return artist.biography(); };
+    case Field::ArtistBorn: return [](Artist& artist) { return artist.born(); };
+    case Field::ArtistDied: return [](Artist& artist) { return artist.died(); };
+    case Field::ArtistDisbanded: return [](Artist& artist) { return artist.disbanded(); };
+    case Field::ArtistMusicBrainzId: return [](Artist& artist) { return artist.mbId().toString(); };
+    case Field::ArtistAllMusicId: return [](Artist& artist) { return artist.allMusicId().toString(); };
+    case Field::ArtistDirectory: return [](Artist& artist) { return artist.path().toNativePathString(); };
+    }
+    // clang-format on
+    return [](Artist& /*artist*/) { return QString(); };
+}
+
 QVector<QString> CsvArtistExport::fieldsToStrings() const
 {
     QVector<QString> out;
@@ -569,40 +621,48 @@ CsvAlbumExport::CsvAlbumExport(QTextStream& outStream, QVector<CsvAlbumExport::F
 
 void CsvAlbumExport::exportAlbumsOfArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
+    CsvWriter csv(m_out);
     csv.setSeparator(m_separator);
     csv.setReplacement(m_replacement);
+    csv.writeHeader(fieldsToStrings());
 
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Artist* artist : asConst(artists)) {
+    const QVector<Column> columns = resolveColumns(m_fields, &CsvAlbumExport::column);
+    for (Artist* artist : artists) {
         const auto albums = artist->albums();
         for (Album* album : albums) {
-            csv.addRow({
-                {s(Field::ArtistName), artist->name()},
-                {s(Field::AlbumTitle), album->title()},
-                {s(Field::AlbumArtistName), album->artist()},
-                {s(Field::AlbumGenres), album->genres().join(", ")},
-                {s(Field::AlbumStyles), album->styles().join(", ")},
-                {s(Field::AlbumMoods), album->moods().join(", ")},
-                {s(Field::AlbumReview), album->review()},
-                {s(Field::AlbumReleaseDate), album->releaseDate()},
-                {s(Field::AlbumLabel), album->label()},
-                {s(Field::AlbumRating), QString::number(album->rating())},
-                {s(Field::AlbumYear), QString::number(album->year())},
-                {s(Field::AlbumMusicBrainzId), album->mbAlbumId().toString()},
-                {s(Field::AlbumMusicBrainzReleaseGroupId), album->mbReleaseGroupId().toString()},
-                {s(Field::AlbumAllMusicId), album->allMusicId().toString()},
-                {s(Field::AlbumDirectory), album->path().toNativePathString()} //
-            });
+            for (const Column accessor : columns) {
+                csv.addCell(accessor(*artist, *album));
+            }
+            csv.endRow();
         }
         callback();
     }
 }
 
+CsvAlbumExport::Column CsvAlbumExport::column(Field field)
+{
+    // clang-format off
+    switch (field) {
+    case Field::ArtistName: return [](Artist& artist, Album& /*album*/) { return artist.name(); };
+    case Field::AlbumTitle: return [](Artist& /*artist*/, Album& album) { return album.title(); };
+    case Field::AlbumArtistName: return [](Artist& /*artist*/, Album& album) { return album.artist(); };
+    case Field::AlbumGenres: return [](Artist& /*artist*/, Album& album) { return album.genres().join(", "); };
+    case Field::AlbumStyles: return [](Artist& /*artist*/, Album& album) { return album.styles().join(", "); };
+    case Field::AlbumMoods: return [](Artist& /*artist*/, Album& album) { return album.moods().join(", "); };
+    case Field::AlbumReview: return [](Artist& /*artist*/, Album& album) { return album.review(); };
+    case Field::AlbumReleaseDate: return [](Artist& /*artist*/, Album& album) { return album.releaseDate(); };
+    case Field::AlbumLabel: return [](Artist& /*artist*/, Album& album) { return album.label(); };
+    case Field::AlbumRating: return [](Artist& /*artist*/, Album& album) { return QString::number(album.rating()); };
+    case Field::AlbumYear: return [](Artist& /*artist*/, Album& album) { return QString::number(album.year()); };
+    case Field::AlbumMusicBrainzId: return [](Artist& /*artist*/, Album& album) { return album.mbAlbumId().toString(); };
+    case Field::AlbumMusicBrainzReleaseGroupId: return [](Artist& /*artist*/, Album& album) { return album.mbReleaseGroupId().toString(); };
+    case Field::AlbumAllMusicId: return [](Artist& /*artist*/, Album& album) { return album.allMusicId().toString(); };
+    case Field::AlbumDirectory: return [](Artist& /*artist*/, Album& album) { return album.path().toNativePathString(); };
+    }
+    // clang-format on
+    return [](Artist& /*artist*/, Album& /*album*/) { return QString(); };
+}
+
 QVector<QString> CsvAlbumExport::fieldsToStrings() const
 {
     QVector<QString> out;
@@ -634,39 +694,38 @@ QString CsvAlbumExport::fieldToString(CsvAlbumExport::Field field)
     return "unknown";
 }
 
-void CsvExport::writeHeader()
+void CsvWriter::writeHeader(const QVector<QString>& columns)
 {
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(*i);
-    ++i;
+    for (const QString& column : columns) {
+        addCell(column);
+    }
+    endRow();
+}
 
-    for (; i != m_fieldsInOrder.cend(); ++i) {
+void CsvWriter::addCell(const QString& value)
+{
+    if (m_isFirstCell) {
+        m_isFirstCell = false;
+    } else {
         m_out << m_separator;
-        writeEscaped(*i);
     }
-    m_out << "\n";
+    writeEscaped(value);
 }
 
-void CsvExport::addRow(const QMap<QString, QString>& values)
+void CsvWriter::endRow()
 {
-    if (m_fieldsInOrder.isEmpty()) {
+    if (m_isFirstCell) {
+        // Rows without cells are not written, e.g. if no field was selected.
         return;
     }
-
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(values.value(*i));
-    ++i;
-
-    for (; i != m_fieldsInOrder.cend(); ++i) {
-        m_out << m_separator;
-        writeEscaped(values.value(*i));
-    }
-    m_out << "\n";
+    m_out << '\n';
+    m_isFirstCell = true;
+    ++m_rowCount;
 }
 
-void CsvExport::writeEscaped(const QString& text)
+void CsvWriter::writeEscaped(const QString& text)
 {
-    if (!text.contains(m_separator) && !text.contains("\n")) {
+    if (!text.contains(m_separator) && !text.contains('\n') && !text.contains('\r')) {
         m_out << text;
         return;
     }
@@ -3,7 +3,6 @@
 #include "data/Rating.h"
 #include "globals/Meta.h"
 
-#include <QMap>
 #include <QObject>
 #include <QRegularExpression>
 #include <QString>
@@ -14,11 +13,15 @@
 struct Actor;
 class Movie;
 class TvShow;
+class TvShowEpisode;
 class Concert;
 class Artist;
+class Album;
 
 namespace mediaelch {
 
+class CsvWriter;
+
 class CsvMediaExport : public QObject
 {
     Q_OBJECT
@@ -30,6 +33,9 @@ public:
     void setSeparator(QString separator) { m_separator = std::move(separator); }
     void setReplacement(QString replacement) { m_replacement = std::move(replacement); }
 
+    /// \brief Writer for the output stream with this export's separator and replacement.
+    CsvWriter csvWriter() const;
+
 protected:
     QTextStream& m_out;
     QString m_separator = "\t";
@@ -89,14 +95,24 @@ public:
 public:
     /// \brief Exports the given movies
     void exportMovies(const QVector<Movie*>& movies, std::function<void()> callback);
+    /// \brief Writes the header row of the export's fields.
+    /// \details Together with writeMovie(), movies can be exported one by one, e.g. to
+    ///          only keep the details of a few movies in memory at once.
+    void writeHeader(CsvWriter& csv) const;
+    /// \brief Writes the row of a single movie.
+    void writeMovie(CsvWriter& csv, Movie& movie) const;
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
 private:
     QVector<QString> fieldsToStrings() const;
 
+    using Column = QString (*)(Movie& movie);
+    static Column column(Field field);
+
 private:
     QVector<Field> m_fields;
+    QVector<Column> m_columns;
 };
 
 
@@ -142,6 +158,9 @@ public:
 private:
     QVector<QString> fieldsToStrings() const;
 
+    using Column = QString (*)(TvShow& show);
+    static Column column(Field field);
+
 private:
     QVector<Field> m_fields;
 };
@@ -198,6 +217,9 @@ public:
 private:
     QVector<QString> fieldsToStrings() const;
 
+    using Column = QString (*)(TvShow& show, TvShowEpisode& episode);
+    static Column column(Field field);
+
 private:
     QVector<Field> m_fields;
 };
@@ -253,6 +275,9 @@ public:
 private:
     QVector<QString> fieldsToStrings() const;
 
+    using Column = QString (*)(Concert& concert);
+    static Column column(Field field);
+
 private:
     QVector<Field> m_fields;
 };
@@ -293,6 +318,9 @@ public:
 private:
     QVector<QString> fieldsToStrings() const;
 
+    using Column = QString (*)(Artist& artist);
+    static Column column(Field field);
+
 private:
     QVector<Field> m_fields;
 };
@@ -335,34 +363,44 @@ public:
 private:
     QVector<QString> fieldsToStrings() const;
 
+    using Column = QString (*)(Artist& artist, Album& album);
+    static Column column(Field field);
+
 private:
     QVector<Field> m_fields;
 };
 
 
-class CsvExport : public QObject
+/// \brief Writes CSV rows cell by cell to a text stream.
+/// \details Rows are not collected: each cell is escaped and written to the stream directly.
+///          Memory usage therefore does not depend on the number of rows.
+class CsvWriter
 {
-    Q_OBJECT
-
 public:
-    explicit CsvExport(QTextStream& outStream, QObject* parent = nullptr) : QObject(parent), m_out{outStream} {}
+    explicit CsvWriter(QTextStream& outStream) : m_out{outStream} {}
 
-    void setFieldsInOrder(QVector<QString> fieldsInOrder) { m_fieldsInOrder = std::move(fieldsInOrder); }
     void setSeparator(QString separator) { m_separator = std::move(separator); }
     void setReplacement(QString replacement) { m_replacement = std::move(replacement); }
 
-    /// \brief Writes a CSV header using the given fieldsInOrder
-    void writeHeader();
-    void addRow(const QMap<QString, QString>& values);
+    /// \brief Writes a CSV header with the given column names.
+    void writeHeader(const QVector<QString>& columns);
+    /// \brief Writes the next cell of the current row.
+    void addCell(const QString& value);
+    /// \brief Ends the current row. Does nothing if the row has no cells.
+    void endRow();
+
+    /// \brief Number of rows written so far, including the header.
+    int rowCount() const { return m_rowCount; }
 
 private:
     void writeEscaped(const QString& text);
 
 private:
     QTextStream& m_out;
-    QVector<QString> m_fieldsInOrder;
-    QString m_separator;
-    QString m_replacement;
+    QString m_separator = "\t";
+    QString m_replacement = " ";
+    bool m_isFirstCell = true;
+    int m_rowCount = 0;
 };
 
 } // namespace mediaelch
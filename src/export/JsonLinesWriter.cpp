@@ -0,0 +1,15 @@
+#include "export/JsonLinesWriter.h"
+
+#include <QJsonDocument>
+
+namespace mediaelch {
+
+void JsonLinesWriter::write(const QJsonObject& object)
+{
+    // Compact JSON never contains unescaped newlines.
+    m_out << QJsonDocument(object).toJson(QJsonDocument::Compact).constData() << '\n';
+    m_out.flush();
+    ++m_count;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QJsonObject>
+#include <ostream>
+
+namespace mediaelch {
+
+/// \brief Writes newline-delimited JSON (one compact object per line).
+///
+/// Every object is flushed once it is written so that consumers, e.g. scripts
+/// that read mediaelch-cli's output through a pipe, can process it right away.
+class JsonLinesWriter
+{
+public:
+    explicit JsonLinesWriter(std::ostream& out) : m_out{out} {}
+
+    void write(const QJsonObject& object);
+    int count() const { return m_count; }
+
+private:
+    std::ostream& m_out;
+    int m_count = 0;
+};
+
+} // namespace mediaelch
@@ -30,11 +30,11 @@ void MediaExport::doExport(ExportTemplate& exportTemplate,
         connect(&engine, &SimpleEngine::sigItemExported, [&]() { emit sigItemExported(); });
 
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::Movies)) {
-            engine.exportMovies(Manager::instance()->movieModel()->movies());
+            engine.exportMovies(Manager::instance()->movieModel()->moviesWithDetails());
         }
 
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::TvShows)) {
-            engine.exportTvShows(Manager::instance()->tvShowModel()->tvShows());
+            engine.exportTvShows(Manager::instance()->tvShowModel()->tvShowsWithEpisodeDetails());
         }
 
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::Concerts)) {
@@ -3,12 +3,14 @@
 #include "concerts/Concert.h"
 #include "data/StreamDetails.h"
 #include "globals/Manager.h"
+#include "media_centers/MediaCenterInterface.h"
 #include "movies/Movie.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QApplication>
-#include <QEventLoop>
+#include <QMutexLocker>
+#include <QtConcurrent/QtConcurrentRun>
 
 static QString colorLabelToString(ColorLabel label)
 {
@@ -25,752 +27,771 @@ static QString colorLabelToString(ColorLabel label)
     return "white";
 }
 
-namespace mediaelch {
+namespace {
 
-SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
-    QDir directory,
-    std::atomic_bool& cancelFlag,
-    QObject* parent) :
-    QObject(parent), m_cancelFlag{cancelFlag}, m_template{&exportTemplate}, m_dir{directory}
-{
-    // Create the base structure
-    m_template->copyTo(m_dir.path());
-}
+using mediaelch::CompiledTemplate;
+using mediaelch::TemplateContext;
+using mediaelch::ValueTemplateContext;
 
-void SimpleEngine::exportMovies(QVector<Movie*> movies)
+/// \brief Context of list pages such as movies.html. The list block contains the already rendered items.
+class ListContext : public TemplateContext
 {
-    std::sort(movies.begin(), movies.end(), Movie::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Movies);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Movie);
-
-    QString listMovieItem;
-    QString listMovieBlock;
-    QStringList movieList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_MOVIE \}\}(.*)\{\{ END_BLOCK_MOVIE \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listMovieBlock = match.captured(0);
-        listMovieItem = match.captured(1).trimmed();
+public:
+    ListContext(QString blockName, const QVector<QString>& items) : m_blockName{std::move(blockName)}, m_items{items}
+    {
     }
 
-    m_dir.mkdir("movies");
-    m_dir.mkdir("movie_images");
-
-    for (Movie* movie : movies) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
-
-        // We can't replace an empty block...
-        if (!listMovieItem.isEmpty()) {
-            QString m = listMovieItem;
-            replaceVars(m, movie);
-            movieList << m;
+    bool appendBlock(const QString& name, const CompiledTemplate& /*item*/, QString& out) const override
+    {
+        if (name != m_blockName) {
+            return false;
         }
-
-        if (!itemContent.isEmpty()) {
-            QString movieTemplate = itemContent;
-            replaceVars(movieTemplate, movie, true);
-            QFile file(m_dir.path() + QStringLiteral("/movies/%1.html").arg(movie->movieId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(movieTemplate.toUtf8());
-                file.close();
+        for (int i = 0; i < m_items.size(); ++i) {
+            if (i > 0) {
+                out += '\n';
             }
+            out += m_items.at(i);
         }
-
-        emit sigItemExported();
-        QApplication::processEvents();
-    }
-
-    // If the movie block is empty, replacing it would result in add a line break after each character
-    if (!listMovieBlock.isEmpty()) {
-        listContent.replace(listMovieBlock, movieList.join("\n"));
+        return true;
     }
 
-    QFile file(m_dir.path() + "/movies.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
-    }
-}
+private:
+    QString m_blockName;
+    const QVector<QString>& m_items;
+};
 
-void SimpleEngine::replaceVars(QString& m, Movie* movie, bool subDir)
+/// \brief Values of a block such as ACTORS with the names ACTOR.NAME and ACTOR.ROLE.
+struct ValueBlock
 {
-    m.replace("{{ MOVIE.ID }}", QString::number(movie->movieId(), 'f', 0));
-    m.replace("{{ MOVIE.LINK }}", QString("movies/%1.html").arg(movie->movieId()));
-    m.replace("{{ MOVIE.IMDB_ID }}", movie->imdbId().toString());
-    m.replace("{{ MOVIE.TMDB_ID }}", movie->tmdbId().toString());
-    m.replace("{{ MOVIE.TITLE }}", movie->name().toHtmlEscaped());
-    m.replace("{{ MOVIE.YEAR }}", movie->released().isValid() ? movie->released().toString("yyyy") : "");
-    m.replace("{{ MOVIE.ORIGINAL_TITLE }}", movie->originalName().toHtmlEscaped());
-    m.replace("{{ MOVIE.PLOT }}", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.PLOT_SIMPLE }}", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.SET }}", movie->set().name.toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGLINE }}", movie->tagline().toHtmlEscaped());
-    m.replace("{{ MOVIE.GENRES }}", movie->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.COUNTRIES }}", movie->countries().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.STUDIOS }}", movie->studios().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGS }}", movie->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.WRITER }}", movie->writer().toHtmlEscaped());
-    m.replace("{{ MOVIE.DIRECTOR }}", movie->director().toHtmlEscaped());
-    m.replace("{{ MOVIE.CERTIFICATION }}", movie->certification().toString().toHtmlEscaped());
-    m.replace("{{ MOVIE.TRAILER }}", movie->trailer().toString());
-    m.replace("{{ MOVIE.LABEL }}", colorLabelToString(movie->label()));
-
-    // \todo multiple ratings
-    if (!movie->ratings().isEmpty()) {
-        double rating = movie->ratings().front().rating;
-        int voteCount = movie->ratings().front().voteCount;
-        m.replace("{{ MOVIE.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ MOVIE.VOTES }}", QString::number(voteCount, 'f', 0));
-    } else {
-        m.replace("{{ MOVIE.RATING }}", "n/a");
-        m.replace("{{ MOVIE.VOTES }}", "n/a");
-    }
-
-    m.replace("{{ MOVIE.RUNTIME }}", QString::number(movie->runtime().count(), 'f', 0));
-    m.replace("{{ MOVIE.PLAY_COUNT }}", QString::number(movie->playcount(), 'f', 0));
-    m.replace("{{ MOVIE.LAST_PLAYED }}",
-        movie->lastPlayed().isValid() ? movie->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace(
-        "{{ MOVIE.DATE_ADDED }}", movie->dateAdded().isValid() ? movie->dateAdded().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILE_LAST_MODIFIED }}",
-        movie->fileLastModified().isValid() ? movie->fileLastModified().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILENAME }}", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
-    if (!movie->files().isEmpty()) {
-        QFileInfo fi(movie->files().first().toString());
-        m.replace("{{ MOVIE.DIR }}", fi.absolutePath());
-    } else {
-        m.replace("{{ MOVIE.DIR }}", "");
-    }
-
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", movie->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", movie->genres());
-    replaceSingleBlock(m, "COUNTRIES", "COUNTRY.NAME", movie->countries());
-    replaceSingleBlock(m, "STUDIOS", "STUDIO.NAME", movie->studios());
+    QStringList names;
+    /// \brief One list per name, each with one value per entry.
+    QVector<QStringList> values;
+};
 
+ValueBlock actorBlock(const QVector<const Actor*>& actors)
+{
     QStringList actorNames;
     QStringList actorRoles;
-    for (const Actor* actor : movie->actors()) {
+    for (const Actor* actor : actors) {
         actorNames << actor->name;
         actorRoles << actor->role;
     }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, QVector<QStringList>() << actorNames << actorRoles);
-
-    replaceStreamDetailsVars(m, movie->streamDetails());
-    replaceImages(m, subDir, movie, nullptr, nullptr, nullptr);
+    return {{"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles}};
 }
 
-void SimpleEngine::exportConcerts(QVector<Concert*> concerts)
+/// \brief Renders the item for each entry, e.g. ACTORS with ACTOR.NAME and ACTOR.ROLE. Values are HTML escaped.
+void appendValueBlock(QString& out,
+    const CompiledTemplate& item,
+    const TemplateContext& parent,
+    const ValueBlock& block)
 {
-    std::sort(concerts.begin(), concerts.end(), Concert::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Concerts);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Concert);
-
-    QString listConcertItem;
-    QString listConcertBlock;
-    QStringList concertList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_CONCERT \}\}(.*)\{\{ END_BLOCK_CONCERT \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listConcertBlock = match.captured(0);
-        listConcertItem = match.captured(1).trimmed();
+    const int count = block.values.isEmpty() ? 0 : block.values.first().size();
+    for (int i = 0; i < count; ++i) {
+        ValueTemplateContext context(&parent);
+        for (int x = 0; x < block.names.size(); ++x) {
+            context.insert(block.names.at(x), block.values.at(x).at(i).toHtmlEscaped());
+        }
+        if (i > 0) {
+            out += ' ';
+        }
+        item.render(context, out);
     }
+}
 
-    m_dir.mkdir("concerts");
-    m_dir.mkdir("concert_images");
+void insertStreamDetailsVariables(QHash<QString, QString>& variables, const StreamDetails* details)
+{
+    const auto videoDetails = (details != nullptr) ? details->videoDetails() : decltype(details->videoDetails()){};
+    variables.insert("FILEINFO.WIDTH", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
+    variables.insert("FILEINFO.HEIGHT", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
+    variables.insert("FILEINFO.ASPECT", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
+    variables.insert("FILEINFO.CODEC", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
+    variables.insert("FILEINFO.DURATION", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
 
-    for (const Concert* concert : concerts) {
-        if (m_cancelFlag.load()) {
-            return;
+    QStringList audioCodecs;
+    QStringList audioChannels;
+    QStringList audioLanguages;
+    QStringList subtitleLanguages;
+    if (details != nullptr) {
+        for (const auto& audio : details->audioDetails()) {
+            audioCodecs << audio.value(StreamDetails::AudioDetails::Codec);
+            audioChannels << audio.value(StreamDetails::AudioDetails::Channels);
+            audioLanguages << audio.value(StreamDetails::AudioDetails::Language);
         }
-
-        QString concertTemplate = itemContent;
-        replaceVars(concertTemplate, concert, true);
-        QFile file(m_dir.path() + QString("/concerts/%1.html").arg(concert->concertId()));
-        if (file.open(QFile::WriteOnly | QFile::Text)) {
-            file.write(concertTemplate.toUtf8());
-            file.close();
+        for (const auto& subtitle : details->subtitleDetails()) {
+            subtitleLanguages << subtitle.value(StreamDetails::SubtitleDetails::Language);
         }
-
-        QString c = listConcertItem;
-        replaceVars(c, concert);
-        concertList << c;
-        emit sigItemExported();
-        QApplication::processEvents();
     }
+    variables.insert("FILEINFO.AUDIO.CODEC", audioCodecs.join("|"));
+    variables.insert("FILEINFO.AUDIO.CHANNELS", audioChannels.join("|"));
+    variables.insert("FILEINFO.AUDIO.LANGUAGE", audioLanguages.join("|"));
+    variables.insert("FILEINFO.SUBTITLES.LANGUAGE", subtitleLanguages.join("|"));
+}
 
-    listContent.replace(listConcertBlock, concertList.join("\n"));
+QString dateTimeString(const QDateTime& dateTime)
+{
+    return dateTime.isValid() ? dateTime.toString("yyyy-MM-dd hh:mm") : "";
+}
 
-    QFile file(m_dir.path() + "/concerts.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
-    }
+QString directoryOf(const mediaelch::FileList& files)
+{
+    return files.isEmpty() ? "" : QFileInfo(files.first().toString()).absolutePath();
 }
 
-void SimpleEngine::replaceVars(QString& m, const Concert* concert, bool subDir)
+QString fileNameOf(const mediaelch::FileList& files)
 {
-    m.replace("{{ CONCERT.ID }}", QString::number(concert->concertId(), 'f', 0));
-    m.replace("{{ CONCERT.LINK }}", QString("concerts/%1.html").arg(concert->concertId()));
-    m.replace("{{ CONCERT.TITLE }}", concert->name().toHtmlEscaped());
-    m.replace("{{ CONCERT.ARTIST }}", concert->artist().toHtmlEscaped());
-    m.replace("{{ CONCERT.ALBUM }}", concert->album().toHtmlEscaped());
-    m.replace("{{ CONCERT.TAGLINE }}", concert->tagline().toHtmlEscaped());
-
-    if (concert->ratings().isEmpty()) {
-        m.replace("{{ CONCERT.RATING }}", "n/a");
-    } else {
-        m.replace("{{ CONCERT.RATING }}", QString::number(concert->ratings().first().rating, 'f', 1));
-    }
+    return files.isEmpty() ? "" : files.first().toString();
+}
 
-    m.replace("{{ CONCERT.YEAR }}", concert->released().isValid() ? concert->released().toString("yyyy") : "");
-    m.replace("{{ CONCERT.RUNTIME }}", QString::number(concert->runtime().count(), 'f', 0));
-    m.replace("{{ CONCERT.CERTIFICATION }}", concert->certification().toString().toHtmlEscaped());
-    m.replace("{{ CONCERT.TRAILER }}", concert->trailer().toString());
-    m.replace("{{ CONCERT.PLAY_COUNT }}", QString::number(concert->playcount(), 'f', 0));
-    m.replace("{{ CONCERT.LAST_PLAYED }}",
-        concert->lastPlayed().isValid() ? concert->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
+QString htmlParagraphs(const QString& text)
+{
+    return text.toHtmlEscaped().replace("\n", "<br />");
+}
 
-    m.replace("{{ CONCERT.FILENAME }}", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
-    if (!concert->files().isEmpty()) {
-        QFileInfo fi(concert->files().first().toString());
-        m.replace("{{ CONCERT.DIR }}", fi.absolutePath());
-    } else {
-        m.replace("{{ CONCERT.DIR }}", "");
+void writeFile(const QString& fileName, const QString& content)
+{
+    QFile file(fileName);
+    if (file.open(QFile::WriteOnly | QFile::Text)) {
+        file.write(content.toUtf8());
+        file.close();
     }
-
-    m.replace("{{ CONCERT.PLOT }}", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ CONCERT.TAGS }}", concert->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ CONCERT.GENRES }}", concert->genres().join(", ").toHtmlEscaped());
-
-    replaceStreamDetailsVars(m, concert->streamDetails());
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", concert->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", concert->genres());
-    replaceImages(m, subDir, nullptr, concert, nullptr, nullptr);
 }
 
-void SimpleEngine::exportTvShows(QVector<TvShow*> shows)
+/// \brief Evaluates all fields of the item.
+template<class T>
+void insertFields(QHash<QString, QString>& variables, const QHash<QString, QString (*)(T&)>& fields, T& item)
 {
-    std::sort(shows.begin(), shows.end(), TvShow::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShows);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShow);
-    QString episodeContent = m_template->getTemplate(ExportTemplate::ExportSection::Episode);
-
-    QString listTvShowItem;
-    QString listTvShowBlock;
-    QStringList tvShowList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_TVSHOW \}\}(.*)\{\{ END_BLOCK_TVSHOW \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listTvShowBlock = match.captured(0);
-        listTvShowItem = match.captured(1).trimmed();
+    for (auto field = fields.constBegin(); field != fields.constEnd(); ++field) {
+        variables.insert(field.key(), field.value()(item));
     }
+}
 
-    m_dir.mkdir("tvshows");
-    m_dir.mkdir("tvshow_images");
-    m_dir.mkdir("episodes");
-    m_dir.mkdir("episode_images");
+/// \brief Image placeholder type, e.g. "poster", and the image's type and export format.
+struct ImageTypeFormat
+{
+    ImageType type;
+    QString format;
+};
 
-    for (TvShow* show : shows) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
+} // namespace
+
+namespace mediaelch {
 
-        // tvshow.html - Single TV show
-        {
-            QString showTemplate = itemContent;
-            replaceVars(showTemplate, show, true);
-            QFile file(m_dir.path() + QString("/tvshows/%1.html").arg(show->showId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(showTemplate.toUtf8());
-                file.close();
+/// \brief Everything that is rendered of a single movie, concert, TV show or episode.
+/// \details Items are created on the GUI thread before rendering starts, so that the
+///          thread pool only works on these values and never touches a QObject.
+struct SimpleEngine::ExportItem
+{
+    struct Image
+    {
+        /// \brief The item's image file. Empty if it has none and the default image is used.
+        QString fileName;
+        QString format;
+    };
+
+    /// \brief Name of the default images, e.g. "movie" for "defaults/movie_poster_200x300.png".
+    QString typeName;
+    /// \brief Name prefix of the exported images, e.g. "movie_images/12".
+    QString imagePrefix;
+    QHash<QString, QString> variables;
+    QHash<QString, ValueBlock> blocks;
+    /// \brief Images by placeholder type. Only types that are used by the templates are added.
+    QHash<QString, Image> images;
+
+    /// \brief Looks up the item's image files of all used image types.
+    template<class T>
+    void insertImages(const T* item,
+        const QHash<QString, ImageTypeFormat>& imageTypes,
+        const QSet<QString>& usedImageTypes)
+    {
+        MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
+        for (const QString& type : usedImageTypes) {
+            auto imageType = imageTypes.constFind(type);
+            if (imageType != imageTypes.constEnd()) {
+                images.insert(type, {mediaCenter->imageFileName(item, imageType->type), imageType->format});
             }
-            QApplication::processEvents();
         }
+    }
+};
 
-        // tvshows.html - All TV shows listed
-        {
-            QString showBlock = listTvShowItem;
-            replaceVars(showBlock, show, false);
-            tvShowList << showBlock;
-            emit sigItemExported();
-            QApplication::processEvents();
-        }
+/// \brief A TV show with its episodes.
+struct SimpleEngine::TvShowExportItem
+{
+    ExportItem show;
+    /// \brief All episodes of the show.
+    QVector<ExportItem> episodes;
+    /// \brief Seasons and their episodes' indexes, in the order of the SEASON and EPISODE blocks.
+    QVector<QPair<SeasonNumber, QVector<int>>> seasons;
+    /// \brief Indexes and ids of episodes that get their own page, i.e. all non-dummy episodes.
+    QVector<QPair<int, int>> episodePages;
+};
+
+/// \brief Renders an export item. Placeholders that the item doesn't know are looked up in the parent.
+class SimpleEngine::ItemContext : public TemplateContext
+{
+public:
+    ItemContext(SimpleEngine& engine, const ExportItem& item, bool subDir, const TemplateContext* parent = nullptr) :
+        TemplateContext(parent), m_engine{engine}, m_item{item}, m_subDir{subDir}
+    {
+    }
 
-        // episode.html - Single episode
-        for (TvShowEpisode* episode : show->episodes()) {
-            if (episode->isDummy()) {
-                continue;
-            }
-            QString episodeTemplate = episodeContent;
-            replaceVars(episodeTemplate, episode, true);
-            QFile file(m_dir.path() + QString("/episodes/%1.html").arg(episode->episodeId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(episodeTemplate.toUtf8());
-                file.close();
-            }
-            emit sigItemExported();
-            QApplication::processEvents();
+    bool appendVariable(const QString& name, QString& out) const override
+    {
+        auto value = m_item.variables.constFind(name);
+        if (value == m_item.variables.constEnd()) {
+            return false;
         }
+        out += value.value();
+        return true;
     }
 
-    listContent.replace(listTvShowBlock, tvShowList.join("\n"));
-
-    QFile file(m_dir.path() + "/tvshows.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    bool appendBlock(const QString& name, const CompiledTemplate& item, QString& out) const override
+    {
+        auto block = m_item.blocks.constFind(name);
+        if (block == m_item.blocks.constEnd()) {
+            return false;
+        }
+        appendValueBlock(out, item, *this, block.value());
+        return true;
     }
-}
 
-void SimpleEngine::replaceVars(QString& m, const TvShow* show, bool subDir)
-{
-    m.replace("{{ TVSHOW.ID }}", QString::number(show->showId(), 'f', 0));
-    m.replace("{{ TVSHOW.LINK }}", QString("tvshows/%1.html").arg(show->showId()));
-    m.replace("{{ TVSHOW.IMDB_ID }}", show->imdbId().toString());
-    m.replace("{{ TVSHOW.TITLE }}", show->title().toHtmlEscaped());
-    m.replace("{{ TVSHOW.SORTTITLE }}", show->sortTitle().toHtmlEscaped());
-    m.replace("{{ TVSHOW.ORIGINALTITLE }}", show->originalTitle().toHtmlEscaped());
-
-    // \todo multiple ratings
-    if (!show->ratings().isEmpty()) {
-        double rating = show->ratings().front().rating;
-        int voteCount = show->ratings().front().voteCount;
-        m.replace("{{ TVSHOW.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ TVSHOW.VOTES }}", QString::number(voteCount, 'f', 0));
-    } else {
-        m.replace("{{ TVSHOW.RATING }}", "n/a");
-        m.replace("{{ TVSHOW.VOTES }}", "n/a");
+    bool appendImage(const QString& type, QSize size, QString& out) const override
+    {
+        return m_engine.appendImage(out, m_item, type, size, m_subDir);
     }
 
-    m.replace("{{ TVSHOW.CERTIFICATION }}", show->certification().toString().toHtmlEscaped());
-    m.replace(
-        "{{ TVSHOW.FIRST_AIRED }}", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ TVSHOW.STUDIO }}", show->network().toHtmlEscaped());
-    m.replace("{{ TVSHOW.PLOT }}", show->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ TVSHOW.TAGS }}", show->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.GENRES }}", show->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.SEASONS_AMOUNT }}", QString::number(show->seasons(false).size()));
+protected:
+    SimpleEngine& m_engine;
+    const ExportItem& m_item;
+    bool m_subDir;
+};
 
-    QStringList actorNames;
-    QStringList actorRoles;
-    for (const Actor* actor : show->actors()) {
-        actorNames << actor->name;
-        actorRoles << actor->role;
+/// \brief A single season inside a TV show's SEASON block.
+class SimpleEngine::SeasonContext : public TemplateContext
+{
+public:
+    SeasonContext(SimpleEngine& engine,
+        const TvShowExportItem& show,
+        int seasonIndex,
+        bool subDir,
+        const TemplateContext* parent) :
+        TemplateContext(parent), m_engine{engine}, m_show{show}, m_seasonIndex{seasonIndex}, m_subDir{subDir}
+    {
     }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles});
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", show->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", show->genres());
-
-    QString listSeasonItem;
-    QString listSeasonBlock;
-    QStringList seasonList;
 
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_SEASON \}\}(.*)\{\{ END_BLOCK_SEASON \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
+    bool appendVariable(const QString& name, QString& out) const override
+    {
+        if (name != "SEASON") {
+            return false;
+        }
+        out += m_show.seasons.at(m_seasonIndex).first.toString();
+        return true;
+    }
 
+    bool appendBlock(const QString& name, const CompiledTemplate& item, QString& out) const override
     {
-        QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listSeasonBlock = match.captured(0);
-            listSeasonItem = match.captured(1).trimmed();
+        if (name != "EPISODE") {
+            return false;
+        }
+        const QVector<int>& episodes = m_show.seasons.at(m_seasonIndex).second;
+        for (int i = 0; i < episodes.size(); ++i) {
+            if (i > 0) {
+                out += '\n';
+            }
+            item.render(ItemContext(m_engine, m_show.episodes.at(episodes.at(i)), m_subDir, this), out);
         }
+        return true;
     }
 
-    if (listSeasonBlock.isEmpty() || listSeasonItem.isEmpty()) {
-        replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
-        return;
+private:
+    SimpleEngine& m_engine;
+    const TvShowExportItem& m_show;
+    int m_seasonIndex;
+    bool m_subDir;
+};
+
+class SimpleEngine::TvShowContext : public ItemContext
+{
+public:
+    TvShowContext(SimpleEngine& engine, const TvShowExportItem& show, bool subDir) :
+        ItemContext(engine, show.show, subDir), m_show{show}
+    {
     }
 
-    QVector<SeasonNumber> seasons = show->seasons(false);
-    std::sort(seasons.begin(), seasons.end());
-    for (const SeasonNumber& season : asConst(seasons)) {
-        QVector<TvShowEpisode*> episodes = show->episodes(season);
-        std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
-        QString s = listSeasonItem;
-        s.replace("{{ SEASON }}", season.toString());
-
-        QString listEpisodeItem;
-        QString listEpisodeBlock;
-        QStringList episodeList;
-
-        rx.setPattern(R"(\{\{ BEGIN_BLOCK_EPISODE \}\}(.*)\{\{ END_BLOCK_EPISODE \}\})");
-        QRegularExpressionMatchIterator matches = rx.globalMatch(s);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listEpisodeBlock = match.captured(0);
-            listEpisodeItem = match.captured(1).trimmed();
+    bool appendBlock(const QString& name, const CompiledTemplate& item, QString& out) const override
+    {
+        if (name != "SEASON") {
+            return ItemContext::appendBlock(name, item, out);
         }
-
-        if (!listEpisodeItem.isEmpty()) {
-            for (TvShowEpisode* episode : asConst(episodes)) {
-                QString e = listEpisodeItem;
-                replaceVars(e, episode, subDir);
-                episodeList << e;
+        for (int i = 0; i < m_show.seasons.size(); ++i) {
+            if (i > 0) {
+                out += '\n';
             }
+            item.render(SeasonContext(m_engine, m_show, i, m_subDir, this), out);
         }
-        s.replace(listEpisodeBlock, episodeList.join("\n"));
-        seasonList << s;
+        return true;
     }
 
-    m.replace(listSeasonBlock, seasonList.join("\n"));
-    replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
-}
+private:
+    const TvShowExportItem& m_show;
+};
 
-void SimpleEngine::replaceVars(QString& m, const TvShowEpisode* episode, bool subDir)
+SimpleEngine::ExportItem SimpleEngine::movieItem(Movie& movie, const QSet<QString>& imageTypes)
 {
-    m.replace("{{ SHOW.TITLE }}", episode->tvShow()->title().toHtmlEscaped());
-    m.replace("{{ SHOW.LINK }}", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
-    m.replace("{{ EPISODE.LINK }}", QString("../episodes/%1.html").arg(episode->episodeId()));
-    m.replace("{{ EPISODE.TITLE }}", episode->title().toHtmlEscaped());
-    m.replace("{{ EPISODE.SEASON }}", episode->seasonString().toHtmlEscaped());
-    m.replace("{{ EPISODE.EPISODE }}", episode->episodeString().toHtmlEscaped());
-    if (episode->ratings().isEmpty()) {
-        m.replace("{{ EPISODE.RATING }}", "n/a");
-    } else {
-        m.replace("{{ EPISODE.RATING }}", QString::number(episode->ratings().first().rating, 'f', 1));
-    }
-    m.replace("{{ EPISODE.CERTIFICATION }}", episode->certification().toString().toHtmlEscaped());
-    m.replace("{{ EPISODE.FIRST_AIRED }}",
-        episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ EPISODE.LAST_PLAYED }}",
-        episode->lastPlayed().isValid() ? episode->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ EPISODE.STUDIO }}", episode->network().toHtmlEscaped());
-    m.replace("{{ EPISODE.PLOT }}", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ EPISODE.WRITERS }}", episode->writers().join(", ").toHtmlEscaped());
-    m.replace("{{ EPISODE.DIRECTORS }}", episode->directors().join(", ").toHtmlEscaped());
-
-    if (!episode->files().isEmpty()) {
-        QFileInfo fi(episode->files().first().toString());
-        m.replace("{{ EPISODE.DIR }}", fi.absolutePath());
-    } else {
-        m.replace("{{ EPISODE.DIR }}", "");
-    }
-    m.replace("{{ EPISODE.FILENAME }}", (!episode->files().isEmpty()) ? episode->files().first().toString() : "");
-
-    replaceStreamDetailsVars(m, episode->streamDetails());
-    replaceSingleBlock(m, "WRITERS", "WRITER.NAME", episode->writers());
-    replaceSingleBlock(m, "DIRECTORS", "DIRECTOR.NAME", episode->directors());
-    replaceImages(m, subDir, nullptr, nullptr, nullptr, episode);
+    using Field = QString (*)(Movie&);
+    // clang-format off
+    static const QHash<QString, Field> fields = {
+        {"MOVIE.ID",             [](Movie& movie) { return QString::number(movie.movieId(), 'f', 0); }},
+        {"MOVIE.LINK",           [](Movie& movie) { return QString("movies/%1.html").arg(movie.movieId()); }},
+        {"MOVIE.IMDB_ID",        [](Movie& movie) { return movie.imdbId().toString(); }},
+        {"MOVIE.TMDB_ID",        [](Movie& movie) { return movie.tmdbId().toString(); }},
+        {"MOVIE.TITLE",          [](Movie& movie) { return movie.name().toHtmlEscaped(); }},
+        {"MOVIE.YEAR",           [](Movie& movie) { return movie.released().isValid() ? movie.released().toString("yyyy") : ""; }},
+        {"MOVIE.ORIGINAL_TITLE", [](Movie& movie) { return movie.originalName().toHtmlEscaped(); }},
+        {"MOVIE.PLOT",           [](Movie& movie) { return htmlParagraphs(movie.overview()); }},
+        {"MOVIE.PLOT_SIMPLE",    [](Movie& movie) { return htmlParagraphs(movie.outline()); }},
+        {"MOVIE.SET",            [](Movie& movie) { return movie.set().name.toHtmlEscaped(); }},
+        {"MOVIE.TAGLINE",        [](Movie& movie) { return movie.tagline().toHtmlEscaped(); }},
+        {"MOVIE.GENRES",         [](Movie& movie) { return movie.genres().join(", ").toHtmlEscaped(); }},
+        {"MOVIE.COUNTRIES",      [](Movie& movie) { return movie.countries().join(", ").toHtmlEscaped(); }},
+        {"MOVIE.STUDIOS",        [](Movie& movie) { return movie.studios().join(", ").toHtmlEscaped(); }},
+        {"MOVIE.TAGS",           [](Movie& movie) { return movie.tags().join(", ").toHtmlEscaped(); }},
+        {"MOVIE.WRITER",         [](Movie& movie) { return movie.writer().toHtmlEscaped(); }},
+        {"MOVIE.DIRECTOR",       [](Movie& movie) { return movie.director().toHtmlEscaped(); }},
+        {"MOVIE.CERTIFICATION",  [](Movie& movie) { return movie.certification().toString().toHtmlEscaped(); }},
+        {"MOVIE.TRAILER",        [](Movie& movie) { return movie.trailer().toString(); }},
+        {"MOVIE.LABEL",          [](Movie& movie) { return colorLabelToString(movie.label()); }},
+        // \todo multiple ratings
+        {"MOVIE.RATING",         [](Movie& movie) { return movie.ratings().isEmpty() ? QString("n/a") : QString::number(movie.ratings().front().rating, 'f', 1); }},
+        {"MOVIE.VOTES",          [](Movie& movie) { return movie.ratings().isEmpty() ? QString("n/a") : QString::number(movie.ratings().front().voteCount, 'f', 0); }},
+        {"MOVIE.RUNTIME",        [](Movie& movie) { return QString::number(movie.runtime().count(), 'f', 0); }},
+        {"MOVIE.PLAY_COUNT",     [](Movie& movie) { return QString::number(movie.playcount(), 'f', 0); }},
+        {"MOVIE.LAST_PLAYED",    [](Movie& movie) { return dateTimeString(movie.lastPlayed()); }},
+        {"MOVIE.DATE_ADDED",     [](Movie& movie) { return dateTimeString(movie.dateAdded()); }},
+        {"MOVIE.FILE_LAST_MODIFIED", [](Movie& movie) { return dateTimeString(movie.fileLastModified()); }},
+        {"MOVIE.FILENAME",       [](Movie& movie) { return fileNameOf(movie.files()); }},
+        {"MOVIE.DIR",            [](Movie& movie) { return directoryOf(movie.files()); }},
+    };
+    static const QHash<QString, ImageTypeFormat> images = {
+        {"poster",   {ImageType::MoviePoster,   "jpg"}},
+        {"fanart",   {ImageType::MovieBackdrop, "jpg"}},
+        {"logo",     {ImageType::MovieLogo,     "png"}},
+        {"clearart", {ImageType::MovieClearArt, "png"}},
+        {"disc",     {ImageType::MovieCdArt,    "png"}},
+    };
+    // clang-format on
+
+    ExportItem item;
+    item.typeName = "movie";
+    item.imagePrefix = QString("movie_images/%1").arg(movie.movieId());
+    insertFields(item.variables, fields, movie);
+    insertStreamDetailsVariables(item.variables, movie.streamDetails());
+    item.blocks.insert("TAGS", {{"TAG.NAME"}, {movie.tags()}});
+    item.blocks.insert("GENRES", {{"GENRE.NAME"}, {movie.genres()}});
+    item.blocks.insert("COUNTRIES", {{"COUNTRY.NAME"}, {movie.countries()}});
+    item.blocks.insert("STUDIOS", {{"STUDIO.NAME"}, {movie.studios()}});
+    item.blocks.insert("ACTORS", actorBlock(asConst(movie).actors()));
+    item.insertImages(&movie, images, imageTypes);
+    return item;
 }
 
-void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* details)
+SimpleEngine::ExportItem SimpleEngine::concertItem(const Concert& concert, const QSet<QString>& imageTypes)
 {
-    const auto videoDetails = (details != nullptr) ? details->videoDetails() : decltype(details->videoDetails()){};
-    const auto audioDetails = (details != nullptr) ? details->audioDetails() : decltype(details->audioDetails()){};
+    using Field = QString (*)(const Concert&);
+    // clang-format off
+    static const QHash<QString, Field> fields = {
+        {"CONCERT.ID",            [](const Concert& concert) { return QString::number(concert.concertId(), 'f', 0); }},
+        {"CONCERT.LINK",          [](const Concert& concert) { return QString("concerts/%1.html").arg(concert.concertId()); }},
+        {"CONCERT.TITLE",         [](const Concert& concert) { return concert.name().toHtmlEscaped(); }},
+        {"CONCERT.ARTIST",        [](const Concert& concert) { return concert.artist().toHtmlEscaped(); }},
+        {"CONCERT.ALBUM",         [](const Concert& concert) { return concert.album().toHtmlEscaped(); }},
+        {"CONCERT.TAGLINE",       [](const Concert& concert) { return concert.tagline().toHtmlEscaped(); }},
+        {"CONCERT.RATING",        [](const Concert& concert) { return concert.ratings().isEmpty() ? QString("n/a") : QString::number(concert.ratings().first().rating, 'f', 1); }},
+        {"CONCERT.YEAR",          [](const Concert& concert) { return concert.released().isValid() ? concert.released().toString("yyyy") : ""; }},
+        {"CONCERT.RUNTIME",       [](const Concert& concert) { return QString::number(concert.runtime().count(), 'f', 0); }},
+        {"CONCERT.CERTIFICATION", [](const Concert& concert) { return concert.certification().toString().toHtmlEscaped(); }},
+        {"CONCERT.TRAILER",       [](const Concert& concert) { return concert.trailer().toString(); }},
+        {"CONCERT.PLAY_COUNT",    [](const Concert& concert) { return QString::number(concert.playcount(), 'f', 0); }},
+        {"CONCERT.LAST_PLAYED",   [](const Concert& concert) { return dateTimeString(concert.lastPlayed()); }},
+        {"CONCERT.FILENAME",      [](const Concert& concert) { return fileNameOf(concert.files()); }},
+        {"CONCERT.DIR",           [](const Concert& concert) { return directoryOf(concert.files()); }},
+        {"CONCERT.PLOT",          [](const Concert& concert) { return htmlParagraphs(concert.overview()); }},
+        {"CONCERT.TAGS",          [](const Concert& concert) { return concert.tags().join(", ").toHtmlEscaped(); }},
+        {"CONCERT.GENRES",        [](const Concert& concert) { return concert.genres().join(", ").toHtmlEscaped(); }},
+    };
+    static const QHash<QString, ImageTypeFormat> images = {
+        {"poster",   {ImageType::ConcertPoster,   "jpg"}},
+        {"fanart",   {ImageType::ConcertBackdrop, "jpg"}},
+        {"logo",     {ImageType::ConcertLogo,     "png"}},
+        {"clearart", {ImageType::ConcertClearArt, "png"}},
+        {"disc",     {ImageType::ConcertCdArt,    "png"}},
+    };
+    // clang-format on
+
+    ExportItem item;
+    item.typeName = "concert";
+    // Concert images have always been exported to movie_images.
+    item.imagePrefix = QString("movie_images/%1").arg(concert.concertId());
+    insertFields(item.variables, fields, concert);
+    insertStreamDetailsVariables(item.variables, concert.streamDetails());
+    item.blocks.insert("TAGS", {{"TAG.NAME"}, {concert.tags()}});
+    item.blocks.insert("GENRES", {{"GENRE.NAME"}, {concert.genres()}});
+    item.insertImages(&concert, images, imageTypes);
+    return item;
+}
 
-    m.replace("{{ FILEINFO.WIDTH }}", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
-    m.replace("{{ FILEINFO.HEIGHT }}", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
-    m.replace("{{ FILEINFO.ASPECT }}", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
-    m.replace("{{ FILEINFO.CODEC }}", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
-    m.replace("{{ FILEINFO.DURATION }}", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
+SimpleEngine::ExportItem SimpleEngine::episodeItem(const TvShowEpisode& episode, const QSet<QString>& imageTypes)
+{
+    using Field = QString (*)(const TvShowEpisode&);
+    // clang-format off
+    static const QHash<QString, Field> fields = {
+        {"SHOW.TITLE",             [](const TvShowEpisode& episode) { return episode.tvShow()->title().toHtmlEscaped(); }},
+        {"SHOW.LINK",              [](const TvShowEpisode& episode) { return QString("../tvshows/%1.html").arg(episode.tvShow()->showId()); }},
+        {"EPISODE.LINK",           [](const TvShowEpisode& episode) { return QString("../episodes/%1.html").arg(episode.episodeId()); }},
+        {"EPISODE.TITLE",          [](const TvShowEpisode& episode) { return episode.title().toHtmlEscaped(); }},
+        {"EPISODE.SEASON",         [](const TvShowEpisode& episode) { return episode.seasonString().toHtmlEscaped(); }},
+        {"EPISODE.EPISODE",        [](const TvShowEpisode& episode) { return episode.episodeString().toHtmlEscaped(); }},
+        {"EPISODE.RATING",         [](const TvShowEpisode& episode) { return episode.ratings().isEmpty() ? QString("n/a") : QString::number(episode.ratings().first().rating, 'f', 1); }},
+        {"EPISODE.CERTIFICATION",  [](const TvShowEpisode& episode) { return episode.certification().toString().toHtmlEscaped(); }},
+        {"EPISODE.FIRST_AIRED",    [](const TvShowEpisode& episode) { return episode.firstAired().isValid() ? episode.firstAired().toString("yyyy-MM-dd") : ""; }},
+        {"EPISODE.LAST_PLAYED",    [](const TvShowEpisode& episode) { return dateTimeString(episode.lastPlayed()); }},
+        {"EPISODE.STUDIO",         [](const TvShowEpisode& episode) { return episode.network().toHtmlEscaped(); }},
+        {"EPISODE.PLOT",           [](const TvShowEpisode& episode) { return htmlParagraphs(episode.overview()); }},
+        {"EPISODE.WRITERS",        [](const TvShowEpisode& episode) { return episode.writers().join(", ").toHtmlEscaped(); }},
+        {"EPISODE.DIRECTORS",      [](const TvShowEpisode& episode) { return episode.directors().join(", ").toHtmlEscaped(); }},
+        {"EPISODE.DIR",            [](const TvShowEpisode& episode) { return directoryOf(episode.files()); }},
+        {"EPISODE.FILENAME",       [](const TvShowEpisode& episode) { return fileNameOf(episode.files()); }},
+    };
+    static const QHash<QString, ImageTypeFormat> images = {
+        {"thumbnail", {ImageType::TvShowEpisodeThumb, "jpg"}},
+    };
+    // clang-format on
+
+    ExportItem item;
+    item.typeName = "episode";
+    item.imagePrefix = QString("episode_images/%1").arg(episode.episodeId());
+    insertFields(item.variables, fields, episode);
+    insertStreamDetailsVariables(item.variables, episode.streamDetails());
+    item.blocks.insert("WRITERS", {{"WRITER.NAME"}, {episode.writers()}});
+    item.blocks.insert("DIRECTORS", {{"DIRECTOR.NAME"}, {episode.directors()}});
+    item.insertImages(&episode, images, imageTypes);
+    return item;
+}
 
-    QStringList audioCodecs;
-    QStringList audioChannels;
-    QStringList audioLanguages;
-    for (int i = 0, n = audioDetails.count(); i < n; ++i) {
-        audioCodecs << audioDetails.at(i).value(StreamDetails::AudioDetails::Codec);
-        audioChannels << audioDetails.at(i).value(StreamDetails::AudioDetails::Channels);
-        audioLanguages << audioDetails.at(i).value(StreamDetails::AudioDetails::Language);
+SimpleEngine::TvShowExportItem SimpleEngine::tvShowItem(const TvShow& show, const QSet<QString>& imageTypes)
+{
+    using Field = QString (*)(const TvShow&);
+    // clang-format off
+    static const QHash<QString, Field> fields = {
+        {"TVSHOW.ID",             [](const TvShow& show) { return QString::number(show.showId(), 'f', 0); }},
+        {"TVSHOW.LINK",           [](const TvShow& show) { return QString("tvshows/%1.html").arg(show.showId()); }},
+        {"TVSHOW.IMDB_ID",        [](const TvShow& show) { return show.imdbId().toString(); }},
+        {"TVSHOW.TITLE",          [](const TvShow& show) { return show.title().toHtmlEscaped(); }},
+        {"TVSHOW.SORTTITLE",      [](const TvShow& show) { return show.sortTitle().toHtmlEscaped(); }},
+        {"TVSHOW.ORIGINALTITLE",  [](const TvShow& show) { return show.originalTitle().toHtmlEscaped(); }},
+        // \todo multiple ratings
+        {"TVSHOW.RATING",         [](const TvShow& show) { return show.ratings().isEmpty() ? QString("n/a") : QString::number(show.ratings().front().rating, 'f', 1); }},
+        {"TVSHOW.VOTES",          [](const TvShow& show) { return show.ratings().isEmpty() ? QString("n/a") : QString::number(show.ratings().front().voteCount, 'f', 0); }},
+        {"TVSHOW.CERTIFICATION",  [](const TvShow& show) { return show.certification().toString().toHtmlEscaped(); }},
+        {"TVSHOW.FIRST_AIRED",    [](const TvShow& show) { return show.firstAired().isValid() ? show.firstAired().toString("yyyy-MM-dd") : ""; }},
+        {"TVSHOW.STUDIO",         [](const TvShow& show) { return show.network().toHtmlEscaped(); }},
+        {"TVSHOW.PLOT",           [](const TvShow& show) { return htmlParagraphs(show.overview()); }},
+        {"TVSHOW.TAGS",           [](const TvShow& show) { return show.tags().join(", ").toHtmlEscaped(); }},
+        {"TVSHOW.GENRES",         [](const TvShow& show) { return show.genres().join(", ").toHtmlEscaped(); }},
+        {"TVSHOW.SEASONS_AMOUNT", [](const TvShow& show) { return QString::number(show.seasons(false).size()); }},
+    };
+    static const QHash<QString, ImageTypeFormat> images = {
+        {"poster",       {ImageType::TvShowPoster,       "jpg"}},
+        {"fanart",       {ImageType::TvShowBackdrop,     "jpg"}},
+        {"banner",       {ImageType::TvShowBanner,       "jpg"}},
+        {"logo",         {ImageType::TvShowLogos,        "png"}},
+        {"clearart",     {ImageType::TvShowClearArt,     "png"}},
+        {"characterart", {ImageType::TvShowCharacterArt, "png"}},
+    };
+    // clang-format on
+
+    TvShowExportItem item;
+    item.show.typeName = "tvshow";
+    item.show.imagePrefix = QString("tvshow_images/%1").arg(show.showId());
+    insertFields(item.show.variables, fields, show);
+    item.show.blocks.insert("ACTORS", actorBlock(show.actors()));
+    item.show.blocks.insert("TAGS", {{"TAG.NAME"}, {show.tags()}});
+    item.show.blocks.insert("GENRES", {{"GENRE.NAME"}, {show.genres()}});
+    item.show.insertImages(&show, images, imageTypes);
+
+    QHash<const TvShowEpisode*, int> episodeIndexes;
+    for (const TvShowEpisode* episode : show.episodes()) {
+        episodeIndexes.insert(episode, item.episodes.size());
+        if (!episode->isDummy()) {
+            item.episodePages.append({item.episodes.size(), episode->episodeId()});
+        }
+        item.episodes << episodeItem(*episode, imageTypes);
     }
-    m.replace("{{ FILEINFO.AUDIO.CODEC }}", audioCodecs.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.CHANNELS }}", audioChannels.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.LANGUAGE }}", audioLanguages.join("|"));
 
-    QStringList subtitleLanguages;
-    if (details != nullptr) {
-        for (auto& subtitle : details->subtitleDetails()) {
-            subtitleLanguages << subtitle.value(StreamDetails::SubtitleDetails::Language);
+    QVector<SeasonNumber> seasons = show.seasons(false);
+    std::sort(seasons.begin(), seasons.end());
+    for (SeasonNumber season : seasons) {
+        QVector<TvShowEpisode*> episodes = show.episodes(season);
+        std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
+        QVector<int> indexes;
+        for (const TvShowEpisode* episode : episodes) {
+            auto index = episodeIndexes.constFind(episode);
+            if (index != episodeIndexes.constEnd()) {
+                indexes << index.value();
+            } else {
+                indexes << item.episodes.size();
+                item.episodes << episodeItem(*episode, imageTypes);
+            }
         }
+        item.seasons.append({season, indexes});
     }
-    m.replace("{{ FILEINFO.SUBTITLES.LANGUAGE }}", subtitleLanguages.join("|"));
+    return item;
 }
 
-void SimpleEngine::replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces)
+SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
+    QDir directory,
+    std::atomic_bool& cancelFlag,
+    QObject* parent) :
+    QObject(parent), m_cancelFlag{cancelFlag}, m_template{&exportTemplate}, m_dir{directory}
 {
-    replaceMultiBlock(m, blockName, QStringList() << itemName, QVector<QStringList>() << replaces);
+    // Create the base structure
+    m_template->copyTo(m_dir.path());
 }
 
-void SimpleEngine::replaceMultiBlock(QString& m,
-    QString blockName,
-    QStringList itemNames,
-    QVector<QStringList> replaces)
+SimpleEngine::~SimpleEngine()
 {
-    QRegularExpression rx("\\{\\{ BEGIN_BLOCK_" + blockName + R"( \}\}(.*)\{\{ END_BLOCK_)" + blockName + " \\}\\}", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatch match = rx.match(m);
-    if (match.hasMatch()) {
-        QString block = match.captured(0);
-        QString item = match.captured(1).trimmed();
-        QStringList list;
-        for (int i = 0, n = replaces.at(0).count(); i < n; ++i) {
-            QString subItem = item;
-            for (int x = 0, y = itemNames.count(); x < y; ++x) {
-                subItem.replace("{{ " + itemNames.at(x) + " }}", replaces.at(x).at(i).toHtmlEscaped());
-            }
-            list << subItem;
-        }
-        m.replace(block, list.join(" "));
-    }
+    m_pool.clear();
+    m_pool.waitForDone();
 }
 
-void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality)
+void SimpleEngine::exportMovies(QVector<Movie*> movies)
 {
-    Q_UNUSED(format)
-    Q_UNUSED(quality)
-
-    QImage img(imageFile);
-    if (img.isNull()) {
-        qWarning() << "[Export][SimpleEngine] Cannot load image:" << imageFile;
-        return;
-    }
+    std::sort(movies.begin(), movies.end(), Movie::lessThan);
+    const CompiledTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Movies));
+    const CompiledTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Movie));
+    const CompiledTemplate* listItemTemplate = listTemplate.block("MOVIE");
+    // We can't replace an empty block...
+    const bool hasListItem = listItemTemplate != nullptr && !listItemTemplate->isEmpty();
 
-    img = img.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    m_dir.mkdir("movies");
+    m_dir.mkdir("movie_images");
 
-    if (!img.isNull()) {
-        img.save(destinationFile);
-    } else {
-        qWarning() << "[Export][SimpleEngine] Could not scale (result was empty):" << imageFile;
+    const QSet<QString> imageTypes = listTemplate.imageTypes().unite(itemTemplate.imageTypes());
+    QVector<ExportItem> items;
+    items.reserve(movies.size());
+    for (Movie* movie : asConst(movies)) {
+        items << movieItem(*movie, imageTypes);
+    }
+
+    QVector<QString> movieList(hasListItem ? items.size() : 0);
+    QString* listItems = movieList.data();
+
+    for (int i = 0; i < items.size(); ++i) {
+        const ExportItem* item = &items.at(i);
+        const QString fileName = m_dir.path() + QStringLiteral("/movies/%1.html").arg(movies.at(i)->movieId());
+        QtConcurrent::run(
+            &m_pool, [this, item, fileName, i, listItems, listItemTemplate, hasListItem, &itemTemplate]() {
+                if (m_cancelFlag.load()) {
+                    return;
+                }
+                if (hasListItem) {
+                    listItems[i] = listItemTemplate->render(ItemContext(*this, *item, false));
+                }
+                if (!itemTemplate.isEmpty()) {
+                    writeFile(fileName, itemTemplate.render(ItemContext(*this, *item, true)));
+                }
+                ++m_itemsExported;
+            });
+    }
+    waitForPool();
+
+    if (m_cancelFlag.load()) {
+        return;
     }
+    writeFile(m_dir.path() + "/movies.html", listTemplate.render(ListContext("MOVIE", movieList)));
 }
 
-void SimpleEngine::replaceImages(QString& m,
-    const bool& subDir,
-    const Movie* movie,
-    const Concert* concert,
-    const TvShow* tvShow,
-    const TvShowEpisode* episode)
+void SimpleEngine::exportConcerts(QVector<Concert*> concerts)
 {
-    QString item;
-    QSize size;
-    QRegularExpression rx(R"(\{\{ IMAGE.(.*)\[(\d*), ?(\d*)\] \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        item = match.captured(0);
-        QString type = match.captured(1).toLower();
-        size.setWidth(match.captured(2).toInt());
-        size.setHeight(match.captured(3).toInt());
-
-        if (item.isEmpty() || size.isEmpty()) {
-            continue;
-        }
-
-        QString destFile;
-        bool imageSaved = false;
-        bool isPlaceholderUsed = true;
-        QString typeName;
-        if (movie != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, movie, &isPlaceholderUsed);
-            typeName = "movie";
-
-        } else if (concert != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, concert, &isPlaceholderUsed);
-            typeName = "concert";
-
-        } else if (tvShow != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, tvShow, &isPlaceholderUsed);
-            typeName = "tvshow";
-
-        } else if (episode != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, episode, &isPlaceholderUsed);
-            typeName = "episode";
-        }
-
-        if (!isPlaceholderUsed) {
-            continue;
-        }
+    std::sort(concerts.begin(), concerts.end(), Concert::lessThan);
+    const CompiledTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Concerts));
+    const CompiledTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Concert));
+    const CompiledTemplate* listItemTemplate = listTemplate.block("CONCERT");
 
-        if (imageSaved) {
-            m.replace(item, (subDir ? "../" : "") + destFile);
-        } else {
-            m.replace(item,
-                (subDir ? "../" : "")
-                    + QString("defaults/%1_%2_%3x%4.png").arg(typeName).arg(type).arg(size.width()).arg(size.height()));
-        }
-    }
-}
+    m_dir.mkdir("concerts");
+    m_dir.mkdir("concert_images");
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const Movie* movie,
-    bool* isPlaceHolderUsed)
-{
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::MoviePoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::MovieBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::MovieLogo;
-    } else if (type == "clearart") {
-        imageType = ImageType::MovieClearArt;
-    } else if (type == "disc") {
-        imageType = ImageType::MovieCdArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
+    const QSet<QString> imageTypes = listTemplate.imageTypes().unite(itemTemplate.imageTypes());
+    QVector<ExportItem> items;
+    items.reserve(concerts.size());
+    for (const Concert* concert : asConst(concerts)) {
+        items << concertItem(*concert, imageTypes);
     }
 
-    *isPlaceHolderUsed = true;
+    QVector<QString> concertList(items.size());
+    QString* listItems = concertList.data();
 
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "movie_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(movie->movieId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
-
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(movie, imageType);
-    if (filename.isEmpty()) {
-        return false;
+    for (int i = 0; i < items.size(); ++i) {
+        const ExportItem* item = &items.at(i);
+        const QString fileName = m_dir.path() + QString("/concerts/%1.html").arg(concerts.at(i)->concertId());
+        QtConcurrent::run(&m_pool, [this, item, fileName, i, listItems, listItemTemplate, &itemTemplate]() {
+            if (m_cancelFlag.load()) {
+                return;
+            }
+            writeFile(fileName, itemTemplate.render(ItemContext(*this, *item, true)));
+            if (listItemTemplate != nullptr) {
+                listItems[i] = listItemTemplate->render(ItemContext(*this, *item, false));
+            }
+            ++m_itemsExported;
+        });
     }
+    waitForPool();
 
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
-
-    return true;
+    if (m_cancelFlag.load()) {
+        return;
+    }
+    writeFile(m_dir.path() + "/concerts.html", listTemplate.render(ListContext("CONCERT", concertList)));
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const Concert* concert,
-    bool* isPlaceHolderUsed)
+void SimpleEngine::exportTvShows(QVector<TvShow*> shows)
 {
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::ConcertPoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::ConcertBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::ConcertLogo;
-    } else if (type == "clearart") {
-        imageType = ImageType::ConcertClearArt;
-    } else if (type == "disc") {
-        imageType = ImageType::ConcertCdArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
-    }
-
-    *isPlaceHolderUsed = true;
+    std::sort(shows.begin(), shows.end(), TvShow::lessThan);
+    const CompiledTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::TvShows));
+    const CompiledTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::TvShow));
+    const CompiledTemplate episodeTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Episode));
+    const CompiledTemplate* listItemTemplate = listTemplate.block("TVSHOW");
 
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "movie_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(concert->concertId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
+    m_dir.mkdir("tvshows");
+    m_dir.mkdir("tvshow_images");
+    m_dir.mkdir("episodes");
+    m_dir.mkdir("episode_images");
 
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(concert, imageType);
-    if (filename.isEmpty()) {
-        return false;
+    const QSet<QString> imageTypes =
+        listTemplate.imageTypes().unite(itemTemplate.imageTypes()).unite(episodeTemplate.imageTypes());
+    QVector<TvShowExportItem> items;
+    items.reserve(shows.size());
+    for (const TvShow* show : asConst(shows)) {
+        items << tvShowItem(*show, imageTypes);
+    }
+
+    QVector<QString> tvShowList(items.size());
+    QString* listItems = tvShowList.data();
+
+    for (int i = 0; i < items.size(); ++i) {
+        const TvShowExportItem* item = &items.at(i);
+        const QString fileName = m_dir.path() + QString("/tvshows/%1.html").arg(shows.at(i)->showId());
+        QtConcurrent::run(&m_pool,
+            [this, item, fileName, i, listItems, listItemTemplate, &itemTemplate, &episodeTemplate]() {
+                if (m_cancelFlag.load()) {
+                    return;
+                }
+                // tvshow.html - Single TV show
+                writeFile(fileName, itemTemplate.render(TvShowContext(*this, *item, true)));
+
+                // tvshows.html - All TV shows listed
+                if (listItemTemplate != nullptr) {
+                    listItems[i] = listItemTemplate->render(TvShowContext(*this, *item, false));
+                }
+                ++m_itemsExported;
+
+                // episode.html - Single episode
+                for (const auto& page : item->episodePages) {
+                    if (m_cancelFlag.load()) {
+                        return;
+                    }
+                    writeFile(m_dir.path() + QString("/episodes/%1.html").arg(page.second),
+                        episodeTemplate.render(ItemContext(*this, item->episodes.at(page.first), true)));
+                    ++m_itemsExported;
+                }
+            });
+    }
+    waitForPool();
+
+    if (m_cancelFlag.load()) {
+        return;
     }
+    writeFile(m_dir.path() + "/tvshows.html", listTemplate.render(ListContext("TVSHOW", tvShowList)));
+}
 
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
+void SimpleEngine::waitForPool()
+{
+    const auto reportProgress = [this]() {
+        const int exported = m_itemsExported.load();
+        for (; m_itemsReported < exported; ++m_itemsReported) {
+            emit sigItemExported();
+        }
+    };
 
-    return true;
+    while (!m_pool.waitForDone(20)) {
+        if (m_cancelFlag.load()) {
+            // Remove all items and images that were not started, yet.
+            m_pool.clear();
+        }
+        reportProgress();
+        QApplication::processEvents();
+    }
+    reportProgress();
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const TvShow* tvShow,
-    bool* isPlaceHolderUsed)
+void SimpleEngine::queueImage(QSize size, QString imageFile, QString destinationFile, QString format, int quality)
 {
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::TvShowPoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::TvShowBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "banner") {
-        imageType = ImageType::TvShowBanner;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::TvShowLogos;
-    } else if (type == "clearart") {
-        imageType = ImageType::TvShowClearArt;
-    } else if (type == "characterart") {
-        imageType = ImageType::TvShowCharacterArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
+    {
+        // Images are often used in the list and on the item's page.
+        QMutexLocker locker(&m_imageMutex);
+        if (m_queuedImages.contains(destinationFile)) {
+            return;
+        }
+        m_queuedImages.insert(destinationFile);
     }
-    *isPlaceHolderUsed = true;
+    QtConcurrent::run(&m_pool, [this, size, imageFile, destinationFile, format, quality]() {
+        if (!m_cancelFlag.load()) {
+            saveImage(size, imageFile, destinationFile, format, quality);
+        }
+    });
+}
 
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "tvshow_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(tvShow->showId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
+void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, QString format, int quality)
+{
+    Q_UNUSED(format)
+    Q_UNUSED(quality)
 
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(tvShow, imageType);
-    if (filename.isEmpty()) {
-        return false;
+    QImage img(imageFile);
+    if (img.isNull()) {
+        qWarning() << "[Export][SimpleEngine] Cannot load image:" << imageFile;
+        return;
     }
 
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
+    img = img.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 
-    return true;
+    if (!img.isNull()) {
+        img.save(destinationFile);
+    } else {
+        qWarning() << "[Export][SimpleEngine] Could not scale (result was empty):" << imageFile;
+    }
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const TvShowEpisode* episode,
-    bool* isPlaceHolderUsed)
+bool SimpleEngine::appendImage(QString& out, const ExportItem& item, const QString& type, QSize size, bool subDir)
 {
-    destFile = "episode_images/"
-               + QString("%1-%2_%3x%4.jpg").arg(episode->episodeId()).arg(type).arg(size.width()).arg(size.height());
-
-    if (type == "thumbnail") {
-        *isPlaceHolderUsed = true;
-        QString filename =
-            Manager::instance()->mediaCenterInterface()->imageFileName(episode, ImageType::TvShowEpisodeThumb);
-        if (filename.isEmpty()) {
-            return false;
-        }
-        saveImage(size, filename, m_dir.path() + "/" + destFile, "jpg", 90);
-    } else {
-        *isPlaceHolderUsed = false;
+    auto image = item.images.constFind(type);
+    if (image == item.images.constEnd()) {
         return false;
     }
+    if (subDir) {
+        out += "../";
+    }
+    if (image->fileName.isEmpty()) {
+        out += QString("defaults/%1_%2_%3x%4.png").arg(item.typeName).arg(type).arg(size.width()).arg(size.height());
+        return true;
+    }
 
+    const QString destFile = QString("%1-%2_%3x%4.%5")
+                                 .arg(item.imagePrefix)
+                                 .arg(type)
+                                 .arg(size.width())
+                                 .arg(size.height())
+                                 .arg(image->format);
+    const int imageQuality = (image->format == "jpg") ? 90 : -1;
+    queueImage(size, image->fileName, m_dir.path() + "/" + destFile, image->format, imageQuality);
+    out += destFile;
     return true;
 }
 
@@ -1,9 +1,13 @@
 #pragma once
 
+#include "export/CompiledTemplate.h"
 #include "export/ExportTemplate.h"
 
 #include <QDir>
+#include <QMutex>
 #include <QObject>
+#include <QSet>
+#include <QThreadPool>
 #include <atomic>
 
 class Concert;
@@ -16,6 +20,11 @@ namespace mediaelch {
 
 /// Default export engine for MediaElch. Simple find&replace semantics,
 /// only basic functionality (e.g. condintional block)
+///
+/// Templates are compiled once per export (see CompiledTemplate).  The values of
+/// all items, including their image files, are collected on the GUI thread.  Items
+/// are then rendered and written on a thread pool, images are scaled and saved on
+/// the same pool while other items are rendered.
 class SimpleEngine : public QObject
 {
     Q_OBJECT
@@ -24,6 +33,7 @@ public:
         QDir directory,
         std::atomic_bool& cancelFlag,
         QObject* parent = nullptr);
+    ~SimpleEngine() override;
 
 signals:
     /// Signal is emitted each time an item is exported (e.g. image, generated HTML, etc.)
@@ -36,45 +46,41 @@ public:
     void exportTvShows(QVector<TvShow*> shows);
 
 private:
-    void saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality);
-    void replaceImages(QString& m,
-        const bool& subDir,
-        const Movie* movie,
-        const Concert* concert,
-        const TvShow* tvShow,
-        const TvShowEpisode* episode);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const Movie* movie,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const Concert* concert,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const TvShow* tvShow,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const TvShowEpisode* episode,
-        bool* isPlaceHolderUsed);
-    void replaceVars(QString& m, Movie* movie, bool subDir = false);
-    void replaceVars(QString& m, const Concert* concert, bool subDir = false);
-    void replaceVars(QString& m, const TvShow* show, bool subDir = false);
-    void replaceVars(QString& m, const TvShowEpisode* episode, bool subDir = false);
-    void replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces);
-    void replaceMultiBlock(QString& m, QString blockName, QStringList itemNames, QVector<QStringList> replaces);
-    void replaceStreamDetailsVars(QString& m, const StreamDetails* details);
+    struct ExportItem;
+    struct TvShowExportItem;
+    class ItemContext;
+    class SeasonContext;
+    class TvShowContext;
+
+    /// \brief Collects the values of the item on the GUI thread, see ExportItem.
+    /// \param imageTypes Image placeholder types used by the templates.
+    static ExportItem movieItem(Movie& movie, const QSet<QString>& imageTypes);
+    static ExportItem concertItem(const Concert& concert, const QSet<QString>& imageTypes);
+    static ExportItem episodeItem(const TvShowEpisode& episode, const QSet<QString>& imageTypes);
+    static TvShowExportItem tvShowItem(const TvShow& show, const QSet<QString>& imageTypes);
+
+    /// \brief Waits until all queued items and images are exported. Processes events meanwhile
+    /// and emits sigItemExported() for each exported item.
+    void waitForPool();
+    /// \brief Scales and saves the image on the thread pool. Each destination is only saved once.
+    void queueImage(QSize size, QString imageFile, QString destinationFile, QString format, int quality);
+    static void saveImage(QSize size, QString imageFile, QString destinationFile, QString format, int quality);
+    /// \brief Appends the path of the item's exported image and queues it. Called on the thread pool.
+    bool appendImage(QString& out, const ExportItem& item, const QString& type, QSize size, bool subDir);
 
 private:
     std::atomic_bool& m_cancelFlag;
     ExportTemplate* m_template = nullptr;
     QDir m_dir;
+
+    std::atomic<int> m_itemsExported{0};
+    int m_itemsReported = 0;
+
+    QMutex m_imageMutex;
+    QSet<QString> m_queuedImages;
+
+    // Must be the last member: its destructor waits for all tasks, which use the members above.
+    QThreadPool m_pool;
 };
 
 } // namespace mediaelch
@@ -0,0 +1,132 @@
+#include "file/DirectoryJournal.h"
+
+#include "globals/Meta.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+
+namespace mediaelch {
+
+namespace {
+
+QString parentDirectory(const QString& path)
+{
+    return path.left(path.lastIndexOf('/'));
+}
+
+} // namespace
+
+DirectoryJournal::DirectoryJournal(QHash<QString, DirectorySnapshot> previous) : m_previous(std::move(previous))
+{
+    for (auto it = m_previous.constBegin(); it != m_previous.constEnd(); ++it) {
+        if (it.value().inode != 0) {
+            m_previousInodes.insert(it.value().inode, it.key());
+        }
+        m_previousChildren.insert(parentDirectory(it.key()), it.key());
+    }
+}
+
+bool DirectoryJournal::walk(const QString& root, const FileLister& listFiles, const ProgressCallback& onProgress)
+{
+    // The root's parent is not part of the last scan, i.e. the root is never its child.
+    m_previousChildren.remove(parentDirectory(root), root);
+    return walkDirectory(root, listFiles, onProgress);
+}
+
+bool DirectoryJournal::isUnchanged(const QString& path) const
+{
+    return m_current.contains(path) && !m_changed.contains(path);
+}
+
+QStringList DirectoryJournal::removedDirectories() const
+{
+    QStringList removed;
+    for (auto it = m_previous.constBegin(); it != m_previous.constEnd(); ++it) {
+        if (!m_current.contains(it.key()) && !m_moved.contains(it.key())) {
+            removed << it.key();
+        }
+    }
+    removed.sort();
+    return removed;
+}
+
+void DirectoryJournal::discard(const QString& path)
+{
+    m_changed.remove(path);
+    m_contents.remove(path);
+    m_current.remove(path);
+}
+
+bool DirectoryJournal::walkDirectory(const QString& path,
+    const FileLister& listFiles,
+    const ProgressCallback& onProgress)
+{
+    if (m_current.contains(path)) {
+        return true;
+    }
+
+    const DirectorySnapshot snapshot = DirectorySnapshot::fromPath(path);
+    if (!snapshot.isValid()) {
+        return true;
+    }
+    m_current.insert(path, snapshot);
+
+    if (onProgress && m_current.size() % 50 == 0 && !onProgress(path)) {
+        return false;
+    }
+
+    // Path of this directory in the last scan if its content is unchanged.
+    QString previousPath;
+    if (m_previous.value(path) == snapshot) {
+        previousPath = path;
+
+    } else if (snapshot.inode != 0 && !m_previous.contains(path)) {
+        const QString candidate = m_previousInodes.value(snapshot.inode);
+        if (!candidate.isEmpty() && m_previous.value(candidate) == snapshot && !QFileInfo::exists(candidate)) {
+            qDebug() << "[DirectoryJournal] Directory was moved from" << candidate << "to" << path;
+            m_moved.insert(candidate, path);
+            previousPath = candidate;
+        }
+    }
+
+    QStringList subDirs;
+    if (!previousPath.isEmpty()) {
+        // Unchanged directory: Its sub-directories are known but may have changed themselves.
+        for (const QString& child : m_previousChildren.values(previousPath)) {
+            subDirs << path + child.mid(previousPath.length());
+        }
+        // Disc structures are required to group files of changed sub-directories.
+        const QString dirName = QFileInfo(path).fileName();
+        if (QString::compare(dirName, "BDMV", Qt::CaseInsensitive) == 0 && QFileInfo::exists(path + "/index.bdmv")) {
+            m_bluRays << parentDirectory(path);
+        } else if (QString::compare(dirName, "VIDEO_TS", Qt::CaseInsensitive) == 0
+                   && QFileInfo::exists(path + "/VIDEO_TS.IFO")) {
+            m_dvds << parentDirectory(path);
+        }
+
+    } else {
+        m_changed.insert(path);
+        for (const QFileInfo& subDir : QDir(path).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            if (subDir.isSymLink()) {
+                // Avoid symlink loops
+                const QString target = subDir.canonicalFilePath();
+                if (m_visitedLinks.contains(target)) {
+                    continue;
+                }
+                m_visitedLinks.insert(target);
+            }
+            subDirs << subDir.filePath();
+        }
+        m_contents.insert(path, listFiles(path, *this));
+    }
+
+    for (const QString& subDir : asConst(subDirs)) {
+        if (!walkDirectory(subDir, listFiles, onProgress)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace mediaelch
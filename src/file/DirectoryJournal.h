@@ -0,0 +1,83 @@
+#pragma once
+
+#include "file/DirectorySnapshot.h"
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Compares a directory tree with the directory snapshots of the last scan.
+///
+/// Unchanged directories are only stat()ed, their sub-directories are taken from
+/// the last scan.  A directory that does not exist at its old path anymore but
+/// has the same inode and modification time at a new path was moved.  Only new
+/// or changed directories are listed.
+///
+/// \par Example
+/// \code{cpp}
+///   DirectoryJournal journal(database->movieDirectorySnapshots(rootDir));
+///   journal.walk(rootPath, [](const QString& path, DirectoryJournal&) { return QDir(path).entryList(); });
+///   database->setMovieDirectorySnapshots(rootDir, journal.current());
+/// \endcode
+class DirectoryJournal
+{
+public:
+    /// \brief Lists the relevant files directly inside a new or changed directory.
+    using FileLister = std::function<QStringList(const QString& path, DirectoryJournal& journal)>;
+    /// \brief Called regularly while walking. The walk is aborted if false is returned.
+    using ProgressCallback = std::function<bool(const QString& path)>;
+
+    explicit DirectoryJournal(QHash<QString, DirectorySnapshot> previous = {});
+
+    /// \brief Walks the directory tree below (and including) the given root.
+    /// \return False if the walk was aborted.
+    bool walk(const QString& root, const FileLister& listFiles, const ProgressCallback& onProgress = {});
+
+    /// \brief Snapshots of all directories found by walk().
+    const QHash<QString, DirectorySnapshot>& current() const { return m_current; }
+    /// \brief Files of all new or changed directories, keyed by directory.
+    const QMap<QString, QStringList>& contents() const { return m_contents; }
+
+    bool isChanged(const QString& path) const { return m_changed.contains(path); }
+    /// \brief Whether the directory exists, was not moved and its content is unchanged.
+    bool isUnchanged(const QString& path) const;
+    /// \brief New path of a directory of the last scan that was moved; empty otherwise.
+    QString movedTo(const QString& previousPath) const { return m_moved.value(previousPath); }
+    /// \brief Directories of the last scan that neither exist anymore nor were moved.
+    QStringList removedDirectories() const;
+
+    /// \brief Forgets a new or changed directory so that it is compared again in the next scan.
+    void discard(const QString& path);
+
+    void addBluRay(const QString& path) { m_bluRays << path; }
+    void addDvd(const QString& path) { m_dvds << path; }
+    /// \brief Directories containing a BluRay structure, including unchanged ones.
+    QStringList& bluRays() { return m_bluRays; }
+    /// \brief Directories containing a DVD structure, including unchanged ones.
+    QStringList& dvds() { return m_dvds; }
+
+private:
+    bool walkDirectory(const QString& path, const FileLister& listFiles, const ProgressCallback& onProgress);
+
+    // Last scan
+    QHash<QString, DirectorySnapshot> m_previous;
+    QHash<quint64, QString> m_previousInodes;
+    QMultiHash<QString, QString> m_previousChildren;
+    // Current scan
+    QHash<QString, DirectorySnapshot> m_current;
+    /// Directories that were moved but are unchanged otherwise: old path -> new path
+    QHash<QString, QString> m_moved;
+    /// New or changed directories; only those are listed
+    QSet<QString> m_changed;
+    QMap<QString, QStringList> m_contents;
+    QSet<QString> m_visitedLinks;
+    QStringList m_bluRays;
+    QStringList m_dvds;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,48 @@
+#include "file/DirectorySnapshot.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+
+#if defined(Q_OS_MAC) || defined(Q_OS_LINUX)
+#    include <sys/stat.h>
+#endif
+
+namespace mediaelch {
+
+DirectorySnapshot DirectorySnapshot::fromPath(const QString& path)
+{
+    DirectorySnapshot snapshot;
+#if defined(Q_OS_MAC) || defined(Q_OS_LINUX)
+    // A single stat() call is enough to get both, the inode and the modification time.
+    struct stat buf;
+    if (::stat(QFile::encodeName(path).constData(), &buf) != 0 || !S_ISDIR(buf.st_mode)) {
+        return snapshot;
+    }
+    snapshot.inode = static_cast<quint64>(buf.st_ino);
+#    ifdef Q_OS_MAC
+    snapshot.lastModified = static_cast<qint64>(buf.st_mtimespec.tv_sec) * 1000 + buf.st_mtimespec.tv_nsec / 1000000;
+#    else
+    snapshot.lastModified = static_cast<qint64>(buf.st_mtim.tv_sec) * 1000 + buf.st_mtim.tv_nsec / 1000000;
+#    endif
+#else
+    QFileInfo info(path);
+    if (!info.isDir()) {
+        return snapshot;
+    }
+    snapshot.lastModified = info.lastModified().toMSecsSinceEpoch();
+#endif
+    return snapshot;
+}
+
+bool operator==(const DirectorySnapshot& lhs, const DirectorySnapshot& rhs)
+{
+    return lhs.lastModified == rhs.lastModified && lhs.inode == rhs.inode;
+}
+
+bool operator!=(const DirectorySnapshot& lhs, const DirectorySnapshot& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace mediaelch
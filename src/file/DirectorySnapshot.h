@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+namespace mediaelch {
+
+/// \brief Modification state and identity of a single directory.
+///
+/// A directory's modification time changes whenever an entry is added,
+/// removed or renamed inside of it (but not if a file's content changes
+/// or if something changes in a sub-directory).  Together with the inode
+/// a snapshot can be used to detect unchanged and moved directories without
+/// listing their content.  The inode is only available on Linux and macOS
+/// and is 0 on other systems.
+struct DirectorySnapshot
+{
+    /// \brief Reads the snapshot of the given directory.
+    /// Returns an invalid snapshot if the directory can't be read.
+    static DirectorySnapshot fromPath(const QString& path);
+
+    bool isValid() const { return lastModified != 0; }
+
+    /// Milliseconds since epoch
+    qint64 lastModified = 0;
+    quint64 inode = 0;
+};
+
+bool operator==(const DirectorySnapshot& lhs, const DirectorySnapshot& rhs);
+bool operator!=(const DirectorySnapshot& lhs, const DirectorySnapshot& rhs);
+
+} // namespace mediaelch
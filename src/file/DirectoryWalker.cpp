@@ -0,0 +1,177 @@
+#include "file/DirectoryWalker.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSemaphore>
+#include <QStorageInfo>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <deque>
+
+namespace mediaelch {
+
+struct DirectoryWalker::WorkerQueue
+{
+    QMutex mutex;
+    std::deque<Task> tasks;
+};
+
+namespace {
+
+// Used to wake up idle workers if new tasks are available or mount slots are free again.
+QMutex s_idleMutex;
+QWaitCondition s_idle;
+
+void wakeIdleWorkers()
+{
+    QMutexLocker locker(&s_idleMutex);
+    s_idle.wakeAll();
+}
+
+} // namespace
+
+DirectoryWalker::DirectoryWalker(int maxConcurrencyPerMount) :
+    m_maxConcurrencyPerMount{qMax(1, maxConcurrencyPerMount)}
+{
+}
+
+DirectoryWalker::~DirectoryWalker() = default;
+
+void DirectoryWalker::setMaxConcurrencyPerMount(int maxConcurrency)
+{
+    m_maxConcurrencyPerMount = qMax(1, maxConcurrency);
+}
+
+int DirectoryWalker::maxConcurrencyPerMount() const
+{
+    return m_maxConcurrencyPerMount;
+}
+
+void DirectoryWalker::setProcessEvents(bool processEvents)
+{
+    m_processEvents = processEvents;
+}
+
+void DirectoryWalker::abort()
+{
+    m_aborted = true;
+}
+
+bool DirectoryWalker::isAborted() const
+{
+    return m_aborted;
+}
+
+void DirectoryWalker::walk(const QStringList& roots, const Visitor& visitor)
+{
+    m_aborted = false;
+    if (roots.isEmpty()) {
+        return;
+    }
+
+    // Roots on the same mount point share their concurrency limit.
+    QHash<QString, int> mounts;
+    QVector<Task> initialTasks;
+    for (const QString& root : roots) {
+        const QString mountPoint = QStorageInfo(root).rootPath();
+        if (!mounts.contains(mountPoint)) {
+            mounts.insert(mountPoint, mounts.size());
+        }
+        initialTasks.push_back({root, mounts.value(mountPoint)});
+    }
+
+    const int threadCount = qBound(1, mounts.size() * m_maxConcurrencyPerMount, 64);
+
+    m_queues.clear();
+    m_mountSlots.clear();
+    for (int i = 0; i < threadCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < mounts.size(); ++i) {
+        m_mountSlots.push_back(std::make_unique<QSemaphore>(m_maxConcurrencyPerMount));
+    }
+    for (int i = 0; i < initialTasks.size(); ++i) {
+        m_queues[static_cast<std::size_t>(i % threadCount)]->tasks.push_back(initialTasks[i]);
+    }
+    m_pending = initialTasks.size();
+
+    qDebug() << "[DirectoryWalker] Walking" << roots.size() << "directories on" << mounts.size()
+             << "mount points using" << threadCount << "threads";
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        QtConcurrent::run(&pool, [this, i, &visitor]() { runWorker(i, visitor); });
+    }
+    if (m_processEvents) {
+        while (!pool.waitForDone(20)) {
+            QCoreApplication::processEvents();
+        }
+    } else {
+        pool.waitForDone();
+    }
+
+    m_queues.clear();
+    m_mountSlots.clear();
+}
+
+void DirectoryWalker::runWorker(int index, const Visitor& visitor)
+{
+    while (!m_aborted) {
+        Task task;
+        if (!takeTask(index, task)) {
+            if (m_pending == 0) {
+                return;
+            }
+            // Either all tasks are taken or their mount points are busy.
+            QMutexLocker locker(&s_idleMutex);
+            s_idle.wait(&s_idleMutex, 10);
+            continue;
+        }
+
+        const QStringList subDirs = visitor(task.path);
+        m_mountSlots[static_cast<std::size_t>(task.mount)]->release();
+
+        if (!subDirs.isEmpty()) {
+            // New tasks must be counted before the current one is finished.
+            m_pending += subDirs.size();
+            WorkerQueue& queue = *m_queues[static_cast<std::size_t>(index)];
+            QMutexLocker locker(&queue.mutex);
+            for (const QString& subDir : subDirs) {
+                queue.tasks.push_back({subDir, task.mount});
+            }
+        }
+        --m_pending;
+        wakeIdleWorkers();
+    }
+}
+
+bool DirectoryWalker::takeTask(int index, Task& task)
+{
+    const std::size_t queueCount = m_queues.size();
+    for (std::size_t offset = 0; offset < queueCount; ++offset) {
+        WorkerQueue& queue = *m_queues[(static_cast<std::size_t>(index) + offset) % queueCount];
+        QMutexLocker locker(&queue.mutex);
+        // Own tasks are taken depth-first (LIFO), stolen ones breadth-first (FIFO).
+        const bool isOwnQueue = (offset == 0);
+        const std::size_t taskCount = queue.tasks.size();
+        for (std::size_t i = 0; i < taskCount; ++i) {
+            auto it = isOwnQueue ? queue.tasks.begin() + static_cast<std::ptrdiff_t>(taskCount - 1 - i)
+                                 : queue.tasks.begin() + static_cast<std::ptrdiff_t>(i);
+            if (m_mountSlots[static_cast<std::size_t>(it->mount)]->tryAcquire()) {
+                task = std::move(*it);
+                queue.tasks.erase(it);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace mediaelch
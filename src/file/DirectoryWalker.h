@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QSemaphore;
+
+namespace mediaelch {
+
+/// \brief Parallel directory walker used by the media file searchers.
+///
+/// Every directory is a task.  Each worker thread has its own task queue and
+/// takes its own tasks depth-first.  Idle workers steal tasks breadth-first
+/// from other workers.  Only a limited number of directories per mount point
+/// are listed concurrently, so that a single slow network share can't occupy
+/// all threads.
+///
+/// The visitor is called on worker threads and must be thread-safe.  It returns
+/// all sub-directories that shall be visited as well.  The visiting order is
+/// not deterministic; callers must key their results by path.
+///
+/// \par Example
+/// \code{cpp}
+///   QMutex mutex;
+///   QMap<QString, QStringList> files;
+///   DirectoryWalker walker;
+///   walker.walk(roots, [&](const QString& path) {
+///       QDir dir(path);
+///       QStringList dirFiles = dir.entryList(QDir::Files);
+///       QMutexLocker locker(&mutex);
+///       files.insert(path, dirFiles);
+///       return subDirectories;
+///   });
+/// \endcode
+class DirectoryWalker
+{
+public:
+    using Visitor = std::function<QStringList(const QString& path)>;
+
+    explicit DirectoryWalker(int maxConcurrencyPerMount = 4);
+    ~DirectoryWalker();
+
+    /// \brief Visits all root directories and all sub-directories returned by the visitor.
+    /// Blocks until all directories were visited or abort() was called.  Events of the
+    /// calling thread are processed while waiting, see setProcessEvents().
+    void walk(const QStringList& roots, const Visitor& visitor);
+    /// \brief Stops the current walk. Directories that are currently visited are finished.
+    void abort();
+    bool isAborted() const;
+
+    void setMaxConcurrencyPerMount(int maxConcurrency);
+    int maxConcurrencyPerMount() const;
+
+    /// \brief Whether walk() processes events while waiting. Not needed without a GUI.
+    void setProcessEvents(bool processEvents);
+
+private:
+    struct Task
+    {
+        QString path;
+        int mount = 0;
+    };
+    struct WorkerQueue;
+
+    void runWorker(int index, const Visitor& visitor);
+    bool takeTask(int index, Task& task);
+
+private:
+    int m_maxConcurrencyPerMount = 4;
+    bool m_processEvents = true;
+    std::atomic_bool m_aborted{false};
+    std::atomic_int m_pending{0};
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::unique_ptr<QSemaphore>> m_mountSlots;
+};
+
+} // namespace mediaelch
@@ -1,5 +1,7 @@
 #include "file/FileFilter.h"
 
+#include <algorithm>
+
 namespace mediaelch {
 
 QStringList FileFilter::files(QDir directory) const
@@ -7,7 +9,12 @@ QStringList FileFilter::files(QDir directory) const
     if (m_filters.isEmpty() || !directory.exists()) {
         return {};
     }
-    return directory.entryList(m_filters, QDir::Files | QDir::System);
+    // List all files and filter them ourselves: QDir matches each file against
+    // every wildcard on its own.
+    QStringList files = directory.entryList(QDir::Files | QDir::System);
+    files.erase(std::remove_if(files.begin(), files.end(), [this](const QString& file) { return !matches(file); }),
+        files.end());
+    return files;
 }
 
 bool FileFilter::hasFilter() const
@@ -20,4 +27,9 @@ QStringList FileFilter::filters() const
     return m_filters;
 }
 
+bool FileFilter::matches(const QString& fileName) const
+{
+    return m_matcher.matches(fileName);
+}
+
 } // namespace mediaelch
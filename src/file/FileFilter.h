@@ -1,5 +1,7 @@
 #pragma once
 
+#include "file/FileNameMatcher.h"
+
 #include <QDir>
 #include <QString>
 #include <QStringList>
@@ -10,14 +12,22 @@ class FileFilter
 {
 public:
     FileFilter() = default;
-    explicit FileFilter(QStringList filters) : m_filters(std::move(filters)) {}
+    explicit FileFilter(QStringList filters) :
+        m_filters(std::move(filters)), m_matcher{FileNameMatcher::fromWildcards(m_filters)}
+    {
+    }
 
     QStringList files(QDir directory) const;
     bool hasFilter() const;
     QStringList filters() const;
 
+    /// \brief Whether the file name matches one of the filters.
+    /// Same as QDir::match(filters(), fileName) but the filters are only compiled once.
+    bool matches(const QString& fileName) const;
+
 private:
     QStringList m_filters;
+    FileNameMatcher m_matcher;
 };
 
 } // namespace mediaelch
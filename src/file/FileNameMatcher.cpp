@@ -0,0 +1,221 @@
+#include "file/FileNameMatcher.h"
+
+#include <QDebug>
+
+namespace mediaelch {
+
+namespace {
+
+bool isRegexMetaCharacter(QChar c)
+{
+    static const QString metaCharacters = QStringLiteral("\\^$.|?*+()[]{}");
+    return metaCharacters.contains(c);
+}
+
+/// \brief Returns the literal text of a regular expression without meta characters
+///        (escaped ones are allowed, e.g. "\."), or a null string.
+QString regexLiteral(const QString& pattern)
+{
+    QString literal;
+    literal.reserve(pattern.size());
+    for (int i = 0; i < pattern.size(); ++i) {
+        const QChar c = pattern[i];
+        if (c == '\\') {
+            // "\d", "\b", "\1", etc. are not literals.
+            if (i + 1 >= pattern.size() || pattern[i + 1].isLetterOrNumber()) {
+                return {};
+            }
+            literal.append(pattern[++i]);
+        } else if (isRegexMetaCharacter(c)) {
+            return {};
+        } else {
+            literal.append(c);
+        }
+    }
+    return literal.isNull() ? QStringLiteral("") : literal;
+}
+
+/// \brief Whether the pattern can be wrapped into a non-capturing group of an
+///        alternation without changing its meaning.
+bool isCombinable(const QRegularExpression& regex)
+{
+    if (regex.patternOptions() != QRegularExpression::NoPatternOption) {
+        return false;
+    }
+    // Group numbers change in the combined expression, which breaks back references
+    // and recursion.  Branch resets and verbs are rare; keep them separate as well.
+    static const QRegularExpression numberedGroupReference(
+        QStringLiteral(R"(\\[1-9]|\\g|\\k|\(\?(?:P=|P>|&|R|[0-9+-]|\|)|\(\*)"));
+    return !numberedGroupReference.match(regex.pattern()).hasMatch();
+}
+
+/// \brief Converts a wildcard as understood by QDir::entryList() into a regular expression.
+QString wildcardToRegex(const QString& wildcard)
+{
+    QString regex;
+    regex.reserve(wildcard.size() * 2);
+    bool inSet = false;
+    for (const QChar c : wildcard) {
+        if (inSet) {
+            regex.append(c);
+            inSet = (c != ']');
+        } else if (c == '*') {
+            regex.append(QStringLiteral(".*"));
+        } else if (c == '?') {
+            regex.append('.');
+        } else if (c == '[') {
+            regex.append(c);
+            inSet = true;
+        } else {
+            regex.append(QRegularExpression::escape(QString(c)));
+        }
+    }
+    return regex;
+}
+
+} // namespace
+
+FileNameMatcher FileNameMatcher::fromRegularExpressions(const QVector<QRegularExpression>& patterns)
+{
+    FileNameMatcher matcher;
+    QStringList combinable;
+    for (const QRegularExpression& regex : patterns) {
+        if (!regex.isValid()) {
+            continue;
+        }
+        QString pattern = regex.pattern();
+        if (regex.patternOptions() == QRegularExpression::NoPatternOption) {
+            const bool anchoredAtStart = pattern.startsWith('^');
+            // "\$" is a literal dollar sign, not an anchor.
+            const bool anchoredAtEnd = pattern.endsWith('$') && !pattern.endsWith(QStringLiteral("\\$"));
+            const QString literal =
+                regexLiteral(pattern.mid(anchoredAtStart ? 1 : 0, pattern.size() - anchoredAtStart - anchoredAtEnd));
+            if (!literal.isNull()) {
+                matcher.addLiteral(literal, anchoredAtStart, anchoredAtEnd);
+                continue;
+            }
+        }
+        ++matcher.m_regexPatternCount;
+        if (isCombinable(regex)) {
+            combinable << pattern;
+        } else {
+            matcher.m_separate << regex;
+        }
+    }
+    matcher.combine(combinable, QRegularExpression::NoPatternOption);
+    return matcher;
+}
+
+FileNameMatcher FileNameMatcher::fromWildcards(const QStringList& wildcards)
+{
+    FileNameMatcher matcher;
+    matcher.m_caseSensitivity = Qt::CaseInsensitive;
+    QStringList combinable;
+    for (const QString& wildcard : wildcards) {
+        const bool hasSet = wildcard.contains('[');
+        const bool hasSingle = wildcard.contains('?');
+        const int stars = wildcard.count('*');
+        if (!hasSet && !hasSingle && stars == 0) {
+            matcher.addLiteral(wildcard, true, true);
+        } else if (!hasSet && !hasSingle && stars == 1 && wildcard.startsWith('*')) {
+            matcher.addLiteral(wildcard.mid(1), false, true);
+        } else if (!hasSet && !hasSingle && stars == 1 && wildcard.endsWith('*')) {
+            matcher.addLiteral(wildcard.left(wildcard.size() - 1), true, false);
+        } else if (!hasSet && !hasSingle && stars == 2 && wildcard.size() > 2 && wildcard.startsWith('*')
+                   && wildcard.endsWith('*')) {
+            matcher.addLiteral(wildcard.mid(1, wildcard.size() - 2), false, false);
+        } else {
+            ++matcher.m_regexPatternCount;
+            combinable << QStringLiteral("^%1$").arg(wildcardToRegex(wildcard));
+        }
+    }
+    matcher.combine(combinable, QRegularExpression::CaseInsensitiveOption);
+    return matcher;
+}
+
+void FileNameMatcher::addLiteral(QString literal, bool anchoredAtStart, bool anchoredAtEnd)
+{
+    if (m_caseSensitivity == Qt::CaseInsensitive) {
+        literal = literal.toLower();
+    }
+    if (anchoredAtStart && anchoredAtEnd) {
+        m_names.insert(literal);
+    } else if (anchoredAtEnd && literal.startsWith('.') && literal.lastIndexOf('.') == 0) {
+        m_extensions.insert(literal);
+    } else if (anchoredAtEnd) {
+        m_suffixes << literal;
+    } else if (anchoredAtStart) {
+        m_prefixes << literal;
+    } else {
+        m_substrings << literal;
+    }
+}
+
+void FileNameMatcher::combine(const QStringList& patterns, QRegularExpression::PatternOptions options)
+{
+    if (patterns.isEmpty()) {
+        return;
+    }
+    if (patterns.size() == 1) {
+        m_combined = QRegularExpression(patterns.first(), options);
+    } else {
+        m_combined = QRegularExpression(QStringLiteral("(?:%1)").arg(patterns.join(QStringLiteral(")|(?:"))), options);
+    }
+    if (!m_combined.isValid()) {
+        // Should not happen for valid patterns; fall back to matching them one by one.
+        qWarning() << "[FileNameMatcher] Could not combine patterns:" << m_combined.errorString();
+        m_combined = QRegularExpression();
+        for (const QString& pattern : patterns) {
+            m_separate << QRegularExpression(pattern, options);
+        }
+        return;
+    }
+    m_combined.optimize();
+}
+
+bool FileNameMatcher::matches(const QString& name) const
+{
+    const QString key = (m_caseSensitivity == Qt::CaseInsensitive) ? name.toLower() : name;
+
+    if (!m_extensions.isEmpty()) {
+        const int dot = key.lastIndexOf('.');
+        if (dot >= 0 && m_extensions.contains(key.mid(dot))) {
+            return true;
+        }
+    }
+    if (m_names.contains(key)) {
+        return true;
+    }
+    for (const QString& suffix : m_suffixes) {
+        if (key.endsWith(suffix)) {
+            return true;
+        }
+    }
+    for (const QString& prefix : m_prefixes) {
+        if (key.startsWith(prefix)) {
+            return true;
+        }
+    }
+    for (const QString& substring : m_substrings) {
+        if (key.contains(substring)) {
+            return true;
+        }
+    }
+    if (!m_combined.pattern().isEmpty() && m_combined.match(name).hasMatch()) {
+        return true;
+    }
+    for (const QRegularExpression& regex : m_separate) {
+        if (regex.match(name).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FileNameMatcher::isEmpty() const
+{
+    return m_extensions.isEmpty() && m_names.isEmpty() && m_suffixes.isEmpty() && m_prefixes.isEmpty()
+           && m_substrings.isEmpty() && m_combined.pattern().isEmpty() && m_separate.isEmpty();
+}
+
+} // namespace mediaelch
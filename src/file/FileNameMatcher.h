@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief Matches file or folder names against a set of patterns at once.
+///
+/// The scanners check every directory entry against all exclude patterns and
+/// file filters.  Instead of running one regular expression per pattern, all
+/// patterns are compiled once:
+///
+///  - Literal patterns, optionally anchored with "^" or "$" (e.g. "sample",
+///    "^\.", "\.part$"), and the typical wildcards ("*.mkv", "VIDEO_TS.IFO")
+///    are matched with plain string comparisons.
+///  - All other patterns are combined into a single alternation, so that a
+///    name is scanned once instead of once per pattern.
+///
+/// Patterns that cannot be combined safely (e.g. because they use back
+/// references or non-default pattern options) are matched on their own.
+/// Matching is thread-safe.
+class FileNameMatcher
+{
+public:
+    FileNameMatcher() = default;
+
+    /// \brief Patterns are matched like QRegularExpression::match(), i.e. a
+    ///        name matches if any pattern matches anywhere in it.
+    static FileNameMatcher fromRegularExpressions(const QVector<QRegularExpression>& patterns);
+    /// \brief Wildcards as used by QDir::entryList(), i.e. a name matches if any
+    ///        wildcard matches the whole name, case-insensitively.
+    static FileNameMatcher fromWildcards(const QStringList& wildcards);
+
+    bool matches(const QString& name) const;
+    bool isEmpty() const;
+
+    /// \brief Number of patterns that are checked with a regular expression.
+    int regexPatternCount() const { return m_regexPatternCount; }
+
+private:
+    void addLiteral(QString literal, bool anchoredAtStart, bool anchoredAtEnd);
+    void combine(const QStringList& patterns, QRegularExpression::PatternOptions options);
+
+private:
+    Qt::CaseSensitivity m_caseSensitivity = Qt::CaseSensitive;
+    /// File extensions including the dot, e.g. ".mkv".  Lowercase if case-insensitive.
+    QSet<QString> m_extensions;
+    /// Whole names.  Lowercase if case-insensitive.
+    QSet<QString> m_names;
+    QStringList m_prefixes;
+    QStringList m_suffixes;
+    QStringList m_substrings;
+    QRegularExpression m_combined;
+    QVector<QRegularExpression> m_separate;
+    int m_regexPatternCount = 0;
+};
+
+} // namespace mediaelch
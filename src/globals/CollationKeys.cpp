@@ -0,0 +1,70 @@
+#include "globals/CollationKeys.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// Proxy models of large libraries compare many distinct titles.  The cache is
+// cleared once it has this many entries so that it does not grow forever.
+constexpr int maxCachedKeys = 100000;
+
+} // namespace
+
+namespace mediaelch {
+
+QVector<int> collationRanks(const QVector<QString>& strings)
+{
+    QCollator collator;
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(static_cast<std::size_t>(strings.size()));
+    for (const QString& str : strings) {
+        keys.push_back(collator.sortKey(str));
+    }
+
+    std::vector<int> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](int left, int right) { //
+        return keys[static_cast<std::size_t>(left)].compare(keys[static_cast<std::size_t>(right)]) < 0;
+    });
+
+    QVector<int> ranks(strings.size());
+    int rank = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const auto current = static_cast<std::size_t>(order[i]);
+        if (i > 0 && keys[static_cast<std::size_t>(order[i - 1])].compare(keys[current]) != 0) {
+            ++rank;
+        }
+        ranks[order[i]] = rank;
+    }
+    return ranks;
+}
+
+CollationKeyCache::CollationKeyCache() = default;
+
+int CollationKeyCache::compare(const QString& left, const QString& right)
+{
+    // Copy the left key: Inserting the right key may rehash the cache.
+    const QCollatorSortKey leftKey = sortKey(left);
+    return leftKey.compare(sortKey(right));
+}
+
+void CollationKeyCache::clear()
+{
+    m_keys.clear();
+}
+
+const QCollatorSortKey& CollationKeyCache::sortKey(const QString& str)
+{
+    auto it = m_keys.find(str);
+    if (it == m_keys.end()) {
+        if (m_keys.size() >= maxCachedKeys) {
+            m_keys.clear();
+        }
+        it = m_keys.insert(str, m_collator.sortKey(str));
+    }
+    return it.value();
+}
+
+} // namespace mediaelch
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief Ranks of the given strings in locale-aware order.
+/// \details Equal strings get the same rank.  Comparing two ranks is the same as
+///          comparing the strings using QString::localeAwareCompare(), but does
+///          not need to collate the strings for each comparison.
+QVector<int> collationRanks(const QVector<QString>& strings);
+
+/// \brief Locale-aware comparison of strings with cached collation keys.
+/// \details Used by proxy models that can't keep a key per row, e.g. tree models.
+///          The collation key of each string is only created once.
+class CollationKeyCache
+{
+public:
+    CollationKeyCache();
+
+    /// \brief Same result as QString::localeAwareCompare(left, right).
+    int compare(const QString& left, const QString& right);
+    void clear();
+
+private:
+    const QCollatorSortKey& sortKey(const QString& str);
+
+private:
+    QCollator m_collator;
+    QHash<QString, QCollatorSortKey> m_keys;
+};
+
+} // namespace mediaelch
@@ -30,8 +30,8 @@ void ComboDelegate::setEditorData(QWidget* editor, const QModelIndex& index) con
     QString value = index.model()->data(index, Qt::EditRole).toString();
     auto* box = dynamic_cast<QComboBox*>(editor);
     QStringList items;
-    const auto& movies = Manager::instance()->movieModel()->movies();
-    const auto& shows = Manager::instance()->tvShowModel()->tvShows();
+    const auto& movies = Manager::instance()->movieModel()->moviesWithDetails();
+    const auto& shows = Manager::instance()->tvShowModel()->tvShowsWithEpisodeDetails();
 
     if (m_widget == MainWidgets::Movies && m_type == ComboDelegateType::Genres) {
         for (Movie* movie : movies) {
@@ -2,19 +2,80 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QHash>
 #include <QTimer>
 
+#include <algorithm>
+
 #include "globals/DownloadManagerElement.h"
 #include "music/Album.h"
 #include "music/Artist.h"
+#include "network/HttpStatusCodes.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
 #include "tv_shows/TvShow.h"
 
 static constexpr char PROP_DOWNLOAD_ELEMENT[] = "downloadElement";
 
+namespace {
+
+/// \brief Connections shared by all download managers.  Only used in the GUI thread.
+struct DownloadConnections
+{
+    int inFlight = 0;
+    QHash<QString, int> perHost;
+    /// Download managers with queued downloads, in order of registration.
+    QVector<DownloadManager*> waiting;
+};
+
+DownloadConnections& connections()
+{
+    static DownloadConnections s_connections;
+    return s_connections;
+}
+
+bool hasFreeConnection(const QString& host)
+{
+    const DownloadConnections& c = connections();
+    return c.inFlight < DownloadManager::maxParallelDownloads
+           && c.perHost.value(host, 0) < DownloadManager::maxParallelDownloadsForHost(host);
+}
+
+void acquireConnection(const QString& host)
+{
+    ++connections().inFlight;
+    ++connections().perHost[host];
+}
+
+void releaseConnection(const QString& host)
+{
+    DownloadConnections& c = connections();
+    --c.inFlight;
+    if (--c.perHost[host] <= 0) {
+        c.perHost.remove(host);
+    }
+}
+
+} // namespace
+
 DownloadManager::DownloadManager(QObject* parent) : QObject(parent)
 {
+    m_retryTimer.setSingleShot(true);
+    m_retryTimer.setInterval(1000);
+    connect(&m_retryTimer, &QTimer::timeout, this, &DownloadManager::retryDownloads);
+}
+
+DownloadManager::~DownloadManager()
+{
+    connections().waiting.removeAll(this);
+    const QVector<QNetworkReply*> replies = m_currentReplies;
+    m_currentReplies.clear();
+    for (QNetworkReply* reply : replies) {
+        releaseReply(reply);
+    }
+    if (!replies.isEmpty()) {
+        QTimer::singleShot(0, &DownloadManager::startWaitingDownloads);
+    }
 }
 
 mediaelch::network::NetworkManager* DownloadManager::network()
@@ -28,6 +89,27 @@ bool DownloadManager::isLocalFile(const QUrl& url)
     return url.toString().startsWith("//");
 }
 
+int DownloadManager::maxParallelDownloadsForHost(const QString& host)
+{
+    // Image CDNs can handle more connections than regular sites.
+    static const QHash<QString, int> limits = {
+        {"image.tmdb.org", 8},
+        {"assets.fanart.tv", 4},
+        {"artworks.thetvdb.com", 4},
+    };
+    return limits.value(host, 4);
+}
+
+void DownloadManager::setPriority(DownloadPriority priority)
+{
+    m_priority = priority;
+}
+
+DownloadPriority DownloadManager::priority() const
+{
+    return m_priority;
+}
+
 void DownloadManager::setDownloads(QVector<DownloadManagerElement> elements)
 {
     if (!m_queue.isEmpty()) {
@@ -40,7 +122,7 @@ void DownloadManager::setDownloads(QVector<DownloadManagerElement> elements)
         addDownload(elem);
     }
 
-    if (m_queue.isEmpty()) {
+    if (elements.isEmpty()) {
         QTimer::singleShot(0, this, &DownloadManager::allDownloadsFinished);
     }
 }
@@ -58,7 +140,7 @@ void DownloadManager::addDownload(DownloadManagerElement elem)
     // method that depends on them or has a previous state.  For example:
     //
     //  addDownload()
-    //    startNextDownload();
+    //    startDownloads();
     //     on finished: downloadFinished()
     //       emit sigDownloadFinished(elem);
     //         some slot calls addDownload, m_currentDownloadElement changes
@@ -70,7 +152,6 @@ void DownloadManager::addDownload(DownloadManagerElement elem)
     //
     // But to be more robust, we should refactor this class and get rid of
     // all member variables that may change state.
-    // Also, this would allow parallel downloads.
     //
     // The mutexes have been removed but the code still needs to be refactored.
     //
@@ -78,11 +159,7 @@ void DownloadManager::addDownload(DownloadManagerElement elem)
     qDebug() << "[DownloadManager] Enqueue download at pos " << downloadQueueSize() << "|" << elem.url;
 
     m_queue.enqueue(elem);
-
-    const bool shouldStartDownloading = m_currentReplies.size() <= numberOfParellelDownloads;
-    if (shouldStartDownloading) {
-        startNextDownload();
-    }
+    startDownloads();
 }
 
 template<class T>
@@ -95,6 +172,11 @@ bool DownloadManager::hasDownloadsLeft(T*& elementToCheck)
             return true;
         }
     }
+    for (int i = 0, n = m_retryQueue.size(); i < n; ++i) {
+        if (m_retryQueue[i].getElement<T>() == elementToCheck) {
+            return true;
+        }
+    }
     // There may be currently running requests for this movie/tv show/...
     for (auto& m_currentReplie : m_currentReplies) {
         // TODO: No copy!
@@ -115,6 +197,11 @@ int DownloadManager::numberOfDownloadsLeft(T*& elementToCheck)
             ++count;
         }
     }
+    for (int i = 0, n = m_retryQueue.size(); i < n; ++i) {
+        if (m_retryQueue[i].getElement<T>() == elementToCheck) {
+            ++count;
+        }
+    }
     // There may be currently running requests for this movie/tv show/...
     for (auto& m_currentReplie : m_currentReplies) {
         // TODO: No copy!
@@ -131,74 +218,146 @@ void DownloadManager::abortDownloads()
     qInfo() << "[DownloadsManager] Abort Downloads";
 
     m_queue.clear();
+    m_retryQueue.clear();
+    m_retryTimer.stop();
+    connections().waiting.removeAll(this);
 
-    QVector<QNetworkReply*> replies = m_currentReplies;
-    // clear before aborting because "abort" emits "finished" which we are connected to.
-    // Avoid that m_currentReplies is used elsewhere.
+    const QVector<QNetworkReply*> replies = m_currentReplies;
+    // Clear before aborting so that m_currentReplies is not used elsewhere.
     m_currentReplies.clear();
 
     for (auto* reply : replies) {
-        // deleted in downloadFinished()
-        reply->abort();
+        releaseReply(reply);
+    }
+    if (!replies.isEmpty()) {
+        // Other download managers may use the free connections now.
+        QTimer::singleShot(0, &DownloadManager::startWaitingDownloads);
     }
 }
 
-void DownloadManager::startNextDownload()
+void DownloadManager::releaseReply(QNetworkReply* reply)
 {
-    if (m_queue.isEmpty()) {
-        if (m_currentReplies.isEmpty()) {
-            qInfo() << "[DownloadManager] All downloads finished";
-            emit allDownloadsFinished();
+    // Aborted downloads are neither retried nor reported as finished.
+    disconnect(reply, nullptr, this, nullptr);
+    releaseConnection(reply->request().url().host());
+    reply->abort();
+    reply->deleteLater();
+}
+
+int DownloadManager::nextDownloadIndex() const
+{
+    int index = -1;
+    for (int i = 0, n = m_queue.size(); i < n; ++i) {
+        const DownloadManagerElement& download = m_queue[i];
+        if (index != -1 && download.priority <= m_queue[index].priority) {
+            continue;
         }
-        return;
+        if (isLocalFile(download.url) || hasFreeConnection(download.url.host())) {
+            index = i;
+        }
+    }
+    return index;
+}
+
+DownloadPriority DownloadManager::highestQueuedPriority() const
+{
+    DownloadPriority priority = DownloadPriority::Low;
+    for (const DownloadManagerElement& download : m_queue) {
+        priority = qMax(priority, download.priority);
     }
+    return priority;
+}
 
-    DownloadManagerElement download = m_queue.dequeue();
+void DownloadManager::startDownloads()
+{
+    int index = nextDownloadIndex();
+    while (index != -1) {
+        DownloadManagerElement download = m_queue.takeAt(index);
 
-    if (download.imageType == ImageType::Actor || download.imageType == ImageType::TvShowEpisodeThumb) {
-        if (download.movie != nullptr) {
-            emit movieDownloadsLeft(numberOfDownloadsLeft<Movie>(download.movie), download);
+        if (download.imageType == ImageType::Actor || download.imageType == ImageType::TvShowEpisodeThumb) {
+            if (download.movie != nullptr) {
+                emit movieDownloadsLeft(numberOfDownloadsLeft<Movie>(download.movie), download);
+
+            } else if (download.show != nullptr) {
+                emit showDownloadsLeft(numberOfDownloadsLeft<TvShow>(download.show), download);
+
+            } else {
+                emit downloadsLeft(downloadQueueSize());
+            }
+        }
 
-        } else if (download.show != nullptr) {
-            emit showDownloadsLeft(numberOfDownloadsLeft<TvShow>(download.show), download);
+        qDebug() << "[DownloadManager] Start next download | Files left:" << m_queue.size();
 
+        if (DownloadManager::isLocalFile(download.url)) {
+            loadLocalFile(download);
         } else {
-            emit downloadsLeft(downloadQueueSize());
+            startDownload(download);
         }
+        index = nextDownloadIndex();
     }
 
-    qDebug() << "[DownloadManager] Start next download | Files left:" << m_queue.size();
+    auto& waiting = connections().waiting;
+    if (m_queue.isEmpty()) {
+        waiting.removeAll(this);
+        if (m_currentReplies.isEmpty() && m_retryQueue.isEmpty()) {
+            qInfo() << "[DownloadManager] All downloads finished";
+            emit allDownloadsFinished();
+        }
+    } else if (!waiting.contains(this)) {
+        waiting.append(this);
+    }
+}
 
-    if (DownloadManager::isLocalFile(download.url)) {
-        QFile file(download.url.toString());
-        QByteArray data;
-        if (file.open(QIODevice::ReadOnly)) {
-            data = file.readAll();
-            file.close();
+void DownloadManager::startWaitingDownloads()
+{
+    // Managers with higher priority get free connections first.
+    QVector<DownloadManager*> waiting = connections().waiting;
+    std::stable_sort(waiting.begin(), waiting.end(), [](DownloadManager* a, DownloadManager* b) {
+        if (a->priority() != b->priority()) {
+            return a->priority() > b->priority();
         }
+        return a->highestQueuedPriority() > b->highestQueuedPriority();
+    });
+    for (DownloadManager* manager : waiting) {
+        // Starting downloads may delete other managers through signal handlers.
+        if (connections().waiting.contains(manager)) {
+            manager->startDownloads();
+        }
+    }
+}
+
+void DownloadManager::startDownload(DownloadManagerElement download)
+{
+    acquireConnection(download.url.host());
+    QNetworkReply* reply = network()->getWithWatcher(mediaelch::network::requestWithDefaults(download.url));
+    reply->setProperty(PROP_DOWNLOAD_ELEMENT, QVariant::fromValue(download));
+    m_currentReplies.push_back(reply);
+
+    connect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
+    connect(reply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
+}
 
-        download.data = data;
+void DownloadManager::loadLocalFile(DownloadManagerElement download)
+{
+    QFile file(download.url.toString());
+    QByteArray data;
+    if (file.open(QIODevice::ReadOnly)) {
+        data = file.readAll();
+        file.close();
+    }
 
-        if (download.actor != nullptr && download.imageType == ImageType::Actor && (download.movie == nullptr)) {
-            download.actor->image = data;
+    download.data = data;
 
-        } else if (download.imageType == ImageType::TvShowEpisodeThumb && !download.directDownload) {
-            download.episode->setThumbnailImage(data);
+    if (download.actor != nullptr && download.imageType == ImageType::Actor && (download.movie == nullptr)) {
+        download.actor->image = data;
 
-        } else {
-            emit sigDownloadFinished(download);
-        }
-        startNextDownload();
-        // TODO: Also emit allXXXFinished() signal
+    } else if (download.imageType == ImageType::TvShowEpisodeThumb && !download.directDownload) {
+        download.episode->setThumbnailImage(data);
 
     } else {
-        QNetworkReply* reply = network()->getWithWatcher(mediaelch::network::requestWithDefaults(download.url));
-        reply->setProperty(PROP_DOWNLOAD_ELEMENT, QVariant::fromValue(download));
-        m_currentReplies.push_back(reply);
-
-        connect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
-        connect(reply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
+        emit sigDownloadFinished(download);
     }
+    // TODO: Also emit allXXXFinished() signal
 }
 
 void DownloadManager::downloadProgress(qint64 received, qint64 total)
@@ -216,27 +375,47 @@ void DownloadManager::downloadProgress(qint64 received, qint64 total)
     emit sigDownloadProgress(element);
 }
 
-void DownloadManager::restartDownloadAfterTimeout(QNetworkReply* reply)
+bool DownloadManager::isTemporaryError(QNetworkReply* reply)
 {
-    auto download = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-    ++download.retries;
-    reply->deleteLater();
-
-    qWarning() << "[DownloadManager] Download timed out:" << download.url;
-
-    if (download.retries < 3) {
-        qDebug() << "[DownloadManager] Re-enqueuing the download, tries:" << download.retries << "/ 3";
-        m_queue.prepend(download);
+    if (reply->property(NetworkReplyWatcher::TIMEOUT_PROP).toBool()) {
+        return true;
+    }
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode == static_cast<int>(mediaelch::HttpStatusCode::TooManyRequests) || statusCode == 502
+        || statusCode == 503 || statusCode == 504) {
+        return true;
+    }
+    switch (reply->error()) {
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError: return true;
+    default: return false;
+    }
+}
 
-    } else {
-        qDebug() << "[DownloadManager] Giving up on this file, tried 3 times";
+void DownloadManager::retryLater(DownloadManagerElement download)
+{
+    ++download.retries;
+    if (download.retries >= maxDownloadTries) {
+        qWarning() << "[DownloadManager] Giving up on this file, tried" << maxDownloadTries << "times:" << download.url;
+        emitDownloadFinished(download);
+        return;
     }
+    qDebug() << "[DownloadManager] Retrying download later, tries:" << download.retries << "/" << maxDownloadTries;
+    m_retryQueue.enqueue(download);
+    if (!m_retryTimer.isActive()) {
+        m_retryTimer.start();
+    }
+}
 
-    // Should always be true because we're replacing the previous request
-    // but just to be sure, we still check this.
-    if (m_currentReplies.size() <= numberOfParellelDownloads) {
-        startNextDownload();
+void DownloadManager::retryDownloads()
+{
+    // Retried downloads were requested earlier than all queued ones.
+    while (!m_retryQueue.isEmpty()) {
+        m_queue.prepend(m_retryQueue.takeLast());
     }
+    startDownloads();
 }
 
 void DownloadManager::downloadFinished()
@@ -250,66 +429,71 @@ void DownloadManager::downloadFinished()
     bool wasRemoved = m_currentReplies.removeOne(reply);
     if (!wasRemoved) {
         qCritical() << "[DownloadManager] downloadFinished() called for reply which wasn't tracked";
+        return;
     }
+    releaseConnection(reply->request().url().host());
+    reply->deleteLater();
+
+    DownloadManagerElement downloadElement = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
 
-    QByteArray data;
     if (reply->error() != QNetworkReply::NoError) {
-        if (reply->property(NetworkReplyWatcher::TIMEOUT_PROP).toBool()) {
-            restartDownloadAfterTimeout(reply); // also deletes the reply
-            return;
-        }
         qWarning() << "[DownloadManager] Network Error:" << reply->errorString() << "|" << reply->url();
+        if (isTemporaryError(reply)) {
+            retryLater(downloadElement);
+        } else {
+            emitDownloadFinished(downloadElement);
+        }
 
     } else {
-        data = reply->readAll();
+        downloadElement.data = reply->readAll();
+        emitDownloadFinished(downloadElement);
     }
 
+    startDownloads();
+    // The connection may be used by other download managers as well.
+    startWaitingDownloads();
+}
 
-    DownloadManagerElement downloadElelement = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-    reply->deleteLater();
-
-    downloadElelement.data = data;
-
-    if (downloadElelement.actor != nullptr && downloadElelement.imageType == ImageType::Actor
-        && downloadElelement.movie == nullptr) {
-        downloadElelement.actor->image = data;
+void DownloadManager::emitDownloadFinished(DownloadManagerElement downloadElement)
+{
+    if (downloadElement.actor != nullptr && downloadElement.imageType == ImageType::Actor
+        && downloadElement.movie == nullptr) {
+        downloadElement.actor->image = downloadElement.data;
 
-    } else if (downloadElelement.imageType == ImageType::TvShowEpisodeThumb && !downloadElelement.directDownload) {
-        downloadElelement.episode->setThumbnailImage(data);
+    } else if (downloadElement.imageType == ImageType::TvShowEpisodeThumb && !downloadElement.directDownload) {
+        downloadElement.episode->setThumbnailImage(downloadElement.data);
 
     } else {
-        emit sigDownloadFinished(downloadElelement);
+        emit sigDownloadFinished(downloadElement);
     }
 
-    emit sigElemDownloaded(downloadElelement);
+    emit sigElemDownloaded(downloadElement);
 
-    if (downloadElelement.movie != nullptr && !hasDownloadsLeft<Movie>(downloadElelement.movie)) {
-        emit allMovieDownloadsFinished(downloadElelement.movie);
+    if (downloadElement.movie != nullptr && !hasDownloadsLeft<Movie>(downloadElement.movie)) {
+        emit allMovieDownloadsFinished(downloadElement.movie);
     }
-    if (downloadElelement.show != nullptr && !hasDownloadsLeft<TvShow>(downloadElelement.show)) {
-        emit allTvShowDownloadsFinished(downloadElelement.show);
+    if (downloadElement.show != nullptr && !hasDownloadsLeft<TvShow>(downloadElement.show)) {
+        emit allTvShowDownloadsFinished(downloadElement.show);
     }
-    if (downloadElelement.concert != nullptr && !hasDownloadsLeft<Concert>(downloadElelement.concert)) {
-        emit allConcertDownloadsFinished(downloadElelement.concert);
+    if (downloadElement.concert != nullptr && !hasDownloadsLeft<Concert>(downloadElement.concert)) {
+        emit allConcertDownloadsFinished(downloadElement.concert);
     }
-    if (downloadElelement.artist != nullptr && !hasDownloadsLeft<Artist>(downloadElelement.artist)) {
-        emit allArtistDownloadsFinished(downloadElelement.artist);
+    if (downloadElement.artist != nullptr && !hasDownloadsLeft<Artist>(downloadElement.artist)) {
+        emit allArtistDownloadsFinished(downloadElement.artist);
     }
-    if (downloadElelement.album != nullptr && !hasDownloadsLeft<Album>(downloadElelement.album)) {
-        emit allAlbumDownloadsFinished(downloadElelement.album);
+    if (downloadElement.album != nullptr && !hasDownloadsLeft<Album>(downloadElement.album)) {
+        emit allAlbumDownloadsFinished(downloadElement.album);
     }
-
-    startNextDownload();
 }
 
 bool DownloadManager::isDownloading() const
 {
-    return !m_queue.isEmpty() || !m_currentReplies.isEmpty();
+    return !m_queue.isEmpty() || !m_currentReplies.isEmpty() || !m_retryQueue.isEmpty();
 }
 
 int DownloadManager::downloadQueueSize()
 {
-    return m_queue.size() + m_currentReplies.size();
+    return m_queue.size() + m_currentReplies.size() + m_retryQueue.size();
 }
 
 int DownloadManager::downloadsLeftForShow(TvShow* show)
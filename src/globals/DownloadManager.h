@@ -4,7 +4,6 @@
 #include "globals/Globals.h"
 #include "network/NetworkManager.h"
 
-#include <QMutex>
 #include <QNetworkReply>
 #include <QObject>
 #include <QQueue>
@@ -15,11 +14,25 @@
 class Artist;
 class Album;
 
+/// \brief Downloads images and other files for movies, TV shows, etc.
+///
+/// All download managers share a common pool of connections: only a limited
+/// number of requests are in flight, in total and per host.  If a connection
+/// becomes available, it is given to the download with the highest priority
+/// of all download managers.  The priority of a download is the manager's
+/// priority (e.g. selected item vs. multi-scrape in the background) and then
+/// the element's priority.
 class DownloadManager : public QObject
 {
     Q_OBJECT
 public:
+    /// \brief Maximum number of downloads in flight over all download managers.
+    static constexpr int maxParallelDownloads = 12;
+    /// \brief How often a download is tried if it fails with a temporary error, e.g. a timeout.
+    static constexpr int maxDownloadTries = 3;
+
     explicit DownloadManager(QObject* parent = nullptr);
+    ~DownloadManager() override;
     /// \brief Add the given download element and start downloading it if the
     ///        download progress hasn't started, yet.
     /// \param elem Element to download
@@ -41,6 +54,16 @@ public:
     /// \return Number of downloads left
     int downloadsLeftForShow(TvShow* show);
 
+    /// \brief Priority of all downloads of this manager compared to other managers.
+    /// \details Widgets that show the selected item use their own manager with
+    ///          DownloadPriority::High, so that its images are downloaded before
+    ///          those of items that are scraped in the background.
+    void setPriority(DownloadPriority priority);
+    DownloadPriority priority() const;
+
+    /// \brief Maximum number of parallel downloads from the given host.
+    static int maxParallelDownloadsForHost(const QString& host);
+
 signals:
     void sigDownloadProgress(DownloadManagerElement);
     void downloadsLeft(int);
@@ -60,11 +83,12 @@ private slots:
     /// \param received Received bytes
     /// \param total Total bytes
     void downloadProgress(qint64 received, qint64 total);
-    /// \brief Starts the next download if there is one.
+    /// \brief Starts the next downloads if there are any.
     void downloadFinished();
-    void startNextDownload();
-    /// \brief Stops the current download and prepends it to the queue
-    void restartDownloadAfterTimeout(QNetworkReply* reply);
+    /// \brief Starts as many queued downloads as there are free connections.
+    void startDownloads();
+    /// \brief Moves downloads that shall be retried back into the queue.
+    void retryDownloads();
 
 private:
     /// \brief Checks if all downloads of the given movie/tvshow/... have finished.
@@ -74,6 +98,24 @@ private:
     template<class T>
     int numberOfDownloadsLeft(T*& elementToCheck);
 
+    /// \brief Index of the queued download that should be started next or -1
+    ///        if no download can be started because all connections are in use.
+    int nextDownloadIndex() const;
+    /// \brief Highest priority of all queued downloads.
+    DownloadPriority highestQueuedPriority() const;
+    void startDownload(DownloadManagerElement download);
+    void loadLocalFile(DownloadManagerElement download);
+    /// \brief Whether the failed download should be tried again, e.g. because of a timeout.
+    static bool isTemporaryError(QNetworkReply* reply);
+    /// \brief Schedules a failed download for another try.
+    void retryLater(DownloadManagerElement download);
+    void emitDownloadFinished(DownloadManagerElement download);
+    /// \brief Disconnects and aborts the reply and gives its connection back to the pool.
+    void releaseReply(QNetworkReply* reply);
+
+    /// \brief Starts downloads of all managers that wait for a free connection.
+    static void startWaitingDownloads();
+
     /// \brief Returns the network access manager
     /// \return Network access manager object
     mediaelch::network::NetworkManager* network();
@@ -81,6 +123,8 @@ private:
 
     QVector<QNetworkReply*> m_currentReplies;
     QQueue<DownloadManagerElement> m_queue;
-
-    int numberOfParellelDownloads = 5;
+    /// Failed downloads that are tried again after a short delay.
+    QQueue<DownloadManagerElement> m_retryQueue;
+    QTimer m_retryTimer;
+    DownloadPriority m_priority = DownloadPriority::Normal;
 };
@@ -11,6 +11,16 @@ class Movie;
 class TvShow;
 class TvShowEpisode;
 
+/// \brief Priority of a download.  Downloads with a higher priority are started first.
+enum class DownloadPriority : int
+{
+    /// e.g. images of items that are scraped in the background
+    Low = 0,
+    Normal = 1,
+    /// e.g. images of the currently selected item
+    High = 2
+};
+
 class DownloadManagerElement
 {
 public:
@@ -23,6 +33,9 @@ public:
     qint64 bytesTotal{0};
     /// \brief How often did the download manager try to download this element?
     int retries{0};
+    /// \brief Priority of this download.  Secondary images like actor images or extra fanarts
+    ///        should use DownloadPriority::Low so that main images are downloaded first.
+    DownloadPriority priority{DownloadPriority::Normal};
 
     Actor* actor{nullptr};
     TvShowEpisode* episode{nullptr};
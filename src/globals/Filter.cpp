@@ -111,6 +111,30 @@ bool Filter::isInfo(MovieFilters info) const
     return m_type == FilterType::Movie && m_movieInfo == info;
 }
 
+bool Filter::needsMovieDetails() const
+{
+    if (m_type != FilterType::Movie) {
+        return false;
+    }
+    switch (m_movieInfo) {
+    case MovieFilters::Released:
+    case MovieFilters::Watched:
+    case MovieFilters::Title:
+    case MovieFilters::Poster:
+    case MovieFilters::Backdrop:
+    case MovieFilters::Logo:
+    case MovieFilters::ClearArt:
+    case MovieFilters::CdArt:
+    case MovieFilters::Banner:
+    case MovieFilters::Thumb:
+    case MovieFilters::ExtraFanarts:
+    case MovieFilters::LocalTrailer:
+    case MovieFilters::Path:
+    case MovieFilters::Label: return false;
+    default: return true;
+    }
+}
+
 bool Filter::isInfo(TvShowFilters info) const
 {
     return m_type == FilterType::TvShow && m_showInfo == info;
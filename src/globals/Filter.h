@@ -62,6 +62,9 @@ public:
     bool isInfo(MusicFilters info) const;
     bool isInfo(ConcertFilters info) const;
 
+    /// \brief Whether the filter needs more than a movie's cache summary, see MovieController::loadDetails().
+    bool needsMovieDetails() const;
+
 private:
     enum class FilterType
     {
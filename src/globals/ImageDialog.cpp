@@ -8,7 +8,6 @@
 #include "movies/Movie.h"
 #include "music/Album.h"
 #include "music/Artist.h"
-#include "network/NetworkRequest.h"
 #include "scrapers/image/ImageProvider.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
@@ -21,6 +20,7 @@
 #include <QLabel>
 #include <QMovie>
 #include <QPainter>
+#include <QScrollBar>
 #include <QSize>
 #include <QTimer>
 #include <QtCore/qmath.h>
@@ -59,8 +59,18 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     connect(ui->gallery,       elchOverload<QString>(&ImageGallery::sigRemoveImage),  this, &ImageDialog::onImageClosed);
     connect(ui->imageProvider, elchOverload<int>(&QComboBox::currentIndexChanged),    this, &ImageDialog::onProviderChanged);
     connect(ui->comboLanguage, elchOverload<int>(&QComboBox::currentIndexChanged),    this, &ImageDialog::onLanguageChanged);
+    connect(&m_previewLoader,  &mediaelch::ImagePreviewLoader::sigPreviewLoaded,      this, &ImageDialog::onPreviewLoaded);
+    connect(&m_previewLoader,  &mediaelch::ImagePreviewLoader::sigPreviewFailed,      this, &ImageDialog::onPreviewFailed);
+    connect(&m_previewLoader,  &mediaelch::ImagePreviewLoader::sigFinished,           this, &ImageDialog::onPreviewsFinished);
+    connect(ui->table->verticalScrollBar(), &QScrollBar::valueChanged,                this, &ImageDialog::prioritizeVisiblePreviews);
     // clang-format on
 
+    m_previewLoader.setMaxConcurrentDownloads(
+        Settings::instance()
+            ->settings()
+            ->value("ImageDialog/ConcurrentDownloads", mediaelch::ImagePreviewLoader::defaultConcurrentDownloads)
+            .toInt());
+
     ui->btnAcceptImages->hide();
 
     auto* movie = new QMovie(":/img/spinner.gif", QByteArray(), this);
@@ -68,7 +78,6 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     ui->labelSpinner->setMovie(movie);
 
     setImageType(ImageType::MoviePoster);
-    m_currentDownloadReply = nullptr;
     m_multiSelection = false;
 
     // create zoom out/in buttons and make them darker
@@ -231,16 +240,14 @@ void ImageDialog::setAndStartDownloads(QVector<Poster> downloads)
     }
     ui->labelLoading->setVisible(true);
     ui->labelSpinner->setVisible(true);
+    // renderTable() queues all previews that are not loaded, yet.
     renderTable();
     if (downloads.count() == 0) {
         ui->stackedWidget->setCurrentIndex(2);
     }
-    startNextDownload();
-}
-
-mediaelch::network::NetworkManager* ImageDialog::network()
-{
-    return &m_network;
+    if (m_previewLoader.isIdle()) {
+        onPreviewsFinished();
+    }
 }
 
 void ImageDialog::setupProviderCombo()
@@ -298,63 +305,66 @@ void ImageDialog::resizeAndReposition()
     }
 }
 
-void ImageDialog::startNextDownload()
+void ImageDialog::onPreviewLoaded(int index, QImage scaled)
 {
-    qDebug() << "[ImageDialog] Start next download";
-
-    int nextIndex = -1;
-    for (int i = 0, n = m_elements.size(); i < n; i++) {
-        if (!m_elements[i].downloaded) {
-            nextIndex = i;
-            break;
-        }
+    // It is possible that m_elements has been cleared by aborting all downloads
+    if (index < 0 || index >= m_elements.size()) {
+        return;
     }
+    DownloadElement& element = m_elements[index];
+    element.downloaded = true;
+    element.hasPreview = true;
 
-    if (nextIndex == -1) {
-        ui->labelLoading->setVisible(false);
-        ui->labelSpinner->setVisible(false);
+    if (scaled.width() != m_previewLoader.targetWidth()) {
+        // The preview size was changed while the image was loading.
+        m_previewLoader.load(index, previewUrl(element));
         return;
     }
 
-    QUrl url =
-        m_elements[nextIndex].thumbUrl.isValid() ? m_elements[nextIndex].thumbUrl : m_elements[nextIndex].originalUrl;
-
-    m_currentDownloadIndex = nextIndex;
-    m_currentDownloadReply = network()->get(mediaelch::network::requestWithDefaults(url));
-    connect(m_currentDownloadReply, &QNetworkReply::finished, this, &ImageDialog::downloadFinished);
+    QPixmap pixmap = QPixmap::fromImage(scaled);
+    helper::setDevicePixelRatio(pixmap, helper::devicePixelRatio(this));
+    if (element.cellWidget != nullptr) {
+        element.cellWidget->setImage(pixmap);
+        element.cellWidget->setHint(element.resolution, element.hint);
+    }
+    const int cols = ui->table->columnCount();
+    if (cols > 0) {
+        ui->table->resizeRowToContents(index / cols);
+    }
 }
 
-void ImageDialog::downloadFinished()
+void ImageDialog::onPreviewFailed(int index, QString errorString)
 {
-    if (m_currentDownloadReply->error() == QNetworkReply::NoError) {
-        m_elements[m_currentDownloadIndex].pixmap.loadFromData(m_currentDownloadReply->readAll());
-        helper::setDevicePixelRatio(m_elements[m_currentDownloadIndex].pixmap, helper::devicePixelRatio(this));
+    showError(tr("Error while downloading one or more images: %1").arg(errorString));
+    if (index >= 0 && index < m_elements.size()) {
+        m_elements[index].downloaded = true;
+    }
+}
 
-        if (!m_elements[m_currentDownloadIndex].pixmap.isNull()) {
-            const int width = static_cast<int>((getColumnWidth() - 10) * helper::devicePixelRatio(this));
-            m_elements[m_currentDownloadIndex].scaledPixmap =
-                m_elements[m_currentDownloadIndex].pixmap.scaledToWidth(width, Qt::SmoothTransformation);
-            helper::setDevicePixelRatio(
-                m_elements[m_currentDownloadIndex].scaledPixmap, helper::devicePixelRatio(this));
-            m_elements[m_currentDownloadIndex].cellWidget->setImage(m_elements[m_currentDownloadIndex].scaledPixmap);
-            m_elements[m_currentDownloadIndex].cellWidget->setHint(
-                m_elements[m_currentDownloadIndex].resolution, m_elements[m_currentDownloadIndex].hint);
-        }
-        ui->table->resizeRowsToContents();
+void ImageDialog::onPreviewsFinished()
+{
+    ui->labelLoading->setVisible(false);
+    ui->labelSpinner->setVisible(false);
+}
 
-    } else {
-        showError(tr("Error while downloading one or more images: %1").arg(m_currentDownloadReply->errorString()));
-        qWarning() << "Network Error: " << m_currentDownloadReply->errorString() << " | "
-                   << m_currentDownloadReply->url();
+void ImageDialog::prioritizeVisiblePreviews()
+{
+    const int cols = ui->table->columnCount();
+    const int firstRow = ui->table->rowAt(0);
+    if (cols == 0 || firstRow < 0) {
+        return;
     }
-
-    // It is possible that m_elements has been cleared by aborting all downloads
-    if (m_currentDownloadIndex < m_elements.size()) {
-        // Mark item as downloaded even if there was an error to avoid an infinite loop.
-        m_elements[m_currentDownloadIndex].downloaded = true;
+    int lastRow = ui->table->rowAt(ui->table->viewport()->height() - 1);
+    if (lastRow < 0) {
+        lastRow = ui->table->rowCount() - 1;
+    }
+    QVector<int> visible;
+    for (int i = firstRow * cols, n = qMin((lastRow + 1) * cols, m_elements.size()); i < n; ++i) {
+        if (!m_elements[i].downloaded) {
+            visible << i;
+        }
     }
-    m_currentDownloadReply->deleteLater();
-    startNextDownload();
+    m_previewLoader.prioritize(visible);
 }
 
 void ImageDialog::renderTable()
@@ -367,6 +377,7 @@ void ImageDialog::renderTable()
     for (int i = 0, n = ui->table->columnCount(); i < n; i++) {
         ui->table->setColumnWidth(i, getColumnWidth());
     }
+    m_previewLoader.setTargetWidth(previewWidth());
 
     for (int i = 0, n = m_elements.size(); i < n; i++) {
         int row = (i - (i % cols)) / cols;
@@ -387,7 +398,15 @@ void ImageDialog::renderTable()
         ui->table->setItem(row, i % cols, item);
         ui->table->setCellWidget(row, i % cols, label);
         ui->table->resizeRowToContents(row);
+
+        // Loaded previews come from the cache and are rescaled if necessary.
+        // Local images already have a pixmap and are never downloaded.
+        if (m_elements[i].hasPreview || (!m_elements[i].downloaded && !m_elements[i].queued)) {
+            m_elements[i].queued = true;
+            m_previewLoader.load(i, previewUrl(m_elements[i]));
+        }
     }
+    prioritizeVisiblePreviews();
 }
 
 /**
@@ -410,6 +429,16 @@ int ImageDialog::getColumnWidth()
     return ui->previewSizeSlider->value() * 16;
 }
 
+int ImageDialog::previewWidth()
+{
+    return static_cast<int>((getColumnWidth() - 10) * helper::devicePixelRatio(this));
+}
+
+QUrl ImageDialog::previewUrl(const DownloadElement& element)
+{
+    return element.thumbUrl.isValid() ? element.thumbUrl : element.originalUrl;
+}
+
 /**
  * \brief Called when an image was clicked
  * Saves the URL of the image and accepts the dialog
@@ -491,17 +520,8 @@ void ImageDialog::cancelDownloads()
 {
     ui->labelLoading->setVisible(false);
     ui->labelSpinner->setVisible(false);
-    bool running = false;
-    for (const DownloadElement& d : asConst(m_elements)) {
-        if (!d.downloaded) {
-            running = true;
-            break;
-        }
-    }
     m_elements.clear();
-    if (running) {
-        m_currentDownloadReply->abort();
-    }
+    m_previewLoader.cancel();
 }
 
 /**
@@ -527,7 +547,7 @@ void ImageDialog::chooseLocalImage()
     DownloadElement d;
     d.originalUrl = fileName;
     d.thumbUrl = fileName;
-    d.downloaded = false;
+    d.downloaded = true;
     m_elements.append(d);
 
     renderTable();
@@ -536,7 +556,6 @@ void ImageDialog::chooseLocalImage()
     m_elements[index].cellWidget->setImage(m_elements[index].pixmap);
     m_elements[index].cellWidget->setHint(m_elements[index].pixmap.size());
     ui->table->resizeRowsToContents();
-    m_elements[index].downloaded = true;
     if (m_multiSelection) {
         QByteArray ba;
         QFile file(fileName);
@@ -566,7 +585,8 @@ void ImageDialog::onImageDropped(QUrl url)
     DownloadElement d;
     d.originalUrl = url;
     d.thumbUrl = url;
-    d.downloaded = false;
+    // Remote images are loaded by renderTable().
+    d.downloaded = url.isLocalFile();
     m_elements.append(d);
 
     renderTable();
@@ -579,7 +599,6 @@ void ImageDialog::onImageDropped(QUrl url)
         m_elements[index].cellWidget->setHint(m_elements[index].pixmap.size());
     }
     ui->table->resizeRowsToContents();
-    m_elements[index].downloaded = true;
     if (m_multiSelection) {
         QByteArray ba;
         QFile file(url.toLocalFile());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "globals/Globals.h"
+#include "globals/ImagePreviewLoader.h"
 #include "globals/Poster.h"
 #include "globals/ScraperResult.h"
 #include "network/NetworkManager.h"
@@ -10,7 +11,6 @@
 
 #include <QDialog>
 #include <QLabel>
-#include <QNetworkReply>
 #include <QResizeEvent>
 #include <QTableWidgetItem>
 #include <QUrl>
@@ -65,10 +65,12 @@ protected:
     void resizeEvent(QResizeEvent* event) override;
 
 private slots:
-    /// \brief Called when a download has finished
-    /// \details Renders the table and displays the downloaded image and starts the next download
-    void downloadFinished();
-    void startNextDownload();
+    /// \brief Displays a preview image that was loaded by m_previewLoader.
+    void onPreviewLoaded(int index, QImage scaled);
+    void onPreviewFailed(int index, QString errorString);
+    void onPreviewsFinished();
+    /// \brief Moves previews of visible cells to the front of the download queue.
+    void prioritizeVisiblePreviews();
     void imageClicked(int row, int col);
     void chooseLocalImage();
     void onImageDropped(QUrl url);
@@ -95,9 +97,14 @@ private:
     {
         QUrl thumbUrl;
         QUrl originalUrl;
+        /// \brief Local image, e.g. a dropped one. Remote previews are stored in ImagePreviewCache.
         QPixmap pixmap;
-        QPixmap scaledPixmap;
+        /// \brief True once the preview has been loaded or has failed to load.
         bool downloaded = false;
+        /// \brief True if the preview was passed to m_previewLoader.
+        bool queued = false;
+        /// \brief True if the preview is in ImagePreviewCache.
+        bool hasPreview = false;
         ImageLabel* cellWidget = nullptr;
         QSize resolution;
         QString hint;
@@ -110,8 +117,7 @@ private:
     };
 
     mediaelch::network::NetworkManager m_network;
-    int m_currentDownloadIndex = 0;
-    QNetworkReply* m_currentDownloadReply = nullptr;
+    mediaelch::ImagePreviewLoader m_previewLoader{m_network};
     ImageType m_imageType = ImageType::None;
     QVector<DownloadElement> m_elements;
     QUrl m_imageUrl;
@@ -134,12 +140,14 @@ private:
 private:
     void setAndStartDownloads(QVector<Poster> downloads);
 
-    mediaelch::network::NetworkManager* network();
     void setupProviderCombo();
     void resizeAndReposition();
     void renderTable();
     int calcColumnCount();
     int getColumnWidth();
+    /// \brief Width of preview images in device pixels.
+    int previewWidth();
+    static QUrl previewUrl(const DownloadElement& element);
     /// \brief Triggers loading of images from the current provider
     void loadImagesFromProvider(QString id);
     /// \brief Clears the dialogs contents and cancels outstanding downloads
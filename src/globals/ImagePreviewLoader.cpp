@@ -0,0 +1,210 @@
+#include "globals/ImagePreviewLoader.h"
+
+#include "network/NetworkRequest.h"
+
+#include <QDebug>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+namespace mediaelch {
+
+ImagePreviewCache& ImagePreviewCache::instance()
+{
+    static ImagePreviewCache cache;
+    return cache;
+}
+
+ImagePreviewCache::ImagePreviewCache()
+{
+    m_cache.setMaxCost(defaultMaxBytes);
+}
+
+const ImagePreviewCache::Preview* ImagePreviewCache::find(const QUrl& url)
+{
+    return m_cache.object(url);
+}
+
+void ImagePreviewCache::insert(const QUrl& url, Preview preview)
+{
+    const auto bytesOf = [](const QImage& image) { return image.bytesPerLine() * image.height(); };
+    if (bytesOf(preview.image) > maxOriginalBytes) {
+        // Photos and fanart can be tens of megabytes once decoded.  Rescaling them is
+        // rare enough that downloading them again is cheaper than keeping them.
+        preview.image = QImage();
+    }
+    const int cost = bytesOf(preview.image) + bytesOf(preview.scaled);
+    // QCache takes ownership; images larger than the budget are deleted right away.
+    m_cache.insert(url, new Preview(std::move(preview)), qMax(1, cost));
+}
+
+void ImagePreviewCache::clear()
+{
+    m_cache.clear();
+}
+
+ImagePreviewLoader::ImagePreviewLoader(network::NetworkManager& network, QObject* parent) :
+    QObject(parent), m_network{network}
+{
+    // Decoding and scaling is CPU bound, downloads are not.  Two threads are
+    // enough to keep up with the downloads without slowing down the GUI.
+    m_pool.setMaxThreadCount(2);
+}
+
+ImagePreviewLoader::~ImagePreviewLoader()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+void ImagePreviewLoader::setMaxConcurrentDownloads(int count)
+{
+    m_maxConcurrentDownloads = qMax(1, count);
+    startDownloads();
+}
+
+void ImagePreviewLoader::setTargetWidth(int width)
+{
+    m_targetWidth = qMax(1, width);
+}
+
+void ImagePreviewLoader::load(int id, const QUrl& url)
+{
+    Request request;
+    request.id = id;
+    request.url = url;
+
+    const ImagePreviewCache::Preview* cached = ImagePreviewCache::instance().find(url);
+    if (cached != nullptr && cached->scaledWidth == m_targetWidth) {
+        emit sigPreviewLoaded(id, cached->scaled);
+        return;
+    }
+    if (cached != nullptr && !cached->image.isNull()) {
+        process(request, {}, cached->image);
+        return;
+    }
+
+    m_queue.append(request);
+    startDownloads();
+}
+
+void ImagePreviewLoader::prioritize(const QVector<int>& ids)
+{
+    QVector<Request> front;
+    QVector<Request> back;
+    front.reserve(ids.size());
+    back.reserve(m_queue.size());
+    for (const Request& request : m_queue) {
+        if (ids.contains(request.id)) {
+            front.append(request);
+        } else {
+            back.append(request);
+        }
+    }
+    if (front.isEmpty()) {
+        return;
+    }
+    std::stable_sort(front.begin(), front.end(), [&ids](const Request& a, const Request& b) {
+        return ids.indexOf(a.id) < ids.indexOf(b.id);
+    });
+    m_queue = front + back;
+}
+
+void ImagePreviewLoader::cancel()
+{
+    ++m_generation;
+    m_queue.clear();
+    // Take the replies first: abort() emits finished() synchronously.
+    const auto downloads = m_downloads;
+    m_downloads.clear();
+    for (auto it = downloads.cbegin(); it != downloads.cend(); ++it) {
+        QNetworkReply* reply = it.key();
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+bool ImagePreviewLoader::isIdle() const
+{
+    return m_queue.isEmpty() && m_downloads.isEmpty() && m_processing == 0;
+}
+
+void ImagePreviewLoader::startDownloads()
+{
+    while (m_downloads.size() < m_maxConcurrentDownloads && !m_queue.isEmpty()) {
+        const Request request = m_queue.takeFirst();
+        QNetworkReply* reply = m_network.get(network::requestWithDefaults(request.url));
+        m_downloads.insert(reply, request);
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() { onDownloadFinished(reply); });
+    }
+}
+
+void ImagePreviewLoader::onDownloadFinished(QNetworkReply* reply)
+{
+    reply->deleteLater();
+    if (!m_downloads.contains(reply)) {
+        return;
+    }
+    const Request request = m_downloads.take(reply);
+
+    if (reply->error() == QNetworkReply::NoError) {
+        process(request, reply->readAll(), {});
+    } else {
+        qWarning() << "[ImagePreviewLoader] Network Error:" << reply->errorString() << "|" << reply->url();
+        emit sigPreviewFailed(request.id, reply->errorString());
+    }
+
+    // Start the next download before the image is decoded to keep the
+    // network busy.
+    startDownloads();
+    emitFinishedIfIdle();
+}
+
+void ImagePreviewLoader::process(const Request& request, QByteArray data, QImage image)
+{
+    ++m_processing;
+    const int generation = m_generation;
+    const int width = m_targetWidth;
+
+    auto* watcher = new QFutureWatcher<ImagePreviewCache::Preview>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, request, generation]() {
+        ImagePreviewCache::Preview preview = watcher->result();
+        watcher->deleteLater();
+        --m_processing;
+
+        if (generation == m_generation) {
+            if (preview.scaled.isNull()) {
+                emit sigPreviewFailed(request.id, tr("The image could not be decoded."));
+            } else {
+                const QImage scaled = preview.scaled;
+                ImagePreviewCache::instance().insert(request.url, std::move(preview));
+                emit sigPreviewLoaded(request.id, scaled);
+            }
+        }
+        emitFinishedIfIdle();
+    });
+    watcher->setFuture(QtConcurrent::run(
+        &m_pool, [data, image, width]() { return decodeAndScale(data, image, width); }));
+}
+
+void ImagePreviewLoader::emitFinishedIfIdle()
+{
+    if (isIdle()) {
+        emit sigFinished();
+    }
+}
+
+ImagePreviewCache::Preview ImagePreviewLoader::decodeAndScale(const QByteArray& data, QImage image, int width)
+{
+    ImagePreviewCache::Preview preview;
+    if (image.isNull() && !image.loadFromData(data)) {
+        return preview;
+    }
+    preview.image = std::move(image);
+    preview.scaledWidth = width;
+    preview.scaled = width > 0 ? preview.image.scaledToWidth(width, Qt::SmoothTransformation) : preview.image;
+    return preview;
+}
+
+} // namespace mediaelch
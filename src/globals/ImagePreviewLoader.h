@@ -0,0 +1,133 @@
+#pragma once
+
+#include "network/NetworkManager.h"
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QNetworkReply>
+#include <QObject>
+#include <QThreadPool>
+#include <QUrl>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief In-memory cache of decoded preview images, shared by all image dialogs.
+///
+/// Image dialogs are created for each use.  By keeping decoded previews in a
+/// process-wide cache, reopening the dialog for the same item does not have to
+/// download or decode its previews again.  The cache has a byte budget and
+/// evicts least recently used images.  It must only be used in the GUI thread.
+class ImagePreviewCache
+{
+public:
+    constexpr static int defaultMaxBytes = 64 * 1024 * 1024;
+    /// \brief Decoded originals larger than this are not cached, only their scaled preview.
+    constexpr static int maxOriginalBytes = 4 * 1024 * 1024;
+
+    struct Preview
+    {
+        /// \brief The decoded image in its original size, used to rescale the preview.
+        /// \details Null in the cache if it is larger than maxOriginalBytes.  Such previews
+        ///          are downloaded again if they are needed in another width.
+        QImage image;
+        /// \brief The image scaled to scaledWidth.
+        QImage scaled;
+        int scaledWidth = 0;
+    };
+
+    static ImagePreviewCache& instance();
+
+    /// \brief Returns the preview for the given URL or nullptr.
+    /// \details The pointer is only valid until the next call to insert().
+    const Preview* find(const QUrl& url);
+    void insert(const QUrl& url, Preview preview);
+    void clear();
+
+    int count() const { return m_cache.count(); }
+    /// \brief Bytes of all cached images.
+    int totalBytes() const { return m_cache.totalCost(); }
+    int maxBytes() const { return m_cache.maxCost(); }
+    /// \brief Sets the byte budget and evicts images until the cache is within it.
+    void setMaxBytes(int bytes) { m_cache.setMaxCost(bytes); }
+
+private:
+    ImagePreviewCache();
+
+    QCache<QUrl, Preview> m_cache;
+};
+
+/// \brief Downloads, decodes and scales preview images concurrently.
+///
+/// Up to maxConcurrentDownloads() previews are downloaded at the same time.
+/// Downloaded images are decoded and scaled in a thread pool so that the
+/// GUI thread only has to convert the result into a pixmap.  Queued previews
+/// can be moved to the front, e.g. those that are currently visible.
+/// Results are stored in ImagePreviewCache.
+class ImagePreviewLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    constexpr static int defaultConcurrentDownloads = 4;
+
+    explicit ImagePreviewLoader(network::NetworkManager& network, QObject* parent = nullptr);
+    /// \brief Aborts all downloads and waits for running decode jobs.
+    ~ImagePreviewLoader() override;
+
+    void setMaxConcurrentDownloads(int count);
+    int maxConcurrentDownloads() const { return m_maxConcurrentDownloads; }
+
+    /// \brief Width in device pixels that previews are scaled to.
+    void setTargetWidth(int width);
+    int targetWidth() const { return m_targetWidth; }
+
+    /// \brief Queues the preview with the given URL.  The id is passed to sigPreviewLoaded().
+    /// \details If the preview is cached in the target width, sigPreviewLoaded() is emitted
+    ///          before this function returns.  If it is cached in another width, it is only
+    ///          rescaled.
+    void load(int id, const QUrl& url);
+    /// \brief Moves the given previews to the front of the queue, in the given order.
+    void prioritize(const QVector<int>& ids);
+    /// \brief Aborts all downloads and clears the queue.  Pending results are discarded.
+    void cancel();
+
+    /// \brief True if no preview is queued, downloading or being decoded.
+    bool isIdle() const;
+
+signals:
+    void sigPreviewLoaded(int id, QImage scaled);
+    void sigPreviewFailed(int id, QString errorString);
+    /// \brief Emitted once all queued previews are loaded or have failed.
+    void sigFinished();
+
+private:
+    struct Request
+    {
+        int id = -1;
+        QUrl url;
+    };
+
+    void startDownloads();
+    void onDownloadFinished(QNetworkReply* reply);
+    /// \brief Decodes (if the image is null) and scales the preview in the thread pool.
+    void process(const Request& request, QByteArray data, QImage image);
+    void emitFinishedIfIdle();
+
+    /// \brief Runs in the thread pool.
+    static ImagePreviewCache::Preview decodeAndScale(const QByteArray& data, QImage image, int width);
+
+private:
+    network::NetworkManager& m_network;
+    QVector<Request> m_queue;
+    QHash<QNetworkReply*, Request> m_downloads;
+    int m_processing = 0;
+    /// Incremented by cancel() to discard results of outdated decode jobs.
+    int m_generation = 0;
+    int m_maxConcurrentDownloads = defaultConcurrentDownloads;
+    int m_targetWidth = 0;
+    QThreadPool m_pool;
+};
+
+} // namespace mediaelch
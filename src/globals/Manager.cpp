@@ -29,7 +29,17 @@ Manager::Manager(QObject* parent) : QObject(parent)
     m_tvShowModel = new TvShowModel(this);
     m_concertModel = new ConcertModel(this);
     m_musicModel = new MusicModel(this);
+    m_searchIndex = new mediaelch::MediaSearchIndex(this);
     m_database = new Database(this);
+    m_mediaInfoProbeQueue = new mediaelch::MediaInfoProbeQueue(*m_database, this);
+
+    // Probe new and changed files after each scan so that opening a movie
+    // doesn't have to wait for libmediainfo.
+    connect(m_movieFileSearcher, &mediaelch::MovieFileSearcher::moviesLoaded, this, [this]() {
+        if (Settings::instance()->autoLoadStreamDetails()) {
+            m_mediaInfoProbeQueue->enqueueMovies(m_movieModel->movies());
+        }
+    });
 
     m_mediaCenters.append(new KodiXml(this));
     m_mediaCentersTvShow.append(new KodiXml(this));
@@ -149,6 +159,12 @@ MusicModel* Manager::musicModel()
     return m_musicModel;
 }
 
+/// \brief Full-text index used by the filter bar. Models are synchronized lazily by their proxy models.
+mediaelch::MediaSearchIndex* Manager::searchIndex()
+{
+    return m_searchIndex;
+}
+
 /**
  * \brief Returns a list of all image providers available for type
  * \param type Type of image
@@ -180,6 +196,12 @@ Database* Manager::database()
     return m_database;
 }
 
+/// \brief Loads stream details through the MediaInfo probe cache.
+mediaelch::MediaInfoProbeQueue* Manager::mediaInfoProbeQueue()
+{
+    return m_mediaInfoProbeQueue;
+}
+
 void Manager::setTvShowFilesWidget(TvShowFilesWidget* widget)
 {
     m_tvShowFilesWidget = widget;
@@ -3,6 +3,8 @@
 #include "concerts/ConcertFileSearcher.h"
 #include "concerts/ConcertModel.h"
 #include "data/Database.h"
+#include "data/MediaInfoProbeQueue.h"
+#include "globals/MediaSearchIndex.h"
 #include "globals/ScraperManager.h"
 #include "media_centers/MediaCenterInterface.h"
 #include "movies/MovieModel.h"
@@ -49,10 +51,12 @@ public:
     ELCH_NODISCARD ConcertFileSearcher* concertFileSearcher();
     ELCH_NODISCARD MusicFileSearcher* musicFileSearcher();
     ELCH_NODISCARD Database* database();
+    ELCH_NODISCARD mediaelch::MediaInfoProbeQueue* mediaInfoProbeQueue();
     ELCH_NODISCARD MovieModel* movieModel();
     ELCH_NODISCARD TvShowModel* tvShowModel();
     ELCH_NODISCARD ConcertModel* concertModel();
     ELCH_NODISCARD MusicModel* musicModel();
+    ELCH_NODISCARD mediaelch::MediaSearchIndex* searchIndex();
     ELCH_NODISCARD FileScannerDialog* fileScannerDialog();
     ELCH_NODISCARD mediaelch::scraper::FanartTv* fanartTv();
     ELCH_NODISCARD TvShowFilesWidget* tvShowFilesWidget();
@@ -77,7 +81,9 @@ private:
     TvShowModel* m_tvShowModel = nullptr;
     ConcertModel* m_concertModel = nullptr;
     MusicModel* m_musicModel = nullptr;
+    mediaelch::MediaSearchIndex* m_searchIndex = nullptr;
     Database* m_database = nullptr;
+    mediaelch::MediaInfoProbeQueue* m_mediaInfoProbeQueue = nullptr;
     TvShowFilesWidget* m_tvShowFilesWidget = nullptr;
     MusicFilesWidget* m_musicFilesWidget = nullptr;
     FileScannerDialog* m_fileScannerDialog = nullptr;
@@ -0,0 +1,399 @@
+#include "globals/MediaSearchIndex.h"
+
+#include "concerts/Concert.h"
+#include "globals/Helper.h"
+#include "movies/Movie.h"
+#include "music/Album.h"
+#include "music/Artist.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using Field = mediaelch::MediaSearchIndex::Field;
+
+/// Separates multiple values of a field so that a query can't match across values.
+const QChar valueSeparator('\n');
+
+int fieldIndex(Field field)
+{
+    switch (field) {
+    case Field::Title: return 0;
+    case Field::OriginalTitle: return 1;
+    case Field::People: return 2;
+    case Field::Genres: return 3;
+    case Field::Tags: return 4;
+    case Field::Studios: return 5;
+    case Field::Plot: return 6;
+    case Field::Path: return 7;
+    }
+    return 0;
+}
+
+class DocumentTexts
+{
+public:
+    DocumentTexts() : m_texts(mediaelch::MediaSearchIndex::FieldCount) {}
+
+    DocumentTexts& add(Field field, const QString& text)
+    {
+        if (!text.isEmpty()) {
+            QString& value = m_texts[fieldIndex(field)];
+            if (!value.isEmpty()) {
+                value.append(valueSeparator);
+            }
+            value.append(text.toCaseFolded());
+        }
+        return *this;
+    }
+
+    DocumentTexts& add(Field field, const QStringList& texts)
+    {
+        for (const QString& text : texts) {
+            add(field, text);
+        }
+        return *this;
+    }
+
+    DocumentTexts& add(Field field, const QVector<const Actor*>& actors)
+    {
+        for (const Actor* actor : actors) {
+            add(field, actor->name);
+        }
+        return *this;
+    }
+
+    QVector<QString> texts() { return std::move(m_texts); }
+
+private:
+    QVector<QString> m_texts;
+};
+
+QVector<QString> textsOf(const Movie& movie)
+{
+    return DocumentTexts()
+        .add(Field::Title, movie.name())
+        .add(Field::OriginalTitle, movie.originalName())
+        .add(Field::People, movie.director())
+        .add(Field::People, movie.actors())
+        .add(Field::Genres, movie.genres())
+        .add(Field::Tags, movie.tags())
+        .add(Field::Studios, movie.studios())
+        .add(Field::Plot, movie.overview())
+        .add(Field::Path, movie.files().toNativeStringList())
+        .texts();
+}
+
+QVector<QString> textsOf(const Concert& concert)
+{
+    return DocumentTexts()
+        .add(Field::Title, concert.name())
+        .add(Field::People, concert.artist())
+        .add(Field::Genres, concert.genres())
+        .add(Field::Tags, concert.tags())
+        .add(Field::Plot, concert.overview())
+        .add(Field::Path, concert.files().toNativeStringList())
+        .texts();
+}
+
+QVector<QString> textsOf(const TvShow& show)
+{
+    return DocumentTexts()
+        .add(Field::Title, show.title())
+        .add(Field::OriginalTitle, show.originalTitle())
+        .add(Field::People, show.actors())
+        .add(Field::Genres, show.genres())
+        .add(Field::Tags, show.tags())
+        .add(Field::Studios, show.network())
+        .add(Field::Plot, show.overview())
+        .add(Field::Path, show.dir().toNativePathString())
+        .texts();
+}
+
+QVector<QString> textsOf(const TvShowEpisode& episode)
+{
+    // The TV show list displays the complete episode name, e.g. "S01E01 Pilot".
+    return DocumentTexts()
+        .add(Field::Title, episode.completeEpisodeName())
+        .add(Field::People, episode.directors())
+        .add(Field::People, episode.actors())
+        .add(Field::Tags, episode.tags())
+        .add(Field::Plot, episode.overview())
+        .add(Field::Path, episode.files().toNativeStringList())
+        .texts();
+}
+
+QVector<QString> textsOf(const Artist& artist)
+{
+    // The music list displays names with moved articles, e.g. "Beatles, The".
+    return DocumentTexts()
+        .add(Field::Title, artist.name())
+        .add(Field::Title, helper::appendArticle(artist.name()))
+        .add(Field::Genres, artist.genres())
+        .add(Field::Genres, artist.styles())
+        .add(Field::Plot, artist.biography())
+        .add(Field::Path, artist.path().toNativePathString())
+        .texts();
+}
+
+QVector<QString> textsOf(const Album& album)
+{
+    return DocumentTexts()
+        .add(Field::Title, album.title())
+        .add(Field::Title, helper::appendArticle(album.title()))
+        .add(Field::People, album.artist())
+        .add(Field::Genres, album.genres())
+        .add(Field::Genres, album.styles())
+        .add(Field::Studios, album.label())
+        .add(Field::Plot, album.review())
+        .add(Field::Path, album.path().toNativePathString())
+        .texts();
+}
+
+bool detailsPendingOf(const Movie& movie)
+{
+    return movie.controller()->detailsPending();
+}
+
+bool detailsPendingOf(const TvShowEpisode& episode)
+{
+    return episode.detailsPending();
+}
+
+template<class T>
+bool detailsPendingOf(const T& /*item*/)
+{
+    return false;
+}
+
+quint64 trigram(const QChar* chars)
+{
+    return (quint64(chars[0].unicode()) << 32) | (quint64(chars[1].unicode()) << 16) | quint64(chars[2].unicode());
+}
+
+} // namespace
+
+namespace mediaelch {
+
+MediaSearchIndex::MediaSearchIndex(QObject* parent) : QObject(parent)
+{
+}
+
+template<class T>
+void MediaSearchIndex::addItem(T* item)
+{
+    const auto it = m_documentIds.constFind(item);
+    if (it != m_documentIds.constEnd()) {
+        // Details may have been loaded while the item's signals were blocked.
+        if (m_documents.at(it.value()).detailsPending != detailsPendingOf(*item)) {
+            updateItem(item);
+        }
+        return;
+    }
+
+    insertDocument(item, textsOf(*item), detailsPendingOf(*item));
+    connect(item, &T::sigChanged, this, [this, item]() { updateItem(item); });
+    // The item must not be dereferenced: It is already (partially) destroyed.
+    connect(item, &QObject::destroyed, this, [this, item]() { removeItem(item); });
+}
+
+template<class T>
+void MediaSearchIndex::updateItem(T* item)
+{
+    const auto it = m_documentIds.constFind(item);
+    if (it == m_documentIds.constEnd()) {
+        return;
+    }
+    const int id = it.value();
+    QVector<QString> texts = textsOf(*item);
+    const bool detailsPending = detailsPendingOf(*item);
+    if (m_documents.at(id).texts == texts) {
+        m_documents[id].detailsPending = detailsPending;
+        return;
+    }
+    retireDocument(id);
+    insertDocument(item, std::move(texts), detailsPending);
+    compactIfNecessary();
+}
+
+void MediaSearchIndex::addMovies(const QVector<Movie*>& movies)
+{
+    for (Movie* movie : movies) {
+        addItem(movie);
+    }
+}
+
+void MediaSearchIndex::addConcerts(const QVector<Concert*>& concerts)
+{
+    for (Concert* concert : concerts) {
+        addItem(concert);
+    }
+}
+
+void MediaSearchIndex::addTvShows(const QVector<TvShow*>& shows)
+{
+    for (TvShow* show : shows) {
+        addItem(show);
+        for (TvShowEpisode* episode : show->episodes()) {
+            addItem(episode);
+        }
+    }
+}
+
+void MediaSearchIndex::addArtists(const QVector<Artist*>& artists)
+{
+    for (Artist* artist : artists) {
+        addItem(artist);
+        for (Album* album : artist->albums()) {
+            addItem(album);
+        }
+    }
+}
+
+void MediaSearchIndex::removeItem(const QObject* item)
+{
+    const auto it = m_documentIds.find(item);
+    if (it == m_documentIds.end()) {
+        return;
+    }
+    retireDocument(it.value());
+    m_documentIds.erase(it);
+    disconnect(item, nullptr, this, nullptr);
+    compactIfNecessary();
+}
+
+void MediaSearchIndex::clear()
+{
+    for (auto it = m_documentIds.constBegin(); it != m_documentIds.constEnd(); ++it) {
+        disconnect(it.key(), nullptr, this, nullptr);
+    }
+    m_documents.clear();
+    m_documentIds.clear();
+    m_postings.clear();
+    m_retiredCount = 0;
+}
+
+int MediaSearchIndex::documentCount() const
+{
+    return m_documentIds.size();
+}
+
+bool MediaSearchIndex::contains(const QObject* item) const
+{
+    return m_documentIds.contains(item);
+}
+
+QSet<const QObject*> MediaSearchIndex::search(const QString& text, Fields fields) const
+{
+    QSet<const QObject*> hits;
+    const QString query = text.toCaseFolded();
+
+    const QVector<int>* candidates = nullptr;
+    if (query.size() >= 3) {
+        // Only documents that contain the query's rarest trigram can match.
+        for (int i = 0; i + 3 <= query.size(); ++i) {
+            const auto posting = m_postings.constFind(trigram(query.constData() + i));
+            if (posting == m_postings.constEnd()) {
+                return hits;
+            }
+            if (candidates == nullptr || posting->size() < candidates->size()) {
+                candidates = &posting.value();
+            }
+        }
+    }
+
+    if (candidates != nullptr) {
+        for (int id : *candidates) {
+            const Document& document = m_documents.at(id);
+            if (documentMatches(document, query, fields)) {
+                hits.insert(document.item);
+            }
+        }
+    } else {
+        hits.reserve(m_documentIds.size());
+        for (const Document& document : m_documents) {
+            if (documentMatches(document, query, fields)) {
+                hits.insert(document.item);
+            }
+        }
+    }
+    return hits;
+}
+
+void MediaSearchIndex::insertDocument(const QObject* item, QVector<QString> texts, bool detailsPending)
+{
+    const int id = m_documents.size();
+    Document document;
+    document.item = item;
+    document.texts = std::move(texts);
+    document.detailsPending = detailsPending;
+    m_documents.append(std::move(document));
+    m_documentIds.insert(item, id);
+    indexDocument(id);
+}
+
+void MediaSearchIndex::retireDocument(int id)
+{
+    // Postings are not touched: Retired documents are skipped when searching
+    // and removed once the index is compacted.
+    m_documents[id].item = nullptr;
+    m_documents[id].texts.clear();
+    ++m_retiredCount;
+}
+
+void MediaSearchIndex::indexDocument(int id)
+{
+    std::vector<quint64> trigrams;
+    for (const QString& text : m_documents.at(id).texts) {
+        for (int i = 0; i + 3 <= text.size(); ++i) {
+            trigrams.push_back(trigram(text.constData() + i));
+        }
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    for (quint64 key : trigrams) {
+        m_postings[key].append(id);
+    }
+}
+
+void MediaSearchIndex::compactIfNecessary()
+{
+    if (m_retiredCount < 1024 || m_retiredCount < m_documentIds.size()) {
+        return;
+    }
+    QVector<Document> documents;
+    documents.reserve(m_documentIds.size());
+    for (Document& document : m_documents) {
+        if (document.item != nullptr) {
+            m_documentIds[document.item] = documents.size();
+            documents.append(std::move(document));
+        }
+    }
+    m_documents = std::move(documents);
+    m_postings.clear();
+    m_retiredCount = 0;
+    for (int id = 0; id < m_documents.size(); ++id) {
+        indexDocument(id);
+    }
+}
+
+bool MediaSearchIndex::documentMatches(const Document& document, const QString& query, Fields fields) const
+{
+    if (document.item == nullptr) {
+        return false;
+    }
+    if (query.isEmpty()) {
+        return true;
+    }
+    for (int i = 0; i < FieldCount; ++i) {
+        if (fields.testFlag(static_cast<Field>(1 << i)) && document.texts.at(i).contains(query)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QFlags>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+class Album;
+class Artist;
+class Concert;
+class Movie;
+class TvShow;
+class TvShowEpisode;
+
+namespace mediaelch {
+
+/// \brief In-memory full-text index over the metadata of all media types.
+/// \details The filter bar filters tens of thousands of items on each key stroke.
+///          Instead of calling Filter::accepts() for each item, the index keeps
+///          case-folded texts of each item and a trigram index over them:
+///          A query of at least three characters only has to check the items
+///          that contain the query's rarest trigram.  Shorter queries fall back
+///          to a linear scan over the case-folded texts.
+///
+///          Items are re-indexed if they emit sigChanged() and removed once they
+///          are destroyed.  The add*() functions are idempotent, so callers can
+///          synchronize the index with their model before searching.  Movies
+///          and episodes whose details are still pending (see
+///          MovieController::detailsPending()) are re-indexed once their details
+///          are loaded.
+class MediaSearchIndex : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Field : int
+    {
+        Title = 0x01,
+        OriginalTitle = 0x02,
+        /// Actors, directors and artists
+        People = 0x04,
+        /// Genres and styles
+        Genres = 0x08,
+        Tags = 0x10,
+        /// Studios, networks and labels
+        Studios = 0x20,
+        /// Plots, overviews, biographies and reviews
+        Plot = 0x40,
+        Path = 0x80,
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
+    static constexpr int FieldCount = 8;
+
+public:
+    explicit MediaSearchIndex(QObject* parent = nullptr);
+    ~MediaSearchIndex() override = default;
+
+    void addMovies(const QVector<Movie*>& movies);
+    void addConcerts(const QVector<Concert*>& concerts);
+    /// \brief Adds the given TV shows and all of their episodes.
+    void addTvShows(const QVector<TvShow*>& shows);
+    /// \brief Adds the given artists and all of their albums.
+    void addArtists(const QVector<Artist*>& artists);
+
+    void removeItem(const QObject* item);
+    void clear();
+
+    int documentCount() const;
+    bool contains(const QObject* item) const;
+
+    /// \brief All items that contain the given text (case-insensitive) in any of the given fields.
+    /// \details An empty text matches all items.
+    QSet<const QObject*> search(const QString& text, Fields fields) const;
+
+private:
+    struct Document
+    {
+        /// nullptr if the document was replaced or removed
+        const QObject* item = nullptr;
+        QVector<QString> texts;
+        bool detailsPending = false;
+    };
+
+    template<class T>
+    void addItem(T* item);
+    template<class T>
+    void updateItem(T* item);
+
+    void insertDocument(const QObject* item, QVector<QString> texts, bool detailsPending);
+    void retireDocument(int id);
+    void indexDocument(int id);
+    void compactIfNecessary();
+    bool documentMatches(const Document& document, const QString& query, Fields fields) const;
+
+private:
+    QVector<Document> m_documents;
+    QHash<const QObject*, int> m_documentIds;
+    /// Trigram -> ids of documents that contain it.  May contain retired documents.
+    QHash<quint64, QVector<int>> m_postings;
+    int m_retiredCount = 0;
+};
+
+} // namespace mediaelch
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(mediaelch::MediaSearchIndex::Fields)
@@ -1,5 +1,6 @@
 #include "ImageCapture.h"
 
+#include "globals/Manager.h"
 #include "globals/Random.h"
 #include "globals/Time.h"
 #include "ui/notifications/NotificationBox.h"
@@ -22,7 +23,7 @@ bool ImageCapture::captureImage(FilePath file,
     bool cropFromCenter)
 {
     if (streamDetails->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds, nullptr) == nullptr) {
-        streamDetails->loadStreamDetails();
+        Manager::instance()->mediaInfoProbeQueue()->loadStreamDetails(*streamDetails);
     }
     if (streamDetails->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds, nullptr) == nullptr) {
         NotificationBox::instance()->showError(tr("Could not get duration of file"));
@@ -0,0 +1,332 @@
+#include "imports/FileImporter.h"
+
+#include "globals/Meta.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QPair>
+#include <QStorageInfo>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <memory>
+
+#ifdef Q_OS_LINUX
+#    include <cerrno>
+#    include <cstring>
+#    include <linux/fs.h>
+#    include <sys/ioctl.h>
+#    include <sys/sendfile.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace mediaelch {
+
+namespace {
+
+/// Buffer size of the fallback copy.  Large enough to keep the number of
+/// syscalls low for multi-gigabyte files.
+constexpr qint64 bufferSize = 4 * 1024 * 1024;
+/// Page alignment, so that the kernel does not have to split reads and writes.
+constexpr std::size_t bufferAlignment = 4096;
+
+using ProgressFunction = std::function<void(qint64)>;
+
+FileImporter::Status copyWithBuffer(QFile& in,
+    QFile& out,
+    qint64 size,
+    const std::atomic_bool& cancelled,
+    const ProgressFunction& onProgress,
+    qint64& copied)
+{
+    std::unique_ptr<char[]> storage(new char[bufferSize + bufferAlignment]);
+    void* aligned = storage.get();
+    std::size_t space = bufferSize + bufferAlignment;
+    char* buffer = static_cast<char*>(std::align(bufferAlignment, bufferSize, aligned, space));
+
+    // The kernel copy may have stopped in the middle of the file.
+    if (!in.seek(copied) || !out.seek(copied)) {
+        return FileImporter::Status::Failed;
+    }
+    while (copied < size) {
+        if (cancelled) {
+            return FileImporter::Status::Cancelled;
+        }
+        const qint64 bytesRead = in.read(buffer, std::min(bufferSize, size - copied));
+        if (bytesRead <= 0) {
+            qWarning() << "[FileImporter] Could not read" << in.fileName() << in.errorString();
+            return FileImporter::Status::Failed;
+        }
+        if (out.write(buffer, bytesRead) != bytesRead) {
+            qWarning() << "[FileImporter] Could not write" << out.fileName() << out.errorString();
+            return FileImporter::Status::Failed;
+        }
+        copied += bytesRead;
+        onProgress(bytesRead);
+    }
+    return FileImporter::Status::Success;
+}
+
+#ifdef Q_OS_LINUX
+
+/// Size of a single copy_file_range() or sendfile() call; cancellation is checked in between.
+constexpr qint64 kernelChunkSize = 16 * 1024 * 1024;
+
+enum class KernelCopy
+{
+    Done,
+    Unsupported,
+    Failed,
+    Cancelled
+};
+
+bool isUnsupported(int error)
+{
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == EBADF;
+}
+
+/// \brief Copies the file without passing the data through user space.
+/// Both file descriptors' offsets are advanced by the number of bytes copied.
+template<class CopyFunction>
+KernelCopy copyInChunks(qint64 size,
+    const std::atomic_bool& cancelled,
+    const ProgressFunction& onProgress,
+    qint64& copied,
+    CopyFunction copyChunk)
+{
+    while (copied < size) {
+        if (cancelled) {
+            return KernelCopy::Cancelled;
+        }
+        const auto chunk = static_cast<size_t>(std::min(kernelChunkSize, size - copied));
+        const qint64 result = copyChunk(chunk);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return isUnsupported(errno) ? KernelCopy::Unsupported : KernelCopy::Failed;
+        }
+        if (result == 0) {
+            // The source file is shorter than expected.
+            return KernelCopy::Failed;
+        }
+        copied += result;
+        onProgress(result);
+    }
+    return KernelCopy::Done;
+}
+
+KernelCopy copyInKernel(int in,
+    int out,
+    qint64 size,
+    const std::atomic_bool& cancelled,
+    const ProgressFunction& onProgress,
+    qint64& copied)
+{
+#    ifdef FICLONE
+    // Copy-on-write clone (Btrfs, XFS): instant and does not use any space.
+    if (::ioctl(out, FICLONE, in) == 0) {
+        copied = size;
+        onProgress(size);
+        return KernelCopy::Done;
+    }
+#    endif
+
+#    ifdef SYS_copy_file_range
+    // copy_file_range() lets the file system copy on the server side (NFS, SMB)
+    // or in the kernel.  Called via syscall() because older C libraries lack a wrapper.
+    const KernelCopy result = copyInChunks(size, cancelled, onProgress, copied, [in, out](size_t chunk) {
+        return static_cast<qint64>(::syscall(SYS_copy_file_range, in, nullptr, out, nullptr, chunk, 0U));
+    });
+    if (result != KernelCopy::Unsupported) {
+        return result;
+    }
+#    endif
+
+    return copyInChunks(size, cancelled, onProgress, copied, [in, out](size_t chunk) {
+        return static_cast<qint64>(::sendfile(out, in, nullptr, chunk));
+    });
+}
+
+#endif
+
+} // namespace
+
+FileImporter::FileImporter(QObject* parent) : QObject(parent)
+{
+    m_pool.setMaxThreadCount(m_maxParallelGroups);
+}
+
+FileImporter::~FileImporter()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+void FileImporter::setMaxParallelGroups(int count)
+{
+    m_maxParallelGroups = qMax(1, count);
+    m_pool.setMaxThreadCount(m_maxParallelGroups);
+}
+
+void FileImporter::start(const QMap<QString, QString>& files, Mode mode)
+{
+    if (isRunning()) {
+        qWarning() << "[FileImporter] Import is already running";
+        return;
+    }
+    m_cancelled = false;
+    m_bytesDone = 0;
+    m_bytesTotal = 0;
+    m_failedFiles.clear();
+
+    // Files are grouped by the devices they are read from and written to.
+    QMap<QPair<QByteArray, QByteArray>, QVector<Job>> groups;
+    for (auto it = files.cbegin(); it != files.cend(); ++it) {
+        m_bytesTotal += QFileInfo(it.key()).size();
+        const QByteArray sourceDevice = QStorageInfo(it.key()).device();
+        const QByteArray destinationDevice = QStorageInfo(QFileInfo(it.value()).absolutePath()).device();
+        groups[qMakePair(sourceDevice, destinationDevice)].append(Job{it.key(), it.value()});
+    }
+
+    if (groups.isEmpty()) {
+        QTimer::singleShot(0, this, [this]() { emit sigFinished(); });
+        return;
+    }
+
+    m_runningGroups = groups.size();
+    for (const QVector<Job>& jobs : asConst(groups)) {
+        auto* watcher = new QFutureWatcher<QStringList>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher]() {
+            m_failedFiles << watcher->result();
+            watcher->deleteLater();
+            if (--m_runningGroups == 0) {
+                emit sigFinished();
+            }
+        });
+        watcher->setFuture(QtConcurrent::run(&m_pool, [this, jobs, mode]() { return importGroup(jobs, mode); }));
+    }
+}
+
+void FileImporter::cancel()
+{
+    m_cancelled = true;
+}
+
+QStringList FileImporter::importGroup(const QVector<Job>& jobs, Mode mode)
+{
+    QStringList failed;
+    for (const Job& job : jobs) {
+        if (importFile(job, mode) != Status::Success) {
+            failed << job.source;
+        }
+    }
+    return failed;
+}
+
+FileImporter::Status FileImporter::importFile(const Job& job, Mode mode)
+{
+    if (m_cancelled) {
+        return Status::Cancelled;
+    }
+
+    if (mode == Mode::Move && !QFileInfo::exists(job.destination)) {
+        const qint64 size = QFileInfo(job.source).size();
+        // Succeeds if both are on the same file system; the rename is atomic.
+        // QDir::rename() (unlike QFile::rename()) never falls back to copying.
+        if (QDir().rename(job.source, job.destination)) {
+            m_bytesDone += size;
+            return Status::Success;
+        }
+    }
+
+    const Status status =
+        copyFile(job.source, job.destination, m_cancelled, [this](qint64 bytes) { m_bytesDone += bytes; });
+    if (status == Status::Success && mode == Mode::Move && !QFile::remove(job.source)) {
+        qWarning() << "[FileImporter] Could not remove the source file" << job.source;
+    }
+    return status;
+}
+
+FileImporter::Status FileImporter::copyFile(const QString& source,
+    const QString& destination,
+    const std::atomic_bool& cancelled,
+    const std::function<void(qint64)>& onProgress)
+{
+    if (cancelled) {
+        return Status::Cancelled;
+    }
+    if (QFileInfo::exists(destination)) {
+        qWarning() << "[FileImporter] Destination already exists:" << destination;
+        return Status::Failed;
+    }
+
+    QFile in(source);
+    if (!in.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        qWarning() << "[FileImporter] Could not open" << source << in.errorString();
+        return Status::Failed;
+    }
+    const QString partFileName = destination + ".part";
+    QFile out(partFileName);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        qWarning() << "[FileImporter] Could not open" << partFileName << out.errorString();
+        return Status::Failed;
+    }
+
+    const ProgressFunction report = [&onProgress](qint64 bytes) {
+        if (onProgress) {
+            onProgress(bytes);
+        }
+    };
+    const qint64 size = in.size();
+    qint64 copied = 0;
+    Status status = Status::Failed;
+    bool useBuffer = true;
+
+#ifdef Q_OS_LINUX
+    switch (copyInKernel(in.handle(), out.handle(), size, cancelled, report, copied)) {
+    case KernelCopy::Done:
+        status = Status::Success;
+        useBuffer = false;
+        break;
+    case KernelCopy::Cancelled:
+        status = Status::Cancelled;
+        useBuffer = false;
+        break;
+    case KernelCopy::Failed:
+        qWarning() << "[FileImporter] Could not copy" << source << "to" << partFileName << ::strerror(errno);
+        useBuffer = false;
+        break;
+    case KernelCopy::Unsupported: break;
+    }
+#endif
+
+    if (useBuffer) {
+        status = copyWithBuffer(in, out, size, cancelled, report, copied);
+    }
+    if (status == Status::Success && copied != size) {
+        status = Status::Failed;
+    }
+    if (status == Status::Success) {
+        out.setPermissions(in.permissions());
+    }
+    in.close();
+    out.close();
+
+    if (status == Status::Success && out.error() == QFileDevice::NoError) {
+        if (QDir().rename(partFileName, destination)) {
+            return Status::Success;
+        }
+        qWarning() << "[FileImporter] Could not rename" << partFileName << "to" << destination;
+        status = Status::Failed;
+    }
+    QFile::remove(partFileName);
+    return status == Status::Success ? Status::Failed : status;
+}
+
+} // namespace mediaelch
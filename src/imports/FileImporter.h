@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Copies or moves imported files into the library.
+///
+/// Files are first written to "<destination>.part" and renamed once they are
+/// complete, so that a library scan never sees a partial file.  Moves within
+/// the same file system are a plain rename and do not copy any data.
+///
+/// On Linux, file contents are cloned (reflink) if the file system supports
+/// it, otherwise copied by the kernel using copy_file_range() or sendfile().
+/// On other systems and if those are not available, a large aligned buffer
+/// is used.
+///
+/// Files are grouped by their source and destination device.  Each group is
+/// imported sequentially, different groups in parallel, so that two copies
+/// never compete for the same disk.
+class FileImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Mode
+    {
+        Copy,
+        Move
+    };
+
+    enum class Status
+    {
+        Success,
+        Failed,
+        Cancelled
+    };
+
+    constexpr static int defaultMaxParallelGroups = 4;
+
+    explicit FileImporter(QObject* parent = nullptr);
+    /// \brief Cancels the import and waits for running copies.
+    ~FileImporter() override;
+
+    /// \brief Imports all files (source -> destination) in the background.
+    /// \details Existing destination files are not overwritten; such files fail.
+    ///          sigFinished() is emitted once all files are done.
+    void start(const QMap<QString, QString>& files, Mode mode);
+    /// \brief Stops the import.  Partial files are removed.  Files that are
+    ///        already imported are kept.  Sources of unfinished moves are kept.
+    void cancel();
+
+    bool isRunning() const { return m_runningGroups > 0; }
+    bool wasCancelled() const { return m_cancelled; }
+
+    /// \brief Number of bytes of all files to import.
+    qint64 bytesTotal() const { return m_bytesTotal; }
+    /// \brief Number of bytes that are imported.  May be called at any time.
+    qint64 bytesDone() const { return m_bytesDone; }
+    /// \brief Source files that could not be imported.  Complete after sigFinished().
+    QStringList failedFiles() const { return m_failedFiles; }
+
+    void setMaxParallelGroups(int count);
+
+    /// \brief Copies the file's contents and permissions.  The destination must not exist.
+    /// \param onProgress Called with the number of bytes copied since the last call.
+    static Status copyFile(const QString& source,
+        const QString& destination,
+        const std::atomic_bool& cancelled,
+        const std::function<void(qint64)>& onProgress = {});
+
+signals:
+    void sigFinished();
+
+private:
+    struct Job
+    {
+        QString source;
+        QString destination;
+    };
+
+    /// \brief Runs in the thread pool.  Returns the sources that failed.
+    QStringList importGroup(const QVector<Job>& jobs, Mode mode);
+    Status importFile(const Job& job, Mode mode);
+
+private:
+    QThreadPool m_pool;
+    std::atomic_bool m_cancelled{false};
+    std::atomic<qint64> m_bytesDone{0};
+    qint64 m_bytesTotal = 0;
+    int m_runningGroups = 0;
+    int m_maxParallelGroups = defaultMaxParallelGroups;
+    QStringList m_failedFiles;
+};
+
+} // namespace mediaelch
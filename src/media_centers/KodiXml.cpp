@@ -30,6 +30,37 @@
 #include <array>
 #include <memory>
 
+namespace {
+
+/// \brief Reads the rest of the document, so that errors after the NFO's root element are found, too.
+/// \details Malformed NFOs are not read at all, not even up to the error, which is how they
+///          have always been handled, see discardNfoDetails().
+/// \return Whether the whole document is well-formed.
+bool readToEnd(QXmlStreamReader& xml)
+{
+    while (!xml.atEnd()) {
+        xml.readNext();
+    }
+    if (xml.hasError()) {
+        qWarning() << "[KodiXml] Malformed NFO file:" << xml.errorString() << "in line" << xml.lineNumber();
+        return false;
+    }
+    return true;
+}
+
+/// \brief Drops the details that were read from a malformed NFO.
+/// \details NFOs are read in a single pass, so an error is only found after the details
+///          in front of it were stored.  Resets everything the loaders clear before reading.
+template<class T>
+void discardNfoDetails(T& item)
+{
+    const QString nfoContent = item.nfoContent();
+    item.clear();
+    item.setNfoContent(nfoContent);
+}
+
+} // namespace
+
 KodiXml::KodiXml(QObject* parent)
 {
     setParent(parent);
@@ -319,13 +350,18 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
+    movie->streamDetails()->clear();
 
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::MovieXmlReader reader(*movie);
-    reader.parseNfoDom(domDoc);
-
-    movie->setStreamDetailsLoaded(loadStreamDetails(movie->streamDetails(), domDoc));
+    reader.parseNfo(xml);
+    if (readToEnd(xml)) {
+        movie->setStreamDetailsLoaded(reader.hasStreamDetails());
+    } else {
+        discardNfoDetails(*movie);
+        movie->streamDetails()->clear();
+        movie->setStreamDetailsLoaded(false);
+    }
 
     // Existence of images
     if (initialNfoContent.isEmpty()) {
@@ -338,80 +374,6 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
     return true;
 }
 
-/// \brief Loads the stream details from the dom document
-/// \param streamDetails StreamDetails object
-/// \param domDoc Nfo document
-/// \return Infos loaded
-bool KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc)
-{
-    streamDetails->clear();
-    QDomNodeList elements = domDoc.elementsByTagName("streamdetails");
-    if (elements.isEmpty()) {
-        return false;
-    }
-    QDomElement elem = elements.at(0).toElement();
-    loadStreamDetails(streamDetails, elem);
-    return true;
-}
-
-void KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomElement elem)
-{
-    if (!elem.elementsByTagName("video").isEmpty()) {
-        QDomElement videoElem = elem.elementsByTagName("video").at(0).toElement();
-
-        std::array<StreamDetails::VideoDetails, 7> details{StreamDetails::VideoDetails::Codec,
-            StreamDetails::VideoDetails::Aspect,
-            StreamDetails::VideoDetails::Width,
-            StreamDetails::VideoDetails::Height,
-            StreamDetails::VideoDetails::DurationInSeconds,
-            StreamDetails::VideoDetails::ScanType,
-            StreamDetails::VideoDetails::StereoMode};
-
-        for (const auto detail : details) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList elements = videoElem.elementsByTagName(detailStr);
-            if (!elements.isEmpty()) {
-                streamDetails->setVideoDetail(detail, elements.at(0).toElement().text());
-            }
-        }
-    }
-
-    QDomNodeList audioElements = elem.elementsByTagName("audio");
-    std::array<StreamDetails::AudioDetails, 3> audioDetails{StreamDetails::AudioDetails::Codec,
-        StreamDetails::AudioDetails::Language,
-        StreamDetails::AudioDetails::Channels};
-
-    for (int i = 0, n = audioElements.count(); i < n; ++i) {
-        QDomElement audioElem = audioElements.at(i).toElement();
-
-        for (const auto detail : audioDetails) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList detailElements = audioElem.elementsByTagName(detailStr);
-
-            if (!detailElements.isEmpty()) {
-                streamDetails->setAudioDetail(i, detail, detailElements.at(0).toElement().text());
-            }
-        }
-    }
-
-    QDomNodeList subtitleElements = elem.elementsByTagName("subtitle");
-    std::array<StreamDetails::SubtitleDetails, 1> subtitleDetails{StreamDetails::SubtitleDetails::Language};
-
-    for (int i = 0, n = subtitleElements.count(); i < n; ++i) {
-        QDomElement subtitleElem = subtitleElements.at(i).toElement();
-        if (!subtitleElem.elementsByTagName("file").isEmpty()) {
-            continue;
-        }
-        for (const auto detail : subtitleDetails) {
-            const auto detailStr = StreamDetails::detailToString(detail);
-            if (!subtitleElem.elementsByTagName(detailStr).isEmpty()) {
-                streamDetails->setSubtitleDetail(
-                    i, detail, subtitleElem.elementsByTagName(detailStr).at(0).toElement().text());
-            }
-        }
-    }
-}
-
 /// \brief Writes streamdetails to xml stream
 /// \param xml XML Stream
 /// \param streamDetails Stream Details object
@@ -657,13 +619,18 @@ bool KodiXml::loadConcert(Concert* concert, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
+    concert->streamDetails()->clear();
 
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::ConcertXmlReader reader(*concert);
-    reader.parseNfoDom(domDoc);
-
-    concert->setStreamDetailsLoaded(loadStreamDetails(concert->streamDetails(), domDoc));
+    reader.parseNfo(xml);
+    if (readToEnd(xml)) {
+        concert->setStreamDetailsLoaded(reader.hasStreamDetails());
+    } else {
+        discardNfoDetails(*concert);
+        concert->streamDetails()->clear();
+        concert->setStreamDetailsLoaded(false);
+    }
 
     // Existence of images
     if (initialNfoContent.isEmpty()) {
@@ -748,11 +715,12 @@ bool KodiXml::loadTvShow(TvShow* show, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::TvShowXmlReader reader(*show);
-    reader.parseNfoDom(domDoc);
+    reader.parseNfo(xml);
+    if (!readToEnd(xml)) {
+        discardNfoDetails(*show);
+    }
 
     return true;
 }
@@ -790,47 +758,56 @@ bool KodiXml::loadTvShowEpisode(TvShowEpisode* episode, QString initialNfoConten
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(nfoContent));
+    const QString episodeXml = mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(nfoContent);
+    // The episode's own numbers, not the ones read from the NFO
+    const SeasonNumber season = episode->seasonNumber();
+    const EpisodeNumber episodeNumber = episode->episodeNumber();
+    const auto discard = [episode, season, episodeNumber]() {
+        discardNfoDetails(*episode);
+        episode->setSeason(season);
+        episode->setEpisode(episodeNumber);
+        episode->streamDetails()->clear();
+        episode->setStreamDetailsLoaded(false);
+    };
 
-    QDomNodeList episodeDetailsList = domDoc.elementsByTagName("episodedetails");
-    if (episodeDetailsList.isEmpty()) {
+    QXmlStreamReader xml(episodeXml);
+    if (!mediaelch::kodi::readNextNfoElement(xml, QLatin1String("episodedetails"))) {
+        readToEnd(xml);
         return false;
     }
+    mediaelch::kodi::EpisodeXmlReader reader(*episode);
+    reader.parseNfo(xml);
 
-    QDomElement episodeDetails;
-    if (episodeDetailsList.count() > 1) {
-        bool found = false;
-        for (int i = 0, n = episodeDetailsList.count(); i < n; ++i) {
-            episodeDetails = episodeDetailsList.at(i).toElement();
-            if (!episodeDetails.elementsByTagName("season").isEmpty()
-                && episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()
-                       == episode->seasonNumber().toInt()
-                && !episodeDetails.elementsByTagName("episode").isEmpty()
-                && episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()
-                       == episode->episodeNumber().toInt()) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            return false;
-        }
-
-    } else {
-        episodeDetails = episodeDetailsList.at(0).toElement();
+    // Multi-episode files contain one <episodedetails> element per episode.
+    const bool isMultiEpisode = mediaelch::kodi::readNextNfoElement(xml, QLatin1String("episodedetails"));
+    if (!readToEnd(xml)) {
+        discard();
+        return false;
+    }
+    if (!isMultiEpisode) {
+        episode->setStreamDetailsLoaded(reader.hasStreamDetails());
+        return true;
     }
 
-    mediaelch::kodi::EpisodeXmlReader reader(*episode);
-    reader.parseNfoDom(episodeDetails);
+    // The first element was read; only read another one if it belongs to this episode.
+    const int episodeIndex =
+        mediaelch::kodi::EpisodeXmlReader::episodeDetailsIndex(episodeXml, season, episodeNumber);
+    if (episodeIndex == 0) {
+        episode->setStreamDetailsLoaded(reader.hasStreamDetails());
+        return true;
+    }
+    discard();
+    if (episodeIndex < 0) {
+        return false;
+    }
 
-    if (episodeDetails.elementsByTagName("streamdetails").count() > 0) {
-        loadStreamDetails(
-            episode->streamDetails(), episodeDetails.elementsByTagName("streamdetails").at(0).toElement());
-        episode->setStreamDetailsLoaded(true);
-    } else {
-        episode->setStreamDetailsLoaded(false);
+    QXmlStreamReader episodeDetails(episodeXml);
+    for (int i = 0; i <= episodeIndex; ++i) {
+        mediaelch::kodi::readNextNfoElement(episodeDetails, QLatin1String("episodedetails"));
     }
+    mediaelch::kodi::EpisodeXmlReader episodeReader(*episode);
+    episodeReader.parseNfo(episodeDetails);
+    episode->setStreamDetailsLoaded(episodeReader.hasStreamDetails());
 
     return true;
 }
@@ -1226,7 +1203,7 @@ QString KodiXml::movieSetFileName(QString setName, DataFile* dataFile)
         return dir.absolutePath() + "/" + fileName;
     }
     if (Settings::instance()->movieSetArtworkType() == MovieSetArtworkType::SingleSetFolder) {
-        for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+        for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
             if (movie->set().name == setName && !movie->files().isEmpty()) {
                 QFileInfo fi(movie->files().first().toString());
                 QDir dir = fi.dir();
@@ -1455,11 +1432,12 @@ bool KodiXml::loadArtist(Artist* artist, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::ArtistXmlReader reader(*artist);
-    reader.parseNfoDom(domDoc);
+    reader.parseNfo(xml);
+    if (!readToEnd(xml)) {
+        discardNfoDetails(*artist);
+    }
 
     return true;
 }
@@ -1494,11 +1472,12 @@ bool KodiXml::loadAlbum(Album* album, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::AlbumXmlReader reader(*album);
-    reader.parseNfoDom(domDoc);
+    reader.parseNfo(xml);
+    if (!readToEnd(xml)) {
+        discardNfoDetails(*album);
+    }
 
     return true;
 }
@@ -7,7 +7,7 @@
 #include "music/Artist.h"
 
 #include <QByteArray>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <QObject>
 #include <QString>
 #include <QVector>
@@ -113,8 +113,6 @@ private:
     QByteArray getEpisodeXml(const QVector<TvShowEpisode*>& episodes);
     QByteArray getArtistXml(Artist* artist);
     QByteArray getAlbumXml(Album* album);
-    bool loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc);
-    void loadStreamDetails(StreamDetails* streamDetails, QDomElement elem);
     bool saveFile(QString filename, QByteArray data);
     mediaelch::DirectoryPath getPath(const Movie* movie);
     mediaelch::DirectoryPath getPath(const Concert* concert);
@@ -5,6 +5,8 @@
 #include "music/AllMusicId.h"
 #include "music/MusicBrainzId.h"
 
+#include <QUrl>
+
 namespace mediaelch {
 namespace kodi {
 
@@ -12,80 +14,111 @@ AlbumXmlReader::AlbumXmlReader(Album& album) : m_album{album}
 {
 }
 
-void AlbumXmlReader::parseNfoDom(QDomDocument domDoc)
+void AlbumXmlReader::parseNfo(QXmlStreamReader& xml)
 {
-    // v16 CamelCase tag
-    if (!domDoc.elementsByTagName("musicBrainzReleaseGroupID").isEmpty()) {
-        m_album.setMbReleaseGroupId(
-            MusicBrainzId(domDoc.elementsByTagName("musicBrainzReleaseGroupID").at(0).toElement().text()));
-    }
-    // v17 lowercase tag
-    if (!domDoc.elementsByTagName("musicbrainzreleasegroupid").isEmpty()) {
-        m_album.setMbReleaseGroupId(
-            MusicBrainzId(domDoc.elementsByTagName("musicbrainzreleasegroupid").at(0).toElement().text()));
-    }
+    if (xml.readNextStartElement()) {
+        // All tags are read regardless of their position in the document.
+        // clang-format off
+        static const NfoTag<AlbumXmlReader> tags[] = {
+            // v16 CamelCase tags
+            {QLatin1String("musicBrainzReleaseGroupID"), &AlbumXmlReader::firstText<&AlbumXmlReader::m_mbReleaseGroupIdV16>},
+            {QLatin1String("musicBrainzAlbumID"),        &AlbumXmlReader::firstText<&AlbumXmlReader::m_mbAlbumIdV16>},
+            // v17 lowercase tags
+            {QLatin1String("musicbrainzreleasegroupid"), &AlbumXmlReader::firstText<&AlbumXmlReader::m_mbReleaseGroupIdV17>},
+            {QLatin1String("musicbrainzalbumid"),        &AlbumXmlReader::firstText<&AlbumXmlReader::m_mbAlbumIdV17>},
+            {QLatin1String("allmusicid"),                &AlbumXmlReader::firstText<&AlbumXmlReader::m_allMusicId>},
+            {QLatin1String("title"),                     &AlbumXmlReader::firstText<&AlbumXmlReader::m_title>},
+            {QLatin1String("artist"),                    &AlbumXmlReader::firstText<&AlbumXmlReader::m_artist>},
+            {QLatin1String("genre"),                     &AlbumXmlReader::albumGenre},
+            {QLatin1String("style"),                     &AlbumXmlReader::albumStyle},
+            {QLatin1String("mood"),                      &AlbumXmlReader::albumMood},
+            {QLatin1String("review"),                    &AlbumXmlReader::firstText<&AlbumXmlReader::m_review>},
+            {QLatin1String("label"),                     &AlbumXmlReader::firstText<&AlbumXmlReader::m_label>},
+            {QLatin1String("releasedate"),               &AlbumXmlReader::firstText<&AlbumXmlReader::m_releaseDate>},
+            {QLatin1String("year"),                      &AlbumXmlReader::firstText<&AlbumXmlReader::m_year>},
+            {QLatin1String("rating"),                    &AlbumXmlReader::firstText<&AlbumXmlReader::m_rating>},
+            {QLatin1String("thumb"),                     &AlbumXmlReader::albumThumb},
+        };
+        // clang-format on
 
-    // v16 CamelCase tag
-    if (!domDoc.elementsByTagName("musicBrainzAlbumID").isEmpty()) {
-        m_album.setMbAlbumId(MusicBrainzId(domDoc.elementsByTagName("musicBrainzAlbumID").at(0).toElement().text()));
-    }
-    // v17 lowercase tag
-    if (!domDoc.elementsByTagName("musicbrainzalbumid").isEmpty()) {
-        m_album.setMbAlbumId(MusicBrainzId(domDoc.elementsByTagName("musicbrainzalbumid").at(0).toElement().text()));
+        walkNfoElement(xml, *this, tags);
+        storeDocumentValues();
     }
 
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty()) {
-        m_album.setAllMusicId(AllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text()));
+    m_album.setHasChanged(false);
+}
+
+void AlbumXmlReader::storeDocumentValues()
+{
+    // The v17 lowercase tags take precedence.
+    if (m_mbReleaseGroupIdV16.found()) {
+        m_album.setMbReleaseGroupId(MusicBrainzId(m_mbReleaseGroupIdV16.text()));
     }
-    if (!domDoc.elementsByTagName("title").isEmpty()) {
-        m_album.setTitle(domDoc.elementsByTagName("title").at(0).toElement().text());
+    if (m_mbReleaseGroupIdV17.found()) {
+        m_album.setMbReleaseGroupId(MusicBrainzId(m_mbReleaseGroupIdV17.text()));
     }
-    if (!domDoc.elementsByTagName("artist").isEmpty()) {
-        m_album.setArtist(domDoc.elementsByTagName("artist").at(0).toElement().text());
+    if (m_mbAlbumIdV16.found()) {
+        m_album.setMbAlbumId(MusicBrainzId(m_mbAlbumIdV16.text()));
     }
-    {
-        QDomNodeList genreElements = domDoc.elementsByTagName("genre");
-        QStringList genres;
-        for (int i = 0, n = genreElements.size(); i < n; i++) {
-            genres << genreElements.at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        }
-        if (!genres.isEmpty()) {
-            m_album.setGenres(genres);
-        }
+    if (m_mbAlbumIdV17.found()) {
+        m_album.setMbAlbumId(MusicBrainzId(m_mbAlbumIdV17.text()));
     }
-    for (int i = 0, n = domDoc.elementsByTagName("style").size(); i < n; i++) {
-        m_album.addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
+
+    if (m_allMusicId.found()) {
+        m_album.setAllMusicId(AllMusicId(m_allMusicId.text()));
     }
-    for (int i = 0, n = domDoc.elementsByTagName("mood").size(); i < n; i++) {
-        m_album.addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
+    if (m_title.found()) {
+        m_album.setTitle(m_title.text());
     }
-    if (!domDoc.elementsByTagName("review").isEmpty()) {
-        m_album.setReview(domDoc.elementsByTagName("review").at(0).toElement().text());
+    if (m_artist.found()) {
+        m_album.setArtist(m_artist.text());
     }
-    if (!domDoc.elementsByTagName("label").isEmpty()) {
-        m_album.setLabel(domDoc.elementsByTagName("label").at(0).toElement().text());
+    if (!m_genres.isEmpty()) {
+        m_album.setGenres(m_genres);
     }
-    if (!domDoc.elementsByTagName("releasedate").isEmpty()) {
-        m_album.setReleaseDate(domDoc.elementsByTagName("releasedate").at(0).toElement().text());
+    if (m_review.found()) {
+        m_album.setReview(m_review.text());
     }
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_album.setYear(domDoc.elementsByTagName("year").at(0).toElement().text().toInt());
+    if (m_label.found()) {
+        m_album.setLabel(m_label.text());
     }
-    if (!domDoc.elementsByTagName("rating").isEmpty()) {
-        m_album.setRating(domDoc.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toDouble());
+    if (m_releaseDate.found()) {
+        m_album.setReleaseDate(m_releaseDate.text());
     }
-    for (int i = 0, n = domDoc.elementsByTagName("thumb").size(); i < n; i++) {
-        Poster p;
-        p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-        if (!domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview").isEmpty()) {
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-        } else {
-            p.thumbUrl = p.originalUrl;
-        }
-        m_album.addImage(ImageType::AlbumThumb, p);
+    if (m_year.found()) {
+        m_album.setYear(m_year.text().toInt());
     }
+    if (m_rating.found()) {
+        m_album.setRating(QString(m_rating.text()).replace(",", ".").toDouble());
+    }
+}
 
-    m_album.setHasChanged(false);
+bool AlbumXmlReader::albumGenre(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_genres << readNfoText(xml).split(" / ", ElchSplitBehavior::SkipEmptyParts);
+    return true;
+}
+
+bool AlbumXmlReader::albumStyle(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_album.addStyle(readNfoText(xml));
+    return true;
+}
+
+bool AlbumXmlReader::albumMood(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_album.addMood(readNfoText(xml));
+    return true;
+}
+
+bool AlbumXmlReader::albumThumb(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QString preview = xml.attributes().value("preview").toString();
+    Poster p;
+    p.originalUrl = QUrl(readNfoText(xml));
+    p.thumbUrl = preview.isEmpty() ? p.originalUrl : QUrl(preview);
+    m_album.addImage(ImageType::AlbumThumb, p);
+    return true;
 }
 
 } // namespace kodi
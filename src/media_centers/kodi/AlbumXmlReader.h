@@ -1,6 +1,10 @@
 #pragma once
 
-#include <QDomElement>
+#include "media_centers/kodi/KodiXmlReader.h"
+
+#include <QString>
+#include <QStringList>
+#include <QXmlStreamReader>
 
 class Album;
 
@@ -11,10 +15,38 @@ class AlbumXmlReader
 {
 public:
     explicit AlbumXmlReader(Album& album);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Reads the album's NFO document in a single pass.
+    void parseNfo(QXmlStreamReader& xml);
 
 private:
+    template<NfoFirstText AlbumXmlReader::*member>
+    bool firstText(QXmlStreamReader& xml, const QString& /*parent*/)
+    {
+        return (this->*member).read(xml);
+    }
+
+    bool albumGenre(QXmlStreamReader& xml, const QString& parent);
+    bool albumStyle(QXmlStreamReader& xml, const QString& parent);
+    bool albumMood(QXmlStreamReader& xml, const QString& parent);
+    bool albumThumb(QXmlStreamReader& xml, const QString& parent);
+
+    void storeDocumentValues();
+
     Album& m_album;
+
+    NfoFirstText m_mbReleaseGroupIdV16;
+    NfoFirstText m_mbReleaseGroupIdV17;
+    NfoFirstText m_mbAlbumIdV16;
+    NfoFirstText m_mbAlbumIdV17;
+    NfoFirstText m_allMusicId;
+    NfoFirstText m_title;
+    NfoFirstText m_artist;
+    QStringList m_genres;
+    NfoFirstText m_review;
+    NfoFirstText m_label;
+    NfoFirstText m_releaseDate;
+    NfoFirstText m_year;
+    NfoFirstText m_rating;
 };
 
 } // namespace kodi
@@ -3,10 +3,6 @@
 #include "globals/Globals.h"
 #include "music/Artist.h"
 
-#include <QDate>
-#include <QDomElement>
-#include <QFileInfo>
-#include <QTime>
 #include <QUrl>
 
 namespace mediaelch {
@@ -16,85 +12,130 @@ ArtistXmlReader::ArtistXmlReader(Artist& artist) : m_artist{artist}
 {
 }
 
-void ArtistXmlReader::parseNfoDom(QDomDocument domDoc)
+void ArtistXmlReader::parseNfo(QXmlStreamReader& xml)
 {
-    if (!domDoc.elementsByTagName("musicBrainzArtistID").isEmpty()) {
-        m_artist.setMbId(MusicBrainzId(domDoc.elementsByTagName("musicBrainzArtistID").at(0).toElement().text()));
-    }
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty()) {
-        m_artist.setAllMusicId(AllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text()));
+    if (xml.readNextStartElement()) {
+        // All tags are read regardless of their position in the document.
+        // clang-format off
+        static const NfoTag<ArtistXmlReader> tags[] = {
+            {QLatin1String("musicBrainzArtistID"), &ArtistXmlReader::firstText<&ArtistXmlReader::m_mbId>},
+            {QLatin1String("allmusicid"),          &ArtistXmlReader::firstText<&ArtistXmlReader::m_allMusicId>},
+            {QLatin1String("name"),                &ArtistXmlReader::firstText<&ArtistXmlReader::m_name>},
+            {QLatin1String("genre"),               &ArtistXmlReader::artistGenre},
+            {QLatin1String("style"),               &ArtistXmlReader::artistStyle},
+            {QLatin1String("mood"),                &ArtistXmlReader::artistMood},
+            {QLatin1String("yearsactive"),         &ArtistXmlReader::firstText<&ArtistXmlReader::m_yearsActive>},
+            {QLatin1String("formed"),              &ArtistXmlReader::firstText<&ArtistXmlReader::m_formed>},
+            {QLatin1String("biography"),           &ArtistXmlReader::firstText<&ArtistXmlReader::m_biography>},
+            {QLatin1String("born"),                &ArtistXmlReader::firstText<&ArtistXmlReader::m_born>},
+            {QLatin1String("died"),                &ArtistXmlReader::firstText<&ArtistXmlReader::m_died>},
+            {QLatin1String("disbanded"),           &ArtistXmlReader::firstText<&ArtistXmlReader::m_disbanded>},
+            {QLatin1String("thumb"),               &ArtistXmlReader::artistThumb},
+            {QLatin1String("album"),               &ArtistXmlReader::artistAlbum},
+        };
+        // clang-format on
+
+        walkNfoElement(xml, *this, tags);
+        storeDocumentValues();
     }
-    if (!domDoc.elementsByTagName("name").isEmpty()) {
-        m_artist.setName(domDoc.elementsByTagName("name").at(0).toElement().text());
+
+    m_artist.setHasChanged(false);
+}
+
+void ArtistXmlReader::storeDocumentValues()
+{
+    if (m_mbId.found()) {
+        m_artist.setMbId(MusicBrainzId(m_mbId.text()));
     }
-    {
-        QDomNodeList genreElements = domDoc.elementsByTagName("genre");
-        QStringList genres;
-        for (int i = 0, n = genreElements.size(); i < n; i++) {
-            genres << genreElements.at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        }
-        if (!genres.isEmpty()) {
-            m_artist.setGenres(genres);
-        }
+    if (m_allMusicId.found()) {
+        m_artist.setAllMusicId(AllMusicId(m_allMusicId.text()));
     }
-    for (int i = 0, n = domDoc.elementsByTagName("style").size(); i < n; i++) {
-        m_artist.addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
+    if (m_name.found()) {
+        m_artist.setName(m_name.text());
     }
-    for (int i = 0, n = domDoc.elementsByTagName("mood").size(); i < n; i++) {
-        m_artist.addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
+    if (!m_genres.isEmpty()) {
+        m_artist.setGenres(m_genres);
     }
-    if (!domDoc.elementsByTagName("yearsactive").isEmpty()) {
-        m_artist.setYearsActive(domDoc.elementsByTagName("yearsactive").at(0).toElement().text());
+    if (m_yearsActive.found()) {
+        m_artist.setYearsActive(m_yearsActive.text());
     }
-    if (!domDoc.elementsByTagName("formed").isEmpty()) {
-        m_artist.setFormed(domDoc.elementsByTagName("formed").at(0).toElement().text());
+    if (m_formed.found()) {
+        m_artist.setFormed(m_formed.text());
     }
-    if (!domDoc.elementsByTagName("biography").isEmpty()) {
-        m_artist.setBiography(domDoc.elementsByTagName("biography").at(0).toElement().text());
+    if (m_biography.found()) {
+        m_artist.setBiography(m_biography.text());
     }
-    if (!domDoc.elementsByTagName("born").isEmpty()) {
-        m_artist.setBorn(domDoc.elementsByTagName("born").at(0).toElement().text());
+    if (m_born.found()) {
+        m_artist.setBorn(m_born.text());
     }
-    if (!domDoc.elementsByTagName("died").isEmpty()) {
-        m_artist.setDied(domDoc.elementsByTagName("died").at(0).toElement().text());
+    if (m_died.found()) {
+        m_artist.setDied(m_died.text());
     }
-    if (!domDoc.elementsByTagName("disbanded").isEmpty()) {
-        m_artist.setDisbanded(domDoc.elementsByTagName("disbanded").at(0).toElement().text());
+    if (m_disbanded.found()) {
+        m_artist.setDisbanded(m_disbanded.text());
     }
+}
 
-    QDomNodeList thumbElements = domDoc.elementsByTagName("thumb");
-    for (int i = 0, n = thumbElements.size(); i < n; i++) {
-        QString parentTag = thumbElements.at(i).parentNode().toElement().tagName();
-        QDomElement thumb = thumbElements.at(i).toElement();
+bool ArtistXmlReader::artistGenre(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_genres << readNfoText(xml).split(" / ", ElchSplitBehavior::SkipEmptyParts);
+    return true;
+}
 
-        Poster p;
-        p.originalUrl = thumb.text();
-        p.thumbUrl = thumb.attribute("preview").trimmed().isEmpty() ? p.originalUrl : thumb.attribute("preview");
-        p.aspect = thumb.attribute("aspect").trimmed();
+bool ArtistXmlReader::artistStyle(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_artist.addStyle(readNfoText(xml));
+    return true;
+}
 
-        if (parentTag == "artist") {
-            m_artist.addImage(ImageType::ArtistThumb, p);
+bool ArtistXmlReader::artistMood(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_artist.addMood(readNfoText(xml));
+    return true;
+}
 
-        } else if (parentTag == "fanart") {
-            m_artist.addImage(ImageType::ArtistFanart, p);
-        }
+bool ArtistXmlReader::artistThumb(QXmlStreamReader& xml, const QString& parent)
+{
+    ImageType imageType;
+    if (parent == "artist") {
+        imageType = ImageType::ArtistThumb;
+    } else if (parent == "fanart") {
+        imageType = ImageType::ArtistFanart;
+    } else {
+        xml.skipCurrentElement();
+        return true;
     }
 
-    QDomNodeList albumElements = domDoc.elementsByTagName("album");
-    for (int i = 0, n = albumElements.size(); i < n; i++) {
-        QDomElement album = albumElements.at(i).toElement();
+    const QXmlStreamAttributes attributes = xml.attributes();
+    const QString preview = attributes.value("preview").toString();
+    Poster p;
+    p.aspect = attributes.value("aspect").toString().trimmed();
+    p.originalUrl = readNfoText(xml);
+    p.thumbUrl = preview.trimmed().isEmpty() ? p.originalUrl : preview;
 
-        DiscographyAlbum a;
-        if (!album.elementsByTagName("title").isEmpty()) {
-            a.title = album.elementsByTagName("title").at(0).toElement().text();
+    m_artist.addImage(imageType, p);
+    return true;
+}
+
+bool ArtistXmlReader::artistAlbum(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    NfoFirstText title;
+    NfoFirstText year;
+    walkNfoElement(xml, [&xml, &title, &year](const QString& /*parent*/) {
+        if (xml.name() == QLatin1String("title")) {
+            return title.read(xml);
         }
-        if (!album.elementsByTagName("year").isEmpty()) {
-            a.year = album.elementsByTagName("year").at(0).toElement().text();
+        if (xml.name() == QLatin1String("year")) {
+            return year.read(xml);
         }
-        m_artist.addDiscographyAlbum(a);
-    }
+        return false;
+    });
 
-    m_artist.setHasChanged(false);
+    DiscographyAlbum a;
+    a.title = title.text();
+    a.year = year.text();
+    m_artist.addDiscographyAlbum(a);
+    return true;
 }
 
 } // namespace kodi
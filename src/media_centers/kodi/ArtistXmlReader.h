@@ -1,6 +1,10 @@
 #pragma once
 
-#include <QDomElement>
+#include "media_centers/kodi/KodiXmlReader.h"
+
+#include <QString>
+#include <QStringList>
+#include <QXmlStreamReader>
 
 class Artist;
 
@@ -11,10 +15,36 @@ class ArtistXmlReader
 {
 public:
     explicit ArtistXmlReader(Artist& artist);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Reads the artist's NFO document in a single pass.
+    void parseNfo(QXmlStreamReader& xml);
 
 private:
+    template<NfoFirstText ArtistXmlReader::*member>
+    bool firstText(QXmlStreamReader& xml, const QString& /*parent*/)
+    {
+        return (this->*member).read(xml);
+    }
+
+    bool artistGenre(QXmlStreamReader& xml, const QString& parent);
+    bool artistStyle(QXmlStreamReader& xml, const QString& parent);
+    bool artistMood(QXmlStreamReader& xml, const QString& parent);
+    bool artistThumb(QXmlStreamReader& xml, const QString& parent);
+    bool artistAlbum(QXmlStreamReader& xml, const QString& parent);
+
+    void storeDocumentValues();
+
     Artist& m_artist;
+
+    NfoFirstText m_mbId;
+    NfoFirstText m_allMusicId;
+    NfoFirstText m_name;
+    QStringList m_genres;
+    NfoFirstText m_yearsActive;
+    NfoFirstText m_formed;
+    NfoFirstText m_biography;
+    NfoFirstText m_born;
+    NfoFirstText m_died;
+    NfoFirstText m_disbanded;
 };
 
 } // namespace kodi
@@ -3,8 +3,6 @@
 #include "concerts/Concert.h"
 
 #include <QDate>
-#include <QDomDocument>
-#include <QDomNodeList>
 #include <QStringList>
 #include <QUrl>
 
@@ -15,153 +13,183 @@ ConcertXmlReader::ConcertXmlReader(Concert& concert) : m_concert{concert}
 {
 }
 
-void ConcertXmlReader::parseNfoDom(QDomDocument domDoc)
+void ConcertXmlReader::parseNfo(QXmlStreamReader& xml)
+{
+    if (!xml.readNextStartElement()) {
+        return;
+    }
+
+    // All tags are read regardless of their position in the document.
+    // clang-format off
+    static const NfoTag<ConcertXmlReader> tags[] = {
+        {QLatin1String("id"),            &ConcertXmlReader::firstText<&ConcertXmlReader::m_imdbIdV16>},
+        {QLatin1String("tmdbid"),        &ConcertXmlReader::firstText<&ConcertXmlReader::m_tmdbIdV16>},
+        {QLatin1String("uniqueid"),      &ConcertXmlReader::concertUniqueId},
+        {QLatin1String("title"),         &ConcertXmlReader::firstText<&ConcertXmlReader::m_title>},
+        {QLatin1String("artist"),        &ConcertXmlReader::firstText<&ConcertXmlReader::m_artist>},
+        {QLatin1String("album"),         &ConcertXmlReader::firstText<&ConcertXmlReader::m_album>},
+        {QLatin1String("ratings"),       &ConcertXmlReader::concertRatingV17},
+        {QLatin1String("rating"),        &ConcertXmlReader::concertRatingV16},
+        {QLatin1String("votes"),         &ConcertXmlReader::concertVoteCountV16},
+        {QLatin1String("userrating"),    &ConcertXmlReader::firstText<&ConcertXmlReader::m_userRating>},
+        {QLatin1String("year"),          &ConcertXmlReader::firstText<&ConcertXmlReader::m_year>},
+        {QLatin1String("plot"),          &ConcertXmlReader::firstText<&ConcertXmlReader::m_plot>},
+        {QLatin1String("tagline"),       &ConcertXmlReader::firstText<&ConcertXmlReader::m_tagline>},
+        {QLatin1String("runtime"),       &ConcertXmlReader::firstText<&ConcertXmlReader::m_runtime>},
+        {QLatin1String("mpaa"),          &ConcertXmlReader::firstText<&ConcertXmlReader::m_certification>},
+        {QLatin1String("playcount"),     &ConcertXmlReader::firstText<&ConcertXmlReader::m_playCount>},
+        {QLatin1String("lastplayed"),    &ConcertXmlReader::firstText<&ConcertXmlReader::m_lastPlayed>},
+        {QLatin1String("trailer"),       &ConcertXmlReader::firstText<&ConcertXmlReader::m_trailer>},
+        {QLatin1String("genre"),         &ConcertXmlReader::concertGenre},
+        {QLatin1String("tag"),           &ConcertXmlReader::concertTag},
+        {QLatin1String("thumb"),         &ConcertXmlReader::concertThumb},
+        {QLatin1String("streamdetails"), &ConcertXmlReader::concertStreamDetails},
+    };
+    // clang-format on
+
+    walkNfoElement(xml, *this, tags);
+    storeDocumentValues();
+}
+
+void ConcertXmlReader::storeDocumentValues()
 {
     // v16 imdbid
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_concert.setImdbId(ImdbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
+    if (m_imdbIdV16.found()) {
+        m_concert.setImdbId(ImdbId(m_imdbIdV16.text()));
     }
     // v16 tmdbid
-    if (!domDoc.elementsByTagName("tmdbid").isEmpty()) {
-        m_concert.setTmdbId(TmdbId(domDoc.elementsByTagName("tmdbid").at(0).toElement().text()));
+    if (m_tmdbIdV16.found()) {
+        m_concert.setTmdbId(TmdbId(m_tmdbIdV16.text()));
     }
     // v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
-        if (type == "imdb") {
-            m_concert.setImdbId(ImdbId(value));
-        } else if (type == "tmdb") {
-            m_concert.setTmdbId(TmdbId(value));
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        if (uniqueId.first == "imdb") {
+            m_concert.setImdbId(ImdbId(uniqueId.second));
+        } else if (uniqueId.first == "tmdb") {
+            m_concert.setTmdbId(TmdbId(uniqueId.second));
         }
     }
 
-    if (!domDoc.elementsByTagName("title").isEmpty()) {
-        m_concert.setName(domDoc.elementsByTagName("title").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("artist").isEmpty()) {
-        m_concert.setArtist(domDoc.elementsByTagName("artist").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("album").isEmpty()) {
-        m_concert.setAlbum(domDoc.elementsByTagName("album").at(0).toElement().text());
-    }
-
-    // check for new ratings syntax
-    if (!domDoc.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = domDoc.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_concert.ratings().clear();
-
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
-            }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_concert.ratings().push_back(rating);
-            m_concert.setChanged(true);
-        }
-
-    } else if (!domDoc.elementsByTagName("rating").isEmpty()) {
-        // otherwise use "old" syntax:
-        // <rating>10.0</rating>
-        // <votes>10.0</votes>
-        QString value = domDoc.elementsByTagName("rating").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            Rating rating;
-            rating.rating = value.replace(",", ".").toDouble();
-            if (!domDoc.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = domDoc.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
-            }
-            m_concert.ratings().clear();
-            m_concert.ratings().push_back(rating);
-            m_concert.setChanged(true);
-        }
+    if (m_title.found()) {
+        m_concert.setName(m_title.text());
     }
-    if (!domDoc.elementsByTagName("userrating").isEmpty()) {
-        m_concert.setUserRating(domDoc.elementsByTagName("userrating").at(0).toElement().text().toDouble());
+    if (m_artist.found()) {
+        m_concert.setArtist(m_artist.text());
     }
-
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_concert.setReleased(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
+    if (m_album.found()) {
+        m_concert.setAlbum(m_album.text());
     }
-    if (!domDoc.elementsByTagName("plot").isEmpty()) {
-        m_concert.setOverview(domDoc.elementsByTagName("plot").at(0).toElement().text());
+
+    m_ratings.store(m_concert);
+    if (m_userRating.found()) {
+        m_concert.setUserRating(m_userRating.text().toDouble());
     }
-    if (!domDoc.elementsByTagName("tagline").isEmpty()) {
-        m_concert.setTagline(domDoc.elementsByTagName("tagline").at(0).toElement().text());
+
+    if (m_year.found()) {
+        m_concert.setReleased(QDate::fromString(m_year.text(), "yyyy"));
     }
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_concert.setRuntime(
-            std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
+    if (m_plot.found()) {
+        m_concert.setOverview(m_plot.text());
     }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_concert.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
+    if (m_tagline.found()) {
+        m_concert.setTagline(m_tagline.text());
     }
-    if (!domDoc.elementsByTagName("playcount").isEmpty()) {
-        m_concert.setPlayCount(domDoc.elementsByTagName("playcount").at(0).toElement().text().toInt());
+    if (m_runtime.found()) {
+        m_concert.setRuntime(std::chrono::minutes(m_runtime.text().toInt()));
     }
-    if (!domDoc.elementsByTagName("lastplayed").isEmpty()) {
-        m_concert.setLastPlayed(QDateTime::fromString(
-            domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss"));
+    if (m_certification.found()) {
+        m_concert.setCertification(Certification(m_certification.text()));
     }
-    if (!domDoc.elementsByTagName("trailer").isEmpty()) {
-        m_concert.setTrailer(QUrl(domDoc.elementsByTagName("trailer").at(0).toElement().text()));
+    if (m_playCount.found()) {
+        m_concert.setPlayCount(m_playCount.text().toInt());
     }
-
-    for (int i = 0, n = domDoc.elementsByTagName("genre").size(); i < n; i++) {
-        const auto genres =
-            domDoc.elementsByTagName("genre").at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& genre : genres) {
-            m_concert.addGenre(genre);
-        }
+    if (m_lastPlayed.found()) {
+        m_concert.setLastPlayed(QDateTime::fromString(m_lastPlayed.text(), "yyyy-MM-dd HH:mm:ss"));
     }
-    for (int i = 0, n = domDoc.elementsByTagName("tag").size(); i < n; i++) {
-        m_concert.addTag(domDoc.elementsByTagName("tag").at(i).toElement().text());
+    if (m_trailer.found()) {
+        m_concert.setTrailer(QUrl(m_trailer.text()));
     }
+}
 
-    QDomNodeList thumbElements = domDoc.elementsByTagName("thumb");
-    for (int i = 0, n = thumbElements.size(); i < n; i++) {
-        QString parentTag = thumbElements.at(i).parentNode().toElement().tagName();
-        QDomElement thumb = thumbElements.at(i).toElement();
+bool ConcertXmlReader::concertUniqueId(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QString type = xml.attributes().value("type").toString();
+    m_uniqueIds.append({type, readNfoText(xml).trimmed()});
+    return true;
+}
+
+bool ConcertXmlReader::concertRatingV17(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    return m_ratings.readRatings(xml);
+}
 
-        Poster p;
-        p.originalUrl = thumb.text();
-        p.thumbUrl = thumb.attribute("preview").trimmed().isEmpty() ? p.originalUrl : thumb.attribute("preview");
-        p.aspect = thumb.attribute("aspect").trimmed();
+bool ConcertXmlReader::concertRatingV16(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <rating>10.0</rating>
+    return m_ratings.readRating(xml);
+}
 
-        if (parentTag == "musicvideo") {
-            m_concert.addPoster(p);
+bool ConcertXmlReader::concertVoteCountV16(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <votes>10.0</votes>
+    return m_ratings.readVotes(xml);
+}
 
-        } else if (parentTag == "fanart") {
-            m_concert.addBackdrop(p);
-        }
+bool ConcertXmlReader::concertGenre(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QStringList genres = readNfoText(xml).split(" / ", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& genre : genres) {
+        m_concert.addGenre(genre);
     }
+    return true;
+}
+
+bool ConcertXmlReader::concertTag(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_concert.addTag(readNfoText(xml));
+    return true;
+}
+
+bool ConcertXmlReader::concertThumb(QXmlStreamReader& xml, const QString& parent)
+{
+    const bool isPoster = (parent == "musicvideo");
+    const bool isBackdrop = (parent == "fanart");
+    if (!isPoster && !isBackdrop) {
+        xml.skipCurrentElement();
+        return true;
+    }
+
+    const QXmlStreamAttributes attributes = xml.attributes();
+    const QString preview = attributes.value("preview").toString();
+    Poster p;
+    p.aspect = attributes.value("aspect").toString().trimmed();
+    p.originalUrl = readNfoText(xml);
+    p.thumbUrl = preview.trimmed().isEmpty() ? p.originalUrl : preview;
+
+    if (isPoster) {
+        m_concert.addPoster(p);
+    } else {
+        m_concert.addBackdrop(p);
+    }
+    return true;
+}
+
+bool ConcertXmlReader::concertStreamDetails(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // Only the first <streamdetails> tag is used.
+    if (m_hasStreamDetails) {
+        xml.skipCurrentElement();
+    } else {
+        m_hasStreamDetails = true;
+        readNfoStreamDetails(xml, *m_concert.streamDetails());
+    }
+    return true;
 }
 
 } // namespace kodi
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <QDomDocument>
+#include "media_centers/kodi/KodiXmlReader.h"
+
+#include <QPair>
 #include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class Concert;
 
@@ -12,10 +16,48 @@ class ConcertXmlReader
 {
 public:
     explicit ConcertXmlReader(Concert& concert);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Reads the concert's NFO document in a single pass.
+    void parseNfo(QXmlStreamReader& xml);
+    /// \brief Whether the NFO contained a <streamdetails> tag.
+    bool hasStreamDetails() const { return m_hasStreamDetails; }
 
 private:
+    template<NfoFirstText ConcertXmlReader::*member>
+    bool firstText(QXmlStreamReader& xml, const QString& /*parent*/)
+    {
+        return (this->*member).read(xml);
+    }
+
+    bool concertUniqueId(QXmlStreamReader& xml, const QString& parent);
+    bool concertRatingV17(QXmlStreamReader& xml, const QString& parent);
+    bool concertRatingV16(QXmlStreamReader& xml, const QString& parent);
+    bool concertVoteCountV16(QXmlStreamReader& xml, const QString& parent);
+    bool concertGenre(QXmlStreamReader& xml, const QString& parent);
+    bool concertTag(QXmlStreamReader& xml, const QString& parent);
+    bool concertThumb(QXmlStreamReader& xml, const QString& parent);
+    bool concertStreamDetails(QXmlStreamReader& xml, const QString& parent);
+
+    void storeDocumentValues();
+
     Concert& m_concert;
+    bool m_hasStreamDetails = false;
+
+    NfoFirstText m_imdbIdV16;
+    NfoFirstText m_tmdbIdV16;
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    NfoFirstText m_title;
+    NfoFirstText m_artist;
+    NfoFirstText m_album;
+    NfoRatings m_ratings;
+    NfoFirstText m_userRating;
+    NfoFirstText m_year;
+    NfoFirstText m_plot;
+    NfoFirstText m_tagline;
+    NfoFirstText m_runtime;
+    NfoFirstText m_certification;
+    NfoFirstText m_playCount;
+    NfoFirstText m_lastPlayed;
+    NfoFirstText m_trailer;
 };
 
 } // namespace kodi
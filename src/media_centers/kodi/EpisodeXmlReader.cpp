@@ -4,7 +4,6 @@
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDate>
-#include <QDomElement>
 #include <QFileInfo>
 #include <QTime>
 #include <QUrl>
@@ -16,33 +15,64 @@ EpisodeXmlReader::EpisodeXmlReader(TvShowEpisode& episode) : m_episode{episode}
 {
 }
 
-void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
+void EpisodeXmlReader::parseNfo(QXmlStreamReader& xml)
+{
+    // All tags are read regardless of their position inside <episodedetails>.
+    // clang-format off
+    static const NfoTag<EpisodeXmlReader> tags[] = {
+        {QLatin1String("id"),             &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_id>},
+        {QLatin1String("tvdbid"),         &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_tvdbIdV16>},
+        {QLatin1String("imdbid"),         &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_imdbIdV16>},
+        {QLatin1String("uniqueid"),       &EpisodeXmlReader::episodeUniqueId},
+        {QLatin1String("title"),          &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_title>},
+        {QLatin1String("showtitle"),      &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_showTitle>},
+        {QLatin1String("season"),         &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_season>},
+        {QLatin1String("episode"),        &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_episodeNumber>},
+        {QLatin1String("displayseason"),  &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_displaySeason>},
+        {QLatin1String("displayepisode"), &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_displayEpisode>},
+        {QLatin1String("ratings"),        &EpisodeXmlReader::episodeRatingV17},
+        {QLatin1String("rating"),         &EpisodeXmlReader::episodeRatingV16},
+        {QLatin1String("votes"),          &EpisodeXmlReader::episodeVoteCountV16},
+        {QLatin1String("top250"),         &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_top250>},
+        {QLatin1String("plot"),           &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_plot>},
+        {QLatin1String("mpaa"),           &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_certification>},
+        {QLatin1String("aired"),          &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_aired>},
+        {QLatin1String("playcount"),      &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_playCount>},
+        {QLatin1String("epbookmark"),     &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_epBookmark>},
+        {QLatin1String("lastplayed"),     &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_lastPlayed>},
+        {QLatin1String("studio"),         &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_studio>},
+        {QLatin1String("thumb"),          &EpisodeXmlReader::firstText<&EpisodeXmlReader::m_thumb>},
+        {QLatin1String("tag"),            &EpisodeXmlReader::episodeTag},
+        {QLatin1String("credits"),        &EpisodeXmlReader::episodeCredits},
+        {QLatin1String("director"),       &EpisodeXmlReader::episodeDirector},
+        {QLatin1String("actor"),          &EpisodeXmlReader::episodeActor},
+        {QLatin1String("streamdetails"),  &EpisodeXmlReader::episodeStreamDetails},
+    };
+    // clang-format on
+
+    walkNfoElement(xml, *this, tags);
+    storeDocumentValues();
+}
+
+void EpisodeXmlReader::storeDocumentValues()
 {
     // v17/v18 TvDbId
-    if (!episodeDetails.elementsByTagName("id").isEmpty()) {
-        m_episode.setTvdbId(TvDbId(episodeDetails.elementsByTagName("id").at(0).toElement().text()));
+    if (m_id.found()) {
+        m_episode.setTvdbId(TvDbId(m_id.text()));
     }
 
     // v16 TvDbId/ImdbId
-    if (!episodeDetails.elementsByTagName("tvdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("tvdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setTvdbId(TvDbId(value));
-        }
+    if (m_tvdbIdV16.found() && !m_tvdbIdV16.text().isEmpty()) {
+        m_episode.setTvdbId(TvDbId(m_tvdbIdV16.text()));
     }
-    if (!episodeDetails.elementsByTagName("imdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("imdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setImdbId(ImdbId(value));
-        }
+    if (m_imdbIdV16.found() && !m_imdbIdV16.text().isEmpty()) {
+        m_episode.setImdbId(ImdbId(m_imdbIdV16.text()));
     }
 
     // v17 ids
-    auto uniqueIds = episodeDetails.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        const QString& type = uniqueId.first;
+        const QString& value = uniqueId.second;
         if (type == "imdb") {
             m_episode.setImdbId(ImdbId(value));
         } else if (type == "tvdb") {
@@ -56,160 +86,166 @@ void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
         }
     }
 
-    if (!episodeDetails.elementsByTagName("title").isEmpty()) {
-        m_episode.setTitle(episodeDetails.elementsByTagName("title").at(0).toElement().text());
+    if (m_title.found()) {
+        m_episode.setTitle(m_title.text());
     }
-    if (!episodeDetails.elementsByTagName("showtitle").isEmpty()) {
-        m_episode.setShowTitle(episodeDetails.elementsByTagName("showtitle").at(0).toElement().text());
+    if (m_showTitle.found()) {
+        m_episode.setShowTitle(m_showTitle.text());
     }
-    if (!episodeDetails.elementsByTagName("season").isEmpty()) {
-        m_episode.setSeason(SeasonNumber(episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()));
+    if (m_season.found()) {
+        m_episode.setSeason(SeasonNumber(m_season.text().toInt()));
     }
-    if (!episodeDetails.elementsByTagName("episode").isEmpty()) {
-        m_episode.setEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()));
+    if (m_episodeNumber.found()) {
+        m_episode.setEpisode(EpisodeNumber(m_episodeNumber.text().toInt()));
     }
-    if (!episodeDetails.elementsByTagName("displayseason").isEmpty()) {
-        m_episode.setDisplaySeason(
-            SeasonNumber(episodeDetails.elementsByTagName("displayseason").at(0).toElement().text().toInt()));
+    if (m_displaySeason.found()) {
+        m_episode.setDisplaySeason(SeasonNumber(m_displaySeason.text().toInt()));
     }
-    if (!episodeDetails.elementsByTagName("displayepisode").isEmpty()) {
-        m_episode.setDisplayEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("displayepisode").at(0).toElement().text().toInt()));
+    if (m_displayEpisode.found()) {
+        m_episode.setDisplayEpisode(EpisodeNumber(m_displayEpisode.text().toInt()));
     }
 
-    // check for new ratings syntax
-    if (!episodeDetails.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = episodeDetails.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_episode.ratings().clear();
-
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
-            }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_episode.ratings().push_back(rating);
-            m_episode.setChanged(true);
-        }
+    m_ratings.store(m_episode);
 
-    } else if (!episodeDetails.elementsByTagName("rating").isEmpty()) {
-        // otherwise use "old" syntax:
-        // <rating>10.0</rating>
-        // <votes>10.0</votes>
-        QString value = episodeDetails.elementsByTagName("rating").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            Rating rating;
-            rating.rating = value.replace(",", ".").toDouble();
-            if (!episodeDetails.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = episodeDetails.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
-            }
-            m_episode.ratings().clear();
-            m_episode.ratings().push_back(rating);
-            m_episode.setChanged(true);
-        }
+    if (m_top250.found()) {
+        m_episode.setTop250(m_top250.text().toInt());
     }
-
-    if (!episodeDetails.elementsByTagName("top250").isEmpty()) {
-        m_episode.setTop250(episodeDetails.elementsByTagName("top250").at(0).toElement().text().toInt());
+    if (m_plot.found()) {
+        m_episode.setOverview(m_plot.text());
     }
-    if (!episodeDetails.elementsByTagName("plot").isEmpty()) {
-        m_episode.setOverview(episodeDetails.elementsByTagName("plot").at(0).toElement().text());
+    if (m_certification.found()) {
+        m_episode.setCertification(Certification(m_certification.text()));
     }
-    if (!episodeDetails.elementsByTagName("mpaa").isEmpty()) {
-        m_episode.setCertification(Certification(episodeDetails.elementsByTagName("mpaa").at(0).toElement().text()));
+    if (m_aired.found() && !m_aired.text().isEmpty()) {
+        const QDate date = QDate::fromString(m_aired.text(), "yyyy-MM-dd");
+        if (date.isValid()) {
+            m_episode.setFirstAired(date);
+        }
+    }
+    if (m_playCount.found()) {
+        m_episode.setPlayCount(m_playCount.text().toInt());
     }
-    if (!episodeDetails.elementsByTagName("aired").isEmpty()) {
-        const QDomElement aired = episodeDetails.elementsByTagName("aired").at(0).toElement();
-        if (!aired.isNull() && !aired.text().isEmpty()) {
-            const QDate date = QDate::fromString(aired.text(), "yyyy-MM-dd");
+    if (m_epBookmark.found()) {
+        m_episode.setEpBookmark(QTime(0, 0, 0).addSecs(m_epBookmark.text().toInt()));
+    }
+    if (m_lastPlayed.found() && !m_lastPlayed.text().isEmpty()) {
+        const QDateTime dateTime = QDateTime::fromString(m_lastPlayed.text(), "yyyy-MM-dd HH:mm:ss");
+        if (dateTime.isValid()) {
+            m_episode.setLastPlayed(dateTime);
+        } else {
+            const QDateTime date = QDateTime::fromString(m_lastPlayed.text(), "yyyy-MM-dd");
             if (date.isValid()) {
-                m_episode.setFirstAired(date);
+                m_episode.setLastPlayed(date);
             }
         }
     }
-    if (!episodeDetails.elementsByTagName("playcount").isEmpty()) {
-        m_episode.setPlayCount(episodeDetails.elementsByTagName("playcount").at(0).toElement().text().toInt());
-    }
-    if (!episodeDetails.elementsByTagName("epbookmark").isEmpty()) {
-        m_episode.setEpBookmark(
-            QTime(0, 0, 0).addSecs(episodeDetails.elementsByTagName("epbookmark").at(0).toElement().text().toInt()));
-    }
-    if (!episodeDetails.elementsByTagName("lastplayed").isEmpty()) {
-        const QDomElement lastplayed = episodeDetails.elementsByTagName("lastplayed").at(0).toElement();
-        if (!lastplayed.isNull() && !lastplayed.text().isEmpty()) {
-            const QDateTime dateTime = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd HH:mm:ss");
-            if (dateTime.isValid()) {
-                m_episode.setLastPlayed(dateTime);
-            } else {
-                const QDateTime date = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd");
-                if (date.isValid()) {
-                    m_episode.setLastPlayed(date);
-                }
-            }
-        }
+    if (m_studio.found()) {
+        m_episode.setNetwork(m_studio.text());
     }
-    if (!episodeDetails.elementsByTagName("studio").isEmpty()) {
-        m_episode.setNetwork(episodeDetails.elementsByTagName("studio").at(0).toElement().text());
+    if (m_thumb.found()) {
+        m_episode.setThumbnail(QUrl(m_thumb.text()));
     }
+}
 
+bool EpisodeXmlReader::episodeUniqueId(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QString type = xml.attributes().value("type").toString();
+    m_uniqueIds.append({type, readNfoText(xml).trimmed()});
+    return true;
+}
+
+bool EpisodeXmlReader::episodeRatingV17(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    return m_ratings.readRatings(xml);
+}
+
+bool EpisodeXmlReader::episodeRatingV16(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <rating>10.0</rating>
+    return m_ratings.readRating(xml);
+}
+
+bool EpisodeXmlReader::episodeVoteCountV16(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <votes>10.0</votes>
+    return m_ratings.readVotes(xml);
+}
+
+bool EpisodeXmlReader::episodeTag(QXmlStreamReader& xml, const QString& /*parent*/)
+{
     // tags are officially not yet supported, even by Kodi 19 but scraper providers start
     // to support them
-    for (int i = 0, n = episodeDetails.elementsByTagName("tag").size(); i < n; i++) {
-        m_episode.addTag(episodeDetails.elementsByTagName("tag").at(i).toElement().text());
-    }
+    m_episode.addTag(readNfoText(xml));
+    return true;
+}
 
-    if (!episodeDetails.elementsByTagName("thumb").isEmpty()) {
-        m_episode.setThumbnail(QUrl(episodeDetails.elementsByTagName("thumb").at(0).toElement().text()));
-    }
-    for (int i = 0, n = episodeDetails.elementsByTagName("credits").size(); i < n; i++) {
-        m_episode.addWriter(episodeDetails.elementsByTagName("credits").at(i).toElement().text());
+bool EpisodeXmlReader::episodeCredits(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_episode.addWriter(readNfoText(xml));
+    return true;
+}
+
+bool EpisodeXmlReader::episodeDirector(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_episode.addDirector(readNfoText(xml));
+    return true;
+}
+
+bool EpisodeXmlReader::episodeActor(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    bool hasThumb = false;
+    Actor actor = readNfoActor(xml, true, &hasThumb);
+    // The episode's thumbnail is the first <thumb> tag in the document, even if it belongs
+    // to an actor.  This is how NFOs were always read, see QDomDocument::elementsByTagName().
+    if (hasThumb && !m_thumb.found()) {
+        m_thumb.set(actor.thumb);
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("director").size(); i < n; i++) {
-        m_episode.addDirector(episodeDetails.elementsByTagName("director").at(i).toElement().text());
+    m_episode.addActor(actor);
+    return true;
+}
+
+bool EpisodeXmlReader::episodeStreamDetails(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // Only the first <streamdetails> tag is used.
+    if (m_hasStreamDetails) {
+        xml.skipCurrentElement();
+    } else {
+        m_hasStreamDetails = true;
+        readNfoStreamDetails(xml, *m_episode.streamDetails());
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("actor").size(); i < n; i++) {
-        QDomElement actorElement = episodeDetails.elementsByTagName("actor").at(i).toElement();
-        Actor a;
-        a.imageHasChanged = false;
-        if (!actorElement.elementsByTagName("name").isEmpty()) {
-            a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("role").isEmpty()) {
-            a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-            a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("order").isEmpty()) {
-            a.order = actorElement.elementsByTagName("order").at(0).toElement().text().toInt();
+    return true;
+}
+
+int EpisodeXmlReader::episodeDetailsIndex(const QString& episodeXml, SeasonNumber season, EpisodeNumber episode)
+{
+    QXmlStreamReader xml(episodeXml);
+    int count = 0;
+    int index = -1;
+    while (readNextNfoElement(xml, QLatin1String("episodedetails"))) {
+        NfoFirstText seasonText;
+        NfoFirstText episodeText;
+        walkNfoElement(xml, [&xml, &seasonText, &episodeText](const QString& /*parent*/) {
+            if (xml.name() == QLatin1String("season")) {
+                return seasonText.read(xml);
+            }
+            if (xml.name() == QLatin1String("episode")) {
+                return episodeText.read(xml);
+            }
+            return false;
+        });
+        if (index < 0 && seasonText.found() && seasonText.text().toInt() == season.toInt() && episodeText.found()
+            && episodeText.text().toInt() == episode.toInt()) {
+            index = count;
         }
-        m_episode.addActor(a);
+        ++count;
     }
+    return count == 1 ? 0 : index;
 }
 
 QString EpisodeXmlReader::makeValidEpisodeXml(const QString& nfoContent)
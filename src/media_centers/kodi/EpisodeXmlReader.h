@@ -1,7 +1,13 @@
 #pragma once
 
-#include <QDomElement>
+#include "media_centers/kodi/KodiXmlReader.h"
+#include "tv_shows/EpisodeNumber.h"
+#include "tv_shows/SeasonNumber.h"
+
+#include <QPair>
 #include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class TvShowEpisode;
 
@@ -12,12 +18,61 @@ class EpisodeXmlReader
 {
 public:
     explicit EpisodeXmlReader(TvShowEpisode& episode);
-    void parseNfoDom(QDomElement episodeDetails);
+    /// \brief Reads the <episodedetails> element the reader is positioned at.
+    void parseNfo(QXmlStreamReader& xml);
+    /// \brief Whether the episode details contained a <streamdetails> tag.
+    bool hasStreamDetails() const { return m_hasStreamDetails; }
 
     static QString makeValidEpisodeXml(const QString& nfoContent);
 
+    /// \brief Index of the <episodedetails> element of a multi-episode NFO that belongs
+    ///        to the given episode.  Returns -1 if there is none.
+    /// \details If the NFO contains only one <episodedetails> element, it is used regardless
+    ///          of its season and episode number.
+    static int episodeDetailsIndex(const QString& episodeXml, SeasonNumber season, EpisodeNumber episode);
+
 private:
+    template<NfoFirstText EpisodeXmlReader::*member>
+    bool firstText(QXmlStreamReader& xml, const QString& /*parent*/)
+    {
+        return (this->*member).read(xml);
+    }
+
+    bool episodeUniqueId(QXmlStreamReader& xml, const QString& parent);
+    bool episodeRatingV17(QXmlStreamReader& xml, const QString& parent);
+    bool episodeRatingV16(QXmlStreamReader& xml, const QString& parent);
+    bool episodeVoteCountV16(QXmlStreamReader& xml, const QString& parent);
+    bool episodeTag(QXmlStreamReader& xml, const QString& parent);
+    bool episodeCredits(QXmlStreamReader& xml, const QString& parent);
+    bool episodeDirector(QXmlStreamReader& xml, const QString& parent);
+    bool episodeActor(QXmlStreamReader& xml, const QString& parent);
+    bool episodeStreamDetails(QXmlStreamReader& xml, const QString& parent);
+
+    void storeDocumentValues();
+
     TvShowEpisode& m_episode;
+    bool m_hasStreamDetails = false;
+
+    NfoFirstText m_id;
+    NfoFirstText m_tvdbIdV16;
+    NfoFirstText m_imdbIdV16;
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    NfoFirstText m_title;
+    NfoFirstText m_showTitle;
+    NfoFirstText m_season;
+    NfoFirstText m_episodeNumber;
+    NfoFirstText m_displaySeason;
+    NfoFirstText m_displayEpisode;
+    NfoRatings m_ratings;
+    NfoFirstText m_top250;
+    NfoFirstText m_plot;
+    NfoFirstText m_certification;
+    NfoFirstText m_aired;
+    NfoFirstText m_playCount;
+    NfoFirstText m_epBookmark;
+    NfoFirstText m_lastPlayed;
+    NfoFirstText m_studio;
+    NfoFirstText m_thumb;
 };
 
 } // namespace kodi
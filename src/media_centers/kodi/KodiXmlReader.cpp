@@ -0,0 +1,255 @@
+#include "media_centers/kodi/KodiXmlReader.h"
+
+#include "data/StreamDetails.h"
+
+#include <QTextDocument>
+#include <array>
+
+namespace mediaelch {
+namespace kodi {
+
+bool readNextNfoElement(QXmlStreamReader& xml, QLatin1String name)
+{
+    while (!xml.atEnd()) {
+        if (xml.readNext() == QXmlStreamReader::StartElement && xml.name() == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString readNfoText(QXmlStreamReader& xml)
+{
+    QString text;
+    int depth = 1;
+    while (depth > 0 && !xml.atEnd()) {
+        switch (xml.readNext()) {
+        case QXmlStreamReader::StartElement: ++depth; break;
+        case QXmlStreamReader::EndElement: --depth; break;
+        case QXmlStreamReader::Characters:
+            if (xml.isCDATA() || !xml.isWhitespace()) {
+                text.append(xml.text());
+            }
+            break;
+        default: break;
+        }
+    }
+    return text;
+}
+
+QString htmlUnescape(const QString& htmlEscaped)
+{
+    // Constructing a QTextDocument is expensive.  Only do it if the text contains
+    // entities, tags or whitespace that HTML would collapse.
+    bool needsDocument = htmlEscaped.startsWith(' ') || htmlEscaped.endsWith(' ');
+    QChar previous;
+    for (const QChar c : htmlEscaped) {
+        if (needsDocument) {
+            break;
+        }
+        const ushort u = c.unicode();
+        needsDocument = u == '&' || u == '<' || u == '\n' || u == '\r' || u == '\t' || u == 0x00A0
+                        || (u == ' ' && previous == ' ');
+        previous = c;
+    }
+    if (!needsDocument) {
+        return htmlEscaped;
+    }
+
+    QTextDocument doc;
+    doc.setHtml(htmlEscaped);
+    return doc.toPlainText();
+}
+
+Rating readNfoRating(QXmlStreamReader& xml)
+{
+    // <rating name="default" max="10" default="true">
+    //   <value>10</value>
+    //   <votes>10</votes>
+    // </rating>
+    Rating rating;
+    const QXmlStreamAttributes attributes = xml.attributes();
+    rating.source = attributes.hasAttribute("name") ? attributes.value("name").toString() : QStringLiteral("default");
+    bool ok = false;
+    const int max = attributes.value("max").toInt(&ok);
+    if (ok && max > 0) {
+        rating.maxRating = max;
+    }
+
+    bool hasValue = false;
+    bool hasVotes = false;
+    walkNfoElement(xml, [&](const QString& /*parent*/) {
+        if (!hasValue && xml.name() == QLatin1String("value")) {
+            hasValue = true;
+            rating.rating = readNfoText(xml).replace(",", ".").toDouble();
+            return true;
+        }
+        if (!hasVotes && xml.name() == QLatin1String("votes")) {
+            hasVotes = true;
+            rating.voteCount = readNfoText(xml).replace(",", "").replace(".", "").toInt();
+            return true;
+        }
+        return false;
+    });
+    return rating;
+}
+
+QVector<Rating> readNfoRatings(QXmlStreamReader& xml)
+{
+    QVector<Rating> ratings;
+    walkNfoElement(xml, [&](const QString& /*parent*/) {
+        if (xml.name() == QLatin1String("rating")) {
+            ratings.push_back(readNfoRating(xml));
+            return true;
+        }
+        return false;
+    });
+    return ratings;
+}
+
+bool NfoRatings::readRatings(QXmlStreamReader& xml)
+{
+    if (m_hasRatings) {
+        xml.skipCurrentElement();
+    } else {
+        m_hasRatings = true;
+        m_ratings = readNfoRatings(xml);
+    }
+    return true;
+}
+
+Actor readNfoActor(QXmlStreamReader& xml, bool readOrder, bool* hasThumb)
+{
+    Actor actor;
+    actor.imageHasChanged = false;
+    bool hasName = false;
+    bool hasRole = false;
+    bool thumbFound = false;
+    bool hasOrder = !readOrder;
+    walkNfoElement(xml, [&](const QString& /*parent*/) {
+        const QStringRef name = xml.name();
+        if (!hasName && name == QLatin1String("name")) {
+            hasName = true;
+            actor.name = readNfoText(xml);
+        } else if (!hasRole && name == QLatin1String("role")) {
+            hasRole = true;
+            actor.role = readNfoText(xml);
+        } else if (!thumbFound && name == QLatin1String("thumb")) {
+            thumbFound = true;
+            actor.thumb = readNfoText(xml);
+        } else if (!hasOrder && name == QLatin1String("order")) {
+            hasOrder = true;
+            actor.order = readNfoText(xml).toInt();
+        } else {
+            return false;
+        }
+        return true;
+    });
+    if (hasThumb != nullptr) {
+        *hasThumb = thumbFound;
+    }
+    return actor;
+}
+
+void readNfoStreamDetails(QXmlStreamReader& xml, StreamDetails& streamDetails)
+{
+    using VideoDetails = StreamDetails::VideoDetails;
+    using AudioDetails = StreamDetails::AudioDetails;
+    using SubtitleDetails = StreamDetails::SubtitleDetails;
+
+    static const std::array<VideoDetails, 7> videoDetails{VideoDetails::Codec,
+        VideoDetails::Aspect,
+        VideoDetails::Width,
+        VideoDetails::Height,
+        VideoDetails::DurationInSeconds,
+        VideoDetails::ScanType,
+        VideoDetails::StereoMode};
+    static const std::array<AudioDetails, 3> audioDetails{
+        AudioDetails::Codec, AudioDetails::Language, AudioDetails::Channels};
+    static const QStringList videoNames = [] {
+        QStringList names;
+        for (const VideoDetails detail : videoDetails) {
+            names << StreamDetails::detailToString(detail);
+        }
+        return names;
+    }();
+    static const QStringList audioNames = [] {
+        QStringList names;
+        for (const AudioDetails detail : audioDetails) {
+            names << StreamDetails::detailToString(detail);
+        }
+        return names;
+    }();
+    static const QString subtitleLanguageName = StreamDetails::detailToString(SubtitleDetails::Language);
+
+    bool hasVideo = false;
+    int audioIndex = 0;
+    int subtitleIndex = 0;
+
+    walkNfoElement(xml, [&](const QString& /*parent*/) {
+        const QStringRef name = xml.name();
+        if (name == QLatin1String("video")) {
+            if (hasVideo) {
+                // Only the first video stream is supported.
+                xml.skipCurrentElement();
+                return true;
+            }
+            hasVideo = true;
+            QVector<bool> found(static_cast<int>(videoDetails.size()), false);
+            walkNfoElement(xml, [&](const QString& /*parent*/) {
+                for (int i = 0; i < found.size(); ++i) {
+                    if (!found.at(i) && xml.name() == videoNames.at(i)) {
+                        found[i] = true;
+                        streamDetails.setVideoDetail(videoDetails.at(static_cast<std::size_t>(i)), readNfoText(xml));
+                        return true;
+                    }
+                }
+                return false;
+            });
+            return true;
+        }
+
+        if (name == QLatin1String("audio")) {
+            const int index = audioIndex++;
+            QVector<bool> found(static_cast<int>(audioDetails.size()), false);
+            walkNfoElement(xml, [&](const QString& /*parent*/) {
+                for (int i = 0; i < found.size(); ++i) {
+                    if (!found.at(i) && xml.name() == audioNames.at(i)) {
+                        found[i] = true;
+                        streamDetails.setAudioDetail(
+                            index, audioDetails.at(static_cast<std::size_t>(i)), readNfoText(xml));
+                        return true;
+                    }
+                }
+                return false;
+            });
+            return true;
+        }
+
+        if (name == QLatin1String("subtitle")) {
+            // External subtitles have a <file> tag and are not part of the stream details.
+            const int index = subtitleIndex++;
+            QString language;
+            bool hasLanguage = false;
+            bool isExternal = false;
+            walkNfoElement(xml, [&](const QString& /*parent*/) {
+                if (xml.name() == QLatin1String("file")) {
+                    isExternal = true;
+                } else if (!hasLanguage && xml.name() == subtitleLanguageName) {
+                    hasLanguage = true;
+                    language = readNfoText(xml);
+                    return true;
+                }
+                return false;
+            });
+            if (!isExternal && hasLanguage) {
+                streamDetails.setSubtitleDetail(index, SubtitleDetails::Language, language);
+            }
+            return true;
+        }
+        return false;
+    });
+}
+
+} // namespace kodi
+} // namespace mediaelch
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "data/Rating.h"
+#include "globals/Actor.h"
+
+#include <QLatin1String>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QXmlStreamReader>
+#include <cstddef>
+
+class StreamDetails;
+
+namespace mediaelch {
+namespace kodi {
+
+/// \brief Reads the text of the current element and all of its descendants.
+/// \details Same as QDomElement::text() of a QDomDocument: Whitespace-only text nodes are ignored.
+QString readNfoText(QXmlStreamReader& xml);
+
+/// \brief Entry of a reader's static dispatch table, see walkNfoElement().
+template<class Reader>
+struct NfoTag
+{
+    QLatin1String name;
+    /// Either consumes the element and returns true or returns false to descend into it.
+    bool (Reader::*handler)(QXmlStreamReader& xml, const QString& parent);
+};
+
+/// \brief Single-pass traversal of all descendants of the element the reader is positioned at.
+/// \details Calls the callback with the name of the parent element for each start
+///          element.  The callback either consumes the element, e.g. using readNfoText(),
+///          and returns true, or returns false to descend into it.  Descending into all
+///          other elements means that nested tags are found as well, as QDomDocument's
+///          elementsByTagName() did.  Returns once the reader is at the element's end.
+template<class Callback>
+void walkNfoElement(QXmlStreamReader& xml, Callback callback)
+{
+    QStringList parents{xml.name().toString()};
+    while (!parents.isEmpty() && !xml.atEnd()) {
+        const QXmlStreamReader::TokenType token = xml.readNext();
+        if (token == QXmlStreamReader::EndElement) {
+            parents.removeLast();
+        } else if (token == QXmlStreamReader::StartElement && !callback(parents.last())) {
+            parents.append(xml.name().toString());
+        }
+    }
+}
+
+/// \brief Returns the table entry for the given tag or nullptr if the tag is not in the table.
+template<class Reader, std::size_t N>
+const NfoTag<Reader>* findNfoTag(const NfoTag<Reader> (&tags)[N], const QStringRef& name)
+{
+    for (const NfoTag<Reader>& tag : tags) {
+        if (name == tag.name) {
+            return &tag;
+        }
+    }
+    return nullptr;
+}
+
+/// \brief Same as above, but dispatches elements using the reader's static table of tags.
+template<class Reader, std::size_t N>
+void walkNfoElement(QXmlStreamReader& xml, Reader& reader, const NfoTag<Reader> (&tags)[N])
+{
+    walkNfoElement(xml, [&xml, &reader, &tags](const QString& parent) {
+        const NfoTag<Reader>* tag = findNfoTag(tags, xml.name());
+        return tag != nullptr && (reader.*tag->handler)(xml, parent);
+    });
+}
+
+/// \brief Text of the first element with a given name.
+/// \details Used for tags that were read using elementsByTagName(name).at(0).
+class NfoFirstText
+{
+public:
+    /// \brief Consumes the current element.  Only the first element's text is stored.
+    bool read(QXmlStreamReader& xml)
+    {
+        if (m_found) {
+            xml.skipCurrentElement();
+        } else {
+            m_found = true;
+            m_text = readNfoText(xml);
+        }
+        return true;
+    }
+    /// \brief Stores the given text as if it was the first element's text.
+    void set(const QString& text)
+    {
+        m_found = true;
+        m_text = text;
+    }
+    bool found() const { return m_found; }
+    const QString& text() const { return m_text; }
+
+private:
+    QString m_text;
+    bool m_found = false;
+};
+
+/// \brief Ratings of Kodi v17 (<ratings>) and Kodi v16 (<rating> and <votes>) NFOs.
+/// \details The first <ratings> tag takes precedence over <rating> and <votes>.
+class NfoRatings
+{
+public:
+    bool readRatings(QXmlStreamReader& xml);
+    bool readRating(QXmlStreamReader& xml) { return m_rating.read(xml); }
+    bool readVotes(QXmlStreamReader& xml) { return m_votes.read(xml); }
+
+    /// \brief Replaces the item's ratings if the NFO contained any.
+    template<class T>
+    void store(T& item) const
+    {
+        if (m_hasRatings) {
+            item.ratings().clear();
+            for (const Rating& rating : m_ratings) {
+                item.ratings().push_back(rating);
+                item.setChanged(true);
+            }
+            return;
+        }
+        if (m_rating.found() && !m_rating.text().isEmpty()) {
+            Rating rating;
+            rating.rating = QString(m_rating.text()).replace(",", ".").toDouble();
+            if (m_votes.found()) {
+                rating.voteCount = QString(m_votes.text()).replace(",", "").replace(".", "").toInt();
+            }
+            item.ratings().clear();
+            item.ratings().push_back(rating);
+            item.setChanged(true);
+        }
+    }
+
+private:
+    QVector<Rating> m_ratings;
+    bool m_hasRatings = false;
+    NfoFirstText m_rating;
+    NfoFirstText m_votes;
+};
+
+/// \brief Moves the reader to the next start element with the given name.
+bool readNextNfoElement(QXmlStreamReader& xml, QLatin1String name);
+
+/// \brief Decodes HTML entities and tags.  Texts without HTML are returned as they are.
+QString htmlUnescape(const QString& htmlEscaped);
+
+/// \brief Reads a <rating> element of Kodi v17+ <ratings>.
+Rating readNfoRating(QXmlStreamReader& xml);
+/// \brief Reads all <rating> elements of a <ratings> element.
+QVector<Rating> readNfoRatings(QXmlStreamReader& xml);
+/// \brief Reads an <actor> element.  Movie NFOs ignore the <order> tag.
+/// \param hasThumb If not null, set to whether the actor has a <thumb> tag.
+Actor readNfoActor(QXmlStreamReader& xml, bool readOrder, bool* hasThumb = nullptr);
+/// \brief Reads a <streamdetails> element into the given stream details.
+void readNfoStreamDetails(QXmlStreamReader& xml, StreamDetails& streamDetails);
+
+} // namespace kodi
+} // namespace mediaelch
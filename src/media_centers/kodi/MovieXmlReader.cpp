@@ -3,149 +3,134 @@
 #include "movies/Movie.h"
 
 #include <QDate>
-#include <QDomDocument>
-#include <QDomNodeList>
 #include <QStringList>
-#include <QTextDocument>
 #include <QUrl>
 
 namespace mediaelch {
 namespace kodi {
 
-static QString htmlUnescape(const QString& htmlEscaped)
-{
-    QTextDocument doc;
-    doc.setHtml(htmlEscaped);
-    return doc.toPlainText();
-}
-
 MovieXmlReader::MovieXmlReader(Movie& movie) : m_movie{movie}
 {
 }
 
-void MovieXmlReader::parseNfoDom(QDomDocument domDoc)
+void MovieXmlReader::parseNfo(QXmlStreamReader& xml)
 {
-    if (domDoc.elementsByTagName("movie").isEmpty()) {
+    if (!readNextNfoElement(xml, QLatin1String("movie"))) {
         qWarning() << "[MovieXmlReader] No <movie> tag in the document";
         return;
     }
-    QDomElement movieElement = domDoc.elementsByTagName("movie").at(0).toElement();
-    QMap<QString, void (MovieXmlReader::*)(const QDomElement&)> tagParsers;
+
+    // Direct children of <movie>
     // clang-format off
-    tagParsers.insert("title",         &MovieXmlReader::simpleString<&Movie::setName>);
-    tagParsers.insert("originaltitle", &MovieXmlReader::simpleString<&Movie::setOriginalName>);
-    tagParsers.insert("sorttitle",     &MovieXmlReader::simpleString<&Movie::setSortTitle>);
-    tagParsers.insert("plot",          &MovieXmlReader::simpleString<&Movie::setOverview>);
-    tagParsers.insert("outline",       &MovieXmlReader::simpleString<&Movie::setOutline>);
-    tagParsers.insert("tagline",       &MovieXmlReader::simpleString<&Movie::setTagline>);
-    tagParsers.insert("set",           &MovieXmlReader::movieSet);
-    tagParsers.insert("actor",         &MovieXmlReader::movieActor);
-    tagParsers.insert("thumb",         &MovieXmlReader::movieThumbnail);
-    tagParsers.insert("fanart",        &MovieXmlReader::movieFanart);
-    tagParsers.insert("playcount",     &MovieXmlReader::simpleInt<&Movie::setPlayCount>);
-    tagParsers.insert("top250",        &MovieXmlReader::simpleInt<&Movie::setTop250>);
-    tagParsers.insert("tag",           &MovieXmlReader::simpleString<&Movie::addTag>);
-    tagParsers.insert("studio",        &MovieXmlReader::stringList<&Movie::addStudio, '/'>);
-    tagParsers.insert("genre",         &MovieXmlReader::stringList<&Movie::addGenre, '/'>);
-    tagParsers.insert("country",       &MovieXmlReader::stringList<&Movie::addCountry, '/'>);
-    tagParsers.insert("ratings",       &MovieXmlReader::movieRatingV17);
-    tagParsers.insert("rating",        &MovieXmlReader::movieRatingV16);
-    tagParsers.insert("userrating",    &MovieXmlReader::simpleDouble<&Movie::setUserRating>);
-    tagParsers.insert("votes",         &MovieXmlReader::movieVoteCountV16);
-    tagParsers.insert("dateadded",     &MovieXmlReader::simpleDateTime<&Movie::setDateAdded>);
-    tagParsers.insert("resume",        &MovieXmlReader::movieResumeTime);
+    static const NfoTag<MovieXmlReader> movieTags[] = {
+        {QLatin1String("title"),         &MovieXmlReader::simpleString<&Movie::setName>},
+        {QLatin1String("originaltitle"), &MovieXmlReader::simpleString<&Movie::setOriginalName>},
+        {QLatin1String("sorttitle"),     &MovieXmlReader::simpleString<&Movie::setSortTitle>},
+        {QLatin1String("plot"),          &MovieXmlReader::simpleString<&Movie::setOverview>},
+        {QLatin1String("outline"),       &MovieXmlReader::simpleString<&Movie::setOutline>},
+        {QLatin1String("tagline"),       &MovieXmlReader::simpleString<&Movie::setTagline>},
+        {QLatin1String("set"),           &MovieXmlReader::movieSet},
+        {QLatin1String("actor"),         &MovieXmlReader::movieActor},
+        {QLatin1String("thumb"),         &MovieXmlReader::movieThumbnail},
+        {QLatin1String("fanart"),        &MovieXmlReader::movieFanart},
+        {QLatin1String("playcount"),     &MovieXmlReader::simpleInt<&Movie::setPlayCount>},
+        {QLatin1String("top250"),        &MovieXmlReader::simpleInt<&Movie::setTop250>},
+        {QLatin1String("tag"),           &MovieXmlReader::simpleString<&Movie::addTag>},
+        {QLatin1String("studio"),        &MovieXmlReader::stringList<&Movie::addStudio, '/'>},
+        {QLatin1String("genre"),         &MovieXmlReader::stringList<&Movie::addGenre, '/'>},
+        {QLatin1String("country"),       &MovieXmlReader::stringList<&Movie::addCountry, '/'>},
+        {QLatin1String("ratings"),       &MovieXmlReader::movieRatingV17},
+        {QLatin1String("rating"),        &MovieXmlReader::movieRatingV16},
+        {QLatin1String("userrating"),    &MovieXmlReader::simpleDouble<&Movie::setUserRating>},
+        {QLatin1String("votes"),         &MovieXmlReader::movieVoteCountV16},
+        {QLatin1String("dateadded"),     &MovieXmlReader::simpleDateTime<&Movie::setDateAdded>},
+        {QLatin1String("resume"),        &MovieXmlReader::movieResumeTime},
+    };
+    // Tags that are read regardless of their position in the document
+    static const NfoTag<MovieXmlReader> documentTags[] = {
+        {QLatin1String("year"),          &MovieXmlReader::firstText<&MovieXmlReader::m_year>},
+        {QLatin1String("premiered"),     &MovieXmlReader::firstText<&MovieXmlReader::m_premiered>},
+        {QLatin1String("runtime"),       &MovieXmlReader::firstText<&MovieXmlReader::m_runtime>},
+        {QLatin1String("mpaa"),          &MovieXmlReader::firstText<&MovieXmlReader::m_certification>},
+        {QLatin1String("lastplayed"),    &MovieXmlReader::firstText<&MovieXmlReader::m_lastPlayed>},
+        {QLatin1String("id"),            &MovieXmlReader::firstText<&MovieXmlReader::m_imdbIdV16>},
+        {QLatin1String("tmdbid"),        &MovieXmlReader::firstText<&MovieXmlReader::m_tmdbIdV16>},
+        {QLatin1String("trailer"),       &MovieXmlReader::firstText<&MovieXmlReader::m_trailer>},
+        {QLatin1String("uniqueid"),      &MovieXmlReader::movieUniqueId},
+        {QLatin1String("credits"),       &MovieXmlReader::movieCredits},
+        {QLatin1String("director"),      &MovieXmlReader::movieDirector},
+        {QLatin1String("streamdetails"), &MovieXmlReader::movieStreamDetails},
+    };
     // clang-format on
 
-    QDomNodeList nodes = movieElement.childNodes();
-    for (int i = 0; i < nodes.size(); ++i) {
-        if (nodes.at(i).isElement()) {
-            QDomElement element = nodes.at(i).toElement();
-            if (tagParsers.contains(element.tagName())) {
-                // call the stored method pointer
-                (this->*tagParsers[element.tagName()])(element);
-            }
+    walkNfoElement(xml, [this, &xml](const QString& parent) {
+        const NfoTag<MovieXmlReader>* tag = nullptr;
+        if (parent == QLatin1String("movie")) {
+            tag = findNfoTag(movieTags, xml.name());
         }
-    }
+        if (tag == nullptr) {
+            tag = findNfoTag(documentTags, xml.name());
+        }
+        return tag != nullptr && (this->*tag->handler)(xml, parent);
+    });
+
+    storeDocumentValues();
+}
 
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_movie.setReleased(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
+void MovieXmlReader::storeDocumentValues()
+{
+    if (m_year.found()) {
+        m_movie.setReleased(QDate::fromString(m_year.text(), "yyyy"));
     }
     // will overwrite the release date set by <year>
-    if (!domDoc.elementsByTagName("premiered").isEmpty()) {
-        QString value = domDoc.elementsByTagName("premiered").at(0).toElement().text().trimmed();
-        QDate released = QDate::fromString(value, "yyyy-MM-dd");
+    if (m_premiered.found()) {
+        QDate released = QDate::fromString(m_premiered.text().trimmed(), "yyyy-MM-dd");
         if (released.isValid()) {
             m_movie.setReleased(released);
         }
     }
 
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_movie.setRuntime(std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
+    if (m_runtime.found()) {
+        m_movie.setRuntime(std::chrono::minutes(m_runtime.text().toInt()));
     }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_movie.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
+    if (m_certification.found()) {
+        m_movie.setCertification(Certification(m_certification.text()));
     }
-    if (!domDoc.elementsByTagName("lastplayed").isEmpty()) {
-        QDateTime lastPlayed = QDateTime::fromString(
-            domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss");
+    if (m_lastPlayed.found()) {
+        QDateTime lastPlayed = QDateTime::fromString(m_lastPlayed.text(), "yyyy-MM-dd HH:mm:ss");
         if (!lastPlayed.isValid()) {
-            lastPlayed =
-                QDateTime::fromString(domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd");
+            lastPlayed = QDateTime::fromString(m_lastPlayed.text(), "yyyy-MM-dd");
         }
         m_movie.setLastPlayed(lastPlayed);
     }
 
     // v16 imdbid
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_movie.setImdbId(ImdbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
+    if (m_imdbIdV16.found()) {
+        m_movie.setImdbId(ImdbId(m_imdbIdV16.text()));
     }
     // v16 tmdbid
-    if (!domDoc.elementsByTagName("tmdbid").isEmpty()) {
-        m_movie.setTmdbId(TmdbId(domDoc.elementsByTagName("tmdbid").at(0).toElement().text()));
+    if (m_tmdbIdV16.found()) {
+        m_movie.setTmdbId(TmdbId(m_tmdbIdV16.text()));
     }
     // >v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
-        if (type == "imdb") {
-            m_movie.setImdbId(ImdbId(value));
-        } else if (type == "tmdb") {
-            m_movie.setTmdbId(TmdbId(value));
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        if (uniqueId.first == "imdb") {
+            m_movie.setImdbId(ImdbId(uniqueId.second));
+        } else if (uniqueId.first == "tmdb") {
+            m_movie.setTmdbId(TmdbId(uniqueId.second));
         }
     }
 
-    if (!domDoc.elementsByTagName("trailer").isEmpty()) {
-        m_movie.setTrailer(QUrl(domDoc.elementsByTagName("trailer").at(0).toElement().text()));
+    if (m_trailer.found()) {
+        m_movie.setTrailer(QUrl(m_trailer.text()));
     }
 
-    QStringList writers;
-    for (int i = 0, n = domDoc.elementsByTagName("credits").size(); i < n; i++) {
-        const auto credits =
-            domDoc.elementsByTagName("credits").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& writer : credits) {
-            writers.append(writer.trimmed());
-        }
-    }
-    m_movie.setWriter(writers.join(", "));
-
-    QStringList directors;
-    for (int i = 0, n = domDoc.elementsByTagName("director").size(); i < n; i++) {
-        const auto directorsFound =
-            domDoc.elementsByTagName("director").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& director : directorsFound) {
-            directors.append(director.trimmed());
-        }
-    }
-    m_movie.setDirector(directors.join(", "));
+    m_movie.setWriter(m_writers.join(", "));
+    m_movie.setDirector(m_directors.join(", "));
 }
 
-void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
+bool MovieXmlReader::movieSet(QXmlStreamReader& xml, const QString& /*parent*/)
 {
-    const QDomNodeList setNameElements = movieSetElement.elementsByTagName("name");
-    const QDomNodeList setOverviewElements = movieSetElement.elementsByTagName("overview");
-
     // We need to support both the old and new XML syntax.
     //
     // New Kodi v17 XML Syntax:
@@ -157,61 +142,82 @@ void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
     // Old Syntax:
     //   <set>Movie Set Name</set>
     //
-    MovieSet set;
-    if (!setNameElements.isEmpty()) {
-        set.name = setNameElements.at(0).toElement().text();
-    } else {
-        set.name = movieSetElement.text();
+    // The old syntax uses the text of the whole element, so the element's
+    // text is collected while looking for <name> and <overview>.
+    QString text;
+    NfoFirstText name;
+    NfoFirstText overview;
+    int depth = 1;
+    while (depth > 0 && !xml.atEnd()) {
+        switch (xml.readNext()) {
+        case QXmlStreamReader::StartElement:
+            if (!name.found() && xml.name() == QLatin1String("name")) {
+                name.read(xml);
+                text.append(name.text());
+            } else if (!overview.found() && xml.name() == QLatin1String("overview")) {
+                overview.read(xml);
+                text.append(overview.text());
+            } else {
+                ++depth;
+            }
+            break;
+        case QXmlStreamReader::EndElement: --depth; break;
+        case QXmlStreamReader::Characters:
+            if (xml.isCDATA() || !xml.isWhitespace()) {
+                text.append(xml.text());
+            }
+            break;
+        default: break;
+        }
     }
-    if (!setOverviewElements.isEmpty()) {
-        set.overview = htmlUnescape(setOverviewElements.at(0).toElement().text());
+
+    MovieSet set;
+    set.name = name.found() ? name.text() : text;
+    if (overview.found()) {
+        set.overview = htmlUnescape(overview.text());
     }
     m_movie.setSet(set);
+    return true;
 }
 
-void MovieXmlReader::movieActor(const QDomElement& actorElement)
+bool MovieXmlReader::movieActor(QXmlStreamReader& xml, const QString& /*parent*/)
 {
-    Actor a;
-    a.imageHasChanged = false;
-    if (!actorElement.elementsByTagName("name").isEmpty()) {
-        a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("role").isEmpty()) {
-        a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-        a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
-    }
-    m_movie.addActor(a);
+    m_movie.addActor(readNfoActor(xml, false));
+    return true;
 }
 
-void MovieXmlReader::movieThumbnail(const QDomElement& thumbElement)
+bool MovieXmlReader::movieThumbnail(QXmlStreamReader& xml, const QString& /*parent*/)
 {
-    QString aspect = thumbElement.attribute("aspect").trimmed();
+    const QXmlStreamAttributes attributes = xml.attributes();
+    QString aspect = attributes.value("aspect").toString().trimmed();
     // if (aspect == "set.poster") {
     //     // TODO: special handling of set-posters, etc.
     // }
 
     Poster p;
-    p.originalUrl = QUrl(thumbElement.text());
-    p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+    p.thumbUrl = QUrl(attributes.value("preview").toString());
     p.aspect = aspect;
+    p.originalUrl = QUrl(readNfoText(xml));
     m_movie.images().addPoster(p);
+    return true;
 }
 
-void MovieXmlReader::movieFanart(const QDomElement& fanartElement)
+bool MovieXmlReader::movieFanart(QXmlStreamReader& xml, const QString& /*parent*/)
 {
-    QDomNodeList thumbs = fanartElement.elementsByTagName("thumb");
-    for (int i = 0; i < thumbs.size(); ++i) {
-        QDomElement thumbElement = thumbs.at(i).toElement();
+    walkNfoElement(xml, [this, &xml](const QString& /*parent*/) {
+        if (xml.name() != QLatin1String("thumb")) {
+            return false;
+        }
         Poster p;
-        p.originalUrl = QUrl(thumbElement.text());
-        p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+        p.thumbUrl = QUrl(xml.attributes().value("preview").toString());
+        p.originalUrl = QUrl(readNfoText(xml));
         m_movie.images().addBackdrop(p);
-    }
+        return true;
+    });
+    return true;
 }
 
-void MovieXmlReader::movieRatingV17(const QDomElement& element)
+bool MovieXmlReader::movieRatingV17(QXmlStreamReader& xml, const QString& /*parent*/)
 {
     // <ratings>
     //   <rating name="default" default="true">
@@ -219,35 +225,25 @@ void MovieXmlReader::movieRatingV17(const QDomElement& element)
     //     <votes>10</votes>
     //   </rating>
     // </ratings>
-    auto ratings = element.elementsByTagName("rating");
+    const QVector<Rating> ratings = readNfoRatings(xml);
 
     // clear all ratings in case that there are <rating> tags to avoid
     // duplicated and/or old ratings
-    if (ratings.length() > 0) {
+    if (!ratings.isEmpty()) {
         m_movie.ratings().clear();
     }
 
-    for (int i = 0; i < ratings.length(); ++i) {
-        Rating rating;
-        auto ratingElement = ratings.at(i).toElement();
-        rating.source = ratingElement.attribute("name", "default");
-        bool ok = false;
-        int max = ratingElement.attribute("max", "0").toInt(&ok);
-        if (ok && max > 0) {
-            rating.maxRating = max;
-        }
-        rating.rating = ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-        rating.voteCount =
-            ratingElement.elementsByTagName("votes").at(0).toElement().text().replace(",", "").replace(".", "").toInt();
+    for (const Rating& rating : ratings) {
         m_movie.ratings().push_back(rating);
         m_movie.setChanged(true);
     }
+    return true;
 }
 
-void MovieXmlReader::movieRatingV16(const QDomElement& element)
+bool MovieXmlReader::movieRatingV16(QXmlStreamReader& xml, const QString& /*parent*/)
 {
     // <rating>10.0</rating>
-    QString value = element.text();
+    QString value = readNfoText(xml);
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().push_back(Rating{});
@@ -255,12 +251,13 @@ void MovieXmlReader::movieRatingV16(const QDomElement& element)
         m_movie.ratings().first().rating = value.replace(",", ".").toDouble();
         m_movie.setChanged(true);
     }
+    return true;
 }
 
-void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
+bool MovieXmlReader::movieVoteCountV16(QXmlStreamReader& xml, const QString& /*parent*/)
 {
     // <votes>100</votes>
-    QString value = element.text();
+    QString value = readNfoText(xml);
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().push_back(Rating{});
@@ -268,32 +265,80 @@ void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
         m_movie.ratings().first().voteCount = value.replace(",", ".").replace(".", "").toInt();
         m_movie.setChanged(true);
     }
+    return true;
 }
 
-void MovieXmlReader::movieResumeTime(const QDomElement& element)
+bool MovieXmlReader::movieResumeTime(QXmlStreamReader& xml, const QString& /*parent*/)
 {
-    auto positions = element.elementsByTagName("position");
-    auto totals = element.elementsByTagName("total");
+    NfoFirstText position;
+    NfoFirstText total;
+    walkNfoElement(xml, [&xml, &position, &total](const QString& /*parent*/) {
+        if (xml.name() == QLatin1String("position")) {
+            return position.read(xml);
+        }
+        if (xml.name() == QLatin1String("total")) {
+            return total.read(xml);
+        }
+        return false;
+    });
 
     mediaelch::ResumeTime time;
 
-    if (!positions.isEmpty()) {
+    if (position.found()) {
         bool ok = false;
-        const double position = positions.at(0).toElement().text().replace(",", ".").toDouble(&ok);
+        const double value = QString(position.text()).replace(",", ".").toDouble(&ok);
         if (ok) {
-            time.position = position;
+            time.position = value;
         }
     }
 
-    if (!totals.isEmpty()) {
+    if (total.found()) {
         bool ok = false;
-        const double total = totals.at(0).toElement().text().replace(",", ".").toDouble(&ok);
+        const double value = QString(total.text()).replace(",", ".").toDouble(&ok);
         if (ok) {
-            time.total = total;
+            time.total = value;
         }
     }
 
     m_movie.setResumeTime(time);
+    return true;
+}
+
+bool MovieXmlReader::movieUniqueId(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QString type = xml.attributes().value("type").toString();
+    m_uniqueIds.append({type, readNfoText(xml).trimmed()});
+    return true;
+}
+
+bool MovieXmlReader::movieCredits(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QStringList credits = readNfoText(xml).split(",", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& writer : credits) {
+        m_writers.append(writer.trimmed());
+    }
+    return true;
+}
+
+bool MovieXmlReader::movieDirector(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QStringList directorsFound = readNfoText(xml).split(",", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& director : directorsFound) {
+        m_directors.append(director.trimmed());
+    }
+    return true;
+}
+
+bool MovieXmlReader::movieStreamDetails(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // Only the first <streamdetails> tag is used.
+    if (m_hasStreamDetails) {
+        xml.skipCurrentElement();
+    } else {
+        m_hasStreamDetails = true;
+        readNfoStreamDetails(xml, *m_movie.streamDetails());
+    }
+    return true;
 }
 
 } // namespace kodi
@@ -1,10 +1,11 @@
 #pragma once
 
 #include "globals/Globals.h"
+#include "media_centers/kodi/KodiXmlReader.h"
 
 #include <QDate>
-#include <QDomDocument>
 #include <QString>
+#include <QXmlStreamReader>
 
 class Movie;
 
@@ -15,59 +16,94 @@ class MovieXmlReader
 {
 public:
     explicit MovieXmlReader(Movie& movie);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Reads the first <movie> element of the reader's document in a single pass.
+    void parseNfo(QXmlStreamReader& xml);
+    /// \brief Whether the NFO contained a <streamdetails> tag.
+    bool hasStreamDetails() const { return m_hasStreamDetails; }
 
 private:
     template<class T>
     using MovieStoreMethod = void (Movie::*)(T);
 
     template<MovieStoreMethod<QString> method>
-    void simpleString(const QDomElement& element)
+    bool simpleString(QXmlStreamReader& xml, const QString& /*parent*/)
     {
-        const QString value = element.text();
+        const QString value = readNfoText(xml);
         (m_movie.*method)(value);
+        return true;
     }
 
     template<MovieStoreMethod<QString> method, const char splitChar>
-    void stringList(const QDomElement& element)
+    bool stringList(QXmlStreamReader& xml, const QString& /*parent*/)
     {
-        QStringList values = element.text().split(splitChar, ElchSplitBehavior::SkipEmptyParts);
+        QStringList values = readNfoText(xml).split(splitChar, ElchSplitBehavior::SkipEmptyParts);
         for (const QString& value : asConst(values)) {
             (m_movie.*method)(value.trimmed());
         }
+        return true;
     }
 
     template<MovieStoreMethod<int> method>
-    void simpleInt(const QDomElement& element)
+    bool simpleInt(QXmlStreamReader& xml, const QString& /*parent*/)
     {
-        (m_movie.*method)(element.text().toInt());
+        (m_movie.*method)(readNfoText(xml).toInt());
+        return true;
     }
 
     template<MovieStoreMethod<double> method>
-    void simpleDouble(const QDomElement& element)
+    bool simpleDouble(QXmlStreamReader& xml, const QString& /*parent*/)
     {
-        (m_movie.*method)(element.text().toDouble());
+        (m_movie.*method)(readNfoText(xml).toDouble());
+        return true;
     }
 
     template<MovieStoreMethod<QDateTime> method>
-    void simpleDateTime(const QDomElement& element)
+    bool simpleDateTime(QXmlStreamReader& xml, const QString& /*parent*/)
     {
-        const QDateTime value = QDateTime::fromString(element.text(), "yyyy-MM-dd HH:mm:ss");
+        const QDateTime value = QDateTime::fromString(readNfoText(xml), "yyyy-MM-dd HH:mm:ss");
         if (value.isValid()) {
             (m_movie.*method)(value);
         }
+        return true;
     }
 
-    void movieSet(const QDomElement& element);
-    void movieActor(const QDomElement& element);
-    void movieThumbnail(const QDomElement& element);
-    void movieFanart(const QDomElement& element);
-    void movieRatingV17(const QDomElement& element);
-    void movieRatingV16(const QDomElement& element);
-    void movieVoteCountV16(const QDomElement& element);
-    void movieResumeTime(const QDomElement& element);
+    template<NfoFirstText MovieXmlReader::*member>
+    bool firstText(QXmlStreamReader& xml, const QString& /*parent*/)
+    {
+        return (this->*member).read(xml);
+    }
+
+    bool movieSet(QXmlStreamReader& xml, const QString& parent);
+    bool movieActor(QXmlStreamReader& xml, const QString& parent);
+    bool movieThumbnail(QXmlStreamReader& xml, const QString& parent);
+    bool movieFanart(QXmlStreamReader& xml, const QString& parent);
+    bool movieRatingV17(QXmlStreamReader& xml, const QString& parent);
+    bool movieRatingV16(QXmlStreamReader& xml, const QString& parent);
+    bool movieVoteCountV16(QXmlStreamReader& xml, const QString& parent);
+    bool movieResumeTime(QXmlStreamReader& xml, const QString& parent);
+    bool movieUniqueId(QXmlStreamReader& xml, const QString& parent);
+    bool movieCredits(QXmlStreamReader& xml, const QString& parent);
+    bool movieDirector(QXmlStreamReader& xml, const QString& parent);
+    bool movieStreamDetails(QXmlStreamReader& xml, const QString& parent);
+
+    /// \brief Stores all values that are only set once the whole document has been read.
+    void storeDocumentValues();
 
     Movie& m_movie;
+    bool m_hasStreamDetails = false;
+
+    // Tags that may appear anywhere in the document.  The first one wins.
+    NfoFirstText m_year;
+    NfoFirstText m_premiered;
+    NfoFirstText m_runtime;
+    NfoFirstText m_certification;
+    NfoFirstText m_lastPlayed;
+    NfoFirstText m_imdbIdV16;
+    NfoFirstText m_tmdbIdV16;
+    NfoFirstText m_trailer;
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    QStringList m_writers;
+    QStringList m_directors;
 };
 
 } // namespace kodi
@@ -5,7 +5,6 @@
 
 #include <QDate>
 #include <QDateTime>
-#include <QDomDocument>
 #include <QFileInfo>
 #include <QUrl>
 
@@ -16,31 +15,68 @@ TvShowXmlReader::TvShowXmlReader(TvShow& tvShow) : m_show{tvShow}
 {
 }
 
-void TvShowXmlReader::parseNfoDom(QDomDocument domDoc)
+void TvShowXmlReader::parseNfo(QXmlStreamReader& xml)
+{
+    if (xml.readNextStartElement()) {
+        // All tags are read regardless of their position in the document.
+        // clang-format off
+        static const NfoTag<TvShowXmlReader> tags[] = {
+            {QLatin1String("id"),            &TvShowXmlReader::firstText<&TvShowXmlReader::m_id>},
+            {QLatin1String("tvdbid"),        &TvShowXmlReader::firstText<&TvShowXmlReader::m_tvdbIdV16>},
+            {QLatin1String("imdbid"),        &TvShowXmlReader::firstText<&TvShowXmlReader::m_imdbIdV16>},
+            {QLatin1String("uniqueid"),      &TvShowXmlReader::showUniqueId},
+            {QLatin1String("title"),         &TvShowXmlReader::firstText<&TvShowXmlReader::m_title>},
+            {QLatin1String("sorttitle"),     &TvShowXmlReader::firstText<&TvShowXmlReader::m_sortTitle>},
+            {QLatin1String("originaltitle"), &TvShowXmlReader::firstText<&TvShowXmlReader::m_originalTitle>},
+            {QLatin1String("showtitle"),     &TvShowXmlReader::firstText<&TvShowXmlReader::m_showTitle>},
+            {QLatin1String("namedseason"),   &TvShowXmlReader::showNamedSeason},
+            {QLatin1String("ratings"),       &TvShowXmlReader::showRatingV17},
+            {QLatin1String("rating"),        &TvShowXmlReader::showRatingV16},
+            {QLatin1String("votes"),         &TvShowXmlReader::showVoteCountV16},
+            {QLatin1String("userrating"),    &TvShowXmlReader::firstText<&TvShowXmlReader::m_userRating>},
+            {QLatin1String("top250"),        &TvShowXmlReader::firstText<&TvShowXmlReader::m_top250>},
+            {QLatin1String("plot"),          &TvShowXmlReader::firstText<&TvShowXmlReader::m_plot>},
+            {QLatin1String("mpaa"),          &TvShowXmlReader::firstText<&TvShowXmlReader::m_certification>},
+            {QLatin1String("year"),          &TvShowXmlReader::firstText<&TvShowXmlReader::m_year>},
+            {QLatin1String("premiered"),     &TvShowXmlReader::firstText<&TvShowXmlReader::m_premiered>},
+            {QLatin1String("dateadded"),     &TvShowXmlReader::firstText<&TvShowXmlReader::m_dateAdded>},
+            {QLatin1String("studio"),        &TvShowXmlReader::firstText<&TvShowXmlReader::m_studio>},
+            {QLatin1String("episodeguide"),  &TvShowXmlReader::showEpisodeGuide},
+            {QLatin1String("runtime"),       &TvShowXmlReader::firstText<&TvShowXmlReader::m_runtime>},
+            {QLatin1String("status"),        &TvShowXmlReader::firstText<&TvShowXmlReader::m_status>},
+            {QLatin1String("genre"),         &TvShowXmlReader::showGenre},
+            {QLatin1String("tag"),           &TvShowXmlReader::showTag},
+            {QLatin1String("actor"),         &TvShowXmlReader::showActor},
+            {QLatin1String("thumb"),         &TvShowXmlReader::showThumb},
+            {QLatin1String("fanart"),        &TvShowXmlReader::showFanart},
+        };
+        // clang-format on
+
+        walkNfoElement(xml, *this, tags);
+        storeDocumentValues();
+    }
+
+    QFileInfo fi(m_show.dir().filePath("theme.mp3"));
+    m_show.setHasTune(fi.isFile());
+}
+
+void TvShowXmlReader::storeDocumentValues()
 {
     // v17/v18 TvDbId
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_show.setTvdbId(TvDbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
+    if (m_id.found()) {
+        m_show.setTvdbId(TvDbId(m_id.text()));
     }
     // v16 TvDbId/ImdbId
-    if (!domDoc.elementsByTagName("tvdbid").isEmpty()) {
-        QString value = domDoc.elementsByTagName("tvdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_show.setTvdbId(TvDbId(value));
-        }
+    if (m_tvdbIdV16.found() && !m_tvdbIdV16.text().isEmpty()) {
+        m_show.setTvdbId(TvDbId(m_tvdbIdV16.text()));
     }
-    if (!domDoc.elementsByTagName("imdbid").isEmpty()) {
-        QString value = domDoc.elementsByTagName("imdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_show.setImdbId(ImdbId(value));
-        }
+    if (m_imdbIdV16.found() && !m_imdbIdV16.text().isEmpty()) {
+        m_show.setImdbId(ImdbId(m_imdbIdV16.text()));
     }
     // v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        const QString& type = uniqueId.first;
+        const QString& value = uniqueId.second;
         if (type == "imdb") {
             m_show.setImdbId(ImdbId(value));
         } else if (type == "tvdb") {
@@ -53,187 +89,155 @@ void TvShowXmlReader::parseNfoDom(QDomDocument domDoc)
             qWarning() << "[TvShowXmlReader] Unsupported unique id type:" << type;
         }
     }
-    if (!domDoc.elementsByTagName("title").isEmpty()) {
-        m_show.setTitle(domDoc.elementsByTagName("title").at(0).toElement().text());
+    if (m_title.found()) {
+        m_show.setTitle(m_title.text());
     }
-    if (!domDoc.elementsByTagName("sorttitle").isEmpty()) {
-        m_show.setSortTitle(domDoc.elementsByTagName("sorttitle").at(0).toElement().text());
+    if (m_sortTitle.found()) {
+        m_show.setSortTitle(m_sortTitle.text());
     }
     // since v17
-    if (!domDoc.elementsByTagName("originaltitle").isEmpty()) {
-        m_show.setOriginalTitle(domDoc.elementsByTagName("originaltitle").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("showtitle").isEmpty()) {
-        m_show.setShowTitle(domDoc.elementsByTagName("showtitle").at(0).toElement().text());
-    }
-    QDomNodeList namedSeasons = domDoc.elementsByTagName("namedseason");
-    for (int i = 0; i < namedSeasons.size(); ++i) {
-        QDomElement seasonElement = namedSeasons.at(i).toElement();
-        SeasonNumber season(seasonElement.attribute("number", SeasonNumber::NoSeason.toString()).toInt());
-        QString name = seasonElement.text();
-        if (season != SeasonNumber::NoSeason) {
-            m_show.setSeasonName(season, name);
-        }
+    if (m_originalTitle.found()) {
+        m_show.setOriginalTitle(m_originalTitle.text());
     }
-    // check for new ratings syntax
-    if (!domDoc.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = domDoc.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_show.ratings().clear();
-
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
-            }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_show.ratings().push_back(rating);
-            m_show.setChanged(true);
-        }
-
-    } else if (!domDoc.elementsByTagName("rating").isEmpty()) {
-        // otherwise use "old" syntax:
-        // <rating>10.0</rating>
-        // <votes>10.0</votes>
-        QString value = domDoc.elementsByTagName("rating").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            Rating rating;
-            rating.rating = value.replace(",", ".").toDouble();
-            if (!domDoc.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = domDoc.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
-            }
-            m_show.ratings().clear();
-            m_show.ratings().push_back(rating);
-            m_show.setChanged(true);
-        }
+    if (m_showTitle.found()) {
+        m_show.setShowTitle(m_showTitle.text());
     }
-    if (!domDoc.elementsByTagName("userrating").isEmpty()) {
-        m_show.setUserRating(domDoc.elementsByTagName("userrating").at(0).toElement().text().toDouble());
+    m_ratings.store(m_show);
+    if (m_userRating.found()) {
+        m_show.setUserRating(m_userRating.text().toDouble());
     }
-    if (!domDoc.elementsByTagName("top250").isEmpty()) {
-        m_show.setTop250(domDoc.elementsByTagName("top250").at(0).toElement().text().toInt());
+    if (m_top250.found()) {
+        m_show.setTop250(m_top250.text().toInt());
     }
-    if (!domDoc.elementsByTagName("plot").isEmpty()) {
-        m_show.setOverview(domDoc.elementsByTagName("plot").at(0).toElement().text());
+    if (m_plot.found()) {
+        m_show.setOverview(m_plot.text());
     }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_show.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
+    if (m_certification.found()) {
+        m_show.setCertification(Certification(m_certification.text()));
     }
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_show.setFirstAired(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
+    if (m_year.found()) {
+        m_show.setFirstAired(QDate::fromString(m_year.text(), "yyyy"));
     }
     // will override the first-aired date set by <year>
-    if (!domDoc.elementsByTagName("premiered").isEmpty()) {
-        QString value = domDoc.elementsByTagName("premiered").at(0).toElement().text().trimmed();
-        QDate released = QDate::fromString(value, "yyyy-MM-dd");
+    if (m_premiered.found()) {
+        QDate released = QDate::fromString(m_premiered.text().trimmed(), "yyyy-MM-dd");
         if (released.isValid()) {
             m_show.setFirstAired(released);
         }
     }
-    if (!domDoc.elementsByTagName("dateadded").isEmpty()) {
-        m_show.setDateAdded(QDateTime::fromString(
-            domDoc.elementsByTagName("dateadded").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss"));
+    if (m_dateAdded.found()) {
+        m_show.setDateAdded(QDateTime::fromString(m_dateAdded.text(), "yyyy-MM-dd HH:mm:ss"));
     }
-    if (!domDoc.elementsByTagName("studio").isEmpty()) {
-        m_show.setNetwork(domDoc.elementsByTagName("studio").at(0).toElement().text());
+    if (m_studio.found()) {
+        m_show.setNetwork(m_studio.text());
     }
-    if (!domDoc.elementsByTagName("episodeguide").isEmpty()
-        && !domDoc.elementsByTagName("episodeguide").at(0).toElement().elementsByTagName("url").isEmpty()) {
-        m_show.setEpisodeGuideUrl(domDoc.elementsByTagName("episodeguide")
-                                      .at(0)
-                                      .toElement()
-                                      .elementsByTagName("url")
-                                      .at(0)
-                                      .toElement()
-                                      .text());
+    if (m_episodeGuideUrl.found()) {
+        m_show.setEpisodeGuideUrl(m_episodeGuideUrl.text());
     }
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_show.setRuntime(std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
+    if (m_runtime.found()) {
+        m_show.setRuntime(std::chrono::minutes(m_runtime.text().toInt()));
     }
-    if (!domDoc.elementsByTagName("status").isEmpty()) {
-        m_show.setStatus(domDoc.elementsByTagName("status").at(0).toElement().text());
+    if (m_status.found()) {
+        m_show.setStatus(m_status.text());
     }
+}
 
-    for (int i = 0, n = domDoc.elementsByTagName("genre").size(); i < n; i++) {
-        const auto genres =
-            domDoc.elementsByTagName("genre").at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& genre : genres) {
-            m_show.addGenre(genre);
-        }
-    }
-    for (int i = 0, n = domDoc.elementsByTagName("tag").size(); i < n; i++) {
-        m_show.addTag(domDoc.elementsByTagName("tag").at(i).toElement().text());
-    }
-    for (int i = 0, n = domDoc.elementsByTagName("actor").size(); i < n; i++) {
-        QDomElement actorElement = domDoc.elementsByTagName("actor").at(i).toElement();
-        Actor a;
-        a.imageHasChanged = false;
-        if (!actorElement.elementsByTagName("name").isEmpty()) {
-            a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("role").isEmpty()) {
-            a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-            a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("order").isEmpty()) {
-            a.order = actorElement.elementsByTagName("order").at(0).toElement().text().toInt();
-        }
-        m_show.addActor(a);
+bool TvShowXmlReader::showUniqueId(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QString type = xml.attributes().value("type").toString();
+    m_uniqueIds.append({type, readNfoText(xml).trimmed()});
+    return true;
+}
+
+bool TvShowXmlReader::showNamedSeason(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QXmlStreamAttributes attributes = xml.attributes();
+    SeasonNumber season(attributes.hasAttribute("number") ? attributes.value("number").toInt()
+                                                          : SeasonNumber::NoSeason.toInt());
+    QString name = readNfoText(xml);
+    if (season != SeasonNumber::NoSeason) {
+        m_show.setSeasonName(season, name);
     }
-    for (int i = 0, n = domDoc.elementsByTagName("thumb").size(); i < n; i++) {
-        QString parentTag = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().tagName();
-        QDomElement thumbElement = domDoc.elementsByTagName("thumb").at(i).toElement();
+    return true;
+}
 
-        if (parentTag == "tvshow") {
-            showThumb(thumbElement);
+bool TvShowXmlReader::showRatingV17(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    return m_ratings.readRatings(xml);
+}
 
-        } else if (parentTag == "fanart") {
-            QString url = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().attribute("url");
-            showFanartThumb(thumbElement, url);
-        }
+bool TvShowXmlReader::showRatingV16(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <rating>10.0</rating>
+    return m_ratings.readRating(xml);
+}
+
+bool TvShowXmlReader::showVoteCountV16(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <votes>10.0</votes>
+    return m_ratings.readVotes(xml);
+}
+
+bool TvShowXmlReader::showEpisodeGuide(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // Only the first <url> of the first <episodeguide> is used.
+    if (m_hasEpisodeGuide) {
+        xml.skipCurrentElement();
+        return true;
     }
+    m_hasEpisodeGuide = true;
+    walkNfoElement(xml, [this, &xml](const QString& /*parent*/) {
+        return xml.name() == QLatin1String("url") && m_episodeGuideUrl.read(xml);
+    });
+    return true;
+}
 
-    QFileInfo fi(m_show.dir().filePath("theme.mp3"));
-    m_show.setHasTune(fi.isFile());
+bool TvShowXmlReader::showGenre(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    const QStringList genres = readNfoText(xml).split(" / ", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& genre : genres) {
+        m_show.addGenre(genre);
+    }
+    return true;
+}
+
+bool TvShowXmlReader::showTag(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_show.addTag(readNfoText(xml));
+    return true;
+}
+
+bool TvShowXmlReader::showActor(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    m_show.addActor(readNfoActor(xml, true));
+    return true;
 }
 
-void TvShowXmlReader::showThumb(const QDomElement& element)
+bool TvShowXmlReader::showThumb(QXmlStreamReader& xml, const QString& parent)
 {
-    QString aspect = element.attribute("aspect", "poster").toLower().trimmed();
+    if (parent != "tvshow") {
+        xml.skipCurrentElement();
+        return true;
+    }
+
+    const QXmlStreamAttributes attributes = xml.attributes();
+    QString aspect = attributes.hasAttribute("aspect") ? attributes.value("aspect").toString().toLower().trimmed()
+                                                       : QStringLiteral("poster");
 
     Poster p;
-    p.originalUrl = QUrl(element.text());
-    p.thumbUrl = element.attribute("preview");
-    p.language = element.attribute("language");
+    p.thumbUrl = attributes.value("preview").toString();
+    p.language = attributes.value("language").toString();
     p.aspect = aspect;
+    p.originalUrl = QUrl(readNfoText(xml));
 
-    if (element.hasAttribute("type") && element.attribute("type").toLower() == "season") {
-        SeasonNumber season = SeasonNumber(element.attribute("season").toInt());
+    if (attributes.hasAttribute("type") && attributes.value("type").toString().toLower() == "season") {
+        SeasonNumber season = SeasonNumber(attributes.value("season").toInt());
         if (season != SeasonNumber::NoSeason) {
             p.season = season;
             if (aspect == "banner") {
@@ -242,31 +246,53 @@ void TvShowXmlReader::showThumb(const QDomElement& element)
                 m_show.addSeasonPoster(season, p);
             }
         }
-        return;
+        return true;
     }
 
     if (aspect == "banner") {
         m_show.addBanner(p);
-        return;
+        return true;
     }
 
     m_show.addPoster(p);
+    return true;
+}
+
+bool TvShowXmlReader::showFanart(QXmlStreamReader& xml, const QString& /*parent*/)
+{
+    // <fanart url="https://example.com/">
+    //   <thumb dim="1920x1080" preview="preview/image.jpg">image.jpg</thumb>
+    // </fanart>
+    const QString url = xml.attributes().value("url").toString();
+    walkNfoElement(xml, [this, &xml, &url](const QString& parent) {
+        if (xml.name() != QLatin1String("thumb")) {
+            return false;
+        }
+        if (parent == "fanart") {
+            showFanartThumb(xml, url);
+        } else {
+            xml.skipCurrentElement();
+        }
+        return true;
+    });
+    return true;
 }
 
-void TvShowXmlReader::showFanartThumb(const QDomElement& element, QString thumbUrl)
+void TvShowXmlReader::showFanartThumb(QXmlStreamReader& xml, QString thumbUrl)
 {
+    const QXmlStreamAttributes attributes = xml.attributes();
     Poster p;
-    p.originalUrl = QUrl(thumbUrl + element.text());
-    if (!element.attribute("preview").isEmpty()) {
-        p.thumbUrl = QUrl(thumbUrl + element.attribute("preview"));
+    if (!attributes.value("preview").isEmpty()) {
+        p.thumbUrl = QUrl(thumbUrl + attributes.value("preview").toString());
     }
-    QStringList dimensions = element.attribute("dim").split("x");
+    QStringList dimensions = attributes.value("dim").toString().split("x");
     if (dimensions.size() == 2) {
         QSize size;
         size.setWidth(dimensions.first().toInt());
         size.setHeight(dimensions.last().toInt());
         p.originalSize = size;
     }
+    p.originalUrl = QUrl(thumbUrl + readNfoText(xml));
 
     m_show.addBackdrop(p);
 }
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <QDomDocument>
+#include "media_centers/kodi/KodiXmlReader.h"
+
+#include <QPair>
 #include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class TvShow;
 
@@ -12,13 +16,54 @@ class TvShowXmlReader
 {
 public:
     explicit TvShowXmlReader(TvShow& tvShow);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Reads the TV show's NFO document in a single pass.
+    void parseNfo(QXmlStreamReader& xml);
 
 private:
-    void showThumb(const QDomElement& element);
-    void showFanartThumb(const QDomElement& element, QString thumbUrl);
+    template<NfoFirstText TvShowXmlReader::*member>
+    bool firstText(QXmlStreamReader& xml, const QString& /*parent*/)
+    {
+        return (this->*member).read(xml);
+    }
+
+    bool showUniqueId(QXmlStreamReader& xml, const QString& parent);
+    bool showNamedSeason(QXmlStreamReader& xml, const QString& parent);
+    bool showRatingV17(QXmlStreamReader& xml, const QString& parent);
+    bool showRatingV16(QXmlStreamReader& xml, const QString& parent);
+    bool showVoteCountV16(QXmlStreamReader& xml, const QString& parent);
+    bool showEpisodeGuide(QXmlStreamReader& xml, const QString& parent);
+    bool showGenre(QXmlStreamReader& xml, const QString& parent);
+    bool showTag(QXmlStreamReader& xml, const QString& parent);
+    bool showActor(QXmlStreamReader& xml, const QString& parent);
+    bool showThumb(QXmlStreamReader& xml, const QString& parent);
+    bool showFanart(QXmlStreamReader& xml, const QString& parent);
+    void showFanartThumb(QXmlStreamReader& xml, QString thumbUrl);
+
+    void storeDocumentValues();
 
     TvShow& m_show;
+
+    NfoFirstText m_id;
+    NfoFirstText m_tvdbIdV16;
+    NfoFirstText m_imdbIdV16;
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    NfoFirstText m_title;
+    NfoFirstText m_sortTitle;
+    NfoFirstText m_originalTitle;
+    NfoFirstText m_showTitle;
+    NfoRatings m_ratings;
+    NfoFirstText m_userRating;
+    NfoFirstText m_top250;
+    NfoFirstText m_plot;
+    NfoFirstText m_certification;
+    NfoFirstText m_year;
+    NfoFirstText m_premiered;
+    NfoFirstText m_dateAdded;
+    NfoFirstText m_studio;
+    bool m_hasEpisodeGuide = false;
+    NfoFirstText m_episodeGuideUrl;
+    NfoFirstText m_runtime;
+    NfoFirstText m_status;
 };
 
 } // namespace kodi
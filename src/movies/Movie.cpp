@@ -10,6 +10,7 @@
 #include "data/ImageCache.h"
 #include "globals/Helper.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "movies/MovieDuplicateIndex.h"
 #include "settings/Settings.h"
 
 using namespace std::chrono_literals;
@@ -1096,7 +1097,8 @@ MovieDuplicate Movie::duplicateProperties(Movie* movie) const
     MovieDuplicate md;
     md.imdbId = movie->imdbId().isValid() && movie->imdbId() == imdbId();
     md.tmdbId = movie->tmdbId().isValid() && movie->tmdbId() == tmdbId();
-    md.title = !movie->name().isEmpty() && movie->name() == name();
+    const QString title = mediaelch::MovieDuplicateIndex::titleKey(*this);
+    md.title = !title.isEmpty() && mediaelch::MovieDuplicateIndex::titleKey(*movie) == title;
 
     return md;
 }
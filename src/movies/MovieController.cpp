@@ -3,8 +3,10 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QRegularExpression>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/qmath.h>
 
+#include "data/Database.h"
 #include "data/ImageCache.h"
 #include "file/NameFormatter.h"
 #include "globals/DownloadManager.h"
@@ -42,8 +44,19 @@ MovieController::MovieController(Movie* parent) :
         static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection));
 }
 
+void MovieController::setDownloadPriority(DownloadPriority priority)
+{
+    m_downloadManager->setPriority(priority);
+}
+
+DownloadPriority MovieController::downloadPriority() const
+{
+    return m_downloadManager->priority();
+}
+
 bool MovieController::saveData(MediaCenterInterface* mediaCenterInterface)
 {
+    loadDetails();
     if (!m_movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         loadStreamDetailsFromFile();
     }
@@ -65,6 +78,15 @@ bool MovieController::saveData(MediaCenterInterface* mediaCenterInterface)
 
 bool MovieController::loadData(MediaCenterInterface* mediaCenterInterface, bool force, bool reloadFromNfo)
 {
+    if (m_detailsPending) {
+        // The summary does not count as loaded infos.
+        m_detailsPending = false;
+        force = true;
+        if (!reloadFromNfo && m_movie->nfoContent().isEmpty() && m_movie->databaseId() >= 0) {
+            m_movie->setNfoContent(Manager::instance()->database()->movieNfoContent(m_movie->databaseId()));
+        }
+    }
+
     if ((m_infoLoaded || m_movie->hasChanged()) && !force
         && (m_infoFromNfoLoaded || (m_movie->hasChanged() && !m_infoFromNfoLoaded))) {
         return m_infoLoaded;
@@ -137,6 +159,7 @@ void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, QString>
     mediaelch::scraper::MovieScraper* scraperInterface,
     QSet<MovieScraperInfo> infos)
 {
+    loadDetails();
     emit sigLoadStarted(m_movie);
     m_infosToLoad = infos;
     if (scraperInterface->meta().identifier == mediaelch::scraper::TmdbMovie::ID
@@ -152,17 +175,26 @@ void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, QString>
 }
 
 void MovieController::loadStreamDetailsFromFile()
+{
+    loadDetails();
+    Manager::instance()->mediaInfoProbeQueue()->loadStreamDetails(*m_movie->streamDetails());
+    applyProbedStreamDetails();
+    m_movie->setChanged(true);
+}
+
+void MovieController::applyProbedStreamDetails()
 {
     using namespace std::chrono;
     using namespace std::chrono_literals;
-    m_movie->streamDetails()->loadStreamDetails();
     seconds runtime =
         seconds(m_movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     if (runtime > 0s) {
+        // setRuntime() marks the movie as changed.
+        const bool hasChanged = m_movie->hasChanged();
         m_movie->setRuntime(duration_cast<minutes>(runtime));
+        m_movie->setChanged(hasChanged);
     }
     m_movie->setStreamDetailsLoaded(true);
-    m_movie->setChanged(true);
 }
 
 QSet<MovieScraperInfo> MovieController::infosToLoad()
@@ -298,6 +330,7 @@ void MovieController::onFanartLoadDone(Movie* movie, QMap<ImageType, QVector<Pos
             }
             DownloadManagerElement d;
             d.imageType = ImageType::Actor;
+            d.priority = DownloadPriority::Low;
             d.url = QUrl(actor->thumb);
             d.actor = actor;
             d.movie = movie;
@@ -396,6 +429,89 @@ bool MovieController::infoLoaded() const
     return m_infoLoaded;
 }
 
+void MovieController::setDetailsPending(bool infoLoaded, DetailsSummary summary)
+{
+    m_detailsPending = true;
+    m_infoLoaded = infoLoaded;
+    m_infoFromNfoLoaded = false;
+    m_detailsSummary = summary;
+}
+
+bool MovieController::detailsPending() const
+{
+    return m_detailsPending;
+}
+
+MovieController::DetailsSummary MovieController::detailsSummary() const
+{
+    if (m_detailsPending) {
+        return m_detailsSummary;
+    }
+    DetailsSummary summary;
+    summary.hasActors = !m_movie->actors().isEmpty();
+    summary.hasTrailer = !m_movie->trailer().isEmpty();
+    summary.streamDetailsLoaded = m_movie->streamDetailsLoaded();
+    summary.hasImdbId = m_movie->hasValidImdbId();
+    return summary;
+}
+
+void MovieController::loadDetails()
+{
+    if (m_detailsPending) {
+        loadData(Manager::instance()->mediaCenterInterface(), true, false);
+    }
+}
+
+void MovieController::loadDetails(const QVector<Movie*>& movies)
+{
+    QVector<Movie*> pending;
+    QVector<int> ids;
+    for (Movie* movie : movies) {
+        if (movie->controller()->detailsPending()) {
+            pending << movie;
+            ids << movie->databaseId();
+        }
+    }
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    // The database connection must only be used in this thread.
+    const QHash<int, QString> contents = Manager::instance()->database()->movieNfoContents(ids);
+    for (Movie* movie : pending) {
+        movie->setNfoContent(contents.value(movie->databaseId()));
+    }
+    // Movies without cached contents are loaded from their NFO file.
+    QtConcurrent::blockingMap(pending, [](Movie* movie) {
+        movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true, movie->nfoContent().isEmpty());
+    });
+}
+
+void MovieController::releaseDetails()
+{
+    if (m_detailsPending || m_movie->databaseId() < 0 || m_movie->hasChanged()) {
+        return;
+    }
+    // Same values as the cache's summary, see Database::moviesInDirectory()
+    const QString name = m_movie->name();
+    const QString sortTitle = m_movie->sortTitle();
+    const QDate released = m_movie->released();
+    const int playCount = m_movie->playcount();
+    const DetailsSummary summary = detailsSummary();
+
+    m_movie->blockSignals(true);
+    m_movie->clear();
+    m_movie->streamDetails()->clear();
+    m_movie->setStreamDetailsLoaded(false);
+    m_movie->setName(name);
+    m_movie->setSortTitle(sortTitle);
+    m_movie->setReleased(released);
+    m_movie->setPlayCount(playCount);
+    m_movie->setChanged(false);
+    m_movie->blockSignals(false);
+    setDetailsPending(m_infoLoaded, summary);
+}
+
 bool MovieController::downloadsInProgress() const
 {
     return m_downloadsInProgress;
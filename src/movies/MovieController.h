@@ -45,6 +45,9 @@ public:
         QSet<MovieScraperInfo> infos);
 
     void loadStreamDetailsFromFile();
+    /// \brief Marks the stream details probed from the movie's files as loaded and
+    ///        sets the runtime they contain.  Does not mark the movie as changed.
+    void applyProbedStreamDetails();
 
     /// \brief Called when a ScraperInterface has finished loading
     ///        Emits the loaded signal
@@ -56,10 +59,47 @@ public:
     /// \return Infos were loaded
     bool infoLoaded() const;
 
+    /// \brief Media status of a movie's details that is stored in the cache summary.
+    /// \details Lets the movie list show the status columns without loading the details.
+    struct DetailsSummary
+    {
+        bool hasActors = false;
+        bool hasTrailer = false;
+        bool streamDetailsLoaded = false;
+        bool hasImdbId = false;
+    };
+
+    /// \brief Marks the movie as loaded from its cache summary only.
+    /// \details Only the name, sort title, release date and playcount are set.
+    ///          Everything else is loaded from the cached NFO contents on the
+    ///          first call to loadDetails() or loadData().
+    /// \param infoLoaded Whether the movie had infos when the summary was written.
+    /// \param summary Media status of the details, see detailsSummary().
+    void setDetailsPending(bool infoLoaded, DetailsSummary summary = {});
+    bool detailsPending() const;
+    /// \brief Media status of the movie's details.  Uses the cache summary if the
+    ///        details are pending, so it never loads them.
+    DetailsSummary detailsSummary() const;
+    /// \brief Loads the movie's details if only its summary was loaded.
+    void loadDetails();
+    /// \brief Loads the details of all given movies that have pending details.
+    /// \details The NFO contents are read in one go and parsed in parallel.
+    static void loadDetails(const QVector<Movie*>& movies);
+    /// \brief Drops the details of a cached movie so that only its summary is kept.
+    /// \details The details are loaded again on the next call to loadDetails().  Does
+    ///          nothing if the movie is not in the cache or has unsaved changes.
+    void releaseDetails();
+
     /// \brief Returns true if a download is in progress
     /// \return Download is in progress
     bool downloadsInProgress() const;
 
+    /// \brief Priority of this movie's image downloads compared to other items' downloads.
+    /// \details The selected movie uses DownloadPriority::High, movies that are scraped
+    ///          in the background use DownloadPriority::Low.
+    void setDownloadPriority(DownloadPriority priority);
+    DownloadPriority downloadPriority() const;
+
     void loadImage(ImageType type, QUrl url);
     void loadImages(ImageType type, QVector<QUrl> urls);
     void abortDownloads();
@@ -90,6 +130,8 @@ private:
     Movie* m_movie;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
+    bool m_detailsPending = false;
+    DetailsSummary m_detailsSummary;
     QSet<MovieScraperInfo> m_infosToLoad;
     DownloadManager* m_downloadManager;
     bool m_downloadsInProgress = false;
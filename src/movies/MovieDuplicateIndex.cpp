@@ -0,0 +1,195 @@
+#include "movies/MovieDuplicateIndex.h"
+
+#include "movies/Movie.h"
+
+#include <QSet>
+#include <algorithm>
+
+namespace mediaelch {
+
+MovieDuplicateIndex::MovieDuplicateIndex(QObject* parent) : QObject(parent)
+{
+}
+
+void MovieDuplicateIndex::setMovies(const QVector<Movie*>& movies)
+{
+    clear();
+    m_buckets.reserve(movies.size() * 3);
+    m_keys.reserve(movies.size());
+    m_order.reserve(movies.size());
+    for (Movie* movie : movies) {
+        addMovie(movie);
+    }
+}
+
+void MovieDuplicateIndex::addMovie(Movie* movie)
+{
+    if (movie == nullptr || m_keys.contains(movie)) {
+        return;
+    }
+    m_order.insert(movie, m_nextOrder++);
+    insertKeys(movie, keysOf(*movie));
+
+    connect(movie, &Movie::sigChanged, this, &MovieDuplicateIndex::onMovieChanged, Qt::UniqueConnection);
+    // The movie must not be dereferenced: It is already (partially) destroyed.
+    connect(movie, &QObject::destroyed, this, [this, movie]() { removeMovie(movie); });
+}
+
+void MovieDuplicateIndex::removeMovie(Movie* movie)
+{
+    if (!m_keys.contains(movie)) {
+        return;
+    }
+    removeKeys(movie);
+    m_keys.remove(movie);
+    m_order.remove(movie);
+    disconnect(movie, nullptr, this, nullptr);
+}
+
+void MovieDuplicateIndex::updateMovie(Movie* movie)
+{
+    if (!m_keys.contains(movie)) {
+        return;
+    }
+    const QStringList keys = keysOf(*movie);
+    if (keys == m_keys.value(movie)) {
+        return;
+    }
+    removeKeys(movie);
+    insertKeys(movie, keys);
+}
+
+void MovieDuplicateIndex::clear()
+{
+    for (auto it = m_keys.constBegin(); it != m_keys.constEnd(); ++it) {
+        disconnect(it.key(), nullptr, this, nullptr);
+    }
+    m_buckets.clear();
+    m_keys.clear();
+    m_order.clear();
+    m_nextOrder = 0;
+}
+
+int MovieDuplicateIndex::movieCount() const
+{
+    return m_keys.size();
+}
+
+bool MovieDuplicateIndex::hasDuplicates(Movie* movie) const
+{
+    for (const QString& key : m_keys.value(movie)) {
+        if (m_buckets.value(key).size() > 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QVector<Movie*> MovieDuplicateIndex::duplicatesOf(Movie* movie) const
+{
+    QVector<Movie*> duplicates;
+    QSet<Movie*> seen{movie};
+    for (const QString& key : m_keys.value(movie)) {
+        for (Movie* other : m_buckets.value(key)) {
+            if (!seen.contains(other)) {
+                seen.insert(other);
+                duplicates.append(other);
+            }
+        }
+    }
+    std::sort(duplicates.begin(), duplicates.end(), [this](Movie* a, Movie* b) { //
+        return m_order.value(a) < m_order.value(b);
+    });
+    return duplicates;
+}
+
+QVector<Movie*> MovieDuplicateIndex::moviesWithDuplicates() const
+{
+    QVector<Movie*> movies;
+    for (auto it = m_keys.constBegin(); it != m_keys.constEnd(); ++it) {
+        if (hasDuplicates(it.key())) {
+            movies.append(it.key());
+        }
+    }
+    std::sort(movies.begin(), movies.end(), [this](Movie* a, Movie* b) { //
+        return m_order.value(a) < m_order.value(b);
+    });
+    return movies;
+}
+
+QString MovieDuplicateIndex::normalizedTitle(const QString& title)
+{
+    // Decompose characters so that diacritics become separate marks that are skipped.
+    const QString decomposed = title.normalized(QString::NormalizationForm_KD);
+    QString normalized;
+    normalized.reserve(decomposed.size());
+    bool separator = false;
+    for (const QChar c : decomposed) {
+        if (c.isLetterOrNumber()) {
+            if (separator && !normalized.isEmpty()) {
+                normalized.append(' ');
+            }
+            separator = false;
+            normalized.append(c.toLower());
+        } else if (!c.isMark()) {
+            separator = true;
+        }
+    }
+    return normalized;
+}
+
+QString MovieDuplicateIndex::titleKey(const Movie& movie)
+{
+    const QString title = normalizedTitle(movie.name());
+    if (title.isEmpty()) {
+        return {};
+    }
+    const int year = movie.released().isValid() ? movie.released().year() : 0;
+    return QStringLiteral("%1|%2").arg(title, QString::number(year));
+}
+
+QStringList MovieDuplicateIndex::keysOf(const Movie& movie) const
+{
+    QStringList keys;
+    if (movie.imdbId().isValid()) {
+        keys << QStringLiteral("imdb:") + movie.imdbId().toString();
+    }
+    if (movie.tmdbId().isValid()) {
+        keys << QStringLiteral("tmdb:") + movie.tmdbId().toString();
+    }
+    const QString title = titleKey(movie);
+    if (!title.isEmpty()) {
+        keys << QStringLiteral("title:") + title;
+    }
+    return keys;
+}
+
+void MovieDuplicateIndex::insertKeys(Movie* movie, const QStringList& keys)
+{
+    for (const QString& key : keys) {
+        m_buckets[key].append(movie);
+    }
+    m_keys.insert(movie, keys);
+}
+
+void MovieDuplicateIndex::removeKeys(Movie* movie)
+{
+    for (const QString& key : m_keys.value(movie)) {
+        auto bucket = m_buckets.find(key);
+        if (bucket == m_buckets.end()) {
+            continue;
+        }
+        bucket->removeOne(movie);
+        if (bucket->isEmpty()) {
+            m_buckets.erase(bucket);
+        }
+    }
+    m_keys[movie].clear();
+}
+
+void MovieDuplicateIndex::onMovieChanged(Movie* movie)
+{
+    updateMovie(movie);
+}
+
+} // namespace mediaelch
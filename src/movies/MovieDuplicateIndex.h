@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class Movie;
+
+namespace mediaelch {
+
+/// \brief Index of movies by IMDb ID, TMDb ID and normalized title + year.
+/// \details Movies that share at least one key are duplicates, see
+///          Movie::isDuplicate().  Instead of comparing each movie with every
+///          other movie, movies are put into buckets by their keys, so that
+///          building the index and looking up duplicates is (nearly) linear.
+///          The index listens to Movie::sigChanged() and moves a movie to
+///          other buckets if its IDs, title or release date change.
+class MovieDuplicateIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MovieDuplicateIndex(QObject* parent = nullptr);
+    ~MovieDuplicateIndex() override = default;
+
+    /// \brief Replaces all movies of the index.
+    void setMovies(const QVector<Movie*>& movies);
+    void addMovie(Movie* movie);
+    void removeMovie(Movie* movie);
+    /// \brief Recalculates the movie's keys. Called automatically if the movie changes.
+    void updateMovie(Movie* movie);
+    void clear();
+
+    int movieCount() const;
+    bool hasDuplicates(Movie* movie) const;
+    /// \brief All movies that share a key with the given movie, without the movie itself.
+    /// \details Movies are returned in the order they were added to the index.
+    QVector<Movie*> duplicatesOf(Movie* movie) const;
+    /// \brief All movies that have duplicates, in the order they were added to the index.
+    QVector<Movie*> moviesWithDuplicates() const;
+
+    /// \brief Lowercase title without punctuation, diacritics and repeated whitespace.
+    static QString normalizedTitle(const QString& title);
+    /// \brief Normalized title and release year, or an empty string if the movie has no title.
+    static QString titleKey(const Movie& movie);
+
+private:
+    QStringList keysOf(const Movie& movie) const;
+    void insertKeys(Movie* movie, const QStringList& keys);
+    void removeKeys(Movie* movie);
+    void onMovieChanged(Movie* movie);
+
+private:
+    QHash<QString, QVector<Movie*>> m_buckets;
+    QHash<Movie*, QStringList> m_keys;
+    /// Insertion order of each movie, used for deterministic results.
+    QHash<Movie*, int> m_order;
+    int m_nextOrder = 0;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,149 @@
+#include "movies/MovieKeyTable.h"
+
+#include "globals/CollationKeys.h"
+#include "globals/Helper.h"
+#include "movies/Movie.h"
+
+namespace mediaelch {
+
+void MovieKeyTable::reset(const QVector<Movie*>& movies)
+{
+    const int count = movies.size();
+    m_movies = movies;
+    m_sortTitles = QVector<QString>(count);
+    m_titleRanks = QVector<int>(count, 0);
+    m_years = QVector<int>(count, 0);
+    m_added = QVector<qint64>(count, 0);
+    m_watched = QVector<bool>(count, false);
+    m_infoLoaded = QVector<bool>(count, false);
+    m_dirty = QVector<bool>(count, true);
+    m_anyDirty = true;
+    m_ranksDirty = true;
+}
+
+void MovieKeyTable::insertRow(int row, Movie* movie)
+{
+    m_movies.insert(row, movie);
+    m_sortTitles.insert(row, QString());
+    m_titleRanks.insert(row, 0);
+    m_years.insert(row, 0);
+    m_added.insert(row, 0);
+    m_watched.insert(row, false);
+    m_infoLoaded.insert(row, false);
+    m_dirty.insert(row, true);
+    m_anyDirty = true;
+    m_ranksDirty = true;
+}
+
+void MovieKeyTable::removeRow(int row)
+{
+    if (row < 0 || row >= m_movies.size()) {
+        return;
+    }
+    m_movies.removeAt(row);
+    m_sortTitles.removeAt(row);
+    m_titleRanks.removeAt(row);
+    m_years.removeAt(row);
+    m_added.removeAt(row);
+    m_watched.removeAt(row);
+    m_infoLoaded.removeAt(row);
+    m_dirty.removeAt(row);
+    // Ranks of the remaining rows keep their order.
+}
+
+void MovieKeyTable::invalidateRow(int row)
+{
+    if (row >= 0 && row < m_dirty.size()) {
+        m_dirty[row] = true;
+        m_anyDirty = true;
+    }
+}
+
+void MovieKeyTable::invalidateAll()
+{
+    m_dirty.fill(true);
+    m_anyDirty = true;
+}
+
+int MovieKeyTable::rowCount() const
+{
+    return m_movies.size();
+}
+
+Movie* MovieKeyTable::movie(int row) const
+{
+    return m_movies.at(row);
+}
+
+int MovieKeyTable::titleRank(int row) const
+{
+    // Ranks depend on the titles of all rows.
+    refresh();
+    return m_titleRanks.at(row);
+}
+
+int MovieKeyTable::year(int row) const
+{
+    ensureRow(row);
+    return m_years.at(row);
+}
+
+qint64 MovieKeyTable::added(int row) const
+{
+    ensureRow(row);
+    return m_added.at(row);
+}
+
+bool MovieKeyTable::watched(int row) const
+{
+    ensureRow(row);
+    return m_watched.at(row);
+}
+
+bool MovieKeyTable::infoLoaded(int row) const
+{
+    ensureRow(row);
+    return m_infoLoaded.at(row);
+}
+
+void MovieKeyTable::ensureRow(int row) const
+{
+    if (m_dirty.at(row)) {
+        updateRow(row);
+    }
+}
+
+void MovieKeyTable::updateRow(int row) const
+{
+    const Movie* movie = m_movies.at(row);
+    // Same as MovieModel::SortTitleRole
+    QString sortTitle = movie->sortTitle();
+    if (sortTitle.isEmpty()) {
+        sortTitle = helper::appendArticle(movie->name());
+    }
+    if (sortTitle != m_sortTitles.at(row)) {
+        m_sortTitles[row] = sortTitle;
+        m_ranksDirty = true;
+    }
+    m_years[row] = movie->released().isValid() ? movie->released().year() : 0;
+    m_added[row] = movie->fileLastModified().isValid() ? movie->fileLastModified().toMSecsSinceEpoch() : 0;
+    m_watched[row] = movie->watched();
+    m_infoLoaded[row] = movie->controller()->infoLoaded();
+    m_dirty[row] = false;
+}
+
+void MovieKeyTable::refresh() const
+{
+    if (m_anyDirty) {
+        for (int row = 0; row < m_movies.size(); ++row) {
+            ensureRow(row);
+        }
+        m_anyDirty = false;
+    }
+    if (m_ranksDirty) {
+        m_titleRanks = collationRanks(m_sortTitles);
+        m_ranksDirty = false;
+    }
+}
+
+} // namespace mediaelch
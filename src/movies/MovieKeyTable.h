@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QDateTime>
+#include <QString>
+#include <QVector>
+
+class Movie;
+
+namespace mediaelch {
+
+/// \brief Column-oriented sort keys of MovieModel's rows.
+/// \details MovieProxyModel sorts and filters tens of thousands of movies.
+///          Instead of going through QVariant based data() calls and
+///          locale-aware string comparisons for each comparison, it uses the
+///          keys of this table.  Rows are invalidated if their movie changes
+///          and recalculated on the next access.  Title ranks are recalculated
+///          for all rows once any title has changed.
+class MovieKeyTable
+{
+public:
+    void reset(const QVector<Movie*>& movies);
+    void insertRow(int row, Movie* movie);
+    void removeRow(int row);
+    void invalidateRow(int row);
+    void invalidateAll();
+
+    int rowCount() const;
+    Movie* movie(int row) const;
+
+    /// \brief Locale-aware rank of the row's sort title. Equal titles have the same rank.
+    int titleRank(int row) const;
+    /// \brief Release year or 0 if the movie has no release date.
+    int year(int row) const;
+    qint64 added(int row) const;
+    bool watched(int row) const;
+    bool infoLoaded(int row) const;
+
+private:
+    void updateRow(int row) const;
+    void ensureRow(int row) const;
+    /// \brief Updates all invalidated rows and the title ranks if necessary.
+    void refresh() const;
+
+private:
+    QVector<Movie*> m_movies;
+    // All other columns are caches that are updated lazily.
+    mutable QVector<QString> m_sortTitles;
+    mutable QVector<int> m_titleRanks;
+    mutable QVector<int> m_years;
+    mutable QVector<qint64> m_added;
+    mutable QVector<bool> m_watched;
+    mutable QVector<bool> m_infoLoaded;
+    mutable QVector<bool> m_dirty;
+    mutable bool m_anyDirty = false;
+    mutable bool m_ranksDirty = false;
+};
+
+} // namespace mediaelch
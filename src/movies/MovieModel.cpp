@@ -26,10 +26,25 @@ void MovieModel::addMovie(Movie* movie)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_movies.append(movie);
+    m_keys.insertRow(m_movies.size() - 1, movie);
     endInsertRows();
     connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
 }
 
+void MovieModel::removeMovie(Movie* movie)
+{
+    const int row = m_movies.indexOf(movie);
+    if (row < 0) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    m_movies.removeAt(row);
+    m_keys.removeRow(row);
+    endRemoveRows();
+    disconnect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged);
+    movie->deleteLater();
+}
+
 /**
  * \brief Called when a movies data has changed
  * Emits dataChanged
@@ -37,12 +52,15 @@ void MovieModel::addMovie(Movie* movie)
  */
 void MovieModel::onMovieChanged(Movie* movie)
 {
-    const QModelIndex index = createIndex(m_movies.indexOf(movie), 0);
+    const int row = m_movies.indexOf(movie);
+    m_keys.invalidateRow(row);
+    const QModelIndex index = createIndex(row, 0);
     emit dataChanged(index, index);
 }
 
 void MovieModel::update()
 {
+    m_keys.invalidateAll();
     const QModelIndex index = createIndex(0, 0);
     emit dataChanged(index, index);
 }
@@ -151,9 +169,11 @@ QVariant MovieModel::data(const QModelIndex& index, int role) const
     } else if (role == Qt::DecorationRole) {
         QString icon;
 
+        // Uses the cache summary of movies whose details are not loaded yet.
+        const MovieController::DetailsSummary details = movie->controller()->detailsSummary();
         switch (MovieModel::columnToMediaStatus(index.column())) {
-        case MediaStatusColumn::Actors: icon = (movie->actors().isEmpty()) ? "actors/red" : "actors/green"; break;
-        case MediaStatusColumn::Trailer: icon = (movie->trailer().isEmpty()) ? "trailer/red" : "trailer/green"; break;
+        case MediaStatusColumn::Actors: icon = details.hasActors ? "actors/green" : "actors/red"; break;
+        case MediaStatusColumn::Trailer: icon = details.hasTrailer ? "trailer/green" : "trailer/red"; break;
         case MediaStatusColumn::LocalTrailer:
             icon = (movie->hasLocalTrailer()) ? "trailer/green" : "trailer/red";
             break;
@@ -177,12 +197,12 @@ QVariant MovieModel::data(const QModelIndex& index, int role) const
             }
             break;
         case MediaStatusColumn::StreamDetails:
-            icon = (movie->streamDetailsLoaded()) ? "streamDetails/green" : "streamDetails/red";
+            icon = details.streamDetailsLoaded ? "streamDetails/green" : "streamDetails/red";
             break;
         case MediaStatusColumn::ExtraFanarts:
             icon = (movie->constImages().hasExtraFanarts()) ? "extraFanarts/green" : "extraFanarts/red";
             break;
-        case MediaStatusColumn::Id: icon = movie->hasValidImdbId() ? "id/green" : "id/red"; break;
+        case MediaStatusColumn::Id: icon = details.hasImdbId ? "id/green" : "id/red"; break;
         default: break;
         }
 
@@ -236,14 +256,26 @@ void MovieModel::clear()
         movie->deleteLater();
     }
     m_movies.clear();
+    m_keys.reset({});
     endRemoveRows();
 }
 
+const mediaelch::MovieKeyTable& MovieModel::keys() const
+{
+    return m_keys;
+}
+
 QVector<Movie*> MovieModel::movies()
 {
     return m_movies;
 }
 
+QVector<Movie*> MovieModel::moviesWithDetails()
+{
+    MovieController::loadDetails(m_movies);
+    return m_movies;
+}
+
 /// \brief Checks if there are new movies (movies where infoLoaded is false)
 /// \return True if there are new movies
 int MovieModel::countNewMovies()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "movies/Movie.h"
+#include "movies/MovieKeyTable.h"
 
 #include <QAbstractItemModel>
 #include <QIcon>
@@ -33,10 +34,16 @@ public:
     QModelIndex parent(const QModelIndex& child) const override;
 
     virtual QVector<Movie*> movies();
+    /// \brief Like movies() but loads pending details first, see MovieController::loadDetails().
+    QVector<Movie*> moviesWithDetails();
     Movie* movie(int row);
     void addMovie(Movie* movie);
+    /// \brief Removes the given movie from the model and deletes it.
+    void removeMovie(Movie* movie);
     void update();
     void clear();
+    /// \brief Sort and filter keys of all rows, see MovieProxyModel.
+    const mediaelch::MovieKeyTable& keys() const;
     int countNewMovies();
 
     static int mediaStatusToColumn(MediaStatusColumn column);
@@ -48,6 +55,7 @@ private slots:
 
 private:
     QVector<Movie*> m_movies;
+    mediaelch::MovieKeyTable m_keys;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
@@ -5,6 +5,7 @@
 #include "globals/Filter.h"
 #include "globals/Globals.h"
 #include "globals/Manager.h"
+#include "globals/Meta.h"
 
 MovieProxyModel::MovieProxyModel(QObject* parent) :
     QSortFilterProxyModel(parent), m_sortBy{SortBy::New}, m_filterDuplicates{false}
@@ -13,75 +14,67 @@ MovieProxyModel::MovieProxyModel(QObject* parent) :
 }
 
 /**
- * \brief Checks if a row accepts the filter. Checks the first two "columns" of our model (Movie name and folder name)
+ * \brief Checks if a row accepts the filter. Text filters use the hits of MediaSearchIndex.
  * \return Filter is accepted or not
  */
 bool MovieProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
 {
     Q_UNUSED(sourceParent);
-    QVector<Movie*> movies = Manager::instance()->movieModel()->movies();
-    if (sourceRow < 0 || sourceRow >= movies.count()) {
+    const mediaelch::MovieKeyTable& keys = Manager::instance()->movieModel()->keys();
+    if (sourceRow < 0 || sourceRow >= keys.rowCount()) {
         return true;
     }
 
-    Movie* movie = movies.at(sourceRow);
-    for (Filter* filter : m_filters) {
+    Movie* movie = keys.movie(sourceRow);
+    for (const QSet<const QObject*>& hits : m_searchHits) {
+        if (!hits.contains(movie)) {
+            return false;
+        }
+    }
+
+    for (Filter* filter : m_otherFilters) {
         if (!filter->accepts(movie)) {
             return false;
         }
     }
 
-    return !(m_filterDuplicates && !movies.at(sourceRow)->hasDuplicates());
+    return !(m_filterDuplicates && !movie->hasDuplicates());
 }
 
 bool MovieProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    const QString leftTitle = sourceModel()->data(left, MovieModel::SortTitleRole).toString();
-    const QString rightTitle = sourceModel()->data(right, MovieModel::SortTitleRole).toString();
-    const int cmp = QString::localeAwareCompare(leftTitle, rightTitle);
+    const mediaelch::MovieKeyTable& keys = Manager::instance()->movieModel()->keys();
+    const int leftRow = left.row();
+    const int rightRow = right.row();
 
     switch (m_sortBy) {
-    case SortBy::Name: return (cmp < 0);
+    case SortBy::Name: break;
 
-    case SortBy::Added:
-        return sourceModel()->data(left, MovieModel::FileLastModifiedRole).toDateTime()
-               >= sourceModel()->data(right, MovieModel::FileLastModifiedRole).toDateTime();
+    case SortBy::Added: return keys.added(leftRow) >= keys.added(rightRow);
 
     case SortBy::Seen:
-        if (sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
-            return false;
-        }
-        if (!sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
-            return true;
+        if (keys.watched(leftRow) != keys.watched(rightRow)) {
+            return !keys.watched(leftRow);
         }
         // Otherwise sort by name because both are either seen or not.
         break;
 
     case SortBy::Year:
-        if (sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-            != sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year()) {
-            return sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-                   >= sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year();
+        if (keys.year(leftRow) != keys.year(rightRow)) {
+            return keys.year(leftRow) >= keys.year(rightRow);
         }
         // Otherwise sort by name because both have the same year.
         break;
 
     case SortBy::New:
-        if (sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
-            return false;
-        }
-        if (!sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
-            return true;
+        if (keys.infoLoaded(leftRow) != keys.infoLoaded(rightRow)) {
+            return !keys.infoLoaded(leftRow);
         }
         // Otherwise sort by name because both are new or not.
         break;
     }
 
-    return (cmp < 0);
+    return keys.titleRank(leftRow) < keys.titleRank(rightRow);
 }
 
 bool MovieProxyModel::filterDuplicates() const
@@ -99,9 +92,45 @@ void MovieProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = std::move(filters);
     m_filterText = std::move(text);
+    m_searchHits.clear();
+    m_otherFilters.clear();
+    bool needsDetails = false;
+    for (Filter* filter : asConst(m_filters)) {
+        needsDetails = needsDetails || filter->needsMovieDetails();
+    }
+    const QVector<Movie*> movies = Manager::instance()->movieModel()->movies();
+    if (needsDetails) {
+        MovieController::loadDetails(movies);
+    }
+
+    mediaelch::MediaSearchIndex* index = Manager::instance()->searchIndex();
+    index->addMovies(movies);
+    for (Filter* filter : asConst(m_filters)) {
+        const mediaelch::MediaSearchIndex::Fields fields = searchFields(*filter);
+        if (fields != mediaelch::MediaSearchIndex::Fields()) {
+            m_searchHits << index->search(filter->shortText(), fields);
+        } else {
+            m_otherFilters << filter;
+        }
+    }
     invalidate();
 }
 
+mediaelch::MediaSearchIndex::Fields MovieProxyModel::searchFields(const Filter& filter)
+{
+    using Field = mediaelch::MediaSearchIndex::Field;
+    if (filter.isInfo(MovieFilters::Title)) {
+        return Field::Title;
+    }
+    if (filter.isInfo(MovieFilters::OriginalTitle)) {
+        return Field::OriginalTitle;
+    }
+    if (filter.isInfo(MovieFilters::Path)) {
+        return Field::Path;
+    }
+    return {};
+}
+
 void MovieProxyModel::setSortBy(SortBy sortBy)
 {
     m_sortBy = sortBy;
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "globals/Filter.h"
+#include "globals/MediaSearchIndex.h"
 
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 class MovieProxyModel : public QSortFilterProxyModel
@@ -20,8 +22,15 @@ protected:
     /// \brief Sort function for the movie model. Sorts movies by name and new files to top per default.
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
+private:
+    /// \brief Fields of MediaSearchIndex that the filter searches, or no fields if it is no text filter.
+    static mediaelch::MediaSearchIndex::Fields searchFields(const Filter& filter);
+
 private:
     QVector<Filter*> m_filters;
+    /// Hits of text filters, see searchFields().  A movie has to be part of each set.
+    QVector<QSet<const QObject*>> m_searchHits;
+    QVector<Filter*> m_otherFilters;
     QString m_filterText;
     SortBy m_sortBy;
     bool m_filterDuplicates;
@@ -0,0 +1,256 @@
+#include "movies/MovieScrapeItem.h"
+
+#include "globals/Manager.h"
+#include "movies/Movie.h"
+#include "movies/MovieController.h"
+#include "scrapers/movie/MovieScraper.h"
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+
+namespace mediaelch {
+
+MovieScrapeItem::MovieScrapeItem(Movie* movie, Config config, QObject* parent) :
+    scraper::ScrapePipelineItem(parent), m_movie{movie}, m_config{std::move(config)}
+{
+}
+
+MovieScrapeItem::~MovieScrapeItem()
+{
+    disconnectAll();
+}
+
+Movie* MovieScrapeItem::movie() const
+{
+    return m_movie;
+}
+
+QString MovieScrapeItem::title() const
+{
+    return m_movie.isNull() ? QString() : m_movie->name().trimmed();
+}
+
+bool MovieScrapeItem::isMissingIdForScraper(const scraper::MovieScraper& scraper, const Movie& movie)
+{
+    using namespace mediaelch::scraper;
+    const QString& id = scraper.meta().identifier;
+    if (id == ImdbMovie::ID) {
+        return !movie.imdbId().isValid();
+    }
+    if (id == TmdbMovie::ID || id == CustomMovieScraper::ID) {
+        return !movie.imdbId().isValid() && !movie.tmdbId().isValid();
+    }
+    return false;
+}
+
+QString MovieScrapeItem::searchKey() const
+{
+    return m_config.scraper->meta().identifier + "/search";
+}
+
+QString MovieScrapeItem::loadKey() const
+{
+    return m_config.scraper->meta().identifier;
+}
+
+void MovieScrapeItem::run()
+{
+    using namespace mediaelch::scraper;
+
+    if (m_movie.isNull() || m_config.scraper == nullptr) {
+        finish(Stage::Failed, tr("Movie or scraper is not available anymore."));
+        return;
+    }
+    // The IDs below are read from the NFO.
+    m_movie->controller()->loadDetails();
+
+    if (m_config.onlyWithId && isMissingIdForScraper(*m_config.scraper, *m_movie)) {
+        finish(Stage::Skipped, tr("Skipped because the movie does not have a valid ID."));
+        return;
+    }
+
+    const QString& scraperId = m_config.scraper->meta().identifier;
+    const bool isImdb = (scraperId == ImdbMovie::ID);
+    const bool isTmdb = (scraperId == TmdbMovie::ID);
+
+    if (isImdb && m_movie->imdbId().isValid()) {
+        m_ids.insert(nullptr, m_movie->imdbId().toString());
+        loadData();
+    } else if (isTmdb && m_movie->tmdbId().isValid()) {
+        m_ids.insert(nullptr, m_movie->tmdbId().toString());
+        loadData();
+    } else if (isTmdb && m_movie->imdbId().isValid()) {
+        m_ids.insert(nullptr, m_movie->imdbId().toString());
+        loadData();
+    } else {
+        startSearch();
+    }
+}
+
+void MovieScrapeItem::doAbort()
+{
+    disconnectAll();
+    if (!m_movie.isNull()) {
+        m_movie->controller()->abortDownloads();
+    }
+}
+
+void MovieScrapeItem::startSearch()
+{
+    using namespace mediaelch::scraper;
+
+    if (rateLimiter() != nullptr) {
+        // Only one search per scraper may be in flight, see class documentation.
+        ScraperRateLimiter::Limit limit = ScraperRateLimiter::defaultLimit(m_config.scraper->meta().identifier);
+        limit.maxConcurrent = 1;
+        rateLimiter()->setLimit(searchKey(), limit);
+    }
+
+    acquireSlot(searchKey(), [this]() {
+        if (m_movie.isNull()) {
+            finish(Stage::Failed, tr("Movie is not available anymore."));
+            return;
+        }
+        if (m_config.scraper->meta().identifier != CustomMovieScraper::ID) {
+            search(m_config.scraper, m_movie->name());
+            return;
+        }
+        MovieScraper* titleScraper = CustomMovieScraper::instance()->titleScraper();
+        const QString titleScraperId = (titleScraper != nullptr) ? titleScraper->meta().identifier : QString();
+        if ((titleScraperId == ImdbMovie::ID || titleScraperId == TmdbMovie::ID) && m_movie->imdbId().isValid()) {
+            search(m_config.scraper, m_movie->imdbId().toString());
+        } else if (titleScraperId == TmdbMovie::ID && m_movie->tmdbId().isValid()) {
+            search(m_config.scraper, m_movie->tmdbId().withPrefix());
+        } else {
+            search(m_config.scraper, m_movie->name());
+        }
+    });
+}
+
+void MovieScrapeItem::search(scraper::MovieScraper* scraper, const QString& searchString)
+{
+    using namespace mediaelch::scraper;
+
+    setStage(Stage::Search);
+    QObject::disconnect(m_searchConnection);
+    m_searchConnection = connect(scraper,
+        &MovieScraper::searchDone,
+        this,
+        [this, scraper](QVector<ScraperSearchResult> results, ScraperError error) {
+            onSearchFinished(scraper, std::move(results), std::move(error));
+        });
+    scraper->search(searchString);
+}
+
+void MovieScrapeItem::onSearchFinished(scraper::MovieScraper* scraper,
+    QVector<ScraperSearchResult> results,
+    ScraperError error)
+{
+    using namespace mediaelch::scraper;
+
+    QObject::disconnect(m_searchConnection);
+
+    if (m_movie.isNull()) {
+        finish(Stage::Failed, tr("Movie is not available anymore."));
+        return;
+    }
+    if (error.hasError()) {
+        finish(Stage::Failed, error.message);
+        return;
+    }
+    if (results.isEmpty()) {
+        finish(Stage::Skipped, tr("Did not find any results for \"%1\".").arg(m_movie->name()));
+        return;
+    }
+
+    if (m_config.scraper->meta().identifier == CustomMovieScraper::ID) {
+        m_ids.insert(scraper, results.first().id);
+        QVector<MovieScraper*> searchScrapers =
+            CustomMovieScraper::instance()->scrapersNeedSearch(m_config.details, m_ids);
+        if (!searchScrapers.isEmpty()) {
+            MovieScraper* next = searchScrapers.first();
+            const QString& nextId = next->meta().identifier;
+            if ((nextId == TmdbMovie::ID || nextId == ImdbMovie::ID) && m_movie->imdbId().isValid()) {
+                search(next, m_movie->imdbId().toString());
+            } else if (nextId == TmdbMovie::ID && m_movie->tmdbId().isValid()) {
+                search(next, m_movie->tmdbId().toString());
+            } else {
+                search(next, m_movie->name());
+            }
+            return;
+        }
+    } else {
+        m_ids.insert(m_config.scraper, results.first().id);
+    }
+
+    releaseSlot(searchKey());
+    loadData();
+}
+
+void MovieScrapeItem::loadData()
+{
+    acquireSlot(loadKey(), [this]() {
+        if (m_movie.isNull()) {
+            finish(Stage::Failed, tr("Movie is not available anymore."));
+            return;
+        }
+        setStage(Stage::Load);
+
+        MovieController* controller = m_movie->controller();
+        // Images of movies that are scraped in the background must not delay images of the selected movie.
+        controller->setDownloadPriority(DownloadPriority::Low);
+        connect(controller, &MovieController::sigLoadImagesStarted, this, &MovieScrapeItem::onLoadImagesStarted);
+        connect(controller, &MovieController::sigDownloadProgress, this, &MovieScrapeItem::onDownloadProgress);
+        connect(controller, &MovieController::sigLoadDone, this, &MovieScrapeItem::onLoadDone);
+        controller->loadData(m_ids, m_config.scraper, m_config.details);
+    });
+}
+
+void MovieScrapeItem::onLoadImagesStarted(Movie* movie)
+{
+    if (movie != m_movie) {
+        return;
+    }
+    // Details are loaded; images are throttled by the DownloadManager's per-host limits.
+    releaseSlot(loadKey());
+    setStage(Stage::Images);
+}
+
+void MovieScrapeItem::onDownloadProgress(Movie* movie, int current, int maximum)
+{
+    if (movie != m_movie) {
+        return;
+    }
+    reportProgress(maximum - current, maximum);
+}
+
+void MovieScrapeItem::onLoadDone(Movie* movie)
+{
+    if (movie != m_movie) {
+        return;
+    }
+    disconnectAll();
+    releaseSlot(loadKey());
+
+    if (m_config.saveToDisk) {
+        setStage(Stage::Save);
+        if (!movie->controller()->saveData(Manager::instance()->mediaCenterInterface())) {
+            finish(Stage::Failed, tr("Could not save the movie."));
+            return;
+        }
+    }
+    finish(Stage::Done);
+}
+
+void MovieScrapeItem::disconnectAll()
+{
+    QObject::disconnect(m_searchConnection);
+    if (!m_movie.isNull()) {
+        disconnect(m_movie->controller(), nullptr, this, nullptr);
+        if (m_movie->controller()->downloadPriority() == DownloadPriority::Low) {
+            m_movie->controller()->setDownloadPriority(DownloadPriority::Normal);
+        }
+    }
+}
+
+} // namespace mediaelch
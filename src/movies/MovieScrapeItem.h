@@ -0,0 +1,78 @@
+#pragma once
+
+#include "globals/ScraperInfos.h"
+#include "globals/ScraperResult.h"
+#include "scrapers/ScrapePipeline.h"
+#include "scrapers/ScraperError.h"
+
+#include <QHash>
+#include <QMetaObject>
+#include <QPointer>
+#include <QSet>
+
+class Movie;
+
+namespace mediaelch {
+namespace scraper {
+class MovieScraper;
+}
+
+/// \brief Scrapes a single movie as part of a ScrapePipeline.
+/// \details Searches the movie if it has no suitable ID, loads its details
+///          and images through the movie's controller and saves it afterwards.
+///          Searches of a scraper are serialized: MovieScraper::searchDone() does
+///          not tell which search has finished.  Loading details and downloading
+///          images happens concurrently.
+class MovieScrapeItem : public scraper::ScrapePipelineItem
+{
+    Q_OBJECT
+public:
+    struct Config
+    {
+        scraper::MovieScraper* scraper = nullptr;
+        QSet<MovieScraperInfo> details;
+        /// \brief Skip movies that have no ID for the scraper instead of searching them.
+        bool onlyWithId = false;
+        /// \brief Write the NFO file and images once the movie was scraped.
+        bool saveToDisk = false;
+    };
+
+public:
+    MovieScrapeItem(Movie* movie, Config config, QObject* parent = nullptr);
+    ~MovieScrapeItem() override;
+
+    Movie* movie() const;
+    QString title() const override;
+
+    /// \brief Whether the scraper works with IMDb/TMDb IDs but the movie has none.
+    /// \details Used for the "only with ID" option. Scrapers that only support
+    ///          searching by title never miss an ID.
+    static bool isMissingIdForScraper(const scraper::MovieScraper& scraper, const Movie& movie);
+
+protected:
+    void run() override;
+    void doAbort() override;
+
+private:
+    QString searchKey() const;
+    QString loadKey() const;
+
+    void startSearch();
+    void search(scraper::MovieScraper* scraper, const QString& searchString);
+    void onSearchFinished(scraper::MovieScraper* scraper,
+        QVector<ScraperSearchResult> results,
+        ScraperError error);
+    void loadData();
+    void onLoadImagesStarted(Movie* movie);
+    void onDownloadProgress(Movie* movie, int current, int maximum);
+    void onLoadDone(Movie* movie);
+    void disconnectAll();
+
+private:
+    QPointer<Movie> m_movie;
+    Config m_config;
+    QHash<scraper::MovieScraper*, QString> m_ids;
+    QMetaObject::Connection m_searchConnection;
+};
+
+} // namespace mediaelch
@@ -8,7 +8,9 @@
 
 #include <QApplication>
 #include <QDebug>
-#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QtConcurrent/QtConcurrent>
@@ -16,6 +18,46 @@
 #include <QtConcurrent/QtConcurrentMap>
 #include <QtConcurrent/QtConcurrentRun>
 
+namespace {
+
+/// Extras like trailers or samples are not listed as movies.
+bool isMovieExtraFile(const QString& fileName)
+{
+    return fileName.contains("-trailer", Qt::CaseInsensitive)            //
+           || fileName.contains("-sample", Qt::CaseInsensitive)          //
+           || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
+           || fileName.contains("-deleted", Qt::CaseInsensitive)         //
+           || fileName.contains("-featurette", Qt::CaseInsensitive)      //
+           || fileName.contains("-interview", Qt::CaseInsensitive)       //
+           || fileName.contains("-scene", Qt::CaseInsensitive)           //
+           || fileName.contains("-short", Qt::CaseInsensitive);
+}
+
+/// Files inside actor, extras, extra fanart and extra thumb folders are skipped.
+bool isSkippedMovieFolder(const QString& dirName)
+{
+    return QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0
+           || QString::compare("extras", dirName, Qt::CaseInsensitive) == 0
+           || QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0
+           || QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0;
+}
+
+QString parentDirectory(const QString& path)
+{
+    return path.left(path.lastIndexOf('/'));
+}
+
+/// Directory of the movie's (first) file. Same as the key of MovieContents::contents.
+QString movieDirectory(const Movie* movie)
+{
+    if (movie->files().isEmpty()) {
+        return QString();
+    }
+    return parentDirectory(movie->files().first().toString());
+}
+
+} // namespace
+
 namespace mediaelch {
 
 MovieFileSearcher::MovieFileSearcher(QObject* parent) :
@@ -26,8 +68,12 @@ MovieFileSearcher::MovieFileSearcher(QObject* parent) :
 void MovieFileSearcher::reload(bool force)
 {
     m_aborted = false;
+    m_statistics = ReloadStatistics{};
     emit searchStarted(tr("Searching for Movies..."));
 
+    QElapsedTimer timer;
+    timer.start();
+
     if (force) {
         Manager::instance()->database()->clearAllMovies();
     }
@@ -43,13 +89,30 @@ void MovieFileSearcher::reload(bool force)
 
     emit progress(0, 0, m_progressMessageId);
 
+    // All directories that can't be loaded from the database are scanned in parallel.
+    QVector<SettingsDir> directoriesToScan;
     for (const auto& movieDir : asConst(m_directories)) {
         if (m_aborted) {
             return;
         }
-        movieSum += loadMoviesFromDirectory(movieDir, force, moviesContent, dbMovies, bluRays, dvds);
+        const int moviesFromDb = loadMoviesFromDatabase(movieDir, force, dbMovies);
+        if (moviesFromDb > 0) {
+            movieSum += moviesFromDb;
+        } else {
+            directoriesToScan.append(movieDir);
+        }
     }
 
+    const QMap<QString, QFileInfoList> listings = listMovieDirectories(directoriesToScan);
+    for (const auto& movieDir : asConst(directoriesToScan)) {
+        if (m_aborted) {
+            return;
+        }
+        movieSum += loadMoviesFromDirectory(movieDir, listings, moviesContent, bluRays, dvds);
+    }
+    m_statistics.scan = std::chrono::milliseconds(timer.restart());
+    m_statistics.directories = listings.size();
+
     emit searchStarted(tr("Loading Movies..."));
 
     qDebug() << "Now processing files";
@@ -60,7 +123,10 @@ void MovieFileSearcher::reload(bool force)
     }
     emit currentDir("");
 
-    QtConcurrent::blockingMapped(dbMovies, MovieFileSearcher::loadMovieData);
+    loadCachedMovieData(dbMovies, Settings::instance()->advanced()->lazyMovieLoading());
+    m_statistics.parse = std::chrono::milliseconds(timer.elapsed());
+    m_statistics.moviesFromDisk = movies.size();
+    m_statistics.moviesFromCache = dbMovies.size();
 
     for (Movie* movie : dbMovies) {
         if (m_aborted) {
@@ -82,12 +148,233 @@ void MovieFileSearcher::reload(bool force)
     }
 }
 
+void MovieFileSearcher::reloadIncremental()
+{
+    m_aborted = false;
+    emit searchStarted(tr("Searching for Movies..."));
+
+    m_lastModifications.clear();
+    emit progress(0, 0, m_progressMessageId);
+
+    QVector<Movie*> newMovies;
+    QVector<Movie*> obsoleteMovies;
+    int movieCounter = 0;
+
+    for (const auto& movieDir : asConst(m_directories)) {
+        if (m_aborted) {
+            return;
+        }
+        rescanMovieDirectory(movieDir, newMovies, obsoleteMovies, movieCounter);
+    }
+    if (m_aborted) {
+        return;
+    }
+    emit currentDir("");
+
+    qDebug() << "[MovieFileSearcher] Incremental rescan: adding" << newMovies.size() << "and removing"
+             << obsoleteMovies.size() << "movies";
+
+    MovieModel* model = Manager::instance()->movieModel();
+    for (Movie* movie : asConst(obsoleteMovies)) {
+        model->removeMovie(movie);
+    }
+    for (Movie* movie : asConst(newMovies)) {
+        model->addMovie(movie);
+    }
+
+    emit moviesLoaded();
+}
+
+void MovieFileSearcher::rescanMovieDirectory(const SettingsDir& movieDir,
+    QVector<Movie*>& newMovies,
+    QVector<Movie*>& obsoleteMovies,
+    int& movieCounter)
+{
+    Database* database = Manager::instance()->database();
+    const DirectoryPath rootDir(movieDir.path);
+    const QString rootPath = rootDir.toString();
+
+    if (!Settings::instance()->advanced()->movieFilters().hasFilter()) {
+        return;
+    }
+
+    emit currentDir(rootPath);
+    processEvents();
+
+    DirectoryJournal journal(database->movieDirectorySnapshots(rootDir));
+    qDebug() << "[MovieFileSearcher] Rescanning directory:" << rootPath;
+    const bool completed = journal.walk(
+        rootPath,
+        [this](const QString& path, DirectoryJournal& dirJournal) {
+            return movieFilesInDirectory(path, dirJournal);
+        },
+        [this](const QString& path) {
+            emit currentDir(path);
+            processEvents();
+            return !m_aborted;
+        });
+    if (!completed || m_aborted) {
+        return;
+    }
+
+    // Movies known so far: either those in the model or, on first load, those from the cache.
+    QVector<Movie*> knownMovies;
+    const QVector<Movie*> modelMovies = Manager::instance()->movieModel()->movies();
+    for (Movie* movie : modelMovies) {
+        const QString dir = movieDirectory(movie);
+        if (dir == rootPath || dir.startsWith(rootPath + "/")) {
+            knownMovies.append(movie);
+        }
+    }
+    const bool loadedFromCache = knownMovies.isEmpty();
+    if (loadedFromCache) {
+        knownMovies = database->moviesInDirectory(rootDir, Settings::instance()->advanced()->lazyMovieLoading());
+    }
+
+    // Don't throw away unsaved changes: Such movies are kept as they are and
+    // their directories are rescanned next time.
+    QSet<QString> unsavedDirs;
+    for (const Movie* movie : asConst(knownMovies)) {
+        const QString dir = movieDirectory(movie);
+        if (movie->hasChanged() && journal.isChanged(dir)) {
+            journal.discard(dir);
+            unsavedDirs.insert(dir);
+        }
+    }
+
+    QVector<Movie*> keptMovies;
+    for (Movie* movie : asConst(knownMovies)) {
+        const QString dir = movieDirectory(movie);
+        const QString newDir = journal.movedTo(dir);
+        if (unsavedDirs.contains(dir)) {
+            keptMovies.append(movie);
+
+        } else if (!newDir.isEmpty()) {
+            moveMovieDirectory(*movie, dir, newDir);
+            database->update(movie);
+            keptMovies.append(movie);
+
+        } else if (journal.isUnchanged(dir)) {
+            keptMovies.append(movie);
+
+        } else {
+            database->remove(movie);
+            if (loadedFromCache) {
+                movie->deleteLater();
+            } else {
+                obsoleteMovies.append(movie);
+            }
+        }
+    }
+
+    if (loadedFromCache) {
+        loadCachedMovieData(keptMovies, Settings::instance()->advanced()->lazyMovieLoading());
+        newMovies.append(keptMovies);
+    }
+
+    MovieContents con;
+    con.path = rootPath;
+    con.inSeparateFolder = movieDir.separateFolders;
+    con.contents = journal.contents();
+    QVector<MovieContents> moviesContent{con};
+    int movieSum = journal.contents().count();
+    newMovies.append(
+        loadAndStoreMoviesContents(moviesContent, journal.bluRays(), journal.dvds(), movieSum, movieCounter));
+
+    if (!m_aborted) {
+        database->setMovieDirectorySnapshots(rootDir, journal.current());
+    }
+}
+
+void MovieFileSearcher::moveMovieDirectory(Movie& movie, const QString& oldDir, const QString& newDir)
+{
+    const auto movePath = [&oldDir, &newDir](const QString& path) {
+        if (path == oldDir || path.startsWith(oldDir + "/")) {
+            return newDir + path.mid(oldDir.length());
+        }
+        return path;
+    };
+
+    QStringList files;
+    for (const FilePath& file : movie.files()) {
+        files << movePath(file.toString());
+    }
+    // Subtitle files are relative to the movie's directory and don't have to be changed.
+    movie.setFiles(files);
+}
+
+/// \brief Lists all movie files directly inside the given directory.
+/// Uses the same rules as loadMoviesFromDirectory().
+QStringList MovieFileSearcher::movieFilesInDirectory(const QString& path, DirectoryJournal& journal)
+{
+    const QString dirName = QFileInfo(path).fileName();
+    if (Settings::instance()->advanced()->isFolderExcluded(dirName) || isSkippedMovieFolder(dirName)) {
+        return {};
+    }
+
+    QStringList files;
+    const auto& filters = Settings::instance()->advanced()->movieFilters();
+    const QFileInfoList entries = QDir(path).entryInfoList(QDir::Files);
+    for (const QFileInfo& entry : entries) {
+        const QString fileName = entry.fileName();
+        if (!filters.matches(fileName) || Settings::instance()->advanced()->isFileExcluded(fileName)
+            || isMovieExtraFile(fileName)) {
+            continue;
+        }
+
+        if (QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+            if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0) {
+                // Skip BluRay backup folder
+                continue;
+            }
+            const bool isBdmv = (QString::compare(dirName, "BDMV", Qt::CaseInsensitive) == 0);
+            journal.addBluRay(isBdmv ? parentDirectory(path) : path);
+        }
+        if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
+            const bool isVideoTs = (QString::compare(dirName, "VIDEO_TS", Qt::CaseInsensitive) == 0);
+            journal.addDvd(isVideoTs ? parentDirectory(path) : path);
+        }
+
+        files << entry.filePath();
+        m_lastModifications.insert(entry.filePath(), entry.lastModified());
+    }
+    return files;
+}
+
 Movie* MovieFileSearcher::loadMovieData(Movie* movie)
 {
     movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
     return movie;
 }
 
+void MovieFileSearcher::loadCachedMovieData(const QVector<Movie*>& movies, bool writeSummaries)
+{
+    QVector<Movie*> moviesToLoad;
+    for (Movie* movie : movies) {
+        if (!movie->controller()->detailsPending()) {
+            moviesToLoad.append(movie);
+        }
+    }
+    QtConcurrent::blockingMapped(moviesToLoad, MovieFileSearcher::loadMovieData);
+    if (writeSummaries) {
+        // These movies had no summary yet, e.g. because the cache was written by an older version.
+        Manager::instance()->database()->updateMovieSummaries(moviesToLoad);
+    }
+}
+
+void MovieFileSearcher::setProcessEvents(bool enabled)
+{
+    m_processEvents = enabled;
+    m_walker.setProcessEvents(enabled);
+}
+
+void MovieFileSearcher::processEvents()
+{
+    if (m_processEvents) {
+        QApplication::processEvents();
+    }
+}
+
 void MovieFileSearcher::setMovieDirectories(const QVector<SettingsDir>& directories)
 {
     m_directories.clear();
@@ -240,146 +527,204 @@ QStringList MovieFileSearcher::getFiles(QString path)
     return files;
 }
 
-int MovieFileSearcher::loadMoviesFromDirectory(const SettingsDir& movieDir,
-    bool force,
-    QVector<MovieContents>& moviesContent,
-    QVector<Movie*>& dbMovies,
-    QStringList& bluRays,
-    QStringList& dvds)
+int MovieFileSearcher::loadMoviesFromDatabase(const SettingsDir& movieDir, bool force, QVector<Movie*>& dbMovies)
 {
-    QString path = movieDir.path.path();
-    int movieSum = 0;
+    if (movieDir.autoReload || force) {
+        return 0;
+    }
+    QVector<Movie*> moviesFromDb = Manager::instance()->database()->moviesInDirectory(
+        movieDir.path.path(), Settings::instance()->advanced()->lazyMovieLoading());
+    dbMovies.append(moviesFromDb);
+    return moviesFromDb.count();
+}
 
-    QVector<Movie*> moviesFromDb;
-    if (!movieDir.autoReload && !force) {
-        moviesFromDb = Manager::instance()->database()->moviesInDirectory(path);
+QMap<QString, QFileInfoList> MovieFileSearcher::listMovieDirectories(const QVector<SettingsDir>& directories)
+{
+    QMap<QString, QFileInfoList> listings;
+    const auto& filters = Settings::instance()->advanced()->movieFilters();
+    // No filter, no media files...
+    if (directories.isEmpty() || !filters.hasFilter()) {
+        return listings;
     }
 
-    if (!movieDir.autoReload && !force && moviesFromDb.count() != 0) {
-        dbMovies.append(moviesFromDb);
-        return moviesFromDb.count();
+    QStringList roots;
+    for (const auto& movieDir : directories) {
+        qDebug() << "Scanning directory: " << movieDir.path;
+        roots << movieDir.path.path();
     }
+    emit currentDir(roots.first());
+    processEvents();
+
+    QMutex mutex;
+    QSet<QString> visitedLinks;
+    m_walker.walk(roots, [&](const QString& path) {
+        QStringList subDirs;
+        QFileInfoList entries;
+        // Directories are not filtered by name so that we can descend into them.
+        // Files are filtered here using the precompiled filters instead of QDir's name filters.
+        const QFileInfoList allEntries = QDir(path).entryInfoList(QDir::AllDirs | QDir::Files | QDir::NoDotAndDotDot);
+        for (const QFileInfo& entry : allEntries) {
+            if (entry.isDir()) {
+                if (entry.isSymLink()) {
+                    // Avoid symlink loops
+                    const QString target = entry.canonicalFilePath();
+                    QMutexLocker locker(&mutex);
+                    if (visitedLinks.contains(target)) {
+                        continue;
+                    }
+                    visitedLinks.insert(target);
+                }
+                subDirs << entry.filePath();
+                if (!filters.matches(entry.fileName())) {
+                    continue;
+                }
+            } else if (filters.matches(entry.fileName())) {
+                // stat() the file on the worker thread; QFileInfo caches the result.
+                entry.lastModified();
+            } else {
+                continue;
+            }
+            entries << entry;
+        }
+        QMutexLocker locker(&mutex);
+        listings.insert(path, entries);
+        return subDirs;
+    });
+
+    return listings;
+}
+
+int MovieFileSearcher::loadMoviesFromDirectory(const SettingsDir& movieDir,
+    const QMap<QString, QFileInfoList>& listings,
+    QVector<MovieContents>& moviesContent,
+    QStringList& bluRays,
+    QStringList& dvds)
+{
+    const QString path = movieDir.path.path();
 
     emit currentDir(path);
-    QApplication::processEvents();
+    processEvents();
     Manager::instance()->database()->clearMoviesInDirectory(path);
-    QMap<QString, QStringList> contents;
     // No filter, no media files...
     if (!Settings::instance()->advanced()->movieFilters().hasFilter()) {
-        return movieSum;
+        return 0;
     }
 
-    qDebug() << "Scanning directory: " << movieDir.path;
-    QString lastDir;
-    QDirIterator it(path,
-        Settings::instance()->advanced()->movieFilters().filters(),
-        QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
-        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
-
-    while (it.hasNext()) {
-        if (m_aborted) {
-            return movieSum;
-        }
-        it.next();
+    const QMap<QString, QStringList> contents = collectMovieFiles(path, listings, bluRays, dvds);
+    if (m_aborted) {
+        return 0;
+    }
 
-        QString dirName = it.fileInfo().dir().dirName();
-        QString fileName = it.fileName(); // may actually be a directory name
+    MovieContents con;
+    con.path = path;
+    con.inSeparateFolder = movieDir.separateFolders;
+    con.contents = contents;
+    moviesContent.append(con);
+    return contents.count();
+}
 
-        const bool isFile = it.fileInfo().isFile();
-        const bool isDir = it.fileInfo().isDir();
-        bool isSpecialDir = false; // set to true for DVD or BluRay Structure
+QMap<QString, QStringList> MovieFileSearcher::scanMovieDirectory(const SettingsDir& movieDir,
+    QStringList& bluRays,
+    QStringList& dvds)
+{
+    const QMap<QString, QFileInfoList> listings = listMovieDirectories({movieDir});
+    return collectMovieFiles(movieDir.path.path(), listings, bluRays, dvds);
+}
 
-        if (isFile && Settings::instance()->advanced()->isFileExcluded(fileName)) {
-            continue;
-        }
-        // TODO: If there is a BluRay structure then the directory filter may not work
-        // because BDMV's parent directory is not listed.
-        if ((isDir && Settings::instance()->advanced()->isFolderExcluded(fileName))
-            || Settings::instance()->advanced()->isFolderExcluded(dirName)) {
+QMap<QString, QStringList> MovieFileSearcher::collectMovieFiles(const QString& path,
+    const QMap<QString, QFileInfoList>& listings,
+    QStringList& bluRays,
+    QStringList& dvds)
+{
+    QMap<QString, QStringList> contents;
+    QString lastDir;
+    const QString subDirPrefix = path.endsWith('/') ? path : path + '/';
+    // Listings are sorted by path; all sub-directories of "path" follow it.
+    for (auto listing = listings.lowerBound(path); listing != listings.constEnd(); ++listing) {
+        const QString& dirPath = listing.key();
+        if (!dirPath.startsWith(path)) {
+            break;
+        }
+        if (dirPath != path && !dirPath.startsWith(subDirPrefix)) {
             continue;
         }
+        const QString dirName = QDir(dirPath).dirName();
+        // Checked once per directory instead of once per entry.
+        const bool isDirExcluded = Settings::instance()->advanced()->isFolderExcluded(dirName);
 
-        // Skips Extras files
-        if (isFile
-            && (fileName.contains("-trailer", Qt::CaseInsensitive)            //
-                || fileName.contains("-sample", Qt::CaseInsensitive)          //
-                || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
-                || fileName.contains("-deleted", Qt::CaseInsensitive)         //
-                || fileName.contains("-featurette", Qt::CaseInsensitive)      //
-                || fileName.contains("-interview", Qt::CaseInsensitive)       //
-                || fileName.contains("-scene", Qt::CaseInsensitive)           //
-                || fileName.contains("-short", Qt::CaseInsensitive))) {
-            continue;
-        }
+        for (const QFileInfo& entry : listing.value()) {
+            if (m_aborted) {
+                return contents;
+            }
 
-        // Skip actors folder and all files inside it
-        if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            QString fileName = entry.fileName(); // may actually be a directory name
 
-        // Skip extras folder and all files inside it
-        if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            const bool isFile = entry.isFile();
+            const bool isDir = entry.isDir();
+            bool isSpecialDir = false; // set to true for DVD or BluRay Structure
 
-        // Skip extra fanarts folder and all files inside it
-        if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            if (isFile && Settings::instance()->advanced()->isFileExcluded(fileName)) {
+                continue;
+            }
+            // TODO: If there is a BluRay structure then the directory filter may not work
+            // because BDMV's parent directory is not listed.
+            if (isDirExcluded || (isDir && Settings::instance()->advanced()->isFolderExcluded(fileName))) {
+                continue;
+            }
 
-        // Skip extra thumbs folder and all files inside it
-        if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            // Skips Extras files
+            if (isFile && isMovieExtraFile(fileName)) {
+                continue;
+            }
 
-        // Skip BluRay backup folder
-        if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
-            && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            // Skip actors, extras, extra fanarts and extra thumbs folder and all files inside them
+            if (isSkippedMovieFolder(dirName)) {
+                continue;
+            }
 
-        if (dirName != lastDir) {
-            lastDir = dirName;
-            if (contents.count() % 20 == 0) {
-                emit currentDir(dirName);
+            // Skip BluRay backup folder
+            if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
+                && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+                continue;
             }
-        }
 
-        if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            qDebug() << "[MovieFileSearcher] Found BluRay structure";
-            QDir bluRayDir(it.fileInfo().dir());
-            if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
-                bluRayDir.cdUp();
+            if (dirName != lastDir) {
+                lastDir = dirName;
+                if (contents.count() % 20 == 0) {
+                    emit currentDir(dirName);
+                }
             }
-            bluRays << bluRayDir.path();
-            isSpecialDir = true;
-        }
-        if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
-            qDebug() << "[MovieFileSearcher] Found DVD structure";
-            QDir videoDir(it.fileInfo().dir());
-            if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
-                videoDir.cdUp();
+
+            if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+                qDebug() << "[MovieFileSearcher] Found BluRay structure";
+                QDir bluRayDir(entry.dir());
+                if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
+                    bluRayDir.cdUp();
+                }
+                bluRays << bluRayDir.path();
+                isSpecialDir = true;
+            }
+            if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
+                qDebug() << "[MovieFileSearcher] Found DVD structure";
+                QDir videoDir(entry.dir());
+                if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
+                    videoDir.cdUp();
+                }
+                dvds << videoDir.path();
+                isSpecialDir = true;
             }
-            dvds << videoDir.path();
-            isSpecialDir = true;
-        }
 
-        const QString dirPath = it.fileInfo().path();
-        if (!contents.contains(dirPath)) {
-            contents.insert(dirPath, {});
-        }
-        if (isFile || isSpecialDir) {
-            contents[dirPath].append(it.filePath());
-            m_lastModifications.insert(it.filePath(), it.fileInfo().lastModified());
+            if (!contents.contains(dirPath)) {
+                contents.insert(dirPath, {});
+            }
+            if (isFile || isSpecialDir) {
+                contents[dirPath].append(entry.filePath());
+                m_lastModifications.insert(entry.filePath(), entry.lastModified());
+            }
         }
     }
 
-    MovieContents con;
-    con.path = path;
-    con.inSeparateFolder = movieDir.separateFolders;
-    con.contents = contents;
-    moviesContent.append(con);
-    return contents.count();
+    return contents;
 }
 
 QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileSearcher::MovieContents>& moviesContent,
@@ -388,13 +733,16 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
     int& movieSum,
     int& movieCounter)
 {
+    // Movies are written by the database thread in batches so that the scan isn't blocked.
+    constexpr int writeBatchSize = 200;
+    Database* database = Manager::instance()->database();
     QVector<Movie*> movies;
     for (const MovieContents& con : moviesContent) {
-        Manager::instance()->database()->transaction();
+        QVector<Movie*> unsavedMovies;
         QMapIterator<QString, QStringList> itContents(con.contents);
         while (itContents.hasNext()) {
             if (m_aborted) {
-                Manager::instance()->database()->commit();
+                database->addAsync(unsavedMovies, con.path);
                 return movies;
             }
             itContents.next();
@@ -445,7 +793,7 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
                 movie->setInSeparateFolder(con.inSeparateFolder);
                 movie->setFileLastModified(m_lastModifications.value(files.at(0)));
                 movie->setDiscType(discType);
-                movie->setLabel(Manager::instance()->database()->getLabel(movie->files()));
+                movie->setLabel(database->getLabel(movie->files()));
                 movie->setChanged(false);
                 movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
                 if (discType == DiscType::Single) {
@@ -479,7 +827,7 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
                         movie->addSubtitle(subtitle, true);
                     }
                 }
-                Manager::instance()->database()->add(movie, con.path);
+                unsavedMovies.append(movie);
                 movies.append(movie);
                 // emit currentDir(movie->name());
             } else {
@@ -513,18 +861,22 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
                     movie->setInSeparateFolder(con.inSeparateFolder);
                     movie->setFileLastModified(m_lastModifications.value(it.value().at(0)));
                     movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
-                    movie->setLabel(Manager::instance()->database()->getLabel(movie->files()));
-                    Manager::instance()->database()->add(movie, con.path);
+                    movie->setLabel(database->getLabel(movie->files()));
+                    unsavedMovies.append(movie);
                     movies.append(movie);
                     // emit currentDir(movie->name());
                 }
             }
+            if (unsavedMovies.size() >= writeBatchSize) {
+                database->addAsync(unsavedMovies, con.path);
+                unsavedMovies.clear();
+            }
             emit progress(++movieCounter, movieSum, m_progressMessageId);
             if (movieCounter % 20 == 0) {
                 emit currentDir("");
             }
         }
-        Manager::instance()->database()->commit();
+        database->addAsync(unsavedMovies, con.path);
     }
     return movies;
 }
@@ -532,6 +884,7 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
 void MovieFileSearcher::abort()
 {
     m_aborted = true;
+    m_walker.abort();
 }
 
 } // namespace mediaelch
@@ -1,12 +1,18 @@
 #pragma once
 
+#include "file/DirectoryJournal.h"
+#include "file/DirectoryWalker.h"
 #include "movies/Movie.h"
 
 #include <QDir>
+#include <QFileInfo>
 #include <QHash>
+#include <QMap>
 #include <QObject>
+#include <QSet>
 #include <QTime>
 #include <QVector>
+#include <chrono>
 #include <memory>
 
 namespace mediaelch {
@@ -22,12 +28,44 @@ class MovieFileSearcher : public QObject
 {
     Q_OBJECT
 public:
+    /// \brief Durations and item counts of the stages of reload().
+    struct ReloadStatistics
+    {
+        /// Reading cached movies from the database and listing all other directories
+        std::chrono::milliseconds scan{0};
+        /// Creating movies and reading their NFO files (or cached NFO contents)
+        std::chrono::milliseconds parse{0};
+        int directories = 0;
+        int moviesFromDisk = 0;
+        int moviesFromCache = 0;
+    };
+
     explicit MovieFileSearcher(QObject* parent = nullptr);
     ~MovieFileSearcher() override = default;
 
+    /// \brief Whether events are processed while scanning so that the GUI stays responsive.
+    /// Should be disabled if there is no GUI, e.g. in mediaelch-cli.
+    void setProcessEvents(bool enabled);
+    const ReloadStatistics& lastReloadStatistics() const { return m_statistics; }
+
     /// \brief Sets the directories to scan for movies. Not readable directories are skipped.
     void setMovieDirectories(const QVector<SettingsDir>& directories);
 
+    /// \brief Rewrites the paths of the movie's files below oldDir to newDir.
+    /// Used for directories that were moved since the last scan.
+    static void moveMovieDirectory(Movie& movie, const QString& oldDir, const QString& newDir);
+
+    /// \brief Loads cached movies from their NFO contents in parallel. Movies that
+    ///        were loaded from their summary only are skipped, see lazyMovieLoading.
+    /// \param writeSummaries Write the summary of loaded movies, e.g. for rows of
+    ///        an older cache that has no summaries yet.
+    static void loadCachedMovieData(const QVector<Movie*>& movies, bool writeSummaries);
+
+    /// \brief Lists the movie files of the given directory and all its sub-directories.
+    /// Same as what reload() finds on disk, but neither creates movies nor touches the database.
+    /// \return Movie files keyed by the directory that contains them.
+    QMap<QString, QStringList> scanMovieDirectory(const SettingsDir& movieDir, QStringList& bluRays, QStringList& dvds);
+
     /// \brief Scans the given path for movie files.
     ///
     /// Results are in a list which contains a QStringList for every movie.
@@ -46,6 +84,18 @@ public:
 
 public slots:
     void reload(bool force);
+    /// \brief Rescans all movie directories but only lists directories that changed since the last scan.
+    ///
+    /// A snapshot (modification time and inode) of every directory is stored in the database.
+    /// Only new or changed directories are listed again; unchanged directories are only
+    /// stat()ed to find changes further down the tree.  Movies in unchanged directories are
+    /// kept, movies in moved directories get their new paths and only movies in new or changed
+    /// directories are loaded again.  Differences are applied to the MovieModel instead of
+    /// rebuilding it.
+    ///
+    /// \note Directory modification times do not change if a file is modified in-place.
+    ///       Use reload() to pick up such changes.
+    void reloadIncremental();
     void abort();
 
 signals:
@@ -65,13 +115,28 @@ private:
     static Movie* loadMovieData(Movie* movie);
 
     QStringList getFiles(QString path);
+    void processEvents();
 
+    int loadMoviesFromDatabase(const SettingsDir& movieDir, bool force, QVector<Movie*>& dbMovies);
+    /// \brief Lists all given directories recursively and in parallel.
+    /// \return Directory listings keyed by directory path. Only entries matching the movie filters are listed.
+    QMap<QString, QFileInfoList> listMovieDirectories(const QVector<SettingsDir>& directories);
     int loadMoviesFromDirectory(const SettingsDir& movieDir,
-        bool force,
+        const QMap<QString, QFileInfoList>& listings,
         QVector<MovieContents>& moviesContent,
-        QVector<Movie*>& dbMovies,
         QStringList& bluRays,
         QStringList& dvds);
+    /// \brief Groups the listed movie files of the given directory by directory and
+    ///        finds DVD and BluRay structures.  Excluded and extra files are skipped.
+    QMap<QString, QStringList> collectMovieFiles(const QString& path,
+        const QMap<QString, QFileInfoList>& listings,
+        QStringList& bluRays,
+        QStringList& dvds);
+    void rescanMovieDirectory(const SettingsDir& movieDir,
+        QVector<Movie*>& newMovies,
+        QVector<Movie*>& obsoleteMovies,
+        int& movieCounter);
+    QStringList movieFilesInDirectory(const QString& path, DirectoryJournal& journal);
     QVector<Movie*> loadAndStoreMoviesContents(QVector<MovieContents>& moviesContent,
         QStringList& bluRays,
         QStringList& dvds,
@@ -81,7 +146,10 @@ private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
     QHash<QString, QDateTime> m_lastModifications;
+    mediaelch::DirectoryWalker m_walker;
     bool m_aborted;
+    bool m_processEvents = true;
+    ReloadStatistics m_statistics;
 };
 
 } // namespace mediaelch
@@ -1,8 +1,11 @@
 #include "MusicFileSearcher.h"
 
 #include <QDebug>
-#include <QDirIterator>
+#include <QDir>
 #include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
 #include <QtConcurrent>
 
 #include "globals/Manager.h"
@@ -54,6 +57,7 @@ void MusicFileSearcher::reload(bool force)
 
     QMap<Artist*, QString> artistPaths;
     QMap<Album*, QString> albumPaths;
+    QVector<SettingsDir> directoriesToScan;
     for (const SettingsDir& dir : m_directories) {
         if (m_aborted) {
             break;
@@ -64,47 +68,7 @@ void MusicFileSearcher::reload(bool force)
         }
 
         if (dir.autoReload || force) {
-            QDirIterator it(dir.path.path(), QDir::NoDotAndDotDot | QDir::Dirs, QDirIterator::FollowSymlinks);
-            while (it.hasNext()) {
-                if (m_aborted) {
-                    break;
-                }
-
-                it.next();
-
-                if (Settings::instance()->advanced()->isFolderExcluded(it.fileInfo().dir().dirName())) {
-                    continue;
-                }
-
-                emit currentDir(it.fileInfo().baseName());
-                auto* artist = new Artist(it.filePath(), this);
-                artist->setName(it.fileInfo().baseName());
-                artists.append(artist);
-                artistPaths.insert(artist, dir.path.path());
-
-                QDirIterator itAlbums(it.filePath(), QDir::NoDotAndDotDot | QDir::Dirs, QDirIterator::FollowSymlinks);
-                while (itAlbums.hasNext()) {
-                    itAlbums.next();
-
-                    if (Settings::instance()->advanced()->isFolderExcluded(itAlbums.fileInfo().dir().dirName())) {
-                        continue;
-                    }
-
-                    if (itAlbums.fileInfo().baseName() == "extrafanart") {
-                        continue;
-                    }
-                    if (itAlbums.fileInfo().baseName() == "extrathumbs") {
-                        continue;
-                    }
-
-                    auto* album = new Album(itAlbums.filePath(), this);
-                    album->setTitle(itAlbums.fileInfo().baseName());
-                    album->setArtistObj(artist);
-                    artist->addAlbum(album);
-                    albums.append(album);
-                    albumPaths.insert(album, dir.path.path());
-                }
-            }
+            directoriesToScan.append(dir);
         } else {
             QVector<Artist*> artistsInPath = Manager::instance()->database()->artistsInDirectory(dir.path);
             for (Artist* artist : artistsInPath) {
@@ -118,6 +82,55 @@ void MusicFileSearcher::reload(bool force)
         }
     }
 
+    // All directories that can't be loaded from the database are listed in parallel.
+    QStringList roots;
+    for (const SettingsDir& dir : directoriesToScan) {
+        roots << dir.path.path();
+    }
+    const QMap<QString, QFileInfoList> listings = listMusicDirectories(roots);
+
+    for (const SettingsDir& dir : directoriesToScan) {
+        if (m_aborted) {
+            break;
+        }
+
+        for (const QFileInfo& artistDir : listings.value(dir.path.path())) {
+            if (m_aborted) {
+                break;
+            }
+
+            if (Settings::instance()->advanced()->isFolderExcluded(artistDir.dir().dirName())) {
+                continue;
+            }
+
+            emit currentDir(artistDir.baseName());
+            auto* artist = new Artist(artistDir.filePath(), this);
+            artist->setName(artistDir.baseName());
+            artists.append(artist);
+            artistPaths.insert(artist, dir.path.path());
+
+            for (const QFileInfo& albumDir : listings.value(artistDir.filePath())) {
+                if (Settings::instance()->advanced()->isFolderExcluded(albumDir.dir().dirName())) {
+                    continue;
+                }
+
+                if (albumDir.baseName() == "extrafanart") {
+                    continue;
+                }
+                if (albumDir.baseName() == "extrathumbs") {
+                    continue;
+                }
+
+                auto* album = new Album(albumDir.filePath(), this);
+                album->setTitle(albumDir.baseName());
+                album->setArtistObj(artist);
+                artist->addAlbum(album);
+                albums.append(album);
+                albumPaths.insert(album, dir.path.path());
+            }
+        }
+    }
+
     emit currentDir("");
     emit searchStarted(tr("Loading Music..."));
 
@@ -179,6 +192,31 @@ void MusicFileSearcher::reload(bool force)
 void MusicFileSearcher::abort()
 {
     m_aborted = true;
+    m_walker.abort();
+}
+
+QMap<QString, QFileInfoList> MusicFileSearcher::listMusicDirectories(const QStringList& roots)
+{
+    QMutex mutex;
+    QMap<QString, QFileInfoList> listings;
+    // Music directories contain artists which contain albums; nothing below is of interest.
+    QSet<QString> rootSet;
+    for (const QString& root : roots) {
+        rootSet.insert(root);
+    }
+    m_walker.walk(roots, [&](const QString& path) {
+        const QFileInfoList entries = QDir(path).entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs);
+        QStringList artistDirs;
+        if (rootSet.contains(path)) {
+            for (const QFileInfo& entry : entries) {
+                artistDirs << entry.filePath();
+            }
+        }
+        QMutexLocker locker(&mutex);
+        listings.insert(path, entries);
+        return artistDirs;
+    });
+    return listings;
 }
 
 Artist* MusicFileSearcher::loadArtistData(Artist* artist)
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "file/DirectoryWalker.h"
 #include "globals/Globals.h"
 
+#include <QFileInfo>
+#include <QMap>
 #include <QObject>
 
 class Album;
@@ -29,7 +32,12 @@ signals:
     void currentDir(QString);
 
 private:
+    /// \brief Lists artist directories and their album directories in parallel.
+    /// \return Sub-directories keyed by directory path.
+    QMap<QString, QFileInfoList> listMusicDirectories(const QStringList& roots);
+
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
+    mediaelch::DirectoryWalker m_walker;
     bool m_aborted;
 };
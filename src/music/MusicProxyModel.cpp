@@ -1,6 +1,13 @@
 #include "music/MusicProxyModel.h"
 
 #include "globals/Globals.h"
+#include "globals/Manager.h"
+#include "music/MusicModel.h"
+#include "music/Album.h"
+#include "music/Artist.h"
+#include "music/MusicModelItem.h"
+
+#include <QRegularExpression>
 
 MusicProxyModel::MusicProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
@@ -24,19 +31,19 @@ bool MusicProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right
         return false;
     }
 
-    bool ret = (QString::localeAwareCompare(leftTitle, rightTitle) < 0);
+    bool ret = (m_collationKeys.compare(leftTitle, rightTitle) < 0);
     return ret;
 }
 
 bool MusicProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
 {
-    if (QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent)) {
+    if (filterAcceptsRowItself(sourceRow, sourceParent)) {
         return true;
     }
 
     QModelIndex parent = sourceParent;
     while (parent.isValid()) {
-        if (QSortFilterProxyModel::filterAcceptsRow(parent.row(), parent.parent())) {
+        if (filterAcceptsRowItself(parent.row(), parent.parent())) {
             return true;
         }
         parent = parent.parent();
@@ -49,6 +56,31 @@ void MusicProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = filters;
     m_filterText = text;
+
+    // Same text as the wildcard set by MusicFilesWidget.
+    const QString query = m_filters.isEmpty() ? m_filterText : m_filters.first()->shortText();
+    m_useSearchHits = !query.isEmpty() && !query.contains(QRegularExpression("[*?\\[]"));
+    m_searchHits.clear();
+    if (m_useSearchHits) {
+        mediaelch::MediaSearchIndex* index = Manager::instance()->searchIndex();
+        index->addArtists(Manager::instance()->musicModel()->artists());
+        m_searchHits = index->search(query, mediaelch::MediaSearchIndex::Field::Title);
+    }
+}
+
+bool MusicProxyModel::filterAcceptsRowItself(int sourceRow, const QModelIndex& sourceParent) const
+{
+    if (m_useSearchHits) {
+        auto* model = dynamic_cast<MusicModel*>(sourceModel());
+        MusicModelItem* item = model->getItem(model->index(sourceRow, 0, sourceParent));
+        if (item->type() == MusicType::Artist) {
+            return m_searchHits.contains(item->artist());
+        }
+        if (item->type() == MusicType::Album) {
+            return m_searchHits.contains(item->album());
+        }
+    }
+    return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
 }
 
 bool MusicProxyModel::hasAcceptedChildren(int sourceRow, const QModelIndex& sourceParent) const
@@ -63,7 +95,7 @@ bool MusicProxyModel::hasAcceptedChildren(int sourceRow, const QModelIndex& sour
     }
 
     for (int i = 0, n = index.model()->rowCount(index); i < n; ++i) {
-        if (QSortFilterProxyModel::filterAcceptsRow(i, index)) {
+        if (filterAcceptsRowItself(i, index)) {
             return true;
         }
     }
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "globals/CollationKeys.h"
 #include "globals/Filter.h"
 
 #include <QObject>
+#include <QSet>
 #include <QSortFilterProxyModel>
 #include <QString>
 #include <QVector>
@@ -23,6 +25,11 @@ protected:
 private:
     QVector<Filter*> m_filters;
     QString m_filterText;
+    mutable mediaelch::CollationKeyCache m_collationKeys;
+    /// Artists and albums whose title contains the filter text, see MediaSearchIndex.
+    QSet<const QObject*> m_searchHits;
+    bool m_useSearchHits = false;
 
+    bool filterAcceptsRowItself(int sourceRow, const QModelIndex& sourceParent) const;
     bool hasAcceptedChildren(int sourceRow, const QModelIndex& sourceParent) const;
 };
@@ -0,0 +1,283 @@
+#include "network/HttpDiskCache.h"
+
+#include "settings/Settings.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLockFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace {
+
+constexpr quint32 CACHE_FILE_MAGIC = 0x4d454843; // "MEHC"
+constexpr qint32 CACHE_FILE_VERSION = 1;
+
+constexpr qint64 ONE_DAY = 24 * 60 * 60;
+
+/// Sub-directory for the counters, so that they are neither counted nor pruned as cache entries.
+constexpr char STATISTICS_DIR[] = "statistics";
+/// Wait at most this long for another process that updates the counters.
+constexpr int COUNTERS_LOCK_TIMEOUT_MS = 1000;
+
+struct HostPolicy
+{
+    const char* host;
+    qint64 timeToLive;
+};
+
+// APIs with stable, versioned responses can be cached longer than HTML pages.
+// Subdomains match as well, e.g. "www.imdb.com" matches "imdb.com".
+const HostPolicy hostPolicies[] = {
+    {"api.themoviedb.org", 3 * ONE_DAY},
+    {"api.thetvdb.com", 3 * ONE_DAY},
+    {"api.tvmaze.com", 3 * ONE_DAY},
+    {"musicbrainz.org", 7 * ONE_DAY},
+    {"theaudiodb.com", 7 * ONE_DAY},
+    {"imdb.com", ONE_DAY},
+};
+
+} // namespace
+
+namespace mediaelch {
+namespace network {
+
+HttpDiskCache::HttpDiskCache(DirectoryPath cacheDir, qint64 maxSizeBytes) :
+    m_cacheDir{std::move(cacheDir)}, m_maxSize{maxSizeBytes}
+{
+    QDir dir(m_cacheDir.toString());
+    if (!dir.exists() && !dir.mkpath(".")) {
+        qWarning() << "[HttpDiskCache] Could not create cache dir:" << m_cacheDir;
+        m_cacheDir = DirectoryPath{};
+    }
+}
+
+HttpDiskCache* HttpDiskCache::instance()
+{
+    static auto* s_instance = new HttpDiskCache(Settings::instance()->imageCacheDir().subDir("http"));
+    return s_instance;
+}
+
+qint64 HttpDiskCache::timeToLive(const QUrl& url)
+{
+    const QString host = url.host().toLower();
+    for (const HostPolicy& policy : hostPolicies) {
+        const QString policyHost = QString::fromLatin1(policy.host);
+        if (host == policyHost || host.endsWith('.' + policyHost)) {
+            return policy.timeToLive;
+        }
+    }
+    return ONE_DAY;
+}
+
+HttpDiskCache::Entry HttpDiskCache::entry(const QString& key)
+{
+    if (!m_cacheDir.isValid()) {
+        return {};
+    }
+
+    QMutexLocker locker(&m_mutex);
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    qint32 version = 0;
+    in >> magic >> version;
+    if (magic != CACHE_FILE_MAGIC || version != CACHE_FILE_VERSION) {
+        return {};
+    }
+
+    QString storedKey;
+    Entry entry;
+    QByteArray data;
+    in >> storedKey >> entry.date >> entry.eTag >> entry.lastModified >> data;
+    if (in.status() != QDataStream::Ok || storedKey != key) {
+        // Corrupt file or hash collision
+        return {};
+    }
+    entry.data = qUncompress(data);
+    return entry;
+}
+
+void HttpDiskCache::store(const QString& key, const Entry& entry)
+{
+    if (!m_cacheDir.isValid() || !entry.isValid()) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    ensureSizeIsKnown();
+
+    const QString path = filePath(key);
+    const qint64 oldSize = QFileInfo(path).size();
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[HttpDiskCache] Could not write cache file:" << path;
+        return;
+    }
+    QDataStream out(&file);
+    out << CACHE_FILE_MAGIC << CACHE_FILE_VERSION;
+    out << key << entry.date << entry.eTag << entry.lastModified << qCompress(entry.data);
+    if (!file.commit()) {
+        qWarning() << "[HttpDiskCache] Could not write cache file:" << path;
+        return;
+    }
+
+    m_currentSize += QFileInfo(path).size() - oldSize;
+    if (m_currentSize > m_maxSize) {
+        prune();
+    }
+}
+
+void HttpDiskCache::remove(const QString& key)
+{
+    if (!m_cacheDir.isValid()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    ensureSizeIsKnown();
+    QFile file(filePath(key));
+    const qint64 fileSize = file.size();
+    if (file.remove()) {
+        m_currentSize -= fileSize;
+    }
+}
+
+void HttpDiskCache::clear()
+{
+    if (!m_cacheDir.isValid()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    QDir dir(m_cacheDir.toString());
+    for (const QString& fileName : dir.entryList(QDir::Files)) {
+        dir.remove(fileName);
+    }
+    m_currentSize = 0;
+}
+
+qint64 HttpDiskCache::size()
+{
+    QMutexLocker locker(&m_mutex);
+    ensureSizeIsKnown();
+    return m_currentSize;
+}
+
+void HttpDiskCache::addToCounters(const Counters& increments)
+{
+    if (!m_cacheDir.isValid() || increments.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_countersMutex);
+    QDir().mkpath(m_cacheDir.subDir(STATISTICS_DIR).toString());
+    // Other processes may update the counters at the same time.
+    QLockFile lock(countersFilePath() + ".lock");
+    if (!lock.tryLock(COUNTERS_LOCK_TIMEOUT_MS)) {
+        qWarning() << "[HttpDiskCache] Could not lock the cache statistics:" << lock.error();
+        return;
+    }
+    Counters values = counters();
+    for (auto it = increments.cbegin(); it != increments.cend(); ++it) {
+        values[it.key()] += it.value();
+    }
+    writeCounters(values);
+}
+
+HttpDiskCache::Counters HttpDiskCache::counters()
+{
+    if (!m_cacheDir.isValid()) {
+        return {};
+    }
+    QFile file(countersFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    // The file is replaced atomically; no lock is needed for reading.
+    Counters values;
+    const QJsonObject object = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        values.insert(it.key(), static_cast<quint64>(it.value().toDouble()));
+    }
+    return values;
+}
+
+void HttpDiskCache::resetCounters()
+{
+    if (!m_cacheDir.isValid()) {
+        return;
+    }
+    QMutexLocker locker(&m_countersMutex);
+    QDir().mkpath(m_cacheDir.subDir(STATISTICS_DIR).toString());
+    QLockFile lock(countersFilePath() + ".lock");
+    if (!lock.tryLock(COUNTERS_LOCK_TIMEOUT_MS)) {
+        qWarning() << "[HttpDiskCache] Could not lock the cache statistics:" << lock.error();
+        return;
+    }
+    writeCounters({});
+}
+
+QString HttpDiskCache::countersFilePath() const
+{
+    return m_cacheDir.subDir(STATISTICS_DIR).filePath("counters.json");
+}
+
+void HttpDiskCache::writeCounters(const Counters& values)
+{
+    QJsonObject object;
+    for (auto it = values.cbegin(); it != values.cend(); ++it) {
+        // Doubles are exact up to 2^53.
+        object.insert(it.key(), static_cast<double>(it.value()));
+    }
+    QSaveFile file(countersFilePath());
+    if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(object).toJson(QJsonDocument::Compact)) < 0
+        || !file.commit()) {
+        qWarning() << "[HttpDiskCache] Could not write the cache statistics:" << countersFilePath();
+    }
+}
+
+QString HttpDiskCache::filePath(const QString& key) const
+{
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_cacheDir.filePath(QString::fromLatin1(hash));
+}
+
+void HttpDiskCache::ensureSizeIsKnown()
+{
+    if (m_currentSize >= 0) {
+        return;
+    }
+    m_currentSize = 0;
+    const QFileInfoList files = QDir(m_cacheDir.toString()).entryInfoList(QDir::Files);
+    for (const QFileInfo& file : files) {
+        m_currentSize += file.size();
+    }
+}
+
+void HttpDiskCache::prune()
+{
+    // Remove entries until 90% of the maximum size is reached so that
+    // we don't have to prune on every new entry.
+    const qint64 targetSize = m_maxSize / 10 * 9;
+    QDir dir(m_cacheDir.toString());
+    // Oldest files last
+    const QFileInfoList files = dir.entryInfoList(QDir::Files, QDir::Time);
+    for (auto it = files.crbegin(); it != files.crend() && m_currentSize > targetSize; ++it) {
+        if (dir.remove(it->fileName())) {
+            m_currentSize -= it->size();
+        }
+    }
+    qDebug() << "[HttpDiskCache] Pruned cache to" << m_currentSize << "bytes";
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "file/Path.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QUrl>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Persistent, size-bounded cache for HTTP responses.
+///
+/// Every entry is stored in its own file.  Besides the response, the ETag and
+/// Last-Modified headers are stored so that stale entries can be revalidated
+/// using conditional requests.  If the cache exceeds its maximum size, the
+/// least recently written entries are removed.
+///
+/// The cache is thread safe.  Use instance() for the cache shared by all scrapers.
+class HttpDiskCache
+{
+public:
+    struct Entry
+    {
+        QDateTime date;
+        QByteArray eTag;
+        QByteArray lastModified;
+        /// \brief Response body as received from the server.
+        QByteArray data;
+
+        bool isValid() const { return date.isValid(); }
+        bool canBeRevalidated() const { return !eTag.isEmpty() || !lastModified.isEmpty(); }
+    };
+
+    /// \brief Named counters, e.g. hits and misses of the website caches using this cache.
+    using Counters = QMap<QString, quint64>;
+
+    constexpr static qint64 defaultMaxSizeBytes = 256 * 1024 * 1024;
+
+    HttpDiskCache(DirectoryPath cacheDir, qint64 maxSizeBytes = defaultMaxSizeBytes);
+
+    /// \brief Cache in MediaElch's cache directory that is shared by all scrapers.
+    static HttpDiskCache* instance();
+
+    /// \brief Time in seconds for which responses of the given URL's host are
+    ///        considered fresh and are used without asking the server.
+    static qint64 timeToLive(const QUrl& url);
+
+    /// \brief Returns the entry for the given key or an invalid entry if there is none.
+    Entry entry(const QString& key);
+    void store(const QString& key, const Entry& entry);
+    void remove(const QString& key);
+    /// \brief Removes all entries.
+    void clear();
+
+    qint64 maxSize() const { return m_maxSize; }
+    /// \brief Current size of all cache files in bytes.
+    qint64 size();
+
+    /// \brief Adds the given values to the persistent counters.
+    /// \details Counters are stored next to the cache entries so that all processes
+    ///          using the same cache directory, e.g. MediaElch and mediaelch-cli,
+    ///          add to and read the same values.  They are not removed by clear().
+    void addToCounters(const Counters& increments);
+    /// \brief Current values of all persistent counters.
+    Counters counters();
+    void resetCounters();
+
+private:
+    QString filePath(const QString& key) const;
+    QString countersFilePath() const;
+    void writeCounters(const Counters& values);
+    void ensureSizeIsKnown();
+    /// \brief Removes the least recently written entries until the cache is below its maximum size.
+    void prune();
+
+    DirectoryPath m_cacheDir;
+    qint64 m_maxSize = defaultMaxSizeBytes;
+    qint64 m_currentSize = -1;
+    QMutex m_mutex;
+    /// Counters are written outside of m_mutex so that cache lookups don't wait for other processes.
+    QMutex m_countersMutex;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -13,6 +13,7 @@ enum class HttpStatusCode : int
     // Redirection
     MovedPermanently = 301,
     Found = 302,
+    NotModified = 304,
 
     TooManyRequests = 429
 };
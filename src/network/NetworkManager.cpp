@@ -2,6 +2,18 @@
 
 #include "network/NetworkReplyWatcher.h"
 
+#include <atomic>
+#include <memory>
+
+namespace {
+
+// Counters of all NetworkManager instances
+std::atomic<quint64> s_requests{0};
+std::atomic<quint64> s_failedRequests{0};
+std::atomic<qint64> s_bytesReceived{0};
+
+} // namespace
+
 namespace mediaelch {
 namespace network {
 
@@ -14,26 +26,55 @@ NetworkManager::NetworkManager(QObject* parent) : QObject(parent)
     // clang-format on
 }
 
+NetworkManager::Statistics NetworkManager::statistics()
+{
+    Statistics stats;
+    stats.requests = s_requests;
+    stats.failedRequests = s_failedRequests;
+    stats.bytesReceived = s_bytesReceived;
+    return stats;
+}
+
+void NetworkManager::countRequest(QNetworkReply* reply)
+{
+    ++s_requests;
+    // downloadProgress() reports the total number of bytes received so far.
+    auto received = std::make_shared<qint64>(0);
+    connect(reply, &QNetworkReply::downloadProgress, reply, [received](qint64 bytesReceived, qint64 /*bytesTotal*/) {
+        s_bytesReceived += bytesReceived - *received;
+        *received = bytesReceived;
+    });
+    connect(reply, &QNetworkReply::finished, reply, [reply]() {
+        if (reply->error() != QNetworkReply::NoError) {
+            ++s_failedRequests;
+        }
+    });
+}
+
 QNetworkReply* NetworkManager::get(const QNetworkRequest& request)
 {
-    return m_qnam.get(request);
+    QNetworkReply* reply = m_qnam.get(request);
+    countRequest(reply);
+    return reply;
 }
 
 QNetworkReply* NetworkManager::getWithWatcher(const QNetworkRequest& request)
 {
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = get(request);
     new NetworkReplyWatcher(this, reply);
     return reply;
 }
 
 QNetworkReply* NetworkManager::post(const QNetworkRequest& request, const QByteArray& data)
 {
-    return m_qnam.post(request, data);
+    QNetworkReply* reply = m_qnam.post(request, data);
+    countRequest(reply);
+    return reply;
 }
 
 QNetworkReply* NetworkManager::postWithWatcher(const QNetworkRequest& request, const QByteArray& data)
 {
-    QNetworkReply* reply = m_qnam.post(request, data);
+    QNetworkReply* reply = post(request, data);
     new NetworkReplyWatcher(this, reply);
     return reply;
 }
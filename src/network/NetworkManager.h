@@ -14,10 +14,23 @@ namespace network {
 class NetworkManager : public QObject
 {
     Q_OBJECT
+public:
+    /// \brief Counters of all network managers, e.g. for the command line interface.
+    struct Statistics
+    {
+        quint64 requests = 0;
+        quint64 failedRequests = 0;
+        /// \brief Bytes of all response bodies (after decompression).
+        qint64 bytesReceived = 0;
+    };
+
 public:
     explicit NetworkManager(QObject* parent = nullptr);
     ~NetworkManager() override = default;
 
+    /// \brief Statistics accumulated over all NetworkManager instances of this process.
+    static Statistics statistics();
+
 public:
     QNetworkReply* get(const QNetworkRequest& request);
     QNetworkReply* getWithWatcher(const QNetworkRequest& request);
@@ -29,6 +42,9 @@ signals:
     void authenticationRequired(QNetworkReply* reply, QAuthenticator* authenticator);
     void finished(QNetworkReply* reply);
 
+private:
+    static void countRequest(QNetworkReply* reply);
+
 private:
     QNetworkAccessManager m_qnam;
 };
@@ -1,21 +1,143 @@
 #include "network/WebsiteCache.h"
 
+#include "network/HttpStatusCodes.h"
+
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QDebug>
 #include <QString>
 #include <QUrl>
 
+#include <atomic>
+#include <iterator>
+
+namespace {
+
+// Counters of all WebsiteCache instances
+std::atomic<quint64> s_memoryHits{0};
+std::atomic<quint64> s_diskHits{0};
+std::atomic<quint64> s_misses{0};
+std::atomic<quint64> s_revalidations{0};
+std::atomic<quint64> s_evictions{0};
+std::atomic<qint64> s_elements{0};
+std::atomic<qint64> s_bytes{0};
+
+// Names of the persistent counters in the disk cache
+const QString MEMORY_HITS = QStringLiteral("websiteCache.memoryHits");
+const QString DISK_HITS = QStringLiteral("websiteCache.diskHits");
+const QString MISSES = QStringLiteral("websiteCache.misses");
+const QString REVALIDATIONS = QStringLiteral("websiteCache.revalidations");
+const QString EVICTIONS = QStringLiteral("websiteCache.evictions");
+
+} // namespace
+
 namespace mediaelch {
 namespace scraper {
 
-WebsiteCache::WebsiteCache()
+WebsiteCache::WebsiteCache() : WebsiteCache(network::HttpDiskCache::instance())
+{
+}
+
+WebsiteCache::WebsiteCache(network::HttpDiskCache* diskCache, qint64 maxMemoryBytes) :
+    m_maxBytes{maxMemoryBytes}, m_diskCache{diskCache}
 {
     QObject::connect(&m_timer, &QTimer::timeout, [this]() { clearOldCacheEntries(); });
+    m_flushTimer.setSingleShot(true);
+    QObject::connect(&m_flushTimer, &QTimer::timeout, [this]() { flushStatistics(); });
+    if (QCoreApplication::instance() != nullptr) {
+        // Caches of scrapers may not be destroyed on exit.
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, &m_flushTimer, [this]() {
+            flushStatistics();
+        });
+    }
+}
+
+WebsiteCache::~WebsiteCache()
+{
+    flushStatistics();
+    s_elements -= m_index.size();
+    s_bytes -= m_bytes;
+}
+
+WebsiteCache::Statistics WebsiteCache::statistics()
+{
+    Statistics stats;
+    stats.memoryHits = s_memoryHits;
+    stats.diskHits = s_diskHits;
+    stats.misses = s_misses;
+    stats.revalidations = s_revalidations;
+    stats.evictions = s_evictions;
+    stats.elements = s_elements;
+    stats.bytes = s_bytes;
+    return stats;
+}
+
+WebsiteCache::Statistics WebsiteCache::persistentStatistics(network::HttpDiskCache* diskCache)
+{
+    Statistics stats;
+    if (diskCache == nullptr) {
+        return stats;
+    }
+    const network::HttpDiskCache::Counters counters = diskCache->counters();
+    stats.memoryHits = counters.value(MEMORY_HITS);
+    stats.diskHits = counters.value(DISK_HITS);
+    stats.misses = counters.value(MISSES);
+    stats.revalidations = counters.value(REVALIDATIONS);
+    stats.evictions = counters.value(EVICTIONS);
+    return stats;
+}
+
+void WebsiteCache::flushStatistics()
+{
+    m_flushTimer.stop();
+    if (m_diskCache == nullptr || m_pendingCounters.isEmpty()) {
+        return;
+    }
+    m_diskCache->addToCounters(m_pendingCounters);
+    m_pendingCounters.clear();
+    m_pendingCount = 0;
+}
+
+void WebsiteCache::countPersistently(const QString& name, quint64 increment)
+{
+    if (m_diskCache == nullptr || increment == 0) {
+        return;
+    }
+    // Writing the counters requires a file lock and a rewrite of the counters file,
+    // which is much slower than a cache hit.
+    m_pendingCounters[name] += increment;
+    m_pendingCount += increment;
+    if (m_pendingCount >= statisticsBatchSize) {
+        flushStatistics();
+    } else if (!m_flushTimer.isActive()) {
+        m_flushTimer.start(statisticsFlushSeconds * 1000);
+    }
 }
 
 bool WebsiteCache::hasValidElement(const QUrl& url, const Locale& locale)
 {
     const QString h = hash(url, locale);
-    return m_cache.contains(h) && m_cache[h].date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds);
+    if (findValidElement(h) != nullptr) {
+        ++s_memoryHits;
+        countPersistently(MEMORY_HITS);
+        return true;
+    }
+    if (m_diskCache == nullptr) {
+        ++s_misses;
+        return false;
+    }
+
+    const network::HttpDiskCache::Entry entry = m_diskCache->entry(h);
+    if (!entry.isValid()
+        || entry.date < QDateTime::currentDateTime().addSecs(-network::HttpDiskCache::timeToLive(url))) {
+        ++s_misses;
+        countPersistently(MISSES);
+        return false;
+    }
+    ++s_diskHits;
+    countPersistently(DISK_HITS);
+    addElement(url, locale, entry.data);
+    return true;
 }
 
 QString WebsiteCache::hash(const QUrl& url, const Locale& locale)
@@ -23,15 +145,29 @@ QString WebsiteCache::hash(const QUrl& url, const Locale& locale)
     return QStringLiteral("%1_##_%2").arg(locale.toString(), url.toString());
 }
 
-void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QString data)
+void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QByteArray data)
 {
     if (data.isEmpty() || !url.isValid()) {
         return;
     }
+    const QString h = hash(url, locale);
+    auto existing = m_index.find(h);
+    if (existing != m_index.end()) {
+        removeElement(existing.value());
+    }
+
     CacheElement c;
+    c.key = h;
     c.data = std::move(data);
     c.date = QDateTime::currentDateTime();
-    m_cache.insert(hash(url, locale), c);
+    c.bytes = static_cast<qint64>(c.key.size() * sizeof(QChar) + c.data.size());
+
+    m_bytes += c.bytes;
+    s_bytes += c.bytes;
+    ++s_elements;
+    m_elements.push_front(std::move(c));
+    m_index.insert(h, m_elements.begin());
+    evictToBudget();
 
     if (!m_timer.isActive()) {
         // set timer for clearing the cache
@@ -39,24 +175,131 @@ void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QString dat
     }
 }
 
-QString WebsiteCache::getElement(const QUrl& url, const Locale& locale)
+void WebsiteCache::addElement(const QNetworkReply& reply, const Locale& locale, QByteArray data)
 {
-    const QString h = hash(url, locale);
-    return m_cache[h].data;
+    if (data.isEmpty() || !reply.url().isValid()) {
+        return;
+    }
+    addElement(reply.url(), locale, data);
+
+    const int statusCode = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (m_diskCache == nullptr || statusCode == static_cast<int>(HttpStatusCode::NotModified)) {
+        // Revalidated elements were already updated by readReply()
+        return;
+    }
+    network::HttpDiskCache::Entry entry;
+    entry.date = QDateTime::currentDateTime();
+    entry.eTag = reply.rawHeader("ETag");
+    entry.lastModified = reply.rawHeader("Last-Modified");
+    entry.data = std::move(data);
+    m_diskCache->store(hash(reply.url(), locale), entry);
+}
+
+void WebsiteCache::prepareRequest(QNetworkRequest& request, const Locale& locale)
+{
+    if (m_diskCache == nullptr) {
+        return;
+    }
+    const network::HttpDiskCache::Entry entry = m_diskCache->entry(hash(request.url(), locale));
+    if (!entry.isValid() || !entry.canBeRevalidated()) {
+        return;
+    }
+    if (!entry.eTag.isEmpty()) {
+        request.setRawHeader("If-None-Match", entry.eTag);
+    }
+    if (!entry.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", entry.lastModified);
+    }
+}
+
+QByteArray WebsiteCache::readReply(QNetworkReply& reply, const Locale& locale)
+{
+    const int statusCode = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (m_diskCache == nullptr || statusCode != static_cast<int>(HttpStatusCode::NotModified)) {
+        return reply.readAll();
+    }
+
+    const QString h = hash(reply.url(), locale);
+    network::HttpDiskCache::Entry entry = m_diskCache->entry(h);
+    if (!entry.isValid()) {
+        qWarning() << "[WebsiteCache] Got \"304 Not Modified\" but element is not cached:" << reply.url();
+        return {};
+    }
+    // The server may send updated validators.
+    if (reply.hasRawHeader("ETag")) {
+        entry.eTag = reply.rawHeader("ETag");
+    }
+    if (reply.hasRawHeader("Last-Modified")) {
+        entry.lastModified = reply.rawHeader("Last-Modified");
+    }
+    entry.date = QDateTime::currentDateTime();
+    m_diskCache->store(h, entry);
+    ++s_revalidations;
+    countPersistently(REVALIDATIONS);
+    return entry.data;
+}
+
+QByteArray WebsiteCache::getElement(const QUrl& url, const Locale& locale)
+{
+    const CacheElement* element = findValidElement(hash(url, locale));
+    return element != nullptr ? element->data : QByteArray{};
+}
+
+WebsiteCache::CacheElement* WebsiteCache::findValidElement(const QString& key)
+{
+    auto indexIt = m_index.find(key);
+    if (indexIt == m_index.end()) {
+        return nullptr;
+    }
+    ElementList::iterator it = indexIt.value();
+    if (it->date < QDateTime::currentDateTime().addSecs(-timeoutSeconds)) {
+        removeElement(it);
+        ++s_evictions;
+        countPersistently(EVICTIONS);
+        return nullptr;
+    }
+    // Move to the front; iterators of std::list stay valid.
+    m_elements.splice(m_elements.begin(), m_elements, it);
+    return &(*it);
+}
+
+void WebsiteCache::removeElement(ElementList::iterator it)
+{
+    m_bytes -= it->bytes;
+    s_bytes -= it->bytes;
+    --s_elements;
+    m_index.remove(it->key);
+    m_elements.erase(it);
+}
+
+void WebsiteCache::evictToBudget()
+{
+    // Always keep the most recently added element, even if it exceeds the budget on its own.
+    quint64 evicted = 0;
+    while (m_bytes > m_maxBytes && m_elements.size() > 1) {
+        removeElement(std::prev(m_elements.end()));
+        ++evicted;
+    }
+    s_evictions += evicted;
+    countPersistently(EVICTIONS, evicted);
 }
 
 void WebsiteCache::clearOldCacheEntries()
 {
-    auto it = m_cache.begin();
-    while (it != m_cache.end()) {
-        if (it.value().date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds)) {
-            it = m_cache.erase(it);
-        } else {
-            ++it;
+    const QDateTime cutoff = QDateTime::currentDateTime().addSecs(-timeoutSeconds);
+    quint64 evicted = 0;
+    auto it = m_elements.begin();
+    while (it != m_elements.end()) {
+        auto current = it++;
+        if (current->date < cutoff) {
+            removeElement(current);
+            ++evicted;
         }
     }
+    s_evictions += evicted;
+    countPersistently(EVICTIONS, evicted);
 
-    if (!m_cache.isEmpty()) {
+    if (!m_elements.empty()) {
         m_timer.start(timeoutSeconds * 1000);
     }
 }
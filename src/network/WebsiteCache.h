@@ -1,48 +1,132 @@
 #pragma once
 
 #include "data/Locale.h"
+#include "network/HttpDiskCache.h"
 
+#include <QByteArray>
 #include <QDateTime>
-#include <QMap>
+#include <QHash>
+#include <QNetworkReply>
+#include <QNetworkRequest>
 #include <QString>
 #include <QTimer>
 #include <QUrl>
 
+#include <list>
+
 namespace mediaelch {
 namespace scraper {
 
-/// \brief TheTvDb API cache stores the result for a API request as a string.
+/// \brief Website cache that stores the result for an API request.
+///
+/// Responses are stored as received, i.e. usually UTF-8 encoded.  This avoids
+/// converting them to QString (UTF-16) and back and halves their memory use.
+/// JSON responses can be parsed directly using QJsonDocument::fromJson().
+///
+/// The in-memory cache is a least-recently-used cache with a byte budget.
+/// Elements are evicted if they are older than timeoutSeconds or if the
+/// budget is exceeded.  The cache is *not* thread safe.
 ///
-/// Clears cache elements every timeoutSeconds. The cache is *not*
-/// thread safe.
+/// Elements are also stored in a persistent disk cache, see network::HttpDiskCache.
+/// Elements on disk are used as long as they are fresh according to the host's
+/// time-to-live.  Stale elements are revalidated: use prepareRequest() before
+/// sending a request and readReply() to read its response.
 class WebsiteCache
 {
 public:
     constexpr static int timeoutSeconds = 240;
+    constexpr static qint64 defaultMaxMemoryBytes = 32 * 1024 * 1024;
+    /// \brief Persistent counters are written at least this often if they changed.
+    constexpr static int statisticsFlushSeconds = 60;
+    /// \brief Persistent counters are written once this many events were counted.
+    constexpr static quint64 statisticsBatchSize = 100;
+
+    /// \brief Counters of all website caches, e.g. for the command line interface.
+    struct Statistics
+    {
+        quint64 memoryHits = 0;
+        quint64 diskHits = 0;
+        quint64 misses = 0;
+        quint64 revalidations = 0;
+        quint64 evictions = 0;
+        /// \brief Number of elements currently held in memory.
+        qint64 elements = 0;
+        /// \brief Bytes currently held in memory.
+        qint64 bytes = 0;
+    };
 
     WebsiteCache();
+    explicit WebsiteCache(network::HttpDiskCache* diskCache, qint64 maxMemoryBytes = defaultMaxMemoryBytes);
+    ~WebsiteCache();
 
-    void addElement(const QUrl& url, const Locale& locale, QString data);
-    QString getElement(const QUrl& url, const Locale& locale);
+    /// \brief Adds the element to the in-memory cache only.
+    void addElement(const QUrl& url, const Locale& locale, QByteArray data);
+    /// \brief Adds the response data of the given reply.
+    /// ETag and Last-Modified headers of the reply are stored as well.
+    void addElement(const QNetworkReply& reply, const Locale& locale, QByteArray data);
+    QByteArray getElement(const QUrl& url, const Locale& locale);
     bool hasValidElement(const QUrl& url, const Locale& locale);
 
+    /// \brief Adds conditional headers (If-None-Match, If-Modified-Since) to the
+    /// request if there is a stale element for the request's URL.
+    void prepareRequest(QNetworkRequest& request, const Locale& locale);
+    /// \brief Returns the reply's body.  If the server answered with "304 Not Modified",
+    /// the revalidated element is returned instead.
+    QByteArray readReply(QNetworkReply& reply, const Locale& locale);
+
+    qint64 memoryBytes() const { return m_bytes; }
+    int elementCount() const { return m_index.size(); }
+
+    /// \brief Statistics accumulated over all WebsiteCache instances of this process.
+    static Statistics statistics();
+    /// \brief Hit, miss, revalidation and eviction counters of all processes that used
+    ///        the given disk cache, e.g. for "mediaelch-cli info cache".
+    /// \details Counters are only persisted for caches that have a disk cache.
+    ///          Memory elements and bytes are always 0.
+    static Statistics persistentStatistics(network::HttpDiskCache* diskCache);
+    /// \brief Adds the counters of this cache that are not yet persisted to the disk cache.
+    /// \details Counters are collected in memory and written in batches, on a timer,
+    ///          when the application quits and when the cache is destroyed.
+    void flushStatistics();
+
 private:
     struct CacheElement
     {
+        QString key;
         QDateTime date;
-        QString data;
+        QByteArray data;
+        qint64 bytes = 0;
     };
+    using ElementList = std::list<CacheElement>;
 
     QString hash(const QUrl& url, const Locale& locale);
 
+    /// \brief Returns the element for the given key and marks it as most recently used.
+    /// Expired elements are removed.  Returns nullptr if there is no valid element.
+    CacheElement* findValidElement(const QString& key);
+    void removeElement(ElementList::iterator it);
+    /// \brief Removes least recently used elements until the cache fits into its budget.
+    void evictToBudget();
+
     /// \brief Clears old cache entries that are older than timeoutSeconds.
     ///
     /// Restarts the timer if the cache is not empty to ensure that all elements
     /// are eventually deleted.
     void clearOldCacheEntries();
 
-    QMap<QUrl, CacheElement> m_cache;
+    /// \brief Counts for persistentStatistics(); written by flushStatistics().
+    void countPersistently(const QString& name, quint64 increment = 1);
+
+    /// Most recently used elements first
+    ElementList m_elements;
+    QHash<QString, ElementList::iterator> m_index;
+    qint64 m_bytes = 0;
+    qint64 m_maxBytes = defaultMaxMemoryBytes;
     QTimer m_timer;
+    network::HttpDiskCache* m_diskCache = nullptr;
+    network::HttpDiskCache::Counters m_pendingCounters;
+    quint64 m_pendingCount = 0;
+    QTimer m_flushTimer;
 };
 
 } // namespace scraper
@@ -27,6 +27,7 @@ EpisodeRenamer::RenameError EpisodeRenamer::renameEpisode(TvShowEpisode& episode
             episodesRenamed.append(subEpisode);
         }
     }
+    TvShowEpisode::loadDetails(multiEpisodes);
 
     const mediaelch::FilePath firstEpisode = episode.files().first();
     const bool isBluRay = helper::isBluRay(firstEpisode);
@@ -14,6 +14,8 @@ MovieRenamer::MovieRenamer(RenamerConfig renamerConfig, RenamerDialog* dialog) :
 
 MovieRenamer::RenameError MovieRenamer::renameMovie(Movie& movie)
 {
+    // Patterns may use any detail of the movie.
+    movie.controller()->loadDetails();
     QFileInfo movieInfo(movie.files().first().toString());
     QString fiCanonicalPath = movieInfo.canonicalPath();
     QDir dir(movieInfo.canonicalPath());
@@ -0,0 +1,268 @@
+#include "scrapers/ScrapePipeline.h"
+
+#include "globals/Meta.h"
+
+#include <QDebug>
+#include <QTimer>
+
+namespace mediaelch {
+namespace scraper {
+
+ScrapePipelineItem::ScrapePipelineItem(QObject* parent) : QObject(parent)
+{
+}
+
+void ScrapePipelineItem::start(ScraperRateLimiter* rateLimiter)
+{
+    if (isStarted()) {
+        qWarning() << "[ScrapePipelineItem] Item was already started:" << title();
+        return;
+    }
+    m_rateLimiter = rateLimiter;
+    m_timer.start();
+    run();
+}
+
+void ScrapePipelineItem::abort()
+{
+    if (m_finished || m_aborted) {
+        return;
+    }
+    m_aborted = true;
+    doAbort();
+    releaseAllSlots();
+}
+
+ScrapePipelineItem::Stage ScrapePipelineItem::stage() const
+{
+    return m_stage;
+}
+
+bool ScrapePipelineItem::isStarted() const
+{
+    return m_timer.isValid();
+}
+
+bool ScrapePipelineItem::isFinished() const
+{
+    return m_finished;
+}
+
+bool ScrapePipelineItem::isAborted() const
+{
+    return m_aborted;
+}
+
+QString ScrapePipelineItem::message() const
+{
+    return m_message;
+}
+
+qint64 ScrapePipelineItem::elapsedMs() const
+{
+    if (m_finished || !m_timer.isValid()) {
+        return m_elapsedMs;
+    }
+    return m_timer.elapsed();
+}
+
+void ScrapePipelineItem::setStage(Stage stage)
+{
+    if (m_stage == stage || m_finished || m_aborted) {
+        return;
+    }
+    m_stage = stage;
+    emit sigStageChanged(this, stage);
+}
+
+void ScrapePipelineItem::finish(Stage stage, QString message)
+{
+    if (m_finished || m_aborted) {
+        return;
+    }
+    setStage(stage);
+    m_finished = true;
+    m_message = std::move(message);
+    m_elapsedMs = m_timer.isValid() ? m_timer.elapsed() : 0;
+    releaseAllSlots();
+    emit sigFinished(this);
+}
+
+void ScrapePipelineItem::log(const QString& message)
+{
+    emit sigMessage(this, message);
+}
+
+void ScrapePipelineItem::reportProgress(int done, int total)
+{
+    emit sigProgress(this, done, total);
+}
+
+void ScrapePipelineItem::acquireSlot(const QString& key, std::function<void()> callback)
+{
+    if (m_rateLimiter == nullptr) {
+        callback();
+        return;
+    }
+    m_rateLimiter->acquire(key, this, [this, key, callback = std::move(callback)]() {
+        if (m_finished || m_aborted) {
+            // The slot was granted after we were done; give it back.
+            m_rateLimiter->release(key);
+            return;
+        }
+        m_slots.append(key);
+        callback();
+    });
+}
+
+void ScrapePipelineItem::releaseSlot(const QString& key)
+{
+    if (m_rateLimiter != nullptr && m_slots.removeOne(key)) {
+        m_rateLimiter->release(key);
+    }
+}
+
+ScraperRateLimiter* ScrapePipelineItem::rateLimiter() const
+{
+    return m_rateLimiter;
+}
+
+void ScrapePipelineItem::releaseAllSlots()
+{
+    const QStringList heldSlots = m_slots;
+    m_slots.clear();
+    if (m_rateLimiter == nullptr) {
+        return;
+    }
+    for (const QString& key : heldSlots) {
+        m_rateLimiter->release(key);
+    }
+}
+
+ScrapePipeline::ScrapePipeline(QObject* parent) : QObject(parent)
+{
+}
+
+ScrapePipeline::~ScrapePipeline()
+{
+    abort();
+}
+
+void ScrapePipeline::setConcurrency(int concurrency)
+{
+    m_concurrency = qMax(1, concurrency);
+    if (m_isRunning) {
+        startNextItems();
+    }
+}
+
+int ScrapePipeline::concurrency() const
+{
+    return m_concurrency;
+}
+
+void ScrapePipeline::addItem(ScrapePipelineItem* item)
+{
+    item->setParent(this);
+    m_items.append(item);
+
+    connect(item, &ScrapePipelineItem::sigStageChanged, this, &ScrapePipeline::sigItemStageChanged);
+    connect(item, &ScrapePipelineItem::sigProgress, this, &ScrapePipeline::sigItemProgress);
+    connect(item, &ScrapePipelineItem::sigMessage, this, &ScrapePipeline::sigItemMessage);
+    // Queued: Items may finish synchronously inside start(), e.g. if they are skipped.
+    // Starting the next item directly would recurse once per skipped item.
+    connect(item, &ScrapePipelineItem::sigFinished, this, &ScrapePipeline::onItemFinished, Qt::QueuedConnection);
+
+    if (m_isRunning) {
+        startNextItems();
+    }
+}
+
+const QVector<ScrapePipelineItem*>& ScrapePipeline::items() const
+{
+    return m_items;
+}
+
+ScraperRateLimiter* ScrapePipeline::rateLimiter()
+{
+    return &m_rateLimiter;
+}
+
+void ScrapePipeline::start()
+{
+    if (m_isRunning) {
+        return;
+    }
+    m_isRunning = true;
+    emit sigProgress(m_finished, m_items.size());
+
+    if (m_finished == m_items.size()) {
+        m_isRunning = false;
+        QTimer::singleShot(0, this, &ScrapePipeline::sigFinished);
+        return;
+    }
+    startNextItems();
+}
+
+void ScrapePipeline::abort()
+{
+    if (!m_isRunning) {
+        return;
+    }
+    m_isRunning = false;
+    m_rateLimiter.clear();
+    for (ScrapePipelineItem* item : asConst(m_items)) {
+        disconnect(item, nullptr, this, nullptr);
+        if (item->isStarted()) {
+            item->abort();
+        }
+    }
+    m_running = 0;
+}
+
+bool ScrapePipeline::isRunning() const
+{
+    return m_isRunning;
+}
+
+int ScrapePipeline::finishedCount() const
+{
+    return m_finished;
+}
+
+int ScrapePipeline::runningCount() const
+{
+    return m_running;
+}
+
+void ScrapePipeline::startNextItems()
+{
+    while (m_isRunning && m_running < m_concurrency && m_nextItem < m_items.size()) {
+        ScrapePipelineItem* item = m_items[m_nextItem];
+        ++m_nextItem;
+        ++m_running;
+        emit sigItemStarted(item);
+        item->start(&m_rateLimiter);
+    }
+}
+
+void ScrapePipeline::onItemFinished(ScrapePipelineItem* item)
+{
+    if (!m_isRunning) {
+        return;
+    }
+    --m_running;
+    ++m_finished;
+    emit sigItemFinished(item);
+    emit sigProgress(m_finished, m_items.size());
+
+    if (m_finished == m_items.size()) {
+        m_isRunning = false;
+        emit sigFinished();
+        return;
+    }
+    startNextItems();
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "scrapers/ScraperRateLimiter.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief A single movie, TV show, episode, etc. that is scraped by a ScrapePipeline.
+/// \details Subclasses implement run() which moves the item through the stages
+///          search → load → images → save.  Stages that query a scraper are guarded
+///          with acquireSlot() / releaseSlot().  A slot limits how many items of one
+///          scraper are in that stage at the same time; it is held for the whole stage,
+///          which may consist of several requests.  The rate of single requests is
+///          limited by the scraper APIs, see ScraperRateLimiter::sendRequest().
+///          An item must call finish() exactly once.
+class ScrapePipelineItem : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Stage
+    {
+        Queued,
+        Search,
+        Load,
+        Images,
+        Save,
+        Done,
+        Skipped,
+        Failed
+    };
+
+public:
+    explicit ScrapePipelineItem(QObject* parent = nullptr);
+    ~ScrapePipelineItem() override = default;
+
+    /// \brief Human readable title of the item, e.g. the movie's name.
+    virtual QString title() const = 0;
+
+    /// \brief Starts the item. Called by the pipeline once a worker slot is free.
+    void start(ScraperRateLimiter* rateLimiter);
+    /// \brief Aborts all requests and downloads of this item. sigFinished() is not emitted.
+    void abort();
+
+    Stage stage() const;
+    bool isStarted() const;
+    bool isFinished() const;
+    bool isAborted() const;
+    /// \brief Reason why the item was skipped or has failed.
+    QString message() const;
+    /// \brief Time in milliseconds from start() until finish(), or until now if still running.
+    qint64 elapsedMs() const;
+
+signals:
+    void sigStageChanged(mediaelch::scraper::ScrapePipelineItem* item,
+        mediaelch::scraper::ScrapePipelineItem::Stage stage);
+    void sigProgress(mediaelch::scraper::ScrapePipelineItem* item, int done, int total);
+    void sigMessage(mediaelch::scraper::ScrapePipelineItem* item, QString message);
+    void sigFinished(mediaelch::scraper::ScrapePipelineItem* item);
+
+protected:
+    virtual void run() = 0;
+    /// \brief Called by abort(). Subclasses disconnect from scrapers and abort downloads.
+    virtual void doAbort() = 0;
+
+    void setStage(Stage stage);
+    /// \brief Marks the item as finished, releases all held slots and emits sigFinished().
+    void finish(Stage stage = Stage::Done, QString message = QString());
+    void log(const QString& message);
+    void reportProgress(int done, int total);
+
+    /// \brief Calls the callback once a slot of the stage for the given key is free.
+    void acquireSlot(const QString& key, std::function<void()> callback);
+    void releaseSlot(const QString& key);
+
+    ScraperRateLimiter* rateLimiter() const;
+
+private:
+    void releaseAllSlots();
+
+private:
+    ScraperRateLimiter* m_rateLimiter = nullptr;
+    QStringList m_slots;
+    Stage m_stage = Stage::Queued;
+    QString m_message;
+    QElapsedTimer m_timer;
+    qint64 m_elapsedMs = 0;
+    bool m_finished = false;
+    bool m_aborted = false;
+};
+
+/// \brief Scrapes several items concurrently.
+/// \details Up to concurrency() items run at the same time.  Each item runs
+///          through its stages independently, so while one item waits for its
+///          images, another one can already search or load.  The pipeline's
+///          ScraperRateLimiter limits the number of items per scraper and stage.
+///          The pipeline does not depend on any widget and can be used from the CLI.
+class ScrapePipeline : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int defaultConcurrency = 4;
+
+public:
+    explicit ScrapePipeline(QObject* parent = nullptr);
+    ~ScrapePipeline() override;
+
+    void setConcurrency(int concurrency);
+    int concurrency() const;
+
+    /// \brief Adds an item to the end of the queue. The pipeline takes ownership.
+    void addItem(ScrapePipelineItem* item);
+    const QVector<ScrapePipelineItem*>& items() const;
+
+    ScraperRateLimiter* rateLimiter();
+
+    void start();
+    /// \brief Aborts all running items and drops the queue. sigFinished() is not emitted.
+    void abort();
+
+    bool isRunning() const;
+    int finishedCount() const;
+    int runningCount() const;
+
+signals:
+    void sigItemStarted(mediaelch::scraper::ScrapePipelineItem* item);
+    void sigItemStageChanged(mediaelch::scraper::ScrapePipelineItem* item,
+        mediaelch::scraper::ScrapePipelineItem::Stage stage);
+    void sigItemProgress(mediaelch::scraper::ScrapePipelineItem* item, int done, int total);
+    void sigItemMessage(mediaelch::scraper::ScrapePipelineItem* item, QString message);
+    void sigItemFinished(mediaelch::scraper::ScrapePipelineItem* item);
+    /// \brief Emitted whenever an item has finished.
+    void sigProgress(int finished, int total);
+    void sigFinished();
+
+private:
+    void startNextItems();
+    void onItemFinished(ScrapePipelineItem* item);
+
+private:
+    ScraperRateLimiter m_rateLimiter;
+    QVector<ScrapePipelineItem*> m_items;
+    int m_concurrency = defaultConcurrency;
+    int m_nextItem = 0;
+    int m_running = 0;
+    int m_finished = 0;
+    bool m_isRunning = false;
+};
+
+} // namespace scraper
+} // namespace mediaelch
@@ -40,7 +40,7 @@ ScraperError replyToScraperError(const QNetworkReply& reply)
     return error;
 }
 
-ScraperError makeScraperError(const QString& data, const QNetworkReply& reply, const QJsonParseError& parseError)
+ScraperError makeScraperError(const QByteArray& data, const QNetworkReply& reply, const QJsonParseError& parseError)
 {
     ScraperError error;
     if (reply.error() != QNetworkReply::NoError) {
@@ -2,6 +2,7 @@
 
 #include "network/HttpStatusCodes.h"
 
+#include <QByteArray>
 #include <QJsonParseError>
 #include <QNetworkReply>
 #include <QString>
@@ -42,7 +43,7 @@ struct ScraperError
 /// \details Most scrapers have a similar setup:  They use JSON as a response and may have
 ///          a rate limit.  This function checks all those cases and creates a scraper error
 ///          with default messages, etc.
-ScraperError makeScraperError(const QString& data, const QNetworkReply& reply, const QJsonParseError& parseError);
+ScraperError makeScraperError(const QByteArray& data, const QNetworkReply& reply, const QJsonParseError& parseError);
 
 /// \brief A utility function to create a scraper error object based on a network reply.
 ScraperError replyToScraperError(const QNetworkReply& reply);
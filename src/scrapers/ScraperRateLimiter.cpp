@@ -0,0 +1,176 @@
+#include "scrapers/ScraperRateLimiter.h"
+
+#include "scrapers/concert/tmdb/TmdbConcert.h"
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "scrapers/tv_show/custom/CustomTvScraper.h"
+#include "scrapers/tv_show/imdb/ImdbTv.h"
+#include "scrapers/tv_show/thetvdb/TheTvDb.h"
+#include "scrapers/tv_show/tmdb/TmdbTv.h"
+#include "scrapers/tv_show/tvmaze/TvMaze.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QTimer>
+
+using namespace std::chrono_literals;
+
+namespace mediaelch {
+namespace scraper {
+
+ScraperRateLimiter::ScraperRateLimiter(QObject* parent) : QObject(parent)
+{
+}
+
+ScraperRateLimiter* ScraperRateLimiter::instance()
+{
+    // Parented to the application so that it is destroyed in the GUI thread.
+    static auto* s_instance = new ScraperRateLimiter(QCoreApplication::instance());
+    return s_instance;
+}
+
+ScraperRateLimiter::Limit ScraperRateLimiter::defaultLimit(const QString& key)
+{
+    // Requests to hosts of scraper APIs, see sendRequest()
+    // TMDb allows plenty of requests per second for API keys.
+    if (key == "api.themoviedb.org") {
+        return {6, 0ms};
+    }
+    if (key == "api.thetvdb.com") {
+        return {4, 100ms};
+    }
+    // TVmaze: 20 calls every 10 seconds
+    if (key == "api.tvmaze.com") {
+        return {2, 500ms};
+    }
+    // IMDb is scraped from its website; be polite.
+    if (key == "www.imdb.com") {
+        return {2, 500ms};
+    }
+
+    // Items of a scraper in the same stage of a ScrapePipeline
+    if (key == TmdbMovie::ID || key == TmdbTv::ID || key == TmdbConcert::ID) {
+        return {6, 0ms};
+    }
+    if (key == TheTvDb::ID) {
+        return {4, 100ms};
+    }
+    if (key == TvMaze::ID || key == ImdbMovie::ID || key == ImdbTv::ID) {
+        return {2, 500ms};
+    }
+    // Custom scrapers query several providers, including IMDb.
+    if (key == CustomMovieScraper::ID || key == CustomTvScraper::ID) {
+        return {2, 250ms};
+    }
+    return {2, 250ms};
+}
+
+void ScraperRateLimiter::setLimit(const QString& key, Limit limit)
+{
+    bucket(key).limit = limit;
+    startWaiting(key);
+}
+
+ScraperRateLimiter::Limit ScraperRateLimiter::limit(const QString& key) const
+{
+    if (m_buckets.contains(key)) {
+        return m_buckets[key].limit;
+    }
+    return defaultLimit(key);
+}
+
+void ScraperRateLimiter::acquire(const QString& key, QObject* context, std::function<void()> callback)
+{
+    bucket(key).waiting.enqueue({context, std::move(callback)});
+    startWaiting(key);
+}
+
+void ScraperRateLimiter::release(const QString& key)
+{
+    Bucket& b = bucket(key);
+    if (b.inFlight <= 0) {
+        qWarning() << "[ScraperRateLimiter] Released a slot that was not acquired:" << key;
+        return;
+    }
+    --b.inFlight;
+    startWaiting(key);
+}
+
+void ScraperRateLimiter::sendRequest(const QUrl& url,
+    QObject* context,
+    std::function<QNetworkReply*()> sendRequest)
+{
+    const QString key = url.host();
+    acquire(key, context, [this, key, send = std::move(sendRequest)]() {
+        QNetworkReply* reply = send();
+        if (reply == nullptr) {
+            release(key);
+            return;
+        }
+        // finished() is emitted for aborted requests as well.
+        connect(reply, &QNetworkReply::finished, this, [this, key]() { release(key); });
+    });
+}
+
+void ScraperRateLimiter::clear()
+{
+    for (Bucket& b : m_buckets) {
+        b.waiting.clear();
+    }
+}
+
+int ScraperRateLimiter::inFlight(const QString& key) const
+{
+    return m_buckets.contains(key) ? m_buckets[key].inFlight : 0;
+}
+
+int ScraperRateLimiter::waiting(const QString& key) const
+{
+    return m_buckets.contains(key) ? m_buckets[key].waiting.size() : 0;
+}
+
+ScraperRateLimiter::Bucket& ScraperRateLimiter::bucket(const QString& key)
+{
+    auto it = m_buckets.find(key);
+    if (it == m_buckets.end()) {
+        Bucket b;
+        b.limit = defaultLimit(key);
+        it = m_buckets.insert(key, b);
+    }
+    return it.value();
+}
+
+void ScraperRateLimiter::startWaiting(const QString& key)
+{
+    while (true) {
+        // Callbacks may acquire or release slots themselves which can rehash
+        // m_buckets; therefore look up the bucket again in every iteration.
+        Bucket& b = bucket(key);
+        if (b.waiting.isEmpty() || b.inFlight >= qMax(1, b.limit.maxConcurrent) || b.timerPending) {
+            return;
+        }
+
+        const qint64 minInterval = b.limit.minInterval.count();
+        if (minInterval > 0 && b.lastStart.isValid() && b.lastStart.elapsed() < minInterval) {
+            b.timerPending = true;
+            const int remaining = static_cast<int>(minInterval - b.lastStart.elapsed());
+            QTimer::singleShot(qMax(0, remaining), this, [this, key]() {
+                bucket(key).timerPending = false;
+                startWaiting(key);
+            });
+            return;
+        }
+
+        Waiting next = b.waiting.dequeue();
+        if (next.context.isNull()) {
+            continue;
+        }
+        ++b.inFlight;
+        b.lastStart.start();
+        next.callback();
+    }
+}
+
+} // namespace scraper
+} // namespace mediaelch
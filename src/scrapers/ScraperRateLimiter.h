@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QNetworkReply>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QString>
+#include <QUrl>
+#include <chrono>
+#include <functional>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief Limits the number of requests that are sent to a scraper's data provider.
+/// \details Requests are grouped by a key, either a provider's host or a scraper's
+///          identifier.  Each key has a maximum number of concurrent slots and a
+///          minimum interval between two acquired slots.  Callers acquire a slot
+///          using acquire() and must call release() once they are done.
+///
+///          Scraper APIs send each of their requests through sendRequest() of the
+///          shared instance(), so that the limits of a provider's host apply to
+///          single requests of all scrapers, pipelines and jobs.  SeasonScrapeJob
+///          acquires slots of the shared instance with scraper identifiers as keys
+///          to limit how many of their requests run at the same time.  ScrapePipeline
+///          uses its own limiter with scraper identifiers as keys to limit how many
+///          items of one scraper are in the same stage.
+class ScraperRateLimiter : public QObject
+{
+    Q_OBJECT
+public:
+    struct Limit
+    {
+        int maxConcurrent = 2;
+        std::chrono::milliseconds minInterval{0};
+    };
+
+public:
+    explicit ScraperRateLimiter(QObject* parent = nullptr);
+    ~ScraperRateLimiter() override = default;
+
+    /// \brief Limiter for requests to scraper APIs, shared by all scrapers.
+    /// \details Only use it in the GUI thread.
+    static ScraperRateLimiter* instance();
+
+    /// \brief Default limit for the given provider host or scraper identifier.
+    /// \details Unknown keys (mostly HTML scrapers) get a conservative limit.
+    static Limit defaultLimit(const QString& key);
+
+    /// \brief Overrides the limit of the given key. Already acquired slots are kept.
+    void setLimit(const QString& key, Limit limit);
+    Limit limit(const QString& key) const;
+
+    /// \brief Calls the callback as soon as a slot for the given key is free.
+    /// \details The callback is called immediately if a slot is available.  It is
+    ///          not called at all if the context object is destroyed before.
+    void acquire(const QString& key, QObject* context, std::function<void()> callback);
+    /// \brief Frees a slot that was acquired with acquire().
+    void release(const QString& key);
+    /// \brief Calls sendRequest as soon as a slot for the URL's host is free.
+    /// \details The slot is released once the returned reply has finished.
+    ///          Like acquire(), nothing is sent if the context object is destroyed before.
+    void sendRequest(const QUrl& url, QObject* context, std::function<QNetworkReply*()> sendRequest);
+    /// \brief Drops all waiting callbacks. Acquired slots stay acquired.
+    void clear();
+
+    int inFlight(const QString& key) const;
+    int waiting(const QString& key) const;
+
+private:
+    struct Waiting
+    {
+        QPointer<QObject> context;
+        std::function<void()> callback;
+    };
+
+    struct Bucket
+    {
+        Limit limit;
+        int inFlight = 0;
+        bool timerPending = false;
+        QElapsedTimer lastStart;
+        QQueue<Waiting> waiting;
+    };
+
+    Bucket& bucket(const QString& key);
+    void startWaiting(const QString& key);
+
+private:
+    QHash<QString, Bucket> m_buckets;
+};
+
+} // namespace scraper
+} // namespace mediaelch
@@ -386,7 +386,7 @@ void TmdbConcert::loadFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, concert, infos);
     } else {
         qWarning() << "Network Error (load)" << reply->errorString();
@@ -409,7 +409,7 @@ void TmdbConcert::loadTrailersFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, concert, infos);
     } else {
         qDebug() << "Network Error (trailers)" << reply->errorString();
@@ -432,7 +432,7 @@ void TmdbConcert::loadImagesFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, concert, infos);
     } else {
         qWarning() << "Network Error (images)" << reply->errorString();
@@ -455,7 +455,7 @@ void TmdbConcert::loadReleasesFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, concert, infos);
     } else {
         qWarning() << "Network Error (releases)" << reply->errorString();
@@ -470,10 +470,10 @@ void TmdbConcert::loadReleasesFinished()
  * \param concert Concert object
  * \param infos List of infos to load
  */
-void TmdbConcert::parseAndAssignInfos(QString json, Concert* concert, QSet<ConcertScraperInfo> infos)
+void TmdbConcert::parseAndAssignInfos(const QByteArray& json, Concert* concert, QSet<ConcertScraperInfo> infos)
 {
     QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing concert info json " << parseError.errorString();
         return;
@@ -61,7 +61,7 @@ private:
     QString language() const;
     QString country() const;
     mediaelch::network::NetworkManager* network();
-    void parseAndAssignInfos(QString json, Concert* concert, QSet<ConcertScraperInfo> infos);
+    void parseAndAssignInfos(const QByteArray& json, Concert* concert, QSet<ConcertScraperInfo> infos);
 };
 
 } // namespace scraper
@@ -352,7 +352,7 @@ void FanartTv::onLoadMovieDataFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QVector<Poster> posters = parseMovieData(msg, ImageType(reply->property("infoToLoad").toInt()));
     emit sigImagesLoaded(posters, {});
 }
@@ -372,7 +372,7 @@ void FanartTv::onLoadAllMovieDataFinished()
     }
 
     QMap<ImageType, QVector<Poster>> posters;
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
         posters.insert(type, parseMovieData(msg, type));
     }
@@ -395,7 +395,7 @@ void FanartTv::onLoadAllConcertDataFinished()
     }
 
     QMap<ImageType, QVector<Poster>> posters;
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
         posters.insert(type, parseMovieData(msg, type));
     }
@@ -409,7 +409,7 @@ void FanartTv::onLoadAllConcertDataFinished()
  * \param type Type of image (ImageType)
  * \return List of posters
  */
-QVector<Poster> FanartTv::parseMovieData(QString json, ImageType type)
+QVector<Poster> FanartTv::parseMovieData(const QByteArray& json, ImageType type)
 {
     QMap<ImageType, QStringList> map;
     // clang-format off
@@ -430,7 +430,7 @@ QVector<Poster> FanartTv::parseMovieData(QString json, ImageType type)
 
     QJsonParseError parseError{};
     // The JSON contains one object with all URLs to fanart images
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing fanart movie json " << parseError.errorString();
@@ -560,7 +560,7 @@ void FanartTv::onLoadTvShowDataFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QVector<Poster> posters = parseTvShowData(
         msg, ImageType(reply->property("infoToLoad").toInt()), SeasonNumber(reply->property("season").toInt()));
 
@@ -578,7 +578,7 @@ void FanartTv::onLoadAllTvShowDataFinished()
     reply->deleteLater();
     QMap<ImageType, QVector<Poster>> posters;
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
             posters.insert(type, parseTvShowData(msg, type));
         }
@@ -707,7 +707,7 @@ void FanartTv::tvShowSeasonThumbs(TvDbId tvdbId, SeasonNumber season, const medi
  * \param type Type of image (ImageType)
  * \return List of posters
  */
-QVector<Poster> FanartTv::parseTvShowData(QString json, ImageType type, SeasonNumber season)
+QVector<Poster> FanartTv::parseTvShowData(const QByteArray& json, ImageType type, SeasonNumber season)
 {
     QMap<ImageType, QStringList> map;
 
@@ -727,7 +727,7 @@ QVector<Poster> FanartTv::parseTvShowData(QString json, ImageType type, SeasonNu
 
     QJsonParseError parseError{};
     // The JSON contains one object with all URLs to fanart images
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing fanart TV show json " << parseError.errorString();
@@ -114,11 +114,12 @@ private:
     QLineEdit* m_personalApiKeyEdit;
 
     mediaelch::network::NetworkManager* network();
-    QVector<Poster> parseMovieData(QString json, ImageType type);
+    QVector<Poster> parseMovieData(const QByteArray& json, ImageType type);
     void loadMovieData(TmdbId tmdbId, ImageType type);
     void loadMovieData(TmdbId tmdbId, QVector<ImageType> types, Movie* movie);
     void loadConcertData(TmdbId tmdbId, QVector<ImageType> types, Concert* concert);
-    QVector<Poster> parseTvShowData(QString json, ImageType type, SeasonNumber season = SeasonNumber::NoSeason);
+    QVector<Poster>
+    parseTvShowData(const QByteArray& json, ImageType type, SeasonNumber season = SeasonNumber::NoSeason);
     void loadTvShowData(TvDbId tvdbId, ImageType type, SeasonNumber season = SeasonNumber::NoSeason);
     void loadTvShowData(TvDbId tvdbId, QVector<ImageType> types, TvShow* show);
     QString keyParameter();
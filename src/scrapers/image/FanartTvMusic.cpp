@@ -173,7 +173,7 @@ void FanartTvMusic::onSearchArtistFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QDomDocument domDoc;
     domDoc.setContent(msg);
     for (int i = 0, n = domDoc.elementsByTagName("artist").count(); i < n; ++i) {
@@ -207,7 +207,7 @@ void FanartTvMusic::onSearchAlbumFinished()
     }
 
     QVector<ScraperSearchResult> results;
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QDomDocument domDoc;
     domDoc.setContent(msg);
     QStringList searchIds;
@@ -252,7 +252,7 @@ void FanartTvMusic::onLoadArtistFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QVector<Poster> posters = parseData(msg, info);
     emit sigImagesLoaded(posters, {});
 }
@@ -268,12 +268,12 @@ void FanartTvMusic::onLoadAlbumFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QVector<Poster> posters = parseData(msg, info);
     emit sigImagesLoaded(posters, {});
 }
 
-QVector<Poster> FanartTvMusic::parseData(QString json, ImageType type) const
+QVector<Poster> FanartTvMusic::parseData(const QByteArray& json, ImageType type) const
 {
     QMap<ImageType, QStringList> map;
 
@@ -289,7 +289,7 @@ QVector<Poster> FanartTvMusic::parseData(QString json, ImageType type) const
     QVector<Poster> posters;
 
     QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError);
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing fanart music json: " << parseError.errorString();
@@ -581,7 +581,7 @@ void FanartTvMusic::onLoadAllAlbumDataFinished()
     reply->deleteLater();
     QMap<ImageType, QVector<Poster>> posters;
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
             posters.insert(type, parseData(msg, type));
         }
@@ -596,7 +596,7 @@ void FanartTvMusic::onLoadAllArtistDataFinished()
     reply->deleteLater();
     QMap<ImageType, QVector<Poster>> posters;
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
             posters.insert(type, parseData(msg, type));
         }
@@ -98,7 +98,7 @@ void FanartTvMusicArtists::onSearchArtistFinished()
     }
 
     QVector<ScraperSearchResult> results;
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QDomDocument domDoc;
     domDoc.setContent(msg);
     for (int i = 0, n = domDoc.elementsByTagName("artist").count(); i < n; ++i) {
@@ -152,12 +152,12 @@ void FanartTvMusicArtists::onLoadConcertFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QVector<Poster> posters = parseData(msg, info);
     emit sigImagesLoaded(posters, {});
 }
 
-QVector<Poster> FanartTvMusicArtists::parseData(QString json, ImageType type)
+QVector<Poster> FanartTvMusicArtists::parseData(const QByteArray& json, ImageType type)
 {
     QMap<ImageType, QStringList> map;
     map.insert(ImageType::ConcertBackdrop, QStringList() << "artistbackground");
@@ -167,7 +167,7 @@ QVector<Poster> FanartTvMusicArtists::parseData(QString json, ImageType type)
 
     QJsonParseError parseError{};
     // The JSON contains one object with all URLs to fanart images
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing fanart music json: " << parseError.errorString();
@@ -91,7 +91,7 @@ private:
     QString m_preferredDiscType;
 
     mediaelch::network::NetworkManager* network();
-    QVector<Poster> parseData(QString json, ImageType type);
+    QVector<Poster> parseData(const QByteArray& json, ImageType type);
     QString keyParameter();
 };
 
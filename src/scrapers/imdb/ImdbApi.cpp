@@ -4,6 +4,7 @@
 #include "globals/JsonRequest.h"
 #include "globals/Meta.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/ScraperRateLimiter.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -34,7 +35,7 @@ void ImdbApi::sendGetRequest(const Locale& locale, const QUrl& url, ImdbApi::Api
         // Do not immediately run the callback because classes higher up may
         // set up a Qt connection while the network request is running.
         QTimer::singleShot(0, [cb = std::move(callback), element = m_cache.getElement(url, locale)]() { //
-            cb(element, {});
+            cb(QString::fromUtf8(element), {});
         });
         return;
     }
@@ -42,23 +43,27 @@ void ImdbApi::sendGetRequest(const Locale& locale, const QUrl& url, ImdbApi::Api
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     addHeadersToRequest(locale, request);
 
-    QNetworkReply* reply = m_network.getWithWatcher(request);
-
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
-        auto dls = makeDeleteLaterScope(reply);
-        QString html;
-        if (reply->error() == QNetworkReply::NoError) {
-            html = QString::fromUtf8(reply->readAll());
-
-            if (!html.isEmpty()) {
-                m_cache.addElement(reply->url(), locale, html);
+    m_cache.prepareRequest(request, locale);
+    // Requests are limited per host, see ScraperRateLimiter::defaultLimit().
+    ScraperRateLimiter::instance()->sendRequest(url, this, [this, request, locale, cb = std::move(callback)]() {
+        QNetworkReply* reply = m_network.getWithWatcher(request);
+        connect(reply, &QNetworkReply::finished, this, [reply, cb, locale, this]() {
+            auto dls = makeDeleteLaterScope(reply);
+            QByteArray html;
+            if (reply->error() == QNetworkReply::NoError) {
+                html = m_cache.readReply(*reply, locale);
+
+                if (!html.isEmpty()) {
+                    m_cache.addElement(*reply, locale, html);
+                }
+            } else {
+                qWarning() << "[ImdbTv][Api] Network Error:" << reply->errorString() << "for URL" << reply->url();
             }
-        } else {
-            qWarning() << "[ImdbTv][Api] Network Error:" << reply->errorString() << "for URL" << reply->url();
-        }
 
-        ScraperError error = makeScraperError(html, *reply, {});
-        cb(html, error);
+            ScraperError error = makeScraperError(html, *reply, {});
+            cb(QString::fromUtf8(html), error);
+        });
+        return reply;
     });
 }
 
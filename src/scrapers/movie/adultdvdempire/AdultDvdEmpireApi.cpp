@@ -16,7 +16,7 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
         // Do not immediately run the callback because classes higher up may
         // set up a Qt connection while the network request is running.
         QTimer::singleShot(0, [cb = std::move(callback), element = m_cache.getElement(url, Locale::English)]() { //
-            cb(element, {});
+            cb(QString::fromUtf8(element), {});
         });
         return;
     }
@@ -26,25 +26,26 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
     // If we use the MediaElch user agent, then no actor images are sent in the response (i.e. HTML).
     // See GitHub issue #1164
     mediaelch::network::useFirefoxUserAgent(request);
+    m_cache.prepareRequest(request, Locale::English);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
         auto dls = makeDeleteLaterScope(reply);
 
-        QString data;
+        QByteArray data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, Locale::English);
 
         } else {
             qWarning() << "[AdultDvdEmpireApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), Locale::English, data);
+            m_cache.addElement(*reply, Locale::English, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
-        cb(data, error);
+        cb(QString::fromUtf8(data), error);
     });
 }
 
@@ -16,31 +16,32 @@ void AebnApi::sendGetRequest(const QUrl& url, const Locale& locale, AebnApi::Api
         // Do not immediately run the callback because classes higher up may
         // set up a Qt connection while the network request is running.
         QTimer::singleShot(0, [cb = std::move(callback), element = m_cache.getElement(url, locale)]() { //
-            cb(element, {});
+            cb(QString::fromUtf8(element), {});
         });
         return;
     }
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    m_cache.prepareRequest(request, locale);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
         auto dls = makeDeleteLaterScope(reply);
 
-        QString data;
+        QByteArray data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, locale);
 
         } else {
             qWarning() << "[AebnApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), locale, data);
+            m_cache.addElement(*reply, locale, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
-        cb(data, error);
+        cb(QString::fromUtf8(data), error);
     });
 }
 
@@ -16,31 +16,32 @@ void HotMoviesApi::sendGetRequest(const QUrl& url, HotMoviesApi::ApiCallback cal
         // Do not immediately run the callback because classes higher up may
         // set up a Qt connection while the network request is running.
         QTimer::singleShot(0, [cb = std::move(callback), element = m_cache.getElement(url, Locale::English)]() { //
-            cb(element, {});
+            cb(QString::fromUtf8(element), {});
         });
         return;
     }
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    m_cache.prepareRequest(request, Locale::English);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
         auto dls = makeDeleteLaterScope(reply);
 
-        QString data;
+        QByteArray data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, Locale::English);
 
         } else {
             qWarning() << "[HotMoviesApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), Locale::English, data);
+            m_cache.addElement(*reply, Locale::English, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
-        cb(data, error);
+        cb(QString::fromUtf8(data), error);
     });
 }
 
@@ -386,7 +386,7 @@ void TmdbMovie::searchFinished()
     QString searchTitle = reply->property("searchTitle").toString();
     QString searchYear = reply->property("searchYear").toString();
     int page = reply->property("page").toInt();
-    QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     int nextPage = -1;
     results.append(parseSearch(msg, &nextPage, page));
     reply->deleteLater();
@@ -419,12 +419,12 @@ void TmdbMovie::searchFinished()
  * \param nextPage This will hold the next page to get, -1 if there are no more pages
  * \return List of search results
  */
-QVector<ScraperSearchResult> TmdbMovie::parseSearch(QString json, int* nextPage, int page)
+QVector<ScraperSearchResult> TmdbMovie::parseSearch(const QByteArray& json, int* nextPage, int page)
 {
     QVector<ScraperSearchResult> results;
 
     QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing search json " << parseError.errorString();
@@ -564,7 +564,7 @@ void TmdbMovie::loadFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        const QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, movie, infos);
 
         // if the movie is part of a collection then download the collection data
@@ -608,9 +608,9 @@ void TmdbMovie::loadCollectionFinished()
         return;
     }
 
-    const QString msg = QString::fromUtf8(reply->readAll());
+    const QByteArray msg = reply->readAll();
     QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(msg.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(msg, &parseError).object();
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing info json " << parseError.errorString();
         return;
@@ -645,7 +645,7 @@ void TmdbMovie::loadCastsFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, movie, infos);
     } else {
         showNetworkError(*reply);
@@ -669,7 +669,7 @@ void TmdbMovie::loadTrailersFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        const QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, movie, infos);
     } else {
         showNetworkError(*reply);
@@ -693,7 +693,7 @@ void TmdbMovie::loadImagesFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, movie, infos);
     } else {
         showNetworkError(*reply);
@@ -717,7 +717,7 @@ void TmdbMovie::loadReleasesFinished()
     }
 
     if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
+        const QByteArray msg = reply->readAll();
         parseAndAssignInfos(msg, movie, infos);
     } else {
         showNetworkError(*reply);
@@ -811,10 +811,10 @@ QUrl TmdbMovie::getCollectionUrl(QString collectionId) const
  * \param movie Movie object
  * \param infos List of infos to load
  */
-void TmdbMovie::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo> infos)
+void TmdbMovie::parseAndAssignInfos(const QByteArray& json, Movie* movie, QSet<MovieScraperInfo> infos)
 {
     QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing info json " << parseError.errorString();
         return;
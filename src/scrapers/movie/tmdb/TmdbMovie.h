@@ -37,7 +37,7 @@ public:
     QSet<MovieScraperInfo> scraperNativelySupports() override;
     void changeLanguage(mediaelch::Locale locale) override;
     QWidget* settingsWidget() override;
-    static QVector<ScraperSearchResult> parseSearch(QString json, int* nextPage, int page);
+    static QVector<ScraperSearchResult> parseSearch(const QByteArray& json, int* nextPage, int page);
     static QString apiKey();
 
 private slots:
@@ -86,7 +86,7 @@ private:
     getMovieUrl(QString movieId, ApiMovieDetails type, const UrlParameterMap& parameters = UrlParameterMap{}) const;
     QUrl getCollectionUrl(QString collectionId) const;
 
-    void parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo> infos);
+    void parseAndAssignInfos(const QByteArray& json, Movie* movie, QSet<MovieScraperInfo> infos);
     /// Load the given collection (TMDb id) and store the content in the movie.
     void loadCollection(Movie* movie, const TmdbId& collectionTmdbId);
 };
@@ -5,6 +5,7 @@
 #include "globals/JsonRequest.h"
 #include "globals/Meta.h"
 #include "network/HttpStatusCodes.h"
+#include "scrapers/ScraperRateLimiter.h"
 #include "tv_shows/TvDbId.h"
 
 #include <QJsonArray>
@@ -30,11 +31,9 @@ void TmdbApi::initialize()
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         auto dls = makeDeleteLaterScope(reply);
 
-        QString data{"{}"};
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
             m_isInitialized = true;
-            m_config = TmdbApiConfiguration::from(QJsonDocument::fromJson(data.toUtf8()));
+            m_config = TmdbApiConfiguration::from(QJsonDocument::fromJson(reply->readAll()));
 
         } else {
             qWarning() << "[TmdbApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
@@ -63,36 +62,41 @@ void TmdbApi::sendGetRequest(const Locale& locale, const QUrl& url, TmdbApi::Api
         QTimer::singleShot(0, [cb = std::move(callback), element = m_cache.getElement(url, locale)]() {
             // should not result in a parse error because the cache element is
             // only stored if no error occured at all.
-            cb(QJsonDocument::fromJson(element.toUtf8()), {});
+            cb(QJsonDocument::fromJson(element), {});
         });
         return;
     }
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
-    QNetworkReply* reply = m_network.getWithWatcher(request);
-
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
-        auto dls = makeDeleteLaterScope(reply);
-
-        QString data;
-        if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
-
-        } else {
-            qWarning() << "[TmdbApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
-        }
+    m_cache.prepareRequest(request, locale);
+    // Requests are limited per host, see ScraperRateLimiter::defaultLimit().
+    ScraperRateLimiter::instance()->sendRequest(url, this, [this, request, locale, cb = std::move(callback)]() {
+        QNetworkReply* reply = m_network.getWithWatcher(request);
+        connect(reply, &QNetworkReply::finished, this, [reply, cb, locale, this]() {
+            auto dls = makeDeleteLaterScope(reply);
+
+            QByteArray data;
+            if (reply->error() == QNetworkReply::NoError) {
+                data = m_cache.readReply(*reply, locale);
+
+            } else {
+                qWarning() << "[TmdbApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
+            }
 
-        QJsonParseError parseError{};
-        QJsonDocument json;
-        if (!data.isEmpty()) {
-            json = QJsonDocument::fromJson(data.toUtf8(), &parseError);
-            if (parseError.error == QJsonParseError::NoError) {
-                m_cache.addElement(reply->url(), locale, data);
+            QJsonParseError parseError{};
+            QJsonDocument json;
+            if (!data.isEmpty()) {
+                // Parse the raw response; converting it to QString first would only add a copy.
+                json = QJsonDocument::fromJson(data, &parseError);
+                if (parseError.error == QJsonParseError::NoError) {
+                    m_cache.addElement(*reply, locale, data);
+                }
             }
-        }
 
-        ScraperError error = makeScraperError(data, *reply, parseError);
-        cb(json, error);
+            ScraperError error = makeScraperError(data, *reply, parseError);
+            cb(json, error);
+        });
+        return reply;
     });
 }
 
@@ -1,5 +1,10 @@
 #include "scrapers/tv_show/SeasonScrapeJob.h"
 
+#include "scrapers/ScraperRateLimiter.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <memory>
+
 namespace mediaelch {
 namespace scraper {
 
@@ -8,6 +13,14 @@ SeasonScrapeJob::SeasonScrapeJob(SeasonScrapeJob::Config config, QObject* parent
 {
 }
 
+SeasonScrapeJob::~SeasonScrapeJob()
+{
+    // Free the slots of requests that are still running so that other jobs are not blocked.
+    for (const QString& key : asConst(m_acquiredSlots)) {
+        ScraperRateLimiter::instance()->release(key);
+    }
+}
+
 bool SeasonScrapeJob::hasError() const
 {
     return m_error.hasError();
@@ -18,6 +31,86 @@ const ScraperError& SeasonScrapeJob::error() const
     return m_error;
 }
 
+void SeasonScrapeJob::fanOut(const QString& rateLimitKey,
+    QVector<SeasonScrapeJob::Request> requests,
+    std::function<void()> onFinished)
+{
+    if (requests.isEmpty()) {
+        onFinished();
+        return;
+    }
+
+    struct State
+    {
+        int total = 0;
+        int remaining = 0;
+        std::function<void()> onFinished;
+    };
+    auto state = std::make_shared<State>();
+    state->total = requests.size();
+    state->remaining = requests.size();
+    state->onFinished = std::move(onFinished);
+
+    for (Request& request : requests) {
+        // The context object ensures that waiting requests are dropped if this job is destroyed.
+        ScraperRateLimiter::instance()->acquire(rateLimitKey, this, [this, rateLimitKey, state, request = std::move(request)]() {
+            m_acquiredSlots.append(rateLimitKey);
+            request([this, rateLimitKey, state]() {
+                m_acquiredSlots.removeOne(rateLimitKey);
+                ScraperRateLimiter::instance()->release(rateLimitKey);
+                --state->remaining;
+                emit sigProgress(state->total - state->remaining, state->total);
+                if (state->remaining == 0) {
+                    state->onFinished();
+                }
+            });
+        });
+    }
+}
+
+void SeasonScrapeJob::fanOutEpisodes(const QString& rateLimitKey,
+    QVector<SeasonScrapeJob::EpisodeRequest> requests,
+    std::function<void()> onFinished)
+{
+    // Each request writes into its own slot.  The slots are merged once all
+    // requests are done, so that the result does not depend on response order.
+    auto results = std::make_shared<QVector<QVector<TvShowEpisode*>>>(requests.size());
+
+    QVector<Request> wrapped;
+    wrapped.reserve(requests.size());
+    for (int i = 0; i < requests.size(); ++i) {
+        wrapped << [results, i, request = requests[i]](std::function<void()> done) {
+            request([results, i, done](QVector<TvShowEpisode*> episodes) {
+                (*results)[i] = std::move(episodes);
+                done();
+            });
+        };
+    }
+
+    fanOut(rateLimitKey, std::move(wrapped), [this, results, onFinished = std::move(onFinished)]() {
+        for (const QVector<TvShowEpisode*>& episodes : asConst(*results)) {
+            for (TvShowEpisode* episode : episodes) {
+                storeEpisode(episode);
+            }
+        }
+        onFinished();
+    });
+}
+
+void SeasonScrapeJob::storeEpisode(TvShowEpisode* episode)
+{
+    const SeasonNumber season = episode->seasonNumber();
+    if (!config().shouldLoadAllSeasons() && !config().seasons.contains(season)) {
+        // Only store episodes that are actually requested.
+        episode->deleteLater();
+        return;
+    }
+    TvShowEpisode*& stored = m_episodes[{season, episode->episodeNumber()}];
+    if (stored != nullptr && stored != episode) {
+        stored->deleteLater();
+    }
+    stored = episode;
+}
 
 } // namespace scraper
 } // namespace mediaelch
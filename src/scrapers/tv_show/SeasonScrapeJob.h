@@ -12,6 +12,8 @@
 #include <QObject>
 #include <QSet>
 #include <QString>
+#include <QVector>
+#include <functional>
 
 namespace mediaelch {
 namespace scraper {
@@ -61,7 +63,8 @@ public:
 
 public:
     SeasonScrapeJob(Config config, QObject* parent = nullptr);
-    virtual ~SeasonScrapeJob() = default;
+    /// \brief Releases rate limiter slots of requests that are still running.
+    ~SeasonScrapeJob() override;
 
     virtual void execute() = 0;
 
@@ -83,10 +86,41 @@ signals:
     ///        data from multiple sites or sends multiple requests.
     void sigProgress(int progress, int max);
 
+protected:
+    /// \brief A single request of a fan-out.  It must call `done` exactly once.
+    using Request = std::function<void(std::function<void()> done)>;
+    /// \brief A single request of a fan-out that results in episodes.  It must
+    ///        call `done` exactly once, with the episodes it has parsed.
+    using EpisodeRequest = std::function<void(std::function<void(QVector<TvShowEpisode*>)> done)>;
+
+    /// \brief Runs the requests concurrently and calls onFinished once all of them are done.
+    /// \details The number of requests that run at the same time and the interval between
+    ///          them are limited per rateLimitKey (the scraper's identifier), see
+    ///          ScraperRateLimiter::defaultLimit().  Slots are acquired from the shared
+    ///          ScraperRateLimiter::instance(), so the limit is shared by all season scrape
+    ///          jobs of a scraper.  Requests are started in the given order.  sigProgress() is emitted
+    ///          for each finished request.
+    void fanOut(const QString& rateLimitKey, QVector<Request> requests, std::function<void()> onFinished);
+    /// \brief Same as fanOut() but stores the resulting episodes using storeEpisode().
+    /// \details Episodes are stored in the order of the requests, not in the order in
+    ///          which the responses arrive.  If two requests return the same episode,
+    ///          the one of the later request is kept.
+    void fanOutEpisodes(const QString& rateLimitKey,
+        QVector<EpisodeRequest> requests,
+        std::function<void()> onFinished);
+
+    /// \brief Store the given episode in m_episodes if its season was requested.
+    ///        Otherwise the episode is deleted.
+    void storeEpisode(TvShowEpisode* episode);
+
 protected:
     EpisodeMap m_episodes;
     const Config m_config;
     ScraperError m_error;
+
+private:
+    /// Rate limiter keys of acquired slots, see fanOut().
+    QVector<QString> m_acquiredSlots;
 };
 
 } // namespace scraper
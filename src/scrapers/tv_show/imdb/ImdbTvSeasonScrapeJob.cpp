@@ -1,11 +1,14 @@
 #include "scrapers/tv_show/imdb/ImdbTvSeasonScrapeJob.h"
 
 #include "scrapers/imdb/ImdbApi.h"
+#include "scrapers/tv_show/imdb/ImdbTv.h"
 #include "scrapers/tv_show/imdb/ImdbTvSeasonParser.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QJsonArray>
 #include <QTimer>
+#include <algorithm>
+#include <memory>
 
 namespace mediaelch {
 namespace scraper {
@@ -29,77 +32,85 @@ void ImdbTvSeasonScrapeJob::execute()
         loadAllSeasons();
 
     } else {
-        gatherAndLoadEpisodes(config().seasons.values(), {});
+        gatherAndLoadEpisodes(config().seasons.values());
     }
 }
 
 void ImdbTvSeasonScrapeJob::loadEpisodes(QMap<SeasonNumber, QMap<EpisodeNumber, ImdbId>> episodeIds)
 {
-    if (episodeIds.isEmpty()) {
-        emit sigFinished(this);
-        return;
-    }
-
-    // Get next episode to load and remove it from episodeIds
-    const SeasonNumber nextSeason = episodeIds.keys().first();
-
-    // If there is no episode left in that season then remove it.
-    if (episodeIds[nextSeason].isEmpty()) {
-        episodeIds.remove(nextSeason);
-        loadEpisodes(episodeIds);
-        return;
+    QVector<EpisodeRequest> requests;
+    for (auto season = episodeIds.cbegin(); season != episodeIds.cend(); ++season) {
+        for (auto episode = season.value().cbegin(); episode != season.value().cend(); ++episode) {
+            requests << [this, seasonNumber = season.key(), episodeNumber = episode.key(), id = episode.value()](
+                            std::function<void(QVector<TvShowEpisode*>)> done) {
+                qInfo() << "[ImdbTvSeasonScrapeJob] Start loading season" << seasonNumber.toInt() << "episode"
+                        << episodeNumber.toInt() << "of show" << config().showIdentifier.str();
+
+                m_api.loadEpisode(config().locale, id, [this, seasonNumber, episodeNumber, id, done](
+                                                           QString html, ScraperError error) {
+                    if (error.hasError()) {
+                        // only store error but try to load other episodes
+                        m_error = error;
+                        done({});
+                        return;
+                    }
+                    if (html.isEmpty()) {
+                        done({});
+                        return;
+                    }
+                    // Create episode: We need to set some details because not everything is available
+                    // from the single episode page (or can be scraped in a stable manner).
+                    auto* episode = new TvShowEpisode({}, this);
+                    episode->setSeason(seasonNumber);
+                    episode->setEpisode(episodeNumber);
+                    episode->setImdbId(id);
+                    ImdbTvEpisodeParser::parseInfos(*episode, html);
+                    done({episode});
+                });
+            };
+        }
     }
 
-    QMap<EpisodeNumber, ImdbId> episodes = episodeIds[nextSeason];
-    const EpisodeNumber nextEpisode = episodes.keys().first();
-    const ImdbId nextEpisodeId = episodes[nextEpisode];
-    episodeIds[nextSeason].remove(nextEpisode);
-
-    // Create episode: We need to set some details because not everything is available
-    // from the single episode page (or can be scraped in a stable manner).
-    auto* episode = new TvShowEpisode({}, this);
-    episode->setSeason(nextSeason);
-    episode->setEpisode(nextEpisode);
-    episode->setImdbId(nextEpisodeId);
-
-    qInfo() << "[ImdbTvSeasonScrapeJob] Start loading season" << nextSeason.toInt() << "episode" << nextEpisode.toInt()
-            << "of show" << config().showIdentifier.str();
-
-    m_api.loadEpisode(config().locale, nextEpisodeId, [this, episode, episodeIds](QString html, ScraperError error) {
-        if (error.hasError()) {
-            // only store error but try to load other episodes
-            m_error = error;
-        } else if (!html.isEmpty()) {
-            ImdbTvEpisodeParser::parseInfos(*episode, html);
-            storeEpisode(episode);
-        }
-        loadEpisodes(episodeIds);
-    });
+    fanOutEpisodes(ImdbTv::ID, requests, [this]() { emit sigFinished(this); });
 }
 
-void ImdbTvSeasonScrapeJob::gatherAndLoadEpisodes(QList<SeasonNumber> seasonsToLoad,
-    QMap<SeasonNumber, QMap<EpisodeNumber, ImdbId>> episodeIds)
+void ImdbTvSeasonScrapeJob::gatherAndLoadEpisodes(QList<SeasonNumber> seasonsToLoad)
 {
-    if (seasonsToLoad.isEmpty()) {
-        loadEpisodes(episodeIds);
-        return;
+    std::sort(seasonsToLoad.begin(), seasonsToLoad.end());
+
+    // Season pages are parsed into their own slot; slots are merged in season order.
+    using EpisodeIds = QMap<EpisodeNumber, ImdbId>;
+    auto seasonEpisodeIds = std::make_shared<QVector<EpisodeIds>>(seasonsToLoad.size());
+    auto failed = std::make_shared<bool>(false);
+
+    QVector<Request> requests;
+    requests.reserve(seasonsToLoad.size());
+    for (int i = 0; i < seasonsToLoad.size(); ++i) {
+        requests << [this, i, season = seasonsToLoad.at(i), seasonEpisodeIds, failed](std::function<void()> done) {
+            m_api.loadSeason(config().locale, m_showId, season, [this, i, seasonEpisodeIds, failed, done](
+                                                                     QString html, ScraperError error) {
+                if (error.hasError()) {
+                    m_error = error;
+                    *failed = true;
+                } else {
+                    (*seasonEpisodeIds)[i] = ImdbTvSeasonParser::parseEpisodeIds(html);
+                }
+                done();
+            });
+        };
     }
 
-    const SeasonNumber nextSeason = seasonsToLoad.takeFirst();
-    const ImdbApi::ApiCallback callback = [this, nextSeason, seasonsToLoad, episodeIds](
-                                              QString html, ScraperError error) {
-        if (error.hasError()) {
-            m_error = error;
+    fanOut(ImdbTv::ID, requests, [this, seasonsToLoad, seasonEpisodeIds, failed]() {
+        if (*failed) {
             emit sigFinished(this);
-        } else {
-            QMap<EpisodeNumber, ImdbId> episodesForSeason = ImdbTvSeasonParser::parseEpisodeIds(html);
-            auto ids = episodeIds;
-            ids.insert(nextSeason, episodesForSeason);
-            gatherAndLoadEpisodes(seasonsToLoad, ids);
+            return;
         }
-    };
-
-    m_api.loadSeason(config().locale, m_showId, nextSeason, callback);
+        QMap<SeasonNumber, QMap<EpisodeNumber, ImdbId>> episodeIds;
+        for (int i = 0; i < seasonsToLoad.size(); ++i) {
+            episodeIds.insert(seasonsToLoad.at(i), seasonEpisodeIds->at(i));
+        }
+        loadEpisodes(episodeIds);
+    });
 }
 
 void ImdbTvSeasonScrapeJob::loadAllSeasons()
@@ -111,20 +122,9 @@ void ImdbTvSeasonScrapeJob::loadAllSeasons()
             return;
         }
         QSet<SeasonNumber> seasons = ImdbTvSeasonParser::parseSeasonNumbersFromEpisodesPage(html);
-        gatherAndLoadEpisodes(seasons.values(), {});
+        gatherAndLoadEpisodes(seasons.values());
     });
 }
 
-void ImdbTvSeasonScrapeJob::storeEpisode(TvShowEpisode* episode)
-{
-    const SeasonNumber season = episode->seasonNumber();
-    if (config().shouldLoadAllSeasons() || config().seasons.contains(season)) {
-        m_episodes[{season, episode->episodeNumber()}] = episode;
-    } else {
-        // Only store episodes that are actually requested.
-        episode->deleteLater();
-    }
-}
-
 } // namespace scraper
 } // namespace mediaelch
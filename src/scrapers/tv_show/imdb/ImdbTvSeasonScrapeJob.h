@@ -20,16 +20,12 @@ public:
     void execute() override;
 
 private:
-    /// \brief Loads the given episodes in a sequential way
-    /// \todo Load in parallel.
+    /// \brief Loads the given episodes concurrently, see fanOutEpisodes().
     void loadEpisodes(QMap<SeasonNumber, QMap<EpisodeNumber, ImdbId>> episodeIds);
-    /// \brief Gathers all episode IDs for the given seasons by loading each
-    ///        season page and then calls laodEpisodes().
-    void gatherAndLoadEpisodes(QList<SeasonNumber> seasonsToLoad,
-        QMap<SeasonNumber, QMap<EpisodeNumber, ImdbId>> episodeIds);
+    /// \brief Gathers all episode IDs for the given seasons by loading all
+    ///        season pages concurrently and then calls loadEpisodes().
+    void gatherAndLoadEpisodes(QList<SeasonNumber> seasonsToLoad);
     void loadAllSeasons();
-    /// \brief Store the given episode in the internal season-episode map.
-    void storeEpisode(TvShowEpisode* episode);
 
 private:
     ImdbApi& m_api;
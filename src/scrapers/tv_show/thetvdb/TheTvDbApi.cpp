@@ -4,6 +4,7 @@
 #include "globals/JsonRequest.h"
 #include "globals/Meta.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/ScraperRateLimiter.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -47,7 +48,7 @@ void TheTvDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheTvDbAp
         QTimer::singleShot(0, [cb = std::move(callback), element = m_cache.getElement(url, locale)]() {
             // should not result in a parse error because the cache element is
             // only stored if no error occured at all.
-            cb(QJsonDocument::fromJson(element.toUtf8()), {});
+            cb(QJsonDocument::fromJson(element), {});
         });
         return;
     }
@@ -55,30 +56,35 @@ void TheTvDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheTvDbAp
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
     addHeadersToRequest(locale, request);
 
-    QNetworkReply* reply = m_network.getWithWatcher(request);
+    m_cache.prepareRequest(request, locale);
+    // Requests are limited per host, see ScraperRateLimiter::defaultLimit().
+    ScraperRateLimiter::instance()->sendRequest(url, this, [this, request, locale, cb = std::move(callback)]() {
+        QNetworkReply* reply = m_network.getWithWatcher(request);
+        connect(reply, &QNetworkReply::finished, this, [reply, cb, locale, this]() {
+            auto dls = makeDeleteLaterScope(reply);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
-        auto dls = makeDeleteLaterScope(reply);
+            QByteArray data;
+            if (reply->error() == QNetworkReply::NoError) {
+                data = m_cache.readReply(*reply, locale);
 
-        QString data;
-        if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
-
-        } else {
-            qWarning() << "[TheTvDbApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
-        }
+            } else {
+                qWarning() << "[TheTvDbApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
+            }
 
-        QJsonParseError parseError{};
-        QJsonDocument json;
-        if (!data.isEmpty()) {
-            json = QJsonDocument::fromJson(data.toUtf8(), &parseError);
-            if (parseError.error == QJsonParseError::NoError) {
-                m_cache.addElement(reply->url(), locale, data);
+            QJsonParseError parseError{};
+            QJsonDocument json;
+            if (!data.isEmpty()) {
+                // Parse the raw response; converting it to QString first would only add a copy.
+                json = QJsonDocument::fromJson(data, &parseError);
+                if (parseError.error == QJsonParseError::NoError) {
+                    m_cache.addElement(*reply, locale, data);
+                }
             }
-        }
 
-        ScraperError error = makeScraperError(data, *reply, parseError);
-        cb(json, error);
+            ScraperError error = makeScraperError(data, *reply, parseError);
+            cb(json, error);
+        });
+        return reply;
     });
 }
 
@@ -25,43 +25,54 @@ void TheTvDbSeasonScrapeJob::execute()
         QTimer::singleShot(0, [this]() { emit sigFinished(this); });
         return;
     }
-    loadEpisodePage(TheTvDbApi::ApiPage{1});
+    // The first page tells us how many pages there are.  All other pages are
+    // loaded concurrently.
+    loadEpisodePage(TheTvDbApi::ApiPage{1}, [this](QVector<TvShowEpisode*> episodes, TheTvDbApi::Paginate paginate) {
+        for (TvShowEpisode* episode : asConst(episodes)) {
+            storeEpisode(episode);
+        }
+        if (hasError() || !paginate.hasNextPage()) {
+            emit sigFinished(this);
+            return;
+        }
+        loadRemainingPages(paginate.next, qMax(paginate.next, paginate.last));
+    });
 }
 
-void TheTvDbSeasonScrapeJob::loadEpisodePage(TheTvDbApi::ApiPage page)
+void TheTvDbSeasonScrapeJob::loadEpisodePage(TheTvDbApi::ApiPage page,
+    std::function<void(QVector<TvShowEpisode*>, TheTvDbApi::Paginate)> callback)
 {
-    const auto callback = [this](QJsonDocument json, ScraperError error) {
-        if (!error.hasError()) {
-            const auto onEpisode = [this](TvShowEpisode* episode) { storeEpisode(episode); };
+    const auto onPage = [this, callback](QJsonDocument json, ScraperError error) {
+        QVector<TvShowEpisode*> episodes;
+        TheTvDbApi::Paginate paginate;
+        if (error.hasError()) {
+            m_error = error;
+        } else {
+            const auto onEpisode = [&episodes](TvShowEpisode* episode) { episodes << episode; };
             // Pass `this` so that newly generated episodes belong to this instance.
-            const auto next =
+            paginate =
                 mediaelch::scraper::TheTvDbEpisodesParser::parseEpisodes(json, config().seasonOrder, this, onEpisode);
-            if (next.hasNextPage()) {
-                loadEpisodePage(next.next);
-            } else {
-                emit sigFinished(this);
-            }
-        } else {
-            m_error = error;
-            emit sigFinished(this);
         }
+        callback(episodes, paginate);
     };
     if (config().shouldLoadAllSeasons()) {
-        m_api.loadAllSeasonsPage(config().locale, m_showId, config().seasonOrder, page, callback);
+        m_api.loadAllSeasonsPage(config().locale, m_showId, config().seasonOrder, page, onPage);
     } else {
-        m_api.loadSeasonsPage(config().locale, m_showId, config().seasons, config().seasonOrder, page, callback);
+        m_api.loadSeasonsPage(config().locale, m_showId, config().seasons, config().seasonOrder, page, onPage);
     }
 }
 
-void TheTvDbSeasonScrapeJob::storeEpisode(TvShowEpisode* episode)
+void TheTvDbSeasonScrapeJob::loadRemainingPages(TheTvDbApi::ApiPage next, TheTvDbApi::ApiPage last)
 {
-    const SeasonNumber season = episode->seasonNumber();
-    if (config().shouldLoadAllSeasons() || config().seasons.contains(season)) {
-        m_episodes[{season, episode->episodeNumber()}] = episode;
-    } else {
-        // Only store episodes that are actually requested.
-        episode->deleteLater();
+    QVector<EpisodeRequest> requests;
+    for (TheTvDbApi::ApiPage page = next; page <= last; ++page) {
+        requests << [this, page](std::function<void(QVector<TvShowEpisode*>)> done) {
+            loadEpisodePage(page, [done](QVector<TvShowEpisode*> episodes, TheTvDbApi::Paginate /*unused*/) {
+                done(episodes);
+            });
+        };
     }
+    fanOutEpisodes(TheTvDb::ID, requests, [this]() { emit sigFinished(this); });
 }
 
 } // namespace scraper
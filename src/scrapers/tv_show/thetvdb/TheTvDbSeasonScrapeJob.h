@@ -22,8 +22,11 @@ public:
     void execute() override;
 
 private:
-    void loadEpisodePage(TheTvDbApi::ApiPage page);
-    void storeEpisode(TvShowEpisode* episode);
+    /// \brief Loads and parses a single page of episodes.
+    void loadEpisodePage(TheTvDbApi::ApiPage page,
+        std::function<void(QVector<TvShowEpisode*>, TheTvDbApi::Paginate)> callback);
+    /// \brief Loads the pages next to last concurrently, see fanOutEpisodes().
+    void loadRemainingPages(TheTvDbApi::ApiPage next, TheTvDbApi::ApiPage last);
 
 private:
     TheTvDbApi& m_api;
@@ -1,11 +1,13 @@
 #include "scrapers/tv_show/tmdb/TmdbTvSeasonScrapeJob.h"
 
 #include "scrapers/tmdb/TmdbApi.h"
+#include "scrapers/tv_show/tmdb/TmdbTv.h"
 #include "scrapers/tv_show/tmdb/TmdbTvSeasonParser.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QJsonArray>
 #include <QTimer>
+#include <algorithm>
 
 namespace mediaelch {
 namespace scraper {
@@ -35,25 +37,32 @@ void TmdbTvSeasonScrapeJob::execute()
 
 void TmdbTvSeasonScrapeJob::loadSeasons(QList<SeasonNumber> seasons)
 {
-    if (seasons.isEmpty()) {
-        emit sigFinished(this);
-        return;
-    }
+    // Request seasons in their natural order; the order of QSet::values() is arbitrary.
+    std::sort(seasons.begin(), seasons.end());
 
-    const SeasonNumber nextSeason = seasons.takeFirst();
-    const TmdbApi::ApiCallback callback = [this, seasons](QJsonDocument json, ScraperError error) {
-        if (error.hasError()) {
-            m_error = error;
-            emit sigFinished(this);
-            return;
-        }
-        const auto onEpisode = [this](TvShowEpisode* episode) { storeEpisode(episode); };
-        // Pass `this` so that newly generated episodes belong to this instance.
-        TmdbTvSeasonParser::parseEpisodes(m_api, json, this, onEpisode);
-        loadSeasons(seasons);
-    };
+    QVector<EpisodeRequest> requests;
+    requests.reserve(seasons.size());
+    for (const SeasonNumber& season : asConst(seasons)) {
+        requests << [this, season](std::function<void(QVector<TvShowEpisode*>)> done) {
+            m_api.loadSeason(config().locale,
+                m_showId,
+                season,
+                config().seasonOrder,
+                [this, done](QJsonDocument json, ScraperError error) {
+                    QVector<TvShowEpisode*> episodes;
+                    if (error.hasError()) {
+                        m_error = error;
+                    } else {
+                        const auto onEpisode = [&episodes](TvShowEpisode* episode) { episodes << episode; };
+                        // Pass `this` so that newly generated episodes belong to this instance.
+                        TmdbTvSeasonParser::parseEpisodes(m_api, json, this, onEpisode);
+                    }
+                    done(episodes);
+                });
+        };
+    }
 
-    m_api.loadSeason(config().locale, m_showId, nextSeason, config().seasonOrder, callback);
+    fanOutEpisodes(TmdbTv::ID, requests, [this]() { emit sigFinished(this); });
 }
 
 void TmdbTvSeasonScrapeJob::loadAllSeasons()
@@ -76,16 +85,5 @@ void TmdbTvSeasonScrapeJob::loadAllSeasons()
     });
 }
 
-void TmdbTvSeasonScrapeJob::storeEpisode(TvShowEpisode* episode)
-{
-    const SeasonNumber season = episode->seasonNumber();
-    if (config().shouldLoadAllSeasons() || config().seasons.contains(season)) {
-        m_episodes[{season, episode->episodeNumber()}] = episode;
-    } else {
-        // Only store episodes that are actually requested.
-        episode->deleteLater();
-    }
-}
-
 } // namespace scraper
 } // namespace mediaelch
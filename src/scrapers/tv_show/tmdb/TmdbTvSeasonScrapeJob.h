@@ -20,9 +20,9 @@ public:
     void execute() override;
 
 private:
+    /// \brief Loads the given seasons concurrently, see fanOutEpisodes().
     void loadSeasons(QList<SeasonNumber> seasons);
     void loadAllSeasons();
-    void storeEpisode(TvShowEpisode* episode);
 
 private:
     TmdbApi& m_api;
@@ -2,6 +2,7 @@
 
 #include "globals/Meta.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/ScraperRateLimiter.h"
 
 #include <QTimer>
 #include <QUrl>
@@ -33,36 +34,41 @@ void TvMazeApi::sendGetRequest(const QUrl& url, TvMazeApi::ApiCallback callback)
         QTimer::singleShot(0, [cb = std::move(callback), element = m_cache.getElement(url, Locale::English)]() {
             // should not result in a parse error because the cache element is
             // only stored if no error occured at all.
-            cb(QJsonDocument::fromJson(element.toUtf8()), {});
+            cb(QJsonDocument::fromJson(element), {});
         });
         return;
     }
 
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
-    QNetworkReply* reply = m_network.getWithWatcher(request);
-
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
-        auto dls = makeDeleteLaterScope(reply);
-        QString data;
-
-        if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
-
-        } else {
-            qWarning() << "[TvMazeApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
-        }
+    m_cache.prepareRequest(request, Locale::English);
+    // Requests are limited per host, see ScraperRateLimiter::defaultLimit().
+    ScraperRateLimiter::instance()->sendRequest(url, this, [this, request, cb = std::move(callback)]() {
+        QNetworkReply* reply = m_network.getWithWatcher(request);
+        connect(reply, &QNetworkReply::finished, this, [reply, cb, this]() {
+            auto dls = makeDeleteLaterScope(reply);
+            QByteArray data;
+
+            if (reply->error() == QNetworkReply::NoError) {
+                data = m_cache.readReply(*reply, Locale::English);
+
+            } else {
+                qWarning() << "[TvMazeApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
+            }
 
-        QJsonParseError parseError{};
-        QJsonDocument json;
-        if (!data.isEmpty()) {
-            json = QJsonDocument::fromJson(data.toUtf8(), &parseError);
-            if (parseError.error == QJsonParseError::NoError) {
-                m_cache.addElement(reply->url(), Locale::English, data);
+            QJsonParseError parseError{};
+            QJsonDocument json;
+            if (!data.isEmpty()) {
+                // Parse the raw response; converting it to QString first would only add a copy.
+                json = QJsonDocument::fromJson(data, &parseError);
+                if (parseError.error == QJsonParseError::NoError) {
+                    m_cache.addElement(*reply, Locale::English, data);
+                }
             }
-        }
 
-        ScraperError error = makeScraperError(data, *reply, parseError);
-        cb(json, error);
+            ScraperError error = makeScraperError(data, *reply, parseError);
+            cb(json, error);
+        });
+        return reply;
     });
 }
 
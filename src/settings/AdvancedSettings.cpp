@@ -168,6 +168,26 @@ bool AdvancedSettings::writeThumbUrlsToNfo() const
     return m_writeThumbUrlsToNfo;
 }
 
+bool AdvancedSettings::incrementalMovieScan() const
+{
+    return m_incrementalMovieScan;
+}
+
+bool AdvancedSettings::lazyMovieLoading() const
+{
+    return m_lazyMovieLoading;
+}
+
+bool AdvancedSettings::lazyEpisodeLoading() const
+{
+    return m_lazyEpisodeLoading;
+}
+
+int AdvancedSettings::multiScrapeConcurrency() const
+{
+    return m_multiScrapeConcurrency;
+}
+
 mediaelch::ThumbnailDimensions AdvancedSettings::episodeThumbnailDimensions() const
 {
     return m_episodeThumbnailDimensions;
@@ -175,22 +195,27 @@ mediaelch::ThumbnailDimensions AdvancedSettings::episodeThumbnailDimensions() co
 
 bool AdvancedSettings::isFileExcluded(QString file) const
 {
-    for (const auto& pattern : m_excludePatterns) {
-        if (pattern.matchFilename(file)) {
-            return true;
-        }
-    }
-    return false;
+    return m_excludedFiles.matches(file);
 }
 
 bool AdvancedSettings::isFolderExcluded(QString dir) const
 {
+    return m_excludedFolders.matches(dir);
+}
+
+void AdvancedSettings::compileExcludePatterns()
+{
+    QVector<QRegularExpression> filePatterns;
+    QVector<QRegularExpression> folderPatterns;
     for (const auto& pattern : m_excludePatterns) {
-        if (pattern.matchFoldername(dir)) {
-            return true;
+        if (pattern.isFilePattern()) {
+            filePatterns << pattern.regex();
+        } else if (pattern.isFolderPattern()) {
+            folderPatterns << pattern.regex();
         }
     }
-    return false;
+    m_excludedFiles = mediaelch::FileNameMatcher::fromRegularExpressions(filePatterns);
+    m_excludedFolders = mediaelch::FileNameMatcher::fromRegularExpressions(folderPatterns);
 }
 
 bool AdvancedSettings::useFirstStudioOnly() const
@@ -249,6 +274,10 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     printMap(out, settings.m_countryMappings);
 
     out << "    writeThumbUrlsToNfo:     " << (settings.m_writeThumbUrlsToNfo ? "true" : "false") << nl;
+    out << "    incrementalMovieScan:    " << (settings.m_incrementalMovieScan ? "true" : "false") << nl;
+    out << "    lazyMovieLoading:        " << (settings.m_lazyMovieLoading ? "true" : "false") << nl;
+    out << "    lazyEpisodeLoading:      " << (settings.m_lazyEpisodeLoading ? "true" : "false") << nl;
+    out << "    multiScrapeConcurrency:  " << settings.m_multiScrapeConcurrency << nl;
     out << "    episodeThumb dimensions: " << nl;
     out << "        width:               " << settings.m_episodeThumbnailDimensions.width << nl;
     out << "        height:              " << settings.m_episodeThumbnailDimensions.height << nl;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "file/FileFilter.h"
+#include "file/FileNameMatcher.h"
 #include "globals/Globals.h"
 #include "image/ThumbnailDimensions.h"
 
@@ -43,6 +44,10 @@ public:
         return false;
     }
 
+    bool isFilePattern() const { return m_type == ExcludeType::File; }
+    bool isFolderPattern() const { return m_type == ExcludeType::Folder; }
+    const QRegularExpression& regex() const { return m_regex; }
+
     QString toString() const { return excludeTypeToString(m_type) + ": " + m_regex.pattern(); }
 
 private:
@@ -97,6 +102,10 @@ public:
     bool portableMode() const;
     int bookletCut() const;
     bool writeThumbUrlsToNfo() const;
+    bool incrementalMovieScan() const;
+    bool lazyMovieLoading() const;
+    bool lazyEpisodeLoading() const;
+    int multiScrapeConcurrency() const;
     mediaelch::ThumbnailDimensions episodeThumbnailDimensions() const;
 
     bool isFileExcluded(QString file) const;
@@ -107,6 +116,9 @@ public:
 
 private:
     void setLocale(QString locale);
+    /// \brief Compiles m_excludePatterns into the file and folder matchers.
+    /// Has to be called whenever m_excludePatterns changes.
+    void compileExcludePatterns();
 
 private:
     bool m_debugLog = false;
@@ -126,10 +138,16 @@ private:
     QHash<QString, QString> m_countryMappings;
     mediaelch::ThumbnailDimensions m_episodeThumbnailDimensions;
     QVector<FileSearchExclude> m_excludePatterns;
+    mediaelch::FileNameMatcher m_excludedFiles;
+    mediaelch::FileNameMatcher m_excludedFolders;
     bool m_forceCache = false;
     bool m_portableMode = false;
     int m_bookletCut = 2;
     bool m_writeThumbUrlsToNfo = true;
+    bool m_incrementalMovieScan = false;
+    bool m_lazyMovieLoading = false;
+    bool m_lazyEpisodeLoading = false;
+    int m_multiScrapeConcurrency = 4;
     bool m_useFirstStudioOnly = false;
 };
 
@@ -99,6 +99,19 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
         } else if (m_xml.name() == "writeThumbUrlsToNfo") {
             expectBool(m_settings.m_writeThumbUrlsToNfo);
 
+        } else if (m_xml.name() == "incrementalMovieScan") {
+            expectBool(m_settings.m_incrementalMovieScan);
+
+        } else if (m_xml.name() == "lazyMovieLoading") {
+            expectBool(m_settings.m_lazyMovieLoading);
+
+        } else if (m_xml.name() == "lazyEpisodeLoading") {
+            expectBool(m_settings.m_lazyEpisodeLoading);
+
+        } else if (m_xml.name() == "multiScrapeConcurrency") {
+            const auto inRange = [](int concurrency) { return concurrency >= 1 && concurrency <= 16; };
+            expectIntChecked(m_settings.m_multiScrapeConcurrency, inRange);
+
         } else if (m_xml.name() == "episodeThumb") {
             while (m_xml.readNextStartElement()) {
                 if (m_xml.name() == "width") {
@@ -149,6 +162,7 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
 
         } else if (m_xml.name() == "exclude") {
             loadExcludePatterns();
+            m_settings.compileExcludePatterns();
 
         } else {
             skipUnsupportedTag();
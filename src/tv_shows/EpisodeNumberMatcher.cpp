@@ -0,0 +1,116 @@
+#include "tv_shows/EpisodeNumberMatcher.h"
+
+namespace mediaelch {
+
+namespace {
+
+QRegularExpression compile(const QString& pattern)
+{
+    QRegularExpression regex(pattern, QRegularExpression::CaseInsensitiveOption);
+    // Compile (and JIT compile, if available) now instead of after a number of matches.
+    regex.optimize();
+    return regex;
+}
+
+} // namespace
+
+EpisodeNumberMatcher::EpisodeNumberMatcher()
+{
+    // Order matters: the first matching pattern wins.
+    m_seasonPatterns = {compile(R"(S(\d+)[ ._-]?E)"),
+        compile(R"((\d+)?x(\d+))"),
+        compile(R"((\d+).(\d){2,4})"),
+        compile(R"(Season[ ._]?(\d+)[ ._]?Episode)")};
+
+    m_episodePatterns = {{compile(R"(S(\d+)[ ._-]?E(\d+))"), false},
+        {compile(R"(S(\d+)[ ._-]?EP(\d+))"), false},
+        {compile(R"(Season[ ._-]?(\d+)[._ -]?Episode[ ._-]?(\d+))"), false},
+        {compile(R"((\d+)x(\d+))"), true},
+        {compile(R"((\d+).(\d){2,4})"), true}};
+
+    // \G anchors the match at the offset passed to match().
+    m_continuation = compile(R"(\G[-_EeXx]+([0-9]+)($|[\-\._\sE]))");
+}
+
+const EpisodeNumberMatcher& EpisodeNumberMatcher::instance()
+{
+    static const EpisodeNumberMatcher matcher;
+    return matcher;
+}
+
+SeasonNumber EpisodeNumberMatcher::seasonNumber(const QString& fileName) const
+{
+    for (const QRegularExpression& regex : m_seasonPatterns) {
+        const QRegularExpressionMatch match = regex.match(fileName);
+        if (match.hasMatch()) {
+            return SeasonNumber(match.capturedRef(1).toInt());
+        }
+    }
+    // Default if no valid season could be parsed.
+    return SeasonNumber::SpecialsSeason;
+}
+
+QVector<EpisodeNumber> EpisodeNumberMatcher::episodeNumbers(const QString& fileName) const
+{
+    QVector<EpisodeNumber> episodes;
+    for (const EpisodePattern& pattern : m_episodePatterns) {
+        if (scanWithPattern(pattern, fileName, episodes)) {
+            break;
+        }
+    }
+    return episodes;
+}
+
+EpisodeNumberMatcher::Result EpisodeNumberMatcher::match(const QString& fileName) const
+{
+    Result result;
+    result.season = seasonNumber(fileName);
+    result.episodes = episodeNumbers(fileName);
+    return result;
+}
+
+QVector<EpisodeNumberMatcher::Result> EpisodeNumberMatcher::match(const QStringList& fileNames) const
+{
+    QVector<Result> results;
+    results.reserve(fileNames.size());
+    for (const QString& fileName : fileNames) {
+        results << match(fileName);
+    }
+    return results;
+}
+
+bool EpisodeNumberMatcher::scanWithPattern(const EpisodePattern& pattern,
+    const QString& fileName,
+    QVector<EpisodeNumber>& episodes) const
+{
+    int offset = 0;
+    int lastEnd = -1;
+    QRegularExpressionMatch match;
+    while ((match = pattern.regex.match(fileName, offset)).hasMatch()) {
+        // if between the last match and this one are more than five characters: break
+        // this way we can try to filter "false matches" like in "21x04 - Hammond vs. 6x6.mp4"
+        if (pattern.mayBeAmbiguous && lastEnd != -1 && lastEnd < match.capturedStart() + 5) {
+            return true;
+        }
+        episodes << EpisodeNumber(match.capturedRef(2).toInt());
+        offset = match.capturedEnd();
+        lastEnd = offset;
+    }
+
+    if (episodes.isEmpty()) {
+        return false;
+    }
+
+    if (episodes.count() == 1) {
+        // Multi-episode files such as "S01E04-E05-E06": the delimiter after each
+        // number may be the start of the next one.
+        offset = lastEnd;
+        while ((match = m_continuation.match(fileName, offset)).hasMatch()) {
+            episodes << EpisodeNumber(match.capturedRef(1).toInt());
+            offset = match.capturedEnd() - 1;
+        }
+    }
+    return true;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "tv_shows/EpisodeNumber.h"
+#include "tv_shows/SeasonNumber.h"
+
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief Extracts season and episode numbers from episode file names.
+///
+/// All patterns are compiled once when the matcher is created and are JIT
+/// compiled right away instead of after a number of uses.  Use instance()
+/// to share one matcher; it is created on first use.  Matching is thread-safe.
+///
+/// \code{cpp}
+///   const auto results = EpisodeNumberMatcher::instance().match(QStringList{"Show.S01E01E02.mkv", "1x03.avi"});
+///   // results[0]: season 1, episodes {1, 2}; results[1]: season 1, episodes {3}
+/// \endcode
+class EpisodeNumberMatcher
+{
+public:
+    struct Result
+    {
+        SeasonNumber season = SeasonNumber::NoSeason;
+        QVector<EpisodeNumber> episodes;
+    };
+
+    EpisodeNumberMatcher();
+
+    static const EpisodeNumberMatcher& instance();
+
+    /// \brief Season number of the given file name.  SpecialsSeason if none could be found.
+    SeasonNumber seasonNumber(const QString& fileName) const;
+    /// \brief All episode numbers of the given file name, e.g. two for "S01E01-E02".
+    QVector<EpisodeNumber> episodeNumbers(const QString& fileName) const;
+
+    Result match(const QString& fileName) const;
+    /// \brief Classifies a whole directory listing.  The results are in the order of fileNames.
+    QVector<Result> match(const QStringList& fileNames) const;
+
+private:
+    struct EpisodePattern
+    {
+        QRegularExpression regex;
+        /// If true, a heuristic avoids matching e.g. the video's resolution.
+        bool mayBeAmbiguous = false;
+    };
+
+    bool scanWithPattern(const EpisodePattern& pattern,
+        const QString& fileName,
+        QVector<EpisodeNumber>& episodes) const;
+
+    QVector<QRegularExpression> m_seasonPatterns;
+    QVector<EpisodePattern> m_episodePatterns;
+    /// Matches further episode numbers directly after the first one, e.g. "-E05" in "S01E04-E05".
+    QRegularExpression m_continuation;
+};
+
+} // namespace mediaelch
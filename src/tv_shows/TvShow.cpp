@@ -254,6 +254,8 @@ void TvShow::scrapeData(mediaelch::scraper::TvScraper* scraper,
     // TODO: Remove in future versions.
     m_infosToLoad = showDetails;
     m_episodeInfosToLoad = episodedetails;
+    // Scraped details are merged into the episodes and must not be overwritten later.
+    TvShowEpisode::loadDetails(m_episodes);
 
     /// Set of seasons that this TV show has. We do not need to load all seasons.
     QSet<SeasonNumber> seasons;
@@ -1,7 +1,9 @@
 #include "TvShowEpisode.h"
 
+#include "data/Database.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "media_centers/MediaCenterInterface.h"
 #include "scrapers/tv_show/ShowMerger.h"
 #include "scrapers/tv_show/TvScraper.h"
@@ -14,6 +16,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QTime>
+#include <QtConcurrent/QtConcurrentMap>
 #include <utility>
 
 /**
@@ -146,6 +149,15 @@ bool TvShowEpisode::loadData(MediaCenterInterface* mediaCenterInterface, bool re
         return false;
     }
 
+    if (m_detailsPending) {
+        // The summary does not count as loaded infos.
+        m_detailsPending = false;
+        forceReload = true;
+        if (!reloadFromNfo && nfoContent().isEmpty() && databaseId() >= 0) {
+            setNfoContent(Manager::instance()->database()->episodeNfoContent(databaseId()));
+        }
+    }
+
     if (!forceReload && (m_infoLoaded || !hasChanged()) && m_infoFromNfoLoaded) {
         return m_infoLoaded;
     }
@@ -169,7 +181,8 @@ bool TvShowEpisode::loadData(MediaCenterInterface* mediaCenterInterface, bool re
  */
 void TvShowEpisode::loadStreamDetailsFromFile()
 {
-    m_streamDetails->loadStreamDetails();
+    loadDetails();
+    Manager::instance()->mediaInfoProbeQueue()->loadStreamDetails(*m_streamDetails);
     setStreamDetailsLoaded(true);
     setChanged(true);
 }
@@ -181,6 +194,17 @@ void TvShowEpisode::loadStreamDetailsFromFile()
  */
 bool TvShowEpisode::saveData(MediaCenterInterface* mediaCenterInterface)
 {
+    // All episodes of a multi-episode file are written to the same NFO file.
+    QVector<TvShowEpisode*> episodesOfFile{this};
+    if (m_show != nullptr) {
+        for (TvShowEpisode* episode : m_show->episodes()) {
+            if (episode != this && episode->files() == files()) {
+                episodesOfFile << episode;
+            }
+        }
+    }
+    loadDetails(episodesOfFile);
+
     if (!streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         loadStreamDetailsFromFile();
     }
@@ -205,6 +229,7 @@ void TvShowEpisode::scrapeData(mediaelch::scraper::TvScraper* scraper,
     using namespace mediaelch::scraper;
 
     qInfo() << "[TvShow] Load episode with show id" << showIdentifier << "using scraper" << scraper->meta().name;
+    loadDetails();
     m_infosToLoad = infosToLoad;
 
     EpisodeIdentifier identifier(showIdentifier.str(), seasonNumber(), episodeNumber(), order);
@@ -248,6 +273,56 @@ void TvShowEpisode::clearImages()
     m_thumbnailImage = QByteArray();
 }
 
+void TvShowEpisode::setDetailsPending(bool infoLoaded)
+{
+    m_detailsPending = true;
+    m_infoLoaded = infoLoaded;
+    m_infoFromNfoLoaded = false;
+}
+
+bool TvShowEpisode::detailsPending() const
+{
+    return m_detailsPending;
+}
+
+void TvShowEpisode::loadDetails()
+{
+    if (m_detailsPending) {
+        loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false, true);
+    }
+}
+
+void TvShowEpisode::loadDetails(const QVector<TvShowEpisode*>& episodes)
+{
+    QVector<TvShowEpisode*> pending;
+    QVector<int> ids;
+    for (TvShowEpisode* episode : episodes) {
+        if (episode->detailsPending()) {
+            pending << episode;
+            ids << episode->databaseId();
+        }
+    }
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    // The database connection must only be used in this thread.
+    const QHash<int, QString> contents = Manager::instance()->database()->episodeNfoContents(ids);
+    for (TvShowEpisode* episode : pending) {
+        episode->setNfoContent(contents.value(episode->databaseId()));
+    }
+    // Episodes without cached contents are loaded from their NFO file.  Signals are
+    // emitted afterwards in this thread because receivers may not be thread safe.
+    QtConcurrent::blockingMap(pending, [](TvShowEpisode* episode) {
+        episode->blockSignals(true);
+        episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), episode->nfoContent().isEmpty(), true);
+        episode->blockSignals(false);
+    });
+    for (TvShowEpisode* episode : pending) {
+        episode->setChanged(false);
+    }
+}
+
 /*** GETTER ***/
 
 bool TvShowEpisode::infoLoaded() const
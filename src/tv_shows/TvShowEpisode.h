@@ -145,6 +145,19 @@ public:
         const QSet<EpisodeScraperInfo>& infosToLoad);
     void loadStreamDetailsFromFile();
     void clearImages();
+
+    /// \brief Marks the episode as loaded from its cache summary only.
+    /// \details Only the title, first aired date and playcount are set.
+    ///          Everything else is loaded from the cached NFO contents on the
+    ///          first call to loadDetails() or loadData().
+    /// \param infoLoaded Whether the episode had infos when the summary was written.
+    void setDetailsPending(bool infoLoaded);
+    bool detailsPending() const;
+    /// \brief Loads the episode's details if only its summary was loaded.
+    void loadDetails();
+    /// \brief Loads the details of all given episodes that have pending details.
+    /// \details The NFO contents are read in one go and parsed in parallel.
+    static void loadDetails(const QVector<TvShowEpisode*>& episodes);
     QSet<EpisodeScraperInfo> infosToLoad();
 
     QVector<ImageType> imagesToRemove() const;
@@ -200,6 +213,7 @@ private:
     bool m_thumbnailImageChanged = false;
     bool m_infoLoaded = false;
     bool m_infoFromNfoLoaded = false;
+    bool m_detailsPending = false;
     bool m_hasChanged = false;
     int m_episodeId = -1;
     bool m_streamDetailsLoaded = false;
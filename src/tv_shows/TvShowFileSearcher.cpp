@@ -2,6 +2,8 @@
 
 #include <QApplication>
 #include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
@@ -10,6 +12,7 @@
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
+#include "tv_shows/EpisodeNumberMatcher.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 #include "tv_shows/model/EpisodeModelItem.h"
@@ -82,6 +85,21 @@ TvShowEpisode* TvShowFileSearcher::loadEpisodeData(TvShowEpisode* episode)
     return episode;
 }
 
+void TvShowFileSearcher::loadCachedEpisodeData(const QVector<TvShowEpisode*>& episodes, bool writeSummaries)
+{
+    QVector<TvShowEpisode*> episodesToLoad;
+    for (TvShowEpisode* episode : episodes) {
+        if (!episode->detailsPending()) {
+            episodesToLoad.append(episode);
+        }
+    }
+    QtConcurrent::blockingMapped(episodesToLoad, TvShowFileSearcher::loadEpisodeData);
+    if (writeSummaries) {
+        // These episodes had no summary yet, e.g. because the cache was written by an older version.
+        Manager::instance()->database()->updateEpisodeSummaries(episodesToLoad);
+    }
+}
+
 void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
 {
     database().clearTvShowInDirectory(showDir);
@@ -118,8 +136,7 @@ void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
     }
 
     // search for contents
-    QVector<QStringList> contents;
-    scanTvShowDir(path, showDir, contents);
+    const QVector<QStringList> contents = scanTvShow(mediaelch::DirectoryPath(path).toString(), showDir.toString());
     auto* show = new TvShow(showDir, this);
     show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
     database().add(show, path);
@@ -130,20 +147,10 @@ void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
     int episodeCounter = 0;
     int episodeSum = contents.count();
 
-    QVector<TvShowEpisode*> episodes;
-    for (const QStringList& files : contents) {
-        if (m_aborted) {
-            return;
-        }
-        SeasonNumber seasonNumber = getSeasonNumber(files);
-        QVector<EpisodeNumber> episodeNumbers = getEpisodeNumbers(files);
-        for (const EpisodeNumber& episodeNumber : episodeNumbers) {
-            auto* episode = new TvShowEpisode(files, show);
-            episode->setSeason(seasonNumber);
-            episode->setEpisode(episodeNumber);
-            episodes.append(episode);
-        }
+    if (m_aborted) {
+        return;
     }
+    QVector<TvShowEpisode*> episodes = createEpisodes(contents, show);
 
     QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
 
@@ -165,48 +172,64 @@ TvShowEpisode* TvShowFileSearcher::reloadEpisodeData(TvShowEpisode* episode)
     return episode;
 }
 
+QVector<QStringList> TvShowFileSearcher::scanTvShow(const QString& startPath, const QString& showDir)
+{
+    QVector<QStringList> contents;
+    const QMap<QString, DirectoryContents> listings = scanTvShowDirs({showDir});
+    collectTvShowContents(startPath, showDir, listings, contents);
+    return contents;
+}
+
 /**
- * \brief Scans a dir for TV show files
+ * \brief Lists all TV show directories inside the given directory
  * \param path Directory to scan
  */
-void TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path, QMap<QString, QVector<QStringList>>& contents)
+QStringList TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path)
 {
+    QStringList showDirs;
     QDir dir(path.toString());
     QStringList tvShows = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
     for (const QString& cDir : tvShows) {
-        if (m_aborted) {
-            return;
-        }
-
         if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
             continue;
         }
-
-        QVector<QStringList> tvShowContents;
-        scanTvShowDir(path, path.subDir(cDir), tvShowContents);
-        contents.insert((dir.path() + '/' + cDir), tvShowContents);
+        showDirs << (dir.path() + '/' + cDir);
     }
+    return showDirs;
 }
 
 /**
- * \brief Scans the given path for TV show files.
- * Results are in a list which contains a QStringList for every episode.
- * \param startPath Scanning started at this path
+ * \brief Scans all given TV show directories in parallel.
+ * \return Contents of all directories keyed by path.
+ *         Use collectTvShowContents() to get the episodes of a TV show.
+ */
+QMap<QString, TvShowFileSearcher::DirectoryContents> TvShowFileSearcher::scanTvShowDirs(const QStringList& showDirs)
+{
+    QMutex mutex;
+    QMap<QString, DirectoryContents> listings;
+    m_walker.walk(showDirs, [&](const QString& path) {
+        QStringList subDirs;
+        DirectoryContents dirContents = scanTvShowDir(path, subDirs);
+        QMutexLocker locker(&mutex);
+        listings.insert(path, dirContents);
+        return subDirs;
+    });
+    return listings;
+}
+
+/**
+ * \brief Scans the given path for TV show files. Does not descend into sub-directories.
+ * Called from worker threads.
  * \param path Path to scan
- * \param contents List of contents
+ * \param subDirs Sub-directories that need to be scanned as well
  */
-void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath,
-    const mediaelch::DirectoryPath& path,
-    QVector<QStringList>& contents)
+TvShowFileSearcher::DirectoryContents TvShowFileSearcher::scanTvShowDir(const QString& path, QStringList& subDirs)
 {
-    emit currentDir(path.toString().mid(startPath.toString().length()));
+    DirectoryContents contents;
+    mediaelch::DirectoryPath dirPath(path);
 
-    QDir dir(path.toString());
+    QDir dir(path);
     for (const QString& cDir : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        if (m_aborted) {
-            return;
-        }
-
         if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
             continue;
         }
@@ -219,25 +242,27 @@ void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath
         }
 
         // Handle DVD
-        if (helper::isDvd(path.subDir(cDir))) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO"));
+        if (helper::isDvd(dirPath.subDir(cDir))) {
+            contents.items.append({QString(), QStringList() << (path + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO")});
             continue;
         }
-        if (helper::isDvd(path.subDir(cDir), true)) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS.IFO"));
+        if (helper::isDvd(dirPath.subDir(cDir), true)) {
+            contents.items.append({QString(), QStringList() << (path + "/" + cDir + "/VIDEO_TS.IFO")});
             continue;
         }
 
         // Handle BluRay
-        if (helper::isBluRay(path.subDir(cDir))) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/BDMV/index.bdmv"));
+        if (helper::isBluRay(dirPath.subDir(cDir))) {
+            contents.items.append({QString(), QStringList() << (path + "/" + cDir + "/BDMV/index.bdmv")});
             continue;
         }
-        scanTvShowDir(startPath, path.subDir(cDir), contents);
+        const QString subDir = path + '/' + cDir;
+        contents.items.append({subDir, {}});
+        subDirs << subDir;
     }
 
     QStringList files;
-    QStringList entries = getFiles(path);
+    QStringList entries = getFiles(dirPath);
     for (const QString& file : entries) {
         if (Settings::instance()->advanced()->isFileExcluded(file)) {
             continue;
@@ -252,17 +277,13 @@ void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath
 
     QRegExp rx("((part|cd)[\\s_]*)(\\d+)", Qt::CaseInsensitive);
     for (int i = 0, n = files.size(); i < n; i++) {
-        if (m_aborted) {
-            return;
-        }
-
         QStringList tvShowFiles;
         QString file = files.at(i);
         if (file.isEmpty()) {
             continue;
         }
 
-        tvShowFiles << (path.toString() + '/' + file);
+        tvShowFiles << (path + '/' + file);
 
         int pos = rx.indexIn(file);
         if (pos != -1) {
@@ -272,14 +293,48 @@ void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath
                 QString subFile = files.at(x);
                 if (subFile != file) {
                     if (subFile.startsWith(left) && subFile.endsWith(right)) {
-                        tvShowFiles << (path.toString() + '/' + subFile);
+                        tvShowFiles << (path + '/' + subFile);
                         files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
                     }
                 }
             }
         }
         if (tvShowFiles.count() > 0) {
-            contents.append(tvShowFiles);
+            contents.items.append({QString(), tvShowFiles});
+        }
+    }
+    return contents;
+}
+
+/**
+ * \brief Collects the TV show files of the given path and all its sub-directories
+ * from the scanned directory listings. Results are in a list which contains
+ * a QStringList for every episode.
+ * \param startPath Scanning started at this path
+ * \param path Path to collect
+ * \param listings Result of scanTvShowDirs()
+ * \param contents List of contents
+ */
+void TvShowFileSearcher::collectTvShowContents(const QString& startPath,
+    const QString& path,
+    const QMap<QString, DirectoryContents>& listings,
+    QVector<QStringList>& contents)
+{
+    emit currentDir(path.mid(startPath.length()));
+
+    const auto listing = listings.constFind(path);
+    if (listing == listings.constEnd()) {
+        return;
+    }
+
+    for (const DirectoryContents::Item& item : listing->items) {
+        if (m_aborted) {
+            return;
+        }
+        if (item.subDir.isEmpty()) {
+            contents.append(item.files);
+        } else {
+            collectTvShowContents(startPath, item.subDir, listings, contents);
         }
     }
 }
@@ -293,47 +348,45 @@ QStringList TvShowFileSearcher::getFiles(const mediaelch::DirectoryPath& path)
 void TvShowFileSearcher::abort()
 {
     m_aborted = true;
+    m_walker.abort();
 }
 
-SeasonNumber TvShowFileSearcher::getSeasonNumber(QStringList files)
+/// \brief Returns the name that contains the season and episode numbers of an episode.
+/// For DVD and BluRay structures this is the name of the episode's directory.
+QString TvShowFileSearcher::episodeFileName(const QStringList& files)
 {
     if (files.isEmpty()) {
-        return SeasonNumber::NoSeason;
+        return {};
+    }
+
+    const QString& path = files.at(0);
+    const int slash = path.lastIndexOf('/');
+    QString filename = path.mid(slash + 1);
+    if (!filename.endsWith("VIDEO_TS.IFO", Qt::CaseInsensitive)
+        && !filename.endsWith("index.bdmv", Qt::CaseInsensitive)) {
+        // Common case: no need to split the whole path.
+        return filename;
     }
 
-    QStringList filenameParts = files.at(0).split('/');
-    QString filename = filenameParts.last();
+    QStringList filenameParts = path.split('/');
     if (filename.endsWith("VIDEO_TS.IFO", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 1 && helper::isDvd(files.at(0))) {
+        if (filenameParts.count() > 1 && helper::isDvd(path)) {
             filename = filenameParts.at(filenameParts.count() - 3);
-        } else if (filenameParts.count() > 2 && helper::isDvd(files.at(0), true)) {
+        } else if (filenameParts.count() > 2 && helper::isDvd(path, true)) {
             filename = filenameParts.at(filenameParts.count() - 2);
         }
-    } else if (filename.endsWith("index.bdmv", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 2) {
-            filename = filenameParts.at(filenameParts.count() - 3);
-        }
+    } else if (filenameParts.count() > 2) {
+        filename = filenameParts.at(filenameParts.count() - 3);
     }
+    return filename;
+}
 
-    QRegExp rx(R"(S(\d+)[ ._-]?E)", Qt::CaseInsensitive);
-    if (rx.indexIn(filename) != -1) {
-        return SeasonNumber(rx.cap(1).toInt());
-    }
-    rx.setPattern("(\\d+)?x(\\d+)");
-    if (rx.indexIn(filename) != -1) {
-        return SeasonNumber(rx.cap(1).toInt());
-    }
-    rx.setPattern("(\\d+).(\\d){2,4}");
-    if (rx.indexIn(filename) != -1) {
-        return SeasonNumber(rx.cap(1).toInt());
-    }
-    rx.setPattern("Season[ ._]?(\\d+)[ ._]?Episode");
-    if (rx.indexIn(filename) != -1) {
-        return SeasonNumber(rx.cap(1).toInt());
+SeasonNumber TvShowFileSearcher::getSeasonNumber(QStringList files)
+{
+    if (files.isEmpty()) {
+        return SeasonNumber::NoSeason;
     }
-
-    // Default if no valid season could be parsed.
-    return SeasonNumber::SpecialsSeason;
+    return mediaelch::EpisodeNumberMatcher::instance().seasonNumber(episodeFileName(files));
 }
 
 QVector<EpisodeNumber> TvShowFileSearcher::getEpisodeNumbers(QStringList files)
@@ -341,77 +394,31 @@ QVector<EpisodeNumber> TvShowFileSearcher::getEpisodeNumbers(QStringList files)
     if (files.isEmpty()) {
         return {};
     }
+    return mediaelch::EpisodeNumberMatcher::instance().episodeNumbers(episodeFileName(files));
+}
 
-    QStringList filenameParts = files.at(0).split('/');
-    QString filename = filenameParts.last();
-    if (filename.endsWith("VIDEO_TS.IFO", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 1 && helper::isDvd(files.at(0))) {
-            filename = filenameParts.at(filenameParts.count() - 3);
-        } else if (filenameParts.count() > 2 && helper::isDvd(files.at(0), true)) {
-            filename = filenameParts.at(filenameParts.count() - 2);
-        }
-    } else if (filename.endsWith("index.bdmv", Qt::CaseInsensitive)) {
-        if (filenameParts.count() > 2) {
-            filename = filenameParts.at(filenameParts.count() - 3);
-        }
+QVector<TvShowEpisode*> TvShowFileSearcher::createEpisodes(const QVector<QStringList>& contents, TvShow* show)
+{
+    QStringList names;
+    names.reserve(contents.size());
+    for (const QStringList& files : contents) {
+        names << episodeFileName(files);
     }
+    // Classify all episodes of the show at once.
+    const auto results = mediaelch::EpisodeNumberMatcher::instance().match(names);
 
-
-    QVector<EpisodeNumber> episodes;
-
-    /// Scans a given filename for a given pattern.
-    /// If mayBeAmbiguous is true, we apply a heuristic to avoid matching the video's resolution
-    auto scanWithPattern = [&](const QString& pattern, bool mayBeAmbiguous) -> bool {
-        QRegExp rx(pattern);
-        rx.setCaseSensitivity(Qt::CaseInsensitive);
-
-        int pos = 0;
-        int lastPos = -1;
-        while ((pos = rx.indexIn(filename, pos)) != -1) {
-            // if between the last match and this one are more than five characters: break
-            // this way we can try to filter "false matches" like in "21x04 - Hammond vs. 6x6.mp4"
-            if (mayBeAmbiguous && lastPos != -1 && lastPos < pos + 5) {
-                return true;
-            }
-            episodes << EpisodeNumber(rx.cap(2).toInt());
-            pos += rx.matchedLength();
-            lastPos = pos;
-        }
-        pos = lastPos;
-
-        // Pattern matched
-        if (episodes.isEmpty()) {
-            return false;
-        }
-
-        if (episodes.count() == 1) {
-            rx.setPattern(R"(^[-_EeXx]+([0-9]+)($|[\-\._\sE]))");
-            while (rx.indexIn(filename, pos, QRegExp::CaretAtOffset) != -1) {
-                episodes << EpisodeNumber(rx.cap(1).toInt());
-                pos += rx.matchedLength() - 1;
-            }
+    QVector<TvShowEpisode*> episodes;
+    for (int i = 0; i < contents.size(); ++i) {
+        if (contents[i].isEmpty()) {
+            continue;
         }
-        return true;
-    };
-
-    struct EpisodeNumberPattern
-    {
-        QString regex;
-        bool mayBeAmbiguous = false;
-    };
-
-    QVector<EpisodeNumberPattern> patterns{{R"(S(\d+)[ ._-]?E(\d+))", false},
-        {R"(S(\d+)[ ._-]?EP(\d+))", false},
-        {R"(Season[ ._-]?(\d+)[._ -]?Episode[ ._-]?(\d+))", false},
-        {R"((\d+)x(\d+))", true},
-        {R"((\d+).(\d){2,4})", true}};
-
-    for (const auto& pattern : patterns) {
-        if (scanWithPattern(pattern.regex, pattern.mayBeAmbiguous)) {
-            break;
+        for (const EpisodeNumber& episodeNumber : results[i].episodes) {
+            auto* episode = new TvShowEpisode(contents[i], show);
+            episode->setSeason(results[i].season);
+            episode->setEpisode(episodeNumber);
+            episodes.append(episode);
         }
     }
-
     return episodes;
 }
 
@@ -440,6 +447,7 @@ void TvShowFileSearcher::clearOldTvShows(bool forceClear)
 
 void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int episodeCounter, int episodeSum)
 {
+    const bool lazyLoading = Settings::instance()->advanced()->lazyEpisodeLoading();
     for (TvShow* show : dbShows) {
         if (m_aborted) {
             return;
@@ -447,8 +455,8 @@ void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int e
 
         show->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false);
 
-        QVector<TvShowEpisode*> episodes = database().episodes(show->databaseId());
-        QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::loadEpisodeData);
+        QVector<TvShowEpisode*> episodes = database().episodes(show->databaseId(), lazyLoading);
+        loadCachedEpisodeData(episodes, lazyLoading);
         for (TvShowEpisode* episode : episodes) {
             if (episode == nullptr) {
                 continue;
@@ -504,19 +512,9 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
         database().add(show, path);
 
         database().transaction();
-        QVector<TvShowEpisode*> episodes;
 
         // Setup episodes list
-        for (const QStringList& files : it.value()) {
-            SeasonNumber seasonNumber = getSeasonNumber(files);
-            QVector<EpisodeNumber> episodeNumbers = getEpisodeNumbers(files);
-            for (const EpisodeNumber& episodeNumber : episodeNumbers) {
-                auto* episode = new TvShowEpisode(files, show);
-                episode->setSeason(seasonNumber);
-                episode->setEpisode(episodeNumber);
-                episodes.append(episode);
-            }
-        }
+        QVector<TvShowEpisode*> episodes = createEpisodes(it.value(), show);
 
         // Load episodes data
         QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
@@ -537,25 +535,34 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
 
 QMap<QString, QVector<QStringList>> TvShowFileSearcher::readTvShowContent(bool forceReload)
 {
-    QMap<QString, QVector<QStringList>> contents;
+    // TV show directory -> directory it was found in
+    QMap<QString, QString> showDirs;
     for (const SettingsDir& dir : m_directories) {
         if (m_aborted) {
             break;
         }
         // Do we need to reload shows from disk?
-        if (dir.autoReload || forceReload) {
-            getTvShows(dir.path, contents);
-            continue;
-        }
         // TODO: Check if necessary?
         // If there are no shows in the database for the directory, reload
         // all shows regardless of forceReload.
-        const int showsFromDatabase = database().showCount(dir.path);
-        if (showsFromDatabase == 0) {
-            getTvShows(dir.path, contents);
-            continue;
+        if (dir.autoReload || forceReload || database().showCount(dir.path) == 0) {
+            for (const QString& showDir : getTvShows(dir.path)) {
+                showDirs.insert(showDir, dir.path.toString());
+            }
         }
     }
+
+    // All TV show directories of all given directories are scanned in parallel.
+    QMap<QString, QVector<QStringList>> contents;
+    const QMap<QString, DirectoryContents> listings = scanTvShowDirs(showDirs.keys());
+    for (auto it = showDirs.constBegin(); it != showDirs.constEnd(); ++it) {
+        if (m_aborted) {
+            break;
+        }
+        QVector<QStringList> tvShowContents;
+        collectTvShowContents(it.value(), it.key(), listings, tvShowContents);
+        contents.insert(it.key(), tvShowContents);
+    }
     return contents;
 }
 
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "file/DirectoryWalker.h"
 #include "file/Path.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDir>
+#include <QMap>
 #include <QObject>
 
 class Database;
@@ -18,6 +20,16 @@ public:
     static QVector<EpisodeNumber> getEpisodeNumbers(QStringList files);
     static TvShowEpisode* loadEpisodeData(TvShowEpisode* episode);
     static TvShowEpisode* reloadEpisodeData(TvShowEpisode* episode);
+    /// \brief Loads cached episodes from their NFO contents in parallel. Episodes that
+    ///        were loaded from their summary only are skipped, see lazyEpisodeLoading.
+    /// \param writeSummaries Write the summary of loaded episodes, e.g. for rows of
+    ///        an older cache that has no summaries yet.
+    static void loadCachedEpisodeData(const QVector<TvShowEpisode*>& episodes, bool writeSummaries);
+
+    /// \brief Lists the episode files of the given TV show directory and all its sub-directories.
+    /// Results are in a list which contains a QStringList for every episode.
+    /// \param startPath TV show directory (see setTvShowDirectories()) the show is in.
+    QVector<QStringList> scanTvShow(const QString& startPath, const QString& showDir);
 
 public slots:
     void reload(bool force);
@@ -31,13 +43,34 @@ signals:
     void currentDir(QString);
 
 private:
+    /// \brief Contents of a single directory inside a TV show directory, in scan order.
+    /// An item either refers to a sub-directory that has its own listing
+    /// or contains the files of one episode.
+    struct DirectoryContents
+    {
+        struct Item
+        {
+            QString subDir;
+            QStringList files;
+        };
+        QVector<Item> items;
+    };
+
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
-    void getTvShows(const mediaelch::DirectoryPath& path, QMap<QString, QVector<QStringList>>& contents);
-    void scanTvShowDir(const mediaelch::DirectoryPath& startPath,
-        const mediaelch::DirectoryPath& path,
+    QStringList getTvShows(const mediaelch::DirectoryPath& path);
+    QMap<QString, DirectoryContents> scanTvShowDirs(const QStringList& showDirs);
+    static DirectoryContents scanTvShowDir(const QString& path, QStringList& subDirs);
+    void collectTvShowContents(const QString& startPath,
+        const QString& path,
+        const QMap<QString, DirectoryContents>& listings,
         QVector<QStringList>& contents);
-    QStringList getFiles(const mediaelch::DirectoryPath& path);
+    static QStringList getFiles(const mediaelch::DirectoryPath& path);
+    static QString episodeFileName(const QStringList& files);
+    /// \brief Creates the episodes of the given show contents.  Files without
+    ///        an episode number are skipped.
+    static QVector<TvShowEpisode*> createEpisodes(const QVector<QStringList>& contents, TvShow* show);
+    mediaelch::DirectoryWalker m_walker;
     bool m_aborted;
 
 private:
@@ -5,6 +5,7 @@
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "tv_shows/TvShowEpisode.h"
 #include "tv_shows/TvShowModel.h"
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
@@ -327,6 +328,17 @@ QVector<TvShow*> TvShowModel::tvShows()
     return shows;
 }
 
+QVector<TvShow*> TvShowModel::tvShowsWithEpisodeDetails()
+{
+    const QVector<TvShow*> shows = tvShows();
+    QVector<TvShowEpisode*> episodes;
+    for (const TvShow* show : shows) {
+        episodes << show->episodes();
+    }
+    TvShowEpisode::loadDetails(episodes);
+    return shows;
+}
+
 /// \brief Checks if there are new shows or episodes (shows or episodes where infoLoaded is false).
 /// \return Number of new episodes and TV shows.
 int TvShowModel::hasNewShowOrEpisode()
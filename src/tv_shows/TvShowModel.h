@@ -45,6 +45,8 @@ public:
     void clear();
 
     QVector<TvShow*> tvShows();
+    /// \brief Like tvShows() but loads pending episode details first, see TvShowEpisode::loadDetails().
+    QVector<TvShow*> tvShowsWithEpisodeDetails();
     int hasNewShowOrEpisode();
 
 private slots:
@@ -5,6 +5,8 @@
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
 
+#include <QRegularExpression>
+
 TvShowProxyModel::TvShowProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
 }
@@ -51,6 +53,17 @@ bool TvShowProxyModel::filterAcceptsRow(int source_row, const QModelIndex& sourc
 
 bool TvShowProxyModel::filterAcceptsRowItself(int sourceRow, const QModelIndex& sourceParent) const
 {
+    if (m_useSearchHits) {
+        auto* model = dynamic_cast<TvShowModel*>(sourceModel());
+        const QModelIndex index = model->index(sourceRow, 0, sourceParent);
+        TvShowBaseModelItem& item = model->getItem(index);
+        if (item.type() == TvShowType::TvShow) {
+            return m_searchHits.contains(item.tvShow());
+        }
+        if (item.type() == TvShowType::Episode) {
+            return m_searchHits.contains(dynamic_cast<EpisodeModelItem&>(item).tvShowEpisode());
+        }
+    }
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
 }
 
@@ -111,12 +124,21 @@ bool TvShowProxyModel::lessThan(const QModelIndex& left, const QModelIndex& righ
         }
     }
 
-    return (
-        QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString()) < 0);
+    return m_collationKeys.compare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString()) < 0;
 }
 
 void TvShowProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = std::move(filters);
     m_filterText = std::move(text);
+
+    // Same text as the wildcard set by TvShowFilesWidget. Seasons are still matched by the wildcard.
+    const QString query = m_filters.isEmpty() ? m_filterText : m_filters.first()->shortText();
+    m_useSearchHits = !query.isEmpty() && !query.contains(QRegularExpression("[*?\\[]"));
+    m_searchHits.clear();
+    if (m_useSearchHits) {
+        mediaelch::MediaSearchIndex* index = Manager::instance()->searchIndex();
+        index->addTvShows(Manager::instance()->tvShowModel()->tvShows());
+        m_searchHits = index->search(query, mediaelch::MediaSearchIndex::Field::Title);
+    }
 }
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "globals/CollationKeys.h"
 #include "globals/Filter.h"
 
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 class TvShowProxyModel : public QSortFilterProxyModel
@@ -21,4 +23,8 @@ protected:
 private:
     QVector<Filter*> m_filters;
     QString m_filterText;
+    /// TV shows and episodes whose title contains the filter text, see MediaSearchIndex.
+    QSet<const QObject*> m_searchHits;
+    bool m_useSearchHits = false;
+    mutable mediaelch::CollationKeyCache m_collationKeys;
 };
@@ -0,0 +1,561 @@
+#include "tv_shows/TvShowScrapeItem.h"
+
+#include "data/ImageCache.h"
+#include "globals/DownloadManager.h"
+#include "globals/Helper.h"
+#include "globals/Manager.h"
+#include "media_centers/MediaCenterInterface.h"
+#include "scrapers/tv_show/ShowSearchJob.h"
+#include "scrapers/tv_show/TvScraper.h"
+#include "scrapers/tv_show/custom/CustomTvScraper.h"
+#include "scrapers/tv_show/imdb/ImdbTv.h"
+#include "scrapers/tv_show/thetvdb/TheTvDb.h"
+#include "scrapers/tv_show/tmdb/TmdbTv.h"
+#include "scrapers/tv_show/tvmaze/TvMaze.h"
+#include "settings/Settings.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QDebug>
+
+namespace mediaelch {
+
+scraper::ShowIdentifier showIdentifierForScraper(const scraper::TvScraper& scraper, const TvShow& show)
+{
+    using namespace mediaelch::scraper;
+    const QString& scraperId = scraper.meta().identifier;
+
+    if (scraperId == TheTvDb::ID) {
+        return ShowIdentifier(show.tvdbId());
+    }
+    if (scraperId == ImdbTv::ID) {
+        return ShowIdentifier(show.imdbId());
+    }
+    if (scraperId == TvMaze::ID) {
+        return ShowIdentifier(show.tvmazeId());
+    }
+    if (scraperId == TmdbTv::ID || scraperId == CustomTvScraper::ID) {
+        // The CustomTvScraper depends on TMDb
+        return ShowIdentifier(show.tmdbId());
+    }
+    return ShowIdentifier();
+}
+
+bool hasValidShowIdForScraper(const scraper::TvScraper& scraper, const TvShow& show)
+{
+    using namespace mediaelch::scraper;
+    const QString& scraperId = scraper.meta().identifier;
+
+    if (scraperId == TheTvDb::ID) {
+        return show.tvdbId().isValid();
+    }
+    if (scraperId == ImdbTv::ID) {
+        return show.imdbId().isValid();
+    }
+    if (scraperId == TvMaze::ID) {
+        return show.tvmazeId().isValid();
+    }
+    if (scraperId == TmdbTv::ID || scraperId == CustomTvScraper::ID) {
+        // The CustomTvScraper depends on TMDb
+        return show.tmdbId().isValid();
+    }
+    return false;
+}
+
+TvScrapeItemBase::TvScrapeItemBase(TvScrapeConfig config, QObject* parent) :
+    scraper::ScrapePipelineItem(parent), m_config{std::move(config)}
+{
+}
+
+QString TvScrapeItemBase::scraperKey() const
+{
+    return m_config.scraper->meta().identifier;
+}
+
+void TvScrapeItemBase::searchShow(const QString& query)
+{
+    using namespace mediaelch::scraper;
+
+    acquireSlot(scraperKey(), [this, query]() {
+        setStage(Stage::Search);
+        ShowSearchJob::Config config{query, m_config.locale, Settings::instance()->showAdultScrapers()};
+        auto* searchJob = m_config.scraper->search(config);
+        connect(searchJob, &ShowSearchJob::sigFinished, this, &TvScrapeItemBase::onSearchFinished);
+        searchJob->execute();
+    });
+}
+
+void TvScrapeItemBase::onSearchFinished(scraper::ShowSearchJob* searchJob)
+{
+    searchJob->deleteLater();
+    if (isAborted()) {
+        return;
+    }
+    releaseSlot(scraperKey());
+
+    if (searchJob->hasError()) {
+        finish(Stage::Failed, tr("Error while searching for TV show: \"%1\"").arg(searchJob->error().message));
+        return;
+    }
+    if (searchJob->results().isEmpty()) {
+        finish(Stage::Skipped, tr("Did not find any results for search term \"%1\".").arg(searchJob->config().query));
+        return;
+    }
+    onShowFound(searchJob->results().first().identifier);
+}
+
+void TvScrapeItemBase::doAbort()
+{
+    if (m_downloadManager != nullptr) {
+        m_downloadManager->abortDownloads();
+    }
+}
+
+DownloadManager* TvScrapeItemBase::downloadManager()
+{
+    if (m_downloadManager == nullptr) {
+        m_downloadManager = new DownloadManager(this);
+        // Images of items that are scraped in the background must not delay images of the selected item.
+        m_downloadManager->setPriority(DownloadPriority::Low);
+
+        const auto queued = static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection);
+        connect(m_downloadManager,
+            &DownloadManager::sigElemDownloaded,
+            this,
+            &TvScrapeItemBase::onDownloadFinished,
+            queued);
+        connect(m_downloadManager,
+            &DownloadManager::allDownloadsFinished,
+            this,
+            &TvScrapeItemBase::onAllDownloadsFinished,
+            queued);
+    }
+    return m_downloadManager;
+}
+
+void TvScrapeItemBase::startDownloads(int count)
+{
+    m_downloadsTotal = count;
+    m_downloadsDone = 0;
+    setStage(Stage::Images);
+    reportProgress(0, m_downloadsTotal);
+}
+
+void TvScrapeItemBase::onDownloadFinished(DownloadManagerElement elem)
+{
+    if (elem.show != nullptr) {
+        if (TvShow::seasonImageTypes().contains(elem.imageType)) {
+            if (elem.imageType == ImageType::TvShowSeasonBackdrop) {
+                helper::resizeBackdrop(elem.data);
+            }
+            ImageCache::instance()->invalidateImages(
+                Manager::instance()->mediaCenterInterface()->imageFileName(elem.show, elem.imageType, elem.season));
+            elem.show->setSeasonImage(elem.season, elem.imageType, elem.data);
+
+        } else if (elem.imageType != ImageType::Actor) {
+            if (elem.imageType == ImageType::TvShowBackdrop) {
+                helper::resizeBackdrop(elem.data);
+            }
+            ImageCache::instance()->invalidateImages(
+                Manager::instance()->mediaCenterInterface()->imageFileName(elem.show, elem.imageType));
+            elem.show->setImage(elem.imageType, elem.data);
+        }
+
+    } else if ((elem.episode != nullptr) && elem.imageType == ImageType::TvShowEpisodeThumb) {
+        elem.episode->setThumbnailImage(elem.data);
+    }
+
+    ++m_downloadsDone;
+    reportProgress(m_downloadsDone, m_downloadsTotal);
+}
+
+void TvScrapeItemBase::onAllDownloadsFinished()
+{
+    if (isAborted()) {
+        return;
+    }
+    save();
+}
+
+TvShowScrapeItem::TvShowScrapeItem(TvShow* show, TvScrapeConfig config, QObject* parent) :
+    TvScrapeItemBase(std::move(config), parent), m_show{show}
+{
+}
+
+TvShowScrapeItem::~TvShowScrapeItem()
+{
+    if (!m_show.isNull()) {
+        disconnect(m_show.data(), nullptr, this, nullptr);
+    }
+}
+
+TvShow* TvShowScrapeItem::show() const
+{
+    return m_show;
+}
+
+QString TvShowScrapeItem::title() const
+{
+    return m_show.isNull() ? QString() : m_show->title().trimmed();
+}
+
+void TvShowScrapeItem::run()
+{
+    using namespace mediaelch::scraper;
+
+    if (m_show.isNull() || m_config.scraper == nullptr) {
+        finish(Stage::Failed, tr("TV show or scraper is not available anymore."));
+        return;
+    }
+
+    // Check if the show has an ID that suits the current scraper.
+    // If not and the "only with ID" option is enabled, skip it.
+    const auto id = showIdentifierForScraper(*m_config.scraper, *m_show);
+    if (id.str().isEmpty() && m_config.onlyWithId) {
+        finish(Stage::Skipped, tr("Skipping show \"%1\" because it does not have a valid ID.").arg(m_show->title()));
+        return;
+    }
+
+    if (!id.str().isEmpty()) {
+        log(tr("Scraping TV show with ID \"%1\".").arg(id.str()));
+        loadShow(id);
+        return;
+    }
+
+    // Most scrapers do not support a year, so we remove it.
+    // Because the title may still be the filename / folder name, we also replace
+    // the dot with space.
+    // TODO: Use some common utility function for sanitization.
+    QString searchQuery = m_show->title().replace(".", " ").trimmed();
+    searchQuery = ShowSearchJob::extractTitleAndYear(searchQuery).first;
+
+    log(tr("Search for TV show \"%1\" because no valid ID was found.").arg(searchQuery));
+    searchShow(searchQuery);
+}
+
+void TvShowScrapeItem::doAbort()
+{
+    TvScrapeItemBase::doAbort();
+    if (!m_show.isNull()) {
+        disconnect(m_show.data(), nullptr, this, nullptr);
+    }
+    disconnect(Manager::instance()->fanartTv(), nullptr, this, nullptr);
+}
+
+void TvShowScrapeItem::onShowFound(const scraper::ShowIdentifier& id)
+{
+    if (m_show.isNull()) {
+        finish(Stage::Failed, tr("TV show is not available anymore."));
+        return;
+    }
+    log(tr("Scraping TV show with ID \"%1\".").arg(id.str()));
+    m_config.showIds->insert(m_show->title(), id);
+    loadShow(id);
+}
+
+void TvShowScrapeItem::loadShow(const scraper::ShowIdentifier& id)
+{
+    acquireSlot(scraperKey(), [this, id]() {
+        if (m_show.isNull()) {
+            finish(Stage::Failed, tr("TV show is not available anymore."));
+            return;
+        }
+        setStage(Stage::Load);
+        connect(m_show.data(), &TvShow::sigLoaded, this, &TvShowScrapeItem::onInfoLoadDone, Qt::UniqueConnection);
+        m_show->scrapeData(m_config.scraper,
+            id,
+            m_config.locale,
+            m_config.seasonOrder,
+            TvShowUpdateType::Show,
+            m_config.showDetails,
+            m_config.episodeDetails);
+    });
+}
+
+void TvShowScrapeItem::onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details)
+{
+    if (show != m_show) {
+        return;
+    }
+    disconnect(show, &TvShow::sigLoaded, this, &TvShowScrapeItem::onInfoLoadDone);
+    releaseSlot(scraperKey());
+
+    if (show->showMissingEpisodes()) {
+        show->clearMissingEpisodes();
+        show->fillMissingEpisodes();
+    }
+
+    log(tr("Finished scraping details of TV show \"%1\".").arg(show->title()));
+
+    QVector<ImageType> types = {ImageType::TvShowClearArt,
+        ImageType::TvShowLogos,
+        ImageType::TvShowCharacterArt,
+        ImageType::TvShowThumb,
+        ImageType::TvShowSeasonThumb};
+
+    if (show->tvdbId().isValid() && details.contains(ShowScraperInfo::ExtraArts)) {
+        log(tr("Start loading extra fanart from TheTvDb for TV show with ID \"%1\".") //
+                .arg(show->tvdbId().toString()));
+        // The image provider is shared: onImagesLoaded() ignores other shows.
+        connect(Manager::instance()->fanartTv(),
+            &scraper::ImageProvider::sigTvShowImagesLoaded,
+            this,
+            &TvShowScrapeItem::onImagesLoaded,
+            Qt::UniqueConnection);
+        Manager::instance()->fanartTv()->tvShowImages(show, show->tvdbId(), types, m_config.locale);
+
+    } else {
+        onImagesLoaded(show, {});
+    }
+}
+
+void TvShowScrapeItem::onImagesLoaded(TvShow* show, QMap<ImageType, QVector<Poster>> posters)
+{
+    if (show != m_show) {
+        return;
+    }
+    disconnect(Manager::instance()->fanartTv(), nullptr, this, nullptr);
+
+    const QSet<ShowScraperInfo>& details = m_config.showDetails;
+    int downloadsSize = 0;
+
+    if (!show->posters().isEmpty() && details.contains(ShowScraperInfo::Poster)) {
+        addDownload(ImageType::TvShowPoster, show->posters().at(0).originalUrl);
+        downloadsSize++;
+    }
+
+    if (!show->backdrops().isEmpty() && details.contains(ShowScraperInfo::Fanart)) {
+        addDownload(ImageType::TvShowBackdrop, show->backdrops().at(0).originalUrl);
+        downloadsSize++;
+    }
+
+    if (!show->banners().isEmpty() && details.contains(ShowScraperInfo::Banner)) {
+        addDownload(ImageType::TvShowBanner, show->banners().at(0).originalUrl);
+        downloadsSize++;
+    }
+
+    QVector<SeasonNumber> thumbsForSeasons;
+    QMapIterator<ImageType, QVector<Poster>> it(posters);
+    while (it.hasNext()) {
+        it.next();
+        if (it.value().isEmpty()) {
+            continue;
+        }
+        const bool isExtraArt = it.key() == ImageType::TvShowClearArt || it.key() == ImageType::TvShowCharacterArt
+                                || it.key() == ImageType::TvShowLogos || it.key() == ImageType::TvShowThumb;
+        if (isExtraArt && details.contains(ShowScraperInfo::ExtraArts)) {
+            addDownload(it.key(), it.value().at(0).originalUrl);
+            downloadsSize++;
+
+        } else if (it.key() == ImageType::TvShowSeasonThumb && details.contains(ShowScraperInfo::SeasonThumb)) {
+            for (const Poster& p : it.value()) {
+                if (thumbsForSeasons.contains(p.season) || !show->seasons().contains(p.season)) {
+                    continue;
+                }
+                addDownload(ImageType::TvShowSeasonThumb, p.originalUrl, p.season);
+                downloadsSize++;
+                thumbsForSeasons.append(p.season);
+            }
+        }
+    }
+
+    if (details.contains(ShowScraperInfo::Actors) && Settings::instance()->downloadActorImages()) {
+        for (Actor* actor : show->actors()) {
+            if (actor->thumb.isEmpty()) {
+                continue;
+            }
+            addDownload(ImageType::Actor, QUrl(actor->thumb), actor);
+            downloadsSize++;
+        }
+    }
+
+    for (SeasonNumber season : show->seasons()) {
+        if (!show->seasonPosters(season).isEmpty() && details.contains(ShowScraperInfo::SeasonPoster)) {
+            addDownload(ImageType::TvShowSeasonPoster, show->seasonPosters(season).at(0).originalUrl, season);
+            downloadsSize++;
+        }
+        if (!show->seasonBackdrops(season).isEmpty() && details.contains(ShowScraperInfo::SeasonBackdrop)) {
+            addDownload(ImageType::TvShowSeasonBackdrop, show->seasonBackdrops(season).at(0).originalUrl, season);
+            downloadsSize++;
+        }
+        if (!show->seasonBanners(season).isEmpty() && details.contains(ShowScraperInfo::SeasonBanner)) {
+            addDownload(ImageType::TvShowSeasonBanner, show->seasonBanners(season).at(0).originalUrl, season);
+            downloadsSize++;
+        }
+    }
+
+    if (downloadsSize > 0) {
+        startDownloads(downloadsSize);
+    } else {
+        save();
+    }
+}
+
+void TvShowScrapeItem::addDownload(ImageType imageType, QUrl url, SeasonNumber season)
+{
+    DownloadManagerElement d;
+    d.imageType = imageType;
+    d.url = std::move(url);
+    d.season = season;
+    d.show = m_show;
+    downloadManager()->addDownload(d);
+}
+
+void TvShowScrapeItem::addDownload(ImageType imageType, QUrl url, Actor* actor)
+{
+    DownloadManagerElement d;
+    d.imageType = imageType;
+    d.url = std::move(url);
+    d.actor = actor;
+    d.show = m_show;
+    downloadManager()->addDownload(d);
+}
+
+void TvShowScrapeItem::save()
+{
+    if (m_show.isNull()) {
+        finish(Stage::Failed, tr("TV show is not available anymore."));
+        return;
+    }
+    if (m_config.saveToDisk) {
+        setStage(Stage::Save);
+        if (!m_show->saveData(Manager::instance()->mediaCenterInterfaceTvShow())) {
+            finish(Stage::Failed, tr("Could not save TV show \"%1\".").arg(m_show->title()));
+            return;
+        }
+    }
+    finish(Stage::Done);
+}
+
+TvShowEpisodeScrapeItem::TvShowEpisodeScrapeItem(TvShowEpisode* episode, TvScrapeConfig config, QObject* parent) :
+    TvScrapeItemBase(std::move(config), parent), m_episode{episode}
+{
+}
+
+TvShowEpisodeScrapeItem::~TvShowEpisodeScrapeItem()
+{
+    if (!m_episode.isNull()) {
+        disconnect(m_episode.data(), nullptr, this, nullptr);
+    }
+}
+
+TvShowEpisode* TvShowEpisodeScrapeItem::episode() const
+{
+    return m_episode;
+}
+
+QString TvShowEpisodeScrapeItem::title() const
+{
+    return m_episode.isNull() ? QString() : m_episode->title().trimmed();
+}
+
+void TvShowEpisodeScrapeItem::run()
+{
+    if (m_episode.isNull() || m_episode->tvShow() == nullptr || m_config.scraper == nullptr) {
+        finish(Stage::Failed, tr("Episode or scraper is not available anymore."));
+        return;
+    }
+
+    const TvShow* show = m_episode->tvShow();
+    auto id = showIdentifierForScraper(*m_config.scraper, *show);
+
+    if (id.str().isEmpty() && m_config.onlyWithId) {
+        finish(Stage::Skipped, tr("Skipping show \"%1\" because it does not have a valid ID.").arg(show->title()));
+        return;
+    }
+
+    if (id.str().isEmpty() && m_config.showIds->contains(show->title())) {
+        id = m_config.showIds->value(show->title());
+    }
+
+    if (id.str().isEmpty()) {
+        log(tr("Search for TV show \"%1\" because no valid show ID was found for the episode.").arg(show->title()));
+        searchShow(show->title());
+        return;
+    }
+
+    loadEpisode(id);
+}
+
+void TvShowEpisodeScrapeItem::doAbort()
+{
+    TvScrapeItemBase::doAbort();
+    if (!m_episode.isNull()) {
+        disconnect(m_episode.data(), nullptr, this, nullptr);
+    }
+}
+
+void TvShowEpisodeScrapeItem::onShowFound(const scraper::ShowIdentifier& id)
+{
+    if (m_episode.isNull() || m_episode->tvShow() == nullptr) {
+        finish(Stage::Failed, tr("Episode is not available anymore."));
+        return;
+    }
+    m_config.showIds->insert(m_episode->tvShow()->title(), id);
+    loadEpisode(id);
+}
+
+void TvShowEpisodeScrapeItem::loadEpisode(const scraper::ShowIdentifier& id)
+{
+    acquireSlot(scraperKey(), [this, id]() {
+        if (m_episode.isNull()) {
+            finish(Stage::Failed, tr("Episode is not available anymore."));
+            return;
+        }
+        log(tr("S%1E%2: Scraping episode with show ID \"%3\".")
+                .arg(m_episode->seasonNumber().toPaddedString(),
+                    m_episode->episodeNumber().toPaddedString(),
+                    id.str()));
+        setStage(Stage::Load);
+        connect(m_episode.data(),
+            &TvShowEpisode::sigLoaded,
+            this,
+            &TvShowEpisodeScrapeItem::onEpisodeLoadDone,
+            Qt::UniqueConnection);
+        m_episode->scrapeData(m_config.scraper, m_config.locale, id, m_config.seasonOrder, m_config.episodeDetails);
+    });
+}
+
+void TvShowEpisodeScrapeItem::onEpisodeLoadDone(TvShowEpisode* episode)
+{
+    if (episode != m_episode) {
+        return;
+    }
+    disconnect(episode, &TvShowEpisode::sigLoaded, this, &TvShowEpisodeScrapeItem::onEpisodeLoadDone);
+    releaseSlot(scraperKey());
+
+    log(tr("S%2E%3: Finished scraping episode details. Title is: \"%1\".")
+            .arg(episode->title(),
+                episode->seasonNumber().toPaddedString(),
+                episode->episodeNumber().toPaddedString()));
+
+    if (m_config.episodeDetails.contains(EpisodeScraperInfo::Thumbnail) && !episode->thumbnail().isEmpty()) {
+        DownloadManagerElement d;
+        d.imageType = ImageType::TvShowEpisodeThumb;
+        d.url = episode->thumbnail();
+        d.episode = episode;
+        d.directDownload = true;
+        downloadManager()->addDownload(d);
+        startDownloads(1);
+    } else {
+        save();
+    }
+}
+
+void TvShowEpisodeScrapeItem::save()
+{
+    if (m_episode.isNull()) {
+        finish(Stage::Failed, tr("Episode is not available anymore."));
+        return;
+    }
+    if (m_config.saveToDisk) {
+        setStage(Stage::Save);
+        if (!m_episode->saveData(Manager::instance()->mediaCenterInterfaceTvShow())) {
+            finish(Stage::Failed, tr("Could not save episode \"%1\".").arg(m_episode->title()));
+            return;
+        }
+    }
+    finish(Stage::Done);
+}
+
+} // namespace mediaelch
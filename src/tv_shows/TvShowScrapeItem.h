@@ -0,0 +1,142 @@
+#pragma once
+
+#include "data/Locale.h"
+#include "globals/DownloadManagerElement.h"
+#include "globals/Globals.h"
+#include "globals/Poster.h"
+#include "globals/ScraperInfos.h"
+#include "scrapers/ScrapePipeline.h"
+#include "scrapers/tv_show/ShowIdentifier.h"
+#include "tv_shows/SeasonNumber.h"
+#include "tv_shows/SeasonOrder.h"
+
+#include <QMap>
+#include <QPointer>
+#include <QSet>
+#include <QUrl>
+#include <memory>
+
+class Actor;
+class DownloadManager;
+class TvShow;
+class TvShowEpisode;
+
+namespace mediaelch {
+namespace scraper {
+class ShowSearchJob;
+class TvScraper;
+} // namespace scraper
+
+/// \brief Get the appropriate ID for the given scraper. Used for the "with ID only" feature.
+scraper::ShowIdentifier showIdentifierForScraper(const scraper::TvScraper& scraper, const TvShow& show);
+bool hasValidShowIdForScraper(const scraper::TvScraper& scraper, const TvShow& show);
+
+/// \brief Settings shared by all TV show and episode items of a ScrapePipeline.
+struct TvScrapeConfig
+{
+    scraper::TvScraper* scraper = nullptr;
+    Locale locale = Locale::English;
+    SeasonOrder seasonOrder = SeasonOrder::Aired;
+    QSet<ShowScraperInfo> showDetails;
+    QSet<EpisodeScraperInfo> episodeDetails;
+    /// \brief Skip shows/episodes without an ID for the scraper instead of searching them.
+    bool onlyWithId = false;
+    /// \brief Write NFO files and images once an item was scraped.
+    bool saveToDisk = false;
+    /// \brief Show identifiers found by searches, keyed by the show's title.
+    /// \details Shared between items so that episodes of a show that was already
+    ///          searched do not search again.
+    std::shared_ptr<QMap<QString, scraper::ShowIdentifier>> showIds =
+        std::make_shared<QMap<QString, scraper::ShowIdentifier>>();
+};
+
+/// \brief Base class for TV show and episode items: search and image downloads.
+class TvScrapeItemBase : public scraper::ScrapePipelineItem
+{
+    Q_OBJECT
+public:
+    TvScrapeItemBase(TvScrapeConfig config, QObject* parent = nullptr);
+    ~TvScrapeItemBase() override = default;
+
+protected:
+    QString scraperKey() const;
+    /// \brief Searches the given show title and calls onShowFound() with the first result.
+    void searchShow(const QString& query);
+    virtual void onShowFound(const scraper::ShowIdentifier& id) = 0;
+    /// \brief Saves the item if configured and finishes it.
+    virtual void save() = 0;
+
+    void doAbort() override;
+
+    DownloadManager* downloadManager();
+    /// \brief Switches to the image stage. Downloads must already be added to downloadManager().
+    void startDownloads(int count);
+
+protected:
+    TvScrapeConfig m_config;
+
+private:
+    void onSearchFinished(scraper::ShowSearchJob* searchJob);
+    void onDownloadFinished(DownloadManagerElement elem);
+    void onAllDownloadsFinished();
+
+private:
+    DownloadManager* m_downloadManager = nullptr;
+    int m_downloadsTotal = 0;
+    int m_downloadsDone = 0;
+};
+
+/// \brief Scrapes a TV show's details and images as part of a ScrapePipeline.
+class TvShowScrapeItem : public TvScrapeItemBase
+{
+    Q_OBJECT
+public:
+    TvShowScrapeItem(TvShow* show, TvScrapeConfig config, QObject* parent = nullptr);
+    ~TvShowScrapeItem() override;
+
+    TvShow* show() const;
+    QString title() const override;
+
+protected:
+    void run() override;
+    void doAbort() override;
+    void onShowFound(const scraper::ShowIdentifier& id) override;
+    void save() override;
+
+private:
+    void loadShow(const scraper::ShowIdentifier& id);
+    void onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details);
+    void onImagesLoaded(TvShow* show, QMap<ImageType, QVector<Poster>> posters);
+    void addDownload(ImageType imageType, QUrl url, SeasonNumber season = SeasonNumber::NoSeason);
+    void addDownload(ImageType imageType, QUrl url, Actor* actor);
+
+private:
+    QPointer<TvShow> m_show;
+};
+
+/// \brief Scrapes a single episode and its thumbnail as part of a ScrapePipeline.
+class TvShowEpisodeScrapeItem : public TvScrapeItemBase
+{
+    Q_OBJECT
+public:
+    TvShowEpisodeScrapeItem(TvShowEpisode* episode, TvScrapeConfig config, QObject* parent = nullptr);
+    ~TvShowEpisodeScrapeItem() override;
+
+    TvShowEpisode* episode() const;
+    QString title() const override;
+
+protected:
+    void run() override;
+    void doAbort() override;
+    void onShowFound(const scraper::ShowIdentifier& id) override;
+    void save() override;
+
+private:
+    void loadEpisode(const scraper::ShowIdentifier& id);
+    void onEpisodeLoadDone(TvShowEpisode* episode);
+
+private:
+    QPointer<TvShowEpisode> m_episode;
+};
+
+} // namespace mediaelch
@@ -225,6 +225,11 @@ void ConcertWidget::setDisabledTrue()
 void ConcertWidget::setConcert(Concert* concert)
 {
     qDebug() << "Entered, concert=" << concert->name();
+    if (m_concert != nullptr && m_concert != concert) {
+        m_concert->controller()->setDownloadPriority(DownloadPriority::Normal);
+    }
+    // Images of the selected concert are downloaded before images of other items.
+    concert->controller()->setDownloadPriority(DownloadPriority::High);
     concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert());
     m_concert = concert;
     if (!concert->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
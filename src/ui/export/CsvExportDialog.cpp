@@ -122,7 +122,7 @@ void CsvExportDialog::onExport()
 
     // Movies ------------------------------------------
     if (!m_shouldAbort && ui->checkMovies->isChecked()) {
-        const QVector<Movie*>& movies = Manager::instance()->movieModel()->movies();
+        const QVector<Movie*>& movies = Manager::instance()->movieModel()->moviesWithDetails();
 
         int processedCount = 0;
         ui->exportProgress->setRange(0, movies.size());
@@ -139,7 +139,7 @@ void CsvExportDialog::onExport()
     }
     // TV shows ----------------------------------------
     if (!m_shouldAbort) {
-        const QVector<TvShow*>& tvShows = Manager::instance()->tvShowModel()->tvShows();
+        const QVector<TvShow*>& tvShows = Manager::instance()->tvShowModel()->tvShowsWithEpisodeDetails();
         if (ui->checkTvShows->isChecked()) {
             int processedCount = 0;
             ui->exportProgress->setRange(0, tvShows.size());
@@ -13,6 +13,7 @@
 #include "tv_shows/model/TvShowModelItem.h"
 #include "ui/notifications/Notificator.h"
 
+#include <QDebug>
 #include <QMessageBox>
 #include <QMovie>
 #include <QRegularExpression>
@@ -45,6 +46,7 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     connect(ui->tvShowSearchWidget, &TvShowSearchWidget::sigResultClicked, this, &ImportDialog::onTvShowChosen);
     connect(ui->btnImport, &QAbstractButton::clicked, this, &ImportDialog::onImport);
     connect(&m_timer, &QTimer::timeout, this, &ImportDialog::onFileWatcherTimeout);
+    connect(&m_importer, &mediaelch::FileImporter::sigFinished, this, &ImportDialog::onMovingFilesFinished);
 }
 
 ImportDialog::~ImportDialog()
@@ -55,6 +57,9 @@ ImportDialog::~ImportDialog()
 void ImportDialog::reject()
 {
     if (!m_filesToMove.isEmpty()) {
+        // Cancel the running import; onMovingFilesFinished() is called once it has stopped.
+        m_importer.cancel();
+        ui->btnReject->setEnabled(false);
         return;
     }
 
@@ -608,58 +613,57 @@ void ImportDialog::onImport()
 
     ui->loading->setVisible(true);
     ui->btnImport->setEnabled(false);
-    ui->btnReject->setEnabled(false);
-    m_worker = new FileWorker();
-    m_worker->setFiles(m_filesToMove);
-    m_workerThread = new QThread(this);
-    if (ui->chkKeepSourceFiles->isChecked()) {
-        connect(m_workerThread.data(), &QThread::started, m_worker.data(), &FileWorker::copyFiles);
-    } else {
-        connect(m_workerThread.data(), &QThread::started, m_worker.data(), &FileWorker::moveFiles);
-    }
-    connect(m_workerThread.data(), &QThread::finished, m_worker.data(), &QObject::deleteLater);
-    connect(m_workerThread.data(), &QThread::finished, m_workerThread.data(), &QObject::deleteLater);
-    connect(m_worker.data(), &FileWorker::sigFinished, m_workerThread.data(), &QThread::quit);
-    connect(m_worker.data(), &FileWorker::sigFinished, this, &ImportDialog::onMovingFilesFinished);
-    m_worker->moveToThread(m_workerThread);
-    m_workerThread->start();
+    // The import can be cancelled using the reject button.
+    ui->btnReject->setEnabled(true);
+    m_importer.start(m_filesToMove,
+        ui->chkKeepSourceFiles->isChecked() ? mediaelch::FileImporter::Mode::Copy
+                                            : mediaelch::FileImporter::Mode::Move);
     m_timer.start();
 }
 
 void ImportDialog::onFileWatcherTimeout()
 {
-    qint64 sourceSize = 0;
-    qint64 destinationSize = 0;
-    QMapIterator<QString, QString> it(m_filesToMove);
-    while (it.hasNext()) {
-        it.next();
-        QFileInfo sourceFi(it.key());
-        sourceSize += sourceFi.size();
-
-        QFileInfo destFi(it.value());
-        if (!destFi.exists()) {
-            continue;
-        }
-        destinationSize += destFi.size();
-    }
-
-    if (sourceSize == 0) {
+    const qint64 bytesTotal = m_importer.bytesTotal();
+    if (bytesTotal == 0) {
         return;
     }
-
-    ui->progressBar->setValue(qRound(static_cast<float>(destinationSize) * 100.0f / static_cast<float>(sourceSize)));
+    ui->progressBar->setValue(qRound(static_cast<double>(m_importer.bytesDone()) * 100.0 / bytesTotal));
 }
 
 void ImportDialog::onMovingFilesFinished()
 {
-    ui->progressBar->setValue(100);
     m_timer.stop();
+
+    // Only files that are actually in the library are added to the media item.
+    // Files of a cancelled import that were already imported are kept as well.
+    const QStringList failedFiles = m_importer.failedFiles();
+    QStringList importedFiles = m_newFiles;
+    for (const QString& file : failedFiles) {
+        qWarning() << "[ImportDialog] Could not import" << file;
+        importedFiles.removeAll(m_filesToMove.value(file));
+    }
+    m_filesToMove.clear();
+
+    if (importedFiles.isEmpty()) {
+        // The media item is not added; reject() deletes it.
+        ui->loading->setVisible(false);
+        if (m_importer.wasCancelled()) {
+            ui->badgeSuccess->setText(tr("Import was cancelled"));
+        } else {
+            ui->badgeSuccess->setText(tr("Import has failed"));
+            Notificator::instance()->notify(Notificator::Warning,
+                tr("Import failed"),
+                tr("%n files could not be imported", "", failedFiles.count()));
+        }
+        ui->btnReject->setEnabled(true);
+        return;
+    }
+
+    ui->progressBar->setValue(100);
     if (m_type == "movie") {
-        m_movie->setFiles(m_newFiles);
+        m_movie->setFiles(importedFiles);
         m_movie->setInSeparateFolder(m_separateFolders);
-        if (!m_newFiles.isEmpty()) {
-            m_movie->setFileLastModified(QFileInfo(m_newFiles.first()).lastModified());
-        }
+        m_movie->setFileLastModified(QFileInfo(importedFiles.first()).lastModified());
         m_movie->controller()->loadStreamDetailsFromFile();
         m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
         m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
@@ -673,7 +677,7 @@ void ImportDialog::onMovingFilesFinished()
             m_show->clearMissingEpisodes();
         }
 
-        m_episode->setFiles(m_newFiles);
+        m_episode->setFiles(importedFiles);
         m_episode->loadStreamDetailsFromFile();
         m_show->addEpisode(m_episode);
         m_episode->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
@@ -695,7 +699,7 @@ void ImportDialog::onMovingFilesFinished()
         m_show = nullptr;
 
     } else if (m_type == "concert") {
-        m_concert->setFiles(m_newFiles);
+        m_concert->setFiles(importedFiles);
         m_concert->controller()->loadStreamDetailsFromFile();
         m_concert->controller()->saveData(Manager::instance()->mediaCenterInterface());
         m_concert->controller()->loadData(Manager::instance()->mediaCenterInterface());
@@ -705,13 +709,19 @@ void ImportDialog::onMovingFilesFinished()
         m_concert = nullptr;
     }
 
-    Notificator::instance()->notify(
-        Notificator::Information, tr("Import finished"), tr("Import of %n files has finished", "", files().count()));
+    if (failedFiles.isEmpty()) {
+        Notificator::instance()->notify(Notificator::Information,
+            tr("Import finished"),
+            tr("Import of %n files has finished", "", files().count()));
+    } else {
+        Notificator::instance()->notify(Notificator::Warning,
+            tr("Import finished"),
+            tr("%n files could not be imported", "", failedFiles.count()));
+    }
 
     ui->loading->setVisible(false);
-    ui->badgeSuccess->setText(tr("Import has finished"));
-
-    m_filesToMove.clear();
+    ui->badgeSuccess->setText(
+        m_importer.wasCancelled() ? tr("Import was cancelled; imported files were added") : tr("Import has finished"));
 
     ui->btnReject->setVisible(false);
     ui->btnAccept->setVisible(true);
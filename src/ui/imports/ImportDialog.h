@@ -3,7 +3,7 @@
 #include "concerts/Concert.h"
 #include "globals/DownloadManager.h"
 #include "globals/DownloadManagerElement.h"
-#include "imports/FileWorker.h"
+#include "imports/FileImporter.h"
 #include "movies/Movie.h"
 #include "renamer/RenamerDialog.h"
 #include "tv_shows/TvShow.h"
@@ -12,7 +12,6 @@
 #include <QCloseEvent>
 #include <QDialog>
 #include <QPointer>
-#include <QThread>
 #include <QTimer>
 
 namespace Ui {
@@ -66,8 +65,7 @@ private:
     bool m_separateFolders = false;
     QTimer m_timer;
     QMap<QString, QString> m_filesToMove;
-    QPointer<QThread> m_workerThread;
-    QPointer<FileWorker> m_worker;
+    mediaelch::FileImporter m_importer;
     QStringList m_newFiles;
     DownloadManager* m_posterDownloadManager = nullptr;
 
@@ -123,6 +123,11 @@ void FileScannerDialog::setForceReload(bool force)
     m_forceReload = force;
 }
 
+void FileScannerDialog::setIncrementalReload(bool incremental)
+{
+    m_incrementalReload = incremental;
+}
+
 void FileScannerDialog::setReloadType(ReloadType type)
 {
     m_reloadType = type;
@@ -160,6 +165,11 @@ void FileScannerDialog::reject()
 void FileScannerDialog::onStartMovieScanner()
 {
     ui->progressBar->setValue(0);
+    if (m_incrementalReload && !m_forceReload) {
+        // Differences are applied to the existing model.
+        QTimer::singleShot(0, this, &FileScannerDialog::onStartMovieScannerIncremental);
+        return;
+    }
     Manager::instance()->movieModel()->clear();
     QApplication::processEvents();
     if (m_forceReload) {
@@ -179,6 +189,11 @@ void FileScannerDialog::onStartMovieScannerForce()
     Manager::instance()->movieFileSearcher()->reload(true);
 }
 
+void FileScannerDialog::onStartMovieScannerIncremental()
+{
+    Manager::instance()->movieFileSearcher()->reloadIncremental();
+}
+
 /// Starts the TV show file searcher
 void FileScannerDialog::onStartTvShowScanner()
 {
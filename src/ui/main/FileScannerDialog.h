@@ -26,6 +26,8 @@ public:
     explicit FileScannerDialog(QWidget* parent = nullptr);
     ~FileScannerDialog() override;
     void setForceReload(bool force);
+    /// \brief Only rescan changed movie directories. Ignored if a forced reload is requested.
+    void setIncrementalReload(bool incremental);
     void setReloadType(ReloadType type);
     void setScanDir(const mediaelch::DirectoryPath& dir);
 
@@ -39,6 +41,7 @@ private slots:
     void onStartMovieScanner();
     void onStartMovieScannerForce();
     void onStartMovieScannerCache();
+    void onStartMovieScannerIncremental();
     void onStartTvShowScanner();
     void onStartTvShowScannerForce();
     void onStartTvShowScannerCache();
@@ -54,6 +57,7 @@ private:
     Ui::FileScannerDialog* ui;
 
     bool m_forceReload = false;
+    bool m_incrementalReload = false;
     ReloadType m_reloadType = ReloadType::All;
     mediaelch::DirectoryPath m_scanDir;
 };
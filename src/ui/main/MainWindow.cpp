@@ -480,7 +480,10 @@ void MainWindow::onActionReload()
     case MainWidgets::Downloads: return; // already handled; no reload
     }
 
-    m_fileScannerDialog->setForceReload(true);
+    const bool incremental =
+        (type == FileScannerDialog::ReloadType::Movies && Settings::instance()->advanced()->incrementalMovieScan());
+    m_fileScannerDialog->setForceReload(!incremental);
+    m_fileScannerDialog->setIncrementalReload(incremental);
     m_fileScannerDialog->setReloadType(type);
     m_fileScannerDialog->exec();
 }
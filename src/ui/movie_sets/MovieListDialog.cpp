@@ -36,7 +36,7 @@ int MovieListDialog::exec()
     ui->movies->clearContents();
     ui->movies->setRowCount(0);
     ui->movies->setSortingEnabled(false);
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         int row = ui->movies->rowCount();
         ui->movies->insertRow(row);
         QString title = (movie->released().isValid())
@@ -62,7 +62,7 @@ int MovieListDialog::execWithoutGenre(QString genre)
     ui->movies->clearContents();
     ui->movies->setRowCount(0);
     ui->movies->setSortingEnabled(false);
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->genres().contains(genre)) {
             continue;
         }
@@ -91,7 +91,7 @@ int MovieListDialog::execWithoutCertification(Certification certification)
     ui->movies->clearContents();
     ui->movies->setRowCount(0);
     ui->movies->setSortingEnabled(false);
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->certification() == certification) {
             continue;
         }
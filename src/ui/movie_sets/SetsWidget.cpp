@@ -42,6 +42,7 @@ SetsWidget::SetsWidget(QWidget* parent) : QWidget(parent), ui(new Ui::SetsWidget
     m_loadingMovie = new QMovie(":/img/spinner.gif", QByteArray(), this);
     m_loadingMovie->start();
     m_downloadManager = new DownloadManager(this);
+    m_downloadManager->setPriority(DownloadPriority::High);
 
     // clang-format off
     connect(ui->sets,                  &QTableWidget::itemSelectionChanged,   this, &SetsWidget::onSetSelected);
@@ -121,7 +122,7 @@ void SetsWidget::loadSets()
     m_moviesToSave.clear();
     m_setPosters.clear();
     m_setBackdrops.clear();
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (!movie->set().name.isEmpty()) {
             if (m_sets.contains(movie->set().name)) {
                 m_sets[movie->set().name].append(movie);
@@ -91,7 +91,7 @@ void CertificationWidget::loadCertifications()
     ui->certifications->blockSignals(true);
     clear();
     QStringList certifications;
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         QString certStr = movie->certification().toString();
         if (movie->certification().isValid() && !certifications.contains(certStr)) {
             certifications.append(certStr);
@@ -133,7 +133,7 @@ void CertificationWidget::onCertificationSelected()
     ui->movies->setSortingEnabled(false);
 
     Certification certification = Certification(ui->certifications->item(ui->certifications->currentRow(), 0)->text());
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->certification() == certification) {
             const int row = ui->movies->rowCount();
             auto* item = new QTableWidgetItem(movie->name());
@@ -159,7 +159,7 @@ void CertificationWidget::onCertificationNameChanged(QTableWidgetItem* item)
         return;
     }
 
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->certification() == origName) {
             movie->setCertification(newName);
         }
@@ -226,7 +226,7 @@ void CertificationWidget::deleteCertification()
         Certification(ui->certifications->item(ui->certifications->currentRow(), 0)->data(Qt::UserRole).toString());
     ui->certifications->removeRow(ui->certifications->currentRow());
 
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->certification() == certification) {
             movie->setCertification(Certification::NoCertification);
         }
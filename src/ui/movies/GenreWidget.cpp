@@ -88,7 +88,7 @@ void GenreWidget::loadGenres()
     ui->genres->blockSignals(true);
     clear();
     QStringList genres;
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         for (const QString& genre : movie->genres()) {
             if (!genre.isEmpty() && !genres.contains(genre)) {
                 genres.append(genre);
@@ -130,7 +130,7 @@ void GenreWidget::onGenreSelected()
     ui->movies->setSortingEnabled(false);
 
     QString genreName = ui->genres->item(ui->genres->currentRow(), 0)->text();
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->genres().contains(genreName)) {
             int row = ui->movies->rowCount();
             auto* item = new QTableWidgetItem(movie->name());
@@ -156,7 +156,7 @@ void GenreWidget::onGenreNameChanged(QTableWidgetItem* item)
         return;
     }
 
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->genres().contains(origName)) {
             movie->removeGenre(origName);
             if (!movie->genres().contains(newName)) {
@@ -223,7 +223,7 @@ void GenreWidget::deleteGenre()
     QString origGenreName = ui->genres->item(ui->genres->currentRow(), 0)->data(Qt::UserRole).toString();
     ui->genres->removeRow(ui->genres->currentRow());
 
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (movie->genres().contains(genreName)) {
             movie->removeGenre(genreName);
         }
@@ -5,6 +5,7 @@
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
 #include "movies/Movie.h"
+#include "movies/MovieDuplicateIndex.h"
 #include "movies/MovieProxyModel.h"
 #include "ui/movies/MovieDuplicateItem.h"
 #include "ui/notifications/NotificationBox.h"
@@ -17,6 +18,8 @@ MovieDuplicates::MovieDuplicates(QWidget* parent) : QWidget(parent), ui(new Ui::
 {
     ui->setupUi(this);
 
+    m_duplicateIndex = new mediaelch::MovieDuplicateIndex(this);
+
     if (!Settings::instance()->movieDuplicatesSplitterState().isNull()) {
         ui->splitter->restoreState(Settings::instance()->movieDuplicatesSplitterState());
     } else {
@@ -68,32 +71,15 @@ void MovieDuplicates::detectDuplicates()
 
     ui->duplicates->clear();
     ui->duplicates->setRowCount(0);
-    m_duplicateMovies.clear();
 
-    int counter = 0;
-    int movieCount = Manager::instance()->movieModel()->movies().count();
     NotificationBox::instance()->showProgressBar(
         tr("Detecting duplicate movies..."), Constants::MovieDuplicatesProgressMessageId);
-    NotificationBox::instance()->progressBarProgress(0, movieCount, Constants::MovieDuplicatesProgressMessageId);
-
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
-        ++counter;
-        QApplication::processEvents();
-
-        NotificationBox::instance()->progressBarProgress(
-            counter, movieCount, Constants::MovieDuplicatesProgressMessageId);
-        movie->setHasDuplicates(false);
-
-        QVector<Movie*> dups{movie};
-        for (Movie* subMovie : Manager::instance()->movieModel()->movies()) {
-            if (movie != subMovie && subMovie->isDuplicate(movie)) {
-                dups.append(subMovie);
-            }
-        }
-        if (dups.count() > 1) {
-            m_duplicateMovies.insert(movie, dups);
-            movie->setHasDuplicates(true);
-        }
+    QApplication::processEvents();
+
+    const QVector<Movie*> movies = Manager::instance()->movieModel()->moviesWithDetails();
+    m_duplicateIndex->setMovies(movies);
+    for (Movie* movie : movies) {
+        movie->setHasDuplicates(m_duplicateIndex->hasDuplicates(movie));
     }
 
     NotificationBox::instance()->hideProgressBar(Constants::MovieDuplicatesProgressMessageId);
@@ -106,14 +92,16 @@ void MovieDuplicates::onItemActivated(QModelIndex /*index*/, QModelIndex /*previ
         return;
     }
 
-    if (!m_duplicateMovies.contains(movie)) {
+    // The index is kept up to date if movies are edited, see MovieDuplicateIndex::updateMovie().
+    if (!m_duplicateIndex->hasDuplicates(movie)) {
         return;
     }
 
     ui->duplicates->clear();
     ui->duplicates->setRowCount(0);
 
-    for (Movie* dup : asConst(m_duplicateMovies[movie])) {
+    const QVector<Movie*> duplicates = QVector<Movie*>{movie} + m_duplicateIndex->duplicatesOf(movie);
+    for (Movie* dup : duplicates) {
         auto* item = new MovieDuplicateItem(ui->duplicates);
         item->setMovie(dup, dup == movie);
         item->setDuplicateProperties(movie->duplicateProperties(dup));
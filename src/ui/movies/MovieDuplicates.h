@@ -1,14 +1,16 @@
 #pragma once
 
-#include <QMap>
 #include <QModelIndex>
-#include <QVector>
 #include <QWidget>
 
 namespace Ui {
 class MovieDuplicates;
 }
 
+namespace mediaelch {
+class MovieDuplicateIndex;
+}
+
 class Movie;
 class MovieProxyModel;
 class QMenu;
@@ -41,6 +43,5 @@ private:
     Ui::MovieDuplicates* ui;
     MovieProxyModel* m_movieProxyModel;
     QMenu* m_contextMenu = nullptr;
-
-    QMap<Movie*, QVector<Movie*>> m_duplicateMovies;
+    mediaelch::MovieDuplicateIndex* m_duplicateIndex = nullptr;
 };
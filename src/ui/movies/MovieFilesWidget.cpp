@@ -204,6 +204,7 @@ void MovieFilesWidget::markAsWatched()
     for (const QModelIndex& index : ui->files->selectionModel()->selectedRows(0)) {
         const int row = index.model()->data(index, Qt::UserRole).toInt();
         Movie* movie = Manager::instance()->movieModel()->movie(row);
+        movie->controller()->loadDetails();
         if (movie->playcount() < 1) {
             movie->setPlayCount(1);
         }
@@ -223,6 +224,7 @@ void MovieFilesWidget::markAsUnwatched()
     for (const QModelIndex& index : ui->files->selectionModel()->selectedRows(0)) {
         const int row = index.model()->data(index, Qt::UserRole).toInt();
         Movie* movie = Manager::instance()->movieModel()->movie(row);
+        movie->controller()->loadDetails();
         movie->setPlayCount(0);
     }
     if (ui->files->selectionModel()->selectedRows(0).count() > 0) {
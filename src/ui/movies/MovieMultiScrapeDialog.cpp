@@ -2,9 +2,9 @@
 #include "ui_MovieMultiScrapeDialog.h"
 
 #include "globals/Manager.h"
-#include "scrapers/movie/custom/CustomMovieScraper.h"
-#include "scrapers/movie/imdb/ImdbMovie.h"
-#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "globals/Meta.h"
+#include "movies/MovieScrapeItem.h"
+#include "scrapers/movie/MovieScraper.h"
 #include "settings/Settings.h"
 #include "ui/small_widgets/MyCheckBox.h"
 
@@ -27,7 +27,6 @@ MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget* parent) : QDialog(parent
     ui->movieCounter->setFont(font);
 
     m_executed = false;
-    m_currentMovie = nullptr;
 
     ui->chkActors->setMyData(static_cast<int>(MovieScraperInfo::Actors));
     ui->chkBackdrop->setMyData(static_cast<int>(MovieScraperInfo::Backdrop));
@@ -77,7 +76,7 @@ MovieMultiScrapeDialog::~MovieMultiScrapeDialog()
 
 int MovieMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    deletePipeline();
     ui->movieCounter->setVisible(false);
     ui->comboScraper->setEnabled(true);
     ui->btnCancel->setVisible(true);
@@ -90,7 +89,6 @@ int MovieMultiScrapeDialog::exec()
     ui->progressMovie->setValue(0);
     ui->groupBox->setEnabled(true);
     ui->movie->clear();
-    m_currentMovie = nullptr;
     m_executed = true;
     setCheckBoxesEnabled(ui->comboScraper->currentIndex());
     adjustSize();
@@ -102,10 +100,6 @@ int MovieMultiScrapeDialog::exec()
 
 void MovieMultiScrapeDialog::accept()
 {
-    for (auto* scraper : Manager::instance()->scrapers().movieScrapers()) {
-        disconnect(
-            scraper, &mediaelch::scraper::MovieScraper::searchDone, this, &MovieMultiScrapeDialog::onSearchFinished);
-    }
     m_executed = false;
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
@@ -115,14 +109,9 @@ void MovieMultiScrapeDialog::accept()
 
 void MovieMultiScrapeDialog::reject()
 {
-    for (auto* scraper : Manager::instance()->scrapers().movieScrapers()) {
-        disconnect(
-            scraper, &mediaelch::scraper::MovieScraper::searchDone, this, &MovieMultiScrapeDialog::onSearchFinished);
-    }
     m_executed = false;
-    if (m_currentMovie != nullptr) {
-        m_queue.clear();
-        m_currentMovie->controller()->abortDownloads();
+    if (m_pipeline != nullptr) {
+        m_pipeline->abort();
     }
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
@@ -139,10 +128,6 @@ void MovieMultiScrapeDialog::onStartScraping()
 {
     using namespace mediaelch::scraper;
 
-    for (auto* scraper : Manager::instance()->scrapers().movieScrapers()) {
-        disconnect(scraper, &MovieScraper::searchDone, this, &MovieMultiScrapeDialog::onSearchFinished);
-    }
-
     ui->groupBox->setEnabled(false);
     ui->comboScraper->setEnabled(false);
     ui->btnStartScraping->setEnabled(false);
@@ -155,32 +140,39 @@ void MovieMultiScrapeDialog::onStartScraping()
         return;
     }
 
-    m_isTmdb = m_scraperInterface->meta().identifier == TmdbMovie::ID;
-    m_isImdb = m_scraperInterface->meta().identifier == ImdbMovie::ID;
-
-    connect(m_scraperInterface,
-        &MovieScraper::searchDone,
-        this,
-        &MovieMultiScrapeDialog::onSearchFinished,
-        Qt::UniqueConnection);
+    mediaelch::MovieScrapeItem::Config config;
+    config.scraper = m_scraperInterface;
+    config.details = m_infosToLoad;
+    config.onlyWithId = ui->chkOnlyImdb->isChecked();
+    config.saveToDisk = ui->chkAutoSave->isChecked();
+
+    deletePipeline();
+    m_pipeline = new ScrapePipeline(this);
+    m_pipeline->setConcurrency(Settings::instance()->advanced()->multiScrapeConcurrency());
+    for (Movie* movie : asConst(m_movies)) {
+        m_pipeline->addItem(new mediaelch::MovieScrapeItem(movie, config));
+    }
 
-    m_queue.append(m_movies.toList());
+    connect(m_pipeline, &ScrapePipeline::sigItemStarted, this, &MovieMultiScrapeDialog::onItemStarted);
+    connect(m_pipeline, &ScrapePipeline::sigItemProgress, this, &MovieMultiScrapeDialog::onItemProgress);
+    connect(m_pipeline, &ScrapePipeline::sigProgress, this, &MovieMultiScrapeDialog::onProgress);
+    connect(m_pipeline, &ScrapePipeline::sigFinished, this, &MovieMultiScrapeDialog::onScrapingFinished);
 
-    ui->movieCounter->setText(QString("0/%1").arg(m_queue.count()));
+    ui->movieCounter->setText(QString("0/%1").arg(m_movies.count()));
     ui->movieCounter->setVisible(true);
     ui->progressAll->setMaximum(m_movies.count());
-    scrapeNext();
+    m_pipeline->start();
 }
 
 void MovieMultiScrapeDialog::onScrapingFinished()
 {
+    using mediaelch::scraper::ScrapePipelineItem;
+
     ui->movieCounter->setVisible(false);
-    int numberOfMovies = m_movies.count();
-    if (ui->chkOnlyImdb->isChecked()) {
-        numberOfMovies = 0;
-        for (Movie* movie : m_movies) {
-            if ((m_isImdb && movie->imdbId().isValid())
-                || (m_isTmdb && (movie->imdbId().isValid() || movie->tmdbId().isValid()))) {
+    int numberOfMovies = 0;
+    if (m_pipeline != nullptr) {
+        for (const ScrapePipelineItem* item : m_pipeline->items()) {
+            if (item->stage() != ScrapePipelineItem::Stage::Skipped) {
                 numberOfMovies++;
             }
         }
@@ -192,140 +184,43 @@ void MovieMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
-void MovieMultiScrapeDialog::scrapeNext()
+void MovieMultiScrapeDialog::onItemStarted(mediaelch::scraper::ScrapePipelineItem* item)
 {
-    using namespace mediaelch::scraper;
-
     if (!isExecuted()) {
         return;
     }
-
-    if ((m_currentMovie != nullptr) && ui->chkAutoSave->isChecked()) {
-        m_currentMovie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-    }
-
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
-
-    m_currentMovie = m_queue.dequeue();
-
-    ui->movie->setText(m_currentMovie->name().trimmed());
-    ui->movieCounter->setText(QString("%1/%2").arg(m_movies.count() - m_queue.count()).arg(m_movies.count()));
-
-    ui->progressAll->setValue(ui->progressAll->maximum() - m_queue.size() - 1);
+    // Several movies are scraped concurrently; show the one that was started last.
+    ui->movie->setText(item->title());
     ui->progressMovie->setValue(0);
-
-    if (ui->chkOnlyImdb->isChecked()
-        && ((!m_currentMovie->imdbId().isValid() && m_isImdb)
-            || (!m_currentMovie->tmdbId().isValid() && !m_currentMovie->imdbId().isValid() && m_isTmdb)
-            || (!m_currentMovie->imdbId().isValid() && !m_currentMovie->tmdbId().isValid()
-                && m_scraperInterface->meta().identifier == CustomMovieScraper::ID))) {
-        scrapeNext();
-        return;
-    }
-
-    connect(m_currentMovie->controller(),
-        &MovieController::sigLoadDone,
-        this,
-        &MovieMultiScrapeDialog::scrapeNext,
-        Qt::UniqueConnection);
-    connect(m_currentMovie->controller(),
-        &MovieController::sigDownloadProgress,
-        this,
-        &MovieMultiScrapeDialog::onProgress,
-        Qt::UniqueConnection);
-
-    m_currentIds.clear();
-
-    if (m_isImdb && m_currentMovie->imdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
-    } else if (m_isTmdb && m_currentMovie->tmdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->tmdbId());
-    } else if (m_isTmdb && m_currentMovie->imdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
-    } else if (m_scraperInterface->meta().identifier == CustomMovieScraper::ID) {
-        if ((CustomMovieScraper::instance()->titleScraper()->meta().identifier == ImdbMovie::ID
-                || CustomMovieScraper::instance()->titleScraper()->meta().identifier == TmdbMovie::ID)
-            && m_currentMovie->imdbId().isValid()) {
-            m_scraperInterface->search(m_currentMovie->imdbId().toString());
-        } else if (CustomMovieScraper::instance()->titleScraper()->meta().identifier == TmdbMovie::ID
-                   && m_currentMovie->tmdbId().isValid()) {
-            m_scraperInterface->search(m_currentMovie->tmdbId().withPrefix());
-        } else {
-            m_scraperInterface->search(m_currentMovie->name());
-        }
-    } else {
-        m_scraperInterface->search(m_currentMovie->name());
-    }
 }
 
-void MovieMultiScrapeDialog::loadMovieData(Movie* movie, ImdbId id)
+void MovieMultiScrapeDialog::onItemProgress(mediaelch::scraper::ScrapePipelineItem* item, int done, int total)
 {
-    QHash<mediaelch::scraper::MovieScraper*, QString> ids;
-    ids.insert(nullptr, id.toString());
-    movie->controller()->loadData(ids, m_scraperInterface, m_infosToLoad);
-}
+    Q_UNUSED(item);
 
-void MovieMultiScrapeDialog::loadMovieData(Movie* movie, TmdbId id)
-{
-    QHash<mediaelch::scraper::MovieScraper*, QString> ids;
-    ids.insert(nullptr, id.toString());
-    movie->controller()->loadData(ids, m_scraperInterface, m_infosToLoad);
+    if (!isExecuted()) {
+        return;
+    }
+    ui->progressMovie->setMaximum(total);
+    ui->progressMovie->setValue(done);
 }
 
-void MovieMultiScrapeDialog::onSearchFinished(QVector<ScraperSearchResult> results)
+void MovieMultiScrapeDialog::onProgress(int finished, int total)
 {
-    using namespace mediaelch::scraper;
-
     if (!isExecuted()) {
         return;
     }
-    if (results.isEmpty()) {
-        scrapeNext();
-        return;
-    }
-
-    if (m_scraperInterface->meta().identifier == CustomMovieScraper::ID) {
-        auto* scraper = dynamic_cast<MovieScraper*>(QObject::sender());
-        m_currentIds.insert(scraper, results.first().id);
-        QVector<MovieScraper*> searchScrapers =
-            CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, m_currentIds);
-        if (!searchScrapers.isEmpty()) {
-            connect(searchScrapers.first(),
-                &MovieScraper::searchDone,
-                this,
-                &MovieMultiScrapeDialog::onSearchFinished,
-                Qt::UniqueConnection);
-            if ((searchScrapers.first()->meta().identifier == TmdbMovie::ID
-                    || searchScrapers.first()->meta().identifier == ImdbMovie::ID)
-                && m_currentMovie->imdbId().isValid()) {
-                searchScrapers.first()->search(m_currentMovie->imdbId().toString());
-            } else if (searchScrapers.first()->meta().identifier == TmdbMovie::ID
-                       && m_currentMovie->tmdbId().isValid()) {
-                searchScrapers.first()->search(m_currentMovie->tmdbId().toString());
-            } else {
-                searchScrapers.first()->search(m_currentMovie->name());
-            }
-            return;
-        }
-    } else {
-        m_currentIds.insert(m_scraperInterface, results.first().id);
-    }
-
-    m_currentMovie->controller()->loadData(m_currentIds, m_scraperInterface, m_infosToLoad);
+    ui->movieCounter->setText(QString("%1/%2").arg(finished).arg(total));
+    ui->progressAll->setValue(finished);
 }
 
-void MovieMultiScrapeDialog::onProgress(Movie* movie, int current, int maximum)
+void MovieMultiScrapeDialog::deletePipeline()
 {
-    Q_UNUSED(movie);
-
-    if (!isExecuted()) {
-        return;
+    if (m_pipeline != nullptr) {
+        m_pipeline->abort();
+        m_pipeline->deleteLater();
+        m_pipeline = nullptr;
     }
-    ui->progressMovie->setValue(maximum - current);
-    ui->progressMovie->setMaximum(maximum);
 }
 
 bool MovieMultiScrapeDialog::isExecuted() const
@@ -1,11 +1,9 @@
 #pragma once
 
-#include "globals/ScraperResult.h"
 #include "movies/Movie.h"
+#include "scrapers/ScrapePipeline.h"
 
 #include <QDialog>
-#include <QPointer>
-#include <QQueue>
 
 namespace Ui {
 class MovieMultiScrapeDialog;
@@ -29,9 +27,9 @@ public slots:
 private slots:
     void onStartScraping();
     void onScrapingFinished();
-    void onSearchFinished(QVector<ScraperSearchResult> results);
-    void scrapeNext();
-    void onProgress(Movie* movie, int current, int maximum);
+    void onItemStarted(mediaelch::scraper::ScrapePipelineItem* item);
+    void onItemProgress(mediaelch::scraper::ScrapePipelineItem* item, int done, int total);
+    void onProgress(int finished, int total);
     void onChkToggled();
     void onChkAllToggled();
     void setCheckBoxesEnabled(int index);
@@ -39,15 +37,10 @@ private slots:
 private:
     Ui::MovieMultiScrapeDialog* ui = nullptr;
     QVector<Movie*> m_movies;
-    QQueue<Movie*> m_queue;
-    QPointer<Movie> m_currentMovie;
     mediaelch::scraper::MovieScraper* m_scraperInterface = nullptr;
-    QHash<mediaelch::scraper::MovieScraper*, QString> m_currentIds;
-    bool m_isImdb = false;
-    bool m_isTmdb = false;
+    mediaelch::scraper::ScrapePipeline* m_pipeline = nullptr;
     bool m_executed = false;
     QSet<MovieScraperInfo> m_infosToLoad;
-    void loadMovieData(Movie* movie, ImdbId id);
-    void loadMovieData(Movie* movie, TmdbId id);
+    void deletePipeline();
     bool isExecuted() const;
 };
@@ -377,6 +377,11 @@ void MovieWidget::setMovie(Movie* movie)
 {
     using namespace std::chrono;
     qDebug() << "Entered, movie=" << movie->name();
+    if (m_movie != nullptr && m_movie != movie) {
+        m_movie->controller()->setDownloadPriority(DownloadPriority::Normal);
+    }
+    // Images of the selected movie are downloaded before images of other movies.
+    movie->controller()->setDownloadPriority(DownloadPriority::High);
     movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
     if (!movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         movie->controller()->loadStreamDetailsFromFile();
@@ -611,7 +616,7 @@ void MovieWidget::updateMovieInfo()
     QStringList sets;
     sets.append("");
     certifications.append("");
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         if (!sets.contains(movie->set().name) && !movie->set().name.isEmpty()) {
             sets.append(movie->set().name);
         }
@@ -668,7 +673,7 @@ void MovieWidget::updateMovieInfo()
     QStringList tags;
     QStringList countries;
     QStringList studios;
-    for (const Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (const Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         genres << movie->genres();
         tags << movie->tags();
         countries << movie->countries();
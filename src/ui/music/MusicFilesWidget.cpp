@@ -119,12 +119,12 @@ MusicFilesWidget* MusicFilesWidget::instance()
 
 void MusicFilesWidget::setFilter(QVector<Filter*> filters, QString text)
 {
+    m_proxyModel->setFilter(filters, text);
     if (!filters.isEmpty()) {
         m_proxyModel->setFilterWildcard("*" + filters.first()->shortText() + "*");
     } else {
         m_proxyModel->setFilterWildcard("*" + text + "*");
     }
-    m_proxyModel->setFilter(filters, text);
 }
 
 void MusicFilesWidget::onItemSelected(QModelIndex index)
@@ -311,7 +311,7 @@ QVector<Filter*> FilterWidget::setupMovieFilters()
         }
     };
 
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+    for (Movie* movie : Manager::instance()->movieModel()->moviesWithDetails()) {
         copyNotEmptyUnique(movie->genres(), genres);
         copyNotEmptyUnique(movie->studios(), studios);
         copyNotEmptyUnique(movie->countries(), countries);
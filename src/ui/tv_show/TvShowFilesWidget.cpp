@@ -160,6 +160,7 @@ void TvShowFilesWidget::scanForEpisodes()
 void TvShowFilesWidget::markAsWatched()
 {
     m_contextMenu->close();
+    TvShowEpisode::loadDetails(selectedEpisodes());
 
     forEachSelectedItem([&](TvShowBaseModelItem& item) {
         switch (item.type()) {
@@ -220,6 +221,7 @@ void TvShowFilesWidget::markAsWatched()
 void TvShowFilesWidget::markAsUnwatched()
 {
     m_contextMenu->close();
+    TvShowEpisode::loadDetails(selectedEpisodes());
 
     forEachSelectedItem([&](TvShowBaseModelItem& item) {
         switch (item.type()) {
@@ -485,8 +487,8 @@ void TvShowFilesWidget::hideSpecialsInMissingEpisodes()
 void TvShowFilesWidget::setFilter(const QVector<Filter*>& filters, QString text)
 {
     QString filterText = filters.isEmpty() ? text : filters.first()->shortText();
-    m_tvShowProxyModel->setFilterWildcard("*" + filterText + "*");
     m_tvShowProxyModel->setFilter(filters, text);
+    m_tvShowProxyModel->setFilterWildcard("*" + filterText + "*");
 }
 
 /// \brief Renews the model (necessary after searching for TV shows)
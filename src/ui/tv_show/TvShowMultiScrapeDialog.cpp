@@ -1,15 +1,10 @@
 #include "TvShowMultiScrapeDialog.h"
 #include "ui_TvShowMultiScrapeDialog.h"
 
-#include "data/ImageCache.h"
-#include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "globals/Meta.h"
 #include "scrapers/tv_show/TvScraper.h"
-#include "scrapers/tv_show/custom/CustomTvScraper.h"
-#include "scrapers/tv_show/imdb/ImdbTv.h"
-#include "scrapers/tv_show/thetvdb/TheTvDb.h"
-#include "scrapers/tv_show/tmdb/TmdbTv.h"
-#include "scrapers/tv_show/tvmaze/TvMaze.h"
+#include "tv_shows/TvShowScrapeItem.h"
 #include "ui/tv_show/TvShowCommonWidgets.h"
 
 #include <QDebug>
@@ -17,57 +12,13 @@
 
 using namespace mediaelch;
 
-/// \brief Get the appropriate ID for the given scraper. Used for the "with ID only" feature.
-static scraper::ShowIdentifier getShowIdentifierForScraper(const scraper::TvScraper& scraper, const TvShow& show)
-{
-    using namespace mediaelch::scraper;
-    const QString& scraperId = scraper.meta().identifier;
-
-    if (scraperId == TheTvDb::ID) {
-        return ShowIdentifier(show.tvdbId());
-    }
-    if (scraperId == ImdbTv::ID) {
-        return ShowIdentifier(show.imdbId());
-    }
-    if (scraperId == TvMaze::ID) {
-        return ShowIdentifier(show.tvmazeId());
-    }
-    if (scraperId == TmdbTv::ID || scraperId == CustomTvScraper::ID) {
-        // The CustomTvScraper depends on TMDb
-        return ShowIdentifier(show.tmdbId());
-    }
-    return ShowIdentifier();
-}
-
-static bool hasValidIdForScraper(const scraper::TvScraper& scraper, const TvShow& show)
-{
-    using namespace mediaelch::scraper;
-    const QString& scraperId = scraper.meta().identifier;
-
-    if (scraperId == TheTvDb::ID) {
-        return show.tvdbId().isValid();
-    }
-    if (scraperId == ImdbTv::ID) {
-        return show.imdbId().isValid();
-    }
-    if (scraperId == TvMaze::ID) {
-        return show.tvmazeId().isValid();
-    }
-    if (scraperId == TmdbTv::ID || scraperId == CustomTvScraper::ID) {
-        // The CustomTvScraper depends on TMDb
-        return show.tmdbId().isValid();
-    }
-    return false;
-}
-
 TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
     QVector<TvShowEpisode*> episodes,
     QWidget* parent) :
     QDialog(parent),
     ui(new Ui::TvShowMultiScrapeDialog),
     m_shows{std::move(shows)},
-    m_episodes{std::move(episodes)},
-    m_downloadManager{new DownloadManager(this)}
+    m_episodes{std::move(episodes)}
 {
     ui->setupUi(this);
 
@@ -85,9 +36,6 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
 #endif
     ui->itemCounter->setFont(font);
 
-    m_showQueue.append(m_shows.toList());
-    m_episodeQueue.append(m_episodes.toList());
-
     ui->chkActors->setMyData(static_cast<int>(ShowScraperInfo::Actors));
     ui->chkBanner->setMyData(static_cast<int>(ShowScraperInfo::Banner));
     ui->chkCertification->setMyData(static_cast<int>(ShowScraperInfo::Certification));
@@ -142,10 +90,6 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
     connect(ui->comboScraper,     indexChanged, this, &TvShowMultiScrapeDialog::onScraperChanged);
     connect(ui->comboSeasonOrder, indexChanged, this, &TvShowMultiScrapeDialog::onSeasonOrderChanged);
     connect(ui->comboLanguage,    &LanguageCombo::languageChanged, this, &TvShowMultiScrapeDialog::onLanguageChanged);
-
-    auto queuedUnique = static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection);
-    connect(m_downloadManager, &DownloadManager::sigElemDownloaded,    this, &TvShowMultiScrapeDialog::onDownloadFinished, queuedUnique);
-    connect(m_downloadManager, &DownloadManager::allDownloadsFinished, this, &TvShowMultiScrapeDialog::scrapeNext,         queuedUnique);
     // clang-format on
 }
 
@@ -179,9 +123,6 @@ int TvShowMultiScrapeDialog::exec()
     ui->episodeInfosGroupBox->setEnabled(true);
     ui->title->clear();
 
-    m_currentEpisode = nullptr;
-    m_currentShow = nullptr;
-
     adjustSize();
 
     ui->chkAutoSave->setChecked(Settings::instance()->multiScrapeSaveEach());
@@ -209,7 +150,9 @@ void TvShowMultiScrapeDialog::accept()
 
 void TvShowMultiScrapeDialog::reject()
 {
-    m_downloadManager->abortDownloads();
+    if (m_pipeline != nullptr) {
+        m_pipeline->abort();
+    }
 
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyId->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
@@ -289,6 +232,8 @@ void TvShowMultiScrapeDialog::onChkAllEpisodeInfosToggled()
 
 void TvShowMultiScrapeDialog::onStartScraping()
 {
+    using namespace mediaelch::scraper;
+
     ui->showInfosGroupBox->setEnabled(false);
     ui->episodeInfosGroupBox->setEnabled(false);
     ui->btnStartScraping->setEnabled(false);
@@ -299,147 +244,43 @@ void TvShowMultiScrapeDialog::onStartScraping()
     ui->comboScraper->setEnabled(false);
     ui->txtScraperLog->clear();
 
-    ui->itemCounter->setText(QStringLiteral("0/%1").arg(m_showQueue.count() + m_episodeQueue.count()));
-    ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(m_showQueue.count() + m_episodeQueue.count());
-
-    logToUser(tr("Start scraping using \"%1\"").arg(m_currentScraper->meta().name));
-
-    scrapeNext();
-}
-
-void TvShowMultiScrapeDialog::scrapeNext()
-{
-    qDebug() << "[TvShowMultiScrapeDialog] Scrape next item";
-    using namespace mediaelch::scraper;
-
-    saveCurrentItem();
-
-    if (m_showQueue.isEmpty() && m_episodeQueue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
-
-    m_currentShow = nullptr;
-    m_currentEpisode = nullptr;
-
-    if (!m_showQueue.isEmpty()) {
-        m_currentShow = m_showQueue.dequeue();
-        ui->title->setText(m_currentShow->title().trimmed());
-
-    } else if (!m_episodeQueue.isEmpty()) {
-        m_currentEpisode = m_episodeQueue.dequeue();
-        ui->title->setText(m_currentEpisode->title().trimmed());
-    }
+    TvScrapeConfig config;
+    config.scraper = m_currentScraper;
+    config.locale = m_locale;
+    config.seasonOrder = m_seasonOrder;
+    config.showDetails = m_showDetailsToLoad;
+    config.episodeDetails = m_episodeDetailsToLoad;
+    config.onlyWithId = ui->chkOnlyId->isChecked();
+    config.saveToDisk = ui->chkAutoSave->isChecked();
+
+    // Shows are queued first so that episodes can reuse their search results.
+    m_pipeline = new ScrapePipeline(this);
+    m_pipeline->setConcurrency(Settings::instance()->advanced()->multiScrapeConcurrency());
+    for (TvShow* show : asConst(m_shows)) {
+        m_pipeline->addItem(new TvShowScrapeItem(show, config));
+    }
+    for (TvShowEpisode* episode : asConst(m_episodes)) {
+        m_pipeline->addItem(new TvShowEpisodeScrapeItem(episode, config));
+    }
+
+    connect(m_pipeline, &ScrapePipeline::sigItemStarted, this, &TvShowMultiScrapeDialog::onItemStarted);
+    connect(m_pipeline, &ScrapePipeline::sigItemProgress, this, &TvShowMultiScrapeDialog::onItemProgress);
+    connect(m_pipeline, &ScrapePipeline::sigItemFinished, this, &TvShowMultiScrapeDialog::onItemFinished);
+    connect(m_pipeline, &ScrapePipeline::sigItemMessage, this, [this](ScrapePipelineItem* item, QString message) {
+        Q_UNUSED(item);
+        logToUser(message);
+    });
+    connect(m_pipeline, &ScrapePipeline::sigProgress, this, &TvShowMultiScrapeDialog::onProgress);
+    connect(m_pipeline, &ScrapePipeline::sigFinished, this, &TvShowMultiScrapeDialog::onScrapingFinished);
 
     const int sum = m_shows.count() + m_episodes.count();
-    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(sum - m_showQueue.count() - m_episodeQueue.count()).arg(sum));
-
-    ui->progressAll->setValue(ui->progressAll->maximum() - m_showQueue.size() - m_episodeQueue.count() - 1);
-    ui->progressItem->setValue(0);
-
-    // Check if the show/episode has an ID that suits the current scraper.
-    // If not and the "only with ID" checkbox is enabled, skip this show/episode.
-    if (ui->chkOnlyId->isChecked()) {
-        const TvShow* show = m_currentShow;
-        if (show == nullptr && m_currentEpisode != nullptr) {
-            show = m_currentEpisode->tvShow();
-        }
-        if (show != nullptr) {
-            const auto id = getShowIdentifierForScraper(*m_currentScraper, *show);
-            if (id.str().isEmpty()) {
-                logToUser(tr("Skipping show \"%1\" because it does not have a valid ID."));
-                scrapeNext();
-                return;
-            }
-        }
-    }
-
-    if (m_currentShow != nullptr) {
-        const auto id = getShowIdentifierForScraper(*m_currentScraper, *m_currentShow);
-
-        // no useful id: search first
-        if (id.str().isEmpty()) {
-            // Most scrapers do not support a year, so we remove it.
-            // Because the title may still be the filename / folder name, we also replace
-            // the dot with space.
-            // TODO: Use some common utility function for sanitization.
-            QString searchQuery = m_currentShow->title().replace(".", " ").trimmed();
-            searchQuery = ShowSearchJob::extractTitleAndYear(searchQuery).first;
-
-            logToUser(tr("Search for TV show \"%1\" because no valid ID was found.").arg(searchQuery));
-            ShowSearchJob::Config config{searchQuery, m_locale, Settings::instance()->showAdultScrapers()};
-            auto* searchJob = m_currentScraper->search(config);
-            connect(searchJob, &ShowSearchJob::sigFinished, this, &TvShowMultiScrapeDialog::onSearchFinished);
-            searchJob->execute();
-
-        } else {
-            logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
-            connect(m_currentShow.data(),
-                &TvShow::sigLoaded,
-                this,
-                &TvShowMultiScrapeDialog::onInfoLoadDone,
-                Qt::UniqueConnection);
-            m_currentShow->scrapeData(m_currentScraper,
-                id,
-                m_locale,
-                m_seasonOrder,
-                TvShowUpdateType::Show,
-                m_showDetailsToLoad,
-                m_episodeDetailsToLoad);
-        }
-
-    } else if (m_currentEpisode != nullptr) {
-        connect(m_currentEpisode.data(),
-            &TvShowEpisode::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onEpisodeLoadDone,
-            Qt::UniqueConnection);
-
-        const QString title = m_currentEpisode->tvShow()->title();
-        auto id = getShowIdentifierForScraper(*m_currentScraper, *m_currentEpisode->tvShow());
-
-        if (id.str().isEmpty() && m_showIds.contains(title)) {
-            id = m_showIds.value(title);
-        }
-
-        if (id.str().isEmpty()) {
-            logToUser(tr("Search for TV show \"%1\" because no valid show ID was found for the episode.")
-                          .arg(m_currentEpisode->tvShow()->title()));
-            ShowSearchJob::Config config{
-                m_currentEpisode->tvShow()->title(), m_locale, Settings::instance()->showAdultScrapers()};
-            auto* searchJob = m_currentScraper->search(config);
-            connect(searchJob, &ShowSearchJob::sigFinished, this, &TvShowMultiScrapeDialog::onSearchFinished);
-            searchJob->execute();
-
-        } else {
-            logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
-                          .arg(m_currentEpisode->seasonNumber().toPaddedString(),
-                              m_currentEpisode->episodeNumber().toPaddedString(),
-                              id.str()));
-            m_currentEpisode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
-        }
-
-    } else {
-        qCritical() << "[TvShowMultiScrapeDialog] Cannot scrape next! No further items to process but initial check "
-                       "did not notice it!";
-        onScrapingFinished();
-    }
-}
-
-void TvShowMultiScrapeDialog::saveCurrentItem()
-{
-    if (!ui->chkAutoSave->isChecked()) {
-        return;
-    }
+    ui->itemCounter->setText(QStringLiteral("0/%1").arg(sum));
+    ui->itemCounter->setVisible(true);
+    ui->progressAll->setMaximum(sum);
 
-    if (m_currentShow != nullptr) {
-        m_currentShow->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-    }
+    logToUser(tr("Start scraping using \"%1\"").arg(m_currentScraper->meta().name));
 
-    if (m_currentEpisode != nullptr) {
-        m_currentEpisode->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-    }
+    m_pipeline->start();
 }
 
 TvShowUpdateType TvShowMultiScrapeDialog::updateType() const
@@ -453,76 +294,50 @@ void TvShowMultiScrapeDialog::logToUser(const QString& msg)
     ui->txtScraperLog->appendPlainText(msg);
 }
 
-void TvShowMultiScrapeDialog::onSearchFinished(scraper::ShowSearchJob* searchJob)
+void TvShowMultiScrapeDialog::onItemStarted(scraper::ScrapePipelineItem* item)
 {
-    searchJob->deleteLater();
+    // Several items are scraped concurrently; show the one that was started last.
+    ui->title->setText(item->title());
+    ui->progressItem->setValue(0);
+}
 
-    if (searchJob->hasError()) {
-        logToUser(tr("Error while searching for TV show: \"%1\"").arg(searchJob->error().message));
-        scrapeNext();
-        return;
-    }
-    if (searchJob->results().isEmpty()) {
-        logToUser(tr("Did not find any results for search term \"%1\".").arg(searchJob->config().query));
-        scrapeNext();
-        return;
-    }
+void TvShowMultiScrapeDialog::onItemProgress(scraper::ScrapePipelineItem* item, int done, int total)
+{
+    Q_UNUSED(item);
+    ui->progressItem->setMaximum(total);
+    ui->progressItem->setValue(done);
+}
 
-    const auto id = searchJob->results().first().identifier;
-    if (m_currentShow != nullptr) {
-        logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
-        m_showIds.insert(m_currentShow->title(), id);
-
-        // TODO: deduplicate code with scrapeNext()
-        connect(m_currentShow.data(),
-            &TvShow::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onInfoLoadDone,
-            Qt::UniqueConnection);
-        m_currentShow->scrapeData(m_currentScraper,
-            id,
-            m_locale,
-            m_seasonOrder,
-            TvShowUpdateType::Show,
-            m_showDetailsToLoad,
-            m_episodeDetailsToLoad);
-
-    } else if (m_currentEpisode != nullptr) {
-        logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
-                      .arg(m_currentEpisode->seasonNumber().toPaddedString(),
-                          m_currentEpisode->episodeNumber().toPaddedString(),
-                          id.str()));
-        m_showIds.insert(m_currentEpisode->tvShow()->title(), id);
-
-        // TODO: deduplicate code with scrapeNext()
-        connect(m_currentEpisode.data(),
-            &TvShowEpisode::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onEpisodeLoadDone,
-            Qt::UniqueConnection);
-        m_currentEpisode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
+void TvShowMultiScrapeDialog::onItemFinished(scraper::ScrapePipelineItem* item)
+{
+    if (!item->message().isEmpty()) {
+        logToUser(item->message());
     }
 }
 
+void TvShowMultiScrapeDialog::onProgress(int finished, int total)
+{
+    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(finished).arg(total));
+    ui->progressAll->setValue(finished);
+}
+
 void TvShowMultiScrapeDialog::onScrapingFinished()
 {
+    using scraper::ScrapePipelineItem;
+
     logToUser(tr("Done."));
 
     ui->itemCounter->setVisible(false);
-    int numberOfShows = m_shows.count();
-    int numberOfEpisodes = m_episodes.count();
-    if (ui->chkOnlyId->isChecked()) {
-        numberOfShows = 0;
-        numberOfEpisodes = 0;
-        for (TvShow* show : m_shows) {
-            if (hasValidIdForScraper(*m_currentScraper, *show)) {
-                numberOfShows++;
-            }
+    int numberOfShows = 0;
+    int numberOfEpisodes = 0;
+    for (const ScrapePipelineItem* item : m_pipeline->items()) {
+        if (item->stage() == ScrapePipelineItem::Stage::Skipped) {
+            continue;
         }
-        for (TvShowEpisode* episode : m_episodes) {
-            if (episode->tvShow() != nullptr && hasValidIdForScraper(*m_currentScraper, *episode->tvShow())) {
-                numberOfEpisodes++;
-            }
+        if (qobject_cast<const TvShowScrapeItem*>(item) != nullptr) {
+            numberOfShows++;
+        } else {
+            numberOfEpisodes++;
         }
     }
 
@@ -537,198 +352,12 @@ void TvShowMultiScrapeDialog::onScrapingFinished()
     }
 
     ui->progressAll->setValue(ui->progressAll->maximum());
+    ui->progressItem->setValue(ui->progressItem->maximum());
     ui->btnCancel->setVisible(false);
     ui->btnClose->setVisible(true);
     ui->btnStartScraping->setVisible(false);
 }
 
-void TvShowMultiScrapeDialog::onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details)
-{
-    Q_UNUSED(details);
-
-    if (show != m_currentShow) {
-        qCritical() << "[TvShowMultiScrapeDialog] TV show has changed mid-scrape-process!";
-        return;
-    }
-
-    if (show->showMissingEpisodes()) {
-        show->clearMissingEpisodes();
-        show->fillMissingEpisodes();
-    }
-
-    logToUser(tr("Finished scraping details of TV show \"%1\".").arg(show->title()));
-
-    QVector<ImageType> types = {ImageType::TvShowClearArt,
-        ImageType::TvShowLogos,
-        ImageType::TvShowCharacterArt,
-        ImageType::TvShowThumb,
-        ImageType::TvShowSeasonThumb};
-
-    if (show->tvdbId().isValid() && details.contains(ShowScraperInfo::ExtraArts)) {
-        logToUser(tr("Start loading extra fanart from TheTvDb for TV show with ID \"%1\".") //
-                      .arg(show->tvdbId().toString()));
-        connect(Manager::instance()->fanartTv(),
-            &mediaelch::scraper::ImageProvider::sigTvShowImagesLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onLoadDone,
-            Qt::UniqueConnection);
-        Manager::instance()->fanartTv()->tvShowImages(show, show->tvdbId(), types, m_locale);
-
-    } else {
-        onLoadDone(show, {});
-    }
-}
-
-void TvShowMultiScrapeDialog::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster>> posters)
-{
-    if (show != m_currentShow) {
-        qCritical() << "[TvShowMultiScrapeDialog] TV show has changed mid-scrape-process!";
-        return;
-    }
-
-    int downloadsSize = 0;
-    if (!show->posters().isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::Poster)) {
-        addDownload(ImageType::TvShowPoster, show->posters().at(0).originalUrl, show);
-        downloadsSize++;
-    }
-
-    if (!show->backdrops().isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::Fanart)) {
-        addDownload(ImageType::TvShowBackdrop, show->backdrops().at(0).originalUrl, show);
-        downloadsSize++;
-    }
-
-    if (!show->banners().isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::Banner)) {
-        addDownload(ImageType::TvShowBanner, show->banners().at(0).originalUrl, show);
-        downloadsSize++;
-    }
-
-    QVector<SeasonNumber> thumbsForSeasons;
-    QMapIterator<ImageType, QVector<Poster>> it(posters);
-    while (it.hasNext()) {
-        it.next();
-        if (m_showDetailsToLoad.contains(ShowScraperInfo::ExtraArts) && it.key() == ImageType::TvShowClearArt
-            && !it.value().isEmpty()) {
-            addDownload(ImageType::TvShowClearArt, it.value().at(0).originalUrl, show);
-            downloadsSize++;
-        } else if (m_showDetailsToLoad.contains(ShowScraperInfo::ExtraArts) && it.key() == ImageType::TvShowCharacterArt
-                   && !it.value().isEmpty()) {
-            addDownload(ImageType::TvShowCharacterArt, it.value().at(0).originalUrl, show);
-            downloadsSize++;
-        } else if (m_showDetailsToLoad.contains(ShowScraperInfo::ExtraArts) && it.key() == ImageType::TvShowLogos
-                   && !it.value().isEmpty()) {
-            addDownload(ImageType::TvShowLogos, it.value().at(0).originalUrl, show);
-            downloadsSize++;
-        } else if (m_showDetailsToLoad.contains(ShowScraperInfo::ExtraArts) && it.key() == ImageType::TvShowThumb
-                   && !it.value().isEmpty()) {
-            addDownload(ImageType::TvShowThumb, it.value().at(0).originalUrl, show);
-            downloadsSize++;
-        } else if (m_showDetailsToLoad.contains(ShowScraperInfo::SeasonThumb)
-                   && it.key() == ImageType::TvShowSeasonThumb && !it.value().isEmpty()) {
-            for (const Poster& p : it.value()) {
-                if (thumbsForSeasons.contains(p.season)) {
-                    continue;
-                }
-                if (!show->seasons().contains(p.season)) {
-                    continue;
-                }
-
-                addDownload(ImageType::TvShowSeasonThumb, p.originalUrl, show, p.season);
-                downloadsSize++;
-                thumbsForSeasons.append(p.season);
-            }
-        }
-    }
-
-    if (m_showDetailsToLoad.contains(ShowScraperInfo::Actors) && Settings::instance()->downloadActorImages()) {
-        for (Actor* actor : show->actors()) {
-            if (actor->thumb.isEmpty()) {
-                continue;
-            }
-            addDownload(ImageType::Actor, QUrl(actor->thumb), show, actor);
-            downloadsSize++;
-        }
-    }
-
-    for (SeasonNumber season : show->seasons()) {
-        if (!show->seasonPosters(season).isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::SeasonPoster)) {
-            addDownload(ImageType::TvShowSeasonPoster, show->seasonPosters(season).at(0).originalUrl, show, season);
-            downloadsSize++;
-        }
-        if (!show->seasonBackdrops(season).isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::SeasonBackdrop)) {
-            addDownload(ImageType::TvShowSeasonBackdrop, show->seasonBackdrops(season).at(0).originalUrl, show, season);
-            downloadsSize++;
-        }
-        if (!show->seasonBanners(season).isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::SeasonBanner)) {
-            addDownload(ImageType::TvShowSeasonBanner, show->seasonBanners(season).at(0).originalUrl, show, season);
-            downloadsSize++;
-        }
-    }
-
-    if (downloadsSize > 0) {
-        ui->progressItem->setMaximum(downloadsSize);
-    } else {
-        scrapeNext();
-    }
-}
-
-void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShow* show, SeasonNumber season)
-{
-    DownloadManagerElement d;
-    d.imageType = imageType;
-    d.url = std::move(url);
-    d.season = season;
-    d.show = show;
-    m_downloadManager->addDownload(d);
-}
-
-void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShow* show, Actor* actor)
-{
-    DownloadManagerElement d;
-    d.imageType = imageType;
-    d.url = std::move(url);
-    d.actor = actor;
-    d.show = show;
-    m_downloadManager->addDownload(d);
-}
-
-void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShowEpisode* episode)
-{
-    DownloadManagerElement d;
-    d.imageType = imageType;
-    d.url = std::move(url);
-    d.episode = episode;
-    d.directDownload = true;
-    m_downloadManager->addDownload(d);
-}
-
-void TvShowMultiScrapeDialog::onDownloadFinished(DownloadManagerElement elem)
-{
-    if (elem.show != nullptr) {
-        int left = m_downloadManager->downloadsLeftForShow(m_currentShow);
-        ui->progressItem->setValue(ui->progressItem->maximum() - left);
-        qDebug() << "Download finished" << left << ui->progressItem->maximum();
-
-        if (TvShow::seasonImageTypes().contains(elem.imageType)) {
-            if (elem.imageType == ImageType::TvShowSeasonBackdrop) {
-                helper::resizeBackdrop(elem.data);
-            }
-            ImageCache::instance()->invalidateImages(
-                Manager::instance()->mediaCenterInterface()->imageFileName(elem.show, elem.imageType, elem.season));
-            elem.show->setSeasonImage(elem.season, elem.imageType, elem.data);
-        } else if (elem.imageType != ImageType::Actor) {
-            if (elem.imageType == ImageType::TvShowBackdrop) {
-                helper::resizeBackdrop(elem.data);
-            }
-            ImageCache::instance()->invalidateImages(
-                Manager::instance()->mediaCenterInterface()->imageFileName(elem.show, elem.imageType));
-            elem.show->setImage(elem.imageType, elem.data);
-        }
-    } else if ((elem.episode != nullptr) && elem.imageType == ImageType::TvShowEpisodeThumb) {
-        elem.episode->setThumbnailImage(elem.data);
-        // scrapeNext();
-    }
-}
-
 void TvShowMultiScrapeDialog::setupSeasonOrderComboBox()
 {
     m_seasonOrder = TvShowCommonWidgets::setupSeasonOrderComboBox(
@@ -835,22 +464,3 @@ void TvShowMultiScrapeDialog::setupLanguageDropdown()
     m_locale = Settings::instance()->scraperSettings(meta.identifier)->language(meta.defaultLocale);
     ui->comboLanguage->setupLanguages(meta.supportedLanguages, m_locale);
 }
-
-void TvShowMultiScrapeDialog::onEpisodeLoadDone()
-{
-    auto* episode = dynamic_cast<TvShowEpisode*>(QObject::sender());
-    if (episode == nullptr) {
-        return;
-    }
-
-    logToUser(tr("S%2E%3: Finished scraping episode details. Title is: \"%1\".")
-                  .arg(episode->title(),
-                      m_currentEpisode->seasonNumber().toPaddedString(),
-                      m_currentEpisode->episodeNumber().toPaddedString()));
-
-    if (m_episodeDetailsToLoad.contains(EpisodeScraperInfo::Thumbnail) && !episode->thumbnail().isEmpty()) {
-        addDownload(ImageType::TvShowEpisodeThumb, episode->thumbnail(), episode);
-    } else {
-        scrapeNext();
-    }
-}
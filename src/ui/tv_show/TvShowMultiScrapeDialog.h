@@ -1,13 +1,11 @@
 #pragma once
 
-#include "globals/DownloadManager.h"
+#include "scrapers/ScrapePipeline.h"
 #include "scrapers/tv_show/TvScraper.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDialog>
-#include <QPointer>
-#include <QQueue>
 
 namespace Ui {
 class TvShowMultiScrapeDialog;
@@ -39,12 +37,10 @@ private slots:
     void onChkAllEpisodeInfosToggled();
     void onStartScraping();
     void onScrapingFinished();
-    void onSearchFinished(mediaelch::scraper::ShowSearchJob* searchJob);
-    void scrapeNext();
-    void onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details);
-    void onEpisodeLoadDone();
-    void onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster>> posters);
-    void onDownloadFinished(DownloadManagerElement elem);
+    void onItemStarted(mediaelch::scraper::ScrapePipelineItem* item);
+    void onItemProgress(mediaelch::scraper::ScrapePipelineItem* item, int done, int total);
+    void onItemFinished(mediaelch::scraper::ScrapePipelineItem* item);
+    void onProgress(int finished, int total);
 
     void onScraperChanged(int index);
     void onLanguageChanged();
@@ -57,29 +53,19 @@ private:
     SeasonOrder m_seasonOrder = SeasonOrder::Aired;
     QSet<ShowScraperInfo> m_showDetailsToLoad;
     QSet<EpisodeScraperInfo> m_episodeDetailsToLoad;
-    QQueue<TvShow*> m_showQueue;
-    QQueue<TvShowEpisode*> m_episodeQueue;
-    QPointer<TvShow> m_currentShow = nullptr;
-    QPointer<TvShowEpisode> m_currentEpisode = nullptr;
     mediaelch::scraper::TvScraper* m_currentScraper = nullptr;
     mediaelch::Locale m_locale = mediaelch::Locale::English;
-    DownloadManager* m_downloadManager;
-    QMap<QString, mediaelch::scraper::ShowIdentifier> m_showIds;
+    mediaelch::scraper::ScrapePipeline* m_pipeline = nullptr;
 
 private:
     void setupLanguageDropdown();
     void setupScraperDropdown();
     void setupSeasonOrderComboBox();
     void updateCheckBoxes();
-    void saveCurrentItem();
 
     TvShowUpdateType updateType() const;
 
     void logToUser(const QString& msg);
 
-    void addDownload(ImageType imageType, QUrl url, TvShow* show, SeasonNumber season = SeasonNumber::NoSeason);
-    void addDownload(ImageType imageType, QUrl url, TvShow* show, Actor* actor);
-    void addDownload(ImageType imageType, QUrl url, TvShowEpisode* episode);
-
     void showError(const QString& message);
 };
@@ -59,6 +59,7 @@ TvShowWidgetEpisode::TvShowWidgetEpisode(QWidget* parent) :
     ui->thumbnail->setShowCapture(true);
 
     m_posterDownloadManager = new DownloadManager(this);
+    m_posterDownloadManager->setPriority(DownloadPriority::High);
 
     connect(ui->name, &QLineEdit::textChanged, ui->episodeName, &QLabel::setText);
     connect(ui->buttonAddDirector, &QAbstractButton::clicked, this, &TvShowWidgetEpisode::onAddDirector);
@@ -332,6 +333,7 @@ void TvShowWidgetEpisode::setEpisode(TvShowEpisode* episode)
 {
     qDebug() << "Entered, episode=" << episode->title();
     m_episode = episode;
+    episode->loadDetails();
     if (!episode->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails() && !episode->isDummy()) {
         // Loading stream details als marks the episode as changed...
         // TODO: Refactor the "hasChanged" stuff...
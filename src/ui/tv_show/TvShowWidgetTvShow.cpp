@@ -95,6 +95,7 @@ TvShowWidgetTvShow::TvShowWidgetTvShow(QWidget* parent) :
     m_savingWidget->hide();
 
     m_posterDownloadManager = new DownloadManager(this);
+    m_posterDownloadManager->setPriority(DownloadPriority::High);
 
     ui->poster->setImageType(ImageType::TvShowPoster);
     ui->backdrop->setImageType(ImageType::TvShowBackdrop);
@@ -663,6 +664,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
             }
             DownloadManagerElement d;
             d.imageType = ImageType::Actor;
+            d.priority = DownloadPriority::Low;
             d.url = QUrl(actor->thumb);
             d.actor = actor;
             d.show = show;
@@ -711,6 +713,7 @@ void TvShowWidgetTvShow::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster
             }
             DownloadManagerElement d;
             d.imageType = ImageType::TvShowEpisodeThumb;
+            d.priority = DownloadPriority::Low;
             d.url = episode->thumbnail();
             d.episode = episode;
             d.show = show;
@@ -0,0 +1,171 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "movies/Movie.h"
+
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <vector>
+
+namespace {
+
+constexpr int fixtureMovieCount = 50000;
+const char* const fixtureMovieDir = "/media/movies";
+
+QByteArray movieNfo(int index)
+{
+    return QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                          "<movie>\n"
+                          "    <title>Movie %1</title>\n"
+                          "    <originaltitle>Original Movie %1</originaltitle>\n"
+                          "    <sorttitle>Movie %1</sorttitle>\n"
+                          "    <rating>7.4</rating>\n"
+                          "    <year>%2</year>\n"
+                          "    <plot>A long plot of movie %1. It is long enough to make the cached NFO content "
+                          "about as large as the one of real movies. Lorem ipsum dolor sit amet, consectetur "
+                          "adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.</plot>\n"
+                          "    <outline>Outline of movie %1</outline>\n"
+                          "    <tagline>Tagline %1</tagline>\n"
+                          "    <runtime>123</runtime>\n"
+                          "    <mpaa>PG-13</mpaa>\n"
+                          "    <playcount>%3</playcount>\n"
+                          "    <id>tt%4</id>\n"
+                          "    <tmdbid>%1</tmdbid>\n"
+                          "    <genre>Action</genre>\n"
+                          "    <genre>Drama</genre>\n"
+                          "    <studio>Studio %1</studio>\n"
+                          "    <director>Director %1</director>\n"
+                          "    <actor>\n"
+                          "        <name>Actor %1</name>\n"
+                          "        <role>Role %1</role>\n"
+                          "    </actor>\n"
+                          "</movie>\n")
+        .arg(index)
+        .arg(1950 + index % 70)
+        .arg(index % 3)
+        .arg(index, 7, 10, QChar('0'))
+        .toUtf8();
+}
+
+/// Creates a cache database with fixtureMovieCount movies, each with one file,
+/// a label, a summary and every tenth with a subtitle.
+void createFixture(const QString& databaseFile)
+{
+    Database database(databaseFile, "benchmarkFixture");
+    QSqlDatabase db = database.db();
+    db.transaction();
+
+    QSqlQuery movieQuery(db);
+    movieQuery.prepare("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
+                       "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, "
+                       "title, sortTitle, released, playcount, infoLoaded, path) "
+                       "VALUES(?, ?, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, ?, ?, ?, ?, 1, ?)");
+    QSqlQuery fileQuery(db);
+    fileQuery.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(?, ?)");
+    QSqlQuery labelQuery(db);
+    labelQuery.prepare("INSERT INTO labels(color, fileName) VALUES(?, ?)");
+    QSqlQuery subtitleQuery(db);
+    subtitleQuery.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(?, ?, 'en', 0)");
+
+    const QByteArray path = QByteArray(fixtureMovieDir);
+    const QDateTime lastModified = QDateTime::currentDateTime();
+    for (int i = 0; i < fixtureMovieCount; ++i) {
+        movieQuery.bindValue(0, movieNfo(i));
+        movieQuery.bindValue(1, lastModified);
+        movieQuery.bindValue(2, QStringLiteral("Movie %1").arg(i));
+        movieQuery.bindValue(3, QStringLiteral("Movie %1").arg(i));
+        movieQuery.bindValue(4, QStringLiteral("%1-01-01").arg(1950 + i % 70));
+        movieQuery.bindValue(5, i % 3);
+        movieQuery.bindValue(6, path);
+        movieQuery.exec();
+        const int idMovie = movieQuery.lastInsertId().toInt();
+
+        const QByteArray file = path + QStringLiteral("/Movie %1 (%2)/movie.mkv").arg(i).arg(1950 + i % 70).toUtf8();
+        fileQuery.bindValue(0, idMovie);
+        fileQuery.bindValue(1, file);
+        fileQuery.exec();
+
+        labelQuery.bindValue(0, i % 7);
+        labelQuery.bindValue(1, file);
+        labelQuery.exec();
+
+        if (i % 10 == 0) {
+            subtitleQuery.bindValue(0, idMovie);
+            subtitleQuery.bindValue(1, QStringLiteral("Movie %1.en.srt").arg(i));
+            subtitleQuery.exec();
+        }
+    }
+    db.commit();
+}
+
+/// The fixture is created once per benchmark run.
+const QString& fixtureFile()
+{
+    static QTemporaryDir s_dir;
+    static QString s_file = [] {
+        QString file = s_dir.filePath("MediaElch.sqlite");
+        createFixture(file);
+        return file;
+    }();
+    return s_file;
+}
+
+} // namespace
+
+TEST_CASE("Database loads cached movies", "[benchmark][database]")
+{
+    const QString& file = fixtureFile();
+    const mediaelch::DirectoryPath path(fixtureMovieDir);
+
+    {
+        Database database(file, "benchmarkCheck");
+        const QVector<Movie*> movies = database.moviesInDirectory(path);
+        REQUIRE(movies.size() == fixtureMovieCount);
+        CHECK(movies.first()->files().size() == 1);
+        qDeleteAll(movies);
+
+        const QVector<Movie*> summaries = database.moviesInDirectory(path, true);
+        REQUIRE(summaries.size() == fixtureMovieCount);
+        CHECK(summaries.first()->controller()->detailsPending());
+        CHECK(summaries.first()->nfoContent().isEmpty());
+        qDeleteAll(summaries);
+    }
+
+    BENCHMARK_ADVANCED("cold start: open cache and load 50k movies")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<QVector<Movie*>> results(static_cast<std::size_t>(meter.runs()));
+        meter.measure([&](int run) {
+            Database database(file, "benchmarkColdStart");
+            results[static_cast<std::size_t>(run)] = database.moviesInDirectory(path);
+            return results[static_cast<std::size_t>(run)].size();
+        });
+        for (const auto& movies : results) {
+            qDeleteAll(movies);
+        }
+    };
+
+    Database database(file, "benchmarkWarm");
+    BENCHMARK_ADVANCED("moviesInDirectory: 50k movies")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<QVector<Movie*>> results(static_cast<std::size_t>(meter.runs()));
+        meter.measure([&](int run) {
+            results[static_cast<std::size_t>(run)] = database.moviesInDirectory(path);
+            return results[static_cast<std::size_t>(run)].size();
+        });
+        for (const auto& movies : results) {
+            qDeleteAll(movies);
+        }
+    };
+
+    BENCHMARK_ADVANCED("moviesInDirectory (summary only): 50k movies")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<QVector<Movie*>> results(static_cast<std::size_t>(meter.runs()));
+        meter.measure([&](int run) {
+            results[static_cast<std::size_t>(run)] = database.moviesInDirectory(path, true);
+            return results[static_cast<std::size_t>(run)].size();
+        });
+        for (const auto& movies : results) {
+            qDeleteAll(movies);
+        }
+    };
+}
@@ -0,0 +1,148 @@
+#include "test/test_helpers.h"
+
+#include "export/CsvExport.h"
+#include "globals/Actor.h"
+#include "movies/Movie.h"
+
+#include <QElapsedTimer>
+#include <QIODevice>
+#include <QTextStream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int fixtureRowCount = 1000000;
+constexpr int fixtureMovieCount = 10000;
+
+/// Discards everything that is written but counts the bytes.  Used so that
+/// the benchmark measures the CSV writer and not the disk.
+class NullDevice : public QIODevice
+{
+public:
+    NullDevice() { open(QIODevice::WriteOnly); }
+    qint64 bytesWritten() const { return m_bytes; }
+
+protected:
+    qint64 readData(char* /*data*/, qint64 /*maxSize*/) override { return -1; }
+    qint64 writeData(const char* /*data*/, qint64 len) override
+    {
+        m_bytes += len;
+        return len;
+    }
+
+private:
+    qint64 m_bytes = 0;
+};
+
+std::vector<std::unique_ptr<Movie>> createMovies()
+{
+    std::vector<std::unique_ptr<Movie>> movies;
+    movies.reserve(fixtureMovieCount);
+    for (int i = 0; i < fixtureMovieCount; ++i) {
+        auto movie = std::make_unique<Movie>(QStringList{QStringLiteral("/media/movies/Movie %1/movie.mkv").arg(i)});
+        movie->setName(QStringLiteral("Movie %1").arg(i));
+        movie->setOriginalName(QStringLiteral("Original Movie %1").arg(i));
+        movie->setOverview(QStringLiteral("Plot of movie %1.\nLorem ipsum dolor sit amet, consectetur adipiscing "
+                                          "elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.")
+                               .arg(i));
+        movie->setTagline(QStringLiteral("Tagline %1").arg(i));
+        movie->setImdbId(ImdbId(QStringLiteral("tt%1").arg(i, 7, 10, QChar('0'))));
+        movie->addGenre("Action");
+        movie->addGenre("Drama");
+        movie->addTag(QStringLiteral("Tag %1").arg(i % 100));
+        for (int a = 0; a < 5; ++a) {
+            Actor actor;
+            actor.name = QStringLiteral("Actor %1").arg(a);
+            actor.role = QStringLiteral("Role %1").arg(a);
+            movie->addActor(actor);
+        }
+        movies.push_back(std::move(movie));
+    }
+    return movies;
+}
+
+QVector<mediaelch::CsvMovieExport::Field> allMovieFields()
+{
+    using Field = mediaelch::CsvMovieExport::Field;
+    QVector<Field> fields;
+    for (int i = 1; mediaelch::CsvMovieExport::fieldToString(static_cast<Field>(i)) != "unknown"; ++i) {
+        fields << static_cast<Field>(i);
+    }
+    return fields;
+}
+
+/// Writes fixtureRowCount rows with ten synthetic cells each.
+qint64 writeSyntheticRows()
+{
+    const QVector<QString> cells = {"tt0000001",
+        "Movie",
+        "Original Movie",
+        "A plot with a\ttab",
+        "Action, Drama",
+        "2001-05-01",
+        "123",
+        "PG-13",
+        "/media/movies/Movie",
+        "movie.mkv"};
+
+    NullDevice device;
+    QTextStream stream(&device);
+    stream.setCodec("UTF-8");
+    mediaelch::CsvWriter csv(stream);
+    for (int row = 0; row < fixtureRowCount; ++row) {
+        for (const QString& cell : cells) {
+            csv.addCell(cell);
+        }
+        csv.endRow();
+    }
+    stream.flush();
+    return device.bytesWritten();
+}
+
+/// Exports all movies fixtureRowCount / fixtureMovieCount times, i.e. writes fixtureRowCount movie rows.
+qint64 exportMovies(const QVector<Movie*>& movies, const QVector<mediaelch::CsvMovieExport::Field>& fields)
+{
+    NullDevice device;
+    QTextStream stream(&device);
+    stream.setCodec("UTF-8");
+    for (int i = 0; i < fixtureRowCount / fixtureMovieCount; ++i) {
+        mediaelch::CsvMovieExport exporter(stream, fields);
+        exporter.exportMovies(movies, []() {});
+    }
+    stream.flush();
+    return device.bytesWritten();
+}
+
+} // namespace
+
+TEST_CASE("CSV export throughput", "[benchmark][export][csv]")
+{
+    const std::vector<std::unique_ptr<Movie>> movieFixture = createMovies();
+    QVector<Movie*> movies;
+    for (const auto& movie : movieFixture) {
+        movies << movie.get();
+    }
+    const auto fields = allMovieFields();
+    REQUIRE(fields.size() == 36);
+
+    {
+        QElapsedTimer timer;
+        timer.start();
+        const qint64 bytes = writeSyntheticRows();
+        const double seconds = static_cast<double>(qMax<qint64>(timer.nsecsElapsed(), 1)) / 1e9;
+        WARN(QStringLiteral("CsvWriter, 1M rows: %1 MB/s")
+                 .arg(static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds, 0, 'f', 1)
+                 .toStdString());
+    }
+
+    BENCHMARK_ADVANCED("write 1M synthetic rows (10 columns)")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return writeSyntheticRows(); });
+    };
+
+    BENCHMARK_ADVANCED("export 1M movie rows (all fields)")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return exportMovies(movies, fields); });
+    };
+}
@@ -0,0 +1,156 @@
+#include "test/test_helpers.h"
+
+#include "file/FileNameMatcher.h"
+#include "settings/AdvancedSettings.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <functional>
+
+using namespace mediaelch;
+
+namespace {
+
+constexpr int fixtureNameCount = 100000;
+constexpr int fixturePatternCount = 50;
+
+QStringList createNames()
+{
+    static const QStringList extensions = {".mkv", ".avi", ".nfo", ".jpg", ".srt", ".mp4", ".txt", ".iso"};
+    QStringList names;
+    names.reserve(fixtureNameCount);
+    for (int i = 0; i < fixtureNameCount; ++i) {
+        QString name = QStringLiteral("Some Movie Title %1 (%2) [1080p]").arg(i).arg(1950 + i % 70);
+        if (i % 97 == 0) {
+            name += QStringLiteral("-sample");
+        }
+        names << name + extensions[i % extensions.size()];
+    }
+    return names;
+}
+
+/// Patterns similar to those found in users' advancedsettings.xml: mostly
+/// literals and anchored literals, some real regular expressions.
+QVector<QRegularExpression> createPatterns()
+{
+    QVector<QRegularExpression> patterns;
+    patterns << QRegularExpression(R"(^\.)") << QRegularExpression(R"(-sample\.)")
+             << QRegularExpression(R"(\.part$)") << QRegularExpression(R"(^@eaDir$)")
+             << QRegularExpression(R"(\.(tmp|bak|!qb)$)") << QRegularExpression(R"(^(extras|featurettes)$)");
+    for (int i = patterns.size(); i < fixturePatternCount; ++i) {
+        if (i % 3 == 0) {
+            patterns << QRegularExpression(QStringLiteral("excluded-%1").arg(i));
+        } else if (i % 3 == 1) {
+            patterns << QRegularExpression(QStringLiteral(R"(^\[tag%1\])").arg(i));
+        } else {
+            patterns << QRegularExpression(QStringLiteral(R"(group%1-\d+)").arg(i));
+        }
+    }
+    for (auto& pattern : patterns) {
+        pattern.optimize();
+    }
+    return patterns;
+}
+
+int countMatchesPerPattern(const QVector<QRegularExpression>& patterns, const QStringList& names)
+{
+    int count = 0;
+    for (const QString& name : names) {
+        for (const QRegularExpression& pattern : patterns) {
+            if (pattern.match(name).hasMatch()) {
+                ++count;
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+int countMatches(const FileNameMatcher& matcher, const QStringList& names)
+{
+    int count = 0;
+    for (const QString& name : names) {
+        count += matcher.matches(name) ? 1 : 0;
+    }
+    return count;
+}
+
+int countFilterMatches(const QStringList& filters, const QStringList& names)
+{
+    int count = 0;
+    for (const QString& name : names) {
+        count += QDir::match(filters, name) ? 1 : 0;
+    }
+    return count;
+}
+
+void reportNamesPerSecond(const QString& name, const std::function<int()>& run)
+{
+    QElapsedTimer timer;
+    timer.start();
+    run();
+    const double seconds = static_cast<double>(qMax<qint64>(timer.nsecsElapsed(), 1)) / 1e9;
+    WARN(QStringLiteral("%1: %2 names/s")
+             .arg(name)
+             .arg(static_cast<double>(fixtureNameCount) / seconds, 0, 'f', 0)
+             .toStdString());
+}
+
+} // namespace
+
+TEST_CASE("Exclude pattern matching", "[benchmark][file]")
+{
+    const QStringList names = createNames();
+    const QVector<QRegularExpression> patterns = createPatterns();
+    const FileNameMatcher matcher = FileNameMatcher::fromRegularExpressions(patterns);
+
+    REQUIRE(countMatches(matcher, names) == countMatchesPerPattern(patterns, names));
+
+    reportNamesPerSecond("50 patterns, one regex each", [&] { return countMatchesPerPattern(patterns, names); });
+    reportNamesPerSecond("50 patterns, FileNameMatcher", [&] { return countMatches(matcher, names); });
+
+    BENCHMARK_ADVANCED("100k names, 50 patterns, one regex each")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return countMatchesPerPattern(patterns, names); });
+    };
+
+    BENCHMARK_ADVANCED("100k names, 50 patterns, FileNameMatcher")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return countMatches(matcher, names); });
+    };
+}
+
+TEST_CASE("File filter matching", "[benchmark][file]")
+{
+    const QStringList names = createNames();
+    const AdvancedSettings settings;
+    const FileFilter& filter = settings.movieFilters();
+    const QStringList wildcards = filter.filters();
+
+    REQUIRE(countMatches(FileNameMatcher::fromWildcards(wildcards), names) == countFilterMatches(wildcards, names));
+
+    reportNamesPerSecond("video filters, QDir::match", [&] { return countFilterMatches(wildcards, names); });
+    reportNamesPerSecond("video filters, FileFilter::matches", [&] {
+        int count = 0;
+        for (const QString& name : names) {
+            count += filter.matches(name) ? 1 : 0;
+        }
+        return count;
+    });
+
+    BENCHMARK_ADVANCED("100k names, video filters, QDir::match")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return countFilterMatches(wildcards, names); });
+    };
+
+    BENCHMARK_ADVANCED("100k names, video filters, FileFilter::matches")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            int count = 0;
+            for (const QString& name : names) {
+                count += filter.matches(name) ? 1 : 0;
+            }
+            return count;
+        });
+    };
+}
@@ -0,0 +1,18 @@
+#define CATCH_CONFIG_RUNNER
+#include "third_party/catch2/catch.hpp"
+
+#include "globals/Meta.h"
+
+#include <QApplication>
+#include <QStandardPaths>
+
+int main(int argc, char** argv)
+{
+    QApplication app(argc, argv);
+    // Benchmarks must never touch the user's cache database or settings.
+    QStandardPaths::setTestModeEnabled(true);
+    registerAllMetaTypes();
+    Catch::Session session; // NOLINT(clang-analyzer-core.uninitialized.UndefReturn)
+    const int res = session.run(argc, argv);
+    return res;
+}
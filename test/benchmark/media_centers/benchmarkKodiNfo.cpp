@@ -0,0 +1,289 @@
+#include "test/test_helpers.h"
+
+#include "media_centers/KodiXml.h"
+#include "media_centers/kodi/EpisodeXmlReader.h"
+#include "media_centers/kodi/MovieXmlReader.h"
+#include "movies/Movie.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QXmlStreamReader>
+
+namespace {
+
+constexpr int fixtureNfoCount = 2000;
+
+QString movieNfo(int index)
+{
+    QString actors;
+    for (int i = 0; i < 15; ++i) {
+        actors += QStringLiteral("    <actor>\n"
+                                 "        <name>Actor %1</name>\n"
+                                 "        <role>Role %1</role>\n"
+                                 "        <thumb>https://image.tmdb.org/t/p/original/actor%1.jpg</thumb>\n"
+                                 "    </actor>\n")
+                      .arg(i);
+    }
+    QString thumbs;
+    for (int i = 0; i < 10; ++i) {
+        thumbs += QStringLiteral("    <thumb aspect=\"poster\" preview=\"https://image.tmdb.org/t/p/w500/poster%1.jpg\">"
+                                 "https://image.tmdb.org/t/p/original/poster%1.jpg</thumb>\n")
+                      .arg(i);
+    }
+    return QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                          "<movie>\n"
+                          "    <title>Movie %1</title>\n"
+                          "    <originaltitle>Original Movie %1</originaltitle>\n"
+                          "    <sorttitle>Movie %1</sorttitle>\n"
+                          "    <ratings>\n"
+                          "        <rating name=\"imdb\" max=\"10\" default=\"true\">\n"
+                          "            <value>7.4</value>\n"
+                          "            <votes>123456</votes>\n"
+                          "        </rating>\n"
+                          "    </ratings>\n"
+                          "    <userrating>8</userrating>\n"
+                          "    <top250>0</top250>\n"
+                          "    <year>%2</year>\n"
+                          "    <plot>A long plot of movie %1. Lorem ipsum dolor sit amet, consectetur adipiscing "
+                          "elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad "
+                          "minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo "
+                          "consequat.</plot>\n"
+                          "    <outline>Outline of movie %1</outline>\n"
+                          "    <tagline>Tagline %1</tagline>\n"
+                          "    <runtime>123</runtime>\n"
+                          "%3"
+                          "    <fanart>\n"
+                          "        <thumb preview=\"https://image.tmdb.org/t/p/w780/fanart.jpg\">"
+                          "https://image.tmdb.org/t/p/original/fanart.jpg</thumb>\n"
+                          "    </fanart>\n"
+                          "    <mpaa>PG-13</mpaa>\n"
+                          "    <playcount>1</playcount>\n"
+                          "    <lastplayed>2020-01-01 20:00:00</lastplayed>\n"
+                          "    <uniqueid type=\"imdb\" default=\"true\">tt%4</uniqueid>\n"
+                          "    <uniqueid type=\"tmdb\">%1</uniqueid>\n"
+                          "    <genre>Action</genre>\n"
+                          "    <genre>Drama</genre>\n"
+                          "    <country>USA</country>\n"
+                          "    <set>\n"
+                          "        <name>Collection %1</name>\n"
+                          "        <overview>Overview of collection %1</overview>\n"
+                          "    </set>\n"
+                          "    <tag>Tag %1</tag>\n"
+                          "    <credits>Writer %1</credits>\n"
+                          "    <director>Director %1</director>\n"
+                          "    <premiered>%2-05-01</premiered>\n"
+                          "    <studio>Studio %1</studio>\n"
+                          "    <trailer>plugin://plugin.video.youtube/?action=play_video&amp;videoid=%1</trailer>\n"
+                          "    <fileinfo>\n"
+                          "        <streamdetails>\n"
+                          "            <video>\n"
+                          "                <codec>h264</codec>\n"
+                          "                <aspect>2.35</aspect>\n"
+                          "                <width>1920</width>\n"
+                          "                <height>816</height>\n"
+                          "                <durationinseconds>7380</durationinseconds>\n"
+                          "            </video>\n"
+                          "            <audio>\n"
+                          "                <codec>dts</codec>\n"
+                          "                <language>eng</language>\n"
+                          "                <channels>6</channels>\n"
+                          "            </audio>\n"
+                          "            <subtitle>\n"
+                          "                <language>eng</language>\n"
+                          "            </subtitle>\n"
+                          "        </streamdetails>\n"
+                          "    </fileinfo>\n"
+                          "%5"
+                          "    <dateadded>2019-06-01 12:00:00</dateadded>\n"
+                          "</movie>\n")
+        .arg(index)
+        .arg(1950 + index % 70)
+        .arg(thumbs)
+        .arg(index, 7, 10, QChar('0'))
+        .arg(actors);
+}
+
+QString episodeNfo(int index)
+{
+    QString actors;
+    for (int i = 0; i < 8; ++i) {
+        actors += QStringLiteral("    <actor>\n"
+                                 "        <name>Actor %1</name>\n"
+                                 "        <role>Role %1</role>\n"
+                                 "        <order>%1</order>\n"
+                                 "    </actor>\n")
+                      .arg(i);
+    }
+    return QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                          "<episodedetails>\n"
+                          "    <title>Episode %1</title>\n"
+                          "    <showtitle>Show</showtitle>\n"
+                          "    <ratings>\n"
+                          "        <rating name=\"tvdb\" max=\"10\" default=\"true\">\n"
+                          "            <value>8.1</value>\n"
+                          "            <votes>42</votes>\n"
+                          "        </rating>\n"
+                          "    </ratings>\n"
+                          "    <season>%2</season>\n"
+                          "    <episode>%3</episode>\n"
+                          "    <plot>Plot of episode %1. Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+                          "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.</plot>\n"
+                          "    <thumb>https://artworks.thetvdb.com/banners/episodes/%1.jpg</thumb>\n"
+                          "    <mpaa>TV-14</mpaa>\n"
+                          "    <uniqueid type=\"tvdb\" default=\"true\">%1</uniqueid>\n"
+                          "    <credits>Writer %1</credits>\n"
+                          "    <director>Director %1</director>\n"
+                          "    <aired>2010-01-01</aired>\n"
+                          "    <studio>Network</studio>\n"
+                          "%4"
+                          "</episodedetails>\n")
+        .arg(index)
+        .arg(index / 20 + 1)
+        .arg(index % 20 + 1)
+        .arg(actors);
+}
+
+QVector<QString> fixture(QString (*nfo)(int))
+{
+    QVector<QString> nfos;
+    nfos.reserve(fixtureNfoCount);
+    for (int i = 0; i < fixtureNfoCount; ++i) {
+        nfos.push_back(nfo(i));
+    }
+    return nfos;
+}
+
+double megabytes(const QVector<QString>& nfos)
+{
+    qint64 bytes = 0;
+    for (const QString& nfo : nfos) {
+        bytes += nfo.toUtf8().size();
+    }
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+/// Reports the throughput of a single pass over all NFOs.
+template<class Callback>
+void reportThroughput(const char* name, const QVector<QString>& nfos, Callback callback)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (const QString& nfo : nfos) {
+        callback(nfo);
+    }
+    const double seconds = static_cast<double>(qMax<qint64>(timer.nsecsElapsed(), 1)) / 1e9;
+    WARN(QStringLiteral("%1: %2 MB/s").arg(name).arg(megabytes(nfos) / seconds, 0, 'f', 1).toStdString());
+}
+
+void readMovie(const QString& nfo)
+{
+    Movie movie;
+    QXmlStreamReader xml(nfo);
+    mediaelch::kodi::MovieXmlReader reader(movie);
+    reader.parseNfo(xml);
+}
+
+void readEpisode(const QString& nfo)
+{
+    TvShowEpisode episode;
+    QXmlStreamReader xml(nfo);
+    mediaelch::kodi::readNextNfoElement(xml, QLatin1String("episodedetails"));
+    mediaelch::kodi::EpisodeXmlReader reader(episode);
+    reader.parseNfo(xml);
+}
+
+/// Loads the NFO the way MediaElch does, including the check for malformed XML.
+void loadMovie(KodiXml& kodi, const QString& nfo)
+{
+    Movie movie;
+    kodi.loadMovie(&movie, nfo);
+}
+
+void loadEpisode(KodiXml& kodi, const QString& nfo)
+{
+    TvShowEpisode episode;
+    kodi.loadTvShowEpisode(&episode, nfo);
+}
+
+void buildDom(const QString& nfo)
+{
+    QDomDocument domDoc;
+    domDoc.setContent(nfo);
+}
+
+} // namespace
+
+TEST_CASE("Kodi NFO reader throughput", "[benchmark][nfo][kodi]")
+{
+    const QVector<QString> movies = fixture(movieNfo);
+    const QVector<QString> episodes = fixture(episodeNfo);
+
+    {
+        Movie movie;
+        QXmlStreamReader xml(movies.first());
+        mediaelch::kodi::MovieXmlReader reader(movie);
+        reader.parseNfo(xml);
+        REQUIRE(movie.name() == "Movie 0");
+        CHECK(movie.actors().size() == 15);
+        CHECK(movie.images().posters().size() == 10);
+        CHECK(reader.hasStreamDetails());
+    }
+
+    KodiXml kodi;
+    const auto loadMovies = [&kodi](const QString& nfo) { loadMovie(kodi, nfo); };
+    const auto loadEpisodes = [&kodi](const QString& nfo) { loadEpisode(kodi, nfo); };
+
+    reportThroughput("movies (QXmlStreamReader)", movies, readMovie);
+    reportThroughput("episodes (QXmlStreamReader)", episodes, readEpisode);
+    reportThroughput("movies (KodiXml::loadMovie)", movies, loadMovies);
+    reportThroughput("episodes (KodiXml::loadTvShowEpisode)", episodes, loadEpisodes);
+    reportThroughput("movies (QDomDocument, DOM only)", movies, buildDom);
+
+    BENCHMARK_ADVANCED("read 2000 movie NFOs")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            for (const QString& nfo : movies) {
+                readMovie(nfo);
+            }
+        });
+    };
+
+    BENCHMARK_ADVANCED("read 2000 episode NFOs")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            for (const QString& nfo : episodes) {
+                readEpisode(nfo);
+            }
+        });
+    };
+
+    BENCHMARK_ADVANCED("load 2000 movie NFOs with KodiXml")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            for (const QString& nfo : movies) {
+                loadMovie(kodi, nfo);
+            }
+        });
+    };
+
+    BENCHMARK_ADVANCED("load 2000 episode NFOs with KodiXml")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            for (const QString& nfo : episodes) {
+                loadEpisode(kodi, nfo);
+            }
+        });
+    };
+
+    // Only builds the DOM.  The old DOM-based readers had to do this before
+    // running elementsByTagName() queries for each tag.
+    BENCHMARK_ADVANCED("build QDomDocument of 2000 movie NFOs")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            for (const QString& nfo : movies) {
+                buildDom(nfo);
+            }
+        });
+    };
+}
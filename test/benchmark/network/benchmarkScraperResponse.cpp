@@ -0,0 +1,195 @@
+#include "test/test_helpers.h"
+
+#include "network/WebsiteCache.h"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace mediaelch;
+
+namespace {
+
+constexpr int fixtureResponseCount = 500;
+
+QString overview(int index)
+{
+    // Non-ASCII characters so that UTF-8 and UTF-16 sizes differ as they do for localized responses.
+    return QStringLiteral("Episode %1: Lorem ipsum dolor sit amet, consectetur adipiscing elit. Über den Wolken "
+                          "– ein Ausflug nach Málaga, Kraków und 東京. Sed do eiusmod tempor incididunt ut labore "
+                          "et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco.")
+        .arg(index);
+}
+
+QJsonObject person(int index, const QString& job)
+{
+    QJsonObject obj;
+    obj["id"] = 1000 + index;
+    obj["name"] = QStringLiteral("Søren Ñúñez %1").arg(index);
+    obj["job"] = job;
+    obj["character"] = QStringLiteral("Character %1").arg(index);
+    obj["profile_path"] = QStringLiteral("/profile%1.jpg").arg(index);
+    return obj;
+}
+
+/// Same structure as TMDb's /tv/{id}/season/{season} response.
+QByteArray tmdbSeasonPayload(int season)
+{
+    QJsonArray episodes;
+    for (int e = 1; e <= 22; ++e) {
+        QJsonArray crew;
+        crew << person(e, "Director") << person(e + 1, "Writer");
+        QJsonArray guests;
+        for (int g = 0; g < 8; ++g) {
+            guests << person(g, "Guest");
+        }
+        QJsonObject episode;
+        episode["air_date"] = "2015-04-12";
+        episode["episode_number"] = e;
+        episode["season_number"] = season;
+        episode["id"] = season * 100 + e;
+        episode["name"] = QStringLiteral("Épisode %1").arg(e);
+        episode["overview"] = overview(e);
+        episode["still_path"] = QStringLiteral("/still%1.jpg").arg(e);
+        episode["vote_average"] = 7.8;
+        episode["vote_count"] = 123;
+        episode["crew"] = crew;
+        episode["guest_stars"] = guests;
+        episodes << episode;
+    }
+    QJsonObject root;
+    root["_id"] = "5256c89f19c2956ff6046d47";
+    root["air_date"] = "2015-04-12";
+    root["name"] = QStringLiteral("Season %1").arg(season);
+    root["overview"] = overview(0);
+    root["season_number"] = season;
+    root["episodes"] = episodes;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+/// Same structure as TheTvDb's /series/{id}/episodes?page={page} response.
+QByteArray theTvDbEpisodePayload(int page)
+{
+    QJsonArray data;
+    for (int e = 1; e <= 100; ++e) {
+        QJsonObject episode;
+        episode["id"] = page * 1000 + e;
+        episode["airedSeason"] = e / 20 + 1;
+        episode["airedEpisodeNumber"] = e % 20 + 1;
+        episode["episodeName"] = QStringLiteral("Épisode %1").arg(e);
+        episode["firstAired"] = "2015-04-12";
+        episode["overview"] = overview(e);
+        episode["directors"] = QJsonArray{QStringLiteral("Søren Ñúñez")};
+        episode["writers"] = QJsonArray{QStringLiteral("José Müller"), QStringLiteral("渡辺")};
+        episode["guestStars"] = QJsonArray{QStringLiteral("Zoë"), QStringLiteral("Ðorđe"), QStringLiteral("Åsa")};
+        episode["siteRating"] = 8.1;
+        episode["siteRatingCount"] = 42;
+        data << episode;
+    }
+    QJsonObject links;
+    links["first"] = 1;
+    links["last"] = 5;
+    links["next"] = page + 1;
+    QJsonObject root;
+    root["links"] = links;
+    root["data"] = data;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+QVector<QByteArray> createPayloads()
+{
+    QVector<QByteArray> payloads;
+    payloads.reserve(fixtureResponseCount);
+    for (int i = 0; i < fixtureResponseCount; ++i) {
+        payloads << (i % 2 == 0 ? tmdbSeasonPayload(i) : theTvDbEpisodePayload(i));
+    }
+    return payloads;
+}
+
+/// The former path: the reply body was decoded into a QString, stored in the
+/// cache as QString and encoded to UTF-8 again for QJsonDocument and the disk cache.
+int parseViaQString(const QVector<QByteArray>& payloads)
+{
+    int objects = 0;
+    for (const QByteArray& payload : payloads) {
+        const QString data = QString::fromUtf8(payload);
+        const QByteArray forDiskCache = data.toUtf8();
+        const QJsonDocument json = QJsonDocument::fromJson(data.toUtf8());
+        objects += json.object().size() + (forDiskCache.isEmpty() ? 0 : 1);
+    }
+    return objects;
+}
+
+/// The current path: the reply body is stored and parsed as is.
+int parseRaw(const QVector<QByteArray>& payloads)
+{
+    int objects = 0;
+    for (const QByteArray& payload : payloads) {
+        const QJsonDocument json = QJsonDocument::fromJson(payload);
+        objects += json.object().size() + (payload.isEmpty() ? 0 : 1);
+    }
+    return objects;
+}
+
+void reportThroughput(const char* name, const QVector<QByteArray>& payloads, int (*parse)(const QVector<QByteArray>&))
+{
+    qint64 bytes = 0;
+    for (const QByteArray& payload : payloads) {
+        bytes += payload.size();
+    }
+    QElapsedTimer timer;
+    timer.start();
+    parse(payloads);
+    const double seconds = static_cast<double>(qMax<qint64>(timer.nsecsElapsed(), 1)) / 1e9;
+    WARN(QStringLiteral("%1: %2 MB/s")
+             .arg(name)
+             .arg(static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds, 0, 'f', 1)
+             .toStdString());
+}
+
+} // namespace
+
+TEST_CASE("Scraper response parsing", "[benchmark][network][json]")
+{
+    const QVector<QByteArray> payloads = createPayloads();
+    REQUIRE(parseRaw(payloads) == parseViaQString(payloads));
+
+    {
+        // Temporary buffers per response: the former path allocated a UTF-16 copy
+        // and two UTF-8 copies; the current one allocates none.
+        qint64 utf8 = 0;
+        qint64 utf16 = 0;
+        for (const QByteArray& payload : payloads) {
+            utf8 += payload.size();
+            utf16 += QString::fromUtf8(payload).size() * static_cast<qint64>(sizeof(QChar));
+        }
+        WARN(QStringLiteral("Average response: %1 bytes; former copies per response: %2 bytes")
+                 .arg(utf8 / payloads.size())
+                 .arg((utf16 + 2 * utf8) / payloads.size())
+                 .toStdString());
+
+        scraper::WebsiteCache rawCache(nullptr, 1024 * 1024 * 1024);
+        for (int i = 0; i < payloads.size(); ++i) {
+            rawCache.addElement(QUrl(QStringLiteral("https://api.example.com/%1").arg(i)), Locale::English, payloads[i]);
+        }
+        WARN(QStringLiteral("WebsiteCache memory for %1 responses: %2 KiB (UTF-16 would need %3 KiB)")
+                 .arg(payloads.size())
+                 .arg(rawCache.memoryBytes() / 1024)
+                 .arg(utf16 / 1024)
+                 .toStdString());
+    }
+
+    reportThroughput("QString round trip", payloads, &parseViaQString);
+    reportThroughput("raw QByteArray", payloads, &parseRaw);
+
+    BENCHMARK_ADVANCED("parse 500 responses via QString")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return parseViaQString(payloads); });
+    };
+
+    BENCHMARK_ADVANCED("parse 500 responses from QByteArray")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return parseRaw(payloads); });
+    };
+}
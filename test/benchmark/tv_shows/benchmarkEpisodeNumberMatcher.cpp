@@ -0,0 +1,69 @@
+#include "test/test_helpers.h"
+
+#include "test/helpers/episode_numbers.h"
+#include "tv_shows/EpisodeNumberMatcher.h"
+
+#include <QElapsedTimer>
+#include <functional>
+
+using namespace mediaelch;
+
+namespace {
+
+constexpr int fixtureFileNameCount = 1000000;
+
+int classifyWithQRegExp(const QStringList& names)
+{
+    int episodes = 0;
+    for (const QString& name : names) {
+        episodes += referenceSeasonNumber(name) >= 0 ? referenceEpisodeNumbers(name).size() : 0;
+    }
+    return episodes;
+}
+
+int classifyWithMatcher(const QStringList& names)
+{
+    int episodes = 0;
+    for (const EpisodeNumberMatcher::Result& result : EpisodeNumberMatcher::instance().match(names)) {
+        episodes += result.season.toInt() >= 0 ? result.episodes.size() : 0;
+    }
+    return episodes;
+}
+
+void reportFileNamesPerSecond(const QString& name, int count, const std::function<int()>& run)
+{
+    QElapsedTimer timer;
+    timer.start();
+    run();
+    const double seconds = static_cast<double>(qMax<qint64>(timer.nsecsElapsed(), 1)) / 1e9;
+    WARN(QStringLiteral("%1: %2 file names/s")
+             .arg(name)
+             .arg(static_cast<double>(count) / seconds, 0, 'f', 0)
+             .toStdString());
+}
+
+} // namespace
+
+TEST_CASE("Episode number extraction", "[benchmark][show]")
+{
+    const QStringList names = syntheticEpisodeFileNames(fixtureFileNameCount);
+
+    const int expected = classifyWithQRegExp(names);
+    REQUIRE(classifyWithMatcher(names) == expected);
+
+    reportFileNamesPerSecond("QRegExp per call", names.size(), [&] { return classifyWithQRegExp(names); });
+    reportFileNamesPerSecond("EpisodeNumberMatcher", names.size(), [&] { return classifyWithMatcher(names); });
+
+    // One directory listing of a large show for the per-iteration measurements.
+    const QStringList listing = names.mid(0, 1000);
+
+    BENCHMARK_ADVANCED("1000 file names, QRegExp per call")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return classifyWithQRegExp(listing); });
+    };
+
+    BENCHMARK_ADVANCED("1000 file names, EpisodeNumberMatcher")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] { return classifyWithMatcher(listing); });
+    };
+}
@@ -0,0 +1,114 @@
+#include "test/helpers/episode_numbers.h"
+
+#include <QRegExp>
+
+int referenceSeasonNumber(const QString& filename)
+{
+    QRegExp rx(R"(S(\d+)[ ._-]?E)", Qt::CaseInsensitive);
+    if (rx.indexIn(filename) != -1) {
+        return rx.cap(1).toInt();
+    }
+    rx.setPattern("(\\d+)?x(\\d+)");
+    if (rx.indexIn(filename) != -1) {
+        return rx.cap(1).toInt();
+    }
+    rx.setPattern("(\\d+).(\\d){2,4}");
+    if (rx.indexIn(filename) != -1) {
+        return rx.cap(1).toInt();
+    }
+    rx.setPattern("Season[ ._]?(\\d+)[ ._]?Episode");
+    if (rx.indexIn(filename) != -1) {
+        return rx.cap(1).toInt();
+    }
+    return 0; // SeasonNumber::SpecialsSeason
+}
+
+QVector<int> referenceEpisodeNumbers(const QString& filename)
+{
+    QVector<int> episodes;
+
+    auto scanWithPattern = [&](const QString& pattern, bool mayBeAmbiguous) -> bool {
+        QRegExp rx(pattern);
+        rx.setCaseSensitivity(Qt::CaseInsensitive);
+
+        int pos = 0;
+        int lastPos = -1;
+        while ((pos = rx.indexIn(filename, pos)) != -1) {
+            if (mayBeAmbiguous && lastPos != -1 && lastPos < pos + 5) {
+                return true;
+            }
+            episodes << rx.cap(2).toInt();
+            pos += rx.matchedLength();
+            lastPos = pos;
+        }
+        pos = lastPos;
+
+        if (episodes.isEmpty()) {
+            return false;
+        }
+
+        if (episodes.count() == 1) {
+            rx.setPattern(R"(^[-_EeXx]+([0-9]+)($|[\-\._\sE]))");
+            while (rx.indexIn(filename, pos, QRegExp::CaretAtOffset) != -1) {
+                episodes << rx.cap(1).toInt();
+                pos += rx.matchedLength() - 1;
+            }
+        }
+        return true;
+    };
+
+    const QVector<QPair<QString, bool>> patterns{{R"(S(\d+)[ ._-]?E(\d+))", false},
+        {R"(S(\d+)[ ._-]?EP(\d+))", false},
+        {R"(Season[ ._-]?(\d+)[._ -]?Episode[ ._-]?(\d+))", false},
+        {R"((\d+)x(\d+))", true},
+        {R"((\d+).(\d){2,4})", true}};
+
+    for (const auto& pattern : patterns) {
+        if (scanWithPattern(pattern.first, pattern.second)) {
+            break;
+        }
+    }
+    return episodes;
+}
+
+QStringList syntheticEpisodeFileNames(int count)
+{
+    static const QStringList shows = {
+        "The.Show", "Another Show (2019)", "show_name", "Some-Show.2005", "Ünïcode Show", "24"};
+    static const QStringList suffixes = {
+        ".mkv", ".720p.HDTV.x264.mkv", " - Episode Title.avi", ".1080p.WEB-DL.mp4", "_[Group].mkv", ""};
+
+    QStringList names;
+    names.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString& show = shows[i % shows.size()];
+        const QString& suffix = suffixes[(i / 7) % suffixes.size()];
+        const int season = 1 + (i / 13) % 30;
+        const int episode = 1 + i % 120;
+        const QString paddedSeason = QStringLiteral("%1").arg(season, 2, 10, QChar('0'));
+        const QString paddedEpisode = QStringLiteral("%1").arg(episode, 2, 10, QChar('0'));
+        QString name;
+        switch (i % 11) {
+        case 0: name = QStringLiteral("%1.S%2E%3").arg(show, paddedSeason, paddedEpisode); break;
+        case 1: name = QStringLiteral("%1 s%2e%3").arg(show).arg(season).arg(episode); break;
+        case 2: name = QStringLiteral("%1.S%2E%3-E%4").arg(show).arg(season).arg(episode).arg(episode + 1); break;
+        case 3: name = QStringLiteral("%1.S%2E%3S%2E%4").arg(show).arg(season).arg(episode).arg(episode + 1); break;
+        case 4: name = QStringLiteral("%1 %2x%3").arg(show).arg(season).arg(paddedEpisode); break;
+        case 5: name = QStringLiteral("%1 - %2x%3 - Hammond vs. 6x6").arg(show).arg(season).arg(episode); break;
+        case 6: name = QStringLiteral("%1.%2%3").arg(show).arg(season).arg(paddedEpisode); break;
+        case 7: name = QStringLiteral("%1 Season %2 Episode %3").arg(show).arg(season).arg(episode); break;
+        case 8: name = QStringLiteral("%1.S%2.EP%3").arg(show).arg(season).arg(episode); break;
+        case 9:
+            name = QStringLiteral("%1.S%2E%3E%4E%5")
+                       .arg(show)
+                       .arg(season)
+                       .arg(episode)
+                       .arg(episode + 1)
+                       .arg(episode + 2);
+            break;
+        default: name = QStringLiteral("%1 - Special %2").arg(show).arg(i); break;
+        }
+        names << name + suffix;
+    }
+    return names;
+}
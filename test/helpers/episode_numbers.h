@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/// The former QRegExp based implementation of TvShowFileSearcher::getSeasonNumber()
+/// for a single file name.  Used to check EpisodeNumberMatcher for parity.
+int referenceSeasonNumber(const QString& filename);
+
+/// The former QRegExp based implementation of TvShowFileSearcher::getEpisodeNumbers()
+/// for a single file name.  Used to check EpisodeNumberMatcher for parity.
+QVector<int> referenceEpisodeNumbers(const QString& filename);
+
+/// Creates episode file names in the common naming schemes ("S01E02", "1x02",
+/// "Season 1 Episode 2", multi-episode files, resolutions, ...).
+/// The result is deterministic for a given count.
+QStringList syntheticEpisodeFileNames(int count);
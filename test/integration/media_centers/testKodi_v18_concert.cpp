@@ -6,7 +6,7 @@
 #include "media_centers/kodi/ConcertXmlWriter.h"
 #include "test/integration/resource_dir.h"
 
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -23,9 +23,8 @@ static void createAndCompareConcert(const QString& filename, Callback callback)
     QString concertContent = getFileContent(filename);
 
     mediaelch::kodi::ConcertXmlReader reader(concert);
-    QDomDocument doc;
-    doc.setContent(concertContent);
-    reader.parseNfoDom(doc);
+    QXmlStreamReader xml(concertContent);
+    reader.parseNfo(xml);
 
     callback(concert);
 
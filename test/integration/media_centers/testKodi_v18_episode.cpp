@@ -1,5 +1,6 @@
 #include "test/test_helpers.h"
 
+#include "media_centers/KodiXml.h"
 #include "media_centers/kodi/EpisodeXmlReader.h"
 #include "media_centers/kodi/EpisodeXmlWriter.h"
 #include "settings/Settings.h"
@@ -7,7 +8,7 @@
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -26,9 +27,9 @@ static void createAndCompareSingleEpisode(const QString& filename, Callback call
     QString episodeContent = getFileContent(filename);
 
     mediaelch::kodi::EpisodeXmlReader reader(episode);
-    QDomDocument doc;
-    doc.setContent(episodeContent);
-    reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+    QXmlStreamReader xml(episodeContent);
+    REQUIRE(mediaelch::kodi::readNextNfoElement(xml, QLatin1String("episodedetails")));
+    reader.parseNfo(xml);
 
     callback(episode);
 
@@ -47,16 +48,13 @@ static void createAndCompareMultiEpisode(const QString& filename, Callback callb
     QVector<TvShowEpisode*> episodesPointer;
     QString episodeContent = getFileContent(filename);
 
-    QDomDocument doc;
-    doc.setContent(episodeContent);
-    QDomNodeList detailTags = doc.elementsByTagName("episodedetails");
-
-    for (int i = 0; i < detailTags.size(); ++i) {
+    QXmlStreamReader xml(episodeContent);
+    while (mediaelch::kodi::readNextNfoElement(xml, QLatin1String("episodedetails"))) {
         episodes.push_back(std::make_unique<TvShowEpisode>());
         episodesPointer.push_back(episodes.back().get());
 
         mediaelch::kodi::EpisodeXmlReader reader(*episodesPointer.last());
-        reader.parseNfoDom(detailTags.at(i).toElement());
+        reader.parseNfo(xml);
     }
 
     callback(episodesPointer);
@@ -109,9 +107,9 @@ TEST_CASE("Episode XML writer for Kodi v18", "[data][tvshow][kodi][nfo]")
 
         EpisodeXmlReader reader(episode);
 
-        QDomDocument doc;
-        doc.setContent(episodeContent);
-        reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+        QXmlStreamReader xml(episodeContent);
+        REQUIRE(mediaelch::kodi::readNextNfoElement(xml, QLatin1String("episodedetails")));
+        reader.parseNfo(xml);
 
         mediaelch::kodi::EpisodeXmlWriterGeneric writer(mediaelch::KodiVersion(18), {&episode});
         QString actual = writer.getEpisodeXmlWithSingleRoot(true).trimmed();
@@ -150,4 +148,79 @@ TEST_CASE("Episode XML writer for Kodi v18", "[data][tvshow][kodi][nfo]")
             }
         });
     }
+
+    SECTION("find episode details of multi-episode")
+    {
+        using mediaelch::kodi::EpisodeXmlReader;
+
+        QString filename = "show/kodi_v18_episode_American_Dad_S02E03-S02E04.nfo";
+        CAPTURE(filename);
+        QString episodeContent = getFileContent(filename);
+
+        CHECK(EpisodeXmlReader::episodeDetailsIndex(episodeContent, SeasonNumber(2), EpisodeNumber(4)) == 0);
+        CHECK(EpisodeXmlReader::episodeDetailsIndex(episodeContent, SeasonNumber(2), EpisodeNumber(3)) == 1);
+        CHECK(EpisodeXmlReader::episodeDetailsIndex(episodeContent, SeasonNumber(2), EpisodeNumber(5)) == -1);
+
+        QString singleContent = getFileContent("show/kodi_v18_episode_American_Dad_S02E01.nfo");
+        CHECK(EpisodeXmlReader::episodeDetailsIndex(singleContent, SeasonNumber(9), EpisodeNumber(9)) == 0);
+    }
+
+    SECTION("load multi-episode with KodiXml")
+    {
+        QString content = getFileContent("show/kodi_v18_episode_American_Dad_S02E03-S02E04.nfo");
+        KodiXml kodi;
+
+        TvShowEpisode episode;
+        episode.setSeason(SeasonNumber(2));
+        episode.setEpisode(EpisodeNumber(3));
+        REQUIRE(kodi.loadTvShowEpisode(&episode, content));
+        CHECK(episode.title() == "All About Steve");
+
+        TvShowEpisode unknownEpisode;
+        unknownEpisode.setSeason(SeasonNumber(2));
+        unknownEpisode.setEpisode(EpisodeNumber(5));
+        CHECK_FALSE(kodi.loadTvShowEpisode(&unknownEpisode, content));
+    }
+
+    SECTION("malformed NFOs are not read at all")
+    {
+        QString content = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes" ?>
+<episodedetails>
+  <title>Malformed</title>
+  <plot>Unclosed tag
+</episodedetails>
+)";
+        KodiXml kodi;
+        TvShowEpisode episode;
+        episode.setSeason(SeasonNumber(1));
+        episode.setEpisode(EpisodeNumber(2));
+        CHECK_FALSE(kodi.loadTvShowEpisode(&episode, content));
+        CHECK(episode.title().isEmpty());
+        CHECK(episode.overview().isEmpty());
+        CHECK(episode.seasonNumber() == SeasonNumber(1));
+    }
+
+    SECTION("first actor thumb is used as episode thumbnail if it comes first")
+    {
+        QString content = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes" ?>
+<episodedetails>
+  <title>Actor Thumb</title>
+  <actor>
+    <name>First Actor</name>
+    <thumb>http://example.com/actor.jpg</thumb>
+  </actor>
+  <thumb>http://example.com/episode.jpg</thumb>
+</episodedetails>
+)";
+        KodiXml kodi;
+        TvShowEpisode episode;
+        REQUIRE(kodi.loadTvShowEpisode(&episode, content));
+        CHECK(episode.thumbnail() == QUrl("http://example.com/actor.jpg"));
+        REQUIRE(episode.actors().size() == 1);
+        CHECK(episode.actors().first()->thumb == "http://example.com/actor.jpg");
+
+        QString episodeThumbFirst = getFileContent("show/kodi_v18_episode_American_Dad_S02E01.nfo");
+        REQUIRE(kodi.loadTvShowEpisode(&episode, episodeThumbFirst));
+        CHECK(episode.thumbnail() == QUrl("http://www.thetvdb.com/banners/episodes/73141/306168.jpg"));
+    }
 }
@@ -6,7 +6,7 @@
 #include "test/integration/resource_dir.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -23,9 +23,8 @@ static void createAndCompareArtist(const QString& filename, Callback callback)
     QString artistContent = getFileContent(filename);
 
     mediaelch::kodi::ArtistXmlReader reader(artist);
-    QDomDocument doc;
-    doc.setContent(artistContent);
-    reader.parseNfoDom(doc);
+    QXmlStreamReader xml(artistContent);
+    reader.parseNfo(xml);
 
     callback(artist);
 
@@ -6,7 +6,7 @@
 #include "tv_shows/TvShow.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -23,9 +23,8 @@ static void createAndCompareTvShow(const QString& filename, Callback callback)
     QString showContent = getFileContent(filename);
 
     mediaelch::kodi::TvShowXmlReader reader(show);
-    QDomDocument doc;
-    doc.setContent(showContent);
-    reader.parseNfoDom(doc);
+    QXmlStreamReader xml(showContent);
+    reader.parseNfo(xml);
 
     callback(show);
 
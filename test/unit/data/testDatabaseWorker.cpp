@@ -0,0 +1,92 @@
+#include "test/test_helpers.h"
+
+#include "data/DatabaseWorker.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+int rowCount(const QString& connectionName)
+{
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    query.exec("SELECT COUNT(*) FROM numbers");
+    return query.next() ? query.value(0).toInt() : -1;
+}
+
+} // namespace
+
+TEST_CASE("DatabaseWorker", "[data][database]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString databaseFile = tempDir.filePath("test.sqlite");
+    const QString connectionName = "testDatabaseWorker";
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(databaseFile);
+        REQUIRE(db.open());
+        DatabaseWorker::configureConnection(db);
+        QSqlQuery query(db);
+        REQUIRE(query.exec("CREATE TABLE numbers(id integer PRIMARY KEY AUTOINCREMENT, value integer, name text)"));
+    }
+
+    SECTION("executes requests in order and calls done callbacks")
+    {
+        DatabaseWorker worker(databaseFile);
+        QVector<int> order;
+        for (int i = 0; i < 10; ++i) {
+            worker.enqueue(
+                [i](PreparedStatements& statements) {
+                    QSqlQuery& query = statements.query("INSERT INTO numbers(value, name) VALUES(:value, :name)");
+                    query.bindValue(":value", i);
+                    query.bindValue(":name", QString::number(i));
+                    query.exec();
+                },
+                [i, &order]() { order << i; });
+        }
+        worker.waitForDone();
+
+        CHECK(worker.pendingRequests() == 0);
+        CHECK(order == QVector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        CHECK(rowCount(connectionName) == 10);
+    }
+
+    SECTION("batch inserts rows in chunks")
+    {
+        DatabaseWorker worker(databaseFile);
+        int statementCount = 0;
+        // 3 columns -> 100 rows per statement; 50 rows are inserted one by one
+        QVector<QVariantList> rows;
+        for (int i = 0; i < 250; ++i) {
+            rows << QVariantList{i, i, QString::number(i)};
+        }
+        worker.enqueue([&](PreparedStatements& statements) {
+            statements.insertRows("numbers", {"id", "value", "name"}, rows);
+            // The same statements are reused for the second call.
+            statements.insertRows("numbers", {"id", "value", "name"}, {{1000, 1, "x"}});
+            statementCount = statements.count();
+        });
+        worker.waitForDone();
+
+        CHECK(statementCount == 2);
+        CHECK(rowCount(connectionName) == 251);
+    }
+
+    SECTION("destructor executes pending requests")
+    {
+        {
+            DatabaseWorker worker(databaseFile);
+            worker.enqueue([](PreparedStatements& statements) {
+                statements.insertRows("numbers", {"value", "name"}, {{1, "a"}, {2, "b"}});
+            });
+        }
+        CHECK(rowCount(connectionName) == 2);
+    }
+
+    QSqlDatabase::removeDatabase(connectionName);
+}
@@ -0,0 +1,232 @@
+#include "test/test_helpers.h"
+
+#include "data/ImageCache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+// Format of thumbnails.index, see ImageCache.cpp
+constexpr quint32 INDEX_MAGIC = 0x4d45494d;
+constexpr quint8 INDEX_RECORD_THUMBNAIL = 1;
+constexpr quint8 INDEX_RECORD_REMOVE = 2;
+
+struct IndexRecord
+{
+    quint8 type = 0;
+    QString md5;
+    qint32 width = 0;
+    qint32 height = 0;
+    qint32 origWidth = 0;
+    qint32 origHeight = 0;
+    quint32 lastModified = 0;
+};
+
+QString md5Of(const QString& imagePath)
+{
+    return QCryptographicHash::hash(FilePath(imagePath).toString().toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+quint32 lastModifiedOf(const QString& imagePath)
+{
+    return QFileInfo(imagePath).lastModified().toTime_t();
+}
+
+/// Creates a small image whose real size differs from the sizes stored in the index,
+/// so that imageSize() tells whether the index was used.
+QString createImage(const QTemporaryDir& dir, const QString& name)
+{
+    const QString path = dir.filePath(name);
+    QImage image(10, 10, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    REQUIRE(image.save(path, "png"));
+    return path;
+}
+
+IndexRecord thumbnailRecord(const QString& imagePath, qint32 origWidth, qint32 origHeight)
+{
+    IndexRecord record;
+    record.type = INDEX_RECORD_THUMBNAIL;
+    record.md5 = md5Of(imagePath);
+    record.width = 100;
+    record.height = 0;
+    record.origWidth = origWidth;
+    record.origHeight = origHeight;
+    record.lastModified = lastModifiedOf(imagePath);
+    return record;
+}
+
+IndexRecord removalRecord(const QString& imagePath)
+{
+    IndexRecord record;
+    record.type = INDEX_RECORD_REMOVE;
+    record.md5 = md5Of(imagePath);
+    return record;
+}
+
+void writeRecord(QDataStream& out, const IndexRecord& record)
+{
+    out << record.type << record.md5;
+    if (record.type == INDEX_RECORD_THUMBNAIL) {
+        out << record.width << record.height << record.origWidth << record.origHeight << record.lastModified;
+    }
+}
+
+void writeIndex(const QString& cacheDir, const QVector<IndexRecord>& records, const QByteArray& trailingBytes = {})
+{
+    QFile file(cacheDir + "/thumbnails.index");
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    QDataStream out(&file);
+    out << INDEX_MAGIC;
+    for (const IndexRecord& record : records) {
+        writeRecord(out, record);
+    }
+    file.write(trailingBytes);
+}
+
+QVector<IndexRecord> readIndex(const QString& cacheDir)
+{
+    QFile file(cacheDir + "/thumbnails.index");
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    QDataStream in(&file);
+    quint32 magic = 0;
+    in >> magic;
+    REQUIRE(magic == INDEX_MAGIC);
+
+    QVector<IndexRecord> records;
+    while (!in.atEnd()) {
+        IndexRecord record;
+        in >> record.type >> record.md5;
+        if (record.type == INDEX_RECORD_THUMBNAIL) {
+            in >> record.width >> record.height >> record.origWidth >> record.origHeight >> record.lastModified;
+        }
+        REQUIRE(in.status() == QDataStream::Ok);
+        records << record;
+    }
+    return records;
+}
+
+} // namespace
+
+TEST_CASE("ImageCache index journal", "[data][image_cache]")
+{
+    QTemporaryDir imageDir;
+    QTemporaryDir cacheDir;
+    REQUIRE(imageDir.isValid());
+    REQUIRE(cacheDir.isValid());
+
+    const QString poster = createImage(imageDir, "poster.png");
+    const QString fanart = createImage(imageDir, "fanart.png");
+    const QString banner = createImage(imageDir, "banner.png");
+
+    SECTION("replays thumbnail and removal records")
+    {
+        writeIndex(cacheDir.path(),
+            {thumbnailRecord(poster, 1000, 1500),
+                thumbnailRecord(fanart, 1920, 1080),
+                removalRecord(poster),
+                thumbnailRecord(banner, 758, 140),
+                // Later records for the same thumbnail replace earlier ones.
+                thumbnailRecord(banner, 1000, 185)});
+
+        ImageCache cache(DirectoryPath(cacheDir.path()));
+        CHECK(cache.imageSize(FilePath(poster)) == QSize(10, 10));
+        CHECK(cache.imageSize(FilePath(fanart)) == QSize(1920, 1080));
+        CHECK(cache.imageSize(FilePath(banner)) == QSize(1000, 185));
+    }
+
+    SECTION("ignores a truncated last record")
+    {
+        QByteArray truncated;
+        {
+            QDataStream out(&truncated, QIODevice::WriteOnly);
+            out << INDEX_RECORD_THUMBNAIL << md5Of(banner) << qint32(100);
+        }
+        writeIndex(cacheDir.path(), {thumbnailRecord(fanart, 1920, 1080)}, truncated);
+
+        {
+            ImageCache cache(DirectoryPath(cacheDir.path()));
+            CHECK(cache.imageSize(FilePath(fanart)) == QSize(1920, 1080));
+            CHECK(cache.imageSize(FilePath(banner)) == QSize(10, 10));
+            // Is appended to the journal and must be readable after a restart.
+            int origWidth = 0;
+            int origHeight = 0;
+            CHECK_FALSE(cache.image(FilePath(poster), 5, 0, origWidth, origHeight).isNull());
+        }
+
+        const QVector<IndexRecord> records = readIndex(cacheDir.path());
+        REQUIRE(records.size() == 2);
+        CHECK(records[0].md5 == md5Of(fanart));
+        CHECK(records[1].md5 == md5Of(poster));
+        CHECK(records[1].width == 5);
+        CHECK(records[1].origWidth == 10);
+    }
+
+    SECTION("ignores records after a corrupt record")
+    {
+        writeIndex(cacheDir.path(), {thumbnailRecord(fanart, 1920, 1080)}, QByteArray("\x7f garbage", 9));
+
+        {
+            ImageCache cache(DirectoryPath(cacheDir.path()));
+            CHECK(cache.imageSize(FilePath(fanart)) == QSize(1920, 1080));
+        }
+
+        const QVector<IndexRecord> records = readIndex(cacheDir.path());
+        REQUIRE(records.size() == 1);
+        CHECK(records[0].md5 == md5Of(fanart));
+    }
+
+    SECTION("compaction keeps live thumbnails and drops removed ones")
+    {
+        QVector<IndexRecord> records;
+        records << thumbnailRecord(poster, 1000, 1500);
+        // Enough superseded and removed records to trigger a compaction
+        for (int i = 0; i < 600; ++i) {
+            records << thumbnailRecord(fanart, 1920 + i, 1080);
+            records << thumbnailRecord(banner, 758, 140 + i);
+            records << removalRecord(banner);
+        }
+
+        writeIndex(cacheDir.path(), records);
+        {
+            ImageCache cache(DirectoryPath(cacheDir.path()));
+            CHECK(cache.imageSize(FilePath(poster)) == QSize(1000, 1500));
+            CHECK(cache.imageSize(FilePath(fanart)) == QSize(1920 + 599, 1080));
+            CHECK(cache.imageSize(FilePath(banner)) == QSize(10, 10));
+        }
+
+        const QVector<IndexRecord> compacted = readIndex(cacheDir.path());
+        REQUIRE(compacted.size() == 2);
+        QStringList hashes;
+        for (const IndexRecord& record : compacted) {
+            CHECK(record.type == INDEX_RECORD_THUMBNAIL);
+            hashes << record.md5;
+            if (record.md5 == md5Of(fanart)) {
+                CHECK(record.origWidth == 1920 + 599);
+            }
+        }
+        hashes.sort();
+        QStringList expected{md5Of(poster), md5Of(fanart)};
+        expected.sort();
+        CHECK(hashes == expected);
+    }
+
+    SECTION("small journals are not compacted")
+    {
+        writeIndex(cacheDir.path(), {thumbnailRecord(poster, 1000, 1500), removalRecord(poster)});
+        {
+            ImageCache cache(DirectoryPath(cacheDir.path()));
+            CHECK(cache.imageSize(FilePath(poster)) == QSize(10, 10));
+        }
+        CHECK(readIndex(cacheDir.path()).size() == 2);
+    }
+}
@@ -0,0 +1,296 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "globals/Filter.h"
+#include "globals/Manager.h"
+#include "movies/MovieModel.h"
+#include "movies/MovieProxyModel.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+#include "tv_shows/TvShowFileSearcher.h"
+
+#include <QCoreApplication>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+#include <utility>
+
+using namespace mediaelch;
+
+namespace {
+
+const char* const movieNfo = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes" ?>
+<movie>
+  <title>Lazy Movie</title>
+  <sorttitle>Movie, Lazy</sorttitle>
+  <plot>Only stored in the NFO contents.</plot>
+  <genre>Drama</genre>
+  <premiered>2001-02-03</premiered>
+  <playcount>2</playcount>
+  <uniqueid type="imdb" default="true">tt0111161</uniqueid>
+  <trailer>https://example.com/trailer.mp4</trailer>
+  <actor>
+    <name>Some Actor</name>
+  </actor>
+</movie>
+)";
+
+const char* const episodeNfo = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes" ?>
+<episodedetails>
+  <title>Lazy Episode</title>
+  <season>1</season>
+  <episode>2</episode>
+  <plot>Only stored in the NFO contents.</plot>
+  <director>Some Director</director>
+  <aired>2001-02-03</aired>
+  <playcount>3</playcount>
+</episodedetails>
+)";
+
+/// \brief Writes a movie that was loaded from movieNfo to the cache.
+void addCachedMovie(Database& database, const DirectoryPath& dir)
+{
+    Movie movie(QStringList{dir.filePath("Lazy Movie.mkv")});
+    movie.setNfoContent(movieNfo);
+    REQUIRE(movie.controller()->loadData(Manager::instance()->mediaCenterInterface(), true, false));
+    database.add(&movie, dir);
+}
+
+/// \brief Removes the summary of all movies in dir like in caches of version 18 and older.
+void removeMovieSummaries(Database& database, const DirectoryPath& dir)
+{
+    QSqlQuery query(database.db());
+    query.prepare("UPDATE movies SET title='', sortTitle='', released='', playcount=0, infoLoaded=-1 "
+                  "WHERE path=:path");
+    query.bindValue(":path", dir.toString().toUtf8());
+    REQUIRE(query.exec());
+}
+
+/// \brief Deletes the movies and their cache entries once the test is done.
+struct CachedMovies
+{
+    CachedMovies(Database& db, DirectoryPath dir) : database{db}, path{std::move(dir)} {}
+    ~CachedMovies()
+    {
+        qDeleteAll(movies);
+        database.clearMoviesInDirectory(path);
+    }
+
+    QVector<Movie*> load(bool summaryOnly)
+    {
+        QVector<Movie*> loaded = database.moviesInDirectory(path, summaryOnly);
+        movies << loaded;
+        return loaded;
+    }
+
+    Database& database;
+    DirectoryPath path;
+    QVector<Movie*> movies;
+};
+
+} // namespace
+
+TEST_CASE("Lazy movie loading", "[data][database]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const DirectoryPath dir(tempDir.path());
+    Database& database = *Manager::instance()->database();
+
+    CachedMovies cache(database, dir);
+    addCachedMovie(database, dir);
+
+    SECTION("summary-only movies get all details from loadDetails()")
+    {
+        const QVector<Movie*> movies = cache.load(true);
+        REQUIRE(movies.size() == 1);
+        Movie* movie = movies.first();
+
+        CHECK(movie->controller()->detailsPending());
+        CHECK(movie->controller()->infoLoaded());
+        CHECK(movie->name() == "Lazy Movie");
+        CHECK(movie->sortTitle() == "Movie, Lazy");
+        CHECK(movie->released() == QDate(2001, 2, 3));
+        CHECK(movie->playcount() == 2);
+        CHECK(movie->overview().isEmpty());
+        CHECK(movie->genres().isEmpty());
+
+        movie->controller()->loadDetails();
+
+        CHECK_FALSE(movie->controller()->detailsPending());
+        CHECK(movie->controller()->infoLoaded());
+        CHECK_FALSE(movie->hasChanged());
+        CHECK(movie->name() == "Lazy Movie");
+        CHECK(movie->overview() == "Only stored in the NFO contents.");
+        CHECK(movie->genres() == QStringList{"Drama"});
+    }
+
+    SECTION("released details are loaded again")
+    {
+        const QVector<Movie*> movies = cache.load(true);
+        REQUIRE(movies.size() == 1);
+        Movie* movie = movies.first();
+        movie->controller()->loadDetails();
+        REQUIRE(movie->genres() == QStringList{"Drama"});
+
+        movie->controller()->releaseDetails();
+        CHECK(movie->controller()->detailsPending());
+        CHECK(movie->controller()->detailsSummary().hasActors);
+        CHECK_FALSE(movie->hasChanged());
+        CHECK(movie->name() == "Lazy Movie");
+        CHECK(movie->playcount() == 2);
+        CHECK(movie->genres().isEmpty());
+        CHECK(movie->nfoContent().isEmpty());
+
+        movie->controller()->loadDetails();
+        CHECK(movie->genres() == QStringList{"Drama"});
+        CHECK(movie->overview() == "Only stored in the NFO contents.");
+    }
+
+    SECTION("status columns of the movie list don't load details")
+    {
+        const QVector<Movie*> movies = cache.load(true);
+        REQUIRE(movies.size() == 1);
+        Movie* movie = movies.first();
+        cache.movies.removeOne(movie);
+        MovieModel* model = Manager::instance()->movieModel();
+        model->addMovie(movie);
+        const int row = model->movies().indexOf(movie);
+        REQUIRE(row >= 0);
+
+        const MovieController::DetailsSummary details = movie->controller()->detailsSummary();
+        CHECK(details.hasActors);
+        CHECK(details.hasTrailer);
+        CHECK(details.hasImdbId);
+        CHECK_FALSE(details.streamDetailsLoaded);
+
+        for (MediaStatusColumn column : {MediaStatusColumn::Actors,
+                 MediaStatusColumn::Trailer,
+                 MediaStatusColumn::StreamDetails,
+                 MediaStatusColumn::Id}) {
+            const QModelIndex index = model->index(row, MovieModel::mediaStatusToColumn(column));
+            CHECK_FALSE(model->data(index, Qt::DecorationRole).isNull());
+        }
+        CHECK(movie->controller()->detailsPending());
+        CHECK(movie->actors().isEmpty());
+
+        model->removeMovie(movie);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    SECTION("movies of caches without summaries are parsed and get a summary")
+    {
+        removeMovieSummaries(database, dir);
+
+        QVector<Movie*> movies = cache.load(true);
+        REQUIRE(movies.size() == 1);
+        CHECK_FALSE(movies.first()->controller()->detailsPending());
+
+        MovieFileSearcher::loadCachedMovieData(movies, true);
+        CHECK(movies.first()->controller()->infoLoaded());
+        CHECK(movies.first()->overview() == "Only stored in the NFO contents.");
+        database.waitForPendingWrites();
+
+        movies = cache.load(true);
+        REQUIRE(movies.size() == 1);
+        CHECK(movies.first()->controller()->detailsPending());
+        CHECK(movies.first()->name() == "Lazy Movie");
+        CHECK(movies.first()->playcount() == 2);
+    }
+
+    SECTION("filters on details load pending details")
+    {
+        const QVector<Movie*> movies = cache.load(true);
+        REQUIRE(movies.size() == 1);
+        Movie* movie = movies.first();
+        cache.movies.removeOne(movie);
+        MovieModel* model = Manager::instance()->movieModel();
+        model->addMovie(movie);
+
+        MovieProxyModel proxy;
+        proxy.setSourceModel(model);
+
+        Filter titleFilter("Title: Lazy", "Lazy", {}, MovieFilters::Title, true);
+        proxy.setFilter({&titleFilter}, "Lazy");
+        CHECK(movie->controller()->detailsPending());
+
+        Filter genreFilter("Genre: Drama", "Drama", {"Genre", "Drama"}, MovieFilters::Genres, true);
+        proxy.setFilter({&genreFilter}, "Drama");
+        CHECK_FALSE(movie->controller()->detailsPending());
+        CHECK(movie->genres() == QStringList{"Drama"});
+
+        proxy.setFilter({}, "");
+        model->removeMovie(movie);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+}
+
+TEST_CASE("Lazy episode loading", "[data][database]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const DirectoryPath dir(tempDir.path());
+    Database& database = *Manager::instance()->database();
+
+    TvShow show(DirectoryPath(tempDir.filePath("Lazy Show")));
+    database.add(&show, dir);
+    {
+        TvShowEpisode episode(QStringList{tempDir.filePath("Lazy Show/S01E02.mkv")});
+        episode.setSeason(SeasonNumber(1));
+        episode.setEpisode(EpisodeNumber(2));
+        episode.setNfoContent(episodeNfo);
+        REQUIRE(episode.loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false, true));
+        database.add(&episode, dir, show.databaseId());
+    }
+
+    QVector<TvShowEpisode*> episodes;
+    const auto loadEpisodes = [&](bool summaryOnly) {
+        qDeleteAll(episodes);
+        episodes = database.episodes(show.databaseId(), summaryOnly);
+        REQUIRE(episodes.size() == 1);
+        return episodes.first();
+    };
+
+    SECTION("summary-only episodes get all details from loadDetails()")
+    {
+        TvShowEpisode* episode = loadEpisodes(true);
+        CHECK(episode->detailsPending());
+        CHECK(episode->infoLoaded());
+        CHECK(episode->title() == "Lazy Episode");
+        CHECK(episode->firstAired() == QDate(2001, 2, 3));
+        CHECK(episode->playCount() == 3);
+        CHECK(episode->overview().isEmpty());
+
+        episode->loadDetails();
+
+        CHECK_FALSE(episode->detailsPending());
+        CHECK(episode->infoLoaded());
+        CHECK_FALSE(episode->hasChanged());
+        CHECK(episode->overview() == "Only stored in the NFO contents.");
+        CHECK(episode->directors() == QStringList{"Some Director"});
+    }
+
+    SECTION("episodes of caches without summaries are parsed and get a summary")
+    {
+        QSqlQuery query(database.db());
+        query.prepare("UPDATE episodes SET title='', firstAired='', playcount=0, infoLoaded=-1 WHERE idShow=:idShow");
+        query.bindValue(":idShow", show.databaseId());
+        REQUIRE(query.exec());
+
+        TvShowEpisode* episode = loadEpisodes(true);
+        CHECK_FALSE(episode->detailsPending());
+
+        TvShowFileSearcher::loadCachedEpisodeData(episodes, true);
+        CHECK(episode->overview() == "Only stored in the NFO contents.");
+        database.waitForPendingWrites();
+
+        episode = loadEpisodes(true);
+        CHECK(episode->detailsPending());
+        CHECK(episode->title() == "Lazy Episode");
+        CHECK(episode->playCount() == 3);
+    }
+
+    qDeleteAll(episodes);
+    database.clearTvShowsInDirectory(dir);
+}
@@ -0,0 +1,164 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "data/MediaInfoProbe.h"
+#include "data/MediaInfoProbeQueue.h"
+#include "movies/Movie.h"
+
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <chrono>
+
+using namespace mediaelch;
+
+namespace {
+
+void writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(content);
+}
+
+StreamDetails::Details exampleDetails()
+{
+    using VideoDetails = StreamDetails::VideoDetails;
+    using AudioDetails = StreamDetails::AudioDetails;
+    using SubtitleDetails = StreamDetails::SubtitleDetails;
+
+    StreamDetails::Details details;
+    details.video = {{VideoDetails::DurationInSeconds, "5400"},
+        {VideoDetails::Codec, "h264"},
+        {VideoDetails::Width, "1920"},
+        {VideoDetails::Height, "1080"}};
+    details.audio = {{{AudioDetails::Language, "eng"}, {AudioDetails::Codec, "ac3"}, {AudioDetails::Channels, "6"}},
+        {{AudioDetails::Language, "ger"}, {AudioDetails::Codec, "dts"}, {AudioDetails::Channels, "2"}}};
+    details.subtitles = {{{SubtitleDetails::Language, "eng"}}};
+    return details;
+}
+
+} // namespace
+
+TEST_CASE("MediaInfoProbe", "[data][streamdetails]")
+{
+    SECTION("stream details survive a JSON roundtrip")
+    {
+        const StreamDetails::Details details = exampleDetails();
+        const StreamDetails::Details actual = streamDetailsFromJson(streamDetailsToJson(details));
+        CHECK(actual.video == details.video);
+        CHECK(actual.audio == details.audio);
+        CHECK(actual.subtitles == details.subtitles);
+    }
+
+    SECTION("invalid JSON results in empty details")
+    {
+        const StreamDetails::Details actual = streamDetailsFromJson("not json");
+        CHECK(actual.video.isEmpty());
+        CHECK(actual.audio.isEmpty());
+        CHECK(actual.subtitles.isEmpty());
+    }
+
+    SECTION("identity of stacked files")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        writeFile(dir.filePath("movie-cd1.mkv"), "12345");
+        writeFile(dir.filePath("movie-cd2.mkv"), "123");
+
+        const FileList files({FilePath(dir.filePath("movie-cd1.mkv")), FilePath(dir.filePath("movie-cd2.mkv"))});
+        const MediaFileIdentity identity = MediaFileIdentity::of(files);
+        CHECK(identity.isValid());
+        CHECK(identity.size == 8);
+        CHECK(identity.path == MediaFileIdentity::pathOf(files));
+        CHECK(identity == MediaFileIdentity::of(files));
+
+        writeFile(dir.filePath("movie-cd2.mkv"), "1234");
+        CHECK(identity != MediaFileIdentity::of(files));
+    }
+
+    SECTION("identity of missing files is invalid")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const FileList files({FilePath(dir.filePath("missing.mkv"))});
+        CHECK_FALSE(MediaFileIdentity::of(files).isValid());
+    }
+
+    SECTION("probes are cached in the database")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+
+        MediaInfoProbe probe;
+        probe.identity.path = "/movies/movie.mkv";
+        probe.identity.size = 42;
+        probe.identity.lastModified = 1000;
+        probe.details = exampleDetails();
+
+        {
+            Database database(dir.filePath("cache.sqlite"), "testMediaInfoProbe");
+            database.setMediaInfoProbeAsync(probe);
+            probe.identity.size = 43;
+            database.setMediaInfoProbeAsync(probe);
+        }
+
+        Database database(dir.filePath("cache.sqlite"), "testMediaInfoProbe");
+        const QHash<QString, MediaInfoProbe> probes =
+            database.mediaInfoProbes({"/movies/movie.mkv", "/movies/other.mkv"});
+        REQUIRE(probes.size() == 1);
+        const MediaInfoProbe actual = probes.value("/movies/movie.mkv");
+        CHECK(actual.identity == probe.identity);
+        CHECK(actual.details.video == probe.details.video);
+        CHECK(actual.details.audio == probe.details.audio);
+    }
+
+    SECTION("queued movies get stream details and runtime of cached probes")
+    {
+        using namespace std::chrono_literals;
+
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        writeFile(dir.filePath("movie.mkv"), "12345");
+        const QStringList files{dir.filePath("movie.mkv")};
+
+        Database database(dir.filePath("cache.sqlite"), "testMediaInfoProbeQueue");
+        MediaInfoProbe probe;
+        probe.identity = MediaFileIdentity::of(FileList(files));
+        probe.details = exampleDetails();
+        database.setMediaInfoProbeAsync(probe);
+        database.waitForPendingWrites();
+
+        MediaInfoProbeQueue queue(database);
+        Movie movie(files);
+        queue.enqueueMovies({&movie});
+        CHECK(queue.pendingCount() == 1);
+
+        QEventLoop loop;
+        QObject::connect(&queue, &MediaInfoProbeQueue::sigFinished, &loop, &QEventLoop::quit);
+        QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+        loop.exec();
+
+        CHECK(queue.pendingCount() == 0);
+        CHECK(movie.streamDetailsLoaded());
+        CHECK(movie.runtime() == 90min);
+        CHECK_FALSE(movie.hasChanged());
+    }
+
+    SECTION("destroyed movies are no longer queued")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        writeFile(dir.filePath("movie.mkv"), "12345");
+
+        Database database(dir.filePath("cache.sqlite"), "testMediaInfoProbeQueue");
+        MediaInfoProbeQueue queue(database);
+        auto* movie = new Movie({dir.filePath("movie.mkv")});
+        queue.enqueueMovies({movie});
+        CHECK(queue.pendingCount() == 1);
+
+        delete movie;
+        CHECK(queue.pendingCount() == 0);
+    }
+}
@@ -0,0 +1,102 @@
+#include "test/test_helpers.h"
+
+#include "export/CompiledTemplate.h"
+
+using namespace mediaelch;
+
+namespace {
+
+/// \brief Context with a TAGS block and a poster image for testing.
+class TestContext : public ValueTemplateContext
+{
+public:
+    QStringList tags;
+
+    bool appendBlock(const QString& name, const CompiledTemplate& item, QString& out) const override
+    {
+        if (name != "TAGS") {
+            return false;
+        }
+        for (int i = 0; i < tags.size(); ++i) {
+            ValueTemplateContext tag(this);
+            tag.insert("TAG.NAME", tags.at(i));
+            if (i > 0) {
+                out += ' ';
+            }
+            item.render(tag, out);
+        }
+        return true;
+    }
+
+    bool appendImage(const QString& type, QSize size, QString& out) const override
+    {
+        if (type != "poster") {
+            return false;
+        }
+        out += QStringLiteral("%1_%2x%3.jpg").arg(type).arg(size.width()).arg(size.height());
+        return true;
+    }
+};
+
+} // namespace
+
+TEST_CASE("CompiledTemplate", "[export]")
+{
+    TestContext context;
+    context.insert("MOVIE.TITLE", "Alien");
+    context.insert("MOVIE.YEAR", "1979");
+
+    SECTION("replaces variables")
+    {
+        CompiledTemplate tpl("<h1>{{ MOVIE.TITLE }} ({{ MOVIE.YEAR }})</h1>");
+        CHECK(tpl.render(context) == "<h1>Alien (1979)</h1>");
+    }
+
+    SECTION("keeps unknown placeholders and plain text")
+    {
+        CompiledTemplate tpl("{{ MOVIE.UNKNOWN }} {{MOVIE.TITLE}} {{ a {{ MOVIE.TITLE }}");
+        CHECK(tpl.render(context) == "{{ MOVIE.UNKNOWN }} {{MOVIE.TITLE}} {{ a Alien");
+    }
+
+    SECTION("renders blocks with the parent's variables")
+    {
+        context.tags = QStringList{"Horror", "SciFi"};
+        CompiledTemplate tpl("<ul>{{ BEGIN_BLOCK_TAGS }}\n  <li>{{ TAG.NAME }} - {{ MOVIE.TITLE }}</li>\n"
+                             "{{ END_BLOCK_TAGS }}</ul>");
+        CHECK(tpl.render(context) == "<ul><li>Horror - Alien</li> <li>SciFi - Alien</li></ul>");
+    }
+
+    SECTION("keeps unknown blocks")
+    {
+        CompiledTemplate tpl("{{ BEGIN_BLOCK_OTHER }}{{ MOVIE.TITLE }}{{ END_BLOCK_OTHER }}");
+        CHECK(tpl.render(context) == "{{ BEGIN_BLOCK_OTHER }}Alien{{ END_BLOCK_OTHER }}");
+    }
+
+    SECTION("block without end is plain text")
+    {
+        CompiledTemplate tpl("{{ BEGIN_BLOCK_TAGS }}{{ MOVIE.TITLE }}");
+        CHECK(tpl.render(context) == "{{ BEGIN_BLOCK_TAGS }}Alien");
+    }
+
+    SECTION("finds nested blocks")
+    {
+        CompiledTemplate tpl("{{ BEGIN_BLOCK_SEASON }}S{{ BEGIN_BLOCK_EPISODE }} E {{ END_BLOCK_EPISODE }}"
+                             "{{ END_BLOCK_SEASON }}");
+        REQUIRE(tpl.block("EPISODE") != nullptr);
+        CHECK(tpl.block("EPISODE")->render(context) == "E");
+        CHECK(tpl.block("MOVIE") == nullptr);
+    }
+
+    SECTION("replaces images")
+    {
+        CompiledTemplate tpl("{{ IMAGE.Poster[200, 300] }} {{ IMAGE.logo[10,10] }} {{ IMAGE.poster[0,0] }}");
+        CHECK(tpl.render(context) == "poster_200x300.jpg {{ IMAGE.logo[10,10] }} {{ IMAGE.poster[0,0] }}");
+    }
+
+    SECTION("lists image types of nested blocks")
+    {
+        CompiledTemplate tpl("{{ IMAGE.Poster[200, 300] }}{{ BEGIN_BLOCK_EPISODE }}{{ IMAGE.thumbnail[10,10] }}"
+                             "{{ END_BLOCK_EPISODE }}{{ IMAGE.logo[0,0] }}");
+        CHECK(tpl.imageTypes() == QSet<QString>{"poster", "thumbnail"});
+    }
+}
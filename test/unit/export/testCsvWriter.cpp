@@ -0,0 +1,58 @@
+#include "test/test_helpers.h"
+
+#include "export/CsvExport.h"
+
+#include <QTextStream>
+
+using namespace mediaelch;
+
+TEST_CASE("CsvWriter", "[export][csv]")
+{
+    QString out;
+    QTextStream stream(&out);
+    CsvWriter csv(stream);
+    csv.setSeparator(";");
+    csv.setReplacement(",");
+
+    SECTION("writes header and rows")
+    {
+        csv.writeHeader({"title", "year"});
+        csv.addCell("Alien");
+        csv.addCell("1979");
+        csv.endRow();
+        stream.flush();
+
+        CHECK(out == "title;year\nAlien;1979\n");
+        CHECK(csv.rowCount() == 2);
+    }
+
+    SECTION("escapes separators and line breaks")
+    {
+        csv.addCell("a;b");
+        csv.addCell("line 1\r\nline 2\nline 3\rline 4");
+        csv.endRow();
+        stream.flush();
+
+        CHECK(out == "a,b;line 1\\nline 2\\nline 3\\nline 4\n");
+    }
+
+    SECTION("empty cells are kept")
+    {
+        csv.addCell("");
+        csv.addCell("");
+        csv.endRow();
+        stream.flush();
+
+        CHECK(out == ";\n");
+    }
+
+    SECTION("rows without cells are skipped")
+    {
+        csv.writeHeader({});
+        csv.endRow();
+        stream.flush();
+
+        CHECK(out.isEmpty());
+        CHECK(csv.rowCount() == 0);
+    }
+}
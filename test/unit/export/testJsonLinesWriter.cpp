@@ -0,0 +1,46 @@
+#include "test/test_helpers.h"
+
+#include "export/JsonLinesWriter.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <sstream>
+
+using namespace mediaelch;
+
+TEST_CASE("JsonLinesWriter", "[export][cli]")
+{
+    std::stringstream out;
+    JsonLinesWriter writer(out);
+
+    SECTION("writes one object per line")
+    {
+        QJsonObject first;
+        first.insert("title", "Line 1\nLine 2");
+        first.insert("genres", QJsonArray{"Drama", "Comedy"});
+        QJsonObject second;
+        second.insert("year", 2020);
+
+        writer.write(first);
+        writer.write(second);
+        CHECK(writer.count() == 2);
+
+        std::string line;
+        REQUIRE(std::getline(out, line));
+        const QJsonObject actualFirst = QJsonDocument::fromJson(QByteArray::fromStdString(line)).object();
+        CHECK(actualFirst == first);
+
+        REQUIRE(std::getline(out, line));
+        CHECK(line == R"({"year":2020})");
+
+        CHECK_FALSE(std::getline(out, line));
+    }
+
+    SECTION("non-ASCII characters are written as UTF-8")
+    {
+        QJsonObject object;
+        object.insert("title", QString::fromUtf8("Die fabelhafte Welt der Amélie"));
+        writer.write(object);
+        CHECK(out.str() == u8"{\"title\":\"Die fabelhafte Welt der Amélie\"}\n");
+    }
+}
@@ -0,0 +1,160 @@
+#include "test/test_helpers.h"
+
+#include "file/DirectoryJournal.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+using namespace mediaelch;
+
+namespace {
+
+void createFile(const QString& path)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+}
+
+QStringList listFiles(const QString& path, DirectoryJournal& /*journal*/)
+{
+    QStringList files;
+    for (const QString& file : QDir(path).entryList(QDir::Files, QDir::Name)) {
+        files << path + "/" + file;
+    }
+    return files;
+}
+
+DirectoryJournal walk(const QString& root, const QHash<QString, DirectorySnapshot>& previous = {})
+{
+    DirectoryJournal journal(previous);
+    REQUIRE(journal.walk(root, listFiles));
+    return journal;
+}
+
+/// Snapshots have a resolution of milliseconds.
+void waitForNextModificationTime()
+{
+    QThread::msleep(20);
+}
+
+} // namespace
+
+TEST_CASE("DirectoryJournal", "[file]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString root = tempDir.path();
+    QDir dir(root);
+    REQUIRE(dir.mkpath("Movie A/Subs"));
+    REQUIRE(dir.mkpath("Movie B"));
+    REQUIRE(dir.mkpath("Disc/BDMV"));
+    createFile(root + "/Movie A/movie.mkv");
+    createFile(root + "/Movie A/Subs/movie.srt");
+    createFile(root + "/Movie B/movie.avi");
+    createFile(root + "/Disc/BDMV/index.bdmv");
+
+    const DirectoryJournal firstScan = walk(root);
+
+    SECTION("first scan lists all directories")
+    {
+        CHECK(firstScan.current().size() == 6);
+        CHECK(firstScan.contents().keys()
+              == QStringList({root,
+                  root + "/Disc",
+                  root + "/Disc/BDMV",
+                  root + "/Movie A",
+                  root + "/Movie A/Subs",
+                  root + "/Movie B"}));
+        CHECK(firstScan.contents().value(root + "/Movie A") == QStringList{root + "/Movie A/movie.mkv"});
+        CHECK(firstScan.isChanged(root + "/Movie B"));
+        CHECK(firstScan.removedDirectories().isEmpty());
+    }
+
+    SECTION("unchanged directories are not listed again")
+    {
+        const DirectoryJournal journal = walk(root, firstScan.current());
+        CHECK(journal.current() == firstScan.current());
+        CHECK(journal.contents().isEmpty());
+        CHECK(journal.isUnchanged(root + "/Movie A/Subs"));
+        CHECK(journal.movedTo(root + "/Movie A").isEmpty());
+        CHECK(journal.removedDirectories().isEmpty());
+    }
+
+    SECTION("disc structures of unchanged directories are found")
+    {
+        DirectoryJournal journal = walk(root, firstScan.current());
+        CHECK(journal.bluRays() == QStringList{root + "/Disc"});
+        CHECK(journal.dvds().isEmpty());
+    }
+
+    SECTION("added directories and files are listed")
+    {
+        waitForNextModificationTime();
+        REQUIRE(dir.mkdir("Movie C"));
+        createFile(root + "/Movie C/movie.mkv");
+        createFile(root + "/Movie B/movie-trailer.avi");
+
+        const DirectoryJournal journal = walk(root, firstScan.current());
+        CHECK(journal.contents().keys() == QStringList({root, root + "/Movie B", root + "/Movie C"}));
+        CHECK(journal.contents().value(root + "/Movie C") == QStringList{root + "/Movie C/movie.mkv"});
+        CHECK(journal.isUnchanged(root + "/Movie A"));
+        CHECK(journal.removedDirectories().isEmpty());
+    }
+
+    SECTION("removed directories are reported")
+    {
+        waitForNextModificationTime();
+        REQUIRE(QDir(root + "/Movie A").removeRecursively());
+
+        const DirectoryJournal journal = walk(root, firstScan.current());
+        CHECK(journal.removedDirectories() == QStringList({root + "/Movie A", root + "/Movie A/Subs"}));
+        CHECK(journal.contents().keys() == QStringList{root});
+        CHECK(journal.isUnchanged(root + "/Movie B"));
+    }
+
+    SECTION("moved directories are a move and not a removal and an addition")
+    {
+        waitForNextModificationTime();
+        REQUIRE(dir.rename("Movie A", "Movie A (2021)"));
+
+        const DirectoryJournal journal = walk(root, firstScan.current());
+        CHECK(journal.movedTo(root + "/Movie A") == root + "/Movie A (2021)");
+        CHECK(journal.movedTo(root + "/Movie A/Subs") == root + "/Movie A (2021)/Subs");
+        CHECK(journal.removedDirectories().isEmpty());
+        // Only the parent directory changed; the moved directories are not listed.
+        CHECK(journal.contents().keys() == QStringList{root});
+        CHECK_FALSE(journal.isChanged(root + "/Movie A (2021)"));
+        CHECK(journal.current().contains(root + "/Movie A (2021)/Subs"));
+    }
+
+    SECTION("discarded directories are compared again")
+    {
+        waitForNextModificationTime();
+        createFile(root + "/Movie B/movie.nfo");
+
+        DirectoryJournal journal = walk(root, firstScan.current());
+        REQUIRE(journal.isChanged(root + "/Movie B"));
+        journal.discard(root + "/Movie B");
+        CHECK_FALSE(journal.isChanged(root + "/Movie B"));
+        CHECK_FALSE(journal.contents().contains(root + "/Movie B"));
+        CHECK_FALSE(journal.current().contains(root + "/Movie B"));
+    }
+
+    SECTION("walk can be aborted")
+    {
+        int calls = 0;
+        DirectoryJournal journal;
+        // The progress callback is only called every 50 directories.
+        for (int i = 0; i < 60; ++i) {
+            REQUIRE(dir.mkdir(QStringLiteral("Extra %1").arg(i)));
+        }
+        CHECK_FALSE(journal.walk(root, listFiles, [&calls](const QString&) {
+            ++calls;
+            return false;
+        }));
+        CHECK(calls == 1);
+        CHECK(journal.current().size() == 50);
+    }
+}
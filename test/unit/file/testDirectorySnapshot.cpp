@@ -0,0 +1,38 @@
+#include "test/test_helpers.h"
+
+#include "file/DirectorySnapshot.h"
+
+#include <QDir>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+TEST_CASE("DirectorySnapshot", "[file]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+
+    SECTION("is invalid for non-existing directories")
+    {
+        CHECK_FALSE(DirectorySnapshot::fromPath(tempDir.filePath("does-not-exist")).isValid());
+    }
+
+    SECTION("is equal for unchanged directories")
+    {
+        const DirectorySnapshot first = DirectorySnapshot::fromPath(tempDir.path());
+        const DirectorySnapshot second = DirectorySnapshot::fromPath(tempDir.path());
+        CHECK(first.isValid());
+        CHECK(first == second);
+    }
+
+    SECTION("keeps the inode if a directory is moved")
+    {
+        REQUIRE(QDir(tempDir.path()).mkdir("before"));
+        const DirectorySnapshot before = DirectorySnapshot::fromPath(tempDir.filePath("before"));
+        REQUIRE(QDir(tempDir.path()).rename("before", "after"));
+        const DirectorySnapshot after = DirectorySnapshot::fromPath(tempDir.filePath("after"));
+
+        CHECK(before.inode == after.inode);
+        CHECK(before.lastModified == after.lastModified);
+    }
+}
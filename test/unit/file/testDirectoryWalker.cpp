@@ -0,0 +1,65 @@
+#include "test/test_helpers.h"
+
+#include "file/DirectoryWalker.h"
+
+#include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+TEST_CASE("DirectoryWalker", "[file]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    QDir root(tempDir.path());
+    REQUIRE(root.mkpath("a/b/c"));
+    REQUIRE(root.mkpath("a/d"));
+    REQUIRE(root.mkpath("e"));
+
+    QMutex mutex;
+    QSet<QString> visited;
+    auto listSubDirs = [&](const QString& path) {
+        QStringList subDirs;
+        for (const QFileInfo& entry : QDir(path).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            subDirs << entry.filePath();
+        }
+        QMutexLocker locker(&mutex);
+        visited.insert(path);
+        return subDirs;
+    };
+
+    SECTION("visits all directories")
+    {
+        DirectoryWalker walker(2);
+        walker.walk({root.path()}, listSubDirs);
+
+        CHECK(visited.size() == 6);
+        CHECK(visited.contains(root.filePath("a/b/c")));
+        CHECK(visited.contains(root.filePath("a/d")));
+        CHECK(visited.contains(root.filePath("e")));
+    }
+
+    SECTION("visits multiple roots")
+    {
+        DirectoryWalker walker(1);
+        walker.walk({root.filePath("a/b"), root.filePath("e")}, listSubDirs);
+
+        CHECK(visited.size() == 3);
+        CHECK(visited.contains(root.filePath("a/b/c")));
+    }
+
+    SECTION("stops after abort")
+    {
+        DirectoryWalker walker;
+        walker.walk({root.path()}, [&](const QString& path) {
+            walker.abort();
+            return listSubDirs(path);
+        });
+
+        CHECK(walker.isAborted());
+        CHECK(visited.size() < 6);
+    }
+}
@@ -0,0 +1,94 @@
+#include "test/test_helpers.h"
+
+#include "file/FileNameMatcher.h"
+
+#include <QDir>
+
+using namespace mediaelch;
+
+namespace {
+
+bool matchesAnyRegex(const QVector<QRegularExpression>& patterns, const QString& name)
+{
+    for (const QRegularExpression& regex : patterns) {
+        if (regex.isValid() && regex.match(name).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const QStringList fileNames = {"movie.mkv",
+    "Movie.MKV",
+    "movie.mkv.part",
+    ".hidden.mkv",
+    "sample.avi",
+    "My Movie-sample.avi",
+    "trailer-1080p.mp4",
+    "VIDEO_TS.IFO",
+    "video_ts.ifo",
+    "index.bdmv",
+    "ab.txt",
+    "abab.txt",
+    "price$.txt",
+    "Über.mkv",
+    "no_extension",
+    ""};
+
+} // namespace
+
+TEST_CASE("FileNameMatcher", "[file]")
+{
+    SECTION("regular expressions match the same names as one regex per pattern")
+    {
+        const QVector<QRegularExpression> patterns = {
+            QRegularExpression(R"(^\.)"),                                     // anchored literal
+            QRegularExpression(R"(\.part$)"),                                 // suffix literal
+            QRegularExpression("sample"),                                     // substring literal
+            QRegularExpression(R"(^trailer-\d+p)"),                           // combined
+            QRegularExpression("(ab)\\1"),                                    // back reference: separate
+            QRegularExpression("(?i)über"),                                   // inline option
+            QRegularExpression(R"(\$)"),                                      // escaped dollar is a literal
+            QRegularExpression("MOVIE", QRegularExpression::CaseInsensitiveOption), // options: separate
+        };
+        const FileNameMatcher matcher = FileNameMatcher::fromRegularExpressions(patterns);
+        CHECK(matcher.regexPatternCount() == 4);
+
+        for (const QString& name : fileNames) {
+            INFO("name: " << name.toStdString());
+            CHECK(matcher.matches(name) == matchesAnyRegex(patterns, name));
+        }
+    }
+
+    SECTION("regular expressions without literals")
+    {
+        const QVector<QRegularExpression> patterns = {
+            QRegularExpression(R"(\.(avi|mp4)$)"), QRegularExpression(R"(^[A-Z]+_TS)")};
+        const FileNameMatcher matcher = FileNameMatcher::fromRegularExpressions(patterns);
+        for (const QString& name : fileNames) {
+            INFO("name: " << name.toStdString());
+            CHECK(matcher.matches(name) == matchesAnyRegex(patterns, name));
+        }
+    }
+
+    SECTION("wildcards match the same names as QDir::match()")
+    {
+        const QStringList wildcards = {
+            "*.mkv", "VIDEO_TS.IFO", "index.bdmv", "*sample*", "trailer*", "a?.txt", "*.m[kp]4"};
+        const FileNameMatcher matcher = FileNameMatcher::fromWildcards(wildcards);
+        CHECK(matcher.regexPatternCount() == 2);
+
+        for (const QString& name : fileNames + QStringList{"clip.mp4", "clip.mk4", "clip.ma4"}) {
+            INFO("name: " << name.toStdString());
+            CHECK(matcher.matches(name) == QDir::match(wildcards, name));
+        }
+    }
+
+    SECTION("empty matcher matches nothing")
+    {
+        const FileNameMatcher matcher;
+        CHECK(matcher.isEmpty());
+        CHECK_FALSE(matcher.matches("movie.mkv"));
+        CHECK_FALSE(FileNameMatcher::fromWildcards({}).matches("movie.mkv"));
+    }
+}
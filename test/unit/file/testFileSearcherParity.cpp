@@ -0,0 +1,324 @@
+#include "test/test_helpers.h"
+
+#include "globals/Helper.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "settings/AdvancedSettingsXmlReader.h"
+#include "settings/Settings.h"
+#include "tv_shows/TvShowFileSearcher.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QRegExp>
+#include <QTemporaryDir>
+#include <algorithm>
+
+using namespace mediaelch;
+
+namespace {
+
+/// Replaces the advanced settings for the lifetime of this object.
+class AdvancedSettingsGuard
+{
+public:
+    explicit AdvancedSettingsGuard(const QString& xml) : m_previous(*Settings::instance()->advanced())
+    {
+        *Settings::instance()->advanced() = AdvancedSettingsXmlReader::loadFromXml(xml).first;
+    }
+    ~AdvancedSettingsGuard() { *Settings::instance()->advanced() = m_previous; }
+
+private:
+    AdvancedSettings m_previous;
+};
+
+void createFiles(const QString& root, const QStringList& files)
+{
+    for (const QString& file : files) {
+        const QString path = root + "/" + file;
+        REQUIRE(QDir().mkpath(QFileInfo(path).absolutePath()));
+        QFile f(path);
+        REQUIRE(f.open(QIODevice::WriteOnly));
+    }
+}
+
+QStringList sorted(QStringList list)
+{
+    list.sort();
+    return list;
+}
+
+QMap<QString, QStringList> sortedValues(QMap<QString, QStringList> map)
+{
+    for (auto& value : map) {
+        value.sort();
+    }
+    return map;
+}
+
+QVector<QStringList> sortedByFirstFile(QVector<QStringList> contents)
+{
+    std::sort(contents.begin(), contents.end(), [](const QStringList& lhs, const QStringList& rhs) {
+        return lhs.value(0) < rhs.value(0);
+    });
+    return contents;
+}
+
+/// Serial implementation of MovieFileSearcher::loadMoviesFromDirectory() as it
+/// was before directories were listed in parallel.
+QMap<QString, QStringList> serialMovieFiles(const QString& path, QStringList& bluRays, QStringList& dvds)
+{
+    const AdvancedSettings* settings = Settings::instance()->advanced();
+    QMap<QString, QStringList> contents;
+    QDirIterator it(path,
+        settings->movieFilters().filters(),
+        QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
+        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+
+    while (it.hasNext()) {
+        it.next();
+        const QString dirName = it.fileInfo().dir().dirName();
+        const QString fileName = it.fileName();
+        const bool isFile = it.fileInfo().isFile();
+        const bool isDir = it.fileInfo().isDir();
+        bool isSpecialDir = false;
+
+        if (isFile && settings->isFileExcluded(fileName)) {
+            continue;
+        }
+        if ((isDir && settings->isFolderExcluded(fileName)) || settings->isFolderExcluded(dirName)) {
+            continue;
+        }
+        if (isFile
+            && (fileName.contains("-trailer", Qt::CaseInsensitive)            //
+                || fileName.contains("-sample", Qt::CaseInsensitive)          //
+                || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
+                || fileName.contains("-deleted", Qt::CaseInsensitive)         //
+                || fileName.contains("-featurette", Qt::CaseInsensitive)      //
+                || fileName.contains("-interview", Qt::CaseInsensitive)       //
+                || fileName.contains("-scene", Qt::CaseInsensitive)           //
+                || fileName.contains("-short", Qt::CaseInsensitive))) {
+            continue;
+        }
+        if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0
+            || QString::compare("extras", dirName, Qt::CaseInsensitive) == 0
+            || QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0
+            || QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
+            continue;
+        }
+        if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
+            && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+            continue;
+        }
+
+        if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+            QDir bluRayDir(it.fileInfo().dir());
+            if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
+                bluRayDir.cdUp();
+            }
+            bluRays << bluRayDir.path();
+            isSpecialDir = true;
+        }
+        if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
+            QDir videoDir(it.fileInfo().dir());
+            if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
+                videoDir.cdUp();
+            }
+            dvds << videoDir.path();
+            isSpecialDir = true;
+        }
+
+        const QString dirPath = it.fileInfo().path();
+        if (!contents.contains(dirPath)) {
+            contents.insert(dirPath, {});
+        }
+        if (isFile || isSpecialDir) {
+            contents[dirPath].append(it.filePath());
+        }
+    }
+    return contents;
+}
+
+/// Serial implementation of TvShowFileSearcher::scanTvShowDir() as it was before
+/// directories were listed in parallel.
+void serialTvShowContents(const QString& path, QVector<QStringList>& contents)
+{
+    const AdvancedSettings* settings = Settings::instance()->advanced();
+    QDir dir(path);
+    for (const QString& cDir : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (settings->isFolderExcluded(cDir)) {
+            continue;
+        }
+        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
+            || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
+            || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
+            continue;
+        }
+        const QString subDir = path + "/" + cDir;
+        if (helper::isDvd(subDir)) {
+            contents.append(QStringList() << (subDir + "/VIDEO_TS/VIDEO_TS.IFO"));
+            continue;
+        }
+        if (helper::isDvd(subDir, true)) {
+            contents.append(QStringList() << (subDir + "/VIDEO_TS.IFO"));
+            continue;
+        }
+        if (helper::isBluRay(subDir)) {
+            contents.append(QStringList() << (subDir + "/BDMV/index.bdmv"));
+            continue;
+        }
+        serialTvShowContents(subDir, contents);
+    }
+
+    QStringList files;
+    const QStringList entries = dir.entryList(settings->tvShowFilters().filters(), QDir::Files | QDir::System);
+    for (const QString& file : entries) {
+        if (settings->isFileExcluded(file)) {
+            continue;
+        }
+        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+            continue;
+        }
+        files.append(file);
+    }
+    files.sort();
+
+    QRegExp rx("((part|cd)[\\s_]*)(\\d+)", Qt::CaseInsensitive);
+    for (int i = 0, n = files.size(); i < n; i++) {
+        QStringList tvShowFiles;
+        QString file = files.at(i);
+        if (file.isEmpty()) {
+            continue;
+        }
+        tvShowFiles << (path + '/' + file);
+        int pos = rx.indexIn(file);
+        if (pos != -1) {
+            QString left = file.left(pos) + rx.cap(1);
+            QString right = file.mid(pos + rx.cap(1).size() + rx.cap(2).size());
+            for (int x = 0; x < n; x++) {
+                QString subFile = files.at(x);
+                if (subFile != file && subFile.startsWith(left) && subFile.endsWith(right)) {
+                    tvShowFiles << (path + '/' + subFile);
+                    files[x] = "";
+                }
+            }
+        }
+        contents.append(tvShowFiles);
+    }
+}
+
+const char* const excludeXml = R"xml(<?xml version="1.0" encoding="utf-8"?>
+<advancedsettings>
+  <exclude>
+    <pattern applyTo="filename">^_</pattern>
+    <pattern applyTo="filename">\.part\.mkv$</pattern>
+    <pattern applyTo="folders">^@eaDir$</pattern>
+    <pattern applyTo="folders">^[.]git$</pattern>
+  </exclude>
+</advancedsettings>
+)xml";
+
+} // namespace
+
+TEST_CASE("Parallel movie directory scan finds the same files as the serial scan", "[file][movie]")
+{
+    AdvancedSettingsGuard settings(excludeXml);
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString root = QDir(tempDir.path()).path();
+
+    createFiles(root,
+        {"Loose Movie (1999).mkv",
+            "_hidden.mkv",
+            "Movie A (2000)/Movie A.mkv",
+            "Movie A (2000)/Movie A.nfo",
+            "Movie A (2000)/Movie A-trailer.mkv",
+            "Movie A (2000)/Movie A.part.mkv",
+            "Movie A (2000)/extrafanart/fanart.mkv",
+            "Movie A (2000)/extras/Bonus.mkv",
+            "Movie B/Movie B cd1.avi",
+            "Movie B/Movie B cd2.avi",
+            "Movie B/Movie B-sample.avi",
+            "Movie C/BDMV/index.bdmv",
+            "Movie C/BDMV/STREAM/00001.m2ts",
+            "Movie C/BDMV/BACKUP/index.bdmv",
+            "Movie D/VIDEO_TS/VIDEO_TS.IFO",
+            "Movie D/VIDEO_TS/VTS_01_1.VOB",
+            "Collection/Part 1/Movie E.mp4",
+            "Collection/Part 1/Deeper/Movie F.mkv",
+            "Collection/Part 2/Movie G part1.mkv",
+            "Collection/Part 2/Movie G part2.mkv",
+            "Collection/@eaDir/Movie H.mkv",
+            "Collection/.git/objects/Movie I.mkv",
+            "Weird.mkv/inner.avi",
+            "Empty/.keep"});
+
+    QStringList serialBluRays;
+    QStringList serialDvds;
+    const QMap<QString, QStringList> serial = serialMovieFiles(root, serialBluRays, serialDvds);
+
+    SettingsDir movieDir;
+    movieDir.path = QDir(root);
+    MovieFileSearcher searcher;
+    searcher.setProcessEvents(false);
+    QStringList bluRays;
+    QStringList dvds;
+    const QMap<QString, QStringList> parallel = searcher.scanMovieDirectory(movieDir, bluRays, dvds);
+
+    CHECK(parallel.keys() == serial.keys());
+    CHECK(sortedValues(parallel) == sortedValues(serial));
+    CHECK(sorted(bluRays) == sorted(serialBluRays));
+    CHECK(sorted(dvds) == sorted(serialDvds));
+
+    // Sanity checks that the fixture covers what it is supposed to.
+    CHECK(sorted(parallel.value(root + "/Movie B"))
+          == QStringList({root + "/Movie B/Movie B cd1.avi", root + "/Movie B/Movie B cd2.avi"}));
+    CHECK(parallel.value(root + "/Movie A (2000)") == QStringList{root + "/Movie A (2000)/Movie A.mkv"});
+    CHECK(parallel.contains(root + "/Collection/Part 1/Deeper"));
+    CHECK_FALSE(parallel.contains(root + "/Collection/@eaDir"));
+    CHECK(bluRays == QStringList{root + "/Movie C"});
+    CHECK(dvds == QStringList{root + "/Movie D"});
+}
+
+TEST_CASE("Parallel TV show directory scan finds the same files as the serial scan", "[file][show]")
+{
+    AdvancedSettingsGuard settings(excludeXml);
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString root = QDir(tempDir.path()).path();
+    const QString show = root + "/Show";
+
+    createFiles(show,
+        {"S01E01.mkv",
+            "_S01E02.mkv",
+            "S01E02 part1.mkv",
+            "S01E02 part2.mkv",
+            "S01E03-sample.mkv",
+            "tvshow.nfo",
+            "Season 1/S01E04.mkv",
+            "Season 1/S01E05.part.mkv",
+            "Season 1/Nested/S01E06.avi",
+            "Season 2/S02E01 cd1.avi",
+            "Season 2/S02E01 cd2.avi",
+            "Season 2/@eaDir/S02E02.mkv",
+            "Season 2/.git/S02E03.mkv",
+            "Disc 1/VIDEO_TS/VIDEO_TS.IFO",
+            "Disc 2/VIDEO_TS.IFO",
+            "Disc 3/BDMV/index.bdmv",
+            "Extras/Bonus.mkv",
+            "extrafanarts/fanart.mkv"});
+
+    QVector<QStringList> serial;
+    serialTvShowContents(show, serial);
+
+    TvShowFileSearcher searcher;
+    const QVector<QStringList> parallel = searcher.scanTvShow(root, show);
+
+    CHECK(sortedByFirstFile(parallel) == sortedByFirstFile(serial));
+
+    // Sanity checks that the fixture covers what it is supposed to.
+    CHECK(parallel.contains(QStringList({show + "/S01E02 part1.mkv", show + "/S01E02 part2.mkv"})));
+    CHECK(parallel.contains(QStringList{show + "/Season 1/Nested/S01E06.avi"}));
+    CHECK(parallel.contains(QStringList{show + "/Disc 1/VIDEO_TS/VIDEO_TS.IFO"}));
+    CHECK(parallel.contains(QStringList{show + "/Disc 3/BDMV/index.bdmv"}));
+    CHECK_FALSE(parallel.contains(QStringList{show + "/Season 2/@eaDir/S02E02.mkv"}));
+}
@@ -0,0 +1,102 @@
+#include "test/test_helpers.h"
+
+#include "globals/ImagePreviewLoader.h"
+
+#include <QImage>
+#include <QUrl>
+
+using namespace mediaelch;
+
+namespace {
+
+ImagePreviewCache::Preview createPreview(int width, int height, int scaledWidth)
+{
+    ImagePreviewCache::Preview preview;
+    preview.image = QImage(width, height, QImage::Format_ARGB32);
+    preview.scaled = QImage(scaledWidth, scaledWidth * height / width, QImage::Format_ARGB32);
+    preview.scaledWidth = scaledWidth;
+    return preview;
+}
+
+/// \brief Resets the shared cache once the test is done.
+struct CacheReset
+{
+    ~CacheReset()
+    {
+        ImagePreviewCache::instance()->clear();
+        ImagePreviewCache::instance()->setMaxBytes(ImagePreviewCache::defaultMaxBytes);
+    }
+};
+
+} // namespace
+
+TEST_CASE("ImagePreviewCache", "[globals][image]")
+{
+    ImagePreviewCache* cache = ImagePreviewCache::instance();
+    CacheReset reset;
+    cache->clear();
+    REQUIRE(cache->totalBytes() == 0);
+
+    SECTION("small originals are kept and charged with the preview")
+    {
+        const QUrl url("https://example.com/small.jpg");
+        cache->insert(url, createPreview(100, 100, 50));
+
+        const ImagePreviewCache::Preview* preview = cache->find(url);
+        REQUIRE(preview != nullptr);
+        CHECK_FALSE(preview->image.isNull());
+        CHECK(preview->scaledWidth == 50);
+        CHECK(cache->totalBytes() == 100 * 100 * 4 + 50 * 50 * 4);
+    }
+
+    SECTION("large originals are dropped and only the preview is charged")
+    {
+        const QUrl url("https://example.com/fanart.jpg");
+        cache->insert(url, createPreview(2000, 1100, 200));
+
+        const ImagePreviewCache::Preview* preview = cache->find(url);
+        REQUIRE(preview != nullptr);
+        CHECK(preview->image.isNull());
+        CHECK(preview->scaled.width() == 200);
+        CHECK(cache->totalBytes() == 200 * 110 * 4);
+    }
+
+    SECTION("least recently used previews are evicted")
+    {
+        // Originals of 40 bytes and previews of 10000 bytes each
+        const auto createSmallPreview = []() {
+            ImagePreviewCache::Preview preview;
+            preview.image = QImage(10, 1, QImage::Format_ARGB32);
+            preview.scaled = QImage(50, 50, QImage::Format_ARGB32);
+            preview.scaledWidth = 50;
+            return preview;
+        };
+        cache->setMaxBytes(25000);
+        const QUrl first("https://example.com/1.jpg");
+        const QUrl second("https://example.com/2.jpg");
+        const QUrl third("https://example.com/3.jpg");
+
+        cache->insert(first, createSmallPreview());
+        cache->insert(second, createSmallPreview());
+        CHECK(cache->count() == 2);
+
+        // Mark the first preview as recently used so that the second one is evicted.
+        CHECK(cache->find(first) != nullptr);
+        cache->insert(third, createSmallPreview());
+
+        CHECK(cache->count() == 2);
+        CHECK(cache->totalBytes() <= cache->maxBytes());
+        CHECK(cache->find(first) != nullptr);
+        CHECK(cache->find(second) == nullptr);
+        CHECK(cache->find(third) != nullptr);
+    }
+
+    SECTION("previews larger than the budget are not cached")
+    {
+        cache->setMaxBytes(1000);
+        const QUrl url("https://example.com/small.jpg");
+        cache->insert(url, createPreview(100, 100, 50));
+        CHECK(cache->find(url) == nullptr);
+        CHECK(cache->totalBytes() == 0);
+    }
+}
@@ -0,0 +1,82 @@
+#include "test/test_helpers.h"
+
+#include "concerts/Concert.h"
+#include "globals/MediaSearchIndex.h"
+#include "movies/Movie.h"
+
+#include <memory>
+
+using namespace mediaelch;
+
+namespace {
+
+std::unique_ptr<Movie> createMovie(const QString& title, const QString& director = {})
+{
+    auto movie = std::make_unique<Movie>(QStringList{});
+    movie->setName(title);
+    movie->setDirector(director);
+    return movie;
+}
+
+} // namespace
+
+TEST_CASE("MediaSearchIndex finds items by field", "[globals][search]")
+{
+    using Field = MediaSearchIndex::Field;
+
+    auto matrix = createMovie("The Matrix", "Lana Wachowski");
+    auto amelie = createMovie("Amélie", "Jean-Pierre Jeunet");
+    auto concert = std::make_unique<Concert>();
+    concert->setName("Matrix Live");
+
+    MediaSearchIndex index;
+    index.addMovies({matrix.get(), amelie.get()});
+    index.addConcerts({concert.get()});
+    REQUIRE(index.documentCount() == 3);
+
+    SECTION("queries are case-insensitive")
+    {
+        const auto hits = index.search("MATRIX", Field::Title);
+        CHECK(hits.size() == 2);
+        CHECK(hits.contains(matrix.get()));
+        CHECK(hits.contains(concert.get()));
+        CHECK(index.search("AMÉLIE", Field::Title).contains(amelie.get()));
+    }
+
+    SECTION("only the given fields are searched")
+    {
+        CHECK(index.search("wachowski", Field::Title).isEmpty());
+        CHECK(index.search("wachowski", Field::People).size() == 1);
+        CHECK(index.search("wachowski", Field::Title | Field::People).size() == 1);
+    }
+
+    SECTION("short queries and empty queries")
+    {
+        CHECK(index.search("am", Field::Title).size() == 1);
+        CHECK(index.search("", Field::Title).size() == 3);
+        CHECK(index.search("xyz", Field::Title).isEmpty());
+    }
+
+    SECTION("changed items are re-indexed")
+    {
+        matrix->setName("Zion");
+        CHECK_FALSE(index.search("matrix", Field::Title).contains(matrix.get()));
+        CHECK(index.search("zion", Field::Title).contains(matrix.get()));
+        CHECK(index.documentCount() == 3);
+    }
+
+    SECTION("destroyed items are removed")
+    {
+        Movie* removed = amelie.get();
+        amelie.reset();
+        CHECK(index.documentCount() == 2);
+        CHECK_FALSE(index.search("", Field::Title).contains(removed));
+    }
+
+    SECTION("adding items is idempotent")
+    {
+        index.addMovies({matrix.get()});
+        CHECK(index.documentCount() == 3);
+        CHECK(index.search("matrix", Field::Title).size() == 2);
+    }
+}
@@ -0,0 +1,142 @@
+#include "test/test_helpers.h"
+
+#include "imports/FileImporter.h"
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+
+using namespace mediaelch;
+
+namespace {
+
+/// Larger than a single buffer of the fallback copy.
+constexpr int fixtureFileSize = 9 * 1024 * 1024 + 123;
+
+QByteArray createContent(int size, char seed)
+{
+    QByteArray content(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        content[i] = static_cast<char>(seed + i % 251);
+    }
+    return content;
+}
+
+void writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    REQUIRE(file.write(content) == content.size());
+}
+
+QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+void runUntilFinished(FileImporter& importer, const QMap<QString, QString>& files, FileImporter::Mode mode)
+{
+    QEventLoop loop;
+    QObject::connect(&importer, &FileImporter::sigFinished, &loop, &QEventLoop::quit);
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+    importer.start(files, mode);
+    loop.exec();
+    REQUIRE_FALSE(importer.isRunning());
+}
+
+} // namespace
+
+TEST_CASE("FileImporter", "[imports]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    QDir dir(tempDir.path());
+    REQUIRE(dir.mkpath("source"));
+    REQUIRE(dir.mkpath("library"));
+
+    const QByteArray content = createContent(fixtureFileSize, 'a');
+    const QString source = dir.filePath("source/movie.mkv");
+    const QString destination = dir.filePath("library/Movie (2020).mkv");
+    writeFile(source, content);
+
+    SECTION("copies the contents and reports all bytes")
+    {
+        std::atomic_bool cancelled{false};
+        qint64 progress = 0;
+        const auto status =
+            FileImporter::copyFile(source, destination, cancelled, [&progress](qint64 bytes) { progress += bytes; });
+
+        CHECK(status == FileImporter::Status::Success);
+        CHECK(progress == fixtureFileSize);
+        CHECK(readFile(destination) == content);
+        CHECK(QFileInfo::exists(source));
+        CHECK_FALSE(QFileInfo::exists(destination + ".part"));
+    }
+
+    SECTION("does not overwrite existing files")
+    {
+        writeFile(destination, "existing");
+        std::atomic_bool cancelled{false};
+        CHECK(FileImporter::copyFile(source, destination, cancelled) == FileImporter::Status::Failed);
+        CHECK(readFile(destination) == "existing");
+    }
+
+    SECTION("cancelled copies leave no files behind")
+    {
+        std::atomic_bool cancelled{true};
+        CHECK(FileImporter::copyFile(source, destination, cancelled) == FileImporter::Status::Cancelled);
+        CHECK_FALSE(QFileInfo::exists(destination));
+        CHECK_FALSE(QFileInfo::exists(destination + ".part"));
+    }
+
+    SECTION("imports several files")
+    {
+        const QByteArray subtitle = createContent(1000, 'x');
+        const QString subtitleSource = dir.filePath("source/movie.srt");
+        const QString subtitleDestination = dir.filePath("library/Movie (2020).srt");
+        writeFile(subtitleSource, subtitle);
+
+        QMap<QString, QString> files;
+        files.insert(source, destination);
+        files.insert(subtitleSource, subtitleDestination);
+
+        FileImporter importer;
+
+        SECTION("copy keeps the sources")
+        {
+            runUntilFinished(importer, files, FileImporter::Mode::Copy);
+            CHECK(importer.failedFiles().isEmpty());
+            CHECK(importer.bytesTotal() == fixtureFileSize + 1000);
+            CHECK(importer.bytesDone() == importer.bytesTotal());
+            CHECK(readFile(destination) == content);
+            CHECK(readFile(subtitleDestination) == subtitle);
+            CHECK(QFileInfo::exists(source));
+            CHECK(QFileInfo::exists(subtitleSource));
+        }
+
+        SECTION("move removes the sources")
+        {
+            runUntilFinished(importer, files, FileImporter::Mode::Move);
+            CHECK(importer.failedFiles().isEmpty());
+            CHECK(importer.bytesDone() == importer.bytesTotal());
+            CHECK(readFile(destination) == content);
+            CHECK(readFile(subtitleDestination) == subtitle);
+            CHECK_FALSE(QFileInfo::exists(source));
+            CHECK_FALSE(QFileInfo::exists(subtitleSource));
+        }
+
+        SECTION("existing destinations fail without touching the source")
+        {
+            writeFile(subtitleDestination, "existing");
+            runUntilFinished(importer, files, FileImporter::Mode::Move);
+            CHECK(importer.failedFiles() == QStringList{subtitleSource});
+            CHECK(readFile(subtitleDestination) == "existing");
+            CHECK(QFileInfo::exists(subtitleSource));
+            CHECK(readFile(destination) == content);
+        }
+    }
+}
@@ -4,9 +4,12 @@
 #include "globals/Meta.h"
 
 #include <QApplication>
+#include <QStandardPaths>
 
 int main(int argc, char** argv)
 {
+    // Tests that use Manager::instance() must not touch the user's database and caches.
+    QStandardPaths::setTestModeEnabled(true);
     QApplication app(argc, argv);
     registerAllMetaTypes();
     Catch::Session session; // NOLINT(clang-analyzer-core.uninitialized.UndefReturn)
@@ -0,0 +1,78 @@
+#include "test/test_helpers.h"
+
+#include "movies/Movie.h"
+#include "movies/MovieDuplicateIndex.h"
+
+#include <memory>
+
+using namespace mediaelch;
+
+namespace {
+
+std::unique_ptr<Movie> createMovie(const QString& title, int year)
+{
+    auto movie = std::make_unique<Movie>(QStringList{});
+    movie->setName(title);
+    movie->setReleased(QDate(year, 1, 1));
+    return movie;
+}
+
+} // namespace
+
+TEST_CASE("MovieDuplicateIndex normalizes titles", "[movie][duplicates]")
+{
+    CHECK(MovieDuplicateIndex::normalizedTitle("The Matrix") == "the matrix");
+    CHECK(MovieDuplicateIndex::normalizedTitle("  Amélie:  Le Fabuleux ") == "amelie le fabuleux");
+    CHECK(MovieDuplicateIndex::normalizedTitle("Spider-Man") == "spider man");
+    CHECK(MovieDuplicateIndex::normalizedTitle("!?").isEmpty());
+}
+
+TEST_CASE("MovieDuplicateIndex finds duplicates", "[movie][duplicates]")
+{
+    auto matrix = createMovie("The Matrix", 1999);
+    auto matrixCopy = createMovie("the matrix!", 1999);
+    auto matrixRemake = createMovie("The Matrix", 2030);
+    auto other = createMovie("Other", 1999);
+
+    MovieDuplicateIndex index;
+    index.setMovies({matrix.get(), matrixCopy.get(), matrixRemake.get(), other.get()});
+    REQUIRE(index.movieCount() == 4);
+
+    SECTION("by normalized title and year")
+    {
+        CHECK(index.duplicatesOf(matrix.get()) == QVector<Movie*>{matrixCopy.get()});
+        CHECK_FALSE(index.hasDuplicates(matrixRemake.get()));
+        CHECK(index.moviesWithDuplicates() == QVector<Movie*>({matrix.get(), matrixCopy.get()}));
+        CHECK(matrix->isDuplicate(matrixCopy.get()));
+        CHECK_FALSE(matrix->isDuplicate(matrixRemake.get()));
+    }
+
+    SECTION("by IDs")
+    {
+        other->setImdbId(ImdbId("tt0133093"));
+        matrixRemake->setTmdbId(TmdbId("603"));
+        matrix->setTmdbId(TmdbId("603"));
+        CHECK_FALSE(index.hasDuplicates(other.get()));
+        matrix->setImdbId(ImdbId("tt0133093"));
+
+        CHECK(index.duplicatesOf(matrix.get())
+              == QVector<Movie*>({matrixCopy.get(), matrixRemake.get(), other.get()}));
+        CHECK(index.duplicatesOf(other.get()) == QVector<Movie*>{matrix.get()});
+    }
+
+    SECTION("updates buckets if a movie changes")
+    {
+        matrixCopy->setName("Something else");
+        CHECK_FALSE(index.hasDuplicates(matrix.get()));
+
+        other->setName("The Matrix");
+        CHECK(index.duplicatesOf(matrix.get()) == QVector<Movie*>{other.get()});
+    }
+
+    SECTION("removes deleted movies")
+    {
+        matrixCopy.reset();
+        CHECK(index.movieCount() == 3);
+        CHECK_FALSE(index.hasDuplicates(matrix.get()));
+    }
+}
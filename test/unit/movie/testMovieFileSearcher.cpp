@@ -1,9 +1,105 @@
 #include "test/test_helpers.h"
 
+#include "data/Database.h"
+#include "data/Subtitle.h"
+#include "globals/Manager.h"
+#include "movies/MovieModel.h"
 #include "movies/file_searcher/MovieFileSearcher.h"
 
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QPointer>
+#include <QTemporaryDir>
+#include <QThread>
+
+namespace {
+
+void createFile(const QString& path)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+}
+
+Movie* findMovie(const QString& fileName)
+{
+    const QVector<Movie*> movies = Manager::instance()->movieModel()->movies();
+    for (Movie* movie : movies) {
+        if (!movie->files().isEmpty() && movie->files().first().toString() == fileName) {
+            return movie;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
 TEST_CASE("movies are found", "[movie]")
 {
     // TODO
     CHECK(true);
 }
+
+TEST_CASE("MovieFileSearcher moves files of moved directories", "[movie]")
+{
+    Movie movie(QStringList{"/movies/Old Name/movie-cd1.mkv", "/movies/Old Name/movie-cd2.mkv"});
+    // Subtitle files are stored relative to the movie's directory.
+    auto* subtitle = new Subtitle(&movie);
+    subtitle->setFiles({"movie-cd1.srt", "movie-cd1.idx"}, false);
+    movie.addSubtitle(subtitle, true);
+    movie.setChanged(false);
+
+    mediaelch::MovieFileSearcher::moveMovieDirectory(movie, "/movies/Old Name", "/movies/New Name");
+
+    CHECK(movie.files().toStringList()
+          == QStringList({"/movies/New Name/movie-cd1.mkv", "/movies/New Name/movie-cd2.mkv"}));
+    CHECK(subtitle->files() == QStringList({"movie-cd1.srt", "movie-cd1.idx"}));
+    CHECK_FALSE(subtitle->changed());
+    CHECK_FALSE(movie.hasChanged());
+}
+
+TEST_CASE("MovieFileSearcher keeps movies with unsaved changes on incremental reloads", "[movie]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString root = QDir(tempDir.path()).path();
+    QDir(root).mkpath("Movie A");
+    QDir(root).mkpath("Movie B");
+    createFile(root + "/Movie A/Movie A.mkv");
+    createFile(root + "/Movie B/Movie B.mkv");
+
+    SettingsDir movieDir;
+    movieDir.path = QDir(root);
+    movieDir.separateFolders = true;
+    mediaelch::MovieFileSearcher searcher;
+    searcher.setProcessEvents(false);
+    searcher.setMovieDirectories({movieDir});
+    searcher.reload(true);
+    // Stores the directory snapshots
+    searcher.reloadIncremental();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    QPointer<Movie> changedMovie = findMovie(root + "/Movie A/Movie A.mkv");
+    QPointer<Movie> unchangedMovie = findMovie(root + "/Movie B/Movie B.mkv");
+    REQUIRE(changedMovie != nullptr);
+    REQUIRE(unchangedMovie != nullptr);
+    changedMovie->setOverview("Not saved yet");
+    REQUIRE(changedMovie->hasChanged());
+
+    // Snapshots have a resolution of milliseconds.
+    QThread::msleep(20);
+    createFile(root + "/Movie A/Movie A.nfo");
+    searcher.reloadIncremental();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    REQUIRE(changedMovie != nullptr);
+    CHECK(findMovie(root + "/Movie A/Movie A.mkv") == changedMovie.data());
+    CHECK(changedMovie->hasChanged());
+    CHECK(changedMovie->overview() == "Not saved yet");
+    CHECK(findMovie(root + "/Movie B/Movie B.mkv") == unchangedMovie.data());
+    CHECK(Manager::instance()->movieModel()->movies().size() == 2);
+
+    Manager::instance()->movieModel()->clear();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    Manager::instance()->database()->clearMoviesInDirectory(mediaelch::DirectoryPath(root));
+}
@@ -0,0 +1,61 @@
+#include "test/test_helpers.h"
+
+#include "globals/CollationKeys.h"
+#include "movies/Movie.h"
+#include "movies/MovieKeyTable.h"
+
+#include <memory>
+
+using namespace mediaelch;
+
+TEST_CASE("collationRanks", "[movie][sort]")
+{
+    const QVector<int> ranks = collationRanks({"b", "a", "c", "a"});
+    CHECK(ranks == QVector<int>({1, 0, 2, 0}));
+    CHECK(collationRanks({}).isEmpty());
+}
+
+TEST_CASE("MovieKeyTable", "[movie][sort]")
+{
+    Movie alien;
+    alien.setName("Alien");
+    alien.setReleased(QDate(1979, 5, 25));
+    Movie brazil;
+    brazil.setName("Brazil");
+    brazil.setPlayCount(2);
+    Movie casablanca;
+    casablanca.setName("Casablanca");
+    casablanca.setSortTitle("0 Casablanca");
+
+    MovieKeyTable keys;
+    keys.reset({&alien, &brazil});
+    keys.insertRow(2, &casablanca);
+    REQUIRE(keys.rowCount() == 3);
+
+    SECTION("contains the keys of each movie")
+    {
+        CHECK(keys.year(0) == 1979);
+        CHECK(keys.year(1) == 0);
+        CHECK_FALSE(keys.watched(0));
+        CHECK(keys.watched(1));
+        // The sort title is used for sorting
+        CHECK(keys.titleRank(2) < keys.titleRank(0));
+        CHECK(keys.titleRank(0) < keys.titleRank(1));
+    }
+
+    SECTION("invalidated rows are updated")
+    {
+        CHECK(keys.titleRank(0) < keys.titleRank(1));
+        alien.setName("Zulu");
+        keys.invalidateRow(0);
+        CHECK(keys.titleRank(0) > keys.titleRank(1));
+    }
+
+    SECTION("removing rows keeps the order")
+    {
+        keys.removeRow(0);
+        REQUIRE(keys.rowCount() == 2);
+        CHECK(keys.movie(0) == &brazil);
+        CHECK(keys.titleRank(1) < keys.titleRank(0));
+    }
+}
@@ -0,0 +1,82 @@
+#include "test/test_helpers.h"
+
+#include "network/HttpDiskCache.h"
+
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+using namespace mediaelch::network;
+
+TEST_CASE("HttpDiskCache", "[network]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+
+    HttpDiskCache::Entry entry;
+    entry.date = QDateTime::currentDateTime();
+    entry.eTag = "\"abc\"";
+    entry.data = "{\"title\": \"Godzilla\"}";
+
+    SECTION("returns stored entries")
+    {
+        HttpDiskCache cache(tempDir.path());
+        cache.store("key", entry);
+
+        // A new instance must read the same directory.
+        HttpDiskCache other(tempDir.path());
+        const HttpDiskCache::Entry stored = other.entry("key");
+        REQUIRE(stored.isValid());
+        CHECK(stored.canBeRevalidated());
+        CHECK(stored.eTag == entry.eTag);
+        CHECK(stored.lastModified.isEmpty());
+        CHECK(stored.data == entry.data);
+        CHECK_FALSE(other.entry("other key").isValid());
+    }
+
+    SECTION("removes entries")
+    {
+        HttpDiskCache cache(tempDir.path());
+        cache.store("key", entry);
+        cache.remove("key");
+        CHECK_FALSE(cache.entry("key").isValid());
+        CHECK(cache.size() == 0);
+    }
+
+    SECTION("stays below its maximum size")
+    {
+        HttpDiskCache cache(tempDir.path(), 1024);
+        for (int i = 0; i < 50; ++i) {
+            cache.store(QString::number(i), entry);
+        }
+        CHECK(cache.size() > 0);
+        CHECK(cache.size() <= 1024);
+    }
+
+    SECTION("persists counters across instances")
+    {
+        HttpDiskCache cache(tempDir.path());
+        CHECK(cache.counters().isEmpty());
+        cache.addToCounters({{"hits", 2}, {"misses", 1}});
+        cache.addToCounters({{"hits", 3}});
+
+        HttpDiskCache other(tempDir.path());
+        const HttpDiskCache::Counters counters = other.counters();
+        CHECK(counters.value("hits") == 5);
+        CHECK(counters.value("misses") == 1);
+
+        // Counters are neither cache entries nor removed with them.
+        CHECK(other.size() == 0);
+        other.clear();
+        CHECK(other.counters().value("hits") == 5);
+
+        other.resetCounters();
+        CHECK(cache.counters().isEmpty());
+    }
+
+    SECTION("uses per-host time-to-live")
+    {
+        CHECK(HttpDiskCache::timeToLive(QUrl("https://api.themoviedb.org/3/movie/1"))
+              > HttpDiskCache::timeToLive(QUrl("https://www.imdb.com/title/tt0000001/")));
+        CHECK(HttpDiskCache::timeToLive(QUrl("https://example.com")) > 0);
+    }
+}
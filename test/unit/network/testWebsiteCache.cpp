@@ -0,0 +1,130 @@
+#include "test/test_helpers.h"
+
+#include "network/WebsiteCache.h"
+
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+using namespace mediaelch::scraper;
+
+TEST_CASE("WebsiteCache", "[network]")
+{
+    const QUrl first("https://example.com/1");
+    const QUrl second("https://example.com/2");
+    const QUrl third("https://example.com/3");
+    const QByteArray data(100, 'x');
+
+    SECTION("returns added elements")
+    {
+        WebsiteCache cache(nullptr);
+        CHECK_FALSE(cache.hasValidElement(first, Locale::English));
+
+        cache.addElement(first, Locale::English, data);
+        CHECK(cache.hasValidElement(first, Locale::English));
+        CHECK(cache.getElement(first, Locale::English) == data);
+        CHECK_FALSE(cache.hasValidElement(first, Locale("de-DE")));
+        CHECK(cache.elementCount() == 1);
+    }
+
+    SECTION("stores responses unchanged")
+    {
+        WebsiteCache cache(nullptr);
+        const QByteArray utf8 = QStringLiteral("{\"title\": \"Die Brücke am Fluss – 千と千尋\"}").toUtf8();
+        cache.addElement(first, Locale::English, utf8);
+        CHECK(cache.getElement(first, Locale::English) == utf8);
+        // Only the key is stored as UTF-16.
+        CHECK(cache.memoryBytes() < utf8.size() + 100 * static_cast<qint64>(sizeof(QChar)));
+    }
+
+    SECTION("replaces existing elements")
+    {
+        WebsiteCache cache(nullptr);
+        cache.addElement(first, Locale::English, data);
+        const qint64 bytes = cache.memoryBytes();
+        cache.addElement(first, Locale::English, data);
+        CHECK(cache.elementCount() == 1);
+        CHECK(cache.memoryBytes() == bytes);
+    }
+
+    SECTION("evicts least recently used elements if the budget is exceeded")
+    {
+        // Budget for two elements
+        const QByteArray largeData(1000, 'x');
+        WebsiteCache cache(nullptr, 2 * 1100);
+        cache.addElement(first, Locale::English, largeData);
+        cache.addElement(second, Locale::English, largeData);
+        // Use the first one so that the second one is evicted.
+        CHECK(cache.hasValidElement(first, Locale::English));
+
+        const auto evictionsBefore = WebsiteCache::statistics().evictions;
+        cache.addElement(third, Locale::English, largeData);
+
+        CHECK(cache.elementCount() == 2);
+        CHECK(cache.hasValidElement(first, Locale::English));
+        CHECK_FALSE(cache.hasValidElement(second, Locale::English));
+        CHECK(cache.hasValidElement(third, Locale::English));
+        CHECK(WebsiteCache::statistics().evictions == evictionsBefore + 1);
+    }
+
+    SECTION("counts hits and misses")
+    {
+        WebsiteCache cache(nullptr);
+        const WebsiteCache::Statistics before = WebsiteCache::statistics();
+        cache.addElement(first, Locale::English, data);
+        CHECK(cache.hasValidElement(first, Locale::English));
+        CHECK_FALSE(cache.hasValidElement(second, Locale::English));
+
+        const WebsiteCache::Statistics after = WebsiteCache::statistics();
+        CHECK(after.memoryHits == before.memoryHits + 1);
+        CHECK(after.misses == before.misses + 1);
+        CHECK(after.elements == before.elements + 1);
+        CHECK(after.bytes == before.bytes + cache.memoryBytes());
+    }
+
+    SECTION("persists counters in the disk cache for other processes")
+    {
+        QTemporaryDir tempDir;
+        REQUIRE(tempDir.isValid());
+        network::HttpDiskCache diskCache(tempDir.path());
+        {
+            WebsiteCache cache(&diskCache, 2 * 1100);
+            const QByteArray largeData(1000, 'x');
+            CHECK_FALSE(cache.hasValidElement(first, Locale::English));
+            cache.addElement(first, Locale::English, largeData);
+            CHECK(cache.hasValidElement(first, Locale::English));
+            cache.addElement(second, Locale::English, largeData);
+            cache.addElement(third, Locale::English, largeData);
+        }
+
+        // Same as a new process: only the disk cache is shared.
+        network::HttpDiskCache otherProcess(tempDir.path());
+        const WebsiteCache::Statistics stats = WebsiteCache::persistentStatistics(&otherProcess);
+        CHECK(stats.memoryHits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.diskHits == 0);
+        CHECK(stats.evictions == 1);
+        CHECK(stats.elements == 0);
+    }
+
+    SECTION("writes persistent counters in batches")
+    {
+        QTemporaryDir tempDir;
+        REQUIRE(tempDir.isValid());
+        network::HttpDiskCache diskCache(tempDir.path());
+        network::HttpDiskCache otherProcess(tempDir.path());
+        WebsiteCache cache(&diskCache);
+        cache.addElement(first, Locale::English, data);
+        CHECK(cache.hasValidElement(first, Locale::English));
+        CHECK(WebsiteCache::persistentStatistics(&otherProcess).memoryHits == 0);
+
+        cache.flushStatistics();
+        CHECK(WebsiteCache::persistentStatistics(&otherProcess).memoryHits == 1);
+
+        for (quint64 i = 1; i < WebsiteCache::statisticsBatchSize; ++i) {
+            CHECK(cache.hasValidElement(first, Locale::English));
+        }
+        CHECK(WebsiteCache::persistentStatistics(&otherProcess).memoryHits == 1);
+        CHECK(cache.hasValidElement(first, Locale::English));
+        CHECK(WebsiteCache::persistentStatistics(&otherProcess).memoryHits == 1 + WebsiteCache::statisticsBatchSize);
+    }
+}
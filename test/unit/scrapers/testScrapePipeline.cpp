@@ -0,0 +1,218 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/ScrapePipeline.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <algorithm>
+
+using namespace mediaelch::scraper;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Counters
+{
+    int running = 0;
+    int maxRunning = 0;
+    int inSlot = 0;
+    int maxInSlot = 0;
+};
+
+/// Fake item: waits for a slot of "fake-scraper", holds it for a few milliseconds and finishes.
+class FakeScrapeItem : public ScrapePipelineItem
+{
+public:
+    FakeScrapeItem(Counters& counters, bool skip) : m_counters{counters}, m_skip{skip} {}
+
+    QString title() const override { return "fake"; }
+
+protected:
+    void run() override
+    {
+        if (m_skip) {
+            finish(Stage::Skipped);
+            return;
+        }
+        ++m_counters.running;
+        m_counters.maxRunning = std::max(m_counters.maxRunning, m_counters.running);
+        acquireSlot("fake-scraper", [this]() {
+            setStage(Stage::Load);
+            ++m_counters.inSlot;
+            m_counters.maxInSlot = std::max(m_counters.maxInSlot, m_counters.inSlot);
+            QTimer::singleShot(5, this, [this]() {
+                --m_counters.inSlot;
+                releaseSlot("fake-scraper");
+                setStage(Stage::Images);
+                QTimer::singleShot(5, this, [this]() {
+                    --m_counters.running;
+                    finish(Stage::Done);
+                });
+            });
+        });
+    }
+
+    void doAbort() override {}
+
+private:
+    Counters& m_counters;
+    bool m_skip = false;
+};
+
+void runUntilFinished(ScrapePipeline& pipeline)
+{
+    QEventLoop loop;
+    QObject::connect(&pipeline, &ScrapePipeline::sigFinished, &loop, &QEventLoop::quit);
+    QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+    pipeline.start();
+    loop.exec();
+}
+
+} // namespace
+
+TEST_CASE("ScrapePipeline", "[scraper][pipeline]")
+{
+    Counters counters;
+    ScrapePipeline pipeline;
+    pipeline.rateLimiter()->setLimit("fake-scraper", {2, 0ms});
+
+    SECTION("runs items concurrently and respects rate limits")
+    {
+        pipeline.setConcurrency(4);
+        for (int i = 0; i < 20; ++i) {
+            pipeline.addItem(new FakeScrapeItem(counters, false));
+        }
+        runUntilFinished(pipeline);
+
+        CHECK_FALSE(pipeline.isRunning());
+        CHECK(pipeline.finishedCount() == 20);
+        CHECK(counters.maxRunning == 4);
+        CHECK(counters.maxInSlot <= 2);
+        CHECK(pipeline.rateLimiter()->inFlight("fake-scraper") == 0);
+        for (const ScrapePipelineItem* item : pipeline.items()) {
+            CHECK(item->stage() == ScrapePipelineItem::Stage::Done);
+        }
+    }
+
+    SECTION("many skipped items do not recurse")
+    {
+        for (int i = 0; i < 5000; ++i) {
+            pipeline.addItem(new FakeScrapeItem(counters, true));
+        }
+        runUntilFinished(pipeline);
+
+        CHECK(pipeline.finishedCount() == 5000);
+        CHECK(pipeline.items().last()->stage() == ScrapePipelineItem::Stage::Skipped);
+    }
+
+    SECTION("abort drops queued items")
+    {
+        pipeline.setConcurrency(1);
+        for (int i = 0; i < 3; ++i) {
+            pipeline.addItem(new FakeScrapeItem(counters, false));
+        }
+        pipeline.start();
+        pipeline.abort();
+
+        CHECK_FALSE(pipeline.isRunning());
+        CHECK(pipeline.items()[0]->isAborted());
+        CHECK_FALSE(pipeline.items()[1]->isStarted());
+        CHECK(pipeline.rateLimiter()->inFlight("fake-scraper") == 0);
+    }
+}
+
+TEST_CASE("ScraperRateLimiter", "[scraper][pipeline]")
+{
+    ScraperRateLimiter limiter;
+    QObject context;
+
+    SECTION("limits concurrent slots")
+    {
+        limiter.setLimit("key", {1, 0ms});
+        int called = 0;
+        limiter.acquire("key", &context, [&]() { ++called; });
+        limiter.acquire("key", &context, [&]() { ++called; });
+        CHECK(called == 1);
+        CHECK(limiter.waiting("key") == 1);
+
+        limiter.release("key");
+        CHECK(called == 2);
+        CHECK(limiter.inFlight("key") == 1);
+    }
+
+    SECTION("respects the minimum interval")
+    {
+        limiter.setLimit("key", {4, 50ms});
+        QElapsedTimer timer;
+        timer.start();
+        qint64 secondStart = -1;
+        limiter.acquire("key", &context, []() {});
+        limiter.acquire("key", &context, [&]() { secondStart = timer.elapsed(); });
+        CHECK(secondStart == -1);
+
+        QEventLoop loop;
+        QTimer::singleShot(200, &loop, &QEventLoop::quit);
+        loop.exec();
+        CHECK(secondStart >= 40);
+    }
+
+    SECTION("drops callbacks of destroyed contexts")
+    {
+        limiter.setLimit("key", {1, 0ms});
+        int called = 0;
+        limiter.acquire("key", &context, []() {});
+        {
+            QObject shortLived;
+            limiter.acquire("key", &shortLived, [&]() { ++called; });
+        }
+        limiter.release("key");
+        CHECK(called == 0);
+        CHECK(limiter.inFlight("key") == 0);
+    }
+
+    SECTION("sends requests once a slot is free and releases it when they have finished")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString fileName = dir.filePath("response.json");
+        QFile file(fileName);
+        REQUIRE(file.open(QIODevice::WriteOnly));
+        file.write("{}");
+        file.close();
+
+        // Local files have no host.
+        const QUrl url = QUrl::fromLocalFile(fileName);
+        limiter.setLimit(url.host(), {1, 0ms});
+
+        QNetworkAccessManager network;
+        int sent = 0;
+        int finished = 0;
+        const auto send = [&]() {
+            ++sent;
+            QNetworkReply* reply = network.get(QNetworkRequest(url));
+            QObject::connect(reply, &QNetworkReply::finished, reply, [&finished, reply]() {
+                ++finished;
+                reply->deleteLater();
+            });
+            return reply;
+        };
+        limiter.sendRequest(url, &context, send);
+        limiter.sendRequest(url, &context, send);
+        CHECK(sent == 1);
+
+        QElapsedTimer timer;
+        timer.start();
+        while (finished < 2 && timer.elapsed() < 2000) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        }
+        CHECK(sent == 2);
+        CHECK(finished == 2);
+        CHECK(limiter.inFlight(url.host()) == 0);
+    }
+}
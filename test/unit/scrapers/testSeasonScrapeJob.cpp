@@ -0,0 +1,117 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/ScraperRateLimiter.h"
+#include "scrapers/tv_show/SeasonScrapeJob.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QEventLoop>
+#include <QTimer>
+#include <algorithm>
+
+using namespace mediaelch;
+using namespace mediaelch::scraper;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Fake job: one request per season.  Later seasons respond earlier, so that
+/// the responses arrive in reverse order.  Each season also returns episode 1
+/// of the next season as a "duplicate".
+class FakeSeasonScrapeJob : public SeasonScrapeJob
+{
+public:
+    FakeSeasonScrapeJob(Config _config, int seasonCount) : SeasonScrapeJob(std::move(_config)), m_seasons{seasonCount}
+    {
+        ScraperRateLimiter::instance()->setLimit("fake-tv-scraper", {2, 0ms});
+    }
+
+    void execute() override
+    {
+        QVector<EpisodeRequest> requests;
+        for (int season = 1; season <= m_seasons; ++season) {
+            requests << [this, season](std::function<void(QVector<TvShowEpisode*>)> done) {
+                ++running;
+                maxRunning = std::max(maxRunning, running);
+                QTimer::singleShot((m_seasons - season) * 5, this, [this, season, done]() {
+                    --running;
+                    QVector<TvShowEpisode*> episodes;
+                    episodes << createEpisode(season, 1, QStringLiteral("S%1E1").arg(season));
+                    episodes << createEpisode(season, 2, QStringLiteral("S%1E2").arg(season));
+                    episodes << createEpisode(season + 1, 1, QStringLiteral("duplicate of S%1E1").arg(season + 1));
+                    done(episodes);
+                });
+            };
+        }
+        fanOutEpisodes("fake-tv-scraper", requests, [this]() { emit sigFinished(this); });
+    }
+
+    int running = 0;
+    int maxRunning = 0;
+
+private:
+    TvShowEpisode* createEpisode(int season, int episode, QString title)
+    {
+        auto* ep = new TvShowEpisode({}, this);
+        ep->setSeason(SeasonNumber(season));
+        ep->setEpisode(EpisodeNumber(episode));
+        ep->setTitle(std::move(title));
+        return ep;
+    }
+
+    int m_seasons = 0;
+};
+
+void runUntilFinished(SeasonScrapeJob& job)
+{
+    QEventLoop loop;
+    QObject::connect(&job, &SeasonScrapeJob::sigFinished, &loop, &QEventLoop::quit);
+    QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+    job.execute();
+    loop.exec();
+}
+
+SeasonScrapeJob::Config makeConfig(QSet<SeasonNumber> seasons)
+{
+    return SeasonScrapeJob::Config{ShowIdentifier("fake"), Locale::English, std::move(seasons), SeasonOrder::Aired, {}};
+}
+
+} // namespace
+
+TEST_CASE("SeasonScrapeJob fan-out", "[scraper][tv][season]")
+{
+    SECTION("merges episodes in request order and respects the rate limit")
+    {
+        FakeSeasonScrapeJob job(makeConfig({}), 6);
+        QVector<int> progress;
+        QObject::connect(&job, &SeasonScrapeJob::sigProgress, [&progress](int current, int max) {
+            CHECK(max == 6);
+            progress << current;
+        });
+        runUntilFinished(job);
+
+        CHECK(job.maxRunning <= 2);
+        CHECK(progress == QVector<int>({1, 2, 3, 4, 5, 6}));
+
+        const EpisodeMap& episodes = job.episodes();
+        // 6 seasons * 2 episodes + episode 1 of the 7th season
+        REQUIRE(episodes.size() == 13);
+        // Season 1 responds last but its duplicate of S2E1 is stored before the
+        // one of season 2 itself, which therefore wins.
+        CHECK(episodes[{SeasonNumber(2), EpisodeNumber(1)}]->title() == "S2E1");
+        CHECK(episodes[{SeasonNumber(1), EpisodeNumber(1)}]->title() == "S1E1");
+        CHECK(episodes[{SeasonNumber(7), EpisodeNumber(1)}]->title() == "duplicate of S7E1");
+    }
+
+    SECTION("only stores requested seasons")
+    {
+        FakeSeasonScrapeJob job(makeConfig({SeasonNumber(2), SeasonNumber(3)}), 3);
+        runUntilFinished(job);
+
+        const EpisodeMap& episodes = job.episodes();
+        REQUIRE(episodes.size() == 4);
+        CHECK(episodes.contains({SeasonNumber(2), EpisodeNumber(1)}));
+        CHECK(episodes.contains({SeasonNumber(3), EpisodeNumber(2)}));
+        CHECK_FALSE(episodes.contains({SeasonNumber(1), EpisodeNumber(1)}));
+        CHECK_FALSE(episodes.contains({SeasonNumber(4), EpisodeNumber(1)}));
+    }
+}
@@ -27,6 +27,10 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         // check a few defaults
         CHECK(settings.useFirstStudioOnly() == defaults.useFirstStudioOnly());
         CHECK(settings.forceCache() == defaults.forceCache());
+        CHECK(settings.incrementalMovieScan() == defaults.incrementalMovieScan());
+        CHECK(settings.lazyMovieLoading() == defaults.lazyMovieLoading());
+        CHECK(settings.lazyEpisodeLoading() == defaults.lazyEpisodeLoading());
+        CHECK(settings.multiScrapeConcurrency() == defaults.multiScrapeConcurrency());
         CHECK(settings.portableMode() == defaults.portableMode());
         CHECK(settings.episodeThumbnailDimensions() == defaults.episodeThumbnailDimensions());
         CHECK(messages.isEmpty());
@@ -138,6 +142,31 @@ TEST_CASE("Advanced Settings XML", "[settings]")
             CHECK(messages[0].tag == "pattern");
             CHECK(messages[0].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidAttributeValue);
         }
+
+        SECTION("files and folders are matched separately")
+        {
+            QString xml = addBaseXml(R"xml(
+                <exclude>
+                    <pattern applyTo="filename">-sample\.</pattern>
+                    <pattern applyTo="filename">^\.</pattern>
+                    <pattern applyTo="folders">^(extras|featurettes)$</pattern>
+                    <pattern applyTo="folders">@eaDir</pattern>
+                </exclude>
+            )xml");
+
+            const auto settings = AdvancedSettingsXmlReader::loadFromXml(xml).first;
+
+            CHECK(settings.isFileExcluded("movie-sample.mkv"));
+            CHECK(settings.isFileExcluded(".movie.mkv"));
+            CHECK_FALSE(settings.isFileExcluded("movie.mkv"));
+            CHECK_FALSE(settings.isFileExcluded("extras"));
+
+            CHECK(settings.isFolderExcluded("extras"));
+            CHECK(settings.isFolderExcluded("featurettes"));
+            CHECK(settings.isFolderExcluded("@eaDir"));
+            CHECK_FALSE(settings.isFolderExcluded("extras2"));
+            CHECK_FALSE(settings.isFolderExcluded(".movie"));
+        }
     }
 
     SECTION("read attributes correctly")
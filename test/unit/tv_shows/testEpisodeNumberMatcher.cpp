@@ -0,0 +1,91 @@
+#include "test/test_helpers.h"
+
+#include "test/helpers/episode_numbers.h"
+#include "tv_shows/EpisodeNumberMatcher.h"
+
+using namespace mediaelch;
+
+namespace {
+
+QVector<int> toInts(const QVector<EpisodeNumber>& episodes)
+{
+    QVector<int> numbers;
+    for (const EpisodeNumber& episode : episodes) {
+        numbers << episode.toInt();
+    }
+    return numbers;
+}
+
+void checkParity(const EpisodeNumberMatcher& matcher, const QStringList& names)
+{
+    const QVector<EpisodeNumberMatcher::Result> results = matcher.match(names);
+    REQUIRE(results.size() == names.size());
+    for (int i = 0; i < names.size(); ++i) {
+        CAPTURE(names[i]);
+        CHECK(results[i].season.toInt() == referenceSeasonNumber(names[i]));
+        CHECK(toInts(results[i].episodes) == referenceEpisodeNumbers(names[i]));
+    }
+}
+
+} // namespace
+
+TEST_CASE("EpisodeNumberMatcher", "[show][utils]")
+{
+    const EpisodeNumberMatcher& matcher = EpisodeNumberMatcher::instance();
+
+    SECTION("same results as the QRegExp implementation for known file names")
+    {
+        // Same file names as in testTvShowFileSearcher.cpp
+        const QStringList names = {"S01E4.mov",
+            "S01E04.mov",
+            "S01E004.mov",
+            "S01E14.mov",
+            "S01E142.mov",
+            "S01E1425.mov",
+            "Season.01-Episode.142.mov",
+            "Season.01 Episode.142.mov",
+            "Season01Episode14.mov",
+            "Name_S01E14.mov",
+            "Name with space S01E14.mov",
+            "Name_before_S01E14.mov",
+            "Name_before_S01E142.mov",
+            "Name_before_S01E1425.mov",
+            "S01E14_Name.mov",
+            "S01E14 Name with space.mov",
+            "S01E14_Name_before.mov",
+            "S01E142_Name_before.mov",
+            "S01E1425_Name_before.mov",
+            "S01E4-S01E5.mov",
+            "S01E4-S01E05.mov",
+            "S01E14-S01E115.mov",
+            "S01E004-S01E005.mov",
+            "S01E004-S01E005-S01E15.mov",
+            "Name_S01E4-S01E5.mov",
+            "S01E4 Name with space S01E05 Second name.mov",
+            "S01E14-S01E115 - Some name.mov",
+            "S01E004.S01E005-Another-Title.mov",
+            "S01E04E05E06.mkv",
+            "21x04 - Hammond vs. 6x6.mp4",
+            "Show.1080p.mkv",
+            "No numbers at all.mkv",
+            ""};
+        checkParity(matcher, names);
+    }
+
+    SECTION("same results as the QRegExp implementation for a synthetic corpus")
+    {
+        checkParity(matcher, syntheticEpisodeFileNames(20000));
+    }
+
+    SECTION("batch results are in input order")
+    {
+        const auto results = matcher.match(QStringList{"Show.S02E03.mkv", "Show 4x05.avi", "Special"});
+        REQUIRE(results.size() == 3);
+        CHECK(results[0].season == SeasonNumber(2));
+        CHECK(results[0].episodes == QVector<EpisodeNumber>{EpisodeNumber(3)});
+        CHECK(results[1].season == SeasonNumber(4));
+        CHECK(results[1].episodes == QVector<EpisodeNumber>{EpisodeNumber(5)});
+        CHECK(results[2].season == SeasonNumber::SpecialsSeason);
+        CHECK(results[2].episodes.isEmpty());
+    }
+}